@@ -236,6 +236,20 @@ private:
      */
     [[nodiscard]] loglib::LogLevel LevelForRow(int row) const;
 
+    /**
+     * @brief Returns the time column's range from the table's zone map.
+     * @return The range, or `std::nullopt` without a live zone map or timestamp.
+     */
+    [[nodiscard]] std::optional<TimeRange> ZoneMapRange() const;
+
+    /**
+     * @brief Picks the auto bucket size from the zone map before a rebuild.
+     *
+     * Lets the following `ApplyAutoBucketSize()` find the rung already
+     * in place instead of walking every row a second time.
+     */
+    void PreselectAutoBucketSize();
+
     /** @brief Starts the coalesced bucket-change timer if idle. */
     void ScheduleEmit();
 
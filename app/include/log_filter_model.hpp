@@ -1,6 +1,7 @@
 #pragma once
 
 #include "log_model.hpp"
+#include "shifted_row_vector.hpp"
 
 #include <loglib/key_index.hpp>
 #include <loglib/log_compare.hpp>
@@ -18,7 +19,7 @@
 #include <unordered_map>
 #include <vector>
 
-/// Row-projection proxy. Holds a `vector<int>` mapping proxy rows to
+/// Row-projection proxy. Holds a `ShiftedRowVector` mapping proxy rows to
 /// source rows and rebuilds it from scratch on filter / sort changes.
 /// Replaces `QSortFilterProxyModel` to skip the per-row `QModelIndex`
 /// / `QVariant` round-trip: `RebuildAcceptedRows` evaluates
@@ -169,6 +170,11 @@ private:
     /// Predicate evaluation for one source-coords row.
     [[nodiscard]] bool MatchesRulesAtSourceRow(int sourceRow) const;
 
+    /// Accepted source rows in `[first, last]`, ascending. Contiguous
+    /// log ranges go through `loglib::FilterAcceptedRows`' parallel
+    /// pass; anything else falls back to `MatchesRulesAtSourceRow`.
+    [[nodiscard]] std::vector<int> AcceptedSourceRowsInRange(int first, int last) const;
+
     /// Compare two source-coords rows under the active sort column /
     /// order. Ties fall back to source-row index for determinism.
     [[nodiscard]] bool LessThanSourceRows(int leftSource, int rightSource) const;
@@ -189,9 +195,44 @@ private:
     /// order. No structural emit; caller brackets with layout signals.
     void ApplySortPermutation();
 
+    /// @p sourceRows reordered by the active sort column / order via
+    /// `loglib::SortPermutationByColumn` (keys pre-materialised once).
+    /// Ties keep input order. Returned unchanged when no sort applies.
+    [[nodiscard]] std::vector<int> SortedBySortColumn(std::vector<int> sourceRows) const;
+
+    /// Place @p newlyAccepted (ascending source rows) under the active
+    /// sort: sort the batch once, find each row's slot by binary search
+    /// from the previous slot, emit one `beginInsertRows` bracket per
+    /// run landing in the same slot, then merge into
+    /// `mAcceptedSourceRows` in one linear pass. Returns the first
+    /// proxy row that moved, or the row count when nothing was added.
+    int InsertSortedRows(const std::vector<int> &newlyAccepted);
+
+    /// Proxy row count, including rows staged in `mSortedInserts`.
+    [[nodiscard]] size_t ProxyRowCount() const noexcept
+    {
+        return mAcceptedSourceRows.size() + mSortedInserts.size();
+    }
+
+    /// Source row shown at @p proxyRow (`< ProxyRowCount()`). O(1)
+    /// normally; O(log k) over `mSortedInserts` while `InsertSortedRows`
+    /// has inserts staged.
+    [[nodiscard]] int ProxyRowToSourceRow(size_t proxyRow) const;
+
     /// Rebuild `mSourceRowToProxyRow` so `mapFromSource` is O(1).
     void RebuildReverseIndex();
 
+    /// Grow `mSourceRowToProxyRow` to the source row count after an
+    /// unsorted append and map @p appendedSourceRows to consecutive
+    /// proxy rows from @p proxyFirst. O(batch) instead of
+    /// `RebuildReverseIndex`'s O(source rows).
+    void ExtendReverseIndexForAppend(int proxyFirst, const std::vector<int> &appendedSourceRows);
+
+    /// Grow `mSourceRowToProxyRow` to the source row count and restamp
+    /// proxy rows from @p proxyFirst on. Valid after an append where
+    /// no row before @p proxyFirst moved; O(rows from @p proxyFirst).
+    void RefreshReverseIndexFrom(int proxyFirst);
+
     /// Disconnect from the previous source and connect to the current one.
     void RewireSourceConnections();
 
@@ -224,13 +265,28 @@ private:
     /// Source-coord row indices in proxy-display order. Ascending
     /// without an active sort; holds the sort permutation otherwise.
     /// `mapToSource(P)` returns `sourceModel()->index(mAcceptedSourceRows[P], ...)`.
-    std::vector<int> mAcceptedSourceRows;
+    /// A `ShiftedRowVector` so prefix eviction is O(evicted rows).
+    logapp::ShiftedRowVector mAcceptedSourceRows;
+
+    /// A streamed row announced by `InsertSortedRows` but not yet merged
+    /// into `mAcceptedSourceRows`.
+    struct SortedInsert
+    {
+        int proxyRow = 0;
+        int sourceRow = 0;
+    };
+
+    /// Rank-indexed overlay over `mAcceptedSourceRows` while
+    /// `InsertSortedRows` emits its per-run brackets. Ascending by
+    /// `proxyRow`; each `proxyRow` is final because runs are inserted
+    /// top to bottom. Empty outside `InsertSortedRows`.
+    std::vector<SortedInsert> mSortedInserts;
 
     /// Reverse index: `mSourceRowToProxyRow[srcRow] == proxyRow` for
     /// visible rows, `INVISIBLE_SOURCE_ROW` otherwise. Resized whenever
     /// the source row count changes.
     static constexpr int INVISIBLE_SOURCE_ROW = -1;
-    std::vector<int> mSourceRowToProxyRow;
+    logapp::ShiftedRowVector mSourceRowToProxyRow;
 
     /// Active sort column in source coords. `-1` means "no user sort";
     /// `mAcceptedSourceRows` then stays in ascending source-row order.
@@ -296,4 +352,8 @@ private:
 
     static bool Matches(const QVariant &data, const QVariant &value, Qt::MatchFlags flags);
     static bool Matches(const QString &text, const QString &needle, Qt::MatchFlags flags);
+
+    /// Trigrams every cell `Matches(text, needle, flags)` accepts must
+    /// contain; `All` when the match type has no useful bound.
+    static loglib::TrigramQuery FindTrigramQuery(const QString &needle, Qt::MatchFlags flags);
 };
@@ -16,8 +16,10 @@
 #include <QIcon>
 #include <QStringList>
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <filesystem>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -235,6 +237,24 @@ public:
     /// Current retention cap (`0` means unbounded). GUI thread only.
     [[nodiscard]] size_t RetentionCap() const noexcept;
 
+    /// Opt-in full-text index for Find and string filters (see
+    /// `LogTable::SetTrigramIndex`). Off while a file parses and brought
+    /// up by `EndStreaming`: loaded from @p cacheDir when a copy built
+    /// over the same single file is there, otherwise built and saved
+    /// back. A live tail extends it batch by batch instead. An idle
+    /// model applies the change immediately; an empty @p cacheDir
+    /// disables persistence.
+    void SetFullTextIndex(bool enabled, std::filesystem::path cacheDir);
+
+    [[nodiscard]] bool FullTextIndexEnabled() const noexcept;
+
+    /// Wall time of the last full-text index build; zero when it was
+    /// loaded from the cache.
+    [[nodiscard]] std::chrono::milliseconds FullTextIndexBuildTime() const noexcept;
+
+    /// True when the live full-text index came from the cache.
+    [[nodiscard]] bool FullTextIndexFromCache() const noexcept;
+
     /// True while source-row order matches wall-clock order across
     /// every appended batch boundary. Reset on session start; flips
     /// irreversibly to false on the first inversion seen by
@@ -406,6 +426,10 @@ private:
     /// `FileLineSource` inputs.
     void BeginStreamingShared(std::unique_ptr<loglib::LineSource> source);
 
+    /// Load or build the full-text index over the current rows when
+    /// `SetFullTextIndex` asked for one and it is not live yet.
+    void BringUpFullTextIndex();
+
     /// Shared implementation of `Reset()` / `StopAndKeepRows()`.
     void TeardownStreamingSessionInternal(bool resetTable);
 
@@ -460,6 +484,12 @@ private:
     /// Retention cap; `0` means unbounded.
     size_t mRetentionCap = 0;
 
+    /// `SetFullTextIndex` state; see `BringUpFullTextIndex`.
+    bool mFullTextIndex = false;
+    std::filesystem::path mFullTextIndexDir;
+    std::chrono::milliseconds mFullTextIndexBuildTime{0};
+    bool mFullTextIndexFromCache = false;
+
     /// Backing store for `TimestampsAreMonotonic()`. True at
     /// session start, only ever flips false (no cheap heal path).
     bool mTimestampsMonotonic = true;
@@ -1145,6 +1145,21 @@ public:
      */
     [[nodiscard]] bool EffectiveAutoDetectRotationHistory() const;
 
+    /**
+     * @brief Reads the process-wide full-text index setting.
+     *
+     * @return `true` when `ui/fullTextIndex` is set; off by default.
+     */
+    [[nodiscard]] static bool FullTextIndexPreference();
+
+    /**
+     * @brief Mirrors the full-text index setting into the model.
+     *
+     * Called on construction and whenever the setting flips; indexes
+     * are cached per file under the application cache directory.
+     */
+    void ApplyFullTextIndexPreference();
+
     /**
      * @brief Returns the monotonic live-tail elapsed timer.
      *
@@ -2,6 +2,7 @@
 
 #include <loglib/filter_expression.hpp>
 #include <loglib/log_filter.hpp>
+#include <loglib/trigram_query.hpp>
 
 #include <QString>
 
@@ -17,3 +18,8 @@
 [[nodiscard]] loglib::CallbackStringRowPredicate::MatchFn MakeStringMatcher(
     const QString &pattern, loglib::LeafRule::Match match
 );
+
+/// Trigrams every string `MakeStringMatcher(pattern, match)` accepts
+/// must contain, for `CallbackStringRowPredicate::SetTrigrams`. `All`
+/// when the pattern is too short or too loose to narrow anything.
+[[nodiscard]] loglib::TrigramQuery MakeStringTrigramQuery(const QString &pattern, loglib::LeafRule::Match match);
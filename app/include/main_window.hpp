@@ -2481,6 +2481,12 @@ private:
      */
     void OnRotationHistoryPrefToggled(bool enabled);
 
+    /**
+     * @brief Persist the full-text index preference and apply it to every session.
+     * @param enabled The new enabled state.
+     */
+    void OnFullTextIndexPrefToggled(bool enabled);
+
     /**
      * @brief Mirrors session state and writes the configuration slice
      * selected by @p scope.
@@ -3180,6 +3186,11 @@ private:
      * @brief Enabled while the current session can undo its expansion.
      */
     QAction *mActionUndoRotationExpansion = nullptr;
+
+    /**
+     * @brief Checkable full-text index Settings action.
+     */
+    QAction *mActionFullTextIndex = nullptr;
     /**
      * @brief Status-bar indicator that surfaces when the parse-errors dock
      * has entries; clicking it opens the dock.
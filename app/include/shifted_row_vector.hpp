@@ -0,0 +1,156 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace logapp
+{
+
+/// `std::vector<int>` of row numbers whose front can be dropped, and
+/// whose remaining values shifted down, in O(dropped).
+///
+/// Built for `LogFilterModel`'s row maps under retention: evicting the
+/// oldest source rows removes a prefix of the accepted rows and moves
+/// every surviving row (and every proxy row it maps to) up by a constant.
+/// Instead of erasing the prefix and rewriting each survivor, `DropFront`
+/// advances a head index and a logical base that reads subtract. The
+/// dropped slots are reclaimed once they outnumber the live ones, so the
+/// memmove is amortised over the evictions that caused it.
+///
+/// Negative values are sentinels (e.g. "row not visible"): stored and
+/// returned as-is, never shifted.
+///
+/// Algorithms that need the whole container (sort, mid-range insert,
+/// merge) go through `Values()`, which first folds the head and base
+/// back into a plain vector. That is O(size) once after a `DropFront`
+/// and free otherwise.
+class ShiftedRowVector
+{
+public:
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return mValues.size() - mHead;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    [[nodiscard]] int operator[](size_t index) const noexcept
+    {
+        return ToLogical(mValues[mHead + index]);
+    }
+
+    void Set(size_t index, int value) noexcept
+    {
+        mValues[mHead + index] = ToStored(value);
+    }
+
+    void push_back(int value)
+    {
+        mValues.push_back(ToStored(value));
+    }
+
+    void reserve(size_t count)
+    {
+        mValues.reserve(mHead + count);
+    }
+
+    /// Grow or shrink to @p count entries; new entries read @p value.
+    void resize(size_t count, int value)
+    {
+        mValues.resize(mHead + count, ToStored(value));
+    }
+
+    /// Replace the contents with @p count copies of @p value.
+    void assign(size_t count, int value)
+    {
+        mHead = 0;
+        mBase = 0;
+        mValues.assign(count, value);
+    }
+
+    void clear() noexcept
+    {
+        mHead = 0;
+        mBase = 0;
+        mValues.clear();
+    }
+
+    /// First index whose value is not less than @p value. The values
+    /// must be ascending.
+    [[nodiscard]] size_t LowerBound(int value) const
+    {
+        const auto begin = mValues.begin() + static_cast<std::ptrdiff_t>(mHead);
+        return static_cast<size_t>(std::lower_bound(begin, mValues.end(), ToStored(value)) - begin);
+    }
+
+    /// First index whose value is greater than @p value. The values
+    /// must be ascending.
+    [[nodiscard]] size_t UpperBound(int value) const
+    {
+        const auto begin = mValues.begin() + static_cast<std::ptrdiff_t>(mHead);
+        return static_cast<size_t>(std::upper_bound(begin, mValues.end(), ToStored(value)) - begin);
+    }
+
+    /// Drop the first @p count entries and subtract @p shift from every
+    /// remaining non-sentinel value. Amortised O(@p count).
+    void DropFront(size_t count, int shift)
+    {
+        mHead += std::min(count, size());
+        mBase += shift;
+        if (mHead > size() || mBase > MAX_BASE)
+        {
+            Fold();
+        }
+    }
+
+    /// The entries as a plain vector of logical values, for algorithms
+    /// that need iterators. Valid until the next `DropFront`.
+    [[nodiscard]] std::vector<int> &Values()
+    {
+        Fold();
+        return mValues;
+    }
+
+private:
+    /// Folded back into the values before stored rows could overflow.
+    static constexpr int MAX_BASE = 1 << 30;
+
+    [[nodiscard]] int ToStored(int value) const noexcept
+    {
+        return value < 0 ? value : value + mBase;
+    }
+
+    [[nodiscard]] int ToLogical(int stored) const noexcept
+    {
+        return stored < 0 ? stored : stored - mBase;
+    }
+
+    /// Erase the dropped slots and apply the base to the survivors.
+    void Fold()
+    {
+        if (mHead == 0 && mBase == 0)
+        {
+            return;
+        }
+        size_t out = 0;
+        for (size_t in = mHead; in < mValues.size(); ++in, ++out)
+        {
+            mValues[out] = ToLogical(mValues[in]);
+        }
+        mValues.resize(out);
+        mHead = 0;
+        mBase = 0;
+    }
+
+    std::vector<int> mValues;
+    /// Slots before this index were dropped.
+    size_t mHead = 0;
+    /// Subtracted from every stored non-sentinel value on read.
+    int mBase = 0;
+};
+
+} // namespace logapp
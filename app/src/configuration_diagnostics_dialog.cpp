@@ -14,6 +14,7 @@
 #include <QHBoxLayout>
 #include <QHeaderView>
 #include <QLabel>
+#include <QLocale>
 #include <QPalette>
 #include <QPushButton>
 #include <QStringList>
@@ -50,6 +51,7 @@ constexpr int COL_PRESENT = 4;
 constexpr int COL_MATCHING = 5;
 constexpr int COL_MISMATCHED = 6;
 constexpr int COL_PERCENT = 7;
+constexpr int COL_INDEX_MEMORY = 8;
 
 QString FormatType(loglib::LogConfiguration::Type type)
 {
@@ -139,6 +141,13 @@ QTableWidgetItem *MakePercentItem(double value)
 {
     return new NumericTableWidgetItem(QStringLiteral("%1").arg(value, 0, 'f', 1), value);
 }
+
+/// Byte count rendered as "12.3 KiB"; "-" for 0 (no index on the column).
+QTableWidgetItem *MakeBytesItem(qulonglong bytes)
+{
+    const QString text = bytes == 0 ? QStringLiteral("-") : QLocale().formattedDataSize(static_cast<qint64>(bytes));
+    return new NumericTableWidgetItem(text, static_cast<double>(bytes));
+}
 } // namespace
 
 ConfigurationDiagnosticsDialog::ConfigurationDiagnosticsDialog(LogModel *model, QWidget *parent)
@@ -165,6 +174,7 @@ ConfigurationDiagnosticsDialog::ConfigurationDiagnosticsDialog(LogModel *model,
         tr("Matching"),
         tr("Mismatched"),
         tr("Mismatch %"),
+        tr("Index memory"),
     };
     mTable->setColumnCount(static_cast<int>(headers.size()));
     mTable->setHorizontalHeaderLabels(headers);
@@ -279,7 +289,9 @@ void ConfigurationDiagnosticsDialog::Refresh()
     const QBrush highlightBg(warningBg);
     const QBrush highlightFg(warningFg);
 
+    const loglib::LogTable &logTable = mModel->Table();
     int mismatchedColumns = 0;
+    int indexedColumns = 0;
     for (int i = 0; std::cmp_less(i, columns.size()); ++i)
     {
         const auto &column = columns[static_cast<size_t>(i)];
@@ -315,6 +327,12 @@ void ConfigurationDiagnosticsDialog::Refresh()
         mTable->setItem(i, COL_MISMATCHED, MakeNumericItem(mismatched));
 
         mTable->setItem(i, COL_PERCENT, MakePercentItem(mismatchPct));
+        const loglib::internal::EnumPostingIndex *index = logTable.EnumIndex(static_cast<size_t>(i));
+        if (index != nullptr)
+        {
+            ++indexedColumns;
+        }
+        mTable->setItem(i, COL_INDEX_MEMORY, MakeBytesItem(index != nullptr ? index->MemoryBytes() : 0));
 
         if (mismatched > 0)
         {
@@ -331,21 +349,36 @@ void ConfigurationDiagnosticsDialog::Refresh()
 
     mTable->setSortingEnabled(wasSorting);
 
+    QString summary;
     if (mismatchedColumns == 0)
     {
-        mSummaryLabel->setText(
-            tr("No configuration mismatches detected. Every column's values match its configured type.")
-        );
+        summary = tr("No configuration mismatches detected. Every column's values match its configured type.");
     }
     else
     {
-        mSummaryLabel->setText(
+        summary =
             tr("%n column(s) have values that do not match the configured type. "
                "Either change the column's type in the Column Editor or leave auto-detect enabled.",
                nullptr,
-               mismatchedColumns)
-        );
+               mismatchedColumns);
+    }
+    if (indexedColumns > 0)
+    {
+        summary += QLatin1Char('\n') +
+                   tr("Filter indexes on %n enum column(s) hold %1.", nullptr, indexedColumns)
+                       .arg(QLocale().formattedDataSize(static_cast<qint64>(logTable.EnumIndexMemoryBytes())));
+    }
+    if (logTable.TrigramIndexEnabled())
+    {
+        const QString size = QLocale().formattedDataSize(static_cast<qint64>(logTable.TrigramIndexMemoryBytes()));
+        summary += QLatin1Char('\n') +
+                   (mModel->FullTextIndexFromCache()
+                        ? tr("Full-text index holds %1 (loaded from cache).").arg(size)
+                        : tr("Full-text index holds %1 (built in %2 ms).")
+                              .arg(size)
+                              .arg(mModel->FullTextIndexBuildTime().count()));
     }
+    mSummaryLabel->setText(summary);
 }
 
 int ConfigurationDiagnosticsDialog::MismatchedColumnCount(const LogModel &model)
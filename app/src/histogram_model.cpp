@@ -117,6 +117,7 @@ void HistogramModel::BindSources(LogModel *logModel, AnchorManager *anchors, boo
     }
 
     mDeferredBindPending = false;
+    PreselectAutoBucketSize();
     Rebuild();
     ApplyAutoBucketSize();
 }
@@ -128,6 +129,7 @@ void HistogramModel::PumpDeferredBind()
         return;
     }
     mDeferredBindPending = false;
+    PreselectAutoBucketSize();
     Rebuild();
     ApplyAutoBucketSize();
 }
@@ -294,8 +296,13 @@ std::optional<HistogramModel::TimeRange> HistogramModel::ObservedRange() const
         return TimeRange{.min = *minTs, .max = *maxTs};
     }
     // Slow path: the index is empty but the model has rows. Happens
-    // when every row's timestamp failed to parse. Walk the model
-    // rather than lie about the range.
+    // when every row's timestamp failed to parse. A live zone map
+    // answers that in O(blocks); otherwise walk the model rather than
+    // lie about the range.
+    if (mLogModel->Table().ColumnZoneMap(static_cast<std::size_t>(mTimeColumnIndex)) != nullptr)
+    {
+        return ZoneMapRange();
+    }
     const int rowCount = mLogModel->rowCount();
     if (rowCount == 0)
     {
@@ -326,6 +333,41 @@ std::optional<HistogramModel::TimeRange> HistogramModel::ObservedRange() const
     return TimeRange{.min = *walkedMin, .max = *walkedMax};
 }
 
+std::optional<HistogramModel::TimeRange> HistogramModel::ZoneMapRange() const
+{
+    if (mLogModel == nullptr || mTimeColumnIndex < 0)
+    {
+        return std::nullopt;
+    }
+    // Same reading as `TimeStampForRow` (`GetEpochMicroseconds`), so
+    // the range matches what `Rebuild` will feed the index.
+    const auto range = mLogModel->Table().EpochMicrosecondsRange(static_cast<std::size_t>(mTimeColumnIndex));
+    if (!range.has_value())
+    {
+        return std::nullopt;
+    }
+    return TimeRange{
+        .min = loglib::TimeStamp{std::chrono::microseconds{range->first}},
+        .max = loglib::TimeStamp{std::chrono::microseconds{range->second}},
+    };
+}
+
+void HistogramModel::PreselectAutoBucketSize()
+{
+    if (mBucketSizePinned)
+    {
+        return;
+    }
+    // After an eviction the front block can still carry evicted
+    // timestamps; a rung picked off that wider range is corrected by
+    // the `ApplyAutoBucketSize()` that follows the rebuild.
+    const auto range = ZoneMapRange();
+    if (range.has_value())
+    {
+        mIndex.SetBucketSize(loglib::HistogramBucketIndex::AutoBucketSize(range->min, range->max));
+    }
+}
+
 void HistogramModel::OnRowsInserted(const QModelIndex &parent, int first, int last)
 {
     (void)parent; // Table model: parent is always root.
@@ -346,6 +388,7 @@ void HistogramModel::OnRowsInserted(const QModelIndex &parent, int first, int la
         {
             emit timeColumnAvailabilityChanged(mTimeColumnIndex >= 0);
         }
+        PreselectAutoBucketSize();
         Rebuild();
         ApplyAutoBucketSize();
         return;
@@ -382,6 +425,7 @@ void HistogramModel::OnModelReset()
     }
     // Drop the pin so a fresh session gets a fresh auto rung.
     mBucketSizePinned = false;
+    PreselectAutoBucketSize();
     Rebuild();
     ApplyAutoBucketSize();
 }
@@ -428,6 +472,7 @@ void HistogramModel::OnColumnsMoved()
     }
     // The move changed column identity behind existing rows, so
     // rebuild against the fresh identity.
+    PreselectAutoBucketSize();
     Rebuild();
     ApplyAutoBucketSize();
 }
@@ -527,9 +572,11 @@ std::optional<loglib::TimeStamp> HistogramModel::TimeStampForRow(int row) const
     {
         return std::nullopt;
     }
-    const auto value =
-        mLogModel->Table().GetValue(static_cast<std::size_t>(row), static_cast<std::size_t>(mTimeColumnIndex));
-    const auto epochMicros = loglib::AsEpochMicroseconds(value);
+    // Typed read: skips the `LogValue` round-trip and streams the dense
+    // column when the table has columnar storage enabled.
+    const auto epochMicros = mLogModel->Table().GetEpochMicroseconds(
+        static_cast<std::size_t>(row), static_cast<std::size_t>(mTimeColumnIndex)
+    );
     if (!epochMicros.has_value())
     {
         return std::nullopt;
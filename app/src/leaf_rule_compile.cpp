@@ -217,11 +217,12 @@ std::optional<loglib::RowPredicate> CompileLeaf(
         {
             return std::nullopt;
         }
-        return loglib::RowPredicate{
-            std::in_place_type<loglib::CallbackStringRowPredicate>,
-            column,
-            MakeStringMatcher(QString::fromStdString(*rule.filterString), *rule.matchType)
-        };
+        const QString pattern = QString::fromStdString(*rule.filterString);
+        loglib::CallbackStringRowPredicate predicate(column, MakeStringMatcher(pattern, *rule.matchType));
+        // Lets `FilterAcceptedRows` skip granules off the full-text
+        // index when the table has one.
+        predicate.SetTrigrams(MakeStringTrigramQuery(pattern, *rule.matchType));
+        return loglib::RowPredicate{std::move(predicate)};
     }
     }
     // Unreachable: `switch` is exhaustive with no `default`, so a
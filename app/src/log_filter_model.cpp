@@ -1,6 +1,10 @@
 #include "log_filter_model.hpp"
 
+#include "log_string_matcher.hpp"
+
 #include <loglib/enum_dictionary.hpp>
+#include <loglib/internal/compact_log_value.hpp>
+#include <loglib/internal/trigram_index.hpp>
 #include <loglib/log_compare.hpp>
 #include <loglib/log_configuration.hpp>
 #include <loglib/log_filter.hpp>
@@ -17,11 +21,15 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdlib>
 #include <iterator>
 #include <mutex>
+#include <numeric>
+#include <optional>
 #include <ranges>
 #include <span>
 #include <utility>
+#include <vector>
 
 LogFilterModel::LogFilterModel(QObject *parent)
     : QAbstractProxyModel{parent}
@@ -69,10 +77,10 @@ void LogFilterModel::setSourceModel(QAbstractItemModel *sourceModel)
         RewireSourceConnections();
         RebuildProxyChainCache();
         const int n = sourceModel->rowCount();
-        mAcceptedSourceRows.resize(static_cast<size_t>(n));
+        mAcceptedSourceRows.reserve(static_cast<size_t>(n));
         for (int i = 0; i < n; ++i)
         {
-            mAcceptedSourceRows[static_cast<size_t>(i)] = i;
+            mAcceptedSourceRows.push_back(i);
         }
         RebuildReverseIndex();
     }
@@ -187,7 +195,7 @@ QModelIndex LogFilterModel::index(int row, int column, const QModelIndex &parent
     {
         return {};
     }
-    if (static_cast<size_t>(row) >= mAcceptedSourceRows.size())
+    if (static_cast<size_t>(row) >= ProxyRowCount())
     {
         return {};
     }
@@ -209,7 +217,7 @@ int LogFilterModel::rowCount(const QModelIndex &parent) const
     {
         return 0;
     }
-    return static_cast<int>(mAcceptedSourceRows.size());
+    return static_cast<int>(ProxyRowCount());
 }
 
 int LogFilterModel::columnCount(const QModelIndex &parent) const
@@ -228,11 +236,28 @@ QModelIndex LogFilterModel::mapToSource(const QModelIndex &proxyIndex) const
         return {};
     }
     const int proxyRow = proxyIndex.row();
-    if (proxyRow < 0 || static_cast<size_t>(proxyRow) >= mAcceptedSourceRows.size())
+    if (proxyRow < 0 || static_cast<size_t>(proxyRow) >= ProxyRowCount())
     {
         return {};
     }
-    return sourceModel()->index(mAcceptedSourceRows[static_cast<size_t>(proxyRow)], proxyIndex.column());
+    return sourceModel()->index(ProxyRowToSourceRow(static_cast<size_t>(proxyRow)), proxyIndex.column());
+}
+
+int LogFilterModel::ProxyRowToSourceRow(size_t proxyRow) const
+{
+    if (mSortedInserts.empty())
+    {
+        return mAcceptedSourceRows[proxyRow];
+    }
+    // Staged rows sit at their final proxy rows; every other proxy row
+    // is an existing entry pushed down by the staged rows above it.
+    const auto it = std::ranges::upper_bound(mSortedInserts, static_cast<int>(proxyRow), {}, &SortedInsert::proxyRow);
+    if (it != mSortedInserts.begin() && std::prev(it)->proxyRow == static_cast<int>(proxyRow))
+    {
+        return std::prev(it)->sourceRow;
+    }
+    const auto stagedAbove = static_cast<size_t>(std::distance(mSortedInserts.begin(), it));
+    return mAcceptedSourceRows[proxyRow - stagedAbove];
 }
 
 QModelIndex LogFilterModel::mapFromSource(const QModelIndex &sourceIndex) const
@@ -275,7 +300,7 @@ void LogFilterModel::sort(int column, Qt::SortOrder order)
 
         mSortColumn = -1;
         mSortOrder = order;
-        std::ranges::sort(mAcceptedSourceRows);
+        std::ranges::sort(mAcceptedSourceRows.Values());
         RebuildReverseIndex();
 
         RemapPersistentIndicesForRebuild();
@@ -301,10 +326,20 @@ void LogFilterModel::ApplySortPermutation()
     {
         return;
     }
+    std::vector<int> &rows = mAcceptedSourceRows.Values();
+    rows = SortedBySortColumn(std::move(rows));
+}
+
+std::vector<int> LogFilterModel::SortedBySortColumn(std::vector<int> sourceRows) const
+{
+    if (mSortColumn < 0 || mLogModel == nullptr || sourceRows.size() <= 1)
+    {
+        return sourceRows;
+    }
     const auto &columns = mLogModel->Configuration().columns;
     if (static_cast<size_t>(mSortColumn) >= columns.size())
     {
-        return;
+        return sourceRows;
     }
 
     // Resolve every source row to its log row once. The old
@@ -313,8 +348,8 @@ void LogFilterModel::ApplySortPermutation()
     // wall-clock). With pre-resolution the sort comparator stays
     // inside `loglib` and never touches a `QModelIndex`.
     std::vector<size_t> logRows;
-    logRows.reserve(mAcceptedSourceRows.size());
-    for (const int srcRow : mAcceptedSourceRows)
+    logRows.reserve(sourceRows.size());
+    for (const int srcRow : sourceRows)
     {
         const int logRow = SourceRowToLogRow(srcRow);
         // Every entry in `mAcceptedSourceRows` was pushed by a path
@@ -346,12 +381,12 @@ void LogFilterModel::ApplySortPermutation()
     );
 
     std::vector<int> sorted;
-    sorted.reserve(mAcceptedSourceRows.size());
+    sorted.reserve(sourceRows.size());
     for (const size_t idx : permutation)
     {
-        sorted.push_back(mAcceptedSourceRows[idx]);
+        sorted.push_back(sourceRows[idx]);
     }
-    mAcceptedSourceRows = std::move(sorted);
+    return sorted;
 }
 
 bool LogFilterModel::LessThanSourceRows(int leftSource, int rightSource) const
@@ -498,6 +533,56 @@ bool LogFilterModel::MatchesRulesAtSourceRow(int sourceRow) const
     return loglib::EvaluateExpression(mCompiledExpression, table, row);
 }
 
+std::vector<int> LogFilterModel::AcceptedSourceRowsInRange(int first, int last) const
+{
+    std::vector<int> accepted;
+    if (loglib::IsMatchAllCompiled(mCompiledExpression))
+    {
+        accepted.resize(static_cast<size_t>(last - first + 1));
+        std::iota(accepted.begin(), accepted.end(), first);
+        return accepted;
+    }
+
+    // The proxies above `LogModel` pass rows through or mirror them,
+    // so a contiguous source range whose ends are `last - first` log
+    // rows apart covers exactly that log range. Evaluate it with
+    // `loglib::FilterAcceptedRows`' parallel pass instead of one
+    // `EvaluateExpression` per row on the GUI thread.
+    const int logFirst = SourceRowToLogRow(first);
+    const int logLast = SourceRowToLogRow(last);
+    if (logFirst >= 0 && logLast >= 0 && std::abs(logLast - logFirst) == last - first)
+    {
+        const auto logBegin = static_cast<size_t>(std::min(logFirst, logLast));
+        const auto logEnd = logBegin + static_cast<size_t>(last - first + 1);
+        const auto acceptedLogRows =
+            loglib::FilterAcceptedRows(mLogModel->Table(), mCompiledExpression, logBegin, logEnd);
+        accepted.reserve(acceptedLogRows.size());
+        for (const size_t logRow : acceptedLogRows)
+        {
+            const int srcRow = LogRowToSourceRow(static_cast<int>(logRow));
+            if (srcRow >= first && srcRow <= last)
+            {
+                accepted.push_back(srcRow);
+            }
+        }
+        // Mirrored chains hand the rows back descending.
+        std::ranges::sort(accepted);
+        return accepted;
+    }
+
+    // Unmapped rows, or no `LogModel` (`MatchesRulesAtSourceRow`
+    // asserts and rejects): probe row by row.
+    accepted.reserve(static_cast<size_t>(last - first + 1));
+    for (int r = first; r <= last; ++r)
+    {
+        if (MatchesRulesAtSourceRow(r))
+        {
+            accepted.push_back(r);
+        }
+    }
+    return accepted;
+}
+
 void LogFilterModel::RecomputeAcceptedRows()
 {
     const QAbstractItemModel *src = sourceModel();
@@ -555,7 +640,7 @@ void LogFilterModel::RecomputeAcceptedRows()
     // ascending source-row order so the reverse index and later
     // streaming inserts can rely on it. Order-preserving chains pay
     // an already-sorted pass.
-    std::ranges::sort(mAcceptedSourceRows);
+    std::ranges::sort(mAcceptedSourceRows.Values());
 }
 
 void LogFilterModel::RebuildAcceptedRows()
@@ -620,7 +705,37 @@ void LogFilterModel::RebuildReverseIndex()
         const int srcRow = mAcceptedSourceRows[proxyRow];
         if (srcRow >= 0 && static_cast<size_t>(srcRow) < mSourceRowToProxyRow.size())
         {
-            mSourceRowToProxyRow[static_cast<size_t>(srcRow)] = static_cast<int>(proxyRow);
+            mSourceRowToProxyRow.Set(static_cast<size_t>(srcRow), static_cast<int>(proxyRow));
+        }
+    }
+}
+
+void LogFilterModel::ExtendReverseIndexForAppend(int proxyFirst, const std::vector<int> &appendedSourceRows)
+{
+    const int srcCount = sourceModel() != nullptr ? sourceModel()->rowCount() : 0;
+    mSourceRowToProxyRow.resize(static_cast<size_t>(srcCount), INVISIBLE_SOURCE_ROW);
+    int proxyRow = proxyFirst;
+    for (const int srcRow : appendedSourceRows)
+    {
+        if (srcRow >= 0 && static_cast<size_t>(srcRow) < mSourceRowToProxyRow.size())
+        {
+            mSourceRowToProxyRow.Set(static_cast<size_t>(srcRow), proxyRow);
+        }
+        ++proxyRow;
+    }
+}
+
+void LogFilterModel::RefreshReverseIndexFrom(int proxyFirst)
+{
+    const int srcCount = sourceModel() != nullptr ? sourceModel()->rowCount() : 0;
+    mSourceRowToProxyRow.resize(static_cast<size_t>(srcCount), INVISIBLE_SOURCE_ROW);
+    for (size_t proxyRow = static_cast<size_t>(std::max(proxyFirst, 0)); proxyRow < mAcceptedSourceRows.size();
+         ++proxyRow)
+    {
+        const int srcRow = mAcceptedSourceRows[proxyRow];
+        if (srcRow >= 0 && static_cast<size_t>(srcRow) < mSourceRowToProxyRow.size())
+        {
+            mSourceRowToProxyRow.Set(static_cast<size_t>(srcRow), static_cast<int>(proxyRow));
         }
     }
 }
@@ -686,31 +801,33 @@ void LogFilterModel::OnSourceRowsInserted(const QModelIndex &parent, int first,
         return;
     }
 
+    // Streaming appends land past every existing source row, so no
+    // accepted entry can sit at or after `first`.
+    const int sourceRowCount = sourceModel()->rowCount();
+    const bool isAppend = first >= sourceRowCount - insertedCount;
+
     // Shift accepted entries whose source row was >= first up by
     // `insertedCount`. Under no sort, `mAcceptedSourceRows` is
     // ascending so this is an in-place tail shift. Under a sort, the
     // comparator reads `SourceRowToLogRow(srcRow)`; the source's
     // row->log mapping shifts in lockstep with the entity, so each
     // shifted entry still describes the same entity in the same order.
-    for (int &row : mAcceptedSourceRows)
+    // Skipped on append: the walk is O(accepted rows) per batch and
+    // would shift nothing.
+    if (!isAppend)
     {
-        if (row >= first)
+        for (int &row : mAcceptedSourceRows.Values())
         {
-            row += insertedCount;
+            if (row >= first)
+            {
+                row += insertedCount;
+            }
         }
     }
 
     // Probe the new source rows. In streaming mode `first` is the old
     // row count, so most predicate work happens here.
-    std::vector<int> newlyAccepted;
-    newlyAccepted.reserve(static_cast<size_t>(insertedCount));
-    for (int r = first; r <= last; ++r)
-    {
-        if (MatchesRulesAtSourceRow(r))
-        {
-            newlyAccepted.push_back(r);
-        }
-    }
+    const std::vector<int> newlyAccepted = AcceptedSourceRowsInRange(first, last);
 
     if (mSortColumn < 0)
     {
@@ -728,48 +845,145 @@ void LogFilterModel::OnSourceRowsInserted(const QModelIndex &parent, int first,
         // `TestStreamingAppendsEmitSingleBracketedInsert`.
         if (!newlyAccepted.empty())
         {
-            const auto insertIt = std::ranges::lower_bound(mAcceptedSourceRows, first);
-            const int proxyFirst = static_cast<int>(std::distance(mAcceptedSourceRows.begin(), insertIt));
+            const size_t insertAt = mAcceptedSourceRows.LowerBound(first);
+            const int proxyFirst = static_cast<int>(insertAt);
             const int proxyLast = proxyFirst + static_cast<int>(newlyAccepted.size()) - 1;
             beginInsertRows(QModelIndex{}, proxyFirst, proxyLast);
-            mAcceptedSourceRows.insert(insertIt, newlyAccepted.begin(), newlyAccepted.end());
+            if (insertAt == mAcceptedSourceRows.size())
+            {
+                // Append: a tail push, which leaves an evicted prefix
+                // unfolded.
+                for (const int srcRow : newlyAccepted)
+                {
+                    mAcceptedSourceRows.push_back(srcRow);
+                }
+            }
+            else
+            {
+                std::vector<int> &rows = mAcceptedSourceRows.Values();
+                rows.insert(
+                    rows.begin() + static_cast<std::ptrdiff_t>(insertAt), newlyAccepted.begin(), newlyAccepted.end()
+                );
+            }
             // Refresh the reverse index inside the bracket so observers
             // calling `mapFromSource` from a `rowsInserted` slot see a
-            // consistent model. (The per-row branch below rebuilds
-            // outside the bracket -- intermediate states would be
+            // consistent model. (The sorted branch below refreshes it
+            // after its last bracket -- per-run states would be
             // momentarily stale either way.)
-            RebuildReverseIndex();
+            if (isAppend)
+            {
+                ExtendReverseIndexForAppend(proxyFirst, newlyAccepted);
+            }
+            else
+            {
+                RebuildReverseIndex();
+            }
             endInsertRows();
             return;
         }
         // Source grew without contributing an accepted row: still
         // resize the reverse index so out-of-range `mapFromSource`
         // queries don't read past the old size.
-        RebuildReverseIndex();
+        if (isAppend)
+        {
+            ExtendReverseIndexForAppend(0, {});
+        }
+        else
+        {
+            RebuildReverseIndex();
+        }
         return;
     }
 
-    if (!newlyAccepted.empty())
+    // Active sort: streamed rows scatter across the permutation. Sort
+    // the batch once and merge it in; see `InsertSortedRows`.
+    const int firstMoved = InsertSortedRows(newlyAccepted);
+    // The reverse index is sized off the source row count: refresh
+    // whenever the source grew, even if no row passed the filter. On
+    // append only the entries from the first insert down moved.
+    if (isAppend)
     {
-        // Active sort: `lower_bound` on the comparator picks each
-        // insertion point. We emit per-row inserts so views keep their
-        // selection / scroll position. Coalescing the inserts is not
-        // worth the complexity for "streaming-while-sorted" (users
-        // typically sort after streaming completes).
-        for (const int r : newlyAccepted)
+        RefreshReverseIndexFrom(firstMoved);
+    }
+    else
+    {
+        RebuildReverseIndex();
+    }
+}
+
+int LogFilterModel::InsertSortedRows(const std::vector<int> &newlyAccepted)
+{
+    if (newlyAccepted.empty())
+    {
+        return static_cast<int>(mAcceptedSourceRows.size());
+    }
+
+    // One `SortPermutationByColumn` pass over the batch replaces a
+    // `CompareRows`-driven placement per row. Ties keep ascending
+    // source order, matching `LessThanSourceRows`' tie-break, so the
+    // batch is ordered under the comparator the slots are found with.
+    const std::vector<int> batch = SortedBySortColumn(newlyAccepted);
+
+    // `existingBefore[i]` is the number of existing entries ordered
+    // before `batch[i]`. Non-decreasing over a sorted batch, so each
+    // search starts from the previous slot.
+    // Only the unsorted path defers evictions, and applying the sort
+    // folded them, so this is a plain view.
+    const std::vector<int> &existing = mAcceptedSourceRows.Values();
+    std::vector<size_t> existingBefore(batch.size());
+    auto searchFrom = existing.begin();
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        searchFrom = std::ranges::lower_bound(searchFrom, existing.end(), batch[i], [this](int lhs, int rhs) {
+            return LessThanSourceRows(lhs, rhs);
+        });
+        existingBefore[i] = static_cast<size_t>(std::distance(existing.begin(), searchFrom));
+    }
+
+    // Announce one bracket per run of rows sharing a slot, top to
+    // bottom. `batch[i]` ends up at proxy row `existingBefore[i] + i`,
+    // and rows below the run are not announced yet, so that row is
+    // final the moment it is staged. Between brackets `rowCount` / `mapToSource`
+    // read through `mSortedInserts` rather than shifting the vector
+    // once per run; the reverse index is refreshed after the last one.
+    mSortedInserts.reserve(batch.size());
+    for (size_t runBegin = 0; runBegin < batch.size();)
+    {
+        size_t runEnd = runBegin + 1;
+        while (runEnd < batch.size() && existingBefore[runEnd] == existingBefore[runBegin])
         {
-            const auto it = std::ranges::lower_bound(mAcceptedSourceRows, r, [this](int lhs, int rhs) {
-                return LessThanSourceRows(lhs, rhs);
-            });
-            const int proxyRow = static_cast<int>(std::distance(mAcceptedSourceRows.begin(), it));
-            beginInsertRows(QModelIndex{}, proxyRow, proxyRow);
-            mAcceptedSourceRows.insert(it, r);
-            endInsertRows();
+            ++runEnd;
+        }
+        const auto proxyFirst = static_cast<int>(existingBefore[runBegin] + runBegin);
+        beginInsertRows(QModelIndex{}, proxyFirst, proxyFirst + static_cast<int>(runEnd - runBegin) - 1);
+        for (size_t i = runBegin; i < runEnd; ++i)
+        {
+            mSortedInserts.push_back(
+                SortedInsert{.proxyRow = static_cast<int>(existingBefore[i] + i), .sourceRow = batch[i]}
+            );
         }
+        endInsertRows();
+        runBegin = runEnd;
     }
-    // The reverse index is sized off the source row count: refresh
-    // whenever the source grew, even if no row passed the filter.
-    RebuildReverseIndex();
+
+    // Fold the staged rows in with one linear merge.
+    std::vector<int> merged;
+    merged.reserve(existing.size() + batch.size());
+    size_t copied = 0;
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        merged.insert(
+            merged.end(),
+            existing.begin() + static_cast<std::ptrdiff_t>(copied),
+            existing.begin() + static_cast<std::ptrdiff_t>(existingBefore[i])
+        );
+        merged.push_back(batch[i]);
+        copied = existingBefore[i];
+    }
+    merged.insert(merged.end(), existing.begin() + static_cast<std::ptrdiff_t>(copied), existing.end());
+    mAcceptedSourceRows.Values() = std::move(merged);
+    mSortedInserts.clear();
+    return static_cast<int>(existingBefore.front());
 }
 
 void LogFilterModel::OnSourceRowsAboutToBeRemoved(
@@ -795,7 +1009,67 @@ void LogFilterModel::OnSourceRowsRemoved(const QModelIndex &parent, int first, i
         return;
     }
 
-    // Two-pass: emit `beginRemoveRows` for each contiguous proxy range
+    if (mSortColumn < 0)
+    {
+        // No sort: `mAcceptedSourceRows` is ascending, so the rows in
+        // `[first, last]` form one contiguous proxy range. Retention
+        // eviction hits this path on every streaming batch at the cap:
+        // the evicted range is the source prefix (oldest-first) or
+        // suffix (newest-first).
+        const size_t dropBegin = mAcceptedSourceRows.LowerBound(first);
+        const size_t dropEnd = mAcceptedSourceRows.UpperBound(last);
+        const int proxyFirst = static_cast<int>(dropBegin);
+        const int droppedCount = static_cast<int>(dropEnd - dropBegin);
+        if (droppedCount > 0)
+        {
+            beginRemoveRows(QModelIndex{}, proxyFirst, proxyFirst + droppedCount - 1);
+        }
+        if (static_cast<size_t>(last) >= mSourceRowToProxyRow.size())
+        {
+            std::vector<int> &rows = mAcceptedSourceRows.Values();
+            rows.erase(rows.begin() + proxyFirst, rows.begin() + proxyFirst + droppedCount);
+            for (int &sr : std::ranges::subrange(rows.begin() + proxyFirst, rows.end()))
+            {
+                sr -= removedCount;
+            }
+            RebuildReverseIndex();
+        }
+        else if (first == 0)
+        {
+            // Prefix: both maps drop their front and every survivor
+            // moves up by a constant, which `DropFront` records as a
+            // base instead of rewriting. O(evicted rows).
+            mAcceptedSourceRows.DropFront(static_cast<size_t>(droppedCount), removedCount);
+            mSourceRowToProxyRow.DropFront(static_cast<size_t>(removedCount), droppedCount);
+        }
+        else
+        {
+            // Elsewhere: erase and shift the survivors. O(rows after
+            // `first`), so a suffix eviction only touches the suffix.
+            std::vector<int> &rows = mAcceptedSourceRows.Values();
+            rows.erase(rows.begin() + proxyFirst, rows.begin() + proxyFirst + droppedCount);
+            for (int &sr : std::ranges::subrange(rows.begin() + proxyFirst, rows.end()))
+            {
+                sr -= removedCount;
+            }
+            std::vector<int> &reverse = mSourceRowToProxyRow.Values();
+            reverse.erase(reverse.begin() + first, reverse.begin() + last + 1);
+            for (int &pr : std::ranges::subrange(reverse.begin() + first, reverse.end()))
+            {
+                if (pr != INVISIBLE_SOURCE_ROW)
+                {
+                    pr -= droppedCount;
+                }
+            }
+        }
+        if (droppedCount > 0)
+        {
+            endRemoveRows();
+        }
+        return;
+    }
+
+    // Active sort: emit `beginRemoveRows` for each contiguous proxy range
     // that maps into [first, last], then shift surviving entries down
     // by the source eviction.
     std::vector<int> proxyRowsToDrop;
@@ -839,18 +1113,17 @@ void LogFilterModel::OnSourceRowsRemoved(const QModelIndex &parent, int first, i
     };
     std::vector<std::pair<int, int>> ranges = coalesceRanges();
 
+    std::vector<int> &rows = mAcceptedSourceRows.Values();
     for (const auto [proxyFirst, proxyLast] : std::views::reverse(ranges))
     {
         beginRemoveRows(QModelIndex{}, proxyFirst, proxyLast);
-        mAcceptedSourceRows.erase(
-            mAcceptedSourceRows.begin() + proxyFirst, mAcceptedSourceRows.begin() + proxyLast + 1
-        );
+        rows.erase(rows.begin() + proxyFirst, rows.begin() + proxyLast + 1);
         endRemoveRows();
     }
 
     // Shift surviving entries whose source row was past `last` down
     // by `removedCount`.
-    for (int &sr : mAcceptedSourceRows)
+    for (int &sr : rows)
     {
         if (sr > last)
         {
@@ -1137,11 +1410,49 @@ void LogFilterModel::ForEachMatchingRow(
     const bool useFastPath = role == Qt::DisplayRole && mLogModel != nullptr;
     const QString needle = useFastPath ? value.toString() : QString{};
 
+    // Full-text index: outside the candidate granules a cell can only
+    // match through text the index never saw -- a formatted number or
+    // time, or a string under a decorating `printFormat`. Plain string
+    // and empty cells there are skipped without formatting them.
+    std::optional<loglib::internal::TrigramCandidates> candidates;
+    std::vector<bool> rawStringColumns;
+    if (useFastPath && mLogModel->Table().TrigramIndexEnabled())
+    {
+        candidates = mLogModel->Table().TrigramCandidatesFor(FindTrigramQuery(needle, flags));
+        const auto &columns = mLogModel->Configuration().columns;
+        rawStringColumns.reserve(columns.size());
+        for (const auto &column : columns)
+        {
+            rawStringColumns.push_back(column.printFormat == "{}");
+        }
+    }
+    auto skippedByIndex = [&](int logRow, int column) {
+        if (!candidates.has_value() || candidates->Contains(static_cast<size_t>(logRow)) ||
+            std::cmp_greater_equal(column, rawStringColumns.size()) || !rawStringColumns[static_cast<size_t>(column)])
+        {
+            return false;
+        }
+        switch (mLogModel->Table().GetCompactValue(static_cast<size_t>(logRow), static_cast<size_t>(column)).tag)
+        {
+        case loglib::internal::CompactTag::Monostate:
+        case loglib::internal::CompactTag::MmapSlice:
+        case loglib::internal::CompactTag::OwnedString:
+        case loglib::internal::CompactTag::DictRef:
+            return true;
+        default:
+            return false;
+        }
+    };
+
     // `logRowCached` is resolved once per row and reused across the
     // column scan (the proxy mapping is row-constant).
     auto probeCell = [&](const QModelIndex &proxyIndex, int logRowCached) -> bool {
         if (useFastPath && logRowCached >= 0)
         {
+            if (skippedByIndex(logRowCached, proxyIndex.column()))
+            {
+                return false;
+            }
             const std::string formatted = mLogModel->Table().GetFormattedValue(
                 static_cast<size_t>(logRowCached), static_cast<size_t>(proxyIndex.column())
             );
@@ -1239,6 +1550,27 @@ void LogFilterModel::ForEachMatchingRow(
     }
 }
 
+loglib::TrigramQuery LogFilterModel::FindTrigramQuery(const QString &needle, Qt::MatchFlags flags)
+{
+    // Same match-type decoding as `Matches`; anchored literals are
+    // bounded by their substring query.
+    constexpr int MATCH_TYPE_MASK = 0x000F;
+    switch (static_cast<int>(flags) & MATCH_TYPE_MASK)
+    {
+    case Qt::MatchExactly:
+    case Qt::MatchStartsWith:
+    case Qt::MatchEndsWith:
+    case Qt::MatchContains:
+        return MakeStringTrigramQuery(needle, loglib::LeafRule::Match::Contains);
+    case Qt::MatchRegularExpression:
+        return MakeStringTrigramQuery(needle, loglib::LeafRule::Match::RegularExpression);
+    case Qt::MatchWildcard:
+        return MakeStringTrigramQuery(needle, loglib::LeafRule::Match::Wildcard);
+    default:
+        return {};
+    }
+}
+
 QList<QModelIndex> LogFilterModel::MatchRow(
     const QModelIndex &start,
     int role,
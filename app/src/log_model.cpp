@@ -39,8 +39,10 @@
 #include <QtConcurrent/QtConcurrent>
 
 #include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <filesystem>
 #include <limits>
 #include <memory>
 #include <optional>
@@ -68,6 +70,13 @@ LogModel::LogModel(
     // Required for queued worker→GUI delivery.
     qRegisterMetaType<loglib::SourceStatus>("loglib::SourceStatus");
 
+    // Enum filters from the header menu and the query bar resolve
+    // through the posting lists instead of rescanning every row.
+    mLogTable.SetEnumIndexes(true);
+    // Time / number range filters skip or bulk-accept whole blocks off
+    // the zone maps; the histogram reads its auto-zoom range off them.
+    mLogTable.SetZoneMaps(true);
+
     mSink = new QtStreamingLogSink(this, this, pendingCapacity);
     mStreamingWatcher = new QFutureWatcher<void>(this);
 
@@ -234,6 +243,11 @@ void LogModel::BeginStreamingShared(std::unique_ptr<loglib::LineSource> source)
     // Drop cache entries for the about-to-be-released sources.
     mCanonicalLocatorCache.clear();
 
+    // Indexing a static parse batch by batch would tax it;
+    // `EndStreaming` loads or builds the full-text index in one pass
+    // instead. A live tail never ends, so its index grows per batch.
+    const bool staticParse = reserveCount.has_value();
+    mLogTable.SetTrigramIndex(mFullTextIndex && !staticParse);
     mLogTable.BeginStreaming(std::move(source));
     if (reserveCount.has_value())
     {
@@ -1047,6 +1061,11 @@ void LogModel::EndStreaming(bool cancelled)
         }
     }
 
+    if (!cancelled)
+    {
+        BringUpFullTextIndex();
+    }
+
     // `StreamingResult::Failed` is wired up at the worker boundary.
     emit streamingFinished(cancelled ? StreamingResult::Cancelled : StreamingResult::Success);
 }
@@ -1479,7 +1498,7 @@ std::optional<AnchorManager::Key> LogModel::AnchorKeyForRow(int row) const noexc
         return std::nullopt;
     }
     const auto unsignedRow = static_cast<std::size_t>(row);
-    const std::vector<loglib::LogLine> &lines = mLogTable.Data().Lines();
+    const loglib::LogLineStore &lines = mLogTable.Data().Lines();
     if (unsignedRow >= lines.size())
     {
         return std::nullopt;
@@ -1513,7 +1532,7 @@ std::optional<AnchorManager::Key> LogModel::AnchorKeyForRow(int row) const noexc
 
 int LogModel::SourceRowForAnchorKey(const AnchorManager::Key &key) const noexcept
 {
-    const std::vector<loglib::LogLine> &lines = mLogTable.Data().Lines();
+    const loglib::LogLineStore &lines = mLogTable.Data().Lines();
     for (std::size_t i = 0; i < lines.size(); ++i)
     {
         // Cheap `lineId` filter first; multi-file sessions still
@@ -1623,7 +1642,7 @@ void LogModel::EmitRolesForAnchorKey(const AnchorManager::Key &key, const QList<
     // reverse map in sync across batch appends and FIFO eviction.
     // Cheap `lineId` filter first to skip the cache lookup on
     // misses (the bulk of the iterations).
-    const std::vector<loglib::LogLine> &lines = mLogTable.Data().Lines();
+    const loglib::LogLineStore &lines = mLogTable.Data().Lines();
     for (size_t i = 0; i < lines.size(); ++i)
     {
         if (static_cast<uint64_t>(lines[i].LineId()) != key.lineId)
@@ -2199,6 +2218,76 @@ bool LogModel::IsStreamingActive() const noexcept
     return mStreamingActive;
 }
 
+void LogModel::SetFullTextIndex(bool enabled, std::filesystem::path cacheDir)
+{
+    mFullTextIndex = enabled;
+    mFullTextIndexDir = std::move(cacheDir);
+    if (!enabled)
+    {
+        mLogTable.SetTrigramIndex(false);
+        mFullTextIndexBuildTime = std::chrono::milliseconds{0};
+        mFullTextIndexFromCache = false;
+        return;
+    }
+    // A file mid-parse gets its index from `EndStreaming`; a live tail
+    // indexes what it has and extends from there.
+    if (!mStreamingActive || mLogTable.Data().FrontStreamSource() != nullptr)
+    {
+        BringUpFullTextIndex();
+    }
+}
+
+bool LogModel::FullTextIndexEnabled() const noexcept
+{
+    return mFullTextIndex;
+}
+
+std::chrono::milliseconds LogModel::FullTextIndexBuildTime() const noexcept
+{
+    return mFullTextIndexBuildTime;
+}
+
+bool LogModel::FullTextIndexFromCache() const noexcept
+{
+    return mFullTextIndexFromCache;
+}
+
+void LogModel::BringUpFullTextIndex()
+{
+    if (!mFullTextIndex || mLogTable.TrigramIndexEnabled())
+    {
+        return;
+    }
+
+    // Persist only single-file sessions: the cache is keyed by the
+    // file's identity and the rows' signature, neither of which
+    // describes a merge or a live tail.
+    std::filesystem::path source;
+    const auto &sources = mLogTable.Data().Sources();
+    if (const loglib::FileLineSource *file = mLogTable.Data().FrontFileSource();
+        !mFullTextIndexDir.empty() && sources.size() == 1 && file != nullptr)
+    {
+        source = file->File().GetPath();
+    }
+
+    if (!source.empty() && mLogTable.LoadTrigramIndex(mFullTextIndexDir, source))
+    {
+        mFullTextIndexBuildTime = std::chrono::milliseconds{0};
+        mFullTextIndexFromCache = true;
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    mLogTable.SetTrigramIndex(true);
+    mFullTextIndexBuildTime =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    mFullTextIndexFromCache = false;
+    if (!source.empty())
+    {
+        (void)mLogTable.SaveTrigramIndex(mFullTextIndexDir, source);
+    }
+}
+
 void LogModel::SetRetentionCap(size_t cap)
 {
     mRetentionCap = cap;
@@ -2290,7 +2379,7 @@ void LogModel::UpdateTimestampMonotonicity(int firstNewRow, int endNewRow)
     int64_t runningMax = std::numeric_limits<int64_t>::min();
     for (int row = firstNewRow; row < endNewRow; ++row)
     {
-        const auto ts = loglib::AsEpochMicroseconds(mLogTable.GetValue(static_cast<std::size_t>(row), colIdx));
+        const auto ts = mLogTable.GetEpochMicroseconds(static_cast<std::size_t>(row), colIdx);
         if (!ts.has_value())
         {
             continue;
@@ -4,6 +4,7 @@
 #include "highlight_rule_set.hpp"
 #include "log_filter_model.hpp"
 #include "log_model.hpp"
+#include "qstring_path.hpp"
 #include "qt_streaming_log_sink.hpp"
 #include "row_order_proxy_model.hpp"
 
@@ -22,6 +23,7 @@
 #include <QModelIndex>
 #include <QPointer>
 #include <QSettings>
+#include <QStandardPaths>
 #include <QString>
 #include <QTimer>
 
@@ -29,6 +31,7 @@
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <filesystem>
 #include <limits>
 #include <optional>
 #include <utility>
@@ -87,6 +90,8 @@ LogSession::LogSession(
     connect(mModel, &QAbstractItemModel::columnsInserted, this, [this](const QModelIndex &, int, int) {
         mHighlights->RebindColumns(mModel->Configuration().columns, &mModel->Table());
     });
+
+    ApplyFullTextIndexPreference();
 }
 
 LogSession::~LogSession()
@@ -1008,6 +1013,25 @@ bool LogSession::ShouldAutoDetectRotationHistory() const
     return settings.value(QStringLiteral("ui/autoDetectRotatedHistory"), true).toBool();
 }
 
+bool LogSession::FullTextIndexPreference()
+{
+    const QSettings settings;
+    return settings.value(QStringLiteral("ui/fullTextIndex"), false).toBool();
+}
+
+void LogSession::ApplyFullTextIndexPreference()
+{
+    if (mModel == nullptr)
+    {
+        return;
+    }
+    // Same cache root as the gzip seek index (see `MainWindow`).
+    const QString cacheBase = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    std::filesystem::path indexDir =
+        cacheBase.isEmpty() ? std::filesystem::path{} : logapp::QStringToFsPath(cacheBase) / "trigram_index";
+    mModel->SetFullTextIndex(FullTextIndexPreference(), std::move(indexDir));
+}
+
 bool LogSession::EffectiveAutoDetectRotationHistory() const
 {
     if (!ShouldAutoDetectRotationHistory())
@@ -1229,8 +1253,8 @@ int LogSession::FindFirstRowAtOrAfterTimestamp(int timeCol, std::int64_t targetM
     // rows explicitly (treating them as `-inf` would break the
     // fast-path binary search's monotonicity invariant).
     const auto tsFor = [this, timeCol](int sourceRow) -> std::optional<std::int64_t> {
-        return loglib::AsEpochMicroseconds(
-            mModel->Table().GetValue(static_cast<std::size_t>(sourceRow), static_cast<std::size_t>(timeCol))
+        return mModel->Table().GetEpochMicroseconds(
+            static_cast<std::size_t>(sourceRow), static_cast<std::size_t>(timeCol)
         );
     };
 
@@ -126,3 +126,21 @@ loglib::CallbackStringRowPredicate::MatchFn MakeStringMatcher(const QString &pat
     }
     return [](std::string_view) { return false; };
 }
+
+loglib::TrigramQuery MakeStringTrigramQuery(const QString &pattern, loglib::LeafRule::Match match)
+{
+    using Match = loglib::LeafRule::Match;
+    switch (match)
+    {
+    case Match::Exactly:
+    case Match::Contains:
+        return loglib::TrigramQuery::ForLiteral(pattern.toStdString());
+    case Match::RegularExpression:
+        // An invalid pattern matches nothing (see `MakeStringMatcher`);
+        // the analyser answers `All` for it, which is merely loose.
+        return loglib::TrigramQuery::ForRegex(pattern.toStdString());
+    case Match::Wildcard:
+        return loglib::TrigramQuery::ForRegex(QRegularExpression::wildcardToRegularExpression(pattern).toStdString());
+    }
+    return {};
+}
@@ -38,6 +38,7 @@
 #include <loglib/format_detection.hpp>
 #include <loglib/internal/ascii_case.hpp>
 #include <loglib/internal/decompressing_byte_source.hpp>
+#include <loglib/internal/growing_byte_buffer.hpp>
 #include <loglib/internal/stdin_peek.hpp>
 #include <loglib/log_configuration.hpp>
 #include <loglib/log_factory.hpp>
@@ -1239,6 +1240,18 @@ MainWindow::MainWindow(
         ui->menuSettings->addAction(mActionUndoRotationExpansion);
 
         SyncRotationHistoryActionCheckedState();
+
+        mActionFullTextIndex = new QAction(tr("Full-text index for Find and filters"), this);
+        mActionFullTextIndex->setObjectName(QStringLiteral("actionFullTextIndex"));
+        mActionFullTextIndex->setCheckable(true);
+        mActionFullTextIndex->setChecked(LogSession::FullTextIndexPreference());
+        mActionFullTextIndex->setToolTip(
+            tr("Index every text field once a file finishes loading so Find and text filters skip rows that "
+               "cannot match. Costs memory (see Configuration diagnostics); the index is cached per file.")
+        );
+        connect(mActionFullTextIndex, &QAction::toggled, this, &MainWindow::OnFullTextIndexPrefToggled);
+        ui->menuSettings->addSeparator();
+        ui->menuSettings->addAction(mActionFullTextIndex);
     }
 
     // Settings -> Regex templates... opens the dedicated editor.
@@ -4025,6 +4038,22 @@ void MainWindow::OnRotationHistoryPrefToggled(bool enabled)
     SyncRotationHistoryActionCheckedState();
 }
 
+void MainWindow::OnFullTextIndexPrefToggled(bool enabled)
+{
+    QSettings settings;
+    if (settings.value(QStringLiteral("ui/fullTextIndex"), false).toBool() != enabled)
+    {
+        settings.setValue(QStringLiteral("ui/fullTextIndex"), enabled);
+    }
+    for (LogSession *session : hostedSessions())
+    {
+        if (session != nullptr)
+        {
+            session->ApplyFullTextIndexPreference();
+        }
+    }
+}
+
 bool MainWindow::ShouldAutoDetectRotationHistory() const
 {
     return mSession->ShouldAutoDetectRotationHistory();
@@ -4723,12 +4752,19 @@ bool MainWindow::ContinueOpenAfterPrepared(
     }
     const bool originIsActive = origin == mSession;
 
+    // A progressive decode is still filling its buffer; the parse
+    // reads it as it grows instead of mapping a finished temp file.
+    const std::shared_ptr<loglib::internal::GrowingByteBuffer> progressiveBytes =
+        decompressionAnchor ? decompressionAnchor->ProgressiveBuffer() : nullptr;
+
     // Open on the GUI thread so any I/O failure surfaces alongside
     // the queue drain rather than through the async future.
     std::unique_ptr<loglib::LogFile> logFile;
     try
     {
-        logFile = std::make_unique<loglib::LogFile>(effectivePath, logapp::QStringToFsPath(originalPath));
+        logFile = progressiveBytes
+                      ? std::make_unique<loglib::LogFile>(progressiveBytes, logapp::QStringToFsPath(originalPath))
+                      : std::make_unique<loglib::LogFile>(effectivePath, logapp::QStringToFsPath(originalPath));
     }
     catch (const std::exception &e)
     {
@@ -4768,6 +4804,17 @@ bool MainWindow::ContinueOpenAfterPrepared(
 
     auto cfg = std::make_shared<const loglib::LogConfiguration>(model->Configuration());
 
+    // Per-file parser detection runs against the effective (possibly
+    // decompressed) bytes so the sniff sees the actual content. The
+    // progressive constructor returned only after more than the probe
+    // budget was decoded, so the head is already in the buffer.
+    const DetectedFormat detectedPerFile =
+        progressiveBytes
+            ? loglib::DetectFormatFromBytes(
+                  std::string_view(logFile->Data(), std::min(logFile->Size(), loglib::PROBE_BYTES_BUDGET))
+              )
+            : DetectFormatForPath(effectivePath);
+
     const bool isFirstFileInSession = !origin->IsSessionActive();
 
     origin->SetStreamingFileName(QFileInfo(originalPath).fileName());
@@ -4783,13 +4830,12 @@ bool MainWindow::ContinueOpenAfterPrepared(
     auto &currentSource = origin->MutableCurrentSource();
     if (isFirstFileInSession)
     {
-        DetectedFormat detected = DetectFormatForPath(effectivePath);
         currentSource = loglib::LogConfiguration::Source{
             .kind = loglib::LogConfiguration::Source::Kind::File,
-            .format = detected.format,
+            .format = detectedPerFile.format,
             .locators = {displayPath},
             .locatorDedupKeys = {dedupKey},
-            .regexPattern = std::move(detected.regexPattern),
+            .regexPattern = detectedPerFile.regexPattern,
         };
         // Seed the source from the global preference and CLI override.
         currentSource->followRotationSiblings = ShouldAutoDetectRotationHistory();
@@ -4837,10 +4883,7 @@ bool MainWindow::ContinueOpenAfterPrepared(
     loglib::ParserOptions options;
     options.configuration = std::move(cfg);
 
-    // Per-file parser detection runs against the effective (possibly
-    // decompressed) path so the sniff sees the actual bytes.
     // `origin->MutableCurrentSource()` still stores the first file's session-level format.
-    const DetectedFormat detectedPerFile = DetectFormatForPath(effectivePath);
     std::shared_ptr<loglib::LogParser> parser =
         MakeParserForFormat(detectedPerFile.format, detectedPerFile.regexPattern);
 
@@ -4936,13 +4979,18 @@ void MainWindow::BeginAsyncDecompression(
     // bundle names survive the hop into the worker (see the
     // `file_size` note above).
     const std::filesystem::path input = logapp::QStringToFsPath(originalPath);
+    // Gzip restart points are cached across opens (see `GzipSeekIndex`);
+    // no cache location just disables them.
+    const QString cacheBase = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    const std::filesystem::path seekIndexDir =
+        cacheBase.isEmpty() ? std::filesystem::path{} : logapp::QStringToFsPath(cacheBase) / "seek_index";
     // `clang-analyzer-webkit.UncountedLambdaCapturesChecker` is WebKit-specific
     // and misclassifies `QAtomicInteger *` captures -- they are `this` members
     // guarded by `mSession->IsDecompressionInFlight()`. `bugprone-exception-escape` is a
     // false positive on `QtConcurrent::run`, which stores any escaped
     // exception into the returned `QFuture`.
     // NOLINTNEXTLINE(clang-analyzer-webkit.UncountedLambdaCapturesChecker,bugprone-exception-escape)
-    auto future = QtConcurrent::run([input, sharedBytesIn, sharedTotal, stopToken, isSessionBundle]() {
+    auto future = QtConcurrent::run([input, seekIndexDir, sharedBytesIn, sharedTotal, stopToken, isSessionBundle]() {
         // NOLINTNEXTLINE(clang-analyzer-webkit.UncountedLambdaCapturesChecker)
         auto progressCb = [sharedBytesIn, sharedTotal](const loglib::internal::DecompressingByteSource::Progress &p) {
             // Relaxed: the GUI only needs a recent-enough snapshot.
@@ -4951,6 +4999,10 @@ void MainWindow::BeginAsyncDecompression(
         };
         loglib::internal::DecompressingByteSource::Options options;
         options.discardFirstLine = isSessionBundle;
+        // Rows start appearing while the rest decodes. Bundles need
+        // their metadata line up front and keep the temp-file decode.
+        options.progressive = true;
+        options.seekIndexDir = seekIndexDir;
         return std::make_shared<loglib::internal::DecompressingByteSource>(
             input, std::move(progressCb), stopToken, options
         );
@@ -5251,6 +5303,14 @@ void MainWindow::OnDecompressionFinishedFor(LogSession *origin)
     {
         errorEntry = tr("Failed to decompress '%1': unknown error").arg(origin->DecompressionOriginalPath());
     }
+    // A progressive decode hands over before the stream ends, so a
+    // cancel can land after the worker already returned. Honour it;
+    // dropping `dbs` stops the decoder.
+    if (dbs && origin->DecompressionStopSource().stop_requested())
+    {
+        dbs.reset();
+        cancelled = true;
+    }
     // Report malformed metadata as a bundle error, not a codec error.
     if (errorEntry.isEmpty() && !cancelled && dbs && IsSessionBundlePath(origin->DecompressionOriginalPath()))
     {
@@ -5389,8 +5449,23 @@ void MainWindow::OnDecompressionFinishedFor(LogSession *origin)
 
     // Success. Emit the "Decompressed X -> Y in Zs" toast before
     // the parse-status label overwrites it; the timeout gives a
-    // 5 s window that survives a fast parse start.
-    if (dbs)
+    // 5 s window that survives a fast parse start. A progressive
+    // decode has no final size yet, so it names the codec only.
+    if (dbs && dbs->IsProgressive())
+    {
+        const std::string_view codecName = loglib::internal::CodecName(dbs->DetectedCodec());
+        PostStatusMessage(
+            origin,
+            tr("Decompressing %1 (%2, %3) while parsing")
+                .arg(
+                    QFileInfo(origin->DecompressionOriginalPath()).fileName(),
+                    HumanBytes(dbs->CompressedSize()),
+                    QString::fromLatin1(codecName.data(), static_cast<qsizetype>(codecName.size()))
+                ),
+            STATUS_BAR_MESSAGE_TIMEOUT_MS
+        );
+    }
+    else if (dbs)
     {
         const auto elapsed = std::chrono::steady_clock::now() - origin->DecompressionStartedAt();
         // Explicit size (see the matching site in `BeginAsyncDecompression`).
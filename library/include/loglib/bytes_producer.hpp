@@ -51,6 +51,19 @@ public:
     /// and returns 0.
     virtual size_t Read(std::span<char> buffer) = 0;
 
+    /// True iff `BorrowBytes` is implemented. Callers that see `false`
+    /// use `Read`.
+    [[nodiscard]] virtual bool SupportsBorrowedBytes() const noexcept;
+
+    /// Zero-copy alternative to `Read`: borrow up to @p maxBytes queued
+    /// bytes in place. Empty when nothing is queued. The span stays
+    /// valid until `ReleaseBorrowedBytes`, which must be called before
+    /// the next `BorrowBytes` / `Read`. Default: always empty.
+    [[nodiscard]] virtual std::span<const char> BorrowBytes(size_t maxBytes);
+
+    /// End the outstanding `BorrowBytes`. Default no-op.
+    virtual void ReleaseBorrowedBytes() noexcept;
+
     /// Block until at least one byte is available, the deadline
     /// elapses, or `Stop()` is called. Spurious wakeups are allowed;
     /// callers must re-check via `Read`.
@@ -1,15 +1,36 @@
 #pragma once
 
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 
 namespace loglib::internal
 {
 
+/// Parameters the static pipeline is running with, as reported to
+/// `AdvancedParserOptions::onTuning`.
+struct PipelineTuning
+{
+    unsigned int threads = 1;
+    size_t ntokens = 0;
+    size_t batchSizeBytes = 0;
+    /// Batches Stage C had finished when these parameters took effect.
+    uint64_t observedBatches = 0;
+    /// Smoothed observations behind the choice; zero before the first
+    /// batch completes.
+    double bytesPerLine = 0.0;
+    std::chrono::nanoseconds stageBLatency{0};
+    std::chrono::nanoseconds stageCLatency{0};
+};
+
 /// Tuning knobs for the streaming pipeline. Defaults reproduce the
 /// public `Parse(path)` behaviour.
 struct AdvancedParserOptions
 {
-    /// Cap on oneTBB parallelism.
+    /// Starting cap on oneTBB parallelism when `threads == 0`.
+    /// `autotune` lifts it up to `hardware_concurrency` once Stage B
+    /// is measured to be the bottleneck.
     static constexpr unsigned int DEFAULT_MAX_THREADS = 8;
 
     /// Stage A batch byte target.
@@ -20,6 +41,20 @@ struct AdvancedParserOptions
 
     /// Auto-expanded so a line never spans batches.
     size_t batchSizeBytes = DEFAULT_BATCH_SIZE_BYTES;
+
+    /// Retune the batch size when `batchSizeBytes` is left at its
+    /// default and, when `threads == 0`, the worker and token counts
+    /// from observed Stage B latency and bytes per line; see
+    /// `PipelineAutotuner`. An explicit `batchSizeBytes` is kept.
+    /// Parsers whose Stage A ignores the requested size keep a fixed
+    /// batch size regardless.
+    bool autotune = true;
+
+    /// Instrumentation hook, called whenever the chosen parameters
+    /// change: on the calling thread before each pipeline run, and
+    /// from the serial Stage C when the batch size moves. Unset by
+    /// default.
+    std::function<void(const PipelineTuning &)> onTuning;
 };
 
 } // namespace loglib::internal
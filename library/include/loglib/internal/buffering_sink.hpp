@@ -41,7 +41,7 @@ public:
 private:
     std::unique_ptr<FileLineSource> mSource;
     KeyIndex mKeys;
-    std::vector<LogLine> mLines;
+    LogLineStore mLines;
     std::vector<uint64_t> mLineOffsets;
     std::vector<MultiLineRecordSpan> mMultiLineSpans;
     std::vector<std::string> mErrors;
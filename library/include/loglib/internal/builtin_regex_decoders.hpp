@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace loglib::internal
+{
+
+/// Hand-written matcher for one built-in regex template, used instead
+/// of PCRE2 when a parser's pattern is byte-identical to `pattern`.
+///
+/// `decode` fills one capture per named group in pattern order (empty
+/// for a group that did not participate) and returns true only when
+/// PCRE2's first match takes the same path. It follows the pattern's
+/// greedy choices without backtracking; any line that would need a
+/// backtrack, or whose `.*` tail holds a `\r` / `\n`, returns false and
+/// goes through PCRE2, so the emitted values never differ.
+struct BuiltinRegexDecoder
+{
+    std::string_view name;
+    std::string_view pattern;
+    size_t groupCount = 0;
+    bool (*decode)(std::string_view line, std::vector<std::string_view> &captures) = nullptr;
+};
+
+/// Every specialised decoder, for tests and benchmarks.
+[[nodiscard]] std::span<const BuiltinRegexDecoder> BuiltinRegexDecoders() noexcept;
+
+/// Decoder whose pattern equals @p pattern byte for byte, or nullptr.
+[[nodiscard]] const BuiltinRegexDecoder *FindBuiltinRegexDecoder(std::string_view pattern) noexcept;
+
+} // namespace loglib::internal
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <string_view>
+
+namespace loglib::internal
+{
+
+/// Bytes classified per call; one bit per byte in each mask.
+inline constexpr size_t BYTE_CLASS_BLOCK_BYTES = 64;
+
+/// Most literal byte values one `ByteClassSet` can hold.
+inline constexpr size_t MAX_CLASSIFIED_BYTES = 4;
+
+/// Literal byte values a tokenizer stops on, e.g. `=`, `"` and `\`
+/// for logfmt.
+struct ByteClassSet
+{
+    std::array<char, MAX_CLASSIFIED_BYTES> bytes{};
+    size_t count = 0;
+
+    constexpr ByteClassSet(std::initializer_list<char> values) noexcept
+    {
+        for (const char value : values)
+        {
+            if (count < MAX_CLASSIFIED_BYTES)
+            {
+                bytes[count++] = value;
+            }
+        }
+    }
+};
+
+/// Classification of one `BYTE_CLASS_BLOCK_BYTES` block: bit i
+/// describes byte i.
+struct ByteClassMasks
+{
+    /// One mask per `ByteClassSet::bytes` entry, in the same order.
+    std::array<uint64_t, MAX_CLASSIFIED_BYTES> bytes{};
+    /// Bytes at or below `' '` compared unsigned: ASCII controls and space.
+    uint64_t controlOrSpace = 0;
+};
+
+/// Classify the `BYTE_CLASS_BLOCK_BYTES` bytes at @p block, which must
+/// all be readable. Dispatches once per process to the widest kernel
+/// the CPU supports (AVX2, SSE2, or scalar).
+[[nodiscard]] ByteClassMasks ClassifyBlock(const char *block, const ByteClassSet &set) noexcept;
+
+/// Portable reference kernel; `ClassifyBlock` must agree with it bit for bit.
+[[nodiscard]] ByteClassMasks ClassifyBlockScalar(const char *block, const ByteClassSet &set) noexcept;
+
+/// Name of the kernel `ClassifyBlock` dispatches to, for benchmark reports.
+[[nodiscard]] std::string_view ByteClassKernelName() noexcept;
+
+/// Inclusive prefix XOR: bit i of the result is the parity of bits 0..i
+/// of @p bits. Applied to a quote mask it marks the bytes from each
+/// opening quote up to (not including) its closing quote. This is the
+/// carry-less multiply by all ones, spelled as a shift ladder so it stays
+/// portable and constexpr.
+[[nodiscard]] constexpr uint64_t PrefixXor(uint64_t bits) noexcept
+{
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+/// Forward scanner over one byte range that keeps the current block's
+/// masks, so consecutive searches inside a block cost a shift and a
+/// count-trailing-zeros. Blocks are aligned to the range start; a block
+/// that would read past @p readableEnd (at least the range end) is
+/// classified from a zero-padded copy instead.
+class ByteClassCursor
+{
+public:
+    ByteClassCursor(std::string_view range, const char *readableEnd, const ByteClassSet &set) noexcept
+        : mRange(range), mReadableEnd(readableEnd), mSet(set)
+    {
+    }
+
+    /// First offset at or after @p from whose bit is set in
+    /// `select(masks)`, or the range size when there is none. Bits past
+    /// the range end are ignored.
+    template <class Select> [[nodiscard]] size_t Find(size_t from, Select select) noexcept
+    {
+        while (from < mRange.size())
+        {
+            const size_t blockStart = from - (from % BYTE_CLASS_BLOCK_BYTES);
+            Load(blockStart);
+            const uint64_t hits = select(mMasks) >> (from - blockStart);
+            if (hits != 0)
+            {
+                return std::min(from + static_cast<size_t>(std::countr_zero(hits)), mRange.size());
+            }
+            from = blockStart + BYTE_CLASS_BLOCK_BYTES;
+        }
+        return mRange.size();
+    }
+
+private:
+    void Load(size_t blockStart) noexcept
+    {
+        if (blockStart == mBlockStart)
+        {
+            return;
+        }
+        mBlockStart = blockStart;
+        const char *block = mRange.data() + blockStart;
+        if (static_cast<size_t>(mReadableEnd - block) >= BYTE_CLASS_BLOCK_BYTES)
+        {
+            mMasks = ClassifyBlock(block, mSet);
+            return;
+        }
+        std::array<char, BYTE_CLASS_BLOCK_BYTES> padded{};
+        std::memcpy(padded.data(), block, mRange.size() - blockStart);
+        mMasks = ClassifyBlock(padded.data(), mSet);
+    }
+
+    std::string_view mRange;
+    const char *mReadableEnd;
+    ByteClassSet mSet;
+    size_t mBlockStart = static_cast<size_t>(-1);
+    ByteClassMasks mMasks;
+};
+
+} // namespace loglib::internal
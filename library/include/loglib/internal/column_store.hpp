@@ -0,0 +1,160 @@
+#pragma once
+
+#include "loglib/internal/compact_log_value.hpp"
+#include "loglib/key_index.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace loglib::internal
+{
+
+/// Column-major mirror of one `LogTable` column: the slot each row
+/// resolves to, split into parallel tag / payload / length arrays.
+/// Typed scans (time, numeric, bool, enum id) walk three contiguous
+/// arrays instead of chasing one `CompactLineFields` block per row.
+/// String slots keep their `(offset, length)` pair; the bytes still
+/// live in the row's `LineSource`.
+///
+/// `EraseFront` advances a head cursor and compacts once the dead
+/// prefix outgrows the live rows, so prefix eviction is amortised O(1)
+/// per row.
+class DenseColumn
+{
+public:
+    [[nodiscard]] size_t Size() const noexcept
+    {
+        return mTags.size() - mHead;
+    }
+
+    [[nodiscard]] bool Empty() const noexcept
+    {
+        return Size() == 0;
+    }
+
+    [[nodiscard]] CompactTag Tag(size_t row) const noexcept
+    {
+        return mTags[mHead + row];
+    }
+
+    [[nodiscard]] uint64_t Payload(size_t row) const noexcept
+    {
+        return mPayloads[mHead + row];
+    }
+
+    /// String length for `MmapSlice` / `OwnedString` rows; 0 otherwise.
+    [[nodiscard]] uint32_t Length(size_t row) const noexcept
+    {
+        return mLengths[mHead + row];
+    }
+
+    /// Reassemble the row's slot.
+    [[nodiscard]] CompactLogValue Slot(size_t row) const noexcept;
+
+    [[nodiscard]] std::span<const CompactTag> Tags() const noexcept
+    {
+        return std::span<const CompactTag>(mTags).subspan(mHead);
+    }
+
+    [[nodiscard]] std::span<const uint64_t> Payloads() const noexcept
+    {
+        return std::span<const uint64_t>(mPayloads).subspan(mHead);
+    }
+
+    [[nodiscard]] std::span<const uint32_t> Lengths() const noexcept
+    {
+        return std::span<const uint32_t>(mLengths).subspan(mHead);
+    }
+
+    void Reserve(size_t rows);
+
+    void Append(const CompactLogValue &slot);
+
+    /// Drop the first @p count rows. @p count past `Size()` clears.
+    void EraseFront(size_t count);
+
+    void Clear() noexcept;
+
+    /// Heap bytes owned (capacity, not size).
+    [[nodiscard]] size_t MemoryBytes() const noexcept;
+
+private:
+    std::vector<CompactTag> mTags;
+    std::vector<uint64_t> mPayloads;
+    std::vector<uint32_t> mLengths;
+    /// First live row; everything before it is an evicted prefix
+    /// awaiting compaction.
+    size_t mHead = 0;
+};
+
+/// Per-table set of `DenseColumn`s. Each column remembers the alias
+/// `KeyId` list it was built against so the owner can detect a
+/// re-resolved column and rebuild it rather than serve stale slots.
+class ColumnStore
+{
+public:
+    [[nodiscard]] bool Enabled() const noexcept
+    {
+        return mEnabled;
+    }
+
+    /// Turning the store off frees every column.
+    void SetEnabled(bool enabled) noexcept;
+
+    [[nodiscard]] size_t ColumnCount() const noexcept
+    {
+        return mColumns.size();
+    }
+
+    /// Grow or shrink to @p columnCount; new columns start empty.
+    void Resize(size_t columnCount);
+
+    [[nodiscard]] DenseColumn &Column(size_t index) noexcept
+    {
+        return mColumns[index].column;
+    }
+
+    [[nodiscard]] const DenseColumn &Column(size_t index) const noexcept
+    {
+        return mColumns[index].column;
+    }
+
+    [[nodiscard]] const std::vector<KeyId> &ColumnKeys(size_t index) const noexcept
+    {
+        return mColumns[index].keyIds;
+    }
+
+    void SetColumnKeys(size_t index, const std::vector<KeyId> &keyIds);
+
+    /// Drop column @p index's rows; the owner's next sync rebuilds it.
+    void Invalidate(size_t index) noexcept;
+
+    /// Mirror of `LogConfigurationManager::MoveColumn`.
+    void MoveColumn(size_t srcIndex, size_t destIndex);
+
+    /// Drop the first @p count rows from every column. Columns shorter
+    /// than @p count were stale anyway and are cleared.
+    void EraseFrontRows(size_t count);
+
+    void Clear() noexcept;
+
+    /// Heap bytes owned across all columns.
+    [[nodiscard]] size_t MemoryBytes() const noexcept;
+
+private:
+    // NOLINTBEGIN(misc-non-private-member-variables-in-classes)
+    // Private nested aggregate: public members are intentional.
+    struct Entry
+    {
+        DenseColumn column;
+        std::vector<KeyId> keyIds;
+    };
+    // NOLINTEND(misc-non-private-member-variables-in-classes)
+
+    std::vector<Entry> mColumns;
+    bool mEnabled = false;
+};
+
+} // namespace loglib::internal
@@ -4,10 +4,14 @@
 #include "loglib/key_index.hpp"
 #include "loglib/log_value.hpp"
 
+#include <compare>
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 namespace loglib
 {
@@ -74,9 +78,25 @@ CompactLogValue ToCompactLogValue(
 /// Add @p delta to every `OwnedString` payload in @p values.
 void RebaseOwnedStringOffsets(std::pair<KeyId, CompactLogValue> *values, size_t valueCount, uint64_t delta) noexcept;
 
-/// Per-line compact field storage: exact-fit heap array of `(KeyId,
-/// CompactLogValue)` pairs sorted by KeyId. Pointer+size+capacity = 16 B,
-/// avoiding `std::vector`'s reserve overhead on narrow rows.
+/// Bare-value overload for the shaped `CompactLineFields` layout.
+void RebaseOwnedStringOffsets(CompactLogValue *values, size_t valueCount, uint64_t delta) noexcept;
+
+/// Per-line compact field storage, 16 B (pointer + size + capacity) in
+/// either of two exact-fit layouts:
+///
+/// - Keyed: `(KeyId, CompactLogValue)` pairs sorted by KeyId (24 B per
+///   field). Built by `AssignSorted` / `EmplaceBack` / `Insert`.
+/// - Shaped: bare `CompactLogValue`s (16 B per field) in the slot order
+///   of an interned `RowShape`, which holds the KeyIds once for every
+///   row of that key set. Built by `AssignShaped`.
+///
+/// The buffer only records which layout it holds; the owner (`LogLine`)
+/// keeps the shape. Keyed accessors (`Data`, `begin` / `end`, `Insert`,
+/// ...) are only meaningful while `!IsShaped()`.
+///
+/// Blocks come from the calling thread's `LineFieldSlab` when one is
+/// installed (static-pipeline Stage B), else from `operator new`; slab
+/// blocks are never freed individually.
 class CompactLineFields
 {
 public:
@@ -84,7 +104,7 @@ public:
 
     CompactLineFields() = default;
 
-    /// Allocates @p initialCapacity slots without constructing them.
+    /// Allocates @p initialCapacity keyed slots without constructing them.
     explicit CompactLineFields(uint32_t initialCapacity);
 
     CompactLineFields(const CompactLineFields &) = delete;
@@ -101,7 +121,7 @@ public:
 
     [[nodiscard]] uint32_t Capacity() const noexcept
     {
-        return mCapacity;
+        return mCapacity & ~(SHAPED_FLAG | SLAB_FLAG);
     }
 
     [[nodiscard]] bool Empty() const noexcept
@@ -109,44 +129,66 @@ public:
         return mSize == 0;
     }
 
+    /// True when the buffer holds the shaped (values-only) layout.
+    [[nodiscard]] bool IsShaped() const noexcept
+    {
+        return (mCapacity & SHAPED_FLAG) != 0;
+    }
+
     [[nodiscard]] value_type *Data() noexcept
     {
-        return mData;
+        return static_cast<value_type *>(mData);
     }
 
     [[nodiscard]] const value_type *Data() const noexcept
     {
-        return mData;
+        return static_cast<const value_type *>(mData);
+    }
+
+    /// Shaped-layout values, indexed by `RowShape` slot.
+    [[nodiscard]] CompactLogValue *ShapedData() noexcept
+    {
+        return static_cast<CompactLogValue *>(mData);
+    }
+
+    [[nodiscard]] const CompactLogValue *ShapedData() const noexcept
+    {
+        return static_cast<const CompactLogValue *>(mData);
     }
 
     [[nodiscard]] value_type *begin() noexcept
     {
-        return mData;
+        return Data();
     }
 
     [[nodiscard]] value_type *end() noexcept
     {
-        return mData + mSize;
+        return Data() + mSize;
     }
 
     [[nodiscard]] const value_type *begin() const noexcept
     {
-        return mData;
+        return Data();
     }
 
     [[nodiscard]] const value_type *end() const noexcept
     {
-        return mData + mSize;
+        return Data() + mSize;
     }
 
-    /// Grow capacity to at least @p capacity. No-op if already large enough.
+    /// Grow keyed capacity to at least @p capacity. No-op if already large
+    /// enough.
     void Reserve(uint32_t capacity);
 
-    /// Replace contents with @p values; reuses the buffer when large
-    /// enough, else reallocates exact-fit.
+    /// Replace contents with @p values in the keyed layout; reuses a keyed
+    /// buffer when large enough, else reallocates exact-fit.
     void AssignSorted(const value_type *values, uint32_t count);
     void AssignSorted(std::vector<value_type> &&values);
 
+    /// Replace contents with the values of @p values in the shaped layout
+    /// (KeyIds dropped). Always exact-fit.
+    void AssignShaped(const value_type *values, uint32_t count);
+
     /// Append at the end; caller must keep the array sorted.
     void EmplaceBack(KeyId key, CompactLogValue value);
 
@@ -162,11 +204,183 @@ public:
     void ShrinkToFit();
 
 private:
-    value_type *mData = nullptr;
+    /// Layout bit, kept in the top bit of `mCapacity`.
+    static constexpr uint32_t SHAPED_FLAG = uint32_t{1} << 31;
+    /// Set when `mData` was carved from a `LineFieldSlab`.
+    static constexpr uint32_t SLAB_FLAG = uint32_t{1} << 30;
+
+    /// Free `mData` unless a slab owns it.
+    void ReleaseBlock() noexcept;
+
+    /// Release the current block and take @p data with the given flags.
+    void AdoptBlock(void *data, bool fromSlab, uint32_t capacity, uint32_t layoutFlag) noexcept;
+
+    void *mData = nullptr;
     uint32_t mSize = 0;
     uint32_t mCapacity = 0;
 };
 
+/// Read-only view of a row's fields as `(KeyId, CompactLogValue)` in
+/// ascending KeyId order, over either `CompactLineFields` layout.
+/// Elements are `std::pair<KeyId, const CompactLogValue &>` proxies, so
+/// structured bindings and `.first` / `.second` work as on a span of
+/// pairs; the values are not copied. `value_type` is the proxy too, which
+/// keeps the iterator a valid `std::input_iterator` for `<ranges>`
+/// algorithms; construct a `std::vector<std::pair<KeyId,
+/// CompactLogValue>>` from the range for an owned copy.
+class CompactFieldsView
+{
+public:
+    using reference = std::pair<KeyId, const CompactLogValue &>;
+    using value_type = reference;
+
+    class iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using iterator_concept = std::random_access_iterator_tag;
+        using value_type = CompactFieldsView::value_type;
+        using reference = CompactFieldsView::reference;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        iterator(const CompactFieldsView &view, uint32_t index) noexcept
+            : mPairs(view.mPairs), mKeys(view.mKeys), mValues(view.mValues), mIndex(index)
+        {
+        }
+
+        reference operator*() const noexcept
+        {
+            return (*this)[0];
+        }
+
+        reference operator[](difference_type n) const noexcept
+        {
+            const auto i = static_cast<size_t>(static_cast<difference_type>(mIndex) + n);
+            return mPairs != nullptr ? reference{mPairs[i].first, mPairs[i].second} : reference{mKeys[i], mValues[i]};
+        }
+
+        iterator &operator++() noexcept
+        {
+            ++mIndex;
+            return *this;
+        }
+
+        iterator operator++(int) noexcept
+        {
+            iterator copy = *this;
+            ++mIndex;
+            return copy;
+        }
+
+        iterator &operator--() noexcept
+        {
+            --mIndex;
+            return *this;
+        }
+
+        iterator operator--(int) noexcept
+        {
+            iterator copy = *this;
+            --mIndex;
+            return copy;
+        }
+
+        iterator &operator+=(difference_type n) noexcept
+        {
+            mIndex = static_cast<uint32_t>(static_cast<difference_type>(mIndex) + n);
+            return *this;
+        }
+
+        iterator &operator-=(difference_type n) noexcept
+        {
+            return *this += -n;
+        }
+
+        friend iterator operator+(iterator it, difference_type n) noexcept
+        {
+            return it += n;
+        }
+
+        friend iterator operator+(difference_type n, iterator it) noexcept
+        {
+            return it += n;
+        }
+
+        friend iterator operator-(iterator it, difference_type n) noexcept
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const iterator &lhs, const iterator &rhs) noexcept
+        {
+            return static_cast<difference_type>(lhs.mIndex) - static_cast<difference_type>(rhs.mIndex);
+        }
+
+        friend bool operator==(const iterator &lhs, const iterator &rhs) noexcept
+        {
+            return lhs.mIndex == rhs.mIndex;
+        }
+
+        friend std::strong_ordering operator<=>(const iterator &lhs, const iterator &rhs) noexcept
+        {
+            return lhs.mIndex <=> rhs.mIndex;
+        }
+
+    private:
+        const std::pair<KeyId, CompactLogValue> *mPairs = nullptr;
+        const KeyId *mKeys = nullptr;
+        const CompactLogValue *mValues = nullptr;
+        uint32_t mIndex = 0;
+    };
+
+    CompactFieldsView() = default;
+
+    /// Keyed layout.
+    CompactFieldsView(const std::pair<KeyId, CompactLogValue> *pairs, uint32_t size) noexcept
+        : mPairs(pairs), mSize(size)
+    {
+    }
+
+    /// Shaped layout: `keys[i]` labels `values[i]`.
+    CompactFieldsView(const KeyId *keys, const CompactLogValue *values, uint32_t size) noexcept
+        : mKeys(keys), mValues(values), mSize(size)
+    {
+    }
+
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return mSize;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return mSize == 0;
+    }
+
+    [[nodiscard]] reference operator[](size_t i) const noexcept
+    {
+        return begin()[static_cast<std::ptrdiff_t>(i)];
+    }
+
+    [[nodiscard]] iterator begin() const noexcept
+    {
+        return {*this, 0};
+    }
+
+    [[nodiscard]] iterator end() const noexcept
+    {
+        return {*this, mSize};
+    }
+
+private:
+    const std::pair<KeyId, CompactLogValue> *mPairs = nullptr;
+    const KeyId *mKeys = nullptr;
+    const CompactLogValue *mValues = nullptr;
+    uint32_t mSize = 0;
+};
+
 /// `CompactLineFields` packs three pointer/size words; growing past this
 /// would inflate every per-line allocation and break the cache-friendly
 /// layout the parsers rely on. The static_assert below is the enforcer.
@@ -1,6 +1,13 @@
 #pragma once
 
+#include "loglib/internal/byte_classes.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <string_view>
 
@@ -18,20 +25,14 @@ struct CsvCell
     bool fromScratch = false;
 };
 
-/// Tokenize one CSV record using RFC 4180 quoting with lax recovery.
-/// Calls @p emit per cell and rejects unterminated quoted cells.
-///
-/// Grammar: cells separated by `,`; a leading `"` opens a quoted cell
-/// closed by an unescaped `"`, with `""` decoded to a literal `"`; an
-/// unquoted cell ends at the next `,` or EOL; a trailing `,` emits one
-/// final empty cell.
-///
-/// @p quotedScratch stores unescaped quoted cells.
-template <class Emit> bool TokenizeCsvLine(std::string_view line, std::string &quotedScratch, Emit emit)
+/// Scalar RFC 4180 state machine behind `TokenizeCsvLine`, resuming at
+/// cell start @p from. Also the reference the block path must match.
+template <class Emit>
+bool TokenizeCsvLineScalar(std::string_view line, std::size_t from, std::string &quotedScratch, Emit &emit)
 {
     const char *const data = line.data();
     const std::size_t end = line.size();
-    std::size_t i = 0;
+    std::size_t i = from;
 
     while (true)
     {
@@ -151,4 +152,156 @@ template <class Emit> bool TokenizeCsvLine(std::string_view line, std::string &q
     }
 }
 
+/// Emit the cell spanning `[cellStart, cellEnd)`, which holds
+/// @p quoteCount `"` bytes, if the block path can prove the scalar
+/// tokenizer would produce the same cell and stop at @p cellEnd.
+/// Returns false (having emitted nothing) otherwise.
+template <class Emit>
+bool EmitCsvBlockCell(
+    std::string_view line,
+    std::size_t cellStart,
+    std::size_t cellEnd,
+    std::size_t quoteCount,
+    std::string &quotedScratch,
+    Emit &emit
+)
+{
+    CsvCell cell;
+    if (quoteCount == 0)
+    {
+        cell.value = line.substr(cellStart, cellEnd - cellStart);
+        emit(cell);
+        return true;
+    }
+
+    // A quoted cell must open at its first byte and close on its last.
+    // Anything else (a stray `"` mid-cell, bytes after the closing
+    // quote) is lax recovery and left to the scalar path.
+    if (cellEnd - cellStart < 2 || line[cellStart] != '"' || line[cellEnd - 1] != '"')
+    {
+        return false;
+    }
+    const std::string_view rawInner = line.substr(cellStart + 1, cellEnd - cellStart - 2);
+    cell.wasQuoted = true;
+    if (quoteCount == 2)
+    {
+        cell.value = rawInner;
+        emit(cell);
+        return true;
+    }
+
+    // Inner quotes must pair up as `""` escapes, left to right, exactly
+    // as the scalar scan consumes them.
+    quotedScratch.clear();
+    quotedScratch.reserve(rawInner.size());
+    for (std::size_t j = 0; j < rawInner.size(); ++j)
+    {
+        if (rawInner[j] == '"')
+        {
+            if (j + 1 >= rawInner.size() || rawInner[j + 1] != '"')
+            {
+                return false;
+            }
+            ++j;
+        }
+        quotedScratch.push_back(rawInner[j]);
+    }
+    cell.value = std::string_view(quotedScratch);
+    cell.fromScratch = true;
+    emit(cell);
+    return true;
+}
+
+/// simdcsv-style pass over @p line: per `BYTE_CLASS_BLOCK_BYTES` block,
+/// the `"` mask's prefix XOR gives the in-quote bytes, and commas outside
+/// quotes are the cell separators, visited by count-trailing-zeros.
+///
+/// Emits cells left to right while each one is well formed (see
+/// `EmitCsvBlockCell`) and returns the offset of the first cell it could
+/// not emit, or `std::string_view::npos` when the whole line was emitted.
+/// The cells before that offset are exactly the scalar tokenizer's, so
+/// the caller resumes it there.
+template <class Emit>
+std::size_t TokenizeCsvLineBlocks(std::string_view line, std::string &quotedScratch, Emit &emit)
+{
+    constexpr ByteClassSet CSV_BYTE_CLASSES{'"', ','};
+    constexpr std::size_t QUOTE_CLASS = 0;
+    constexpr std::size_t COMMA_CLASS = 1;
+
+    const std::size_t end = line.size();
+    std::size_t cellStart = 0;
+    std::size_t quotesBeforeCell = 0;
+    std::size_t quotesBeforeBlock = 0;
+    // All ones while the previous block ended inside quotes.
+    uint64_t inQuoteCarry = 0;
+
+    for (std::size_t blockStart = 0; blockStart < end; blockStart += BYTE_CLASS_BLOCK_BYTES)
+    {
+        const std::size_t blockBytes = std::min(end - blockStart, BYTE_CLASS_BLOCK_BYTES);
+        ByteClassMasks masks;
+        if (blockBytes == BYTE_CLASS_BLOCK_BYTES)
+        {
+            masks = ClassifyBlock(line.data() + blockStart, CSV_BYTE_CLASSES);
+        }
+        else
+        {
+            std::array<char, BYTE_CLASS_BLOCK_BYTES> padded{};
+            std::memcpy(padded.data(), line.data() + blockStart, blockBytes);
+            masks = ClassifyBlock(padded.data(), CSV_BYTE_CLASSES);
+        }
+        const uint64_t quotes = masks.bytes[QUOTE_CLASS];
+        const uint64_t inQuote = PrefixXor(quotes) ^ inQuoteCarry;
+        inQuoteCarry = (inQuote >> (BYTE_CLASS_BLOCK_BYTES - 1)) != 0 ? ~uint64_t{0} : 0;
+
+        uint64_t separators = masks.bytes[COMMA_CLASS] & ~inQuote;
+        while (separators != 0)
+        {
+            const auto bit = static_cast<std::size_t>(std::countr_zero(separators));
+            const std::size_t quotesBeforeSeparator =
+                quotesBeforeBlock + static_cast<std::size_t>(std::popcount(quotes & ((uint64_t{1} << bit) - 1)));
+            const std::size_t separator = blockStart + bit;
+            if (!EmitCsvBlockCell(
+                    line, cellStart, separator, quotesBeforeSeparator - quotesBeforeCell, quotedScratch, emit
+                ))
+            {
+                return cellStart;
+            }
+            cellStart = separator + 1;
+            quotesBeforeCell = quotesBeforeSeparator;
+            separators &= separators - 1;
+        }
+        quotesBeforeBlock += static_cast<std::size_t>(std::popcount(quotes));
+    }
+
+    // Final cell; empty after a trailing `,`. An unterminated quote fails
+    // here and the scalar path reports it.
+    if (!EmitCsvBlockCell(line, cellStart, end, quotesBeforeBlock - quotesBeforeCell, quotedScratch, emit))
+    {
+        return cellStart;
+    }
+    return std::string_view::npos;
+}
+
+/// Tokenize one CSV record using RFC 4180 quoting with lax recovery.
+/// Calls @p emit per cell and rejects unterminated quoted cells.
+///
+/// Grammar: cells separated by `,`; a leading `"` opens a quoted cell
+/// closed by an unescaped `"`, with `""` decoded to a literal `"`; an
+/// unquoted cell ends at the next `,` or EOL; a trailing `,` emits one
+/// final empty cell.
+///
+/// Well-formed cells are sliced by `TokenizeCsvLineBlocks`; the scalar
+/// state machine takes over from the first cell that needs lax recovery.
+///
+/// @p quotedScratch stores unescaped quoted cells.
+template <class Emit> bool TokenizeCsvLine(std::string_view line, std::string &quotedScratch, Emit emit)
+{
+    const std::size_t resumeAt = TokenizeCsvLineBlocks(line, quotedScratch, emit);
+    if (resumeAt == std::string_view::npos)
+    {
+        return true;
+    }
+    return TokenizeCsvLineScalar(line, resumeAt, quotedScratch, emit);
+}
+
 } // namespace loglib::internal
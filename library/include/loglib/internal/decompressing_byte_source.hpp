@@ -1,17 +1,22 @@
 #pragma once
 
+#include <loglib/internal/seek_index.hpp>
 #include <loglib/stop_token.hpp>
 
 #include <cstddef>
 #include <exception>
 #include <filesystem>
+#include <fstream>
 #include <functional>
+#include <memory>
 #include <string>
 #include <string_view>
 
 namespace loglib::internal
 {
 
+class GrowingByteBuffer;
+
 /// Thrown when decompression is cancelled.
 class DecompressionCancelled : public std::exception
 {
@@ -53,6 +58,19 @@ private:
 ///
 /// Compressed input is streamed to an owned temp file exposed through
 /// `EffectivePath()`. Plain input is returned unchanged. Not thread-safe.
+///
+/// Multi-frame zstd and BGZF gzip inputs are decoded frame-parallel on
+/// a private TBB arena and written back in input order; other inputs
+/// stream through one decoder (xz uses liblzma's own threads).
+///
+/// With `Options::seekIndexDir` set, a serial gzip decode also records
+/// restart points (see `GzipSeekIndex`) into that directory; reopening
+/// the unchanged file decodes the spans between them in parallel.
+///
+/// With `Options::progressive` the decode instead runs on an owned
+/// worker thread into `ProgressiveBuffer()`, and the constructor
+/// returns as soon as the first `PROGRESSIVE_READY_BYTES` are readable.
+/// Destroying the source stops and joins the worker.
 class DecompressingByteSource
 {
 public:
@@ -90,8 +108,34 @@ public:
         bool discardFirstLine = false;
         /// Maximum buffered first-line size.
         std::size_t maxDiscardedFirstLineBytes = DEFAULT_MAX_DISCARDED_FIRST_LINE_BYTES;
+        /// Decode in the background into a `GrowingByteBuffer` rather
+        /// than a temp file. Falls back to the temp file silently when
+        /// `discardFirstLine` is set or the platform cannot reserve
+        /// the buffer; check `IsProgressive()`.
+        bool progressive = false;
+        /// Progressive output kept in anonymous memory before the
+        /// rest spills to an unlinked temp file. Zero means a quarter
+        /// of physical RAM.
+        std::size_t maxInMemoryBytes = 0;
+        /// Threads for inputs made of independently decodable frames
+        /// (multi-frame zstd, BGZF gzip). Zero uses the TBB default
+        /// concurrency; one keeps the single-threaded stream decoder.
+        unsigned decodeThreads = 0;
+        /// Cache directory for gzip seek-index sidecars. Empty
+        /// disables both recording and lookup.
+        std::filesystem::path seekIndexDir;
+        /// Decoded distance between recorded seek points.
+        std::size_t seekPointSpacingBytes = DEFAULT_SEEK_POINT_SPACING_BYTES;
     };
 
+    /// Decoded bytes a progressive constructor waits for before
+    /// returning. Covers the format-detection probe and a first batch.
+    static constexpr std::size_t PROGRESSIVE_READY_BYTES = std::size_t{256} << 10;
+
+    /// Address space reserved for a progressive decode when
+    /// `maxDecompressedBytes` is zero. Reserved, not committed.
+    static constexpr std::size_t UNCAPPED_PROGRESSIVE_RESERVATION_BYTES = std::size_t{1} << 40;
+
     /// Sniff @p input and decode compressed content to a temp file.
     /// Progress and cancellation are checked between input chunks.
     DecompressingByteSource(
@@ -121,7 +165,8 @@ public:
     [[nodiscard]] const std::filesystem::path &DisplayPath() const noexcept;
 
     /// Path downstream code should mmap / probe. Equal to
-    /// `DisplayPath()` when the input was not compressed.
+    /// `DisplayPath()` when the input was not compressed or the decode
+    /// is progressive (read `ProgressiveBuffer()` then).
     [[nodiscard]] const std::filesystem::path &EffectivePath() const noexcept;
 
     [[nodiscard]] bool WasDecompressed() const noexcept;
@@ -131,14 +176,31 @@ public:
     [[nodiscard]] std::size_t CompressedSize() const noexcept;
 
     /// Size of the decompressed temp file, in bytes. Zero when
-    /// `WasDecompressed()` is false.
+    /// `WasDecompressed()` is false. Progressive decodes report the
+    /// bytes decoded so far.
     [[nodiscard]] std::size_t DecompressedSize() const noexcept;
 
+    /// True when the decode runs in the background into
+    /// `ProgressiveBuffer()`.
+    [[nodiscard]] bool IsProgressive() const noexcept;
+
+    /// The buffer a progressive decode fills; null otherwise.
+    [[nodiscard]] std::shared_ptr<GrowingByteBuffer> ProgressiveBuffer() const noexcept;
+
     /// Bytes stripped by `Options::discardFirstLine`, without the
     /// terminating newline. Empty when the option was off.
     [[nodiscard]] const std::string &DiscardedFirstLine() const noexcept;
 
 private:
+    class ProgressiveDecode;
+
+    void StartProgressive(
+        std::ifstream in,
+        std::shared_ptr<GrowingByteBuffer> buffer,
+        const ProgressCallback &progress,
+        const StopToken &stopToken,
+        const Options &options
+    );
     void ReleaseTempFile() noexcept;
 
     std::filesystem::path mDisplayPath;
@@ -149,6 +211,7 @@ private:
     /// True when `mEffectivePath` is a temp file owned by this object.
     bool mOwnsTempFile = false;
     std::string mDiscardedFirstLine;
+    std::unique_ptr<ProgressiveDecode> mProgressive;
 };
 
 /// Human-readable codec name (`"gzip"`, `"bzip2"`, `"xz"`, `"zstd"`,
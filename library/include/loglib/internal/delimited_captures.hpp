@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace loglib::internal
+{
+
+/// How far one named capture of a `DelimitedCapturePattern` extends.
+enum class DelimitedField : uint8_t
+{
+    /// `[^D]*`: up to the next delimiter, possibly empty.
+    UntilDelimiter,
+    /// `[^D]+`: up to the next delimiter, at least one byte.
+    UntilDelimiterNonEmpty,
+    /// `.*`: the rest of the line. Last field only.
+    Rest,
+    /// `.+`: the rest of the line, at least one byte. Last field only.
+    RestNonEmpty,
+};
+
+/// A regex that reduces to named captures split on one literal byte,
+/// e.g. `^(?<ts>[^|]+)\|(?<level>[^|]*)\|(?<message>.*)$`. Every field
+/// but a trailing `.*` / `.+` excludes the delimiter, so the pattern
+/// cannot backtrack and a positional split yields PCRE2's captures.
+struct DelimitedCapturePattern
+{
+    /// Unused when the only field is `.*` / `.+`.
+    char delimiter = '\0';
+    /// One entry per named group, in pattern order.
+    std::vector<DelimitedField> fields;
+};
+
+/// Recognise @p pattern as a `DelimitedCapturePattern`; `nullopt` for
+/// anything else, which keeps going through PCRE2.
+[[nodiscard]] std::optional<DelimitedCapturePattern> RecognizeDelimitedCapturePattern(std::string_view pattern);
+
+/// Split @p line into one capture per field of @p pattern, replacing
+/// @p captures. Returns false when the line does not match, or when a
+/// `.` field would cover a `\r` / `\n` whose handling depends on the
+/// PCRE2 newline convention; the caller then asks PCRE2.
+[[nodiscard]] bool SplitDelimitedCaptures(
+    const DelimitedCapturePattern &pattern, std::string_view line, std::vector<std::string_view> &captures
+);
+
+} // namespace loglib::internal
@@ -0,0 +1,280 @@
+#pragma once
+
+#include "loglib/enum_dictionary.hpp"
+#include "loglib/key_index.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace loglib::internal
+{
+
+class SidecarReader;
+class SidecarWriter;
+
+/// Compressed ascending set of 64-bit row sequence ids, laid out like
+/// a roaring bitmap: ids split into 2^16-wide chunks keyed by the high
+/// bits, each chunk a sorted `uint16_t` array while sparse and a
+/// 1024-word bitmap once it passes `ARRAY_MAX_ENTRIES`. Sparse values
+/// cost ~2 B per row, dense ones a flat 8 KiB per 65536 rows.
+///
+/// Ids only ever arrive in ascending order (`Append`) and leave from
+/// the front (`EraseBelow`), matching a table that appends at the tail
+/// and evicts its prefix.
+class RowIdSet
+{
+public:
+    /// Array containers convert to a bitmap past this many entries,
+    /// the point where the bitmap becomes the smaller of the two.
+    static constexpr size_t ARRAY_MAX_ENTRIES = 4096;
+
+    /// Append @p id; must be greater than every id already held.
+    void Append(uint64_t id);
+
+    /// Drop every id below @p id.
+    void EraseBelow(uint64_t id);
+
+    void Clear() noexcept;
+
+    [[nodiscard]] size_t Count() const noexcept
+    {
+        return mCount;
+    }
+
+    [[nodiscard]] bool Empty() const noexcept
+    {
+        return mCount == 0;
+    }
+
+    /// Call @p visit with every id in `[first, end)`, ascending.
+    template <class Visit> void ForEachInRange(uint64_t first, uint64_t end, Visit &&visit) const;
+
+    /// Heap bytes owned (capacity, not size).
+    [[nodiscard]] size_t MemoryBytes() const noexcept;
+
+    /// Serialise every chunk in its current container form.
+    void Write(SidecarWriter &writer) const;
+
+    /// Replace the contents with a set `Write` produced. Returns false,
+    /// leaving the set empty, on a short or malformed stream.
+    [[nodiscard]] bool Read(SidecarReader &reader);
+
+private:
+    static constexpr uint64_t CHUNK_BITS = 16;
+    static constexpr size_t BITMAP_WORDS = (size_t{1} << CHUNK_BITS) / 64;
+
+    // NOLINTBEGIN(misc-non-private-member-variables-in-classes)
+    // Private nested aggregate: public members are intentional.
+    struct Chunk
+    {
+        uint64_t key = 0;
+        /// Sorted low halves; empty once `bitmap` took over.
+        std::vector<uint16_t> array;
+        /// `BITMAP_WORDS` words when dense, else empty.
+        std::vector<uint64_t> bitmap;
+        uint32_t count = 0;
+    };
+    // NOLINTEND(misc-non-private-member-variables-in-classes)
+
+    static void ConvertToBitmap(Chunk &chunk);
+
+    std::vector<Chunk> mChunks;
+    size_t mCount = 0;
+};
+
+/// Posting lists for one enum column: for every `EnumValueId`, the
+/// rows whose slot resolves to it (`LogTable::GetEnumValueId`). Rows
+/// are stored as sequence ids (`row + mFirstId`), so `EraseFront`
+/// shifts one offset and trims each list's head instead of renumbering
+/// survivors.
+class EnumPostingIndex
+{
+public:
+    /// Rows covered, indexed or not.
+    [[nodiscard]] size_t Size() const noexcept
+    {
+        return mSize;
+    }
+
+    [[nodiscard]] bool Empty() const noexcept
+    {
+        return mSize == 0;
+    }
+
+    /// Cover one more row; @p id is its value, or
+    /// `INVALID_ENUM_VALUE_ID` when the slot is not a `DictRef`.
+    void Append(EnumValueId id);
+
+    /// Drop the first @p count rows. @p count past `Size()` clears.
+    void EraseFront(size_t count);
+
+    void Clear() noexcept;
+
+    /// Number of rows carrying @p id.
+    [[nodiscard]] size_t RowCount(EnumValueId id) const noexcept;
+
+    /// Call @p visit with every row in `[firstRow, endRow)` carrying
+    /// @p id, ascending.
+    template <class Visit> void ForEachRow(EnumValueId id, size_t firstRow, size_t endRow, Visit &&visit) const;
+
+    /// Heap bytes owned (capacity, not size).
+    [[nodiscard]] size_t MemoryBytes() const noexcept;
+
+private:
+    /// Indexed by `EnumValueId`; grown on first sight of an id.
+    std::vector<RowIdSet> mLists;
+    /// Sequence id of row 0.
+    uint64_t mFirstId = 0;
+    size_t mSize = 0;
+};
+
+/// Per-table set of `EnumPostingIndex`es, one slot per column (empty
+/// for non-enum columns). Like `ColumnStore`, each slot remembers the
+/// alias `KeyId`s and the dictionary it was built against so the owner
+/// can detect a re-resolved column and rebuild it.
+class EnumIndexStore
+{
+public:
+    [[nodiscard]] bool Enabled() const noexcept
+    {
+        return mEnabled;
+    }
+
+    /// Turning the store off frees every index.
+    void SetEnabled(bool enabled) noexcept;
+
+    [[nodiscard]] size_t ColumnCount() const noexcept
+    {
+        return mColumns.size();
+    }
+
+    /// Grow or shrink to @p columnCount; new columns start empty.
+    void Resize(size_t columnCount);
+
+    [[nodiscard]] EnumPostingIndex &Index(size_t index) noexcept
+    {
+        return mColumns[index].index;
+    }
+
+    [[nodiscard]] const EnumPostingIndex &Index(size_t index) const noexcept
+    {
+        return mColumns[index].index;
+    }
+
+    [[nodiscard]] const std::vector<KeyId> &ColumnKeys(size_t index) const noexcept
+    {
+        return mColumns[index].keyIds;
+    }
+
+    [[nodiscard]] const EnumDictionary *ColumnDictionary(size_t index) const noexcept
+    {
+        return mColumns[index].dictionary;
+    }
+
+    /// Record what column @p index is built against; clears its rows
+    /// when either differs from before.
+    void Bind(size_t index, const std::vector<KeyId> &keyIds, const EnumDictionary *dictionary);
+
+    /// Drop column @p index's rows; the owner's next sync rebuilds it.
+    void Invalidate(size_t index) noexcept;
+
+    /// Mirror of `LogConfigurationManager::MoveColumn`.
+    void MoveColumn(size_t srcIndex, size_t destIndex);
+
+    /// Drop the first @p count rows from every index.
+    void EraseFrontRows(size_t count);
+
+    void Clear() noexcept;
+
+    /// Heap bytes owned across all columns.
+    [[nodiscard]] size_t MemoryBytes() const noexcept;
+
+private:
+    // NOLINTBEGIN(misc-non-private-member-variables-in-classes)
+    // Private nested aggregate: public members are intentional.
+    struct Entry
+    {
+        EnumPostingIndex index;
+        std::vector<KeyId> keyIds;
+        const EnumDictionary *dictionary = nullptr;
+    };
+    // NOLINTEND(misc-non-private-member-variables-in-classes)
+
+    std::vector<Entry> mColumns;
+    bool mEnabled = false;
+};
+
+template <class Visit> void RowIdSet::ForEachInRange(uint64_t first, uint64_t end, Visit &&visit) const
+{
+    if (first >= end)
+    {
+        return;
+    }
+    auto chunk = std::ranges::lower_bound(mChunks, first >> CHUNK_BITS, {}, &Chunk::key);
+    for (; chunk != mChunks.end(); ++chunk)
+    {
+        const uint64_t base = chunk->key << CHUNK_BITS;
+        if (base >= end)
+        {
+            return;
+        }
+        if (chunk->bitmap.empty())
+        {
+            auto low = chunk->array.begin();
+            if (first > base)
+            {
+                low = std::ranges::lower_bound(chunk->array, static_cast<uint16_t>(first - base));
+            }
+            for (; low != chunk->array.end(); ++low)
+            {
+                const uint64_t id = base + *low;
+                if (id >= end)
+                {
+                    return;
+                }
+                if (id >= first)
+                {
+                    visit(id);
+                }
+            }
+            continue;
+        }
+        const size_t firstWord = first > base ? static_cast<size_t>((first - base) / 64) : 0;
+        for (size_t word = firstWord; word < BITMAP_WORDS; ++word)
+        {
+            uint64_t bits = chunk->bitmap[word];
+            while (bits != 0U)
+            {
+                const uint64_t id = base + (word * 64) + static_cast<uint64_t>(std::countr_zero(bits));
+                if (id >= end)
+                {
+                    return;
+                }
+                if (id >= first)
+                {
+                    visit(id);
+                }
+                bits &= bits - 1U;
+            }
+        }
+    }
+}
+
+template <class Visit>
+void EnumPostingIndex::ForEachRow(EnumValueId id, size_t firstRow, size_t endRow, Visit &&visit) const
+{
+    const auto slot = static_cast<size_t>(id);
+    if (slot >= mLists.size())
+    {
+        return;
+    }
+    const uint64_t firstId = mFirstId;
+    mLists[slot].ForEachInRange(firstId + firstRow, firstId + std::min(endRow, mSize), [&visit, firstId](uint64_t seq) {
+        visit(static_cast<size_t>(seq - firstId));
+    });
+}
+
+} // namespace loglib::internal
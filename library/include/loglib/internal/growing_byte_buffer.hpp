@@ -0,0 +1,120 @@
+#pragma once
+
+#include "loglib/stop_token.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+
+namespace loglib::internal
+{
+
+/// Append-only byte buffer at a fixed address, filled front to back by
+/// one writer thread while readers consume the published prefix.
+///
+/// Backs progressive decompression (`DecompressingByteSource::Options::
+/// progressive`): the decoder appends decoded bytes and the static
+/// parser pipeline cuts complete lines out of `[Data(), Data() + Size())`
+/// as they land. The address never moves, so `MmapSlice` values stay
+/// valid for the buffer's lifetime exactly as they do over a file mmap.
+///
+/// The whole range is reserved up front and backed one `WINDOW_BYTES`
+/// window at a time. The first `inMemoryBytes` live in anonymous
+/// memory; later windows map an unlinked temp file, so an output larger
+/// than the budget spills to disk instead of RAM. POSIX only (see
+/// `IsSupported`); Windows keeps the temp-file decode.
+class GrowingByteBuffer
+{
+public:
+    /// Granularity of commits and spill-file mappings.
+    static constexpr size_t WINDOW_BYTES = size_t{64} << 20;
+
+    /// Whether this platform can reserve and back the range.
+    [[nodiscard]] static bool IsSupported() noexcept;
+
+    /// Reserve @p capacityBytes of address space, the first
+    /// @p inMemoryBytes of which stay in anonymous memory. Both round
+    /// up to `WINDOW_BYTES`. Throws `std::runtime_error` when the
+    /// reservation fails or the platform is unsupported.
+    GrowingByteBuffer(size_t capacityBytes, size_t inMemoryBytes);
+
+    ~GrowingByteBuffer();
+
+    GrowingByteBuffer(const GrowingByteBuffer &) = delete;
+    GrowingByteBuffer &operator=(const GrowingByteBuffer &) = delete;
+    GrowingByteBuffer(GrowingByteBuffer &&) = delete;
+    GrowingByteBuffer &operator=(GrowingByteBuffer &&) = delete;
+
+    /// Writer: append @p size bytes and publish them to readers.
+    /// Throws `std::length_error` past the reserved capacity and
+    /// `std::runtime_error` when the spill file cannot be written.
+    void Append(const char *data, size_t size);
+
+    /// Writer: mark the buffer complete. A non-empty @p error records
+    /// why the writer stopped early; the bytes already published stay
+    /// readable.
+    void Finish(std::string error = {});
+
+    /// Writer: whether a reader asked it to give up (`RequestStop`).
+    [[nodiscard]] bool StopRequested() const noexcept
+    {
+        return mStopRequested.load(std::memory_order_acquire);
+    }
+
+    /// Stable base address; valid (if empty) before the first append.
+    [[nodiscard]] const char *Data() const noexcept
+    {
+        return mBase;
+    }
+
+    /// Published byte count. Only grows.
+    [[nodiscard]] size_t Size() const noexcept
+    {
+        return mSize.load(std::memory_order_acquire);
+    }
+
+    /// True once `Finish` ran; `Size()` is final from then on.
+    [[nodiscard]] bool IsComplete() const noexcept
+    {
+        return mComplete.load(std::memory_order_acquire);
+    }
+
+    /// The writer's `Finish` error. Empty while running or on success.
+    [[nodiscard]] std::string Error() const;
+
+    /// Bytes written to the spill file rather than anonymous memory.
+    [[nodiscard]] size_t SpilledBytes() const noexcept;
+
+    /// Reader: block until more than @p knownSize bytes are published,
+    /// the buffer completes, or @p stopToken fires. Returns `Size()`.
+    size_t WaitForGrowth(size_t knownSize, const StopToken &stopToken);
+
+    /// Reader: ask the writer to stop at its next `Append`.
+    void RequestStop() noexcept;
+
+private:
+    void MapNextWindow();
+    void OpenSpillFile();
+    void WakeReaders();
+
+    char *mBase = nullptr;
+    size_t mCapacity = 0;
+    size_t mInMemoryBytes = 0;
+
+    /// Writer-only state.
+    size_t mMappedEnd = 0;
+    int mSpillFd = -1;
+
+    std::atomic<size_t> mSize{0};
+    std::atomic<bool> mComplete{false};
+    std::atomic<bool> mStopRequested{false};
+    std::atomic<int> mWaitingReaders{0};
+
+    mutable std::mutex mMutex;
+    std::condition_variable mCv;
+    std::string mError;
+};
+
+} // namespace loglib::internal
@@ -1,9 +1,15 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
-#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <span>
 #include <string_view>
 
@@ -11,105 +17,404 @@ namespace loglib::internal
 {
 
 /// Single-producer / single-consumer FIFO byte queue with line-aware
-/// back-pressure. Used by `TcpServerProducer` and `UdpServerProducer`
-/// to buffer bytes between the Asio worker thread and the parser
-/// thread. The queue is *not* internally synchronised; callers wrap
-/// access in their own mutex (the same one that already guards the
-/// pending state in those producers).
+/// back-pressure. Used by `TcpServerProducer`, `UdpServerProducer` and
+/// `StdinBytesProducer` to hand bytes from their I/O worker thread (the
+/// only producer) to the parser thread (the only consumer).
 ///
-/// Back-pressure semantics: when an `Append` would push the queue
-/// past `cap` bytes, the oldest queued bytes are dropped down to the
-/// next newline boundary so the consumer never sees a torn line. The
-/// drop count goes into a caller-supplied atomic so the producer can
-/// surface it via its `DroppedByteCount` accessor.
+/// Lock-free ring: the producer owns the tail, the consumer claims
+/// bytes by CAS-advancing the head, and neither side takes a lock on
+/// the byte path. The only mutex parks a consumer in `WaitForBytes`,
+/// and `Append` touches it only when one is parked.
 ///
-/// Backed by `std::deque<char>` for O(1) `pop_front` and bounded
-/// resident memory under sustained back-pressure. Read sizes
-/// (`STREAMING_READ_BUFFER_SIZE`) stay below a deque block, so most
-/// `Read` calls do not cross a block boundary.
+/// The ring starts at `INITIAL_RING_BYTES` and the producer regrows it
+/// (copying the unread bytes into a new ring) up to `softCap +
+/// MAX_BORROW_BYTES` as the backlog demands, then shrinks it again once
+/// the backlog drains, so resident memory follows the unread bytes
+/// rather than the cap. A replaced ring is freed by the consumer at its
+/// next `Borrow`, when it holds no pointer into it.
+///
+/// Back-pressure semantics: when an `Append` would push the unread
+/// bytes past the soft cap, the oldest unread bytes are dropped down to
+/// the next newline boundary so the consumer never sees a torn line.
+/// The producer drops by CAS-advancing the head, so a drop and a
+/// consumer claim never both win the same bytes. The drop count goes
+/// into a caller-supplied atomic so the producer can surface it via its
+/// `DroppedByteCount` accessor.
+///
+/// `Borrow` hands the consumer a span over the ring itself (no copy).
+/// Borrowed bytes count as read for back-pressure, but the producer
+/// does not overwrite them until `ReleaseBorrowed`. The ring may grow
+/// to `softCap + MAX_BORROW_BYTES`, so the soft cap alone guarantees
+/// room while borrows are short-lived.
 class LineBytesQueue
 {
 public:
-    LineBytesQueue() = default;
+    /// Upper bound on one `Borrow` span.
+    static constexpr std::size_t MAX_BORROW_BYTES = std::size_t{64} * 1024;
+
+    /// Soft cap used when the caller passes `0` ("no back-pressure").
+    /// The ring never grows past it, so an uncapped queue still drops
+    /// past this many unread bytes.
+    static constexpr std::size_t UNCAPPED_SOFT_CAP_BYTES = std::size_t{256} * 1024 * 1024;
+
+    /// Ring size while the consumer keeps up, and the floor it shrinks
+    /// back to after a burst.
+    static constexpr std::size_t INITIAL_RING_BYTES = std::size_t{1} << 20;
+
+    /// @param softCapBytes  Unread-byte cap past which `Append` drops
+    ///                      the oldest lines. `0` means
+    ///                      `UNCAPPED_SOFT_CAP_BYTES`.
+    explicit LineBytesQueue(std::size_t softCapBytes)
+        : mSoftCap(softCapBytes == 0 ? UNCAPPED_SOFT_CAP_BYTES : softCapBytes),
+          mMaxCapacity(mSoftCap + MAX_BORROW_BYTES),
+          mRing(new Ring(std::min(INITIAL_RING_BYTES, mMaxCapacity)))
+    {
+    }
 
     LineBytesQueue(const LineBytesQueue &) = delete;
     LineBytesQueue &operator=(const LineBytesQueue &) = delete;
     LineBytesQueue(LineBytesQueue &&) = delete;
     LineBytesQueue &operator=(LineBytesQueue &&) = delete;
-    ~LineBytesQueue() = default;
 
-    /// Number of bytes currently queued.
+    ~LineBytesQueue()
+    {
+        FreeRetiredRings();
+        delete mRing.load(std::memory_order_relaxed);
+    }
+
+    /// Number of unread bytes. Exact from the consumer thread; a
+    /// snapshot elsewhere.
     [[nodiscard]] std::size_t Size() const noexcept
     {
-        return mBytes.size();
+        const uint64_t head = mHead.load();
+        return static_cast<std::size_t>(mTail.load() - head);
     }
 
-    /// Whether the queue holds zero bytes.
+    /// Whether the queue holds zero unread bytes.
     [[nodiscard]] bool Empty() const noexcept
     {
-        return mBytes.empty();
+        return Size() == 0;
+    }
+
+    /// Bytes allocated for the current ring. A snapshot off the
+    /// producer thread.
+    [[nodiscard]] std::size_t RingBytes() const noexcept
+    {
+        return mRing.load(std::memory_order_acquire)->capacity;
+    }
+
+    /// Consumer: claim up to @p maxBytes (capped at `MAX_BORROW_BYTES`)
+    /// contiguous unread bytes in place. Empty when nothing is queued.
+    /// The span stays valid until `ReleaseBorrowed`, which must be
+    /// called before the next `Borrow` / `Read`.
+    [[nodiscard]] std::span<const char> Borrow(std::size_t maxBytes) noexcept
+    {
+        maxBytes = std::min(maxBytes, MAX_BORROW_BYTES);
+        // No borrow is outstanding here, so no ring the producer has
+        // replaced can still be in use.
+        FreeRetiredRings();
+        for (;;)
+        {
+            uint64_t head = mHead.load();
+            const uint64_t tail = mTail.load(std::memory_order_acquire);
+            if (head == tail || maxBytes == 0)
+            {
+                return {};
+            }
+            // Loaded after the tail: the producer swaps rings before
+            // publishing bytes past the old one, and a new ring holds
+            // every byte from any head a claim can still succeed at.
+            const Ring &ring = *mRing.load(std::memory_order_acquire);
+            const std::size_t offset = static_cast<std::size_t>(head % ring.capacity);
+            const std::size_t count =
+                std::min({static_cast<std::size_t>(tail - head), maxBytes, ring.capacity - offset});
+            // Pin the region before claiming it; see `Append` for the
+            // producer's side of this handshake.
+            mBorrowBegin.store(head);
+            if (mHead.compare_exchange_strong(head, head + count))
+            {
+                return {ring.bytes.get() + offset, count};
+            }
+            // The producer dropped bytes under us; retry from the new head.
+        }
+    }
+
+    /// Consumer: end the current `Borrow`, letting the producer reuse
+    /// the bytes.
+    void ReleaseBorrowed() noexcept
+    {
+        mBorrowBegin.store(NO_BORROW, std::memory_order_release);
     }
 
-    /// Copy up to `buffer.size()` bytes into @p buffer and pop them
-    /// off the front. Returns the actual byte count copied.
+    /// Consumer: copy up to `buffer.size()` bytes into @p buffer and
+    /// pop them off the front. Returns the actual byte count copied.
     std::size_t Read(std::span<char> buffer) noexcept
     {
-        if (buffer.empty() || mBytes.empty())
+        std::size_t copied = 0;
+        while (copied < buffer.size())
         {
-            return 0;
+            const std::span<const char> bytes = Borrow(buffer.size() - copied);
+            if (bytes.empty())
+            {
+                break;
+            }
+            std::memcpy(buffer.data() + copied, bytes.data(), bytes.size());
+            copied += bytes.size();
+            ReleaseBorrowed();
         }
-        const std::size_t toCopy = std::min(buffer.size(), mBytes.size());
-        // `std::copy_n` over a deque iterator is the conventional way
-        // to extract a span; modern stdlibs lower it to a memcpy per
-        // contiguous block.
-        std::copy_n(mBytes.begin(), toCopy, buffer.data());
-        mBytes.erase(mBytes.begin(), mBytes.begin() + static_cast<std::ptrdiff_t>(toCopy));
-        return toCopy;
+        return copied;
+    }
+
+    /// Producer: append @p data of length @p size, applying line-aware
+    /// back-pressure: if the unread bytes would exceed the soft cap,
+    /// drop the oldest ones (rounded up to the next newline) until it
+    /// fits. A payload larger than the cap on its own loses its leading
+    /// lines the same way. Increments @p droppedCounter by the number
+    /// of bytes dropped.
+    void Append(const char *data, std::size_t size, std::atomic<std::size_t> &droppedCounter)
+    {
+        Append(std::string_view(data, size), std::string_view{}, droppedCounter);
+    }
+
+    /// Convenience overload for `std::string_view` payloads.
+    void Append(std::string_view payload, std::atomic<std::size_t> &droppedCounter)
+    {
+        Append(payload, std::string_view{}, droppedCounter);
     }
 
-    /// Append @p data of length @p size, applying line-aware
-    /// back-pressure: if the resulting queue would exceed @p cap, drop
-    /// oldest bytes (rounded up to the next newline) until it fits.
-    /// `cap == 0` disables back-pressure. Increments @p droppedCounter
-    /// by the number of bytes dropped.
-    void Append(const char *data, std::size_t size, std::size_t cap, std::atomic<std::size_t> &droppedCounter)
+    /// Producer: append @p payload followed by @p suffix as one unit
+    /// (e.g. a datagram and its synthetic newline): the consumer sees
+    /// both or, when the ring has no room, neither.
+    void Append(std::string_view payload, std::string_view suffix, std::atomic<std::size_t> &droppedCounter)
     {
+        std::size_t size = payload.size() + suffix.size();
         if (size == 0)
         {
             return;
         }
-        if (cap > 0 && mBytes.size() + size > cap)
+        const bool oversized = size > mSoftCap;
+        if (oversized)
+        {
+            // Keep the payload's newest lines that fit; the rest counts
+            // as dropped, exactly as if it had been queued then evicted.
+            std::size_t skip = size;
+            for (std::size_t at = size - mSoftCap - 1; at < size; ++at)
+            {
+                if ((at < payload.size() ? payload[at] : suffix[at - payload.size()]) == '\n')
+                {
+                    skip = at + 1;
+                    break;
+                }
+            }
+            droppedCounter.fetch_add(skip, std::memory_order_acq_rel);
+            if (skip >= payload.size())
+            {
+                suffix.remove_prefix(skip - payload.size());
+                payload = {};
+            }
+            else
+            {
+                payload.remove_prefix(skip);
+            }
+            size -= skip;
+            if (size == 0)
+            {
+                return;
+            }
+        }
+
+        Ring *ring = mRing.load(std::memory_order_relaxed);
+        const uint64_t tail = mTail.load(std::memory_order_relaxed);
+        uint64_t head = mHead.load();
+        // An oversized payload would have evicted every queued byte on
+        // its way in, so those go too.
+        while (tail - head + size > mSoftCap || (oversized && head != tail))
         {
-            const std::size_t over = mBytes.size() + size - cap;
-            const std::size_t dropFrom = std::min(over, mBytes.size());
+            const std::size_t queued = static_cast<std::size_t>(tail - head);
+            const std::size_t over = static_cast<std::size_t>(tail - head + size - mSoftCap);
 
-            // Round drop up to the next newline so the consumer never
-            // sees a torn line. If no newline within the drop region,
-            // extend through the rest of the buffered bytes (extreme
-            // back-pressure: the parser is hopelessly behind).
-            std::size_t dropCount = dropFrom;
-            while (dropCount < mBytes.size() && mBytes[dropCount] != '\n')
+            // Round the drop up to the next newline so the consumer
+            // never sees a torn line. If there is no newline within
+            // the unread bytes, drop them all (extreme back-pressure:
+            // the parser is hopelessly behind).
+            std::size_t dropCount = oversized ? queued : std::min(over, queued);
+            while (dropCount < queued && ring->At(head + dropCount) != '\n')
             {
                 ++dropCount;
             }
-            if (dropCount < mBytes.size() && mBytes[dropCount] == '\n')
+            if (dropCount < queued)
             {
                 ++dropCount; // include the newline
             }
-            mBytes.erase(mBytes.begin(), mBytes.begin() + static_cast<std::ptrdiff_t>(dropCount));
-            droppedCounter.fetch_add(dropCount, std::memory_order_acq_rel);
+            if (mHead.compare_exchange_strong(head, head + dropCount))
+            {
+                droppedCounter.fetch_add(dropCount, std::memory_order_acq_rel);
+                head += dropCount;
+            }
+            // On failure `head` holds the consumer's newer claim; re-check.
+        }
+
+        // Head is loaded before the borrow pin: a consumer that claimed
+        // bytes after our head load published its pin first, so the
+        // oldest byte still in use is never newer than what we see.
+        // With the soft cap enforced above this only fails when the
+        // consumer holds one borrow across a whole ring of traffic;
+        // the new payload is then dropped whole rather than overwrite
+        // it.
+        const uint64_t oldest = std::min(mHead.load(), mBorrowBegin.load());
+        const auto needed = static_cast<std::size_t>(tail + size - oldest);
+        if (needed > ring->capacity && ring->capacity < mMaxCapacity)
+        {
+            ring = Resize(ring, tail, std::min(std::max(needed, ring->capacity * 2), mMaxCapacity));
+        }
+        else if (ring->capacity > INITIAL_RING_BYTES && needed <= ring->capacity / SHRINK_FACTOR)
+        {
+            // The backlog drained after a burst; hand the memory back.
+            ring = Resize(ring, tail, std::max(ring->capacity / 2, INITIAL_RING_BYTES));
+        }
+        if (needed > ring->capacity)
+        {
+            droppedCounter.fetch_add(size, std::memory_order_acq_rel);
+            return;
+        }
+
+        ring->CopyIn(tail, payload);
+        ring->CopyIn(tail + payload.size(), suffix);
+        // Publishes the bytes; sequentially consistent so the parked
+        // check below cannot be ordered before it.
+        mTail.store(tail + size);
+        if (mConsumerParked.load())
+        {
+            WakeConsumer();
         }
-        mBytes.insert(mBytes.end(), data, data + size);
     }
 
-    /// Convenience overload for `std::string_view` payloads.
-    void Append(std::string_view payload, std::size_t cap, std::atomic<std::size_t> &droppedCounter)
+    /// Consumer: block until bytes are queued, @p stopWaiting returns
+    /// true, or @p timeout elapses. Spurious wakeups are allowed.
+    template <class Predicate> void WaitForBytes(std::chrono::milliseconds timeout, Predicate stopWaiting)
     {
-        Append(payload.data(), payload.size(), cap, droppedCounter);
+        std::unique_lock<std::mutex> lock(mParkMutex);
+        mConsumerParked.store(true);
+        mParkCv.wait_for(lock, timeout, [&] { return !Empty() || stopWaiting(); });
+        mConsumerParked.store(false, std::memory_order_relaxed);
+    }
+
+    /// Wake a consumer parked in `WaitForBytes`. Producers call this
+    /// after flipping the state their `stopWaiting` predicate reads.
+    void WakeConsumer()
+    {
+        {
+            // Taking the lock orders us after a consumer that checked
+            // its predicate but has not started waiting yet.
+            const std::scoped_lock lock(mParkMutex);
+        }
+        mParkCv.notify_all();
     }
 
 private:
-    std::deque<char> mBytes;
+    static constexpr uint64_t NO_BORROW = std::numeric_limits<uint64_t>::max();
+
+    /// A ring shrinks once the bytes it must hold fit in this fraction
+    /// of it; the gap to the 2x growth step keeps it from flapping.
+    static constexpr std::size_t SHRINK_FACTOR = 8;
+
+    /// One ring allocation. Positions map into it modulo `capacity`.
+    struct Ring
+    {
+        explicit Ring(std::size_t ringCapacity)
+            : capacity(ringCapacity),
+              bytes(std::make_unique_for_overwrite<char[]>(ringCapacity))
+        {
+        }
+
+        [[nodiscard]] char At(uint64_t position) const noexcept
+        {
+            return bytes[static_cast<std::size_t>(position % capacity)];
+        }
+
+        /// Copy @p data into the ring at @p position, wrapping at the end.
+        void CopyIn(uint64_t position, std::string_view data) noexcept
+        {
+            if (data.empty())
+            {
+                return;
+            }
+            const std::size_t offset = static_cast<std::size_t>(position % capacity);
+            const std::size_t first = std::min(data.size(), capacity - offset);
+            std::memcpy(bytes.get() + offset, data.data(), first);
+            if (first < data.size())
+            {
+                std::memcpy(bytes.get(), data.data() + first, data.size() - first);
+            }
+        }
+
+        /// Copy the bytes at positions [@p begin, @p end) into @p target.
+        void CopyTo(Ring &target, uint64_t begin, uint64_t end) const noexcept
+        {
+            while (begin != end)
+            {
+                const std::size_t offset = static_cast<std::size_t>(begin % capacity);
+                const std::size_t count = std::min(static_cast<std::size_t>(end - begin), capacity - offset);
+                target.CopyIn(begin, std::string_view(bytes.get() + offset, count));
+                begin += count;
+            }
+        }
+
+        const std::size_t capacity;
+        const std::unique_ptr<char[]> bytes;
+        /// Next entry on the retired list.
+        Ring *nextRetired = nullptr;
+    };
+
+    /// Producer: move the unread bytes of @p ring (up to @p tail) into a
+    /// new ring of @p capacity, publish it, and retire @p ring.
+    Ring *Resize(Ring *ring, uint64_t tail, std::size_t capacity)
+    {
+        auto *resized = new Ring(capacity);
+        // A consumer claim racing this copy reads the old ring, which
+        // stays allocated until its next `Borrow`.
+        ring->CopyTo(*resized, mHead.load(), tail);
+        mRing.store(resized, std::memory_order_release);
+        ring->nextRetired = mRetired.load(std::memory_order_relaxed);
+        while (!mRetired.compare_exchange_weak(
+            ring->nextRetired, ring, std::memory_order_release, std::memory_order_relaxed
+        ))
+        {
+        }
+        return resized;
+    }
+
+    /// Consumer (or destructor): free every ring the producer retired.
+    void FreeRetiredRings() noexcept
+    {
+        Ring *ring = mRetired.exchange(nullptr, std::memory_order_acquire);
+        while (ring != nullptr)
+        {
+            Ring *next = ring->nextRetired;
+            delete ring;
+            ring = next;
+        }
+    }
+
+    const std::size_t mSoftCap;
+    const std::size_t mMaxCapacity;
+    /// Current ring; replaced only by the producer.
+    std::atomic<Ring *> mRing;
+    /// Rings the producer replaced, freed by the consumer.
+    std::atomic<Ring *> mRetired{nullptr};
+
+    /// Monotonic byte positions; `% capacity` maps them into the ring.
+    /// The head is shared (consumer claims, producer drops); the tail is
+    /// written by the producer only. Kept on separate cache lines so the
+    /// two threads do not false-share.
+    alignas(64) std::atomic<uint64_t> mHead{0};
+    alignas(64) std::atomic<uint64_t> mTail{0};
+    /// Start of the consumer's outstanding `Borrow`, or `NO_BORROW`.
+    alignas(64) std::atomic<uint64_t> mBorrowBegin{NO_BORROW};
+
+    std::atomic<bool> mConsumerParked{false};
+    std::mutex mParkMutex;
+    std::condition_variable mParkCv;
 };
 
 } // namespace loglib::internal
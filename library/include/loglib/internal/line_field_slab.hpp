@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace loglib::internal
+{
+
+/// Bump arena for the `CompactLineFields` blocks of one parsed batch.
+///
+/// The static pipeline's Stage B installs a slab (`ScopedLineFieldSlab`)
+/// while it decodes a batch, so every row's field array is carved out of
+/// one contiguous block instead of a per-row `operator new`. Stage C
+/// hands the slab to the `LogFile` (`AdoptFieldSlab`), which frees it
+/// with the session: teardown is O(slabs), not O(rows).
+///
+/// Nothing is freed individually. A row whose fields are rebuilt after
+/// ingest (e.g. `SetValue` on a new key) moves to the heap and leaves its
+/// old block as slack until the slab dies.
+class LineFieldSlab
+{
+public:
+    /// Default first-block size; Stage B sizes later slabs from the
+    /// previous batch's use.
+    static constexpr size_t DEFAULT_BLOCK_BYTES = size_t{64} * 1024;
+
+    explicit LineFieldSlab(size_t firstBlockBytes = DEFAULT_BLOCK_BYTES);
+
+    LineFieldSlab(const LineFieldSlab &) = delete;
+    LineFieldSlab &operator=(const LineFieldSlab &) = delete;
+    LineFieldSlab(LineFieldSlab &&) = delete;
+    LineFieldSlab &operator=(LineFieldSlab &&) = delete;
+
+    ~LineFieldSlab() = default;
+
+    /// @p bytes of 8-byte-aligned storage, valid for the slab's
+    /// lifetime. Opens a new block when the current one is exhausted.
+    [[nodiscard]] void *Allocate(size_t bytes);
+
+    /// Bytes handed out by `Allocate`.
+    [[nodiscard]] size_t UsedBytes() const noexcept
+    {
+        return mUsedBytes;
+    }
+
+    /// Bytes reserved across all blocks.
+    [[nodiscard]] size_t MemoryBytes() const noexcept
+    {
+        return mReservedBytes;
+    }
+
+private:
+    static constexpr size_t ALIGNMENT = 8;
+
+    void OpenBlock(size_t minBytes);
+
+    std::vector<std::unique_ptr<std::byte[]>> mBlocks;
+    std::byte *mCursor = nullptr;
+    size_t mRemaining = 0;
+    size_t mNextBlockBytes;
+    size_t mUsedBytes = 0;
+    size_t mReservedBytes = 0;
+};
+
+/// Slab the calling thread's `CompactLineFields` allocations currently
+/// draw from, or nullptr (plain heap).
+[[nodiscard]] LineFieldSlab *CurrentLineFieldSlab() noexcept;
+
+/// Routes `CompactLineFields` allocations made on this thread into
+/// @p slab for the scope's lifetime; restores the previous slab on exit.
+class ScopedLineFieldSlab
+{
+public:
+    explicit ScopedLineFieldSlab(LineFieldSlab &slab) noexcept;
+    ~ScopedLineFieldSlab();
+
+    ScopedLineFieldSlab(const ScopedLineFieldSlab &) = delete;
+    ScopedLineFieldSlab &operator=(const ScopedLineFieldSlab &) = delete;
+    ScopedLineFieldSlab(ScopedLineFieldSlab &&) = delete;
+    ScopedLineFieldSlab &operator=(ScopedLineFieldSlab &&) = delete;
+
+private:
+    LineFieldSlab *mPrevious;
+};
+
+} // namespace loglib::internal
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "loglib/internal/byte_classes.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace loglib::internal
+{
+
+/// Byte class set for line framing: only `\n`.
+inline constexpr ByteClassSet NEWLINE_BYTE_CLASSES{'\n'};
+
+/// Forward `\n` scanner over one byte range. Each 64-byte block is
+/// classified once, so every further line ending inside the same block
+/// costs a shift and a count-trailing-zeros rather than a fresh `memchr`.
+class NewlineScanner
+{
+public:
+    /// @p readableEnd is at least the range end; see `ByteClassCursor`.
+    NewlineScanner(std::string_view range, const char *readableEnd) noexcept
+        : mSize(range.size()), mCursor(range, readableEnd, NEWLINE_BYTE_CLASSES)
+    {
+    }
+
+    /// Offset of the first `\n` at or after @p from, or
+    /// `std::string_view::npos` when the rest of the range has none.
+    [[nodiscard]] size_t Find(size_t from) noexcept
+    {
+        const size_t offset = mCursor.Find(from, [](const ByteClassMasks &masks) { return masks.bytes[0]; });
+        return offset < mSize ? offset : std::string_view::npos;
+    }
+
+private:
+    size_t mSize;
+    ByteClassCursor mCursor;
+};
+
+/// Offset of the last `\n` in @p range, or `std::string_view::npos`.
+/// Classifies 64-byte blocks backwards from the range end.
+[[nodiscard]] inline size_t FindLastNewline(std::string_view range) noexcept
+{
+    size_t blockEnd = range.size();
+    while (blockEnd != 0)
+    {
+        const size_t blockBytes = std::min(blockEnd, BYTE_CLASS_BLOCK_BYTES);
+        const size_t blockStart = blockEnd - blockBytes;
+        std::array<char, BYTE_CLASS_BLOCK_BYTES> padded{};
+        const char *block = range.data() + blockStart;
+        if (blockBytes < BYTE_CLASS_BLOCK_BYTES)
+        {
+            std::memcpy(padded.data(), block, blockBytes);
+            block = padded.data();
+        }
+        const uint64_t newlines = ClassifyBlock(block, NEWLINE_BYTE_CLASSES).bytes[0];
+        if (newlines != 0)
+        {
+            return blockStart + (BYTE_CLASS_BLOCK_BYTES - 1) - static_cast<size_t>(std::countl_zero(newlines));
+        }
+        blockEnd = blockStart;
+    }
+    return std::string_view::npos;
+}
+
+/// One physical line of a Stage B batch.
+struct FramedLine
+{
+    const char *begin = nullptr;
+    /// Just past the last content byte; a trailing `\r` is excluded.
+    const char *contentEnd = nullptr;
+    /// The terminating `\n`, or the batch end for an unterminated line.
+    const char *end = nullptr;
+    /// Start of the next line, or the batch end.
+    const char *next = nullptr;
+    /// Value `localLineOffsets` records for this line. `GetLine`
+    /// subtracts 1 for the `\n`, so an unterminated final line records
+    /// one past the file end to keep its last byte.
+    uint64_t nextOffset = 0;
+
+    /// Line content without the `\n` and trailing `\r`; empty for a
+    /// blank line.
+    [[nodiscard]] std::string_view Text() const noexcept
+    {
+        return {begin, static_cast<size_t>(contentEnd - begin)};
+    }
+};
+
+/// Cuts a Stage B batch `[begin, end)` into physical lines with one
+/// `NewlineScanner`, shared by every parser's batch decoder.
+class LineFramer
+{
+public:
+    /// @p readableEnd is the published file end (at least @p end);
+    /// @p fileBegin anchors `FramedLine::nextOffset`.
+    LineFramer(const char *begin, const char *end, const char *readableEnd, const char *fileBegin) noexcept
+        : mBegin(begin),
+          mEnd(end),
+          mFileBegin(fileBegin),
+          mNext(begin),
+          mScanner(std::string_view(begin, static_cast<size_t>(end - begin)), readableEnd)
+    {
+    }
+
+    /// Frame the line starting at @p lineStart, which must lie in the
+    /// batch. Calls with non-decreasing starts reuse the cached block.
+    [[nodiscard]] FramedLine LineAt(const char *lineStart) noexcept
+    {
+        const size_t newline = mScanner.Find(static_cast<size_t>(lineStart - mBegin));
+        FramedLine line;
+        line.begin = lineStart;
+        line.end = newline != std::string_view::npos ? mBegin + newline : mEnd;
+        line.next = newline != std::string_view::npos ? line.end + 1 : mEnd;
+        line.contentEnd = line.end;
+        if (line.contentEnd != lineStart && *(line.contentEnd - 1) == '\r')
+        {
+            --line.contentEnd;
+        }
+        line.nextOffset =
+            static_cast<uint64_t>(line.next - mFileBegin) + (newline == std::string_view::npos ? 1U : 0U);
+        return line;
+    }
+
+    /// Frame the line at the cursor and advance past it; false once the
+    /// batch is exhausted.
+    bool Next(FramedLine &out) noexcept
+    {
+        if (mNext >= mEnd)
+        {
+            return false;
+        }
+        out = LineAt(mNext);
+        mNext = out.next;
+        return true;
+    }
+
+    /// Move the `Next` cursor to @p lineStart, e.g. after a fast path
+    /// consumed a prefix of the batch.
+    void Resume(const char *lineStart) noexcept
+    {
+        mNext = lineStart;
+    }
+
+private:
+    const char *mBegin;
+    const char *mEnd;
+    const char *mFileBegin;
+    const char *mNext;
+    NewlineScanner mScanner;
+};
+
+} // namespace loglib::internal
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace loglib::internal
+{
+
+/// Byte arena behind `LogFile`'s escape-decoded strings, addressed by
+/// a session-global `uint64_t` offset.
+///
+/// The offset space is handed out separately from the bytes: `Reserve`
+/// claims a range, and `Adopt` later installs a buffer for it without
+/// copying. That lets the static pipeline fix each batch's offsets in
+/// one serial prefix-sum step, rebase the batch's values in parallel,
+/// and move the batch's staging buffer in as one chunk. Chunks may be
+/// adopted out of offset order; reads find them by binary search,
+/// after first trying the chunk the previous read hit and the one
+/// after it, so scans that walk rows in order stay O(1).
+///
+/// A chunk may cover more offsets than it holds bytes (`span`); the
+/// spare range lets `TryExtend` grow the chunk's last string in place,
+/// so a record extended over many batches is not recopied each time.
+///
+/// `Reserve` and `End` are safe from any thread. Everything else is
+/// single-writer, and views returned by `Bytes` stay valid only until
+/// the next write.
+class OwnedStringArena
+{
+public:
+    OwnedStringArena() = default;
+
+    OwnedStringArena(const OwnedStringArena &) = delete;
+    OwnedStringArena &operator=(const OwnedStringArena &) = delete;
+    OwnedStringArena(OwnedStringArena &&) = delete;
+    OwnedStringArena &operator=(OwnedStringArena &&) = delete;
+
+    ~OwnedStringArena() = default;
+
+    /// Claim @p length offsets and return the first. `Reserve(0)`
+    /// returns the current end.
+    uint64_t Reserve(size_t length) noexcept
+    {
+        return mEnd.fetch_add(length, std::memory_order_relaxed);
+    }
+
+    /// One past the highest offset reserved so far.
+    [[nodiscard]] uint64_t End() const noexcept
+    {
+        return mEnd.load(std::memory_order_relaxed);
+    }
+
+    /// Install @p bytes at @p offset, covering `max(span, bytes.size())`
+    /// offsets. The range must come from one `Reserve` call and be
+    /// adopted once. Empty buffers with no spare span are dropped.
+    void Adopt(uint64_t offset, std::string bytes, size_t span = 0);
+
+    /// Append @p bytes to the chunk whose bytes end exactly at @p end.
+    /// Succeeds when that chunk's spare span fits them, or when the
+    /// chunk reaches `End()` and can claim the extra offsets; returns
+    /// false otherwise (the caller copies to a fresh range instead).
+    bool TryExtend(uint64_t end, std::string_view bytes);
+
+    /// Append @p bytes at the end of the arena and return their offset.
+    /// Extends the last chunk when nothing was reserved past it.
+    uint64_t Append(std::string_view bytes);
+
+    /// @p length bytes at @p offset, or an empty view when the range is
+    /// not inside one adopted chunk's bytes.
+    [[nodiscard]] std::string_view Bytes(uint64_t offset, size_t length) const noexcept;
+
+    /// Heap bytes held by the chunks (capacity) and the chunk index.
+    [[nodiscard]] size_t MemoryBytes() const noexcept;
+
+private:
+    struct Chunk
+    {
+        uint64_t offset = 0;
+        /// Offsets owned by the chunk; at least `bytes.size()`.
+        size_t span = 0;
+        std::string bytes;
+    };
+
+    /// Chunk whose bytes end at @p end, or nullptr.
+    Chunk *FindChunkEndingAt(uint64_t end) noexcept;
+
+    /// Chunk whose span covers @p offset, or the last chunk starting
+    /// before it when none does; nullptr when every chunk starts after.
+    const Chunk *FindChunkCovering(uint64_t offset) const noexcept;
+
+    /// Sorted by `offset`; ranges never overlap.
+    std::vector<Chunk> mChunks;
+    std::atomic<uint64_t> mEnd{0};
+    /// Index of the chunk the last read resolved to. Only a hint: it is
+    /// checked against the chunk's range before use, so a stale value
+    /// after an `Adopt` costs one binary search, never a wrong read.
+    mutable std::atomic<size_t> mLastChunk{0};
+};
+
+} // namespace loglib::internal
@@ -33,6 +33,9 @@ struct WorkerScratchBase
     std::vector<std::optional<LastValidTimestampParse>> lastValidTimestamps;
     TimestampParseScratch tsScratch;
     std::vector<LastTimestampBytesHit> lastBytesHits;
+    /// Field-slab bytes this worker's previous batch used; sizes the next
+    /// batch's `LineFieldSlab`.
+    size_t fieldSlabBytesHint = 0;
 
     void EnsureTimeColumnCapacity(size_t n)
     {
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "loglib/internal/advanced_parser_options.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace loglib::internal
+{
+
+/// Runtime tuning for `RunStaticParserPipeline`. Stage C feeds it one
+/// observation per batch (bytes, lines, Stage B and Stage C latency);
+/// Stage A reads the batch size to cut next.
+///
+/// - When `batchSizeBytes` was left at its default, batch size steers
+///   Stage B latency towards `TARGET_STAGE_B_LATENCY`, so expensive
+///   wide rows get smaller batches and Stage C keeps streaming, but
+///   never below `MIN_LINES_PER_BATCH` lines, so cheap narrow rows
+///   amortise the per-batch overhead. It moves at most 2x per batch
+///   within [`MIN_BATCH_BYTES`, `MAX_BATCH_BYTES`], and ignores
+///   drifts under an eighth.
+/// - After `CALIBRATION_BATCHES`, when `threads` was left at `0` and
+///   Stage B (divided across workers) is slower per batch than the
+///   serial Stage C, it requests one wider pipeline run with enough
+///   workers to catch Stage C up, up to `hardwareThreads`. Stage A
+///   drains the running pipeline when `ReplanPending()` and the
+///   pipeline restarts with `Replan()`'s thread and token counts.
+///
+/// `Observe` must be called from one thread at a time (Stage C is
+/// `serial_in_order`); `BatchSizeBytes` and `ReplanPending` are safe
+/// from Stage A concurrently.
+class PipelineAutotuner
+{
+public:
+    static constexpr size_t MIN_BATCH_BYTES = 64 * 1024;
+    static constexpr size_t MAX_BATCH_BYTES = 8 * 1024 * 1024;
+    /// Well under `STATIC_BATCH_FLUSH_INTERVAL`, so a flush never
+    /// waits on a single batch.
+    static constexpr auto TARGET_STAGE_B_LATENCY = std::chrono::milliseconds(10);
+    static constexpr size_t MIN_LINES_PER_BATCH = 4096;
+    static constexpr uint64_t CALIBRATION_BATCHES = 8;
+    /// Batch sizes are rounded up to a multiple of this.
+    static constexpr size_t BATCH_SIZE_GRANULE = 4 * 1024;
+
+    /// @p threads / @p ntokens are the settings the first pipeline run
+    /// uses; @p hardwareThreads bounds any later widening.
+    PipelineAutotuner(
+        const AdvancedParserOptions &advanced, unsigned int threads, size_t ntokens, unsigned int hardwareThreads
+    );
+
+    PipelineAutotuner(const PipelineAutotuner &) = delete;
+    PipelineAutotuner &operator=(const PipelineAutotuner &) = delete;
+    PipelineAutotuner(PipelineAutotuner &&) = delete;
+    PipelineAutotuner &operator=(PipelineAutotuner &&) = delete;
+
+    [[nodiscard]] size_t BatchSizeBytes() const noexcept
+    {
+        return mBatchSize.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] bool ReplanPending() const noexcept
+    {
+        return mReplanPending.load(std::memory_order_acquire);
+    }
+
+    /// Record one finished batch of @p bytes holding @p lines source
+    /// lines, and retune. Calls the `onTuning` hook when the batch
+    /// size changes.
+    void Observe(size_t bytes, size_t lines, std::chrono::nanoseconds stageB, std::chrono::nanoseconds stageC);
+
+    /// Apply a pending thread-count change. Call between pipeline
+    /// runs only; reports the new settings through `onTuning`.
+    void Replan();
+
+    /// Current parameters and the smoothed observations behind them.
+    [[nodiscard]] PipelineTuning Current() const;
+
+    /// Forward `Current()` to the `onTuning` hook, if set.
+    void Report() const;
+
+private:
+    void RetuneBatchSize();
+    void DecideThreads();
+
+    const AdvancedParserOptions &mAdvanced;
+    const bool mAdaptBatchSize;
+    const bool mAdaptThreads;
+    const unsigned int mHardwareThreads;
+
+    unsigned int mThreads;
+    size_t mTokens;
+    std::atomic<size_t> mBatchSize;
+    std::atomic<bool> mReplanPending{false};
+    unsigned int mPendingThreads = 0;
+    bool mThreadsDecided = false;
+
+    uint64_t mObservedBatches = 0;
+    double mBytesPerLine = 0.0;
+    double mStageBNanosPerByte = 0.0;
+    double mStageCNanosPerByte = 0.0;
+    double mStageBNanos = 0.0;
+    double mStageCNanos = 0.0;
+};
+
+} // namespace loglib::internal
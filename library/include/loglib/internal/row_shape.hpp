@@ -0,0 +1,128 @@
+#pragma once
+
+#include "loglib/internal/compact_log_value.hpp"
+#include "loglib/key_index.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <shared_mutex>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace loglib::internal
+{
+
+/// Interned sorted `KeyId` set shared by every row carrying exactly
+/// those keys. Holds a dense `KeyId -> slot` table so a row of this
+/// shape finds a key's slot with one indexed load instead of scanning
+/// its `CompactLineFields`.
+class RowShape
+{
+public:
+    /// `SlotOf` result for keys the shape does not carry.
+    static constexpr uint16_t NO_SLOT = std::numeric_limits<uint16_t>::max();
+
+    RowShape(std::vector<KeyId> keys, uint64_t hash, uint64_t ownerSerial);
+
+    [[nodiscard]] std::span<const KeyId> Keys() const noexcept
+    {
+        return mKeys;
+    }
+
+    [[nodiscard]] uint32_t Size() const noexcept
+    {
+        return static_cast<uint32_t>(mKeys.size());
+    }
+
+    /// Slot index of @p id in rows of this shape, or `NO_SLOT`.
+    [[nodiscard]] uint16_t SlotOf(KeyId id) const noexcept
+    {
+        return id < mSlotOfKey.size() ? mSlotOfKey[id] : NO_SLOT;
+    }
+
+    /// True when @p fields carries exactly this shape's keys.
+    [[nodiscard]] bool Matches(std::span<const std::pair<KeyId, CompactLogValue>> fields) const noexcept;
+
+    [[nodiscard]] uint64_t Hash() const noexcept
+    {
+        return mHash;
+    }
+
+    /// Serial of the `RowShapeRegistry` that interned this shape.
+    [[nodiscard]] uint64_t OwnerSerial() const noexcept
+    {
+        return mOwnerSerial;
+    }
+
+    /// Heap bytes owned (key list + slot table).
+    [[nodiscard]] size_t MemoryBytes() const noexcept;
+
+private:
+    std::vector<KeyId> mKeys;
+    /// Indexed by `KeyId`, sized `max(mKeys) + 1`.
+    std::vector<uint16_t> mSlotOfKey;
+    uint64_t mHash = 0;
+    uint64_t mOwnerSerial = 0;
+};
+
+/// Thread-safe intern table of `RowShape`s, owned by a `KeyIndex`
+/// (shapes are only meaningful against one `KeyId` space). Shapes are
+/// never freed before the registry, so `const RowShape *` handles stay
+/// valid for its lifetime and across `KeyIndex` moves.
+///
+/// A per-thread "last shape" cache makes the common case (consecutive
+/// rows of one shape) lock-free; misses take the registry lock.
+class RowShapeRegistry
+{
+public:
+    /// Rows whose largest `KeyId` reaches this stay unshaped, bounding
+    /// each slot table at 32 KiB.
+    static constexpr KeyId MAX_SHAPED_KEY_ID = 16384;
+
+    /// Interning stops past this many shapes (heterogeneous logs); later
+    /// key sets fall back to the linear scan.
+    static constexpr size_t MAX_SHAPES = 1024;
+
+    RowShapeRegistry();
+
+    RowShapeRegistry(const RowShapeRegistry &) = delete;
+    RowShapeRegistry &operator=(const RowShapeRegistry &) = delete;
+    RowShapeRegistry(RowShapeRegistry &&) = delete;
+    RowShapeRegistry &operator=(RowShapeRegistry &&) = delete;
+
+    ~RowShapeRegistry() = default;
+
+    /// Shape for @p fields (sorted by `KeyId`), or nullptr when the row
+    /// is empty, too wide, or the registry is full.
+    [[nodiscard]] const RowShape *Intern(std::span<const std::pair<KeyId, CompactLogValue>> fields);
+
+    /// True when @p shape was interned here.
+    [[nodiscard]] bool Owns(const RowShape *shape) const noexcept
+    {
+        return shape != nullptr && shape->OwnerSerial() == mSerial;
+    }
+
+    [[nodiscard]] size_t Size() const;
+
+    /// Heap bytes owned across all shapes.
+    [[nodiscard]] size_t MemoryBytes() const;
+
+private:
+    /// Process-unique; lets the per-thread cache tell registries apart
+    /// even when one is destroyed and another reuses its address.
+    uint64_t mSerial;
+    mutable std::shared_mutex mMutex;
+    std::deque<RowShape> mShapes;
+    std::unordered_map<uint64_t, std::vector<const RowShape *>> mByHash;
+};
+
+/// `keys.Shapes().Intern(fields)`.
+[[nodiscard]] const RowShape *InternRowShape(
+    const KeyIndex &keys, std::span<const std::pair<KeyId, CompactLogValue>> fields
+);
+
+} // namespace loglib::internal
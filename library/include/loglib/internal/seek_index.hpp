@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace loglib::internal
+{
+
+/// Place inside a single-member-style gzip stream where inflate can
+/// restart without decoding what came before (zlib's `zran` scheme):
+/// a deflate block boundary plus the 32 KiB window preceding it.
+struct GzipSeekPoint
+{
+    /// First input byte not fully consumed at the boundary.
+    std::uint64_t compressedOffset = 0;
+    /// Decoded bytes produced before the boundary.
+    std::uint64_t decodedOffset = 0;
+    /// Unused low bits of the byte at `compressedOffset - 1` (0-7).
+    std::uint8_t bits = 0;
+    /// Up to 32 KiB of decoded output ending at `decodedOffset`.
+    std::vector<std::uint8_t> window;
+};
+
+/// Seek points for one compressed file, plus what identifies the exact
+/// bytes they were recorded from. Stored as a sidecar file in a cache
+/// directory, keyed by the source's `FileIdentity`.
+struct GzipSeekIndex
+{
+    std::uint64_t compressedSize = 0;
+    std::int64_t modifiedTime = 0;
+    /// `SeekIndexFingerprint` of the compressed bytes.
+    std::uint64_t fingerprint = 0;
+    std::uint64_t decodedSize = 0;
+    /// Ascending by both offsets.
+    std::vector<GzipSeekPoint> points;
+};
+
+/// Default decoded distance between seek points; also the work unit of
+/// an indexed parallel decode.
+inline constexpr std::size_t DEFAULT_SEEK_POINT_SPACING_BYTES = std::size_t{8} << 20;
+
+/// Sidecars kept per cache directory; `SaveGzipSeekIndex` drops the
+/// least recently written beyond this.
+inline constexpr std::size_t MAX_SEEK_INDEX_FILES = 256;
+
+/// Cheap content check over the head and tail of @p compressed; catches
+/// a same-size rewrite that kept the modification time.
+[[nodiscard]] std::uint64_t SeekIndexFingerprint(std::span<const std::uint8_t> compressed) noexcept;
+
+/// Sidecar path for @p source in @p indexDir, or empty when the file's
+/// identity cannot be read.
+[[nodiscard]] std::filesystem::path SeekIndexPath(
+    const std::filesystem::path &indexDir, const std::filesystem::path &source
+);
+
+/// Load the sidecar for @p source. Returns nullopt when there is none,
+/// it is malformed, or it was recorded from different bytes (size,
+/// modification time, or @p fingerprint differ).
+[[nodiscard]] std::optional<GzipSeekIndex> LoadGzipSeekIndex(
+    const std::filesystem::path &indexDir, const std::filesystem::path &source, std::uint64_t fingerprint
+) noexcept;
+
+/// Persist @p index for @p source, replacing any older sidecar
+/// atomically. `modifiedTime` is stamped from @p source at save time;
+/// the caller fills the other identity fields. Best-effort: a cache
+/// that cannot be written only costs the next open its parallelism,
+/// so failures are swallowed.
+void SaveGzipSeekIndex(
+    const std::filesystem::path &indexDir, const std::filesystem::path &source, const GzipSeekIndex &index
+) noexcept;
+
+} // namespace loglib::internal
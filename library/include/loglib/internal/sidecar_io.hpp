@@ -0,0 +1,145 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <ios>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace loglib::internal
+{
+
+/// Little-endian field writer for cache sidecars (`GzipSeekIndex`,
+/// `TrigramIndex`). Stream errors stick on the `ofstream`; callers
+/// check it once at the end.
+class SidecarWriter
+{
+public:
+    explicit SidecarWriter(std::ofstream &out) noexcept
+        : mOut(out)
+    {
+    }
+
+    template <class T> void Put(T value)
+    {
+        std::array<char, sizeof(T)> bytes{};
+        for (std::size_t i = 0; i < sizeof(T); ++i)
+        {
+            bytes[i] = static_cast<char>((static_cast<std::uint64_t>(value) >> (8 * i)) & 0xff);
+        }
+        mOut.write(bytes.data(), bytes.size());
+    }
+
+    /// `Put` every element of @p values with one stream write.
+    template <class T> void PutArray(std::span<const T> values)
+    {
+        mScratch.resize(values.size() * sizeof(T));
+        char *out = mScratch.data();
+        for (const T value : values)
+        {
+            for (std::size_t i = 0; i < sizeof(T); ++i)
+            {
+                *out++ = static_cast<char>((static_cast<std::uint64_t>(value) >> (8 * i)) & 0xff);
+            }
+        }
+        PutBytes(mScratch.data(), mScratch.size());
+    }
+
+    void PutBytes(const void *data, std::size_t size)
+    {
+        mOut.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+    }
+
+private:
+    std::ofstream &mOut;
+    std::vector<char> mScratch;
+};
+
+/// Reader counterpart of `SidecarWriter`. Every getter returns false
+/// once the stream runs short.
+class SidecarReader
+{
+public:
+    explicit SidecarReader(std::ifstream &in) noexcept
+        : mIn(in)
+    {
+    }
+
+    template <class T> [[nodiscard]] bool Get(T &value)
+    {
+        std::array<unsigned char, sizeof(T)> bytes{};
+        if (!GetBytes(bytes.data(), bytes.size()))
+        {
+            return false;
+        }
+        std::uint64_t raw = 0;
+        for (std::size_t i = 0; i < sizeof(T); ++i)
+        {
+            raw |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+        }
+        value = static_cast<T>(raw);
+        return true;
+    }
+
+    /// Fill every element of @p values with one stream read.
+    template <class T> [[nodiscard]] bool GetArray(std::span<T> values)
+    {
+        mScratch.resize(values.size() * sizeof(T));
+        if (!GetBytes(mScratch.data(), mScratch.size()))
+        {
+            return false;
+        }
+        const unsigned char *in = mScratch.data();
+        for (T &value : values)
+        {
+            std::uint64_t raw = 0;
+            for (std::size_t i = 0; i < sizeof(T); ++i)
+            {
+                raw |= static_cast<std::uint64_t>(*in++) << (8 * i);
+            }
+            value = static_cast<T>(raw);
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool GetBytes(void *data, std::size_t size)
+    {
+        return static_cast<bool>(mIn.read(static_cast<char *>(data), static_cast<std::streamsize>(size)));
+    }
+
+private:
+    std::ifstream &mIn;
+    std::vector<unsigned char> mScratch;
+};
+
+/// Modification time of @p path as a raw clock count, or nullopt when
+/// it cannot be read.
+[[nodiscard]] std::optional<std::int64_t> ModifiedTime(const std::filesystem::path &path) noexcept;
+
+/// `<indexDir>/<identity><extension>` for @p source, keyed by its
+/// `FileIdentity` so renames keep the sidecar; empty when the identity
+/// cannot be read or @p indexDir is empty.
+[[nodiscard]] std::filesystem::path SidecarPath(
+    const std::filesystem::path &indexDir, const std::filesystem::path &source, std::string_view extension
+);
+
+/// Create @p sidecar's directory, run @p write against a staging file
+/// beside it and rename that over @p sidecar, so a concurrent reader
+/// sees either the old sidecar or the complete new one. The staging
+/// file is removed when @p write returns false or any step fails.
+/// Returns whether @p sidecar was replaced.
+bool WriteSidecarAtomically(
+    const std::filesystem::path &sidecar, const std::function<bool(SidecarWriter &)> &write
+) noexcept;
+
+/// Drop the least recently written `*<extension>` files in @p indexDir
+/// beyond @p maxFiles.
+void PruneSidecars(const std::filesystem::path &indexDir, std::string_view extension, std::size_t maxFiles) noexcept;
+
+} // namespace loglib::internal
@@ -5,7 +5,9 @@
 #include "loglib/internal/batch_coalescer.hpp"
 #include "loglib/internal/compact_log_value.hpp"
 #include "loglib/internal/line_decoder.hpp"
+#include "loglib/internal/line_field_slab.hpp"
 #include "loglib/internal/parse_runtime.hpp"
+#include "loglib/internal/pipeline_autotuner.hpp"
 #include "loglib/internal/timestamp_promotion.hpp"
 #include "loglib/key_index.hpp"
 #include "loglib/log_file.hpp"
@@ -25,10 +27,14 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
+#include <memory>
 #include <optional>
 #include <span>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -39,6 +45,11 @@ namespace loglib::internal
 constexpr size_t STATIC_BATCH_FLUSH_LINES = 1000;
 constexpr auto STATIC_BATCH_FLUSH_INTERVAL = std::chrono::milliseconds(50);
 
+/// Stage A keeps the OS reading this many batches (but at least
+/// `STATIC_MIN_PREFETCH_BYTES`) past its cut cursor.
+constexpr size_t STATIC_PREFETCH_BATCHES = 8;
+constexpr size_t STATIC_MIN_PREFETCH_BYTES = size_t{16} * 1024 * 1024;
+
 /// Stage B per-line error. `relativeLine` is 1-based within the batch;
 /// Stage C composes the absolute "Error on line N: ..." wrapper using
 /// its running line-number cursor.
@@ -52,16 +63,25 @@ struct ParsedLineError
 struct ParsedPipelineBatch
 {
     uint64_t batchIndex = 0;
+    /// Slab the batch's `CompactLineFields` were carved from; Stage C
+    /// hands it to the `LogFile`. Declared before `lines` so a dropped
+    /// batch destroys its rows first.
+    std::unique_ptr<LineFieldSlab> fieldSlab;
     std::vector<LogLine> lines;
     std::vector<uint64_t> localLineOffsets;
     std::vector<ParsedLineError> errors;
     /// Per-batch owned-string staging. Stage B appends escape-decoded
-    /// bytes; Stage C concatenates into the `LogFile` arena and
-    /// rebases the offsets on `lines` in one pass.
+    /// bytes; the reserve stage claims an equal range of the `LogFile`
+    /// arena, the place stage rebases the offsets on `lines`, and
+    /// Stage C moves the buffer in as one chunk.
     std::string ownedStringsArena;
     /// Source lines consumed (parsed + errors + skipped empties);
-    /// advances Stage C's line-number cursor across batches.
+    /// advances the reserve stage's line-number cursor across batches.
     size_t totalLineCount = 0;
+    /// Set by the reserve stage: source lines in earlier batches, and
+    /// the `LogFile` arena offset reserved for `ownedStringsArena`.
+    size_t lineNumberDelta = 0;
+    uint64_t ownedStringsOffset = 0;
     /// Newline-separated continuation bytes at the start of this
     /// batch, to be spliced into the preceding batch's held record.
     std::string leadingContinuationBytes;
@@ -88,6 +108,10 @@ struct ParsedPipelineBatch
         size_t lastPhysicalLine = 0;
     };
     std::vector<MultiLineSpan> completedMultiLineSpans;
+
+    /// Token byte count and Stage B wall time, for `PipelineAutotuner`.
+    size_t batchBytes = 0;
+    std::chrono::nanoseconds stageBElapsed{0};
 };
 
 /// Resolved defaults for `effectiveThreads` and `ntokens`. Both >= 1.
@@ -100,8 +124,9 @@ struct ResolvedPipelineSettings
 ResolvedPipelineSettings ResolvePipelineSettings(const AdvancedParserOptions &advanced);
 
 /// Append @p leadingContinuationBytes to @p heldLine's `targetKey`.
-/// Arena-tail values extend in place to keep records spanning many
-/// batches linear; other values are copied and rebased at the tail.
+/// Values copied here reserve twice their size, so later continuations
+/// of a record spanning many batches extend in place and the total
+/// copying stays linear; other values are copied to a fresh range.
 inline ContinuationSpliceOutcome SpliceCrossBatchContinuation(
     LogLine &heldLine, LogFile &file, KeyId targetKey, std::string_view leadingContinuationBytes
 )
@@ -125,18 +150,18 @@ inline ContinuationSpliceOutcome SpliceCrossBatchContinuation(
         return ContinuationSpliceOutcome::NonStringTarget;
     }
 
-    const std::string_view arenaView = file.OwnedStringsView();
-
     // Avoid repeatedly copying records that span several batches.
-    if (slot->tag == CompactTag::OwnedString && slot->payload + slot->aux == arenaView.size())
+    if (slot->tag == CompactTag::OwnedString)
     {
         std::string extension;
         extension.reserve(1 + leadingContinuationBytes.size());
         extension.push_back('\n');
         extension.append(leadingContinuationBytes);
-        (void)file.AppendOwnedStrings(extension);
-        slot->aux = static_cast<uint32_t>(static_cast<size_t>(slot->aux) + extension.size());
-        return ContinuationSpliceOutcome::Ok;
+        if (file.TryExtendOwnedStrings(slot->payload + slot->aux, extension))
+        {
+            slot->aux = static_cast<uint32_t>(static_cast<size_t>(slot->aux) + extension.size());
+            return ContinuationSpliceOutcome::Ok;
+        }
     }
 
     std::string joined;
@@ -159,23 +184,172 @@ inline ContinuationSpliceOutcome SpliceCrossBatchContinuation(
     }
     joined.append(leadingContinuationBytes);
 
-    const uint64_t offset = file.AppendOwnedStrings(joined);
+    // The reserve stage may already have claimed ranges for later
+    // batches, so the arena tail is rarely free; leave room to grow.
+    const size_t joinedSize = joined.size();
+    const size_t span = 2 * joinedSize;
+    const uint64_t offset = file.ReserveOwnedStrings(span);
+    file.AdoptOwnedStrings(offset, std::move(joined), span);
     slot->tag = CompactTag::OwnedString;
     slot->payload = offset;
-    slot->aux = static_cast<uint32_t>(joined.size());
+    slot->aux = static_cast<uint32_t>(joinedSize);
     return ContinuationSpliceOutcome::Ok;
 }
 
+/// Stage A driver shared by the static parsers: cuts `batchSize`
+/// bytes and extends the batch through the next newline, so batches
+/// never split a line. Tokens expose `batchIndex`, `bytesBegin`,
+/// `bytesEnd`, and `fileEnd`. The `Next(out, batchSize)` overload
+/// cuts to a per-call size, which is how the pipeline's autotuned
+/// batch size reaches Stage A.
+///
+/// Each cut keeps a `LogFile::AdviseWillNeed` window open ahead of the
+/// cursor, so page faults in Stage B hit pages already being read.
+///
+/// Over a growing `LogFile` (progressive decompression) a cut waits
+/// until a full batch and its closing newline are published, or the
+/// file stops growing. `fileEnd` is then the published end at cut
+/// time, so Stage B never reads bytes still being written.
+class StaticBatchCutter
+{
+public:
+    StaticBatchCutter(const LogFile &file, size_t batchSize, StopToken stopToken)
+        : mFile(file), mBatchSize(std::max<size_t>(batchSize, 1)), mStopToken(std::move(stopToken))
+    {
+    }
+
+    template <class Token> bool Next(Token &out)
+    {
+        return Next(out, mBatchSize);
+    }
+
+    template <class Token> bool Next(Token &out, size_t batchSize)
+    {
+        batchSize = std::max<size_t>(batchSize, 1);
+        const char *base = mFile.Data();
+        if (base == nullptr)
+        {
+            return false;
+        }
+        PrefetchAhead(batchSize);
+        for (;;)
+        {
+            // Growth state before size: once growth is seen to have
+            // ended, the size read after it is final.
+            const bool growing = mFile.IsGrowing();
+            const size_t size = mFile.Size();
+            const size_t remaining = size - mCursor;
+            if (remaining > batchSize)
+            {
+                const size_t scanFrom = std::max(mCursor + batchSize, mScanFrom);
+                const auto *newline =
+                    static_cast<const char *>(std::memchr(base + scanFrom, '\n', size - scanFrom));
+                if (newline != nullptr)
+                {
+                    return Cut(out, base, static_cast<size_t>(newline - base) + 1, size);
+                }
+                mScanFrom = size;
+            }
+            if (!growing)
+            {
+                return remaining != 0 && Cut(out, base, size, size);
+            }
+            if (mStopToken.stop_requested())
+            {
+                return false;
+            }
+            (void)mFile.WaitForGrowth(size, mStopToken);
+        }
+    }
+
+private:
+    void PrefetchAhead(size_t batchSize)
+    {
+        const size_t window = std::max(batchSize * STATIC_PREFETCH_BATCHES, STATIC_MIN_PREFETCH_BYTES);
+        // Re-arm once half the window is consumed: each hint then
+        // covers at least half a window of new bytes.
+        if (mPrefetchedTo > mCursor + (window / 2))
+        {
+            return;
+        }
+        const size_t from = std::max(mPrefetchedTo, mCursor);
+        mFile.AdviseWillNeed(from, mCursor + window - from);
+        mPrefetchedTo = mCursor + window;
+    }
+
+    template <class Token> bool Cut(Token &out, const char *base, size_t end, size_t publishedSize)
+    {
+        out.batchIndex = mBatchIndex++;
+        out.bytesBegin = base + mCursor;
+        out.bytesEnd = base + end;
+        out.fileEnd = base + publishedSize;
+        mCursor = end;
+        mScanFrom = end;
+        return true;
+    }
+
+    const LogFile &mFile;
+    size_t mBatchSize;
+    StopToken mStopToken;
+    size_t mCursor = 0;
+    /// Bytes past here were not yet searched for a newline.
+    size_t mScanFrom = 0;
+    /// End of the last `AdviseWillNeed` window.
+    size_t mPrefetchedTo = 0;
+    uint64_t mBatchIndex = 0;
+};
+
+/// Wait until a growing @p file has published its first non-blank
+/// line in full, or has stopped growing. Parsers that read a header
+/// before the pipeline starts call this first.
+inline void WaitForFirstLine(const LogFile &file, const StopToken &stopToken)
+{
+    size_t scanned = 0;
+    bool sawContent = false;
+    while (file.IsGrowing() && !stopToken.stop_requested())
+    {
+        const size_t size = file.Size();
+        const char *data = file.Data();
+        for (; scanned < size; ++scanned)
+        {
+            const char c = data[scanned];
+            if (c == '\n')
+            {
+                if (sawContent)
+                {
+                    return;
+                }
+            }
+            else if (c != '\r')
+            {
+                sawContent = true;
+            }
+        }
+        (void)file.WaitForGrowth(size, stopToken);
+    }
+}
+
 /// Static-file TBB pipeline. Stage A (`serial_in_order`) drives
-/// tokens; Stage B (`parallel`) decodes; Stage C (`serial_in_order`)
-/// rebases per-batch arenas into `source.File()`'s session-global
-/// arena, coalesces, diffs new keys, runs inline timestamp promotion,
-/// and honours `stop_token`. Stage B stamps each emitted `LogLine` with
-/// `&source` and its absolute `lineId`.
+/// tokens; Stage B (`parallel`) decodes; a reserve stage
+/// (`serial_in_order`) prefix-sums line counts and claims each batch's
+/// range of `source.File()`'s session-global arena; a place stage
+/// (`parallel`) shifts line ids and rebases owned-string offsets into
+/// that range; Stage C (`serial_in_order`) adopts the per-batch arena
+/// without copying, splices cross-batch continuations, coalesces,
+/// diffs new keys, and honours `stop_token`. Stage B stamps each
+/// emitted `LogLine` with `&source` and runs inline timestamp
+/// promotion; the place stage makes its `lineId` absolute.
 ///
 /// @p newKeyBaseline forwards to `BatchCoalescer` (see its docstring);
 /// parsers that intern their schema before the pipeline pass the
 /// pre-intern key count. Defaults to the index's current size.
+///
+/// A `stageADriver` invocable as `(Token &, size_t batchSize)` cuts to
+/// the `PipelineAutotuner`'s current size; one taking only `Token &`
+/// keeps its own. When the tuner asks for more workers, Stage A stops
+/// cutting, the running pipeline drains, and a wider one resumes from
+/// the same cursor; every piece of cross-batch state below lives
+/// outside the stage lambdas, so the restart is invisible to the sink.
 // `stageADriver` / `stageBDecoder` are forwarding refs to keep both
 // lvalue and rvalue callables callable without an explicit `std::move`
 // at the call site, but they are captured by the inner `[&]` lambdas
@@ -218,13 +392,25 @@ void RunStaticParserPipeline(
         return;
     }
 
+    // A growing file is empty only once the decoder says so.
+    if (file.IsGrowing())
+    {
+        (void)file.WaitForGrowth(0, options.stopToken);
+    }
+
     if (file.Size() == 0 || file.Data() == nullptr)
     {
-        coalescer.Finish(1, false);
+        file.StopGrowing();
+        coalescer.Finish(1, options.stopToken.stop_requested());
         return;
     }
 
+    // Stage A reads front to back; rows are looked up at random once
+    // the parse is done (see the `AdviseRandomAccess` below).
+    file.AdviseSequentialAccess();
+
     const ResolvedPipelineSettings settings = ResolvePipelineSettings(advanced);
+    PipelineAutotuner tuner(advanced, settings.effectiveThreads, settings.ntokens, std::thread::hardware_concurrency());
     file.ReserveLineOffsets(file.Size() / 100);
 
     const std::vector<TimeColumnSpec> timeColumns = BuildTimeColumnSpecs(keys, options.configuration.get());
@@ -232,6 +418,7 @@ void RunStaticParserPipeline(
     oneapi::tbb::enumerable_thread_specific<WorkerScratch<UserState>> workers;
 
     const bool prefersUncoalesced = sink.PrefersUncoalesced();
+    size_t reservedLineCount = 0;
     size_t nextLineNumber = 1;
 
     // Stage C holds a batch's open final record until the next batch
@@ -250,16 +437,26 @@ void RunStaticParserPipeline(
     const StopToken stopToken = options.stopToken;
     std::span<const TimeColumnSpec> timeColumnsSpan(timeColumns);
 
+    bool inputExhausted = false;
     auto stageA = [&](oneapi::tbb::flow_control &fc) -> Token {
-        if (stopToken.stop_requested())
+        if (stopToken.stop_requested() || tuner.ReplanPending())
         {
             fc.stop();
             return Token{};
         }
         Token token{};
-        const bool produced = stageADriver(token);
+        bool produced = false;
+        if constexpr (std::is_invocable_r_v<bool, StageADriver &, Token &, size_t>)
+        {
+            produced = stageADriver(token, tuner.BatchSizeBytes());
+        }
+        else
+        {
+            produced = stageADriver(token);
+        }
         if (!produced)
         {
+            inputExhausted = true;
             fc.stop();
             return Token{};
         }
@@ -270,21 +467,60 @@ void RunStaticParserPipeline(
         WorkerScratch<UserState> &worker = workers.local();
         worker.EnsureTimeColumnCapacity(timeColumnsSpan.size());
 
+        // One slab per batch, sized from this worker's previous batch so
+        // steady state carves every row from a single block.
+        const auto started = std::chrono::steady_clock::now();
         ParsedPipelineBatch parsed;
-        stageBDecoder(std::move(token), worker, keys, timeColumnsSpan, parsed);
+        parsed.batchBytes = static_cast<size_t>(token.bytesEnd - token.bytesBegin);
+        const size_t hint = worker.fieldSlabBytesHint;
+        parsed.fieldSlab =
+            std::make_unique<LineFieldSlab>(hint != 0 ? hint + (hint / 8) : LineFieldSlab::DEFAULT_BLOCK_BYTES);
+        {
+            const ScopedLineFieldSlab slabScope(*parsed.fieldSlab);
+            stageBDecoder(std::move(token), worker, keys, timeColumnsSpan, parsed);
+        }
+        worker.fieldSlabBytesHint = parsed.fieldSlab->UsedBytes();
+        parsed.stageBElapsed = std::chrono::steady_clock::now() - started;
 
         return parsed;
     };
 
-    auto stageC = [&](ParsedPipelineBatch parsed) {
-        const size_t lineNumberDelta = nextLineNumber - 1;
-        if (lineNumberDelta != 0)
+    // The only serial work that needs a batch's predecessors: O(1) per
+    // batch, so it never bounds the pipeline the way the per-line
+    // passes below would.
+    auto stageReserve = [&](ParsedPipelineBatch parsed) -> ParsedPipelineBatch {
+        parsed.lineNumberDelta = reservedLineCount;
+        reservedLineCount += parsed.totalLineCount;
+        if (!parsed.ownedStringsArena.empty())
+        {
+            parsed.ownedStringsOffset = file.ReserveOwnedStrings(parsed.ownedStringsArena.size());
+        }
+        return parsed;
+    };
+
+    // Make line ids and `OwnedString` offsets absolute, in parallel.
+    // Counted as Stage B time for the tuner: it scales with workers.
+    auto stagePlace = [&](ParsedPipelineBatch parsed) -> ParsedPipelineBatch {
+        const auto started = std::chrono::steady_clock::now();
+        const size_t lineNumberDelta = parsed.lineNumberDelta;
+        const uint64_t arenaDelta = parsed.ownedStringsOffset;
+        if (lineNumberDelta != 0 || arenaDelta != 0)
         {
             for (LogLine &line : parsed.lines)
             {
                 line.ShiftLineId(lineNumberDelta);
+                line.RebaseOwnedStringOffsets(arenaDelta);
             }
         }
+        parsed.stageBElapsed += std::chrono::steady_clock::now() - started;
+        return parsed;
+    };
+
+    auto stageCBody = [&](ParsedPipelineBatch parsed) {
+        file.AdoptFieldSlab(std::move(parsed.fieldSlab));
+
+        const size_t lineNumberDelta = parsed.lineNumberDelta;
+        assert(lineNumberDelta == nextLineNumber - 1);
 
         // Registration belongs to the sink thread and must follow
         // `AppendLineOffsets`; registering here would race readers and
@@ -304,16 +540,12 @@ void RunStaticParserPipeline(
             }
         }
 
-        // Rebase per-batch `OwnedString` offsets into the `LogFile`
-        // arena. Stage C is serial_in_order, so this write is
-        // single-threaded.
+        // The place stage already pointed `lines` at the reserved
+        // range. Stage C is serial_in_order, so adoption and the
+        // splice below are the arena's only writers.
         if (!parsed.ownedStringsArena.empty())
         {
-            const uint64_t delta = file.AppendOwnedStrings(parsed.ownedStringsArena);
-            for (LogLine &line : parsed.lines)
-            {
-                line.RebaseOwnedStringOffsets(delta);
-            }
+            file.AdoptOwnedStrings(parsed.ownedStringsOffset, std::move(parsed.ownedStringsArena));
         }
 
         // Splice leading continuations before deciding whether the
@@ -532,16 +764,41 @@ void RunStaticParserPipeline(
         }
     };
 
-    oneapi::tbb::global_control gc(
-        oneapi::tbb::global_control::max_allowed_parallelism, static_cast<size_t>(settings.effectiveThreads)
-    );
+    auto stageC = [&](ParsedPipelineBatch parsed) {
+        const auto started = std::chrono::steady_clock::now();
+        const size_t bytes = parsed.batchBytes;
+        const size_t lines = parsed.totalLineCount;
+        const std::chrono::nanoseconds stageBElapsed = parsed.stageBElapsed;
+        stageCBody(std::move(parsed));
+        tuner.Observe(bytes, lines, stageBElapsed, std::chrono::steady_clock::now() - started);
+    };
 
-    oneapi::tbb::parallel_pipeline(
-        settings.ntokens,
-        oneapi::tbb::make_filter<void, Token>(oneapi::tbb::filter_mode::serial_in_order, stageA) &
-            oneapi::tbb::make_filter<Token, ParsedPipelineBatch>(oneapi::tbb::filter_mode::parallel, stageB) &
-            oneapi::tbb::make_filter<ParsedPipelineBatch, void>(oneapi::tbb::filter_mode::serial_in_order, stageC)
-    );
+    tuner.Report();
+    for (;;)
+    {
+        const PipelineTuning run = tuner.Current();
+        const oneapi::tbb::global_control gc(
+            oneapi::tbb::global_control::max_allowed_parallelism, static_cast<size_t>(run.threads)
+        );
+        oneapi::tbb::parallel_pipeline(
+            run.ntokens,
+            oneapi::tbb::make_filter<void, Token>(oneapi::tbb::filter_mode::serial_in_order, stageA) &
+                oneapi::tbb::make_filter<Token, ParsedPipelineBatch>(oneapi::tbb::filter_mode::parallel, stageB) &
+                oneapi::tbb::make_filter<ParsedPipelineBatch, ParsedPipelineBatch>(
+                    oneapi::tbb::filter_mode::serial_in_order, stageReserve
+                ) &
+                oneapi::tbb::make_filter<ParsedPipelineBatch, ParsedPipelineBatch>(
+                    oneapi::tbb::filter_mode::parallel, stagePlace
+                ) &
+                oneapi::tbb::make_filter<ParsedPipelineBatch, void>(oneapi::tbb::filter_mode::serial_in_order, stageC)
+        );
+        if (inputExhausted || stopToken.stop_requested() || !tuner.ReplanPending())
+        {
+            break;
+        }
+        tuner.Replan();
+    }
+    file.AdviseRandomAccess();
 
     // EOF seals the final held record; all of its offsets are present.
     if (held.has_value())
@@ -583,6 +840,23 @@ void RunStaticParserPipeline(
         held.reset();
     }
 
+    if (file.IsGrowing())
+    {
+        // Stage A only quits a growing file on stop; release the decoder.
+        file.StopGrowing();
+    }
+    else if (!stopToken.stop_requested())
+    {
+        // A decode that failed past the first bytes still yields every
+        // complete row before the failure; say why the file ends there.
+        if (std::string growthError = file.GrowthError(); !growthError.empty())
+        {
+            coalescer.Pending().errors.push_back(
+                fmt::format("Decompression stopped early: {}", std::move(growthError))
+            );
+        }
+    }
+
     coalescer.Finish(nextLineNumber, stopToken.stop_requested());
 }
 
@@ -4,6 +4,7 @@
 #include "loglib/internal/batch_coalescer.hpp"
 #include "loglib/internal/compact_log_value.hpp"
 #include "loglib/internal/line_decoder.hpp"
+#include "loglib/internal/line_framer.hpp"
 #include "loglib/internal/parse_runtime.hpp"
 #include "loglib/internal/timestamp_promotion.hpp"
 #include "loglib/key_index.hpp"
@@ -147,7 +148,8 @@ inline ContinuationSpliceOutcome ExtendContinuationTarget(
 /// Single-threaded: the target is thousands of lines/s, so TBB
 /// overhead is not warranted. `source` is mutated on the parser
 /// thread and read concurrently by the GUI; `StreamLineSource`'s
-/// internal mutex + deque storage make that safe.
+/// chunk arena and epoch-guarded reads make that safe. Producers that
+/// support `BorrowBytes` are parsed in place, without the `Read` copy.
 ///
 /// A `Continue` result extends the pending record's raw text and the
 /// field selected by `decoder.LastContinuationTarget()`. Pending
@@ -197,9 +199,10 @@ void RunStreamingParseLoop(
     // consumed from the producer during format detection. Zero cost
     // on the default path where `initialCarry` is empty.
     std::string carry = options.initialCarry;
-    std::vector<char> readBuffer(STREAMING_READ_BUFFER_SIZE);
+    const bool borrowsBytes = producer->SupportsBorrowedBytes();
+    std::vector<char> readBuffer(borrowsBytes ? 0 : STREAMING_READ_BUFFER_SIZE);
 
-    // Reused per line; move-transferred into the source on success.
+    // Reused per line; move-transferred into the pending record.
     std::vector<std::pair<KeyId, CompactLogValue>> compactValues;
     std::string ownedArena;
     std::string lineError;
@@ -229,6 +232,10 @@ void RunStreamingParseLoop(
         size_t droppedContinuationLines = 0;
     };
     std::optional<PendingRecord> pending;
+    // `AppendLine` copies into the source's chunk arena, so a committed
+    // record's buffers are recycled for the next one instead of freed.
+    std::string spareRawText;
+    std::string spareOwnedArena;
 
     // Reject invalid targets before buffering to keep memory bounded.
     auto canAcceptContinuation = [](std::span<const std::pair<KeyId, CompactLogValue>> values, KeyId key) -> bool {
@@ -337,7 +344,11 @@ void RunStreamingParseLoop(
             return a.first < b.first;
         });
 
-        const size_t lineId = source.AppendLine(std::move(rec.rawText), std::move(rec.ownedArena));
+        const size_t lineId = source.AppendLine(rec.rawText, rec.ownedArena);
+        rec.rawText.clear();
+        rec.ownedArena.clear();
+        spareRawText = std::move(rec.rawText);
+        spareOwnedArena = std::move(rec.ownedArena);
         LogLine logLine(std::move(rec.compactValues), keys, source, lineId);
         // Promote only after all continuations have joined the record.
         promoteScratch.PromoteTimestamps(logLine, timeColumnsSpan, std::string_view{});
@@ -427,6 +438,7 @@ void RunStreamingParseLoop(
         commitPending();
 
         PendingRecord fresh;
+        fresh.rawText = std::move(spareRawText);
         fresh.rawText.assign(trimmed.data(), trimmed.size());
         fresh.ownedArena = std::move(ownedArena);
         fresh.compactValues = std::move(compactValues);
@@ -444,17 +456,19 @@ void RunStreamingParseLoop(
 
         // Reset moved-from buffers explicitly for clang-analyzer.
         compactValues.clear();
+        ownedArena = std::move(spareOwnedArena);
         ownedArena.clear();
     };
 
     // Emit complete lines already present in `initialCarry` before
     // waiting for more producer bytes.
     auto scanCarry = [&]() {
+        NewlineScanner newlines(carry, carry.data() + carry.size());
         size_t scanStart = 0;
         while (scanStart < carry.size())
         {
-            const size_t newlineRel = carry.find('\n', scanStart);
-            if (newlineRel == std::string::npos)
+            const size_t newlineRel = newlines.Find(scanStart);
+            if (newlineRel == std::string_view::npos)
             {
                 break;
             }
@@ -473,6 +487,36 @@ void RunStreamingParseLoop(
         }
     };
 
+    // Parse complete lines straight out of a borrowed producer span;
+    // only a line split across spans goes through `carry`.
+    auto scanBorrowed = [&](std::string_view bytes) {
+        NewlineScanner newlines(bytes, bytes.data() + bytes.size());
+        size_t scanStart = 0;
+        if (!carry.empty())
+        {
+            const size_t newline = newlines.Find(0);
+            if (newline == std::string_view::npos)
+            {
+                carry.append(bytes);
+                return;
+            }
+            carry.append(bytes.substr(0, newline + 1));
+            scanCarry();
+            scanStart = newline + 1;
+        }
+        while (scanStart < bytes.size() && !stopToken.stop_requested())
+        {
+            const size_t newline = newlines.Find(scanStart);
+            if (newline == std::string_view::npos)
+            {
+                break;
+            }
+            processLine(bytes.substr(scanStart, newline - scanStart));
+            scanStart = newline + 1;
+        }
+        carry.append(bytes.substr(scanStart));
+    };
+
     if (!carry.empty() && !stopToken.stop_requested())
     {
         scanCarry();
@@ -487,12 +531,26 @@ void RunStreamingParseLoop(
             break;
         }
 
-        const size_t read = producer->Read(std::span<char>(readBuffer.data(), readBuffer.size()));
-        if (read != 0)
+        size_t read = 0;
+        if (borrowsBytes)
         {
-            carry.append(readBuffer.data(), read);
+            const std::span<const char> borrowed = producer->BorrowBytes(STREAMING_READ_BUFFER_SIZE);
+            read = borrowed.size();
+            if (read != 0)
+            {
+                scanBorrowed(std::string_view(borrowed.data(), borrowed.size()));
+                producer->ReleaseBorrowedBytes();
+            }
         }
         else
+        {
+            read = producer->Read(std::span<char>(readBuffer.data(), readBuffer.size()));
+            if (read != 0)
+            {
+                carry.append(readBuffer.data(), read);
+            }
+        }
+        if (read == 0)
         {
             if (producer->IsClosed())
             {
@@ -515,7 +573,10 @@ void RunStreamingParseLoop(
             }
         }
 
-        scanCarry();
+        if (!borrowsBytes)
+        {
+            scanCarry();
+        }
 
         coalescer.TryFlush(false);
     }
@@ -0,0 +1,221 @@
+#pragma once
+
+#include "loglib/internal/enum_posting_index.hpp"
+#include "loglib/trigram_query.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace loglib::internal
+{
+
+/// Symbol every code point without its own trigram symbol folds to:
+/// non-ASCII text, control bytes and invalid UTF-8. It breaks trigrams
+/// rather than joining one, since decoders disagree on how many code
+/// points a malformed run is; no indexed or queried trigram holds it.
+inline constexpr char TRIGRAM_OTHER_SYMBOL = '\x7f';
+
+/// Folded alphabet: `' '`..`'@'`, `'['`..`'~'` (upper case folds onto
+/// lower case) and `TRIGRAM_OTHER_SYMBOL`.
+inline constexpr uint32_t TRIGRAM_SYMBOL_COUNT = 70;
+
+/// Distinct `TrigramKey`s.
+inline constexpr uint32_t TRIGRAM_KEY_COUNT = TRIGRAM_SYMBOL_COUNT * TRIGRAM_SYMBOL_COUNT * TRIGRAM_SYMBOL_COUNT;
+
+/// Trigram symbol for @p codePoint. Whitespace `QString::simplified`
+/// collapses maps to `' '`; the non-ASCII code points that match an
+/// ASCII letter case-insensitively (KELVIN SIGN, LONG S, dotted and
+/// dotless I) map to that letter, so a folded needle stays a substring
+/// of the folded text under any case mode.
+[[nodiscard]] char FoldTrigramCodePoint(char32_t codePoint) noexcept;
+
+/// Append @p bytes (UTF-8) to @p out as trigram symbols, one per code
+/// point. @p compact also collapses whitespace runs and trims the ends,
+/// matching the displayed `simplified()` text a cell is matched on.
+void FoldTrigramText(std::string_view bytes, bool compact, std::string &out);
+
+/// Dense key of three folded symbols.
+[[nodiscard]] uint32_t TrigramKey(char first, char second, char third) noexcept;
+
+/// Distinct trigram keys across the cells of one index granule. Owns a
+/// key-space bitmap (~42 KiB), so keep one per worker and reuse it.
+class TrigramKeySet
+{
+public:
+    TrigramKeySet();
+
+    /// Fold @p bytes as a compact cell and add its trigrams.
+    void AddCell(std::string_view bytes);
+
+    /// Keys added since the last take, in `TrigramIndex` shard order;
+    /// leaves the set empty for the next granule.
+    [[nodiscard]] std::vector<uint32_t> TakeKeys();
+
+private:
+    std::vector<uint64_t> mSeen;
+    std::vector<uint32_t> mKeys;
+    std::string mFolded;
+};
+
+/// Result of `TrigramIndex::Candidates`: the granules whose rows may
+/// match. Rows past the index (appended after the query ran) count as
+/// candidates.
+class TrigramCandidates
+{
+public:
+    [[nodiscard]] bool Contains(size_t row) const noexcept;
+
+    /// One past the last row sharing @p row's granule.
+    [[nodiscard]] size_t GranuleEndRow(size_t row) const noexcept;
+
+    /// Granules covering the indexed rows.
+    [[nodiscard]] size_t GranuleCount() const noexcept
+    {
+        return mGranules;
+    }
+
+    /// Granules that may hold a match.
+    [[nodiscard]] size_t CandidateGranuleCount() const noexcept;
+
+private:
+    friend class TrigramIndex;
+
+    uint64_t mFirstId = 0;
+    uint64_t mFirstGranule = 0;
+    size_t mRows = 0;
+    size_t mGranules = 0;
+    std::vector<uint64_t> mBits;
+};
+
+/// Identity of the rows an index was built over; a persisted index is
+/// only reused for a table with the same signature.
+// NOLINTBEGIN(misc-non-private-member-variables-in-classes)
+struct TrigramIndexSignature
+{
+    uint64_t rows = 0;
+    /// String fields across all rows and their total byte length.
+    uint64_t stringCells = 0;
+    uint64_t stringBytes = 0;
+
+    friend bool operator==(const TrigramIndexSignature &, const TrigramIndexSignature &) = default;
+};
+// NOLINTEND(misc-non-private-member-variables-in-classes)
+
+/// Full-text trigram index over a table's string cells. Rows are
+/// grouped into `GRANULE_ROWS`-row granules aligned to sequence ids
+/// (`row + mFirstId`, like `ZoneMap`), and each trigram keeps a
+/// `RowIdSet` of the granules containing it. A query intersects /
+/// unions those sets into candidate granules; the caller re-checks the
+/// rows inside them with the real matcher, so granule false positives
+/// cost time, never correctness.
+///
+/// Posting lists are split into `SHARD_COUNT` shards by key, so a batch
+/// of granules is appended with one task per shard.
+class TrigramIndex
+{
+public:
+    static constexpr size_t GRANULE_ROWS = 256;
+    static constexpr size_t SHARD_COUNT = 64;
+
+    [[nodiscard]] static size_t ShardOf(uint32_t key) noexcept
+    {
+        return key % SHARD_COUNT;
+    }
+
+    /// Rows covered.
+    [[nodiscard]] size_t Size() const noexcept
+    {
+        return mSize;
+    }
+
+    [[nodiscard]] bool Empty() const noexcept
+    {
+        return mSize == 0;
+    }
+
+    /// Rows the open granule takes before the next one starts.
+    [[nodiscard]] size_t OpenGranuleRoom() const noexcept
+    {
+        return GRANULE_ROWS - static_cast<size_t>((mFirstId + mSize) % GRANULE_ROWS);
+    }
+
+    /// Cover @p rows more rows. `granules[0]` holds the keys of the
+    /// rows that fill the open granule (up to `OpenGranuleRoom()`),
+    /// each later entry those of the next `GRANULE_ROWS` rows; keys in
+    /// `TrigramKeySet::TakeKeys` order.
+    void AppendGranules(std::span<const std::vector<uint32_t>> granules, size_t rows);
+
+    /// Drop the first @p count rows. @p count past `Size()` clears.
+    void EraseFront(size_t count);
+
+    void Clear() noexcept;
+
+    /// Candidate granules for @p query, or nullopt when the query does
+    /// not narrow anything (`All`).
+    [[nodiscard]] std::optional<TrigramCandidates> Candidates(const TrigramQuery &query) const;
+
+    /// Distinct trigrams held.
+    [[nodiscard]] size_t TrigramCount() const noexcept;
+
+    /// Heap bytes owned (capacity, not size).
+    [[nodiscard]] size_t MemoryBytes() const noexcept;
+
+    void Write(SidecarWriter &writer) const;
+
+    /// Replace the contents with an index `Write` produced. Returns
+    /// false, leaving the index empty, on a short or malformed stream.
+    [[nodiscard]] bool Read(SidecarReader &reader);
+
+private:
+    // NOLINTBEGIN(misc-non-private-member-variables-in-classes)
+    // Private nested aggregate: public members are intentional.
+    struct Posting
+    {
+        uint32_t key = 0;
+        RowIdSet granules;
+        /// Last granule appended, to fold repeat hits in the open one.
+        uint64_t lastGranule = UINT64_MAX;
+    };
+    // NOLINTEND(misc-non-private-member-variables-in-classes)
+
+    [[nodiscard]] const Posting *Find(uint32_t key) const noexcept;
+    void Evaluate(const TrigramQuery &query, TrigramCandidates &out) const;
+    void OrPostings(uint32_t key, TrigramCandidates &out) const;
+
+    /// Key -> 1 + slot in its shard, 0 when absent. Sized on first use.
+    std::vector<uint32_t> mSlots;
+    std::array<std::vector<Posting>, SHARD_COUNT> mShards;
+    /// Sequence id of row 0.
+    uint64_t mFirstId = 0;
+    size_t mSize = 0;
+};
+
+/// Sidecars kept per cache directory; `SaveTrigramIndex` drops the
+/// least recently written beyond this.
+inline constexpr size_t MAX_TRIGRAM_INDEX_FILES = 32;
+
+/// Load the index persisted for @p source, or nullopt when there is
+/// none, it is malformed, or it was built from different bytes or rows
+/// (file size, modification time or @p signature differ).
+[[nodiscard]] std::optional<TrigramIndex> LoadTrigramIndex(
+    const std::filesystem::path &indexDir, const std::filesystem::path &source, const TrigramIndexSignature &signature
+) noexcept;
+
+/// Persist @p index for @p source into @p indexDir, keyed by the
+/// file's identity like `SaveGzipSeekIndex`. Best-effort: a failed save
+/// only costs the next open a rebuild. Returns whether it was written.
+bool SaveTrigramIndex(
+    const std::filesystem::path &indexDir,
+    const std::filesystem::path &source,
+    const TrigramIndexSignature &signature,
+    const TrigramIndex &index
+) noexcept;
+
+} // namespace loglib::internal
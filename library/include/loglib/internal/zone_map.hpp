@@ -0,0 +1,200 @@
+#pragma once
+
+#include "loglib/internal/compact_log_value.hpp"
+#include "loglib/key_index.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace loglib::internal
+{
+
+/// Min / max summary of one block of a column, in the two domains the
+/// range predicates compare in: epoch microseconds (the slots
+/// `LogTable::GetEpochMicroseconds` accepts) and `double` (the slots
+/// `NumericRangeRowPredicate` accepts). Counts let a filter tell "every
+/// row has a value in range" from "some rows do".
+// NOLINTBEGIN(misc-non-private-member-variables-in-classes)
+// Aggregate by design: `ZoneMap` and the filter read the fields directly.
+struct ZoneSummary
+{
+    /// Rows the block covers, with or without a value.
+    uint32_t rows = 0;
+    /// Rows with an epoch-microsecond reading.
+    uint32_t timeRows = 0;
+    /// Rows with a non-NaN numeric reading.
+    uint32_t numberRows = 0;
+    /// Some time reading came from a `Uint64` slot, which
+    /// `TimeRangeRowPredicate` clamps differently for negative bounds.
+    bool hasUnsignedTime = false;
+    int64_t minMicros = std::numeric_limits<int64_t>::max();
+    int64_t maxMicros = std::numeric_limits<int64_t>::min();
+    double minNumber = std::numeric_limits<double>::infinity();
+    double maxNumber = -std::numeric_limits<double>::infinity();
+
+    /// Fold one row's slot in.
+    void Add(const CompactLogValue &slot) noexcept;
+
+    /// Fold another summary in (rows and ranges add up).
+    void Merge(const ZoneSummary &other) noexcept;
+};
+// NOLINTEND(misc-non-private-member-variables-in-classes)
+
+/// Zone map for one column: a `ZoneSummary` per `BLOCK_ROWS` rows, so
+/// a range filter can skip blocks that cannot match and bulk-accept
+/// blocks that wholly do. Blocks are aligned to row sequence ids
+/// (`row + mFirstId`) like `EnumPostingIndex`, so `EraseFront` drops
+/// whole blocks and leaves the straddling front block's summary as-is.
+/// That summary then covers evicted rows too; it stays a valid bound
+/// for both decisions, just a looser one.
+class ZoneMap
+{
+public:
+    static constexpr size_t BLOCK_ROWS = 4096;
+
+    /// Rows covered.
+    [[nodiscard]] size_t Size() const noexcept
+    {
+        return mSize;
+    }
+
+    [[nodiscard]] bool Empty() const noexcept
+    {
+        return mSize == 0;
+    }
+
+    /// True when the next row opens a new block.
+    [[nodiscard]] bool AtBlockBoundary() const noexcept
+    {
+        return (mFirstId + mSize) % BLOCK_ROWS == 0;
+    }
+
+    /// Cover one more row.
+    void Append(const CompactLogValue &slot);
+
+    /// Cover `summary.rows` more rows summarised elsewhere (e.g. in
+    /// parallel). Requires `AtBlockBoundary()` and at most `BLOCK_ROWS`
+    /// rows.
+    void AppendBlock(const ZoneSummary &summary);
+
+    /// Drop the first @p count rows. @p count past `Size()` clears.
+    void EraseFront(size_t count);
+
+    void Clear() noexcept;
+
+    [[nodiscard]] size_t BlockCount() const noexcept
+    {
+        return mBlocks.size();
+    }
+
+    [[nodiscard]] const ZoneSummary &Block(size_t block) const noexcept
+    {
+        return mBlocks[block];
+    }
+
+    /// Block holding @p row (`row < Size()`).
+    [[nodiscard]] size_t BlockOf(size_t row) const noexcept
+    {
+        return static_cast<size_t>(((mFirstId + row) / BLOCK_ROWS) - (mFirstId / BLOCK_ROWS));
+    }
+
+    /// First live row of @p block.
+    [[nodiscard]] size_t BlockFirstRow(size_t block) const noexcept;
+
+    /// One past the last live row of @p block.
+    [[nodiscard]] size_t BlockEndRow(size_t block) const noexcept;
+
+    /// Every block folded together.
+    [[nodiscard]] ZoneSummary Total() const noexcept;
+
+    /// Heap bytes owned (capacity, not size).
+    [[nodiscard]] size_t MemoryBytes() const noexcept
+    {
+        return mBlocks.capacity() * sizeof(ZoneSummary);
+    }
+
+private:
+    std::vector<ZoneSummary> mBlocks;
+    /// Sequence id of row 0.
+    uint64_t mFirstId = 0;
+    size_t mSize = 0;
+};
+
+/// Per-table set of `ZoneMap`s, one slot per column (empty for columns
+/// that are not summarised). Each slot remembers the alias `KeyId`s it
+/// was built against, like `EnumIndexStore`.
+class ZoneMapStore
+{
+public:
+    [[nodiscard]] bool Enabled() const noexcept
+    {
+        return mEnabled;
+    }
+
+    /// Turning the store off frees every map.
+    void SetEnabled(bool enabled) noexcept;
+
+    [[nodiscard]] size_t ColumnCount() const noexcept
+    {
+        return mColumns.size();
+    }
+
+    /// Grow or shrink to @p columnCount; new columns start empty.
+    void Resize(size_t columnCount);
+
+    [[nodiscard]] ZoneMap &Map(size_t index) noexcept
+    {
+        return mColumns[index].map;
+    }
+
+    [[nodiscard]] const ZoneMap &Map(size_t index) const noexcept
+    {
+        return mColumns[index].map;
+    }
+
+    [[nodiscard]] const std::vector<KeyId> &ColumnKeys(size_t index) const noexcept
+    {
+        return mColumns[index].keyIds;
+    }
+
+    [[nodiscard]] bool Tracked(size_t index) const noexcept
+    {
+        return mColumns[index].tracked;
+    }
+
+    /// Record what column @p index is built against and whether it is
+    /// summarised at all; clears its rows when either differs.
+    void Bind(size_t index, const std::vector<KeyId> &keyIds, bool tracked);
+
+    /// Drop column @p index's rows; the owner's next sync rebuilds it.
+    void Invalidate(size_t index) noexcept;
+
+    /// Mirror of `LogConfigurationManager::MoveColumn`.
+    void MoveColumn(size_t srcIndex, size_t destIndex);
+
+    /// Drop the first @p count rows from every map.
+    void EraseFrontRows(size_t count);
+
+    void Clear() noexcept;
+
+    /// Heap bytes owned across all columns.
+    [[nodiscard]] size_t MemoryBytes() const noexcept;
+
+private:
+    // NOLINTBEGIN(misc-non-private-member-variables-in-classes)
+    // Private nested aggregate: public members are intentional.
+    struct Entry
+    {
+        ZoneMap map;
+        std::vector<KeyId> keyIds;
+        bool tracked = false;
+    };
+    // NOLINTEND(misc-non-private-member-variables-in-classes)
+
+    std::vector<Entry> mColumns;
+    bool mEnabled = false;
+};
+
+} // namespace loglib::internal
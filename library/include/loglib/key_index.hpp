@@ -15,6 +15,11 @@
 namespace loglib
 {
 
+namespace internal
+{
+class RowShapeRegistry;
+}
+
 /// Dense integer id for a log field key. Ids are assigned monotonically from
 /// 0 and never reused, so they double as indices into per-key arrays.
 using KeyId = uint32_t;
@@ -56,11 +61,15 @@ public:
     /// Cold-path snapshot under the internal lock.
     [[nodiscard]] std::vector<std::string> SortedKeys() const;
 
-    /// Approximate heap bytes owned by the index (shard maps + reverse
-    /// table). Used by the memory-footprint benchmark; not part of the
-    /// parse hot path.
+    /// Approximate heap bytes owned by the index (shard maps, reverse
+    /// table, row shapes). Used by the memory-footprint benchmark; not
+    /// part of the parse hot path.
     [[nodiscard]] size_t EstimatedMemoryBytes() const;
 
+    /// Row-shape intern table for this id space. Thread-safe; lives in
+    /// the heap-allocated impl, so shape handles survive `KeyIndex` moves.
+    [[nodiscard]] internal::RowShapeRegistry &Shapes() const noexcept;
+
 #ifdef LOGLIB_KEY_INDEX_INSTRUMENTATION
     /// Test-only call counters compiled in by the unit-test target.
     static std::atomic<std::size_t> sGetOrInsertCallCount;
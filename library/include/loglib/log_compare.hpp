@@ -96,15 +96,18 @@ private:
 /// Pass @p rankForEnumColumn when @p columnIndex is an `Enumeration`
 /// column; the lib then pre-materialises a `uint16_t` rank per row in
 /// parallel and the comparator collapses to a branch-free integer
-/// compare. Without a rank the comparator dispatches through
-/// `CompareRows`, paying the per-call slot resolution cost --
-/// noticeably slower on enum columns but correct for the non-enum
-/// types (`Time`, `Integer`, `Floating`, string).
+/// compare. `Level`, `Time`, `Integer`, `Floating` / `Number` and
+/// `Boolean` columns get the same treatment from a typed key read off
+/// `LogTable::GetCompactValue` (the dense column when columnar storage
+/// is enabled). Everything else -- strings, and enum columns without a
+/// rank -- dispatches through `CompareRows`, paying the per-call slot
+/// resolution cost.
 ///
 /// Threading: pre-materialisation runs under `tbb::parallel_for`, the
 /// sort under `tbb::parallel_sort`. Both are read-only against
-/// @p table; `LogTable::GetEnumValueId` and `CompareRows` must be
-/// safe to call concurrently (today's implementations are).
+/// @p table; `LogTable::GetEnumValueId`, `LogTable::GetCompactValue`
+/// and `CompareRows` must be safe to call concurrently (today's
+/// implementations are).
 [[nodiscard]] std::vector<size_t> SortPermutationByColumn(
     const LogTable &table,
     std::span<const size_t> logRows,
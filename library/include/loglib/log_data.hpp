@@ -4,6 +4,7 @@
 #include "key_index.hpp"
 #include "line_source.hpp"
 #include "log_line.hpp"
+#include "log_line_store.hpp"
 #include "log_parse_sink.hpp"
 #include "stream_line_source.hpp"
 
@@ -31,6 +32,7 @@ public:
     /// Constructs a `LogData` from a single source and rebinds each
     /// line's `KeyIndex` back-pointer to @p keys.
     LogData(std::unique_ptr<LineSource> source, std::vector<LogLine> lines, KeyIndex keys);
+    LogData(std::unique_ptr<LineSource> source, LogLineStore lines, KeyIndex keys);
 
     LogData(const LogData &) = delete;
     LogData &operator=(const LogData &) = delete;
@@ -67,8 +69,10 @@ public:
     [[nodiscard]] StreamLineSource *BackStreamSource() noexcept;
     [[nodiscard]] const StreamLineSource *BackStreamSource() const noexcept;
 
-    const std::vector<LogLine> &Lines() const;
-    std::vector<LogLine> &Lines();
+    /// Row store. Chunked, so `LogTable::EvictPrefixRows` can drop a
+    /// retention-capped prefix without moving survivors.
+    const LogLineStore &Lines() const;
+    LogLineStore &Lines();
 
     const KeyIndex &Keys() const;
     KeyIndex &Keys();
@@ -97,7 +101,7 @@ public:
 
 private:
     std::vector<std::unique_ptr<LineSource>> mSources;
-    std::vector<LogLine> mLines;
+    LogLineStore mLines;
     KeyIndex mKeys;
     bool mTimestampsAlreadyParsed = false;
 };
@@ -1,5 +1,9 @@
 #pragma once
 
+#include "loglib/internal/line_field_slab.hpp"
+#include "loglib/internal/owned_string_arena.hpp"
+#include "loglib/stop_token.hpp"
+
 #include <mio/mmap.hpp>
 
 #include <cstddef>
@@ -14,6 +18,11 @@
 namespace loglib
 {
 
+namespace internal
+{
+class GrowingByteBuffer;
+} // namespace internal
+
 /// Memory-mapped log file. Owns the mmap so `LogValue` instances can
 /// hold `string_view`s into the content; move keeps the pointer stable.
 /// Per-record addressing is `FileLineSource`'s job; `LogFile` only
@@ -21,10 +30,37 @@ namespace loglib
 class LogFile
 {
 public:
+    /// How the mapping is set up and hinted. Defaults suit any file size.
+    struct MapOptions
+    {
+        /// Access-pattern hints: sequential read-ahead while the static
+        /// pipeline runs, with `AdviseWillNeed` windows issued ahead of
+        /// Stage A, then random access once the parse is done. Off
+        /// leaves the kernel's defaults.
+        bool accessHints = true;
+        /// Fault the whole file in before the constructor returns, like
+        /// `MAP_POPULATE` (Linux `MADV_POPULATE_READ`, a will-need hint
+        /// elsewhere). Moves the I/O to open time; for files that fit in
+        /// RAM.
+        bool populate = false;
+        /// Ask for transparent huge pages (`MADV_HUGEPAGE`) to cut TLB
+        /// misses. Linux only; file-backed pages are collapsed only on
+        /// kernels built with `CONFIG_READ_ONLY_THP_FOR_FS`.
+        bool hugePages = false;
+    };
+
     /// Throws `std::runtime_error` if the file cannot be opened or mapped.
     explicit LogFile(const std::filesystem::path &filePath);
     /// Map @p storagePath while reporting @p logicalPath as the source.
     LogFile(std::filesystem::path storagePath, std::filesystem::path logicalPath);
+    /// Explicit-@p options overload. Kept separate because some clang
+    /// versions diagnose an aggregate default parameter for a member of
+    /// an incomplete class.
+    LogFile(std::filesystem::path storagePath, std::filesystem::path logicalPath, MapOptions options);
+    /// View the output of a progressive decode while it is still being
+    /// written. `Data()` is stable; `Size()` grows until `IsGrowing()`
+    /// turns false.
+    LogFile(std::shared_ptr<internal::GrowingByteBuffer> growingBytes, std::filesystem::path logicalPath);
 
     /// Member order unmaps before releasing `mLifetimeAnchor`.
     ~LogFile() = default;
@@ -41,6 +77,31 @@ public:
     const char *Data() const;
     size_t Size() const;
 
+    /// True while a progressive decode may still append bytes.
+    [[nodiscard]] bool IsGrowing() const noexcept;
+
+    /// Block until `Size()` exceeds @p knownSize, growth ends, or
+    /// @p stopToken fires; returns the new `Size()`. Returns at once
+    /// for a file that is not growing.
+    size_t WaitForGrowth(size_t knownSize, const StopToken &stopToken) const;
+
+    /// Ask the decoder feeding a growing file to stop. The bytes
+    /// already published stay readable.
+    void StopGrowing() noexcept;
+
+    /// Why growth ended early (a decode error past the first bytes).
+    /// Empty on success and for files that never grew.
+    [[nodiscard]] std::string GrowthError() const;
+
+    /// Read-ahead hints for the mapping. Best-effort; no-ops when
+    /// `MapOptions::accessHints` is off and for growing files, whose
+    /// bytes are already in memory.
+    /// `AdviseWillNeed` starts reading [@p offset, @p offset + @p length)
+    /// in the background.
+    void AdviseWillNeed(size_t offset, size_t length) const noexcept;
+    void AdviseSequentialAccess() const noexcept;
+    void AdviseRandomAccess() const noexcept;
+
     /// Trailing `'\r'` is trimmed. Throws `std::out_of_range` when out of range.
     std::string GetLine(size_t lineNumber) const;
     size_t GetLineCount() const;
@@ -71,19 +132,44 @@ public:
         return !mMultiLineSpans.empty();
     }
 
-    /// Sliding view over the owned-string arena (escape-decoded values
-    /// that cannot live in the mmap). `LogLine` materialisation indexes
-    /// into this via `(offset, length)` stored in its compact values.
-    std::string_view OwnedStringsView() const noexcept;
+    /// @p length bytes of the owned-string arena (escape-decoded values
+    /// that cannot live in the mmap) at @p offset, as stored in a
+    /// compact `OwnedString` value. Empty when out of range.
+    std::string_view OwnedBytes(uint64_t offset, size_t length) const noexcept;
 
     /// Append @p bytes to the owned-string arena and return the byte
     /// offset of the first appended byte. Single-threaded contract: the
     /// streaming pipeline serialises arena writes through Stage C.
     uint64_t AppendOwnedStrings(std::string_view bytes);
 
-    /// Heap bytes owned by `mOwnedStrings` (capacity).
+    /// Claim @p length arena offsets for bytes adopted later; safe to
+    /// call while Stage C writes. See `internal::OwnedStringArena`.
+    uint64_t ReserveOwnedStrings(size_t length) noexcept;
+
+    /// Move @p bytes into the range `ReserveOwnedStrings` returned
+    /// @p offset for, without copying. @p span extends the range past
+    /// the bytes for later `TryExtendOwnedStrings` calls. Single-threaded
+    /// contract, like `AppendOwnedStrings`.
+    void AdoptOwnedStrings(uint64_t offset, std::string bytes, size_t span = 0);
+
+    /// Append @p bytes in place to the owned string ending at @p end;
+    /// false when that needs a copy to a fresh range instead.
+    /// Single-threaded contract, like `AppendOwnedStrings`.
+    bool TryExtendOwnedStrings(uint64_t end, std::string_view bytes);
+
+    /// Heap bytes owned by the owned-string arena (capacity).
     size_t OwnedStringsMemoryBytes() const noexcept;
 
+    /// Take ownership of a batch's `CompactLineFields` slab. Rows parsed
+    /// from this file may point into it, so it lives as long as the file.
+    /// Single-threaded contract, like `AppendOwnedStrings`.
+    void AdoptFieldSlab(std::unique_ptr<internal::LineFieldSlab> slab);
+
+    /// Bytes reserved by adopted field slabs, and the part of them no
+    /// row was carved from (block tails).
+    size_t FieldSlabMemoryBytes() const noexcept;
+    size_t FieldSlabSlackBytes() const noexcept;
+
     /// Keep @p anchor alive until after the mmap is released.
     /// Multiple anchors are composed in LIFO order.
     void AttachLifetimeAnchor(std::shared_ptr<void> anchor) noexcept;
@@ -96,16 +182,23 @@ private:
     std::shared_ptr<void> mLifetimeAnchor;
 
     mio::mmap_source mMmap;
+    bool mAccessHints = true;
+    /// Set instead of `mMmap` for a progressive decode.
+    std::shared_ptr<internal::GrowingByteBuffer> mGrowingBytes;
 
     /// Byte offsets of every line boundary plus a one-past-the-last sentinel.
     std::vector<uint64_t> mLineOffsets;
 
-    /// Concatenated escape-decoded strings referenced by this file's
-    /// `LogLine` values via `(offset, length)`.
-    std::string mOwnedStrings;
+    /// Escape-decoded strings referenced by this file's `LogLine` values
+    /// via `(offset, length)`. Boxed so `LogFile` stays movable.
+    std::unique_ptr<internal::OwnedStringArena> mOwnedStrings = std::make_unique<internal::OwnedStringArena>();
 
     /// Maps each multi-line header to its final physical line.
     std::unordered_map<size_t, size_t> mMultiLineSpans;
+
+    /// Per-batch field-array slabs (see `internal::LineFieldSlab`);
+    /// released together, so closing a session costs O(batches).
+    std::vector<std::unique_ptr<internal::LineFieldSlab>> mFieldSlabs;
 };
 
 } // namespace loglib
@@ -3,6 +3,7 @@
 #include "loglib/enum_dictionary.hpp"
 #include "loglib/filter_expression.hpp"
 #include "loglib/internal/transparent_string_hash.hpp"
+#include "loglib/trigram_query.hpp"
 
 #include <cstddef>
 #include <cstdint>
@@ -13,6 +14,7 @@
 #include <string>
 #include <string_view>
 #include <unordered_set>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -60,8 +62,23 @@ public:
         return mFastPathArmed;
     }
 
+    /// Dictionary the ids were resolved against; nullptr when none
+    /// was given.
+    [[nodiscard]] const EnumDictionary *Dictionary() const noexcept
+    {
+        return mDictionary;
+    }
+
+    /// Selected ids when they alone decide the predicate -- every
+    /// selected value resolved (or the selection is empty), so a row
+    /// matches iff its `GetEnumValueId` is in the list. Lets a posting
+    /// index built against `Dictionary()` answer the predicate exactly.
+    /// Nullopt when the string-set fallback is part of the semantics.
+    [[nodiscard]] std::optional<std::vector<EnumValueId>> IndexableIds() const;
+
 private:
     size_t mColumnIndex = 0;
+    const EnumDictionary *mDictionary = nullptr;
     /// Indexed by `EnumValueId`. Empty when no dictionary was given.
     std::vector<bool> mSelectedIds;
     /// Selected values that didn't resolve at construction (or all
@@ -96,6 +113,17 @@ public:
         return mColumnIndex;
     }
 
+    /// Inclusive bounds in epoch microseconds.
+    [[nodiscard]] int64_t Begin() const noexcept
+    {
+        return mBegin;
+    }
+
+    [[nodiscard]] int64_t End() const noexcept
+    {
+        return mEnd;
+    }
+
 private:
     size_t mColumnIndex = 0;
     int64_t mBegin = 0;
@@ -129,6 +157,17 @@ public:
         return mColumnIndex;
     }
 
+    /// Inclusive bounds after NaN collapsing; `nullopt` = unbounded.
+    [[nodiscard]] std::optional<double> MinValue() const noexcept
+    {
+        return mMin;
+    }
+
+    [[nodiscard]] std::optional<double> MaxValue() const noexcept
+    {
+        return mMax;
+    }
+
 private:
     size_t mColumnIndex = 0;
     std::optional<double> mMin;
@@ -177,6 +216,11 @@ private:
 /// Keeps Qt-flavoured regex/wildcard semantics in the GUI without
 /// pulling Qt into the lib. The caller owns callback thread-safety;
 /// the GUI builder pre-JITs its `QRegularExpression`.
+///
+/// An optional `TrigramQuery` lets `FilterAcceptedRows` use the
+/// table's trigram index. It must hold for the compacted text of
+/// every string cell the callback accepts; `All` (the default) opts
+/// out.
 class CallbackStringRowPredicate
 {
 public:
@@ -198,9 +242,21 @@ public:
         return mColumnIndex;
     }
 
+    void SetTrigrams(TrigramQuery query) noexcept
+    {
+        mTrigrams = std::move(query);
+    }
+
+    /// Trigrams every accepted string cell contains; see the class doc.
+    [[nodiscard]] const TrigramQuery &Trigrams() const noexcept
+    {
+        return mTrigrams;
+    }
+
 private:
     size_t mColumnIndex = 0;
     MatchFn mMatch;
+    TrigramQuery mTrigrams;
 };
 
 /// Closed union of concrete row predicates. Stored by value; the
@@ -317,8 +373,27 @@ struct CompiledFilterExpression
 /// Evaluate @p expression across every row of @p table in parallel
 /// and return the accepted rows in ascending order.
 ///
-/// Picks one of two paths per rebuild:
+/// Picks one of five paths per rebuild:
 ///
+/// - **Index path**: when the whole tree, or a direct leaf of a
+///   top-level `And`, is an `EnumRowPredicate` whose column has a
+///   live `LogTable::EnumIndex` and every selected value resolved,
+///   its posting lists give the accept-set (or the candidate rows
+///   the rest of the `And` is evaluated on) without a scan. With
+///   several such leaves the one with the fewest postings wins.
+/// - **Zone path**: when the whole tree, or some direct leaves of a
+///   top-level `And`, are `TimeRangeRowPredicate` /
+///   `NumericRangeRowPredicate`s on columns with a live
+///   `LogTable::ColumnZoneMap`, rows are walked block by block:
+///   blocks a leaf rules out are skipped, blocks the leaves wholly
+///   accept are taken in bulk when they are the whole conjunction,
+///   and the rest are evaluated row by row.
+/// - **Trigram path**: when the whole tree, or a direct leaf of a
+///   top-level `And`, is a `CallbackStringRowPredicate` with a
+///   `TrigramQuery` and the table's trigram index is live, only rows
+///   in candidate granules, plus rows whose cell is a formatted
+///   non-string value, are evaluated. With several such leaves the
+///   one with the fewest candidate granules wins.
 /// - **Visit path** (default): `tbb::parallel_for` over rows, each
 ///   row calling `EvaluateExpression`. Same envelope as the old
 ///   flat `span<RowPredicate>` for flat `And` trees.
@@ -328,9 +403,20 @@ struct CompiledFilterExpression
 ///   qualifies (short-circuiting beats materialising). Each unique
 ///   leaf's accept-set becomes a packed bitset (shared across
 ///   repeats); the tree walks with word-parallel AND/OR/NOT.
+///   Indexed enum leaves fill their bitset from the posting lists;
+///   zoned range leaves skip or bulk-fill whole blocks; trigram
+///   string leaves only test rows the index cannot rule out.
 ///
 /// Threading: per-worker thread-local buckets/bitsets; the caller
 /// coalesces and sorts. Every predicate is read-only-safe.
 [[nodiscard]] std::vector<size_t> FilterAcceptedRows(const LogTable &table, const CompiledFilterExpression &expression);
 
+/// `FilterAcceptedRows` over the rows `[firstRow, endRow)` only, with
+/// the same path choice sized to the range. @p endRow is clamped to
+/// `table.RowCount()`. Returns table rows, ascending. Streaming
+/// appends use this to evaluate just the new batch.
+[[nodiscard]] std::vector<size_t> FilterAcceptedRows(
+    const LogTable &table, const CompiledFilterExpression &expression, size_t firstRow, size_t endRow
+);
+
 } // namespace loglib
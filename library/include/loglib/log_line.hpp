@@ -17,9 +17,17 @@ namespace loglib
 
 class LineSource;
 
-/// One log record: a `(KeyId, CompactLogValue)` vector sorted by KeyId.
+namespace internal
+{
+class RowShape;
+}
+
+/// One log record: `(KeyId, CompactLogValue)` fields sorted by KeyId.
 /// Strings are stored as `(offset, length)` resolved via the owning
 /// `LineSource`. `(LineSource*, lineId)` is the row's session identity.
+/// Rows with the same key set share an interned `internal::RowShape`
+/// that holds the KeyIds and maps each to a slot, so such rows store
+/// only their values; rows the registry declines keep per-field KeyIds.
 class LogLine
 {
 public:
@@ -70,8 +78,9 @@ public:
     /// (KeyId, LogValue) pairs in ascending KeyId order. Cold path.
     std::vector<std::pair<KeyId, LogValue>> IndexedValues() const;
 
-    /// Span over the compact storage; for hot-path walkers.
-    std::span<const std::pair<KeyId, internal::CompactLogValue>> CompactValues() const noexcept;
+    /// `(KeyId, CompactLogValue)` view over the compact storage, in
+    /// ascending KeyId order; for hot-path walkers.
+    internal::CompactFieldsView CompactValues() const noexcept;
 
     LogMap Values() const;
 
@@ -108,7 +117,8 @@ public:
     /// `EnumValueId` payload for a `DictRef` slot, else nullopt.
     [[nodiscard]] std::optional<EnumValueId> GetEnumValueId(KeyId id) const noexcept;
 
-    /// Linear scan over the sorted compact storage; nullptr if absent.
+    /// One indexed load through the row's interned `RowShape`; rows
+    /// without a shape fall back to a linear scan. nullptr if absent.
     [[nodiscard]] const internal::CompactLogValue *FindCompact(KeyId id) const noexcept;
 
     /// Mutable counterpart; callers may overwrite `*slot` in place.
@@ -125,7 +135,15 @@ private:
     /// Replace/insert the slot for @p id with @p compact; may allocate.
     void SetCompact(KeyId id, internal::CompactLogValue compact);
 
+    /// Intern @p sortedValues' key set and store the values in the
+    /// shaped layout, or keyed when the registry declines it.
+    void AssignFields(std::span<const std::pair<KeyId, internal::CompactLogValue>> sortedValues);
+
+    /// Shaped layout iff `mShape` is set.
     internal::CompactLineFields mValues;
+    /// Interned key set of `mValues` (from `mKeys->Shapes()`), or
+    /// nullptr when the registry declined it.
+    const internal::RowShape *mShape = nullptr;
     const KeyIndex *mKeys = nullptr;
     LineSource *mSource = nullptr;
     size_t mLineId = 0;
@@ -0,0 +1,297 @@
+#pragma once
+
+#include "log_line.hpp"
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace loglib
+{
+
+/// Row store behind `LogData::Lines()`: a segmented array of
+/// `CHUNK_ROWS`-row chunks plus a logical base offset into the first
+/// chunk.
+///
+/// Appends fill the last chunk (which grows geometrically up to
+/// `CHUNK_ROWS`, so small tables stay small) and then open a new one.
+/// `EraseFront` drops whole chunks and advances the base, so prefix
+/// eviction under a retention cap never moves a surviving row. Rows in
+/// a partially evicted head chunk stay allocated until the whole chunk
+/// drops.
+///
+/// Exposes the subset of the `std::vector` surface existing callers use
+/// (`size`, `operator[]`, `front` / `back`, random-access iteration,
+/// `push_back`) so row-indexed code is unchanged. Storage is not
+/// contiguous across chunks; code that wants spans goes through
+/// `ForEachSegment`.
+class LogLineStore
+{
+    template <bool IsConst> class BasicIterator;
+
+public:
+    static constexpr size_t CHUNK_SHIFT = 12;
+    static constexpr size_t CHUNK_ROWS = size_t{1} << CHUNK_SHIFT;
+
+    using value_type = LogLine;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = LogLine &;
+    using const_reference = const LogLine &;
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+
+    LogLineStore() = default;
+
+    /// Moves @p lines into chunked storage.
+    explicit LogLineStore(std::vector<LogLine> lines);
+
+    LogLineStore(const LogLineStore &) = delete;
+    LogLineStore &operator=(const LogLineStore &) = delete;
+
+    /// Chunks move by handle: row addresses survive a store move.
+    LogLineStore(LogLineStore &&) noexcept = default;
+    LogLineStore &operator=(LogLineStore &&) noexcept = default;
+
+    ~LogLineStore() = default;
+
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return mSize;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return mSize == 0;
+    }
+
+    [[nodiscard]] LogLine &operator[](size_t row) noexcept
+    {
+        const size_t slot = mHead + row;
+        return mChunks[slot >> CHUNK_SHIFT][slot & (CHUNK_ROWS - 1)];
+    }
+
+    [[nodiscard]] const LogLine &operator[](size_t row) const noexcept
+    {
+        const size_t slot = mHead + row;
+        return mChunks[slot >> CHUNK_SHIFT][slot & (CHUNK_ROWS - 1)];
+    }
+
+    [[nodiscard]] LogLine &front() noexcept
+    {
+        return (*this)[0];
+    }
+
+    [[nodiscard]] const LogLine &front() const noexcept
+    {
+        return (*this)[0];
+    }
+
+    [[nodiscard]] LogLine &back() noexcept
+    {
+        return mChunks.back().back();
+    }
+
+    [[nodiscard]] const LogLine &back() const noexcept
+    {
+        return mChunks.back().back();
+    }
+
+    [[nodiscard]] iterator begin() noexcept;
+    [[nodiscard]] iterator end() noexcept;
+    [[nodiscard]] const_iterator begin() const noexcept;
+    [[nodiscard]] const_iterator end() const noexcept;
+
+    void push_back(LogLine &&line);
+
+    /// Pre-sizes the chunk table for @p rows live rows. Chunks
+    /// themselves are still allocated on demand.
+    void reserve(size_t rows);
+
+    void clear() noexcept;
+
+    /// Drop the first @p count rows; @p count past `size()` clears.
+    /// Frees every chunk that falls wholly inside the evicted prefix and
+    /// moves no surviving row. O(evicted chunks + chunk-table length).
+    void EraseFront(size_t count);
+
+    /// Invoke @p fn with each contiguous `std::span<LogLine>` covering
+    /// rows `[first, last)`, in row order.
+    template <class Fn> void ForEachSegment(size_t first, size_t last, Fn &&fn)
+    {
+        ForEachSegmentImpl(*this, first, last, fn);
+    }
+
+    template <class Fn> void ForEachSegment(size_t first, size_t last, Fn &&fn) const
+    {
+        ForEachSegmentImpl(*this, first, last, fn);
+    }
+
+    /// Heap bytes owned by the row slots (excludes per-row field storage).
+    [[nodiscard]] size_t MemoryBytes() const noexcept;
+
+private:
+    template <class Self, class Fn> static void ForEachSegmentImpl(Self &self, size_t first, size_t last, Fn &fn)
+    {
+        last = last < self.mSize ? last : self.mSize;
+        size_t slot = self.mHead + first;
+        const size_t endSlot = self.mHead + last;
+        while (slot < endSlot)
+        {
+            auto &chunk = self.mChunks[slot >> CHUNK_SHIFT];
+            const size_t offset = slot & (CHUNK_ROWS - 1);
+            const size_t chunkEnd = (slot - offset) + chunk.size();
+            const size_t runEnd = chunkEnd < endSlot ? chunkEnd : endSlot;
+            fn(std::span(chunk.data() + offset, runEnd - slot));
+            slot = runEnd;
+        }
+    }
+
+    /// Every chunk but the last holds exactly `CHUNK_ROWS` rows.
+    std::vector<std::vector<LogLine>> mChunks;
+    /// Slot of row 0 inside `mChunks.front()`; always `< CHUNK_ROWS`.
+    size_t mHead = 0;
+    size_t mSize = 0;
+};
+
+/// Random-access iterator over a `LogLineStore`; a `(store, row)` pair.
+template <bool IsConst> class LogLineStore::BasicIterator
+{
+    using Store = std::conditional_t<IsConst, const LogLineStore, LogLineStore>;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept = std::random_access_iterator_tag;
+    using value_type = LogLine;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<IsConst, const LogLine *, LogLine *>;
+    using reference = std::conditional_t<IsConst, const LogLine &, LogLine &>;
+
+    BasicIterator() = default;
+
+    BasicIterator(Store *store, size_t row) noexcept
+        : mStore(store), mRow(row)
+    {
+    }
+
+    /// Mutable -> const conversion.
+    template <bool OtherConst>
+        requires(IsConst && !OtherConst)
+    BasicIterator(const BasicIterator<OtherConst> &other) noexcept // NOLINT(google-explicit-constructor)
+        : mStore(other.mStore), mRow(other.mRow)
+    {
+    }
+
+    reference operator*() const noexcept
+    {
+        return (*mStore)[mRow];
+    }
+
+    pointer operator->() const noexcept
+    {
+        return &(*mStore)[mRow];
+    }
+
+    reference operator[](difference_type n) const noexcept
+    {
+        return (*mStore)[static_cast<size_t>(static_cast<difference_type>(mRow) + n)];
+    }
+
+    BasicIterator &operator++() noexcept
+    {
+        ++mRow;
+        return *this;
+    }
+
+    BasicIterator operator++(int) noexcept
+    {
+        BasicIterator copy = *this;
+        ++mRow;
+        return copy;
+    }
+
+    BasicIterator &operator--() noexcept
+    {
+        --mRow;
+        return *this;
+    }
+
+    BasicIterator operator--(int) noexcept
+    {
+        BasicIterator copy = *this;
+        --mRow;
+        return copy;
+    }
+
+    BasicIterator &operator+=(difference_type n) noexcept
+    {
+        mRow = static_cast<size_t>(static_cast<difference_type>(mRow) + n);
+        return *this;
+    }
+
+    BasicIterator &operator-=(difference_type n) noexcept
+    {
+        return *this += -n;
+    }
+
+    friend BasicIterator operator+(BasicIterator it, difference_type n) noexcept
+    {
+        return it += n;
+    }
+
+    friend BasicIterator operator+(difference_type n, BasicIterator it) noexcept
+    {
+        return it += n;
+    }
+
+    friend BasicIterator operator-(BasicIterator it, difference_type n) noexcept
+    {
+        return it -= n;
+    }
+
+    friend difference_type operator-(const BasicIterator &lhs, const BasicIterator &rhs) noexcept
+    {
+        return static_cast<difference_type>(lhs.mRow) - static_cast<difference_type>(rhs.mRow);
+    }
+
+    friend bool operator==(const BasicIterator &lhs, const BasicIterator &rhs) noexcept
+    {
+        return lhs.mRow == rhs.mRow;
+    }
+
+    friend std::strong_ordering operator<=>(const BasicIterator &lhs, const BasicIterator &rhs) noexcept
+    {
+        return lhs.mRow <=> rhs.mRow;
+    }
+
+private:
+    template <bool> friend class BasicIterator;
+
+    Store *mStore = nullptr;
+    size_t mRow = 0;
+};
+
+inline LogLineStore::iterator LogLineStore::begin() noexcept
+{
+    return {this, 0};
+}
+
+inline LogLineStore::iterator LogLineStore::end() noexcept
+{
+    return {this, mSize};
+}
+
+inline LogLineStore::const_iterator LogLineStore::begin() const noexcept
+{
+    return {this, 0};
+}
+
+inline LogLineStore::const_iterator LogLineStore::end() const noexcept
+{
+    return {this, mSize};
+}
+
+} // namespace loglib
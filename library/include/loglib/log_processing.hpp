@@ -4,6 +4,7 @@
 #include "log_configuration.hpp"
 #include "log_data.hpp"
 #include "log_line.hpp"
+#include "log_line_store.hpp"
 
 #include <date/tz.h>
 
@@ -113,6 +114,15 @@ void BackfillTimestampColumn(
     const LogConfiguration::Column &column, std::span<LogLine> lines, BackfillErrors discardErrors
 );
 
+/// `LogLineStore` overloads: back-fill rows `[first, lines.size())` one
+/// contiguous chunk segment at a time.
+std::vector<std::string> BackfillTimestampColumn(
+    const LogConfiguration::Column &column, LogLineStore &lines, size_t first = 0
+);
+void BackfillTimestampColumn(
+    const LogConfiguration::Column &column, LogLineStore &lines, size_t first, BackfillErrors discardErrors
+);
+
 int64_t TimeStampToLocalMillisecondsSinceEpoch(TimeStamp timeStamp);
 
 int64_t UtcMicrosecondsToLocalMilliseconds(int64_t microseconds);
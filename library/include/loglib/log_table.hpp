@@ -1,7 +1,12 @@
 #pragma once
 
 #include "enum_dictionary.hpp"
+#include "internal/column_store.hpp"
+#include "internal/compact_log_value.hpp"
+#include "internal/enum_posting_index.hpp"
 #include "internal/transparent_string_hash.hpp"
+#include "internal/trigram_index.hpp"
+#include "internal/zone_map.hpp"
 #include "key_index.hpp"
 #include "line_source.hpp"
 #include "log_configuration.hpp"
@@ -11,6 +16,7 @@
 #include "log_parse_sink.hpp"
 
 #include <cstdint>
+#include <filesystem>
 #include <memory>
 #include <optional>
 #include <span>
@@ -23,8 +29,10 @@
 namespace loglib
 {
 
-/// Row-range backed by `std::vector<LogLine>` for static and live-tail
-/// sessions. Each row's `LineSource *` resolves its values.
+/// Row-range backed by a `LogLineStore` (chunked `LogLine`s behind a
+/// base offset, so retention drops a prefix without moving survivors)
+/// for static and live-tail sessions. Each row's `LineSource *`
+/// resolves its values.
 class LogTable
 {
 public:
@@ -138,10 +146,127 @@ public:
     [[nodiscard]] size_t RowCount() const;
 
     [[nodiscard]] const LogData &Data() const noexcept;
+    /// Mutating rows through this reference bypasses the columnar
+    /// mirror, the enum indexes, the zone maps and the trigram index;
+    /// call `SetColumnarStorage(true)` / `SetEnumIndexes(true)` /
+    /// `SetZoneMaps(true)` / `SetTrigramIndex(true)` again afterwards
+    /// to rebuild them.
     [[nodiscard]] LogData &Data() noexcept;
 
+    /// Opt-in column-major mirror of every column's resolved slot
+    /// (see `internal::DenseColumn`). When enabled, typed reads
+    /// (`GetCompactValue`, `GetEpochMicroseconds`, `GetEnumValueId`,
+    /// non-string `GetValue`) and the filter / sort / histogram paths
+    /// built on them read contiguous per-column arrays instead of
+    /// walking each row's `LogLine`. `LogLine` stays the source of
+    /// truth; the mirror is rebuilt per column whenever slots are
+    /// rewritten (enum promote / demote, time back-fill, type change)
+    /// and extended on every append. Costs ~13 B per row per column.
+    /// Enabling builds the mirror over the current rows; disabling
+    /// frees it.
+    void SetColumnarStorage(bool enabled);
+
+    [[nodiscard]] bool ColumnarStorageEnabled() const noexcept;
+
+    /// Dense column for @p column, or nullptr when columnar storage
+    /// is off or @p column is out of range.
+    [[nodiscard]] const internal::DenseColumn *ColumnarView(size_t column) const noexcept;
+
+    /// Heap bytes held by the columnar mirror (0 when disabled).
+    [[nodiscard]] size_t ColumnarMemoryBytes() const noexcept;
+
+    /// Opt-in per-column secondary index for enum / level columns: a
+    /// posting list of rows per `EnumValueId` (see
+    /// `internal::EnumPostingIndex`). `FilterAcceptedRows` answers a
+    /// fully-resolved `EnumRowPredicate` from it instead of scanning.
+    /// Maintained like the columnar mirror: extended on every append,
+    /// trimmed by `EvictPrefixRows`, rebuilt per column on promote /
+    /// demote / type change. Enabling builds the indexes over the
+    /// current rows; disabling frees them.
+    void SetEnumIndexes(bool enabled);
+
+    [[nodiscard]] bool EnumIndexesEnabled() const noexcept;
+
+    /// Posting index for @p column, or nullptr when indexing is off,
+    /// the column is not a promoted enum, or the index is mid-rebuild.
+    [[nodiscard]] const internal::EnumPostingIndex *EnumIndex(size_t column) const noexcept;
+
+    /// Heap bytes held by the enum indexes (0 when disabled).
+    [[nodiscard]] size_t EnumIndexMemoryBytes() const noexcept;
+
+    /// Opt-in per-column zone maps for time and numeric columns: a
+    /// min / max summary per `internal::ZoneMap::BLOCK_ROWS` rows (see
+    /// `internal::ZoneMap`). `FilterAcceptedRows` uses them to skip
+    /// blocks a `TimeRangeRowPredicate` / `NumericRangeRowPredicate`
+    /// cannot match and to accept blocks it wholly matches without a
+    /// per-row scan. Maintained like the enum indexes; ~40 B per block.
+    void SetZoneMaps(bool enabled);
+
+    [[nodiscard]] bool ZoneMapsEnabled() const noexcept;
+
+    /// Zone map for @p column, or nullptr when zone maps are off, the
+    /// column is not `Type::Time` / numeric, or the map is mid-rebuild.
+    [[nodiscard]] const internal::ZoneMap *ColumnZoneMap(size_t column) const noexcept;
+
+    /// `[min, max]` of `GetEpochMicroseconds` over @p column, read off
+    /// the zone map in O(blocks). nullopt when there is no live map or
+    /// no row has a time reading. After `EvictPrefixRows` the range may
+    /// still include values from evicted rows of the front block.
+    [[nodiscard]] std::optional<std::pair<int64_t, int64_t>> EpochMicrosecondsRange(size_t column) const noexcept;
+
+    /// Heap bytes held by the zone maps (0 when disabled).
+    [[nodiscard]] size_t ZoneMapMemoryBytes() const noexcept;
+
+    /// Opt-in full-text trigram index over every string field of every
+    /// row (see `internal::TrigramIndex`). `FilterAcceptedRows` narrows
+    /// a `CallbackStringRowPredicate` carrying a `TrigramQuery` to the
+    /// candidate granules instead of running the matcher on every row.
+    /// Extended on every append and trimmed by `EvictPrefixRows`. Slot
+    /// rewrites (enum promote / demote, time back-fill) keep a string's
+    /// text or turn it into a non-string value, so they never make the
+    /// index miss a row. Enabling builds it over the current rows;
+    /// disabling frees it. Costs roughly 10-20% of the string bytes.
+    void SetTrigramIndex(bool enabled);
+
+    [[nodiscard]] bool TrigramIndexEnabled() const noexcept;
+
+    /// Granules that may hold a string cell matching @p query, or
+    /// nullopt when the index is off, behind the rows, or @p query is
+    /// `All`. Rows outside the candidates can only match through a
+    /// non-string cell (its formatted text).
+    [[nodiscard]] std::optional<internal::TrigramCandidates> TrigramCandidatesFor(const TrigramQuery &query) const;
+
+    /// Heap bytes held by the trigram index (0 when disabled).
+    [[nodiscard]] size_t TrigramIndexMemoryBytes() const noexcept;
+
+    /// Row count and string-field totals of the current rows; a
+    /// persisted index is only reused for an identical signature.
+    [[nodiscard]] internal::TrigramIndexSignature TrigramSignature() const;
+
+    /// Persist the trigram index for the file @p source under
+    /// @p indexDir. False when the index is off or behind the rows, or
+    /// the write failed.
+    bool SaveTrigramIndex(const std::filesystem::path &indexDir, const std::filesystem::path &source) const;
+
+    /// Enable the trigram index from the copy persisted for @p source
+    /// when it was built over these exact rows. Returns false, leaving
+    /// the index untouched, when there is no usable copy.
+    bool LoadTrigramIndex(const std::filesystem::path &indexDir, const std::filesystem::path &source);
+
+    /// Compact slot at (@p row, @p column) under `GetValue`'s alias
+    /// rule (first alias that materialises to a non-monostate value),
+    /// or a monostate slot. Read from the columnar mirror when enabled.
+    /// String / `DictRef` payloads still need the row's `LineSource`
+    /// to resolve; use `GetValue` for those.
+    [[nodiscard]] internal::CompactLogValue GetCompactValue(size_t row, size_t column) const noexcept;
+
+    /// `AsEpochMicroseconds(GetValue(row, column))` without
+    /// materialising a `LogValue`.
+    [[nodiscard]] std::optional<int64_t> GetEpochMicroseconds(size_t row, size_t column) const noexcept;
+
     /// Drop the first @p count rows; callers wrap with
-    /// `beginRemoveRows`/`endRemoveRows`.
+    /// `beginRemoveRows`/`endRemoveRows`. Frees whole row chunks without
+    /// moving survivors (see `LogLineStore::EraseFront`).
     void EvictPrefixRows(size_t count);
 
     /// Mutable `KeyIndex` for worker-thread `GetOrInsert`.
@@ -355,6 +480,43 @@ private:
     /// Point every owned `LineSource` at `mEnumDictionaries`.
     void RewireSourceRegistries();
 
+    /// First alias slot on @p line for @p column that `GetValue`
+    /// would materialise to a non-monostate value; monostate slot
+    /// when none does.
+    [[nodiscard]] internal::CompactLogValue ResolveColumnSlot(const LogLine &line, size_t column) const noexcept;
+
+    /// Resize the columnar mirror to the column count and drop every
+    /// column whose alias `KeyId`s no longer match `mColumnKeyIds`.
+    /// Runs after each key refresh so no reader sees a stale column.
+    void SyncColumnarKeys();
+
+    /// Bring the columnar mirror up to `RowCount()`: rebuild columns
+    /// whose alias keys changed or that were invalidated, then append
+    /// rows added since the last sync. No-op when disabled.
+    void SyncColumnarStorage();
+
+    /// Bring the enum indexes up to `RowCount()`: clear columns that
+    /// are not promoted enums, rebuild those whose keys or dictionary
+    /// changed or that were invalidated, then index appended rows.
+    /// No-op when disabled.
+    void SyncEnumIndexes();
+
+    /// Bring the zone maps up to `RowCount()`: clear columns that are
+    /// not time / numeric, rebuild those whose keys changed or that
+    /// were invalidated, then summarise appended rows. No-op when
+    /// disabled.
+    void SyncZoneMaps();
+
+    /// Bring the trigram index up to `RowCount()`: clear it when rows
+    /// vanished without `EvictPrefixRows`, then index appended rows a
+    /// window of granules at a time. No-op when disabled.
+    void SyncTrigramIndex();
+
+    /// Drop the mirror, enum index and zone map for @p columnIndex and for every
+    /// column sharing one of its alias keys. Called before a
+    /// whole-column slot rewrite.
+    void InvalidateColumnarColumn(size_t columnIndex) noexcept;
+
     /// Enum pass over `[oldLineCount, Lines().size())`: encode active
     /// columns, demote overflowing ones, auto-promote quiescent
     /// candidates. Extends @p firstBackfilled / @p lastBackfilled.
@@ -458,6 +620,16 @@ private:
     /// promoted to `Type::Level`. See `MaybePromoteToLevel` and
     /// `TakePendingLevelBubbleKeys`.
     std::vector<KeyId> mPendingLevelBubbleKeys;
+
+    /// Opt-in column-major mirror; see `SetColumnarStorage`.
+    internal::ColumnStore mColumnStore;
+    /// Opt-in enum posting lists; see `SetEnumIndexes`.
+    internal::EnumIndexStore mEnumIndexes;
+    /// Opt-in block min / max summaries; see `SetZoneMaps`.
+    internal::ZoneMapStore mZoneMaps;
+    /// Opt-in full-text index; see `SetTrigramIndex`.
+    internal::TrigramIndex mTrigramIndex;
+    bool mTrigramIndexEnabled = false;
 };
 
 } // namespace loglib
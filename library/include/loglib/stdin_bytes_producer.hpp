@@ -30,11 +30,12 @@ struct StdinBytesProducerTestAccess;
 ///     stdin is left untouched.
 ///   - One worker thread per producer, drains `readChunkBytes` per
 ///     syscall (default 64 KiB, matching `TailingBytesProducer`).
-///   - `Read()` drains a byte queue backed by
-///     `internal::LineBytesQueue`, shared with the network stream
+///   - `Read()` / `BorrowBytes()` drain a lock-free SPSC byte ring
+///     (`internal::LineBytesQueue`), shared with the network stream
 ///     producers.
-///   - `WaitForBytes` parks on a condition variable that the
-///     worker signals on every new chunk or on EOF.
+///   - `WaitForBytes` parks on the queue's condition variable, which
+///     the worker signals on a new chunk (only while the parser is
+///     parked) or on EOF.
 ///   - `Stop()` closes the dup, joins the worker, marks the
 ///     producer terminally closed. Idempotent and safe from any
 ///     thread (GUI teardown, session switch, `NewSession`).
@@ -64,10 +65,10 @@ public:
         /// `DEFAULT_READ_CHUNK_BYTES` for the sizing rationale.
         std::size_t readChunkBytes = DEFAULT_READ_CHUNK_BYTES;
 
-        /// Soft cap on the internal byte queue. 0 disables the
-        /// cap. When the parser can't keep up, oldest bytes are
-        /// dropped to the next newline boundary (identical
-        /// semantics to `TcpServerProducer`).
+        /// Soft cap on the internal byte queue. 0 selects the
+        /// largest cap the ring supports. When the parser can't
+        /// keep up, oldest bytes are dropped to the next newline
+        /// boundary (identical semantics to `TcpServerProducer`).
         std::size_t queueCapBytes = DEFAULT_QUEUE_CAP_BYTES;
 
         /// Display name shown in the status bar / window title.
@@ -94,6 +95,10 @@ public:
 
     std::size_t Read(std::span<char> buffer) override;
 
+    [[nodiscard]] bool SupportsBorrowedBytes() const noexcept override;
+    [[nodiscard]] std::span<const char> BorrowBytes(std::size_t maxBytes) override;
+    void ReleaseBorrowedBytes() noexcept override;
+
     void WaitForBytes(std::chrono::milliseconds timeout) override;
 
     void Stop() noexcept override;
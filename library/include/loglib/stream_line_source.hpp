@@ -2,38 +2,53 @@
 
 #include "loglib/line_source.hpp"
 
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <filesystem>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace loglib
 {
 
 class BytesProducer;
 
-/// `LineSource` over a live byte producer. Owns the bytes backing each
-/// line in a pair of `std::deque<std::string>`s (raw text + per-line
-/// owned arena). No session-global arena: eviction simply drops the
-/// corresponding entries.
+/// `LineSource` over a live byte producer. Line bytes live in an
+/// append-only arena of `CHUNK_BYTES` chunks: each line's raw text is
+/// copied into the current chunk followed by its escape-decoded owned
+/// bytes, and a 16-byte index entry records where. Appending a line is
+/// a bump copy (no per-line allocation); `EvictBefore` releases whole
+/// chunks and whole index blocks once every line in them is gone.
 ///
 /// - `BytesAreStable()` is `false`; the parser must emit
 ///   `OwnedString` payloads (not `MmapSlice`).
 /// - `SupportsEviction()` is `true`; `EvictBefore` is the retention
 ///   hook used by `LogTable` / `LogModel`.
 /// - LineIds are 1-based monotonic, assigned by `AppendLine`.
-/// - Thread-safe: a mutex guards all members. The parser worker
-///   appends; the GUI reads and may evict. `std::deque` push_back is
-///   reference-stable, so concurrent reads on existing entries are
-///   safe. `string_view`s from `ResolveOwnedBytes` are invalidated by
-///   `EvictBefore` on that line id.
+/// - Thread-safe. Writers (`AppendLine`, `AppendOwnedBytes`,
+///   `EvictBefore`) serialise on a mutex; `RawLine` /
+///   `ResolveOwnedBytes` for bytes written by `AppendLine` take no lock.
+///   They read the index through atomically published pointers and
+///   announce themselves in a two-slot epoch counter, so memory that
+///   `EvictBefore` unlinks is freed only after every reader that could
+///   have seen it has left. `string_view`s from `ResolveOwnedBytes` are
+///   still invalidated by `EvictBefore` on that line id.
 class StreamLineSource final : public LineSource
 {
 public:
+    /// Arena chunk size. Lines longer than this get a dedicated chunk.
+    static constexpr size_t CHUNK_BYTES = size_t{1} << 20;
+
+    /// Index entries per index block.
+    static constexpr size_t INDEX_BLOCK_LINES = 4096;
+
     /// @param displayName  GUI-facing identity (typically a file path).
     /// @param producer     Byte producer for this stream. May be null
     ///                     in tests that drive `AppendLine` directly.
@@ -72,38 +87,115 @@ public:
     [[nodiscard]] BytesProducer *Producer() noexcept;
     [[nodiscard]] const BytesProducer *Producer() const noexcept;
 
-    /// Append @p rawLine and its escape-decoded byte arena. Returns
-    /// the assigned 1-based monotonic `lineId`. `ownedBytes` may be
-    /// empty if the line had no escape-decoded fields.
-    size_t AppendLine(std::string rawLine, std::string ownedBytes);
+    /// Copy @p rawLine and its escape-decoded byte arena into the chunk
+    /// arena. Returns the assigned 1-based monotonic `lineId`.
+    /// `ownedBytes` may be empty if the line had no escape-decoded
+    /// fields; its offsets stay relative to the line, as before.
+    size_t AppendLine(std::string_view rawLine, std::string_view ownedBytes);
 
     /// Number of lines currently held (post-eviction).
     [[nodiscard]] size_t Size() const noexcept;
 
-    /// Total bytes owned: line bytes + per-line owned arenas.
-    /// Capacity-accurate; benchmark-only, not on the parse hot path.
+    /// Total bytes owned: arena chunks (capacity, including slack),
+    /// index blocks, late-appended owned bytes, and memory awaiting
+    /// reclamation. Benchmark-only, not on the parse hot path.
     [[nodiscard]] size_t OwnedMemoryBytes() const noexcept;
 
 private:
-    [[nodiscard]] bool LineIsLiveLocked(size_t lineId) const noexcept;
-    [[nodiscard]] size_t IndexForLocked(size_t lineId) const noexcept;
+    /// Where one line's bytes sit: `rawLength` bytes of raw text at
+    /// `bytes`, immediately followed by `ownedLength` owned bytes.
+    struct LineEntry
+    {
+        const char *bytes = nullptr;
+        uint32_t rawLength = 0;
+        uint32_t ownedLength = 0;
+    };
+
+    static constexpr size_t INDEX_BLOCK_BYTES = INDEX_BLOCK_LINES * sizeof(LineEntry);
+
+    /// Reader-visible index: `blocks[i]` holds lines
+    /// `[baseLineId + i * INDEX_BLOCK_LINES, ...)`. Immutable once
+    /// published; growth and eviction publish a fresh copy.
+    struct IndexTable
+    {
+        size_t baseLineId = 1;
+        std::vector<const LineEntry *> blocks;
+    };
+
+    struct Chunk
+    {
+        std::unique_ptr<char[]> bytes;
+        size_t capacity = 0;
+        size_t used = 0;
+        /// Highest line id with bytes in this chunk.
+        size_t lastLineId = 0;
+    };
+
+    /// Memory unlinked at `epoch`; freed once no reader can still hold it.
+    struct Retired
+    {
+        uint64_t epoch = 0;
+        std::vector<std::unique_ptr<char[]>> chunks;
+        std::vector<std::unique_ptr<LineEntry[]>> blocks;
+        std::unique_ptr<IndexTable> table;
+        size_t bytes = 0;
+    };
+
+    /// Pins the current epoch for a lock-free read.
+    class ReadGuard
+    {
+    public:
+        explicit ReadGuard(const StreamLineSource &source) noexcept;
+        ~ReadGuard();
+
+        ReadGuard(const ReadGuard &) = delete;
+        ReadGuard &operator=(const ReadGuard &) = delete;
+        ReadGuard(ReadGuard &&) = delete;
+        ReadGuard &operator=(ReadGuard &&) = delete;
+
+    private:
+        std::atomic<uint32_t> *mSlot = nullptr;
+    };
+
+    /// Entry for @p lineId, or nullptr if it is not live. Call under a
+    /// `ReadGuard` or `mWriteLock`.
+    [[nodiscard]] const LineEntry *FindEntry(size_t lineId) const noexcept;
+
+    [[nodiscard]] LineEntry *EntryForLocked(size_t lineId) noexcept;
+    [[nodiscard]] char *ReserveBytesLocked(size_t bytes, size_t lineId);
+    void PublishTableLocked(std::unique_ptr<IndexTable> table);
+    void RetireLocked(Retired retired);
+    void ReclaimLocked();
 
     std::filesystem::path mDisplayName;
     std::unique_ptr<BytesProducer> mProducer;
 
-    /// Guards every member below.
-    mutable std::mutex mLock;
-
-    /// Raw line text (no trailing `\n` / `\r`). `std::deque` push_back
-    /// is reference-stable, so concurrent reads on existing entries
-    /// remain valid.
-    std::deque<std::string> mLines;
-
-    /// Per-line escape-decoded byte arena. Same indexing as `mLines`.
-    std::deque<std::string> mLineOwnedBytes;
-
-    size_t mFirstAvailableLineId = 1;
-    size_t mNextLineId = 1;
+    /// Serialises writers and guards the writer-side members below.
+    /// Readers never take it except for late-appended owned bytes.
+    mutable std::mutex mWriteLock;
+
+    std::deque<Chunk> mChunks;
+    std::deque<std::unique_ptr<LineEntry[]>> mIndexBlocks;
+    std::unique_ptr<IndexTable> mTable;
+    std::vector<Retired> mRetired;
+    size_t mRetiredBytes = 0;
+
+    /// Owned bytes added by `AppendOwnedBytes` after `AppendLine`. The
+    /// line's arena chunk is immutable by then, so they live here at
+    /// offsets continuing from the entry's `ownedLength`. Cold path.
+    std::map<size_t, std::string> mLateOwnedBytes;
+
+    /// Reader-visible state. `mNextLineId` is published (release) after
+    /// the entry and its bytes are written; `mPublishedTable` before it.
+    std::atomic<const IndexTable *> mPublishedTable{nullptr};
+    std::atomic<size_t> mFirstAvailableLineId{1};
+    std::atomic<size_t> mNextLineId{1};
+
+    /// Epoch-based reclamation: readers count themselves in
+    /// `mActiveReaders[epoch & 1]`; the writer only advances the epoch
+    /// once the slot it is about to reuse has drained.
+    mutable std::atomic<uint64_t> mEpoch{0};
+    mutable std::array<std::atomic<uint32_t>, 2> mActiveReaders{};
 };
 
 } // namespace loglib
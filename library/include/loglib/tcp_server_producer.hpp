@@ -94,7 +94,8 @@ public:
         /// Soft cap on the byte queue. When the parser falls behind
         /// and the queue exceeds this, the oldest queued bytes are
         /// dropped (rounded up to the next newline) and counted in
-        /// `DroppedByteCount`. `0` disables back-pressure.
+        /// `DroppedByteCount`. `0` selects the queue's largest cap
+        /// (`LineBytesQueue::UNCAPPED_SOFT_CAP_BYTES`).
         size_t maxQueueBytes = 16 * 1024 * 1024;
 
         /// `std::nullopt` for plaintext. Filled in to enable TLS.
@@ -119,6 +120,10 @@ public:
 
     size_t Read(std::span<char> buffer) override;
 
+    [[nodiscard]] bool SupportsBorrowedBytes() const noexcept override;
+    [[nodiscard]] std::span<const char> BorrowBytes(size_t maxBytes) override;
+    void ReleaseBorrowedBytes() noexcept override;
+
     void WaitForBytes(std::chrono::milliseconds timeout) override;
 
     /// Stop accepting connections, close every active session, drain
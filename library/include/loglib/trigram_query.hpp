@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace loglib
+{
+
+/// Boolean query over trigrams that every text matching a string
+/// pattern must contain, evaluated against `internal::TrigramIndex` to
+/// narrow a scan to candidate rows before the real matcher runs.
+///
+/// Trigrams are spelled in folded symbols (`internal::FoldTrigramText`):
+/// ASCII lower-cased, whitespace collapsed to one space, and other code
+/// points splitting the text into separately indexed runs. The query is
+/// a necessary condition only, so it stays valid for case-insensitive
+/// matching; `All` means the pattern gives the index nothing to go on.
+// NOLINTBEGIN(misc-non-private-member-variables-in-classes)
+// Aggregate by design: the index walks the tree directly.
+struct TrigramQuery
+{
+    enum class Op : uint8_t
+    {
+        /// Every text may match.
+        All,
+        /// No text can match.
+        None,
+        /// Every trigram and every sub-query is required.
+        And,
+        /// Any one trigram or sub-query suffices.
+        Or
+    };
+
+    Op op = Op::All;
+    /// `internal::TrigramKey`s, ascending and distinct.
+    std::vector<uint32_t> trigrams;
+    std::vector<TrigramQuery> subs;
+
+    /// Query for texts containing @p needle (UTF-8) as a substring;
+    /// also a valid bound for prefix / suffix / exact matches.
+    [[nodiscard]] static TrigramQuery ForLiteral(std::string_view needle);
+
+    /// Query for texts a PCRE-syntax @p pattern (UTF-8) finds a match
+    /// in, built Code Search style from the exact / prefix / suffix
+    /// strings of each sub-expression. Constructs the analysis does not
+    /// model (backreferences, `(?x)`, recursion, ...) weaken the
+    /// result, down to `All` for patterns it cannot parse.
+    [[nodiscard]] static TrigramQuery ForRegex(std::string_view pattern);
+
+    /// Both @p lhs and @p rhs hold.
+    [[nodiscard]] static TrigramQuery And(TrigramQuery lhs, TrigramQuery rhs);
+
+    /// @p lhs or @p rhs holds.
+    [[nodiscard]] static TrigramQuery Or(TrigramQuery lhs, TrigramQuery rhs);
+
+    [[nodiscard]] bool IsAll() const noexcept
+    {
+        return op == Op::All;
+    }
+
+    friend bool operator==(const TrigramQuery &, const TrigramQuery &) = default;
+};
+// NOLINTEND(misc-non-private-member-variables-in-classes)
+
+} // namespace loglib
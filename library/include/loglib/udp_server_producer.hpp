@@ -61,8 +61,8 @@ public:
 
         /// Soft cap on the byte queue. When the parser falls behind
         /// and the queue exceeds this, the oldest queued bytes are
-        /// dropped (counted in `DroppedByteCount`). `0` disables
-        /// back-pressure (the queue may grow unbounded).
+        /// dropped (counted in `DroppedByteCount`). `0` selects the
+        /// queue's largest cap (`LineBytesQueue::UNCAPPED_SOFT_CAP_BYTES`).
         size_t maxQueueBytes = 16 * 1024 * 1024;
     };
 
@@ -80,6 +80,10 @@ public:
 
     size_t Read(std::span<char> buffer) override;
 
+    [[nodiscard]] bool SupportsBorrowedBytes() const noexcept override;
+    [[nodiscard]] std::span<const char> BorrowBytes(size_t maxBytes) override;
+    void ReleaseBorrowedBytes() noexcept override;
+
     void WaitForBytes(std::chrono::milliseconds timeout) override;
 
     /// Stop accepting datagrams, unblock any in-flight `Read` /
@@ -106,8 +110,7 @@ public:
     [[nodiscard]] size_t DatagramCount() const noexcept;
 
     /// Cumulative bytes dropped from the queue under back-pressure.
-    /// `0` when `Options::maxQueueBytes == 0` or when the parser kept
-    /// up the whole session.
+    /// `0` when the parser kept up the whole session.
     [[nodiscard]] size_t DroppedByteCount() const noexcept;
 
 private:
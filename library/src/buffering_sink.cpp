@@ -24,14 +24,12 @@ void BufferingSink::OnStarted()
 
 void BufferingSink::OnBatch(StreamedBatch batch)
 {
-    // Avoid `reserve(size + n)`: some STL impls take it as exact and
-    // make this O(N^2/B). `insert` grows geometrically.
-    if (!batch.lines.empty())
+    for (LogLine &line : batch.lines)
     {
-        mLines.insert(
-            mLines.end(), std::make_move_iterator(batch.lines.begin()), std::make_move_iterator(batch.lines.end())
-        );
+        mLines.push_back(std::move(line));
     }
+    // Avoid `reserve(size + n)`: some STL impls take it as exact and
+    // make this O(N^2/B). `insert` grows geometrically.
     if (!batch.localLineOffsets.empty())
     {
         mLineOffsets.insert(
@@ -0,0 +1,522 @@
+#include "loglib/internal/builtin_regex_decoders.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace loglib::internal
+{
+
+namespace
+{
+
+/// PCRE2's `\s` under the default character tables: space and `\t`..`\r`.
+constexpr bool IsRegexSpace(char c) noexcept
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+constexpr bool IsNotRegexSpace(char c) noexcept
+{
+    return !IsRegexSpace(c);
+}
+
+constexpr bool IsDigit(char c) noexcept
+{
+    return c >= '0' && c <= '9';
+}
+
+/// Position in the line being matched, with one reader per regex atom.
+/// Every reader is greedy and never gives bytes back, mirroring the
+/// first path PCRE2 tries.
+class LineCursor
+{
+public:
+    explicit LineCursor(std::string_view line) noexcept
+        : mLine(line)
+    {
+    }
+
+    [[nodiscard]] size_t Pos() const noexcept
+    {
+        return mPos;
+    }
+
+    [[nodiscard]] bool AtEnd() const noexcept
+    {
+        return mPos == mLine.size();
+    }
+
+    void Seek(size_t pos) noexcept
+    {
+        mPos = pos;
+    }
+
+    /// Bytes consumed since @p begin.
+    [[nodiscard]] std::string_view From(size_t begin) const noexcept
+    {
+        return mLine.substr(begin, mPos - begin);
+    }
+
+    bool Char(char c) noexcept
+    {
+        if (mPos < mLine.size() && mLine[mPos] == c)
+        {
+            ++mPos;
+            return true;
+        }
+        return false;
+    }
+
+    bool Literal(std::string_view text) noexcept
+    {
+        if (mLine.substr(mPos).starts_with(text))
+        {
+            mPos += text.size();
+            return true;
+        }
+        return false;
+    }
+
+    /// One byte matching @p pred.
+    template <class Pred> bool Take(Pred pred) noexcept
+    {
+        if (mPos < mLine.size() && pred(mLine[mPos]))
+        {
+            ++mPos;
+            return true;
+        }
+        return false;
+    }
+
+    /// Longest run of bytes matching @p pred, possibly empty.
+    template <class Pred> std::string_view Run(Pred pred) noexcept
+    {
+        const size_t begin = mPos;
+        while (mPos < mLine.size() && pred(mLine[mPos]))
+        {
+            ++mPos;
+        }
+        return From(begin);
+    }
+
+    /// `\s+`.
+    bool Spaces() noexcept
+    {
+        return !Run(IsRegexSpace).empty();
+    }
+
+    /// `\d{count}`.
+    bool Digits(size_t count) noexcept
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (!Take(IsDigit))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// `(.*)$`. Refuses a tail holding `\r` or `\n`: whether `.` and `$`
+    /// stop there depends on the PCRE2 newline convention.
+    bool Rest(std::string_view &out) noexcept
+    {
+        out = mLine.substr(mPos);
+        if (std::memchr(out.data(), '\n', out.size()) != nullptr ||
+            std::memchr(out.data(), '\r', out.size()) != nullptr)
+        {
+            return false;
+        }
+        mPos = mLine.size();
+        return true;
+    }
+
+private:
+    std::string_view mLine;
+    size_t mPos = 0;
+};
+
+/// `\d{2}:\d{2}:\d{2}`.
+bool Clock(LineCursor &cur) noexcept
+{
+    return cur.Digits(2) && cur.Char(':') && cur.Digits(2) && cur.Char(':') && cur.Digits(2);
+}
+
+/// `\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}(?:\.\d+)?` followed by the zone
+/// `(?:Z|[+\-]\d{2}:?\d{2})`, optional unless @p zoneRequired. A `.` or
+/// sign whose group does not complete leaves a byte that nothing after
+/// the timestamp accepts, so it fails here instead of skipping the group.
+bool IsoTimestamp(LineCursor &cur, bool zoneRequired) noexcept
+{
+    if (!cur.Digits(4) || !cur.Char('-') || !cur.Digits(2) || !cur.Char('-') || !cur.Digits(2) || !cur.Char('T') ||
+        !Clock(cur))
+    {
+        return false;
+    }
+    if (cur.Char('.') && cur.Run(IsDigit).empty())
+    {
+        return false;
+    }
+    if (cur.Char('Z'))
+    {
+        return true;
+    }
+    if (cur.Char('+') || cur.Char('-'))
+    {
+        if (!cur.Digits(2))
+        {
+            return false;
+        }
+        cur.Char(':');
+        return cur.Digits(2);
+    }
+    return !zoneRequired;
+}
+
+bool DecodeSyslogRfc3164(std::string_view line, std::vector<std::string_view> &captures)
+{
+    LineCursor cur(line);
+    // The first byte picks the timestamp alternative: `[A-Z]` for
+    // `Mmm dd hh:mm:ss`, a digit for ISO-8601.
+    if (cur.Take([](char c) { return c >= 'A' && c <= 'Z'; }))
+    {
+        const auto isLower = [](char c) { return c >= 'a' && c <= 'z'; };
+        if (!cur.Take(isLower) || !cur.Take(isLower) || !cur.Spaces())
+        {
+            return false;
+        }
+        const std::string_view day = cur.Run(IsDigit);
+        if (day.empty() || day.size() > 2 || !cur.Spaces() || !Clock(cur))
+        {
+            return false;
+        }
+    }
+    else if (!IsoTimestamp(cur, /*zoneRequired*/ false))
+    {
+        return false;
+    }
+    const std::string_view timestamp = cur.From(0);
+    if (!cur.Spaces())
+    {
+        return false;
+    }
+
+    const std::string_view hostname = cur.Run(IsNotRegexSpace);
+    if (hostname.empty() || !cur.Spaces())
+    {
+        return false;
+    }
+    const std::string_view program =
+        cur.Run([](char c) { return !IsRegexSpace(c) && c != '[' && c != ':'; });
+    if (program.empty())
+    {
+        return false;
+    }
+    std::string_view pid;
+    if (cur.Char('['))
+    {
+        pid = cur.Run(IsDigit);
+        if (pid.empty() || !cur.Char(']'))
+        {
+            return false;
+        }
+    }
+    std::string_view message;
+    if (!cur.Char(':') || !cur.Spaces() || !cur.Rest(message))
+    {
+        return false;
+    }
+
+    captures.assign({timestamp, hostname, program, pid, message});
+    return true;
+}
+
+bool DecodeGlog(std::string_view line, std::vector<std::string_view> &captures)
+{
+    LineCursor cur(line);
+    if (!cur.Take([](char c) { return c == 'I' || c == 'W' || c == 'E' || c == 'F'; }))
+    {
+        return false;
+    }
+    const std::string_view severity = cur.From(0);
+
+    const size_t timestampBegin = cur.Pos();
+    if (!cur.Digits(4) || !cur.Spaces() || !Clock(cur) || !cur.Char('.') || !cur.Digits(6))
+    {
+        return false;
+    }
+    const std::string_view timestamp = cur.From(timestampBegin);
+    if (!cur.Spaces())
+    {
+        return false;
+    }
+
+    const std::string_view thread = cur.Run(IsDigit);
+    if (thread.empty() || !cur.Spaces())
+    {
+        return false;
+    }
+    const std::string_view file = cur.Run([](char c) { return c != ':'; });
+    if (file.empty() || !cur.Char(':'))
+    {
+        return false;
+    }
+    const std::string_view lineNumber = cur.Run(IsDigit);
+    std::string_view message;
+    if (lineNumber.empty() || !cur.Char(']') || !cur.Spaces() || !cur.Rest(message))
+    {
+        return false;
+    }
+
+    captures.assign({severity, timestamp, thread, file, lineNumber, message});
+    return true;
+}
+
+/// Fields shared by the Common and Combined Log Format templates, up to
+/// and including `bytes`.
+struct ClfPrefix
+{
+    std::string_view clientip;
+    std::string_view ident;
+    std::string_view auth;
+    std::string_view timestamp;
+    std::string_view verb;
+    std::string_view request;
+    std::string_view httpversion;
+    std::string_view response;
+    std::string_view bytes;
+};
+
+/// `... "(?:(?<verb>\S+)\s+(?<request>\S+)(?:\s+HTTP/(?<httpversion>\S+))?|-)"\s+(?<response>\d+)\s+(?<bytes>\d+|-)`.
+///
+/// The closing quote must be followed by `\s`, so inside the request it
+/// can only be the last byte of a `\S` run: PCRE2 backs `httpversion`
+/// (or `request`, when there is no `HTTP/` part) off by exactly that
+/// quote. A `"-"` request, which PCRE2 only reaches after the first
+/// alternative fails, is left to PCRE2.
+bool DecodeClfPrefix(LineCursor &cur, ClfPrefix &out)
+{
+    const auto field = [&cur](std::string_view &value) {
+        value = cur.Run(IsNotRegexSpace);
+        return !value.empty() && cur.Spaces();
+    };
+    if (!field(out.clientip) || !field(out.ident) || !field(out.auth) || !cur.Char('['))
+    {
+        return false;
+    }
+    out.timestamp = cur.Run([](char c) { return c != ']'; });
+    if (out.timestamp.empty() || !cur.Char(']') || !cur.Spaces() || !cur.Char('"') || !field(out.verb))
+    {
+        return false;
+    }
+
+    const std::string_view request = cur.Run(IsNotRegexSpace);
+    if (request.empty())
+    {
+        return false;
+    }
+    const size_t afterRequest = cur.Pos();
+    if (cur.Spaces() && cur.Literal("HTTP/"))
+    {
+        out.request = request;
+        out.httpversion = cur.Run(IsNotRegexSpace);
+        if (out.httpversion.size() < 2 || out.httpversion.back() != '"')
+        {
+            return false;
+        }
+        out.httpversion.remove_suffix(1);
+    }
+    else
+    {
+        if (request.size() < 2 || request.back() != '"')
+        {
+            return false;
+        }
+        out.request = request.substr(0, request.size() - 1);
+        out.httpversion = {};
+        cur.Seek(afterRequest);
+    }
+
+    if (!cur.Spaces())
+    {
+        return false;
+    }
+    out.response = cur.Run(IsDigit);
+    if (out.response.empty() || !cur.Spaces())
+    {
+        return false;
+    }
+    out.bytes = cur.Run(IsDigit);
+    if (out.bytes.empty())
+    {
+        const size_t dash = cur.Pos();
+        if (!cur.Char('-'))
+        {
+            return false;
+        }
+        out.bytes = cur.From(dash);
+    }
+    return true;
+}
+
+bool DecodeApacheCommon(std::string_view line, std::vector<std::string_view> &captures)
+{
+    LineCursor cur(line);
+    ClfPrefix clf;
+    if (!DecodeClfPrefix(cur, clf) || !cur.AtEnd())
+    {
+        return false;
+    }
+    captures.assign(
+        {clf.clientip,
+         clf.ident,
+         clf.auth,
+         clf.timestamp,
+         clf.verb,
+         clf.request,
+         clf.httpversion,
+         clf.response,
+         clf.bytes}
+    );
+    return true;
+}
+
+bool DecodeApacheCombined(std::string_view line, std::vector<std::string_view> &captures)
+{
+    LineCursor cur(line);
+    ClfPrefix clf;
+    if (!DecodeClfPrefix(cur, clf) || !cur.Spaces() || !cur.Char('"'))
+    {
+        return false;
+    }
+    const auto isNotQuote = [](char c) { return c != '"'; };
+    const std::string_view referrer = cur.Run(isNotQuote);
+    if (!cur.Char('"') || !cur.Spaces() || !cur.Char('"'))
+    {
+        return false;
+    }
+    const std::string_view agent = cur.Run(isNotQuote);
+    if (!cur.Char('"') || !cur.AtEnd())
+    {
+        return false;
+    }
+    captures.assign(
+        {clf.clientip,
+         clf.ident,
+         clf.auth,
+         clf.timestamp,
+         clf.verb,
+         clf.request,
+         clf.httpversion,
+         clf.response,
+         clf.bytes,
+         referrer,
+         agent}
+    );
+    return true;
+}
+
+/// Zap console levels; none is a prefix of another.
+constexpr std::array<std::string_view, 7> ZAP_LEVELS{"DEBUG", "INFO", "WARN", "ERROR", "DPANIC", "PANIC", "FATAL"};
+
+bool DecodeZap(std::string_view line, std::vector<std::string_view> &captures)
+{
+    LineCursor cur(line);
+    if (!IsoTimestamp(cur, /*zoneRequired*/ true))
+    {
+        return false;
+    }
+    const std::string_view timestamp = cur.From(0);
+    if (!cur.Spaces())
+    {
+        return false;
+    }
+
+    const size_t levelBegin = cur.Pos();
+    const bool knownLevel = std::ranges::any_of(ZAP_LEVELS, [&cur](std::string_view level) {
+        return cur.Literal(level);
+    });
+    const std::string_view level = cur.From(levelBegin);
+    if (!knownLevel || !cur.Spaces())
+    {
+        return false;
+    }
+
+    // `(?:(?<caller>[^\s"]+:\d+)\s+)?`: `[^\s"]+` backs off to a `:`, and
+    // only the last `:` of the run can leave `\d+` ending on `\s`. When
+    // that fails PCRE2 skips the group.
+    const size_t callerBegin = cur.Pos();
+    std::string_view caller = cur.Run([](char c) { return !IsRegexSpace(c) && c != '"'; });
+    const size_t colon = caller.rfind(':');
+    const bool callerMatches = colon != std::string_view::npos && colon != 0 && colon + 1 < caller.size() &&
+                               std::ranges::all_of(caller.substr(colon + 1), IsDigit) && cur.Spaces();
+    if (!callerMatches)
+    {
+        caller = {};
+        cur.Seek(callerBegin);
+    }
+
+    std::string_view message;
+    if (!cur.Rest(message))
+    {
+        return false;
+    }
+    captures.assign({timestamp, level, caller, message});
+    return true;
+}
+
+constexpr std::array<BuiltinRegexDecoder, 5> BUILTIN_REGEX_DECODERS{{
+    {
+        "Syslog (RFC3164)",
+        R"re(^(?<timestamp>[A-Z][a-z]{2}\s+\d{1,2}\s+\d{2}:\d{2}:\d{2}|\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}(?:\.\d+)?(?:Z|[+\-]\d{2}:?\d{2})?)\s+(?<hostname>\S+)\s+(?<program>[^\s\[:]+)(?:\[(?<pid>\d+)\])?:\s+(?<message>.*)$)re",
+        5,
+        &DecodeSyslogRfc3164,
+    },
+    {
+        "Google glog",
+        R"re(^(?<severity>[IWEF])(?<timestamp>\d{4}\s+\d{2}:\d{2}:\d{2}\.\d{6})\s+(?<thread>\d+)\s+(?<file>[^:]+):(?<line>\d+)\]\s+(?<message>.*)$)re",
+        6,
+        &DecodeGlog,
+    },
+    {
+        "Apache/nginx Common Log Format",
+        R"re(^(?<clientip>\S+)\s+(?<ident>\S+)\s+(?<auth>\S+)\s+\[(?<timestamp>[^\]]+)\]\s+"(?:(?<verb>\S+)\s+(?<request>\S+)(?:\s+HTTP/(?<httpversion>\S+))?|-)"\s+(?<response>\d+)\s+(?<bytes>\d+|-)$)re",
+        9,
+        &DecodeApacheCommon,
+    },
+    {
+        "Apache/nginx Combined Log Format",
+        R"re(^(?<clientip>\S+)\s+(?<ident>\S+)\s+(?<auth>\S+)\s+\[(?<timestamp>[^\]]+)\]\s+"(?:(?<verb>\S+)\s+(?<request>\S+)(?:\s+HTTP/(?<httpversion>\S+))?|-)"\s+(?<response>\d+)\s+(?<bytes>\d+|-)\s+"(?<referrer>[^"]*)"\s+"(?<agent>[^"]*)"$)re",
+        11,
+        &DecodeApacheCombined,
+    },
+    {
+        "Uber Zap (console)",
+        R"re(^(?<timestamp>\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}(?:\.\d+)?(?:Z|[+\-]\d{2}:?\d{2}))\s+(?<level>DEBUG|INFO|WARN|ERROR|DPANIC|PANIC|FATAL)\s+(?:(?<caller>[^\s"]+:\d+)\s+)?(?<message>.*)$)re",
+        4,
+        &DecodeZap,
+    },
+}};
+
+} // namespace
+
+std::span<const BuiltinRegexDecoder> BuiltinRegexDecoders() noexcept
+{
+    return BUILTIN_REGEX_DECODERS;
+}
+
+const BuiltinRegexDecoder *FindBuiltinRegexDecoder(std::string_view pattern) noexcept
+{
+    for (const BuiltinRegexDecoder &decoder : BUILTIN_REGEX_DECODERS)
+    {
+        if (decoder.pattern == pattern)
+        {
+            return &decoder;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace loglib::internal
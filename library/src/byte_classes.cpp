@@ -0,0 +1,170 @@
+#include "loglib/internal/byte_classes.hpp"
+
+#include <array>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define LOGLIB_BYTE_CLASSES_X86_64 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+namespace loglib::internal
+{
+
+namespace
+{
+
+using ClassifyKernel = ByteClassMasks (*)(const char *, const ByteClassSet &) noexcept;
+
+#ifdef LOGLIB_BYTE_CLASSES_X86_64
+
+// MSVC compiles AVX2 intrinsics without a per-function target; GCC and
+// Clang need the attribute so the rest of the TU stays baseline x86-64.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define LOGLIB_TARGET_AVX2
+#else
+#define LOGLIB_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+/// SSE2 is part of the x86-64 baseline, so this kernel needs no check.
+ByteClassMasks ClassifyBlockSse2(const char *block, const ByteClassSet &set) noexcept
+{
+    constexpr size_t LANE_BYTES = 16;
+    const __m128i spaceCeiling = _mm_set1_epi8(' ');
+
+    ByteClassMasks masks;
+    for (size_t lane = 0; lane < BYTE_CLASS_BLOCK_BYTES / LANE_BYTES; ++lane)
+    {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + (lane * LANE_BYTES)));
+        const size_t shift = lane * LANE_BYTES;
+        // Unsigned `c <= ' '` as `min(c, ' ') == c`.
+        const __m128i atOrBelowSpace = _mm_cmpeq_epi8(_mm_min_epu8(chunk, spaceCeiling), chunk);
+        masks.controlOrSpace |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(atOrBelowSpace)))
+                                << shift;
+        for (size_t i = 0; i < set.count; ++i)
+        {
+            const __m128i hit = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(set.bytes[i]));
+            masks.bytes[i] |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(hit))) << shift;
+        }
+    }
+    return masks;
+}
+
+LOGLIB_TARGET_AVX2 ByteClassMasks ClassifyBlockAvx2(const char *block, const ByteClassSet &set) noexcept
+{
+    constexpr size_t LANE_BYTES = 32;
+    const __m256i spaceCeiling = _mm256_set1_epi8(' ');
+
+    ByteClassMasks masks;
+    for (size_t lane = 0; lane < BYTE_CLASS_BLOCK_BYTES / LANE_BYTES; ++lane)
+    {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + (lane * LANE_BYTES)));
+        const size_t shift = lane * LANE_BYTES;
+        const __m256i atOrBelowSpace = _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, spaceCeiling), chunk);
+        masks.controlOrSpace |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(atOrBelowSpace)))
+                                << shift;
+        for (size_t i = 0; i < set.count; ++i)
+        {
+            const __m256i hit = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(set.bytes[i]));
+            masks.bytes[i] |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(hit))) << shift;
+        }
+    }
+    return masks;
+}
+
+/// AVX2 needs both the CPU feature and OS support for the YMM state.
+bool CpuSupportsAvx2() noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    constexpr int OSXSAVE_BIT = 1 << 27;
+    constexpr int AVX_BIT = 1 << 28;
+    constexpr int AVX2_BIT = 1 << 5;
+    constexpr unsigned long long XMM_YMM_STATE = 0x6;
+
+    std::array<int, 4> info{};
+    __cpuid(info.data(), 0);
+    if (info[0] < 7)
+    {
+        return false;
+    }
+    __cpuid(info.data(), 1);
+    if ((info[2] & OSXSAVE_BIT) == 0 || (info[2] & AVX_BIT) == 0)
+    {
+        return false;
+    }
+    if ((_xgetbv(0) & XMM_YMM_STATE) != XMM_YMM_STATE)
+    {
+        return false;
+    }
+    __cpuidex(info.data(), 7, 0);
+    return (info[1] & AVX2_BIT) != 0;
+#else
+    // libgcc / compiler-rt check the OS-enabled XSAVE state too.
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif
+
+struct SelectedKernel
+{
+    ClassifyKernel classify;
+    std::string_view name;
+};
+
+SelectedKernel SelectKernel() noexcept
+{
+#ifdef LOGLIB_BYTE_CLASSES_X86_64
+    if (CpuSupportsAvx2())
+    {
+        return {&ClassifyBlockAvx2, "avx2"};
+    }
+    return {&ClassifyBlockSse2, "sse2"};
+#else
+    return {&ClassifyBlockScalar, "scalar"};
+#endif
+}
+
+const SelectedKernel &ActiveKernel() noexcept
+{
+    static const SelectedKernel kernel = SelectKernel();
+    return kernel;
+}
+
+} // namespace
+
+ByteClassMasks ClassifyBlockScalar(const char *block, const ByteClassSet &set) noexcept
+{
+    ByteClassMasks masks;
+    for (size_t i = 0; i < BYTE_CLASS_BLOCK_BYTES; ++i)
+    {
+        const char c = block[i];
+        const uint64_t bit = uint64_t{1} << i;
+        if (static_cast<unsigned char>(c) <= ' ')
+        {
+            masks.controlOrSpace |= bit;
+        }
+        for (size_t j = 0; j < set.count; ++j)
+        {
+            if (c == set.bytes[j])
+            {
+                masks.bytes[j] |= bit;
+            }
+        }
+    }
+    return masks;
+}
+
+ByteClassMasks ClassifyBlock(const char *block, const ByteClassSet &set) noexcept
+{
+    return ActiveKernel().classify(block, set);
+}
+
+std::string_view ByteClassKernelName() noexcept
+{
+    return ActiveKernel().name;
+}
+
+} // namespace loglib::internal
@@ -3,6 +3,21 @@
 namespace loglib
 {
 
+bool BytesProducer::SupportsBorrowedBytes() const noexcept
+{
+    return false;
+}
+
+std::span<const char> BytesProducer::BorrowBytes(size_t /*maxBytes*/)
+{
+    return {};
+}
+
+void BytesProducer::ReleaseBorrowedBytes() noexcept
+{
+    // No-op: nothing is ever borrowed.
+}
+
 void BytesProducer::SetRotationCallback(const std::function<void()> & /*callback*/)
 {
     // No-op: finite producers never rotate.
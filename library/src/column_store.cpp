@@ -0,0 +1,147 @@
+#include "loglib/internal/column_store.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace loglib::internal
+{
+
+CompactLogValue DenseColumn::Slot(size_t row) const noexcept
+{
+    CompactLogValue slot;
+    slot.tag = Tag(row);
+    slot.payload = Payload(row);
+    slot.aux = Length(row);
+    return slot;
+}
+
+void DenseColumn::Reserve(size_t rows)
+{
+    mTags.reserve(mHead + rows);
+    mPayloads.reserve(mHead + rows);
+    mLengths.reserve(mHead + rows);
+}
+
+void DenseColumn::Append(const CompactLogValue &slot)
+{
+    mTags.push_back(slot.tag);
+    mPayloads.push_back(slot.payload);
+    // `aux` only carries a length for the string tags; keep the side
+    // array zero elsewhere so `Lengths()` is a clean length vector.
+    const bool isString = slot.tag == CompactTag::MmapSlice || slot.tag == CompactTag::OwnedString;
+    mLengths.push_back(isString ? slot.aux : 0U);
+}
+
+void DenseColumn::EraseFront(size_t count)
+{
+    if (count >= Size())
+    {
+        Clear();
+        return;
+    }
+    mHead += count;
+    // Compact once the dead prefix outgrows the live rows: each row
+    // moves at most once per doubling, keeping eviction amortised O(1).
+    if (mHead < Size())
+    {
+        return;
+    }
+    const auto head = static_cast<std::ptrdiff_t>(mHead);
+    mTags.erase(mTags.begin(), std::next(mTags.begin(), head));
+    mPayloads.erase(mPayloads.begin(), std::next(mPayloads.begin(), head));
+    mLengths.erase(mLengths.begin(), std::next(mLengths.begin(), head));
+    mHead = 0;
+}
+
+void DenseColumn::Clear() noexcept
+{
+    mTags.clear();
+    mPayloads.clear();
+    mLengths.clear();
+    mHead = 0;
+}
+
+size_t DenseColumn::MemoryBytes() const noexcept
+{
+    return (mTags.capacity() * sizeof(CompactTag)) + (mPayloads.capacity() * sizeof(uint64_t)) +
+           (mLengths.capacity() * sizeof(uint32_t));
+}
+
+void ColumnStore::SetEnabled(bool enabled) noexcept
+{
+    mEnabled = enabled;
+    if (!enabled)
+    {
+        Clear();
+    }
+}
+
+void ColumnStore::Resize(size_t columnCount)
+{
+    mColumns.resize(columnCount);
+}
+
+void ColumnStore::SetColumnKeys(size_t index, const std::vector<KeyId> &keyIds)
+{
+    mColumns[index].keyIds = keyIds;
+}
+
+void ColumnStore::Invalidate(size_t index) noexcept
+{
+    if (index < mColumns.size())
+    {
+        mColumns[index].column.Clear();
+    }
+}
+
+void ColumnStore::MoveColumn(size_t srcIndex, size_t destIndex)
+{
+    if (srcIndex == destIndex || srcIndex >= mColumns.size() || destIndex >= mColumns.size())
+    {
+        return;
+    }
+    using Diff = std::vector<Entry>::difference_type;
+    auto begin = mColumns.begin();
+    if (srcIndex > destIndex)
+    {
+        std::rotate(
+            std::next(begin, static_cast<Diff>(destIndex)),
+            std::next(begin, static_cast<Diff>(srcIndex)),
+            std::next(begin, static_cast<Diff>(srcIndex + 1))
+        );
+    }
+    else
+    {
+        std::rotate(
+            std::next(begin, static_cast<Diff>(srcIndex)),
+            std::next(begin, static_cast<Diff>(srcIndex + 1)),
+            std::next(begin, static_cast<Diff>(destIndex + 1))
+        );
+    }
+}
+
+void ColumnStore::EraseFrontRows(size_t count)
+{
+    for (Entry &entry : mColumns)
+    {
+        entry.column.EraseFront(count);
+    }
+}
+
+void ColumnStore::Clear() noexcept
+{
+    mColumns.clear();
+}
+
+size_t ColumnStore::MemoryBytes() const noexcept
+{
+    size_t bytes = mColumns.capacity() * sizeof(Entry);
+    for (const Entry &entry : mColumns)
+    {
+        bytes += entry.column.MemoryBytes() + (entry.keyIds.capacity() * sizeof(KeyId));
+    }
+    return bytes;
+}
+
+} // namespace loglib::internal
@@ -1,11 +1,13 @@
 #include "loglib/internal/compact_log_value.hpp"
 
 #include "loglib/enum_dictionary.hpp"
+#include "loglib/internal/line_field_slab.hpp"
 #include "loglib/line_source.hpp"
 #include "loglib/log_line.hpp"
 
 #include <algorithm>
 #include <bit>
+#include <cassert>
 #include <chrono>
 #include <memory>
 #include <string>
@@ -228,11 +230,26 @@ void RebaseOwnedStringOffsets(std::pair<KeyId, CompactLogValue> *values, size_t
     }
 }
 
+void RebaseOwnedStringOffsets(CompactLogValue *values, size_t valueCount, uint64_t delta) noexcept
+{
+    if (delta == 0)
+    {
+        return;
+    }
+    for (size_t i = 0; i < valueCount; ++i)
+    {
+        if (values[i].tag == CompactTag::OwnedString)
+        {
+            values[i].payload += delta;
+        }
+    }
+}
+
 namespace
 {
 
 /// `CompactLineFields` uses raw `::operator new` to avoid per-element
-/// ctor/dtor work; the pair must therefore be trivially destructible and
+/// ctor/dtor work; the slots must therefore be trivially destructible and
 /// trivially copy-constructible.
 constexpr size_t PAIR_BYTES = sizeof(std::pair<KeyId, CompactLogValue>);
 
@@ -244,23 +261,31 @@ static_assert(
     std::is_trivially_copy_constructible_v<std::pair<KeyId, CompactLogValue>>,
     "CompactLineFields slots must be trivially copy-constructible"
 );
+static_assert(
+    std::is_trivially_copyable_v<CompactLogValue> && sizeof(CompactLogValue) < PAIR_BYTES,
+    "Shaped CompactLineFields slots must be trivially copyable and narrower than keyed ones"
+);
+
+/// Fresh block for @p capacity slots: carved from the thread's current
+/// `LineFieldSlab` inside Stage B, else from the heap.
+struct SlotBlock
+{
+    void *data = nullptr;
+    bool fromSlab = false;
+};
 
-std::pair<KeyId, CompactLogValue> *AllocatePairs(uint32_t capacity)
+SlotBlock AllocateSlots(uint32_t capacity, size_t slotBytes)
 {
     if (capacity == 0)
     {
-        return nullptr;
+        return {};
     }
-    void *raw = ::operator new(static_cast<size_t>(capacity) * PAIR_BYTES);
-    return static_cast<std::pair<KeyId, CompactLogValue> *>(raw);
-}
-
-void DeallocatePairs(std::pair<KeyId, CompactLogValue> *data) noexcept
-{
-    if (data != nullptr)
+    const size_t bytes = static_cast<size_t>(capacity) * slotBytes;
+    if (LineFieldSlab *slab = CurrentLineFieldSlab())
     {
-        ::operator delete(data);
+        return {.data = slab->Allocate(bytes), .fromSlab = true};
     }
+    return {.data = ::operator new(bytes), .fromSlab = false};
 }
 
 uint32_t GrowCapacity(uint32_t current, uint32_t needed) noexcept
@@ -274,8 +299,10 @@ uint32_t GrowCapacity(uint32_t current, uint32_t needed) noexcept
 } // namespace
 
 CompactLineFields::CompactLineFields(uint32_t initialCapacity)
-    : mData(AllocatePairs(initialCapacity)), mCapacity(initialCapacity)
 {
+    const SlotBlock block = AllocateSlots(initialCapacity, PAIR_BYTES);
+    mData = block.data;
+    mCapacity = initialCapacity | (block.fromSlab ? SLAB_FLAG : 0U);
 }
 
 CompactLineFields::CompactLineFields(CompactLineFields &&other) noexcept
@@ -290,7 +317,7 @@ CompactLineFields &CompactLineFields::operator=(CompactLineFields &&other) noexc
 {
     if (this != &other)
     {
-        DeallocatePairs(mData);
+        ReleaseBlock();
         mData = other.mData;
         mSize = other.mSize;
         mCapacity = other.mCapacity;
@@ -303,44 +330,60 @@ CompactLineFields &CompactLineFields::operator=(CompactLineFields &&other) noexc
 
 CompactLineFields::~CompactLineFields()
 {
-    DeallocatePairs(mData);
+    ReleaseBlock();
+}
+
+void CompactLineFields::ReleaseBlock() noexcept
+{
+    // Slab blocks are reclaimed wholesale with their `LineFieldSlab`.
+    if (mData != nullptr && (mCapacity & SLAB_FLAG) == 0)
+    {
+        ::operator delete(mData);
+    }
+}
+
+void CompactLineFields::AdoptBlock(void *data, bool fromSlab, uint32_t capacity, uint32_t layoutFlag) noexcept
+{
+    ReleaseBlock();
+    mData = data;
+    mCapacity = capacity | layoutFlag | (fromSlab ? SLAB_FLAG : 0U);
 }
 
 void CompactLineFields::Reserve(uint32_t capacity)
 {
-    if (capacity <= mCapacity)
+    // Keyed-only: a shaped buffer has no KeyIds to carry over, so
+    // `LogLine` rebuilds it via `AssignSorted` when its key set changes.
+    assert(!IsShaped());
+    if (capacity <= Capacity())
     {
         return;
     }
-    auto *fresh = AllocatePairs(capacity);
+    const SlotBlock fresh = AllocateSlots(capacity, PAIR_BYTES);
     if (mSize > 0)
     {
-        std::uninitialized_copy_n(mData, mSize, fresh);
+        std::uninitialized_copy_n(Data(), mSize, static_cast<value_type *>(fresh.data));
     }
-    DeallocatePairs(mData);
-    mData = fresh;
-    mCapacity = capacity;
+    AdoptBlock(fresh.data, fresh.fromSlab, capacity, 0U);
 }
 
 void CompactLineFields::AssignSorted(const value_type *values, uint32_t count)
 {
-    const bool reused = (count <= mCapacity);
+    const bool reused = (!IsShaped() && count <= Capacity());
     if (!reused)
     {
-        DeallocatePairs(mData);
-        mData = AllocatePairs(count);
-        mCapacity = count;
+        const SlotBlock fresh = AllocateSlots(count, PAIR_BYTES);
+        AdoptBlock(fresh.data, fresh.fromSlab, count, 0U);
     }
     if (count > 0)
     {
         // Reused buffer uses copy assignment; fresh uses uninitialized copy.
         if (reused)
         {
-            std::copy_n(values, count, mData);
+            std::copy_n(values, count, Data());
         }
         else
         {
-            std::uninitialized_copy_n(values, count, mData);
+            std::uninitialized_copy_n(values, count, Data());
         }
     }
     mSize = count;
@@ -352,72 +395,95 @@ void CompactLineFields::AssignSorted(std::vector<value_type> &&values)
     AssignSorted(local.data(), static_cast<uint32_t>(local.size()));
 }
 
+void CompactLineFields::AssignShaped(const value_type *values, uint32_t count)
+{
+    // Exact-fit: a shaped row only changes layout through a rebuild, so
+    // slack would never be used.
+    if (!(IsShaped() && count == Capacity()))
+    {
+        const SlotBlock fresh = AllocateSlots(count, sizeof(CompactLogValue));
+        AdoptBlock(fresh.data, fresh.fromSlab, count, SHAPED_FLAG);
+    }
+    auto *out = static_cast<CompactLogValue *>(mData);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        std::construct_at(out + i, values[i].second);
+    }
+    mSize = count;
+}
+
 void CompactLineFields::EmplaceBack(KeyId key, CompactLogValue value)
 {
-    if (mSize == mCapacity)
+    if (mSize == Capacity())
     {
-        Reserve(GrowCapacity(mCapacity, mSize + 1U));
+        Reserve(GrowCapacity(Capacity(), mSize + 1U));
     }
     // Trailing slot is raw memory; `construct_at` begins object lifetime.
-    std::construct_at(mData + mSize, key, value);
+    std::construct_at(Data() + mSize, key, value);
     ++mSize;
 }
 
 void CompactLineFields::Insert(uint32_t position, KeyId key, CompactLogValue value)
 {
-    if (mSize == mCapacity)
+    if (mSize == Capacity())
     {
-        Reserve(GrowCapacity(mCapacity, mSize + 1U));
+        Reserve(GrowCapacity(Capacity(), mSize + 1U));
     }
+    value_type *data = Data();
     if (position < mSize)
     {
         // Shift `[position, mSize)` right by one; construct into the
         // trailing raw slot first, then assign the rest.
-        std::construct_at(mData + mSize, mData[mSize - 1]);
+        std::construct_at(data + mSize, data[mSize - 1]);
         if (position + 1 < mSize)
         {
-            std::copy_backward(mData + position, mData + mSize - 1, mData + mSize);
+            std::copy_backward(data + position, data + mSize - 1, data + mSize);
         }
-        mData[position] = {key, value};
+        data[position] = {key, value};
     }
     else
     {
-        std::construct_at(mData + mSize, key, value);
+        std::construct_at(data + mSize, key, value);
     }
     ++mSize;
 }
 
 void CompactLineFields::Set(uint32_t position, CompactLogValue value) noexcept
 {
-    if (position < mSize)
+    if (position >= mSize)
+    {
+        return;
+    }
+    if (IsShaped())
+    {
+        ShapedData()[position] = value;
+    }
+    else
     {
-        mData[position].second = value;
+        Data()[position].second = value;
     }
 }
 
 size_t CompactLineFields::OwnedMemoryBytes() const noexcept
 {
-    return static_cast<size_t>(mCapacity) * PAIR_BYTES;
+    return static_cast<size_t>(Capacity()) * (IsShaped() ? sizeof(CompactLogValue) : PAIR_BYTES);
 }
 
 void CompactLineFields::ShrinkToFit()
 {
-    if (mCapacity == mSize)
+    if (Capacity() == mSize)
     {
         return;
     }
     if (mSize == 0)
     {
-        DeallocatePairs(mData);
-        mData = nullptr;
-        mCapacity = 0;
+        AdoptBlock(nullptr, false, 0U, 0U);
         return;
     }
-    auto *fresh = AllocatePairs(mSize);
-    std::uninitialized_copy_n(mData, mSize, fresh);
-    DeallocatePairs(mData);
-    mData = fresh;
-    mCapacity = mSize;
+    // Shaped buffers are always exact-fit, so only the keyed layout gets here.
+    const SlotBlock fresh = AllocateSlots(mSize, PAIR_BYTES);
+    std::uninitialized_copy_n(Data(), mSize, static_cast<value_type *>(fresh.data));
+    AdoptBlock(fresh.data, fresh.fromSlab, mSize, 0U);
 }
 
 } // namespace loglib::internal
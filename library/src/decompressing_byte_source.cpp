@@ -1,19 +1,34 @@
 #include "loglib/internal/decompressing_byte_source.hpp"
 
+#include "loglib/internal/growing_byte_buffer.hpp"
+#include "loglib/internal/path_encoding.hpp"
+#include "loglib/internal/seek_index.hpp"
+
 #include <fmt/format.h>
+#include <mio/mmap.hpp>
+#include <oneapi/tbb/info.h>
+#include <oneapi/tbb/parallel_pipeline.h>
+#include <oneapi/tbb/task_arena.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cerrno>
 #include <chrono>
+#include <climits>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <exception>
 #include <fstream>
 #include <ios>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <random>
 #include <span>
 #include <system_error>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -306,19 +321,68 @@ void WriteAll(FileHandle &out, const void *data, std::size_t bytes, const std::f
     }
 }
 
-/// Write output, update its size, and enforce the configured cap.
-void WriteOutput(
-    FileHandle &out,
-    const void *data,
-    std::size_t bytes,
-    const std::filesystem::path &tempPath,
-    const std::filesystem::path &sourcePath,
-    std::size_t &decompressedSize,
-    std::size_t maxDecompressedBytes
+/// Destination for decoded bytes: the temp file, or the
+/// `GrowingByteBuffer` of a progressive decode.
+class DecodeOutput
+{
+public:
+    DecodeOutput() = default;
+    DecodeOutput(const DecodeOutput &) = delete;
+    DecodeOutput &operator=(const DecodeOutput &) = delete;
+    DecodeOutput(DecodeOutput &&) = delete;
+    DecodeOutput &operator=(DecodeOutput &&) = delete;
+    virtual ~DecodeOutput() = default;
+
+    /// Called after every decoder step, also with zero bytes, so a
+    /// sink can observe cancellation while the codec is idle.
+    virtual void Write(const void *data, std::size_t bytes) = 0;
+};
+
+class TempFileOutput final : public DecodeOutput
+{
+public:
+    TempFileOutput(FileHandle &handle, const std::filesystem::path &tempPath) noexcept
+        : mHandle(handle), mTempPath(tempPath)
+    {
+    }
+
+    void Write(const void *data, std::size_t bytes) override
+    {
+        WriteAll(mHandle, data, bytes, mTempPath);
+    }
+
+private:
+    FileHandle &mHandle;
+    const std::filesystem::path &mTempPath;
+};
+
+class BufferOutput final : public DecodeOutput
+{
+public:
+    explicit BufferOutput(GrowingByteBuffer &buffer) noexcept
+        : mBuffer(buffer)
+    {
+    }
+
+    void Write(const void *data, std::size_t bytes) override
+    {
+        // The reader gave up (parse cancelled or file closed).
+        if (mBuffer.StopRequested())
+        {
+            throw DecompressionCancelled("decompression cancelled by reader");
+        }
+        mBuffer.Append(static_cast<const char *>(data), bytes);
+    }
+
+private:
+    GrowingByteBuffer &mBuffer;
+};
+
+/// Throw if @p decompressedSize is over a non-zero @p maxDecompressedBytes.
+void EnforceSizeCap(
+    const std::filesystem::path &sourcePath, std::size_t decompressedSize, std::size_t maxDecompressedBytes
 )
 {
-    WriteAll(out, data, bytes, tempPath);
-    decompressedSize += bytes;
     if (maxDecompressedBytes != 0 && decompressedSize > maxDecompressedBytes)
     {
         throw DecompressionSizeCapExceeded(
@@ -333,6 +397,21 @@ void WriteOutput(
     }
 }
 
+/// Write output, update its size, and enforce the configured cap.
+void WriteOutput(
+    DecodeOutput &out,
+    const void *data,
+    std::size_t bytes,
+    const std::filesystem::path &sourcePath,
+    std::size_t &decompressedSize,
+    std::size_t maxDecompressedBytes
+)
+{
+    out.Write(data, bytes);
+    decompressedSize += bytes;
+    EnforceSizeCap(sourcePath, decompressedSize, maxDecompressedBytes);
+}
+
 /// Shared progress-fire + stop-token poll used by every codec.
 inline void ObservePoll(
     std::size_t bytesInSoFar,
@@ -351,18 +430,60 @@ inline void ObservePoll(
     }
 }
 
+/// 25% of physical RAM, or 512 MiB when liblzma cannot tell.
+[[nodiscard]] std::uint64_t QuarterOfPhysicalMemory() noexcept
+{
+    constexpr std::uint64_t FALLBACK_MIB = 512;
+    constexpr unsigned MIB_TO_BYTES_SHIFT = 20;
+    constexpr unsigned PHYSMEM_FRACTION_SHIFT = 2; // physmem / 4
+    const std::uint64_t physmem = ::lzma_physmem();
+    return physmem == 0 ? (FALLBACK_MIB << MIB_TO_BYTES_SHIFT) : (physmem >> PHYSMEM_FRACTION_SHIFT);
+}
+
 // --- gzip / zlib -------------------------------------------------------
 
+/// Ends an inflate stream on scope exit.
+class ZlibGuard
+{
+public:
+    explicit ZlibGuard(z_stream *s) noexcept
+        : mStream(s)
+    {
+    }
+    ~ZlibGuard() noexcept
+    {
+        (void)::inflateEnd(mStream);
+    }
+    ZlibGuard(const ZlibGuard &) = delete;
+    ZlibGuard &operator=(const ZlibGuard &) = delete;
+    ZlibGuard(ZlibGuard &&) = delete;
+    ZlibGuard &operator=(ZlibGuard &&) = delete;
+
+private:
+    z_stream *mStream;
+};
+
+/// Unused bits of the last input byte, in `z_stream::data_type`.
+constexpr int ZLIB_DATA_TYPE_BITS_MASK = 7;
+/// Set while inflate is decoding the final deflate block.
+constexpr int ZLIB_DATA_TYPE_LAST_BLOCK = 64;
+/// Set when inflate stopped on a deflate block boundary.
+constexpr int ZLIB_DATA_TYPE_BLOCK_END = 128;
+
+/// Stream-decode gzip / zlib input. With @p seekIndex set, inflate
+/// also stops on every deflate block boundary and records one there
+/// each @p seekPointSpacing decoded bytes.
 void DecodeGzip(
     std::ifstream &in,
-    FileHandle &out,
+    DecodeOutput &out,
     const std::filesystem::path &sourcePath,
-    const std::filesystem::path &tempPath,
     std::size_t totalBytesIn,
     const DecompressingByteSource::ProgressCallback &progress,
     const StopToken &stopToken,
     std::size_t &decompressedSize,
-    std::size_t maxDecompressedBytes
+    std::size_t maxDecompressedBytes,
+    GzipSeekIndex *seekIndex,
+    std::size_t seekPointSpacing
 )
 {
     z_stream strm{};
@@ -372,31 +493,14 @@ void DecodeGzip(
     {
         throw std::runtime_error(fmt::format("Failed to init zlib inflate for '{}'", sourcePath.string()));
     }
-    class ZlibGuard
-    {
-    public:
-        explicit ZlibGuard(z_stream *s) noexcept
-            : mStream(s)
-        {
-        }
-        ~ZlibGuard() noexcept
-        {
-            (void)::inflateEnd(mStream);
-        }
-        ZlibGuard(const ZlibGuard &) = delete;
-        ZlibGuard &operator=(const ZlibGuard &) = delete;
-        ZlibGuard(ZlibGuard &&) = delete;
-        ZlibGuard &operator=(ZlibGuard &&) = delete;
-
-    private:
-        z_stream *mStream;
-    };
     const ZlibGuard guard(&strm);
 
     std::array<Bytef, CHUNK_SIZE> inBuf{};
     std::array<Bytef, CHUNK_SIZE> outBuf{};
 
     std::size_t consumed = 0;
+    std::size_t lastSeekPoint = decompressedSize;
+    const int flush = seekIndex != nullptr ? Z_BLOCK : Z_NO_FLUSH;
     // Preserve end-of-member state across chunk boundaries.
     int ret = Z_OK;
     for (;;)
@@ -445,7 +549,7 @@ void DecodeGzip(
             // Z_NO_FLUSH handles concatenated members uniformly;
             // Z_FINISH + reset-on-Z_STREAM_END breaks when member
             // boundaries land mid-buffer.
-            ret = ::inflate(&strm, Z_NO_FLUSH);
+            ret = ::inflate(&strm, flush);
             switch (ret)
             {
             case Z_NEED_DICT:
@@ -461,7 +565,23 @@ void DecodeGzip(
                 break;
             }
             const std::size_t produced = outBuf.size() - strm.avail_out;
-            WriteOutput(out, outBuf.data(), produced, tempPath, sourcePath, decompressedSize, maxDecompressedBytes);
+            WriteOutput(out, outBuf.data(), produced, sourcePath, decompressedSize, maxDecompressedBytes);
+            // A block boundary other than the one after the last block
+            // can be resumed from with just the window (zlib's zran).
+            if (seekIndex != nullptr && ret != Z_STREAM_END && (strm.data_type & ZLIB_DATA_TYPE_BLOCK_END) != 0 &&
+                (strm.data_type & ZLIB_DATA_TYPE_LAST_BLOCK) == 0 &&
+                decompressedSize - lastSeekPoint >= std::max<std::size_t>(seekPointSpacing, 1))
+            {
+                GzipSeekPoint &point = seekIndex->points.emplace_back();
+                point.compressedOffset = consumed - strm.avail_in;
+                point.decodedOffset = decompressedSize;
+                point.bits = static_cast<std::uint8_t>(strm.data_type & ZLIB_DATA_TYPE_BITS_MASK);
+                uInt windowBytes = 0;
+                (void)::inflateGetDictionary(&strm, nullptr, &windowBytes);
+                point.window.resize(windowBytes);
+                (void)::inflateGetDictionary(&strm, point.window.data(), &windowBytes);
+                lastSeekPoint = decompressedSize;
+            }
             if (strm.avail_out != 0 && strm.avail_in == 0)
             {
                 break;
@@ -487,9 +607,8 @@ void DecodeGzip(
 
 void DecodeBzip2(
     std::ifstream &in,
-    FileHandle &out,
+    DecodeOutput &out,
     const std::filesystem::path &sourcePath,
-    const std::filesystem::path &tempPath,
     std::size_t totalBytesIn,
     const DecompressingByteSource::ProgressCallback &progress,
     const StopToken &stopToken,
@@ -578,7 +697,7 @@ void DecodeBzip2(
                 );
             }
             const std::size_t produced = outBuf.size() - strm.avail_out;
-            WriteOutput(out, outBuf.data(), produced, tempPath, sourcePath, decompressedSize, maxDecompressedBytes);
+            WriteOutput(out, outBuf.data(), produced, sourcePath, decompressedSize, maxDecompressedBytes);
             if (strm.avail_out != 0 && strm.avail_in == 0)
             {
                 break;
@@ -605,9 +724,8 @@ void DecodeBzip2(
 // back to one worker.
 void DecodeXz(
     std::ifstream &in,
-    FileHandle &out,
+    DecodeOutput &out,
     const std::filesystem::path &sourcePath,
-    const std::filesystem::path &tempPath,
     std::size_t totalBytesIn,
     const DecompressingByteSource::ProgressCallback &progress,
     const StopToken &stopToken,
@@ -635,12 +753,7 @@ void DecodeXz(
     // ST decoder accepts must still open here.
     mt.memlimit_stop = UINT64_MAX;
     // Limit threading memory to 25% of RAM, or 512 MiB if unknown.
-    constexpr std::uint64_t XZ_MEMLIMIT_FALLBACK_MIB = 512;
-    constexpr unsigned MIB_TO_BYTES_SHIFT = 20;
-    constexpr unsigned PHYSMEM_FRACTION_SHIFT = 2; // physmem / 4
-    const std::uint64_t physmem = ::lzma_physmem();
-    mt.memlimit_threading =
-        physmem == 0 ? (XZ_MEMLIMIT_FALLBACK_MIB << MIB_TO_BYTES_SHIFT) : (physmem >> PHYSMEM_FRACTION_SHIFT);
+    mt.memlimit_threading = QuarterOfPhysicalMemory();
 
     const lzma_ret initRet = ::lzma_stream_decoder_mt(&strm, &mt);
     if (initRet != LZMA_OK)
@@ -713,17 +826,37 @@ void DecodeXz(
             );
         }
         const std::size_t produced = outBuf.size() - strm.avail_out;
-        WriteOutput(out, outBuf.data(), produced, tempPath, sourcePath, decompressedSize, maxDecompressedBytes);
+        WriteOutput(out, outBuf.data(), produced, sourcePath, decompressedSize, maxDecompressedBytes);
     }
 }
 
 // --- zstd --------------------------------------------------------------
 
+/// Frees a zstd decompression context on scope exit.
+class ZstdGuard
+{
+public:
+    explicit ZstdGuard(ZSTD_DCtx *ctx) noexcept
+        : mCtx(ctx)
+    {
+    }
+    ~ZstdGuard() noexcept
+    {
+        (void)::ZSTD_freeDCtx(mCtx);
+    }
+    ZstdGuard(const ZstdGuard &) = delete;
+    ZstdGuard &operator=(const ZstdGuard &) = delete;
+    ZstdGuard(ZstdGuard &&) = delete;
+    ZstdGuard &operator=(ZstdGuard &&) = delete;
+
+private:
+    ZSTD_DCtx *mCtx;
+};
+
 void DecodeZstd(
     std::ifstream &in,
-    FileHandle &out,
+    DecodeOutput &out,
     const std::filesystem::path &sourcePath,
-    const std::filesystem::path &tempPath,
     std::size_t totalBytesIn,
     const DecompressingByteSource::ProgressCallback &progress,
     const StopToken &stopToken,
@@ -739,25 +872,6 @@ void DecodeZstd(
     {
         throw std::runtime_error(fmt::format("Failed to create zstd DCtx for '{}'", sourcePath.string()));
     }
-    class ZstdGuard
-    {
-    public:
-        explicit ZstdGuard(ZSTD_DCtx *ctx) noexcept
-            : mCtx(ctx)
-        {
-        }
-        ~ZstdGuard() noexcept
-        {
-            (void)::ZSTD_freeDCtx(mCtx);
-        }
-        ZstdGuard(const ZstdGuard &) = delete;
-        ZstdGuard &operator=(const ZstdGuard &) = delete;
-        ZstdGuard(ZstdGuard &&) = delete;
-        ZstdGuard &operator=(ZstdGuard &&) = delete;
-
-    private:
-        ZSTD_DCtx *mCtx;
-    };
     const ZstdGuard guard(dctx);
 
     std::array<char, CHUNK_SIZE> inBuf{};
@@ -822,9 +936,7 @@ void DecodeZstd(
                     produced = {};
                 }
             }
-            WriteOutput(
-                out, produced.data(), produced.size(), tempPath, sourcePath, decompressedSize, maxDecompressedBytes
-            );
+            WriteOutput(out, produced.data(), produced.size(), sourcePath, decompressedSize, maxDecompressedBytes);
             lastResult = result;
         }
 
@@ -849,8 +961,937 @@ void DecodeZstd(
     }
 }
 
+// --- frame-parallel decode ---------------------------------------------
+
+/// Compressed bytes per pipeline token. Small BGZF blocks and seekable
+/// zstd frames are grouped up to this so per-token overhead stays low.
+constexpr std::size_t PARALLEL_RUN_BYTES = std::size_t{1} << 20;
+
+/// Frames above either limit are not buffered by a worker; the ordered
+/// output stage streams them instead, bounding in-flight memory.
+constexpr std::size_t PARALLEL_MAX_FRAME_BYTES = std::size_t{8} << 20;
+constexpr std::size_t PARALLEL_MAX_DECODED_FRAME_BYTES = std::size_t{128} << 20;
+
+/// Pipeline tokens per decode thread.
+constexpr std::size_t PARALLEL_TOKENS_PER_THREAD = 2;
+
+/// Decoded size of a frame whose header does not record it.
+constexpr std::size_t UNKNOWN_FRAME_SIZE = static_cast<std::size_t>(-1);
+
+/// One independently decodable frame at the start of a span.
+struct FrameExtent
+{
+    std::size_t compressedBytes = 0;
+    std::size_t decodedBytes = UNKNOWN_FRAME_SIZE;
+};
+
+/// Pipeline token: a run of whole frames and, once a worker has been
+/// through it, their decoded bytes or the failure that stopped it.
+struct FrameRun
+{
+    std::size_t begin = 0;
+    std::size_t end = 0;
+    std::size_t decodedHint = 0;
+    /// Decoded by the output stage rather than a worker: one frame
+    /// too large to buffer, or an input tail no frame scan delimits.
+    bool streamed = false;
+    std::string decoded;
+    std::exception_ptr failure;
+};
+
+/// BGZF block (`bgzip`, htslib) at the start of @p rest: a gzip member
+/// whose `BC` extra subfield records its own size. Plain gzip members
+/// carry no size, so they are never split.
+[[nodiscard]] std::optional<FrameExtent> ScanBgzfBlock(std::span<const std::uint8_t> rest) noexcept
+{
+    // ID1 ID2 CM FLG MTIME(4) XFL OS XLEN(2), then XLEN extra bytes.
+    constexpr std::size_t HEADER_BYTES = 12;
+    constexpr std::uint8_t DEFLATE_METHOD = 8;
+    constexpr std::uint8_t FLAG_EXTRA = 0x04;
+    constexpr std::size_t SUBFIELD_HEADER_BYTES = 4;
+    constexpr std::size_t TRAILER_BYTES = 8; // CRC32, ISIZE
+    if (rest.size() < HEADER_BYTES || rest[0] != GZIP_MAGIC[0] || rest[1] != GZIP_MAGIC[1] ||
+        rest[2] != DEFLATE_METHOD || (rest[3] & FLAG_EXTRA) == 0)
+    {
+        return std::nullopt;
+    }
+    const auto readLe16 = [&rest](std::size_t at) {
+        return static_cast<std::size_t>(rest[at]) | (static_cast<std::size_t>(rest[at + 1]) << 8);
+    };
+    const std::size_t extraEnd = HEADER_BYTES + readLe16(10);
+    if (rest.size() < extraEnd)
+    {
+        return std::nullopt;
+    }
+    for (std::size_t pos = HEADER_BYTES; pos + SUBFIELD_HEADER_BYTES <= extraEnd;)
+    {
+        const std::size_t subfieldBytes = readLe16(pos + 2);
+        if (rest[pos] == 'B' && rest[pos + 1] == 'C' && subfieldBytes == 2 &&
+            pos + SUBFIELD_HEADER_BYTES + 2 <= extraEnd)
+        {
+            const std::size_t blockBytes = readLe16(pos + SUBFIELD_HEADER_BYTES) + 1;
+            if (blockBytes < extraEnd + TRAILER_BYTES || blockBytes > rest.size())
+            {
+                return std::nullopt;
+            }
+            const std::size_t isize = readLe16(blockBytes - 4) | (readLe16(blockBytes - 2) << 16);
+            return FrameExtent{.compressedBytes = blockBytes, .decodedBytes = isize};
+        }
+        pos += SUBFIELD_HEADER_BYTES + subfieldBytes;
+    }
+    return std::nullopt;
+}
+
+/// Complete zstd frame (data or skippable) at the start of @p rest.
+[[nodiscard]] std::optional<FrameExtent> ScanZstdFrame(std::span<const std::uint8_t> rest) noexcept
+{
+    const std::size_t compressed = ::ZSTD_findFrameCompressedSize(rest.data(), rest.size());
+    if (::ZSTD_isError(compressed) != 0U)
+    {
+        return std::nullopt;
+    }
+    const unsigned long long decoded = ::ZSTD_getFrameContentSize(rest.data(), rest.size());
+    const bool known = decoded != ZSTD_CONTENTSIZE_UNKNOWN && decoded != ZSTD_CONTENTSIZE_ERROR;
+    return FrameExtent{
+        .compressedBytes = compressed,
+        .decodedBytes = known ? static_cast<std::size_t>(decoded) : UNKNOWN_FRAME_SIZE,
+    };
+}
+
+/// Inflate the gzip members in @p bytes, which start at input offset
+/// @p baseOffset. @p poll sees the input offset between inflate calls
+/// and @p sink every output chunk.
+template <class Poll, class Sink>
+void InflateMembers(
+    std::span<const std::uint8_t> bytes,
+    std::size_t baseOffset,
+    const std::filesystem::path &sourcePath,
+    Poll &&poll,
+    Sink &&sink
+)
+{
+    z_stream strm{};
+    // 15 + 16: gzip only; BGZF blocks are always gzip members.
+    if (::inflateInit2(&strm, 15 + 16) != Z_OK)
+    {
+        throw std::runtime_error(fmt::format("Failed to init zlib inflate for '{}'", sourcePath.string()));
+    }
+    const ZlibGuard guard(&strm);
+
+    std::array<Bytef, CHUNK_SIZE> outBuf{};
+    std::size_t fed = 0;
+    int ret = Z_OK;
+    bool pendingOutput = false;
+    for (;;)
+    {
+        if (strm.avail_in == 0 && !pendingOutput)
+        {
+            if (fed == bytes.size())
+            {
+                break;
+            }
+            const std::size_t slice = std::min(bytes.size() - fed, CHUNK_SIZE);
+            // zlib only takes `next_in` as non-const without ZLIB_CONST.
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+            strm.next_in = const_cast<Bytef *>(bytes.data() + fed);
+            strm.avail_in = static_cast<uInt>(slice);
+            fed += slice;
+        }
+        if (ret == Z_STREAM_END)
+        {
+            // Another member follows.
+            if (::inflateReset(&strm) != Z_OK)
+            {
+                throw std::runtime_error(
+                    fmt::format(
+                        "zlib inflateReset failed on '{}' at input byte {}",
+                        sourcePath.string(),
+                        baseOffset + fed - strm.avail_in
+                    )
+                );
+            }
+        }
+        poll(baseOffset + fed - strm.avail_in);
+        strm.next_out = outBuf.data();
+        strm.avail_out = static_cast<uInt>(outBuf.size());
+        ret = ::inflate(&strm, Z_NO_FLUSH);
+        switch (ret)
+        {
+        case Z_NEED_DICT:
+        case Z_DATA_ERROR:
+        case Z_MEM_ERROR:
+        case Z_STREAM_ERROR:
+            throw std::runtime_error(
+                fmt::format(
+                    "zlib inflate error on '{}' at input byte {} (code {})",
+                    sourcePath.string(),
+                    baseOffset + fed - strm.avail_in,
+                    ret
+                )
+            );
+        default:
+            break;
+        }
+        sink(reinterpret_cast<const char *>(outBuf.data()), outBuf.size() - strm.avail_out);
+        pendingOutput = ret != Z_STREAM_END && strm.avail_out == 0;
+    }
+    if (ret != Z_STREAM_END)
+    {
+        throw std::runtime_error(
+            fmt::format("Unexpected EOF in gzip stream '{}' at input byte {}", sourcePath.string(), baseOffset + fed)
+        );
+    }
+}
+
+/// Decompress the zstd frames in @p bytes; see `InflateMembers`.
+template <class Poll, class Sink>
+void DecompressZstdFrames(
+    std::span<const std::uint8_t> bytes,
+    std::size_t baseOffset,
+    const std::filesystem::path &sourcePath,
+    Poll &&poll,
+    Sink &&sink
+)
+{
+    ZSTD_DCtx *dctx = ::ZSTD_createDCtx();
+    if (dctx == nullptr)
+    {
+        throw std::runtime_error(fmt::format("Failed to create zstd DCtx for '{}'", sourcePath.string()));
+    }
+    const ZstdGuard guard(dctx);
+
+    std::array<char, CHUNK_SIZE> outBuf{};
+    ZSTD_inBuffer input{.src = bytes.data(), .size = bytes.size(), .pos = 0};
+    std::size_t lastResult = 0;
+    for (;;)
+    {
+        poll(baseOffset + input.pos);
+        const std::size_t inputBefore = input.pos;
+        ZSTD_outBuffer output{.dst = outBuf.data(), .size = outBuf.size(), .pos = 0};
+        const std::size_t result = ::ZSTD_decompressStream(dctx, &output, &input);
+        if (::ZSTD_isError(result) != 0U)
+        {
+            throw std::runtime_error(
+                fmt::format(
+                    "zstd decode error on '{}' at input byte {} ({})",
+                    sourcePath.string(),
+                    baseOffset + input.pos,
+                    ::ZSTD_getErrorName(result)
+                )
+            );
+        }
+        sink(outBuf.data(), output.pos);
+        lastResult = result;
+        // With the input used up, keep flushing until the frame ends
+        // or a call makes no progress (truncated frame).
+        const bool progressed = output.pos != 0 || input.pos != inputBefore;
+        if (input.pos == input.size && (result == 0 || !progressed))
+        {
+            break;
+        }
+    }
+    if (lastResult != 0)
+    {
+        throw std::runtime_error(
+            fmt::format(
+                "Unexpected EOF in zstd stream '{}' at input byte {}", sourcePath.string(), baseOffset + input.pos
+            )
+        );
+    }
+}
+
+/// Run @p cut, @p decode, @p write as a serial / parallel / ordered
+/// pipeline of `Run` tokens on a dedicated arena of @p threads.
+template <class Run, class Cut, class Decode, class Write>
+void RunOrderedDecode(unsigned threads, Cut &cut, Decode &decode, Write &write)
+{
+    // A dedicated arena keeps this thread from picking up parser tasks
+    // while it waits: a progressive parse's Stage A blocks on the very
+    // bytes this decode produces.
+    oneapi::tbb::task_arena arena(static_cast<int>(threads));
+    arena.execute([&]() {
+        oneapi::tbb::parallel_pipeline(
+            static_cast<std::size_t>(threads) * PARALLEL_TOKENS_PER_THREAD,
+            oneapi::tbb::make_filter<void, Run>(oneapi::tbb::filter_mode::serial_in_order, cut) &
+                oneapi::tbb::make_filter<Run, Run>(oneapi::tbb::filter_mode::parallel, decode) &
+                oneapi::tbb::make_filter<Run, void>(oneapi::tbb::filter_mode::serial_in_order, write)
+        );
+    });
+}
+
+/// Decode @p input on a dedicated TBB arena of @p threads. The serial
+/// first stage cuts runs of whole frames with @p scan, workers decode
+/// each run into its own buffer with @p decodeSpan, and the ordered
+/// last stage writes the runs out in input order, so the output is
+/// byte-identical to the stream decoders'. A failing run surfaces only
+/// after every run before it is written.
+///
+/// Returns false, having written nothing, unless @p input starts with
+/// a frame @p scan recognises that is shorter than the whole input.
+template <class Scan, class DecodeSpan>
+bool DecodeFramesInParallel(
+    std::span<const std::uint8_t> input,
+    unsigned threads,
+    Scan scan,
+    DecodeSpan decodeSpan,
+    DecodeOutput &out,
+    const std::filesystem::path &sourcePath,
+    const DecompressingByteSource::ProgressCallback &progress,
+    const StopToken &stopToken,
+    std::size_t &decompressedSize,
+    std::size_t maxDecompressedBytes
+)
+{
+    const std::optional<FrameExtent> first = scan(input);
+    if (!first.has_value() || first->compressedBytes >= input.size())
+    {
+        return false;
+    }
+
+    std::size_t cursor = 0;
+    auto cutRun = [&](oneapi::tbb::flow_control &control) -> FrameRun {
+        if (cursor == input.size())
+        {
+            control.stop();
+            return {};
+        }
+        ObservePoll(cursor, input.size(), progress, stopToken);
+        FrameRun run;
+        run.begin = cursor;
+        while (cursor < input.size() && cursor - run.begin < PARALLEL_RUN_BYTES)
+        {
+            const std::optional<FrameExtent> frame = scan(input.subspan(cursor));
+            if (!frame.has_value())
+            {
+                // Truncated or not a delimitable frame: the stream
+                // decoder takes the rest and reports what it finds.
+                if (cursor == run.begin)
+                {
+                    run.streamed = true;
+                    cursor = input.size();
+                }
+                break;
+            }
+            const bool tooLarge = frame->compressedBytes > PARALLEL_MAX_FRAME_BYTES ||
+                                  (frame->decodedBytes != UNKNOWN_FRAME_SIZE &&
+                                   frame->decodedBytes > PARALLEL_MAX_DECODED_FRAME_BYTES);
+            if (tooLarge)
+            {
+                if (cursor == run.begin)
+                {
+                    run.streamed = true;
+                    cursor += frame->compressedBytes;
+                }
+                break;
+            }
+            cursor += frame->compressedBytes;
+            if (frame->decodedBytes != UNKNOWN_FRAME_SIZE)
+            {
+                run.decodedHint += frame->decodedBytes;
+            }
+        }
+        run.end = cursor;
+        return run;
+    };
+
+    // Bytes already written plus everything workers have buffered. Every
+    // buffered run is written unless an earlier one fails first, so once
+    // this passes the cap the output will too; a worker throws there
+    // instead of buffering a run the cap would reject anyway.
+    const std::size_t writtenBefore = decompressedSize;
+    std::atomic<std::size_t> bufferedBytes{0};
+
+    auto decodeRun = [&](FrameRun run) -> FrameRun {
+        if (run.streamed)
+        {
+            return run;
+        }
+        try
+        {
+            std::size_t reserveBytes = run.decodedHint;
+            if (maxDecompressedBytes != 0)
+            {
+                const std::size_t used = writtenBefore + bufferedBytes.load(std::memory_order_relaxed);
+                // One byte past the budget is enough to trip the cap.
+                const std::size_t budget = used < maxDecompressedBytes ? maxDecompressedBytes - used + 1 : 1;
+                reserveBytes = std::min(reserveBytes, budget);
+            }
+            run.decoded.reserve(reserveBytes);
+            decodeSpan(
+                input.subspan(run.begin, run.end - run.begin),
+                run.begin,
+                [&stopToken](std::size_t) {
+                    if (stopToken.stop_requested())
+                    {
+                        throw DecompressionCancelled("decompression cancelled by StopToken");
+                    }
+                },
+                [&](const char *data, std::size_t bytes) {
+                    const std::size_t buffered =
+                        bufferedBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+                    EnforceSizeCap(sourcePath, writtenBefore + buffered, maxDecompressedBytes);
+                    run.decoded.append(data, bytes);
+                }
+            );
+        }
+        catch (...)
+        {
+            run.failure = std::current_exception();
+        }
+        return run;
+    };
+
+    auto writeRun = [&](FrameRun run) {
+        if (run.failure)
+        {
+            std::rethrow_exception(run.failure);
+        }
+        if (run.streamed)
+        {
+            decodeSpan(
+                input.subspan(run.begin, run.end - run.begin),
+                run.begin,
+                [&](std::size_t consumed) { ObservePoll(consumed, input.size(), progress, stopToken); },
+                [&](const char *data, std::size_t bytes) {
+                    WriteOutput(out, data, bytes, sourcePath, decompressedSize, maxDecompressedBytes);
+                }
+            );
+            return;
+        }
+        WriteOutput(out, run.decoded.data(), run.decoded.size(), sourcePath, decompressedSize, maxDecompressedBytes);
+    };
+
+    RunOrderedDecode<FrameRun>(threads, cutRun, decodeRun, writeRun);
+    return true;
+}
+
+/// Inflate @p input from @p from (the start of the input when null)
+/// until @p limit bytes are produced, or to the end of the input when
+/// @p limit is `UNKNOWN_FRAME_SIZE`; later gzip members are followed.
+template <class Poll, class Sink>
+void InflateFromSeekPoint(
+    std::span<const std::uint8_t> input,
+    const GzipSeekPoint *from,
+    std::size_t limit,
+    const std::filesystem::path &sourcePath,
+    Poll &&poll,
+    Sink &&sink
+)
+{
+    constexpr std::size_t GZIP_TRAILER_BYTES = 8; // CRC32, ISIZE
+    z_stream strm{};
+    // A seek point sits inside raw deflate data; its member's trailer
+    // is skipped by hand before the next member's header.
+    bool raw = from != nullptr;
+    if (::inflateInit2(&strm, raw ? -15 : 15 + 16) != Z_OK)
+    {
+        throw std::runtime_error(fmt::format("Failed to init zlib inflate for '{}'", sourcePath.string()));
+    }
+    const ZlibGuard guard(&strm);
+
+    std::size_t pos = 0;
+    if (from != nullptr)
+    {
+        pos = static_cast<std::size_t>(from->compressedOffset);
+        if (from->bits != 0 &&
+            ::inflatePrime(&strm, from->bits, input[pos - 1] >> (CHAR_BIT - from->bits)) != Z_OK)
+        {
+            throw std::runtime_error(fmt::format("zlib inflatePrime failed on '{}'", sourcePath.string()));
+        }
+        if (::inflateSetDictionary(&strm, from->window.data(), static_cast<uInt>(from->window.size())) != Z_OK)
+        {
+            throw std::runtime_error(fmt::format("zlib inflateSetDictionary failed on '{}'", sourcePath.string()));
+        }
+    }
+
+    std::array<Bytef, CHUNK_SIZE> outBuf{};
+    std::size_t produced = 0;
+    int ret = Z_OK;
+    while (produced != limit)
+    {
+        if (ret == Z_STREAM_END)
+        {
+            if (raw)
+            {
+                pos += GZIP_TRAILER_BYTES;
+                raw = false;
+            }
+            if (pos >= input.size())
+            {
+                break;
+            }
+            if (::inflateReset2(&strm, 15 + 16) != Z_OK)
+            {
+                throw std::runtime_error(
+                    fmt::format("zlib inflateReset failed on '{}' at input byte {}", sourcePath.string(), pos)
+                );
+            }
+        }
+        if (pos >= input.size())
+        {
+            break;
+        }
+        poll(pos);
+        const std::size_t slice = std::min(input.size() - pos, CHUNK_SIZE);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        strm.next_in = const_cast<Bytef *>(input.data() + pos);
+        strm.avail_in = static_cast<uInt>(slice);
+        strm.next_out = outBuf.data();
+        strm.avail_out = static_cast<uInt>(std::min(outBuf.size(), limit - produced));
+        ret = ::inflate(&strm, Z_NO_FLUSH);
+        switch (ret)
+        {
+        case Z_NEED_DICT:
+        case Z_DATA_ERROR:
+        case Z_MEM_ERROR:
+        case Z_STREAM_ERROR:
+            throw std::runtime_error(
+                fmt::format("zlib inflate error on '{}' at input byte {} (code {})", sourcePath.string(), pos, ret)
+            );
+        default:
+            break;
+        }
+        pos += slice - strm.avail_in;
+        const std::size_t bytes = static_cast<std::size_t>(strm.next_out - outBuf.data());
+        sink(reinterpret_cast<const char *>(outBuf.data()), bytes);
+        produced += bytes;
+    }
+    const bool complete = limit == UNKNOWN_FRAME_SIZE ? ret == Z_STREAM_END && !raw : produced == limit;
+    if (!complete)
+    {
+        throw std::runtime_error(
+            fmt::format("Unexpected EOF in gzip stream '{}' at input byte {}", sourcePath.string(), pos)
+        );
+    }
+}
+
+/// Pipeline token of an indexed gzip decode: the span between seek
+/// points `segment - 1` and `segment` (the input start and end at the
+/// edges) and, once decoded, its bytes or failure.
+struct SeekRun
+{
+    std::size_t segment = 0;
+    std::string decoded;
+    std::exception_ptr failure;
+};
+
+/// Decode @p input across @p threads using the restart points of
+/// @p index, which must describe these exact bytes. Ordering and
+/// error surfacing match `DecodeFramesInParallel`.
+void DecodeIndexedGzipInParallel(
+    std::span<const std::uint8_t> input,
+    const GzipSeekIndex &index,
+    unsigned threads,
+    DecodeOutput &out,
+    const std::filesystem::path &sourcePath,
+    const DecompressingByteSource::ProgressCallback &progress,
+    const StopToken &stopToken,
+    std::size_t &decompressedSize,
+    std::size_t maxDecompressedBytes
+)
+{
+    const std::vector<GzipSeekPoint> &points = index.points;
+    const auto segmentStart = [&points](std::size_t segment) -> const GzipSeekPoint * {
+        return segment == 0 ? nullptr : &points[segment - 1];
+    };
+    const auto segmentLimit = [&points](std::size_t segment) -> std::size_t {
+        if (segment == points.size())
+        {
+            return UNKNOWN_FRAME_SIZE;
+        }
+        const std::uint64_t begin = segment == 0 ? 0 : points[segment - 1].decodedOffset;
+        return static_cast<std::size_t>(points[segment].decodedOffset - begin);
+    };
+
+    std::size_t nextSegment = 0;
+    auto cutRun = [&](oneapi::tbb::flow_control &control) -> SeekRun {
+        if (nextSegment > points.size())
+        {
+            control.stop();
+            return {};
+        }
+        return SeekRun{.segment = nextSegment++, .decoded = {}, .failure = {}};
+    };
+
+    auto decodeRun = [&](SeekRun run) -> SeekRun {
+        try
+        {
+            const std::size_t limit = segmentLimit(run.segment);
+            if (limit != UNKNOWN_FRAME_SIZE)
+            {
+                run.decoded.reserve(limit);
+            }
+            InflateFromSeekPoint(
+                input,
+                segmentStart(run.segment),
+                limit,
+                sourcePath,
+                [&stopToken](std::size_t) {
+                    if (stopToken.stop_requested())
+                    {
+                        throw DecompressionCancelled("decompression cancelled by StopToken");
+                    }
+                },
+                [&run](const char *data, std::size_t bytes) { run.decoded.append(data, bytes); }
+            );
+        }
+        catch (...)
+        {
+            run.failure = std::current_exception();
+        }
+        return run;
+    };
+
+    auto writeRun = [&](SeekRun run) {
+        if (run.failure)
+        {
+            std::rethrow_exception(run.failure);
+        }
+        WriteOutput(out, run.decoded.data(), run.decoded.size(), sourcePath, decompressedSize, maxDecompressedBytes);
+        const std::size_t consumed =
+            run.segment < points.size() ? static_cast<std::size_t>(points[run.segment].compressedOffset) : input.size();
+        ObservePoll(consumed, input.size(), progress, stopToken);
+    };
+
+    RunOrderedDecode<SeekRun>(threads, cutRun, decodeRun, writeRun);
+}
+
+/// Decode multi-frame zstd, BGZF gzip, and gzip with a valid seek
+/// index across threads. False when none applies or only one thread is
+/// allowed; nothing has been written then and the caller streams. For
+/// gzip with `Options::seekIndexDir` set, @p indexToRecord is then
+/// primed with the input's identity for the serial decode to fill.
+bool TryDecodeInParallel(
+    DecompressingByteSource::Codec codec,
+    DecodeOutput &out,
+    const std::filesystem::path &sourcePath,
+    const DecompressingByteSource::ProgressCallback &progress,
+    const StopToken &stopToken,
+    std::size_t &decompressedSize,
+    const DecompressingByteSource::Options &options,
+    std::optional<GzipSeekIndex> &indexToRecord
+)
+{
+    using Codec = DecompressingByteSource::Codec;
+    // The metadata-line split lives in `DecodeZstd`; bundles stay serial.
+    if (options.discardFirstLine || (codec != Codec::Gzip && codec != Codec::Zstd))
+    {
+        return false;
+    }
+    const unsigned threads = options.decodeThreads != 0
+                                 ? options.decodeThreads
+                                 : static_cast<unsigned>(oneapi::tbb::info::default_concurrency());
+    // A single-threaded open still records the index for later ones.
+    const bool useSeekIndex = codec == Codec::Gzip && !options.seekIndexDir.empty();
+    if (threads < 2 && !useSeekIndex)
+    {
+        return false;
+    }
+
+    std::error_code ec;
+#ifdef _WIN32
+    const mio::mmap_source mapped = mio::make_mmap_source(sourcePath.wstring(), 0, mio::map_entire_file, ec);
+#else
+    const mio::mmap_source mapped = mio::make_mmap_source(PathToUtf8(sourcePath), 0, mio::map_entire_file, ec);
+#endif
+    if (ec || mapped.size() == 0)
+    {
+        return false;
+    }
+    const std::span<const std::uint8_t> input(reinterpret_cast<const std::uint8_t *>(mapped.data()), mapped.size());
+
+    if (codec == Codec::Gzip)
+    {
+        if (ScanBgzfBlock(input).has_value())
+        {
+            // BGZF needs no index: every block is its own member.
+            const auto inflateSpan =
+                [&sourcePath](std::span<const std::uint8_t> bytes, std::size_t baseOffset, auto &&poll, auto &&sink) {
+                    InflateMembers(bytes, baseOffset, sourcePath, poll, sink);
+                };
+            return threads >= 2 && DecodeFramesInParallel(
+                                       input,
+                                       threads,
+                                       &ScanBgzfBlock,
+                                       inflateSpan,
+                                       out,
+                                       sourcePath,
+                                       progress,
+                                       stopToken,
+                                       decompressedSize,
+                                       options.maxDecompressedBytes
+                                   );
+        }
+        if (!useSeekIndex)
+        {
+            return false;
+        }
+        const std::uint64_t fingerprint = SeekIndexFingerprint(input);
+        if (threads >= 2)
+        {
+            const std::optional<GzipSeekIndex> index = LoadGzipSeekIndex(options.seekIndexDir, sourcePath, fingerprint);
+            if (index.has_value() && !index->points.empty())
+            {
+                DecodeIndexedGzipInParallel(
+                    input,
+                    *index,
+                    threads,
+                    out,
+                    sourcePath,
+                    progress,
+                    stopToken,
+                    decompressedSize,
+                    options.maxDecompressedBytes
+                );
+                return true;
+            }
+        }
+        indexToRecord.emplace();
+        indexToRecord->compressedSize = input.size();
+        indexToRecord->fingerprint = fingerprint;
+        return false;
+    }
+    if (threads < 2)
+    {
+        return false;
+    }
+    return DecodeFramesInParallel(
+        input,
+        threads,
+        &ScanZstdFrame,
+        [&sourcePath](std::span<const std::uint8_t> bytes, std::size_t baseOffset, auto &&poll, auto &&sink) {
+            DecompressZstdFrames(bytes, baseOffset, sourcePath, poll, sink);
+        },
+        out,
+        sourcePath,
+        progress,
+        stopToken,
+        decompressedSize,
+        options.maxDecompressedBytes
+    );
+}
+
+/// Run the decoder for @p codec over all of @p in.
+void DecodeStream(
+    DecompressingByteSource::Codec codec,
+    std::ifstream &in,
+    DecodeOutput &out,
+    const std::filesystem::path &sourcePath,
+    std::size_t totalBytesIn,
+    const DecompressingByteSource::ProgressCallback &progress,
+    const StopToken &stopToken,
+    std::size_t &decompressedSize,
+    const DecompressingByteSource::Options &options,
+    std::string &discardedFirstLine
+)
+{
+    using Codec = DecompressingByteSource::Codec;
+    std::optional<GzipSeekIndex> indexToRecord;
+    if (TryDecodeInParallel(codec, out, sourcePath, progress, stopToken, decompressedSize, options, indexToRecord))
+    {
+        return;
+    }
+    const std::size_t maxDecompressedBytes = options.maxDecompressedBytes;
+    switch (codec)
+    {
+    case Codec::Gzip:
+        DecodeGzip(
+            in,
+            out,
+            sourcePath,
+            totalBytesIn,
+            progress,
+            stopToken,
+            decompressedSize,
+            maxDecompressedBytes,
+            indexToRecord.has_value() ? &*indexToRecord : nullptr,
+            options.seekPointSpacingBytes
+        );
+        // Only a clean decode reaches here; a file with no interior
+        // block boundary has nothing worth saving.
+        if (indexToRecord.has_value() && !indexToRecord->points.empty())
+        {
+            indexToRecord->decodedSize = decompressedSize;
+            SaveGzipSeekIndex(options.seekIndexDir, sourcePath, *indexToRecord);
+        }
+        break;
+    case Codec::Bzip2:
+        DecodeBzip2(
+            in, out, sourcePath, totalBytesIn, progress, stopToken, decompressedSize, maxDecompressedBytes
+        );
+        break;
+    case Codec::Xz:
+        DecodeXz(in, out, sourcePath, totalBytesIn, progress, stopToken, decompressedSize, maxDecompressedBytes);
+        break;
+    case Codec::Zstd:
+        DecodeZstd(
+            in,
+            out,
+            sourcePath,
+            totalBytesIn,
+            progress,
+            stopToken,
+            decompressedSize,
+            maxDecompressedBytes,
+            options.discardFirstLine,
+            options.maxDiscardedFirstLineBytes,
+            discardedFirstLine
+        );
+        break;
+    case Codec::None:
+        // Callers pass through plain input; enumerated for -Wswitch.
+        break;
+    }
+}
+
+/// Reserve the output buffer for a progressive decode, or null when
+/// this platform or address space cannot host one.
+[[nodiscard]] std::shared_ptr<GrowingByteBuffer> TryReserveProgressiveBuffer(
+    const DecompressingByteSource::Options &options
+) noexcept
+{
+    if (!GrowingByteBuffer::IsSupported())
+    {
+        return nullptr;
+    }
+    // The cap check runs after each chunk lands, so leave one chunk
+    // of slack past it; `Append` must not be what trips first.
+    const std::size_t capacity = options.maxDecompressedBytes != 0
+                                     ? options.maxDecompressedBytes + CHUNK_SIZE
+                                     : DecompressingByteSource::UNCAPPED_PROGRESSIVE_RESERVATION_BYTES;
+    const std::size_t inMemory = options.maxInMemoryBytes != 0
+                                     ? options.maxInMemoryBytes
+                                     : static_cast<std::size_t>(QuarterOfPhysicalMemory());
+    try
+    {
+        return std::make_shared<GrowingByteBuffer>(capacity, inMemory);
+    }
+    catch (const std::exception &)
+    {
+        return nullptr;
+    }
+}
+
 } // namespace
 
+/// Worker thread of a progressive decode. Appends into the shared
+/// buffer until the stream ends, the decoder fails, or a reader calls
+/// `GrowingByteBuffer::RequestStop`; the outcome lands in
+/// `GrowingByteBuffer::Finish` either way.
+class DecompressingByteSource::ProgressiveDecode
+{
+public:
+    ProgressiveDecode(
+        std::ifstream in,
+        std::shared_ptr<GrowingByteBuffer> buffer,
+        std::filesystem::path sourcePath,
+        Codec codec,
+        std::size_t compressedSize,
+        ProgressCallback progress,
+        const Options &options
+    )
+        : mIn(std::move(in)),
+          mBuffer(std::move(buffer)),
+          mSourcePath(std::move(sourcePath)),
+          mCodec(codec),
+          mCompressedSize(compressedSize),
+          mOptions(options),
+          mProgress(std::move(progress)),
+          mThread([this] { Run(); })
+    {
+    }
+
+    ~ProgressiveDecode()
+    {
+        Stop();
+    }
+
+    ProgressiveDecode(const ProgressiveDecode &) = delete;
+    ProgressiveDecode &operator=(const ProgressiveDecode &) = delete;
+    ProgressiveDecode(ProgressiveDecode &&) = delete;
+    ProgressiveDecode &operator=(ProgressiveDecode &&) = delete;
+
+    [[nodiscard]] const std::shared_ptr<GrowingByteBuffer> &Buffer() const noexcept
+    {
+        return mBuffer;
+    }
+
+    /// Stop forwarding progress. The caller's callback may capture
+    /// state that does not outlive the constructor's caller.
+    void MuteProgress()
+    {
+        const std::scoped_lock lock(mProgressMutex);
+        mProgress = nullptr;
+    }
+
+    /// Wait for the worker to exit and return its failure, if any.
+    [[nodiscard]] std::exception_ptr Join()
+    {
+        if (mThread.joinable())
+        {
+            mThread.join();
+        }
+        return mFailure;
+    }
+
+    void Stop() noexcept
+    {
+        mBuffer->RequestStop();
+        if (mThread.joinable())
+        {
+            mThread.join();
+        }
+    }
+
+private:
+    void Run() noexcept
+    {
+        try
+        {
+            BufferOutput out(*mBuffer);
+            const ProgressCallback progress = [this](const Progress &p) {
+                const std::scoped_lock lock(mProgressMutex);
+                if (mProgress)
+                {
+                    mProgress(p);
+                }
+            };
+            std::size_t decompressedSize = 0;
+            std::string unusedFirstLine;
+            // Cancellation arrives through `BufferOutput`, which sees
+            // the buffer's stop flag after every decoder step.
+            DecodeStream(
+                mCodec, mIn, out, mSourcePath, mCompressedSize, progress, StopToken{}, decompressedSize, mOptions,
+                unusedFirstLine
+            );
+            mBuffer->Finish();
+        }
+        catch (const std::exception &e)
+        {
+            mFailure = std::current_exception();
+            mBuffer->Finish(e.what());
+        }
+        catch (...)
+        {
+            mFailure = std::current_exception();
+            mBuffer->Finish("unknown decompression error");
+        }
+    }
+
+    std::ifstream mIn;
+    std::shared_ptr<GrowingByteBuffer> mBuffer;
+    std::filesystem::path mSourcePath;
+    Codec mCodec;
+    std::size_t mCompressedSize;
+    Options mOptions;
+    std::mutex mProgressMutex;
+    ProgressCallback mProgress;
+    /// Written by the worker before `Finish`; read after `Join`.
+    std::exception_ptr mFailure;
+    /// Last: starts running once everything above is constructed.
+    std::thread mThread;
+};
+
 DecompressingByteSource::DecompressingByteSource(
     std::filesystem::path input, const ProgressCallback &progress, const StopToken &stopToken
 )
@@ -863,7 +1904,6 @@ DecompressingByteSource::DecompressingByteSource(
 )
     : mDisplayPath(std::move(input)), mEffectivePath(mDisplayPath)
 {
-    const std::size_t maxDecompressedBytes = options.maxDecompressedBytes;
     std::error_code ec;
     // MSVC's <filesystem> flag-cast trips clang-analyzer's enum-cast check.
     // NOLINTNEXTLINE(clang-analyzer-optin.core.EnumCastOutOfRange)
@@ -925,13 +1965,24 @@ DecompressingByteSource::DecompressingByteSource(
         );
     }
 
-    // Decode to an owned temp file and remove it on failure.
     std::ifstream inStream(mDisplayPath, std::ios::binary);
     if (!inStream.is_open())
     {
         throw std::runtime_error(fmt::format("Failed to open '{}' for decompression", mDisplayPath.string()));
     }
 
+    // Bundles need the metadata line before the caller proceeds, so
+    // they always take the temp-file path.
+    if (options.progressive && !options.discardFirstLine)
+    {
+        if (std::shared_ptr<GrowingByteBuffer> buffer = TryReserveProgressiveBuffer(options))
+        {
+            StartProgressive(std::move(inStream), std::move(buffer), progress, stopToken, options);
+            return;
+        }
+    }
+
+    // Decode to an owned temp file and remove it on failure.
     try
     {
         std::filesystem::path tempPath;
@@ -941,67 +1992,19 @@ DecompressingByteSource::DecompressingByteSource(
         mEffectivePath = tempPath;
         mOwnsTempFile = true;
 
-        switch (mCodec)
-        {
-        case Codec::Gzip:
-            DecodeGzip(
-                inStream,
-                outHandle,
-                mDisplayPath,
-                tempPath,
-                mCompressedSize,
-                progress,
-                stopToken,
-                mDecompressedSize,
-                maxDecompressedBytes
-            );
-            break;
-        case Codec::Bzip2:
-            DecodeBzip2(
-                inStream,
-                outHandle,
-                mDisplayPath,
-                tempPath,
-                mCompressedSize,
-                progress,
-                stopToken,
-                mDecompressedSize,
-                maxDecompressedBytes
-            );
-            break;
-        case Codec::Xz:
-            DecodeXz(
-                inStream,
-                outHandle,
-                mDisplayPath,
-                tempPath,
-                mCompressedSize,
-                progress,
-                stopToken,
-                mDecompressedSize,
-                maxDecompressedBytes
-            );
-            break;
-        case Codec::Zstd:
-            DecodeZstd(
-                inStream,
-                outHandle,
-                mDisplayPath,
-                tempPath,
-                mCompressedSize,
-                progress,
-                stopToken,
-                mDecompressedSize,
-                maxDecompressedBytes,
-                options.discardFirstLine,
-                options.maxDiscardedFirstLineBytes,
-                mDiscardedFirstLine
-            );
-            break;
-        case Codec::None:
-            // Handled above; enumerated here for -Wswitch.
-            break;
-        }
+        TempFileOutput out(outHandle, tempPath);
+        DecodeStream(
+            mCodec,
+            inStream,
+            out,
+            mDisplayPath,
+            mCompressedSize,
+            progress,
+            stopToken,
+            mDecompressedSize,
+            options,
+            mDiscardedFirstLine
+        );
         // Explicit flush so partial-write failures surface here
         // rather than at destructor time.
         if (std::fflush(outHandle.Get()) != 0)
@@ -1022,6 +2025,40 @@ DecompressingByteSource::DecompressingByteSource(
     }
 }
 
+void DecompressingByteSource::StartProgressive(
+    std::ifstream in,
+    std::shared_ptr<GrowingByteBuffer> buffer,
+    const ProgressCallback &progress,
+    const StopToken &stopToken,
+    const Options &options
+)
+{
+    GrowingByteBuffer &bytes = *buffer;
+    mProgressive = std::make_unique<ProgressiveDecode>(
+        std::move(in), std::move(buffer), mDisplayPath, mCodec, mCompressedSize, progress, options
+    );
+    // Hand over once there is enough for format detection and a first
+    // batch, or the stream ended early. A stop before then is still
+    // this constructor's cancellation.
+    (void)bytes.WaitForGrowth(PROGRESSIVE_READY_BYTES - 1, stopToken);
+    if (stopToken.stop_requested())
+    {
+        mProgressive.reset();
+        throw DecompressionCancelled("decompression cancelled by StopToken");
+    }
+    if (bytes.IsComplete())
+    {
+        // Small or corrupt inputs fail here exactly like the temp-file
+        // path, instead of surfacing later as a parse error.
+        if (const std::exception_ptr failure = mProgressive->Join())
+        {
+            mProgressive.reset();
+            std::rethrow_exception(failure);
+        }
+    }
+    mProgressive->MuteProgress();
+}
+
 DecompressingByteSource::~DecompressingByteSource()
 {
     ReleaseTempFile();
@@ -1034,7 +2071,8 @@ DecompressingByteSource::DecompressingByteSource(DecompressingByteSource &&other
       mCompressedSize(other.mCompressedSize),
       mDecompressedSize(other.mDecompressedSize),
       mOwnsTempFile(other.mOwnsTempFile),
-      mDiscardedFirstLine(std::move(other.mDiscardedFirstLine))
+      mDiscardedFirstLine(std::move(other.mDiscardedFirstLine)),
+      mProgressive(std::move(other.mProgressive))
 {
     other.mCodec = Codec::None;
     other.mCompressedSize = 0;
@@ -1054,6 +2092,7 @@ DecompressingByteSource &DecompressingByteSource::operator=(DecompressingByteSou
         mDecompressedSize = other.mDecompressedSize;
         mOwnsTempFile = other.mOwnsTempFile;
         mDiscardedFirstLine = std::move(other.mDiscardedFirstLine);
+        mProgressive = std::move(other.mProgressive);
         other.mCodec = Codec::None;
         other.mCompressedSize = 0;
         other.mDecompressedSize = 0;
@@ -1101,7 +2140,17 @@ std::size_t DecompressingByteSource::CompressedSize() const noexcept
 
 std::size_t DecompressingByteSource::DecompressedSize() const noexcept
 {
-    return mDecompressedSize;
+    return mProgressive ? mProgressive->Buffer()->Size() : mDecompressedSize;
+}
+
+bool DecompressingByteSource::IsProgressive() const noexcept
+{
+    return mProgressive != nullptr;
+}
+
+std::shared_ptr<GrowingByteBuffer> DecompressingByteSource::ProgressiveBuffer() const noexcept
+{
+    return mProgressive ? mProgressive->Buffer() : nullptr;
 }
 
 const std::string &DecompressingByteSource::DiscardedFirstLine() const noexcept
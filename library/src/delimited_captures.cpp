@@ -0,0 +1,237 @@
+#include "loglib/internal/delimited_captures.hpp"
+
+#include <cstddef>
+#include <cstring>
+
+namespace loglib::internal
+{
+
+namespace
+{
+
+/// Cursor over the pattern text with the few token readers the
+/// recogniser needs.
+class PatternReader
+{
+public:
+    explicit PatternReader(std::string_view text)
+        : mText(text)
+    {
+    }
+
+    [[nodiscard]] bool AtEnd() const noexcept
+    {
+        return mPos >= mText.size();
+    }
+
+    bool Consume(std::string_view token) noexcept
+    {
+        if (mText.substr(mPos).starts_with(token))
+        {
+            mPos += token.size();
+            return true;
+        }
+        return false;
+    }
+
+    /// `(?<name>`; PCRE2 already validated the name itself.
+    bool ConsumeGroupOpen() noexcept
+    {
+        if (!Consume("(?<") || AtEnd() || !IsNameStart(mText[mPos]))
+        {
+            return false;
+        }
+        while (!AtEnd() && IsNameChar(mText[mPos]))
+        {
+            ++mPos;
+        }
+        return Consume(">");
+    }
+
+    /// One literal byte: `\t`, a backslash-escaped punctuation byte, or
+    /// a plain byte outside @p special.
+    std::optional<char> ConsumeLiteral(std::string_view special) noexcept
+    {
+        if (AtEnd())
+        {
+            return std::nullopt;
+        }
+        const char c = mText[mPos];
+        if (c == '\\')
+        {
+            if (mPos + 1 >= mText.size())
+            {
+                return std::nullopt;
+            }
+            const char escaped = mText[mPos + 1];
+            if (escaped == 't')
+            {
+                mPos += 2;
+                return '\t';
+            }
+            // Escaped letters and digits are classes, back references, or
+            // other escapes with meaning; only punctuation is literal.
+            if (IsNameChar(escaped) || static_cast<unsigned char>(escaped) < 0x21 ||
+                static_cast<unsigned char>(escaped) > 0x7e)
+            {
+                return std::nullopt;
+            }
+            mPos += 2;
+            return escaped;
+        }
+        if (special.find(c) != std::string_view::npos)
+        {
+            return std::nullopt;
+        }
+        ++mPos;
+        return c;
+    }
+
+private:
+    static bool IsNameStart(char c) noexcept
+    {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '_';
+    }
+
+    static bool IsNameChar(char c) noexcept
+    {
+        return IsNameStart(c) || (c >= '0' && c <= '9');
+    }
+
+    std::string_view mText;
+    size_t mPos = 0;
+};
+
+/// Bytes with a meaning outside a character class.
+constexpr std::string_view PATTERN_SPECIALS = "\\^$.|?*+()[]{}";
+/// Bytes with a meaning inside `[^...]` (a leading `-` is literal in
+/// PCRE2, but is rejected to keep the grammar trivial).
+constexpr std::string_view CLASS_SPECIALS = "\\]^-[";
+
+} // namespace
+
+std::optional<DelimitedCapturePattern> RecognizeDelimitedCapturePattern(std::string_view pattern)
+{
+    // `^...$` with the body ending in `)`, so the `$` is never an
+    // escaped literal.
+    if (!pattern.starts_with('^') || !pattern.ends_with(")$"))
+    {
+        return std::nullopt;
+    }
+    PatternReader reader(pattern.substr(1, pattern.size() - 2));
+
+    DelimitedCapturePattern result;
+    std::optional<char> delimiter;
+    for (;;)
+    {
+        if (!reader.ConsumeGroupOpen())
+        {
+            return std::nullopt;
+        }
+
+        DelimitedField field{};
+        if (reader.Consume("[^"))
+        {
+            const std::optional<char> excluded = reader.ConsumeLiteral(CLASS_SPECIALS);
+            if (!excluded || !reader.Consume("]") || (delimiter && *delimiter != *excluded))
+            {
+                return std::nullopt;
+            }
+            delimiter = excluded;
+            if (reader.Consume("*"))
+            {
+                field = DelimitedField::UntilDelimiter;
+            }
+            else if (reader.Consume("+"))
+            {
+                field = DelimitedField::UntilDelimiterNonEmpty;
+            }
+            else
+            {
+                return std::nullopt;
+            }
+        }
+        else if (reader.Consume(".*"))
+        {
+            field = DelimitedField::Rest;
+        }
+        else if (reader.Consume(".+"))
+        {
+            field = DelimitedField::RestNonEmpty;
+        }
+        else
+        {
+            return std::nullopt;
+        }
+        // A lazy or possessive suffix changes the semantics.
+        if (!reader.Consume(")"))
+        {
+            return std::nullopt;
+        }
+        result.fields.push_back(field);
+
+        if (reader.AtEnd())
+        {
+            break;
+        }
+        if (field == DelimitedField::Rest || field == DelimitedField::RestNonEmpty)
+        {
+            return std::nullopt;
+        }
+        const std::optional<char> separator = reader.ConsumeLiteral(PATTERN_SPECIALS);
+        if (!separator || *separator != *delimiter)
+        {
+            return std::nullopt;
+        }
+    }
+
+    result.delimiter = delimiter.value_or('\0');
+    return result;
+}
+
+bool SplitDelimitedCaptures(
+    const DelimitedCapturePattern &pattern, std::string_view line, std::vector<std::string_view> &captures
+)
+{
+    captures.clear();
+    size_t pos = 0;
+    for (size_t i = 0; i < pattern.fields.size(); ++i)
+    {
+        const DelimitedField field = pattern.fields[i];
+        const bool last = i + 1 == pattern.fields.size();
+        const std::string_view rest = line.substr(pos);
+
+        size_t end = 0;
+        if (field == DelimitedField::Rest || field == DelimitedField::RestNonEmpty)
+        {
+            if (std::memchr(rest.data(), '\n', rest.size()) != nullptr ||
+                std::memchr(rest.data(), '\r', rest.size()) != nullptr)
+            {
+                return false;
+            }
+            end = line.size();
+        }
+        else
+        {
+            const auto *found = static_cast<const char *>(std::memchr(rest.data(), pattern.delimiter, rest.size()));
+            // The last field runs to `$`, so it must not hold a delimiter;
+            // every other field must be closed by one.
+            if (last != (found == nullptr))
+            {
+                return false;
+            }
+            end = found != nullptr ? pos + static_cast<size_t>(found - rest.data()) : line.size();
+        }
+
+        const bool nonEmpty = field == DelimitedField::UntilDelimiterNonEmpty || field == DelimitedField::RestNonEmpty;
+        if (nonEmpty && end == pos)
+        {
+            return false;
+        }
+        captures.push_back(line.substr(pos, end - pos));
+        pos = end + 1;
+    }
+    return true;
+}
+
+} // namespace loglib::internal
@@ -0,0 +1,317 @@
+#include "loglib/internal/enum_posting_index.hpp"
+
+#include "loglib/internal/sidecar_io.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <span>
+#include <utility>
+
+namespace loglib::internal
+{
+
+void RowIdSet::Append(uint64_t id)
+{
+    const uint64_t key = id >> CHUNK_BITS;
+    const auto low = static_cast<uint16_t>(id & ((uint64_t{1} << CHUNK_BITS) - 1U));
+    if (mChunks.empty() || mChunks.back().key != key)
+    {
+        mChunks.emplace_back().key = key;
+    }
+    Chunk &chunk = mChunks.back();
+    if (chunk.bitmap.empty())
+    {
+        chunk.array.push_back(low);
+        if (chunk.array.size() > ARRAY_MAX_ENTRIES)
+        {
+            ConvertToBitmap(chunk);
+        }
+    }
+    else
+    {
+        chunk.bitmap[low / 64U] |= uint64_t{1} << (low % 64U);
+    }
+    ++chunk.count;
+    ++mCount;
+}
+
+void RowIdSet::ConvertToBitmap(Chunk &chunk)
+{
+    chunk.bitmap.assign(BITMAP_WORDS, 0U);
+    for (const uint16_t low : chunk.array)
+    {
+        chunk.bitmap[low / 64U] |= uint64_t{1} << (low % 64U);
+    }
+    std::vector<uint16_t>().swap(chunk.array);
+}
+
+void RowIdSet::EraseBelow(uint64_t id)
+{
+    const uint64_t key = id >> CHUNK_BITS;
+    // Whole chunks below the cut go in one erase.
+    const auto firstKept = std::ranges::find_if(mChunks, [key](const Chunk &chunk) { return chunk.key >= key; });
+    for (auto it = mChunks.begin(); it != firstKept; ++it)
+    {
+        mCount -= it->count;
+    }
+    mChunks.erase(mChunks.begin(), firstKept);
+    if (mChunks.empty() || mChunks.front().key != key)
+    {
+        return;
+    }
+
+    // The cut falls inside the front chunk: trim its head.
+    Chunk &chunk = mChunks.front();
+    const auto low = static_cast<uint16_t>(id & ((uint64_t{1} << CHUNK_BITS) - 1U));
+    size_t dropped = 0;
+    if (chunk.bitmap.empty())
+    {
+        const auto cut = std::ranges::lower_bound(chunk.array, low);
+        dropped = static_cast<size_t>(std::distance(chunk.array.begin(), cut));
+        chunk.array.erase(chunk.array.begin(), cut);
+    }
+    else
+    {
+        const size_t fullWords = low / 64U;
+        for (size_t word = 0; word < fullWords; ++word)
+        {
+            dropped += static_cast<size_t>(std::popcount(chunk.bitmap[word]));
+            chunk.bitmap[word] = 0U;
+        }
+        if (const size_t tail = low % 64U; tail != 0)
+        {
+            const uint64_t mask = (uint64_t{1} << tail) - 1U;
+            dropped += static_cast<size_t>(std::popcount(chunk.bitmap[fullWords] & mask));
+            chunk.bitmap[fullWords] &= ~mask;
+        }
+    }
+    chunk.count -= static_cast<uint32_t>(dropped);
+    mCount -= dropped;
+    if (chunk.count == 0)
+    {
+        mChunks.erase(mChunks.begin());
+    }
+}
+
+void RowIdSet::Clear() noexcept
+{
+    mChunks.clear();
+    mCount = 0;
+}
+
+size_t RowIdSet::MemoryBytes() const noexcept
+{
+    size_t bytes = mChunks.capacity() * sizeof(Chunk);
+    for (const Chunk &chunk : mChunks)
+    {
+        bytes += (chunk.array.capacity() * sizeof(uint16_t)) + (chunk.bitmap.capacity() * sizeof(uint64_t));
+    }
+    return bytes;
+}
+
+void RowIdSet::Write(SidecarWriter &writer) const
+{
+    // Per chunk: key u64, count u32, bitmap flag u8, then the sorted
+    // low halves or the `BITMAP_WORDS` words.
+    writer.Put(static_cast<uint32_t>(mChunks.size()));
+    for (const Chunk &chunk : mChunks)
+    {
+        writer.Put(chunk.key);
+        writer.Put(chunk.count);
+        writer.Put(static_cast<uint8_t>(chunk.bitmap.empty() ? 0U : 1U));
+        if (chunk.bitmap.empty())
+        {
+            writer.PutArray(std::span<const uint16_t>(chunk.array));
+        }
+        else
+        {
+            writer.PutArray(std::span<const uint64_t>(chunk.bitmap));
+        }
+    }
+}
+
+bool RowIdSet::Read(SidecarReader &reader)
+{
+    Clear();
+    uint32_t chunkCount = 0;
+    if (!reader.Get(chunkCount))
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < chunkCount; ++i)
+    {
+        Chunk chunk;
+        uint8_t isBitmap = 0;
+        if (!reader.Get(chunk.key) || !reader.Get(chunk.count) || !reader.Get(isBitmap) || chunk.count == 0 ||
+            chunk.count > (uint32_t{1} << CHUNK_BITS) || (!mChunks.empty() && chunk.key <= mChunks.back().key))
+        {
+            Clear();
+            return false;
+        }
+        bool valid = false;
+        if (isBitmap == 0U)
+        {
+            chunk.array.resize(chunk.count);
+            valid = chunk.count <= ARRAY_MAX_ENTRIES && reader.GetArray(std::span<uint16_t>(chunk.array)) &&
+                    std::ranges::is_sorted(chunk.array) &&
+                    std::ranges::adjacent_find(chunk.array) == chunk.array.end();
+        }
+        else
+        {
+            chunk.bitmap.resize(BITMAP_WORDS);
+            valid = reader.GetArray(std::span<uint64_t>(chunk.bitmap));
+            size_t bits = 0;
+            for (const uint64_t word : chunk.bitmap)
+            {
+                bits += static_cast<size_t>(std::popcount(word));
+            }
+            valid = valid && bits == chunk.count;
+        }
+        if (!valid)
+        {
+            Clear();
+            return false;
+        }
+        mCount += chunk.count;
+        mChunks.push_back(std::move(chunk));
+    }
+    return true;
+}
+
+void EnumPostingIndex::Append(EnumValueId id)
+{
+    if (id != INVALID_ENUM_VALUE_ID)
+    {
+        const auto slot = static_cast<size_t>(id);
+        if (slot >= mLists.size())
+        {
+            mLists.resize(slot + 1);
+        }
+        mLists[slot].Append(mFirstId + mSize);
+    }
+    ++mSize;
+}
+
+void EnumPostingIndex::EraseFront(size_t count)
+{
+    if (count >= mSize)
+    {
+        Clear();
+        return;
+    }
+    mFirstId += count;
+    mSize -= count;
+    for (RowIdSet &list : mLists)
+    {
+        list.EraseBelow(mFirstId);
+    }
+}
+
+void EnumPostingIndex::Clear() noexcept
+{
+    mLists.clear();
+    // Keep `mFirstId`: ids only need to be unique within one build.
+    mSize = 0;
+}
+
+size_t EnumPostingIndex::RowCount(EnumValueId id) const noexcept
+{
+    const auto slot = static_cast<size_t>(id);
+    return slot < mLists.size() ? mLists[slot].Count() : 0;
+}
+
+size_t EnumPostingIndex::MemoryBytes() const noexcept
+{
+    size_t bytes = mLists.capacity() * sizeof(RowIdSet);
+    for (const RowIdSet &list : mLists)
+    {
+        bytes += list.MemoryBytes();
+    }
+    return bytes;
+}
+
+void EnumIndexStore::SetEnabled(bool enabled) noexcept
+{
+    mEnabled = enabled;
+    if (!enabled)
+    {
+        Clear();
+    }
+}
+
+void EnumIndexStore::Resize(size_t columnCount)
+{
+    mColumns.resize(columnCount);
+}
+
+void EnumIndexStore::Bind(size_t index, const std::vector<KeyId> &keyIds, const EnumDictionary *dictionary)
+{
+    Entry &entry = mColumns[index];
+    if (entry.keyIds == keyIds && entry.dictionary == dictionary)
+    {
+        return;
+    }
+    entry.index.Clear();
+    entry.keyIds = keyIds;
+    entry.dictionary = dictionary;
+}
+
+void EnumIndexStore::Invalidate(size_t index) noexcept
+{
+    if (index < mColumns.size())
+    {
+        mColumns[index].index.Clear();
+    }
+}
+
+void EnumIndexStore::MoveColumn(size_t srcIndex, size_t destIndex)
+{
+    if (srcIndex == destIndex || srcIndex >= mColumns.size() || destIndex >= mColumns.size())
+    {
+        return;
+    }
+    using Diff = std::vector<Entry>::difference_type;
+    auto begin = mColumns.begin();
+    if (srcIndex > destIndex)
+    {
+        std::rotate(
+            std::next(begin, static_cast<Diff>(destIndex)),
+            std::next(begin, static_cast<Diff>(srcIndex)),
+            std::next(begin, static_cast<Diff>(srcIndex + 1))
+        );
+    }
+    else
+    {
+        std::rotate(
+            std::next(begin, static_cast<Diff>(srcIndex)),
+            std::next(begin, static_cast<Diff>(srcIndex + 1)),
+            std::next(begin, static_cast<Diff>(destIndex + 1))
+        );
+    }
+}
+
+void EnumIndexStore::EraseFrontRows(size_t count)
+{
+    for (Entry &entry : mColumns)
+    {
+        entry.index.EraseFront(count);
+    }
+}
+
+void EnumIndexStore::Clear() noexcept
+{
+    mColumns.clear();
+}
+
+size_t EnumIndexStore::MemoryBytes() const noexcept
+{
+    size_t bytes = mColumns.capacity() * sizeof(Entry);
+    for (const Entry &entry : mColumns)
+    {
+        bytes += entry.index.MemoryBytes() + (entry.keyIds.capacity() * sizeof(KeyId));
+    }
+    return bytes;
+}
+
+} // namespace loglib::internal
@@ -0,0 +1,265 @@
+#include "loglib/internal/growing_byte_buffer.hpp"
+
+#include "loglib/internal/path_encoding.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace loglib::internal
+{
+
+namespace
+{
+
+/// Readers re-check their stop token at this interval; `StopToken` has
+/// no callback to wake them.
+constexpr auto STOP_POLL_INTERVAL = std::chrono::milliseconds(50);
+
+[[nodiscard]] size_t RoundUpToWindow(size_t bytes) noexcept
+{
+    const size_t window = GrowingByteBuffer::WINDOW_BYTES;
+    return ((bytes + window - 1) / window) * window;
+}
+
+} // namespace
+
+#ifndef _WIN32
+
+bool GrowingByteBuffer::IsSupported() noexcept
+{
+    return sizeof(void *) >= 8;
+}
+
+GrowingByteBuffer::GrowingByteBuffer(size_t capacityBytes, size_t inMemoryBytes)
+    : mCapacity(RoundUpToWindow(std::max(capacityBytes, size_t{1}))),
+      mInMemoryBytes(std::min(RoundUpToWindow(inMemoryBytes), RoundUpToWindow(std::max(capacityBytes, size_t{1}))))
+{
+    if (!IsSupported())
+    {
+        throw std::runtime_error("Progressive decompression needs a 64-bit address space");
+    }
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+#endif
+    // Address space only; windows gain access as the writer reaches them.
+    void *base = ::mmap(nullptr, mCapacity, PROT_NONE, flags, -1, 0);
+    if (base == MAP_FAILED)
+    {
+        throw std::runtime_error(
+            fmt::format("Failed to reserve {} bytes for decompressed output: errno {}", mCapacity, errno)
+        );
+    }
+    mBase = static_cast<char *>(base);
+}
+
+GrowingByteBuffer::~GrowingByteBuffer()
+{
+    if (mBase != nullptr)
+    {
+        (void)::munmap(mBase, mCapacity);
+    }
+    if (mSpillFd >= 0)
+    {
+        (void)::close(mSpillFd);
+    }
+}
+
+void GrowingByteBuffer::OpenSpillFile()
+{
+    std::error_code ec;
+    const std::filesystem::path dir = std::filesystem::temp_directory_path(ec);
+    if (ec)
+    {
+        throw std::runtime_error(fmt::format("temp_directory_path() failed: {}", ec.message()));
+    }
+    std::string pattern = PathToUtf8(dir / "slv-spill-XXXXXX");
+    const int fd = ::mkstemp(pattern.data());
+    if (fd < 0)
+    {
+        throw std::runtime_error(fmt::format("Failed to create spill file in '{}': errno {}", PathToUtf8(dir), errno));
+    }
+    // Unlinked at once: the mapping keeps the data reachable and the
+    // kernel reclaims the file even if the process dies.
+    (void)::unlink(pattern.c_str());
+    (void)::fcntl(fd, F_SETFD, FD_CLOEXEC);
+    mSpillFd = fd;
+}
+
+void GrowingByteBuffer::MapNextWindow()
+{
+    if (mMappedEnd >= mCapacity)
+    {
+        throw std::length_error(fmt::format("Decompressed output exceeded the {}-byte reservation", mCapacity));
+    }
+    char *window = mBase + mMappedEnd;
+    if (mMappedEnd < mInMemoryBytes)
+    {
+        if (::mprotect(window, WINDOW_BYTES, PROT_READ | PROT_WRITE) != 0)
+        {
+            throw std::runtime_error(fmt::format("Failed to commit decompression window: errno {}", errno));
+        }
+    }
+    else
+    {
+        if (mSpillFd < 0)
+        {
+            OpenSpillFile();
+        }
+        // Size the file before mapping so a reader never faults on a
+        // page past its end; holes read back as zeros.
+        const auto fileOffset = static_cast<off_t>(mMappedEnd - mInMemoryBytes);
+        if (::ftruncate(mSpillFd, fileOffset + static_cast<off_t>(WINDOW_BYTES)) != 0)
+        {
+            throw std::runtime_error(fmt::format("Failed to grow spill file: errno {}", errno));
+        }
+        // Read-only: the writer goes through `pwrite` so a full disk
+        // surfaces as an error instead of SIGBUS.
+        void *mapped = ::mmap(window, WINDOW_BYTES, PROT_READ, MAP_SHARED | MAP_FIXED, mSpillFd, fileOffset);
+        if (mapped == MAP_FAILED)
+        {
+            throw std::runtime_error(fmt::format("Failed to map spill file window: errno {}", errno));
+        }
+    }
+    mMappedEnd += WINDOW_BYTES;
+}
+
+void GrowingByteBuffer::Append(const char *data, size_t size)
+{
+    size_t written = mSize.load(std::memory_order_relaxed);
+    while (size > 0)
+    {
+        if (written == mMappedEnd)
+        {
+            MapNextWindow();
+        }
+        const size_t chunk = std::min(size, mMappedEnd - written);
+        if (written < mInMemoryBytes)
+        {
+            std::memcpy(mBase + written, data, chunk);
+        }
+        else
+        {
+            size_t done = 0;
+            while (done < chunk)
+            {
+                const ssize_t n = ::pwrite(
+                    mSpillFd, data + done, chunk - done, static_cast<off_t>(written + done - mInMemoryBytes)
+                );
+                if (n < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (n <= 0)
+                {
+                    throw std::runtime_error(fmt::format("Failed to write spill file: errno {}", errno));
+                }
+                done += static_cast<size_t>(n);
+            }
+        }
+        data += chunk;
+        size -= chunk;
+        written += chunk;
+        // Sequentially consistent so the waiting-readers check below
+        // cannot be ordered before the publish.
+        mSize.store(written);
+    }
+    if (mWaitingReaders.load() > 0)
+    {
+        WakeReaders();
+    }
+}
+
+size_t GrowingByteBuffer::SpilledBytes() const noexcept
+{
+    const size_t size = Size();
+    return size > mInMemoryBytes ? size - mInMemoryBytes : 0;
+}
+
+#else // _WIN32
+
+bool GrowingByteBuffer::IsSupported() noexcept
+{
+    return false;
+}
+
+GrowingByteBuffer::GrowingByteBuffer(size_t /*capacityBytes*/, size_t /*inMemoryBytes*/)
+{
+    throw std::runtime_error("Progressive decompression is not supported on this platform");
+}
+
+GrowingByteBuffer::~GrowingByteBuffer() = default;
+
+void GrowingByteBuffer::OpenSpillFile() {}
+
+void GrowingByteBuffer::MapNextWindow() {}
+
+void GrowingByteBuffer::Append(const char * /*data*/, size_t /*size*/) {}
+
+size_t GrowingByteBuffer::SpilledBytes() const noexcept
+{
+    return 0;
+}
+
+#endif // _WIN32
+
+void GrowingByteBuffer::Finish(std::string error)
+{
+    {
+        const std::scoped_lock lock(mMutex);
+        mError = std::move(error);
+        mComplete.store(true, std::memory_order_release);
+    }
+    mCv.notify_all();
+}
+
+std::string GrowingByteBuffer::Error() const
+{
+    const std::scoped_lock lock(mMutex);
+    return mError;
+}
+
+size_t GrowingByteBuffer::WaitForGrowth(size_t knownSize, const StopToken &stopToken)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    mWaitingReaders.fetch_add(1);
+    const auto ready = [&] { return Size() > knownSize || IsComplete() || stopToken.stop_requested(); };
+    while (!ready())
+    {
+        mCv.wait_for(lock, STOP_POLL_INTERVAL, ready);
+    }
+    mWaitingReaders.fetch_sub(1, std::memory_order_relaxed);
+    return Size();
+}
+
+void GrowingByteBuffer::RequestStop() noexcept
+{
+    mStopRequested.store(true, std::memory_order_release);
+}
+
+void GrowingByteBuffer::WakeReaders()
+{
+    {
+        // Taking the lock orders us after a reader that checked its
+        // predicate but has not started waiting yet.
+        const std::scoped_lock lock(mMutex);
+    }
+    mCv.notify_all();
+}
+
+} // namespace loglib::internal
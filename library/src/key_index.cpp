@@ -1,5 +1,6 @@
 #include "loglib/key_index.hpp"
 
+#include "loglib/internal/row_shape.hpp"
 #include "loglib/internal/transparent_string_hash.hpp"
 
 #include <tsl/robin_map.h>
@@ -48,6 +49,9 @@ struct KeyIndex::Impl
     /// reallocate, so concurrent access is data-race UB.
     mutable std::shared_mutex reverseMutex;
 
+    /// Interned row key sets; see `internal::RowShapeRegistry`.
+    internal::RowShapeRegistry shapes;
+
     static size_t ShardIndex(std::string_view key) noexcept
     {
         return std::hash<std::string_view>{}(key)&SHARD_MASK;
@@ -169,9 +173,15 @@ size_t KeyIndex::EstimatedMemoryBytes() const
             }
         }
     }
+    bytes += mImpl->shapes.MemoryBytes();
     return bytes;
 }
 
+internal::RowShapeRegistry &KeyIndex::Shapes() const noexcept
+{
+    return mImpl->shapes;
+}
+
 #ifdef LOGLIB_KEY_INDEX_INSTRUMENTATION
 std::atomic<std::size_t> KeyIndex::sGetOrInsertCallCount{0};
 std::atomic<std::size_t> KeyIndex::sFindCallCount{0};
@@ -0,0 +1,64 @@
+#include "loglib/internal/line_field_slab.hpp"
+
+#include <algorithm>
+
+namespace loglib::internal
+{
+
+namespace
+{
+
+thread_local LineFieldSlab *tCurrentSlab = nullptr;
+
+} // namespace
+
+LineFieldSlab::LineFieldSlab(size_t firstBlockBytes)
+    : mNextBlockBytes(std::max(firstBlockBytes, ALIGNMENT))
+{
+}
+
+void *LineFieldSlab::Allocate(size_t bytes)
+{
+    const size_t rounded = (bytes + (ALIGNMENT - 1)) & ~(ALIGNMENT - 1);
+    if (rounded > mRemaining)
+    {
+        OpenBlock(rounded);
+    }
+    void *result = mCursor;
+    mCursor += rounded;
+    mRemaining -= rounded;
+    mUsedBytes += rounded;
+    return result;
+}
+
+void LineFieldSlab::OpenBlock(size_t minBytes)
+{
+    // Geometric growth keeps an undersized first guess to a handful of
+    // blocks; the tail of the abandoned block stays as slack.
+    const size_t blockBytes = std::max(mNextBlockBytes, minBytes);
+    // `operator new[]` for `std::byte` is aligned to
+    // `__STDCPP_DEFAULT_NEW_ALIGNMENT__`, which covers `ALIGNMENT`.
+    mBlocks.push_back(std::make_unique_for_overwrite<std::byte[]>(blockBytes));
+    mCursor = mBlocks.back().get();
+    mRemaining = blockBytes;
+    mReservedBytes += blockBytes;
+    mNextBlockBytes = blockBytes * 2;
+}
+
+LineFieldSlab *CurrentLineFieldSlab() noexcept
+{
+    return tCurrentSlab;
+}
+
+ScopedLineFieldSlab::ScopedLineFieldSlab(LineFieldSlab &slab) noexcept
+    : mPrevious(tCurrentSlab)
+{
+    tCurrentSlab = &slab;
+}
+
+ScopedLineFieldSlab::~ScopedLineFieldSlab()
+{
+    tCurrentSlab = mPrevious;
+}
+
+} // namespace loglib::internal
@@ -3,6 +3,7 @@
 // is fine.
 #include "loglib/log_compare.hpp"
 
+#include "loglib/internal/compact_log_value.hpp"
 #include "loglib/log_configuration.hpp"
 #include "loglib/log_level.hpp"
 #include "loglib/log_table.hpp"
@@ -13,6 +14,7 @@
 #include <oneapi/tbb/parallel_sort.h>
 
 #include <algorithm>
+#include <bit>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
@@ -390,6 +392,159 @@ int CompareLevel(const LogTable &table, size_t lhsRow, size_t rhsRow, size_t col
     return -1;
 }
 
+/// Pre-materialised sort key for the typed fast path in
+/// `SortPermutationByColumn`. `bucket` orders representable values
+/// (`0`) before NaN (`1`, floating only) before the tail bucket (`2`),
+/// so a lexicographic `(bucket, value)` compare reproduces
+/// `CompareRows` for the scalar types.
+template <class T> struct TypedSortKey
+{
+    T value{};
+    uint8_t bucket = 0;
+};
+
+constexpr uint8_t TYPED_KEY_NAN_BUCKET = 1;
+constexpr uint8_t TYPED_KEY_TAIL_BUCKET = 2;
+
+/// `CompareInteger`'s extraction, read off the compact slot.
+TypedSortKey<int64_t> IntegerSortKey(const internal::CompactLogValue &slot) noexcept
+{
+    constexpr auto MAX = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+    switch (slot.tag)
+    {
+    case internal::CompactTag::Int64:
+        return {.value = static_cast<int64_t>(slot.payload)};
+    case internal::CompactTag::Uint64:
+        return {.value = slot.payload > MAX ? std::numeric_limits<int64_t>::max() : static_cast<int64_t>(slot.payload)};
+    case internal::CompactTag::Double:
+    {
+        const double d = std::bit_cast<double>(slot.payload);
+        if (std::isnan(d))
+        {
+            return {.bucket = TYPED_KEY_TAIL_BUCKET};
+        }
+        if (d >= static_cast<double>(std::numeric_limits<int64_t>::max()))
+        {
+            return {.value = std::numeric_limits<int64_t>::max()};
+        }
+        if (d <= static_cast<double>(std::numeric_limits<int64_t>::min()))
+        {
+            return {.value = std::numeric_limits<int64_t>::min()};
+        }
+        return {.value = static_cast<int64_t>(d)};
+    }
+    default:
+        return {.bucket = TYPED_KEY_TAIL_BUCKET};
+    }
+}
+
+/// `CompareTime`'s extraction, read off the compact slot.
+TypedSortKey<int64_t> TimeSortKey(const internal::CompactLogValue &slot) noexcept
+{
+    constexpr auto MAX = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+    switch (slot.tag)
+    {
+    case internal::CompactTag::Timestamp:
+    case internal::CompactTag::Int64:
+        return {.value = static_cast<int64_t>(slot.payload)};
+    case internal::CompactTag::Uint64:
+        return {.value = slot.payload > MAX ? std::numeric_limits<int64_t>::max() : static_cast<int64_t>(slot.payload)};
+    default:
+        return {.bucket = TYPED_KEY_TAIL_BUCKET};
+    }
+}
+
+/// `CompareFloating`'s extraction, read off the compact slot. NaN gets
+/// its own bucket: `ThreeWayDouble` sorts it after every number but
+/// ahead of the non-numeric tail.
+TypedSortKey<double> FloatingSortKey(const internal::CompactLogValue &slot) noexcept
+{
+    switch (slot.tag)
+    {
+    case internal::CompactTag::Double:
+    {
+        const double d = std::bit_cast<double>(slot.payload);
+        if (std::isnan(d))
+        {
+            return {.bucket = TYPED_KEY_NAN_BUCKET};
+        }
+        return {.value = d};
+    }
+    case internal::CompactTag::Int64:
+        return {.value = static_cast<double>(static_cast<int64_t>(slot.payload))};
+    case internal::CompactTag::Uint64:
+        return {.value = static_cast<double>(slot.payload)};
+    default:
+        return {.bucket = TYPED_KEY_TAIL_BUCKET};
+    }
+}
+
+/// `CompareBool`'s extraction, read off the compact slot.
+TypedSortKey<uint8_t> BoolSortKey(const internal::CompactLogValue &slot) noexcept
+{
+    if (slot.tag != internal::CompactTag::Bool)
+    {
+        return {.bucket = TYPED_KEY_TAIL_BUCKET};
+    }
+    return {.value = static_cast<uint8_t>(slot.payload != 0 ? 1U : 0U)};
+}
+
+/// Pre-materialise one `TypedSortKey` per row in parallel via
+/// @p makeKey, then sort @p permutation by `(bucket, value)` with the
+/// input-index tie-break. Reads go through `GetCompactValue`, so a
+/// table with columnar storage enabled streams the dense column.
+template <class T, class MakeKey>
+void SortByTypedKeys(
+    const LogTable &table,
+    std::span<const size_t> logRows,
+    size_t columnIndex,
+    bool ascending,
+    std::vector<size_t> &permutation,
+    MakeKey makeKey
+)
+{
+    const size_t n = logRows.size();
+    std::vector<TypedSortKey<T>> keys(n);
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, n),
+        [&table, columnIndex, &logRows, &keys, &makeKey](const tbb::blocked_range<size_t> &range) {
+            for (size_t i = range.begin(); i != range.end(); ++i)
+            {
+                keys[i] = makeKey(table.GetCompactValue(logRows[i], columnIndex));
+            }
+        }
+    );
+    // Only bucket-0 values carry a payload; NaN / tail members compare
+    // equal within their bucket, matching `CompareRows`.
+    auto threeWay = [&keys](size_t a, size_t b) -> int {
+        const TypedSortKey<T> &lhs = keys[a];
+        const TypedSortKey<T> &rhs = keys[b];
+        if (lhs.bucket != rhs.bucket)
+        {
+            return lhs.bucket < rhs.bucket ? -1 : 1;
+        }
+        if (lhs.bucket == 0)
+        {
+            return ThreeWay(lhs.value, rhs.value);
+        }
+        return 0;
+    };
+    if (ascending)
+    {
+        tbb::parallel_sort(permutation.begin(), permutation.end(), [&threeWay](size_t a, size_t b) {
+            const int cmp = threeWay(a, b);
+            return cmp != 0 ? cmp < 0 : a < b;
+        });
+    }
+    else
+    {
+        tbb::parallel_sort(permutation.begin(), permutation.end(), [&threeWay](size_t a, size_t b) {
+            const int cmp = threeWay(a, b);
+            return cmp != 0 ? cmp > 0 : a < b;
+        });
+    }
+}
+
 } // namespace
 
 int CompareRows(
@@ -568,11 +723,36 @@ std::vector<size_t> SortPermutationByColumn(
         return permutation;
     }
 
+    // Scalar fast path: pre-materialise a typed key per row off the
+    // compact slot (the dense column when columnar storage is on), then
+    // sort on plain integer / double compares. Same tail-bucket
+    // placement as `CompareRows`.
+    if (columnInRange)
+    {
+        switch (columns[columnIndex].type)
+        {
+        case LogConfiguration::Type::Time:
+            SortByTypedKeys<int64_t>(table, logRows, columnIndex, ascending, permutation, TimeSortKey);
+            return permutation;
+        case LogConfiguration::Type::Integer:
+            SortByTypedKeys<int64_t>(table, logRows, columnIndex, ascending, permutation, IntegerSortKey);
+            return permutation;
+        case LogConfiguration::Type::Floating:
+        case LogConfiguration::Type::Number:
+            SortByTypedKeys<double>(table, logRows, columnIndex, ascending, permutation, FloatingSortKey);
+            return permutation;
+        case LogConfiguration::Type::Boolean:
+            SortByTypedKeys<uint8_t>(table, logRows, columnIndex, ascending, permutation, BoolSortKey);
+            return permutation;
+        default:
+            break;
+        }
+    }
+
     // Generic path: dispatch through `CompareRows` per comparison.
-    // Pays the slot-resolution cost on every call but is correct for
-    // the non-enum types (`Time`, `Integer`, `Floating`, string),
-    // where no cheap pre-materialisation is available. Still benefits
-    // from parallel sort.
+    // Pays the slot-resolution cost on every call; reached by string
+    // columns and by enum columns sorted without a rank table. Still
+    // benefits from parallel sort.
     if (ascending)
     {
         tbb::parallel_sort(
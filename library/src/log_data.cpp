@@ -17,6 +17,11 @@ namespace loglib
 LogData::LogData() = default;
 
 LogData::LogData(std::unique_ptr<LineSource> source, std::vector<LogLine> lines, KeyIndex keys)
+    : LogData(std::move(source), LogLineStore(std::move(lines)), std::move(keys))
+{
+}
+
+LogData::LogData(std::unique_ptr<LineSource> source, LogLineStore lines, KeyIndex keys)
     : mLines(std::move(lines)), mKeys(std::move(keys))
 {
     if (source != nullptr)
@@ -155,12 +160,12 @@ const StreamLineSource *LogData::BackStreamSource() const noexcept
     return nullptr;
 }
 
-const std::vector<LogLine> &LogData::Lines() const
+const LogLineStore &LogData::Lines() const
 {
     return mLines;
 }
 
-std::vector<LogLine> &LogData::Lines()
+LogLineStore &LogData::Lines()
 {
     return mLines;
 }
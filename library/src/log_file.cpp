@@ -1,9 +1,11 @@
 #include "loglib/log_file.hpp"
 
+#include "loglib/internal/growing_byte_buffer.hpp"
 #include "loglib/internal/path_encoding.hpp"
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <cassert>
 #include <stdexcept>
 #include <string>
@@ -20,6 +22,7 @@
 #include <memoryapi.h>
 #elif defined(__unix__) || defined(__APPLE__)
 #include <sys/mman.h>
+#include <unistd.h>
 #endif
 
 namespace loglib
@@ -52,6 +55,53 @@ void HintSequential(const mio::mmap_source &mmap)
 #endif
 }
 
+#if defined(__unix__) || defined(__APPLE__)
+/// `posix_madvise` on the pages covering [@p offset, @p offset + @p length)
+/// of @p mmap, clamped to the mapping. Best-effort; failures are ignored.
+void AdviseRange(const mio::mmap_source &mmap, size_t offset, size_t length, int advice)
+{
+    if (mmap.empty() || offset >= mmap.size() || length == 0)
+    {
+        return;
+    }
+    static const auto PAGE_SIZE_BYTES = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    const size_t end = offset + std::min(length, mmap.size() - offset);
+    const size_t alignedBegin = offset - (offset % PAGE_SIZE_BYTES);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast): POSIX API takes non-const `void*`; mapping is read-only.
+    (void)::posix_madvise(const_cast<char *>(mmap.data()) + alignedBegin, end - alignedBegin, advice);
+}
+#endif
+
+/// Ask for transparent huge pages. Linux only; failures are ignored.
+void HintHugePages(const mio::mmap_source &mmap)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast): Linux API takes non-const `void*`; mapping is read-only.
+    (void)::madvise(const_cast<char *>(mmap.data()), mmap.size(), MADV_HUGEPAGE);
+#else
+    (void)mmap;
+#endif
+}
+
+/// Fault every page of @p mmap in now, the after-the-fact equivalent of
+/// `MAP_POPULATE` (mio maps without it). Kernels before 5.14 reject
+/// `MADV_POPULATE_READ`; they and other platforms get a will-need hint.
+void Populate(const mio::mmap_source &mmap)
+{
+#if defined(__linux__) && defined(MADV_POPULATE_READ)
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast): Linux API takes non-const `void*`; mapping is read-only.
+    if (::madvise(const_cast<char *>(mmap.data()), mmap.size(), MADV_POPULATE_READ) == 0)
+    {
+        return;
+    }
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+    AdviseRange(mmap, 0, mmap.size(), POSIX_MADV_WILLNEED);
+#else
+    (void)mmap;
+#endif
+}
+
 } // namespace
 
 // MSVC's <filesystem> casts a combined bitmask back to __std_fs_stats_flags;
@@ -63,7 +113,12 @@ LogFile::LogFile(const std::filesystem::path &filePath)
 }
 
 LogFile::LogFile(std::filesystem::path storagePath, std::filesystem::path logicalPath)
-    : mPath(std::move(logicalPath)), mStoragePath(std::move(storagePath))
+    : LogFile(std::move(storagePath), std::move(logicalPath), MapOptions{})
+{
+}
+
+LogFile::LogFile(std::filesystem::path storagePath, std::filesystem::path logicalPath, MapOptions options)
+    : mPath(std::move(logicalPath)), mStoragePath(std::move(storagePath)), mAccessHints(options.accessHints)
 {
     if (!std::filesystem::exists(mStoragePath))
     {
@@ -88,13 +143,34 @@ LogFile::LogFile(std::filesystem::path storagePath, std::filesystem::path logica
                 fmt::format("Failed to memory-map file '{}': {}", internal::PathToUtf8(mStoragePath), ec.message())
             );
         }
-        HintSequential(mMmap);
+        if (options.hugePages)
+        {
+            HintHugePages(mMmap);
+        }
+        if (mAccessHints)
+        {
+            HintSequential(mMmap);
+        }
+        if (options.populate)
+        {
+            Populate(mMmap);
+        }
     }
 
     mLineOffsets.push_back(0);
 }
 // NOLINTEND(clang-analyzer-optin.core.EnumCastOutOfRange)
 
+LogFile::LogFile(std::shared_ptr<internal::GrowingByteBuffer> growingBytes, std::filesystem::path logicalPath)
+    : mPath(std::move(logicalPath)), mStoragePath(mPath), mGrowingBytes(std::move(growingBytes))
+{
+    if (mGrowingBytes == nullptr)
+    {
+        throw std::invalid_argument("LogFile needs a non-null growing byte buffer");
+    }
+    mLineOffsets.push_back(0);
+}
+
 const std::filesystem::path &LogFile::GetPath() const
 {
     return mPath;
@@ -102,12 +178,85 @@ const std::filesystem::path &LogFile::GetPath() const
 
 const char *LogFile::Data() const
 {
-    return mMmap.data();
+    return mGrowingBytes ? mGrowingBytes->Data() : mMmap.data();
 }
 
 size_t LogFile::Size() const
 {
-    return mMmap.size();
+    return mGrowingBytes ? mGrowingBytes->Size() : mMmap.size();
+}
+
+bool LogFile::IsGrowing() const noexcept
+{
+    return mGrowingBytes != nullptr && !mGrowingBytes->IsComplete();
+}
+
+size_t LogFile::WaitForGrowth(size_t knownSize, const StopToken &stopToken) const
+{
+    if (mGrowingBytes == nullptr)
+    {
+        return Size();
+    }
+    return mGrowingBytes->WaitForGrowth(knownSize, stopToken);
+}
+
+void LogFile::StopGrowing() noexcept
+{
+    if (mGrowingBytes != nullptr)
+    {
+        mGrowingBytes->RequestStop();
+    }
+}
+
+std::string LogFile::GrowthError() const
+{
+    return mGrowingBytes ? mGrowingBytes->Error() : std::string{};
+}
+
+void LogFile::AdviseWillNeed(size_t offset, size_t length) const noexcept
+{
+    if (!mAccessHints)
+    {
+        return;
+    }
+#ifdef _WIN32
+    if (mMmap.empty() || offset >= mMmap.size() || length == 0)
+    {
+        return;
+    }
+    WIN32_MEMORY_RANGE_ENTRY range;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast): Win32 API takes non-const `void*`; mapping is read-only.
+    range.VirtualAddress = const_cast<char *>(mMmap.data()) + offset;
+    range.NumberOfBytes = std::min(length, mMmap.size() - offset);
+    (void)::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &range, 0);
+#elif defined(__unix__) || defined(__APPLE__)
+    AdviseRange(mMmap, offset, length, POSIX_MADV_WILLNEED);
+#else
+    (void)offset;
+    (void)length;
+#endif
+}
+
+void LogFile::AdviseSequentialAccess() const noexcept
+{
+    // Windows has no per-range access-pattern hint; `AdviseWillNeed`
+    // windows stand in for read-ahead there.
+#if !defined(_WIN32) && (defined(__unix__) || defined(__APPLE__))
+    if (mAccessHints)
+    {
+        AdviseRange(mMmap, 0, mMmap.size(), POSIX_MADV_SEQUENTIAL);
+    }
+#endif
+}
+
+void LogFile::AdviseRandomAccess() const noexcept
+{
+#if !defined(_WIN32) && (defined(__unix__) || defined(__APPLE__))
+    if (mAccessHints)
+    {
+        AdviseRange(mMmap, 0, mMmap.size(), POSIX_MADV_RANDOM);
+    }
+#endif
 }
 
 std::string LogFile::GetLine(size_t lineNumber) const
@@ -139,13 +288,13 @@ std::string LogFile::GetLine(size_t lineNumber) const
     // newline use `fileSize + 1` as the sentinel; clamp against the mmap size.
     size_t length = stopOffset - startOffset - 1;
 
-    const size_t mmapSize = mMmap.size();
+    const size_t mmapSize = Size();
     if (startOffset + length > mmapSize)
     {
         length = mmapSize - static_cast<size_t>(startOffset);
     }
 
-    std::string buffer(mMmap.data() + startOffset, length);
+    std::string buffer(Data() + startOffset, length);
     if (!buffer.empty() && buffer.back() == '\r')
     {
         buffer.pop_back();
@@ -193,21 +342,62 @@ void LogFile::RegisterMultiLineRecord(size_t headerLineId, size_t lastLineId)
     mMultiLineSpans[headerLineId] = lastLineId;
 }
 
-std::string_view LogFile::OwnedStringsView() const noexcept
+std::string_view LogFile::OwnedBytes(uint64_t offset, size_t length) const noexcept
 {
-    return std::string_view(mOwnedStrings);
+    return mOwnedStrings->Bytes(offset, length);
 }
 
 uint64_t LogFile::AppendOwnedStrings(std::string_view bytes)
 {
-    const uint64_t offset = mOwnedStrings.size();
-    mOwnedStrings.append(bytes.data(), bytes.size());
-    return offset;
+    return mOwnedStrings->Append(bytes);
+}
+
+uint64_t LogFile::ReserveOwnedStrings(size_t length) noexcept
+{
+    return mOwnedStrings->Reserve(length);
+}
+
+void LogFile::AdoptOwnedStrings(uint64_t offset, std::string bytes, size_t span)
+{
+    mOwnedStrings->Adopt(offset, std::move(bytes), span);
+}
+
+bool LogFile::TryExtendOwnedStrings(uint64_t end, std::string_view bytes)
+{
+    return mOwnedStrings->TryExtend(end, bytes);
 }
 
 size_t LogFile::OwnedStringsMemoryBytes() const noexcept
 {
-    return mOwnedStrings.capacity();
+    return mOwnedStrings->MemoryBytes();
+}
+
+void LogFile::AdoptFieldSlab(std::unique_ptr<internal::LineFieldSlab> slab)
+{
+    if (slab != nullptr && slab->MemoryBytes() > 0)
+    {
+        mFieldSlabs.push_back(std::move(slab));
+    }
+}
+
+size_t LogFile::FieldSlabMemoryBytes() const noexcept
+{
+    size_t bytes = 0;
+    for (const auto &slab : mFieldSlabs)
+    {
+        bytes += slab->MemoryBytes();
+    }
+    return bytes;
+}
+
+size_t LogFile::FieldSlabSlackBytes() const noexcept
+{
+    size_t bytes = 0;
+    for (const auto &slab : mFieldSlabs)
+    {
+        bytes += slab->MemoryBytes() - slab->UsedBytes();
+    }
+    return bytes;
 }
 
 void LogFile::AttachLifetimeAnchor(std::shared_ptr<void> anchor) noexcept
@@ -2,6 +2,10 @@
 // ordering that `app/` needs doesn't apply here.
 #include "loglib/log_filter.hpp"
 
+#include "loglib/internal/compact_log_value.hpp"
+#include "loglib/internal/enum_posting_index.hpp"
+#include "loglib/internal/trigram_index.hpp"
+#include "loglib/internal/zone_map.hpp"
 #include "loglib/log_table.hpp"
 #include "loglib/log_value.hpp"
 
@@ -16,6 +20,7 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <numeric>
@@ -34,7 +39,7 @@ namespace loglib
 EnumRowPredicate::EnumRowPredicate(
     size_t columnIndex, std::span<const std::string_view> selectedValues, const EnumDictionary *dictionary
 )
-    : mColumnIndex(columnIndex)
+    : mColumnIndex(columnIndex), mDictionary(dictionary)
 {
     if (selectedValues.empty())
     {
@@ -139,6 +144,27 @@ bool EnumRowPredicate::MatchesRow(const LogTable &table, size_t row) const
     return false;
 }
 
+std::optional<std::vector<EnumValueId>> EnumRowPredicate::IndexableIds() const
+{
+    if (mEmptySelection)
+    {
+        return std::vector<EnumValueId>{};
+    }
+    if (mDictionary == nullptr || !mAllResolved)
+    {
+        return std::nullopt;
+    }
+    std::vector<EnumValueId> ids;
+    for (size_t idx = 0; idx < mSelectedIds.size(); ++idx)
+    {
+        if (mSelectedIds[idx])
+        {
+            ids.push_back(static_cast<EnumValueId>(static_cast<uint16_t>(idx)));
+        }
+    }
+    return ids;
+}
+
 TimeRangeRowPredicate::TimeRangeRowPredicate(size_t columnIndex, int64_t begin, int64_t end)
     : mColumnIndex(columnIndex), mBegin(begin), mEnd(end)
 {
@@ -150,44 +176,36 @@ bool TimeRangeRowPredicate::MatchesRow(const LogTable &table, size_t row) const
     {
         return false;
     }
-    const LogValue value = table.GetValue(row, mColumnIndex);
-    // Slot acceptance set must stay in lockstep with
-    // `loglib::AsEpochMicroseconds`: `TimeStamp`, `int64_t`,
-    // in-range `uint64_t`.
-    return std::visit(
-        [this](const auto &alt) -> bool {
-            using T = std::decay_t<decltype(alt)>;
-            if constexpr (std::is_same_v<T, TimeStamp>)
-            {
-                const int64_t ts = alt.time_since_epoch().count();
-                return ts >= mBegin && ts <= mEnd;
-            }
-            else if constexpr (std::is_same_v<T, int64_t>)
-            {
-                return alt >= mBegin && alt <= mEnd;
-            }
-            else if constexpr (std::is_same_v<T, uint64_t>)
-            {
-                // Reject (rather than wrap) `uint64_t` past
-                // `int64_t::max` so this stays in sync with
-                // `AsEpochMicroseconds`.
-                if (alt > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
-                {
-                    return false;
-                }
-                // Clamp negative bounds to 0 so e.g. `[-1, 100]`
-                // still matches positive values.
-                const uint64_t lo = mBegin < 0 ? 0U : static_cast<uint64_t>(mBegin);
-                const uint64_t hi = mEnd < 0 ? 0U : static_cast<uint64_t>(mEnd);
-                return alt >= lo && alt <= hi;
-            }
-            else
-            {
-                return false;
-            }
-        },
-        value
-    );
+    // Typed read straight off the compact slot (columnar mirror when
+    // enabled): no `LogValue` materialisation per row. Slot acceptance
+    // set must stay in lockstep with `loglib::AsEpochMicroseconds`:
+    // `TimeStamp`, `int64_t`, in-range `uint64_t`.
+    const internal::CompactLogValue slot = table.GetCompactValue(row, mColumnIndex);
+    switch (slot.tag)
+    {
+    case internal::CompactTag::Timestamp:
+    case internal::CompactTag::Int64:
+    {
+        const auto ts = static_cast<int64_t>(slot.payload);
+        return ts >= mBegin && ts <= mEnd;
+    }
+    case internal::CompactTag::Uint64:
+    {
+        // Reject (rather than wrap) `uint64_t` past `int64_t::max` so
+        // this stays in sync with `AsEpochMicroseconds`.
+        if (slot.payload > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+        {
+            return false;
+        }
+        // Clamp negative bounds to 0 so e.g. `[-1, 100]` still
+        // matches positive values.
+        const uint64_t lo = mBegin < 0 ? 0U : static_cast<uint64_t>(mBegin);
+        const uint64_t hi = mEnd < 0 ? 0U : static_cast<uint64_t>(mEnd);
+        return slot.payload >= lo && slot.payload <= hi;
+    }
+    default:
+        return false;
+    }
 }
 
 NumericRangeRowPredicate::NumericRangeRowPredicate(
@@ -210,43 +228,36 @@ NumericRangeRowPredicate::NumericRangeRowPredicate(
 
 bool NumericRangeRowPredicate::MatchesRow(const LogTable &table, size_t row) const
 {
-    const LogValue value = table.GetValue(row, mColumnIndex);
-    return std::visit(
-        [this](const auto &alt) -> bool {
-            using T = std::decay_t<decltype(alt)>;
-            // Single exit after the `if constexpr` chain to avoid
-            // MSVC C4702 (a branch returning early would make the
-            // common tail unreachable for that instantiation).
-            std::optional<double> asDouble;
-            if constexpr (std::is_same_v<T, double>)
-            {
-                if (!std::isnan(alt))
-                {
-                    asDouble = alt;
-                }
-            }
-            else if constexpr (std::is_same_v<T, int64_t> || std::is_same_v<T, uint64_t>)
-            {
-                // Cast loses precision past 2^53 (see header).
-                asDouble = static_cast<double>(alt);
-            }
-            if (!asDouble.has_value())
-            {
-                return false;
-            }
-            const double numeric = *asDouble;
-            if (mMin.has_value() && numeric < *mMin)
-            {
-                return false;
-            }
-            if (mMax.has_value() && numeric > *mMax)
-            {
-                return false;
-            }
-            return true;
-        },
-        value
-    );
+    const internal::CompactLogValue slot = table.GetCompactValue(row, mColumnIndex);
+    double numeric = 0.0;
+    switch (slot.tag)
+    {
+    case internal::CompactTag::Double:
+        numeric = std::bit_cast<double>(slot.payload);
+        if (std::isnan(numeric))
+        {
+            return false;
+        }
+        break;
+    case internal::CompactTag::Int64:
+        // Cast loses precision past 2^53 (see header).
+        numeric = static_cast<double>(static_cast<int64_t>(slot.payload));
+        break;
+    case internal::CompactTag::Uint64:
+        numeric = static_cast<double>(slot.payload);
+        break;
+    default:
+        return false;
+    }
+    if (mMin.has_value() && numeric < *mMin)
+    {
+        return false;
+    }
+    if (mMax.has_value() && numeric > *mMax)
+    {
+        return false;
+    }
+    return true;
 }
 
 BoolRowPredicate::BoolRowPredicate(size_t columnIndex, bool includeTrue, bool includeFalse)
@@ -260,12 +271,12 @@ bool BoolRowPredicate::MatchesRow(const LogTable &table, size_t row) const
     {
         return false;
     }
-    const LogValue value = table.GetValue(row, mColumnIndex);
-    if (const auto *b = std::get_if<bool>(&value); b != nullptr)
+    const internal::CompactLogValue slot = table.GetCompactValue(row, mColumnIndex);
+    if (slot.tag != internal::CompactTag::Bool)
     {
-        return *b ? mIncludeTrue : mIncludeFalse;
+        return false;
     }
-    return false;
+    return slot.payload != 0 ? mIncludeTrue : mIncludeFalse;
 }
 
 CallbackStringRowPredicate::CallbackStringRowPredicate(size_t columnIndex, MatchFn match)
@@ -544,6 +555,24 @@ public:
         mWords[row / WORD_BITS] |= (uint64_t{1} << (row % WORD_BITS));
     }
 
+    /// Set every bit in `[first, end)`.
+    void SetRange(size_t first, size_t end) noexcept
+    {
+        assert(first <= end && end <= mRowCount);
+        for (; first < end && first % WORD_BITS != 0; ++first)
+        {
+            Set(first);
+        }
+        for (; first + WORD_BITS <= end; first += WORD_BITS)
+        {
+            mWords[first / WORD_BITS] = ~uint64_t{0};
+        }
+        for (; first < end; ++first)
+        {
+            Set(first);
+        }
+    }
+
     [[nodiscard]] bool Test(size_t row) const noexcept
     {
         return (mWords[row / WORD_BITS] & (uint64_t{1} << (row % WORD_BITS))) != 0U;
@@ -596,8 +625,9 @@ public:
         return total;
     }
 
-    /// Extract accepted rows in ascending order.
-    void CollectInto(std::vector<size_t> &out) const
+    /// Extract accepted rows in ascending order, offset by
+    /// @p firstRow (the table row bit 0 stands for).
+    void CollectInto(std::vector<size_t> &out, size_t firstRow) const
     {
         // Reserve by popcount, not `mRowCount`: reserving per-row
         // would allocate ~800 MB per 100 M-row table for a
@@ -613,7 +643,7 @@ public:
                 // Every mutating op must call `MaskTail`, so a set
                 // bit past `mRowCount` here would be a bug.
                 assert(row < mRowCount);
-                out.push_back(row);
+                out.push_back(firstRow + row);
                 word &= word - 1U;
             }
         }
@@ -646,25 +676,306 @@ private:
     std::vector<uint64_t> mWords;
 };
 
-/// Materialise @p predicate's accept-set into a packed bitset in
-/// parallel. Each worker owns a private bitset; the main thread
+/// An `EnumRowPredicate` leaf answered by its column's posting index.
+struct IndexedLeaf
+{
+    const internal::EnumPostingIndex *index = nullptr;
+    std::vector<EnumValueId> ids;
+    /// Rows carrying any of `ids`, table-wide.
+    size_t postings = 0;
+};
+
+/// @p predicate as an `IndexedLeaf` when a live index answers it
+/// exactly: an `EnumRowPredicate` with `IndexableIds`, resolved
+/// against the dictionary the column's index was built from.
+std::optional<IndexedLeaf> ResolveIndexedLeaf(const RowPredicate &predicate, const LogTable &table)
+{
+    const auto *enumPredicate = std::get_if<EnumRowPredicate>(&predicate);
+    if (enumPredicate == nullptr)
+    {
+        return std::nullopt;
+    }
+    std::optional<std::vector<EnumValueId>> ids = enumPredicate->IndexableIds();
+    if (!ids.has_value())
+    {
+        return std::nullopt;
+    }
+    const size_t column = enumPredicate->ColumnIndex();
+    const internal::EnumPostingIndex *index = table.EnumIndex(column);
+    // A predicate compiled before a demote / re-promote carries ids
+    // from the old dictionary; those must not meet the new postings.
+    if (index == nullptr || table.ResolveEnumColumn(column).dictionary != enumPredicate->Dictionary())
+    {
+        return std::nullopt;
+    }
+    IndexedLeaf leaf{.index = index, .ids = std::move(*ids)};
+    for (const EnumValueId id : leaf.ids)
+    {
+        leaf.postings += index->RowCount(id);
+    }
+    return leaf;
+}
+
+/// Rows in `[firstRow, endRow)` accepted by @p leaf, ascending.
+std::vector<size_t> CollectIndexedRows(const IndexedLeaf &leaf, size_t firstRow, size_t endRow)
+{
+    std::vector<size_t> rows;
+    rows.reserve(std::min(leaf.postings, endRow - firstRow));
+    for (const EnumValueId id : leaf.ids)
+    {
+        // Each list is ascending and the lists are disjoint (a row
+        // has one id), so merging list by list keeps `rows` sorted.
+        const auto listBegin = static_cast<std::ptrdiff_t>(rows.size());
+        leaf.index->ForEachRow(id, firstRow, endRow, [&rows](size_t row) { rows.push_back(row); });
+        std::inplace_merge(rows.begin(), std::next(rows.begin(), listBegin), rows.end());
+    }
+    return rows;
+}
+
+/// Where a run of rows stands against a range leaf, per its zone map.
+enum class ZoneVerdict : uint8_t
+{
+    /// No row can match.
+    None,
+    /// Every row matches.
+    All,
+    /// Needs the per-row check.
+    Some,
+};
+
+/// A `TimeRangeRowPredicate` / `NumericRangeRowPredicate` leaf whose
+/// column has a live zone map.
+struct ZonedLeaf
+{
+    const RowPredicate *predicate = nullptr;
+    const internal::ZoneMap *zones = nullptr;
+};
+
+std::optional<ZonedLeaf> ResolveZonedLeaf(const RowPredicate &predicate, const LogTable &table)
+{
+    if (!std::holds_alternative<TimeRangeRowPredicate>(predicate) &&
+        !std::holds_alternative<NumericRangeRowPredicate>(predicate))
+    {
+        return std::nullopt;
+    }
+    const internal::ZoneMap *zones = table.ColumnZoneMap(RowPredicateColumn(predicate));
+    if (zones == nullptr)
+    {
+        return std::nullopt;
+    }
+    return ZonedLeaf{.predicate = &predicate, .zones = zones};
+}
+
+/// @p predicate against one block summary. Must only answer `None` /
+/// `All` where `MatchesRow` would agree on every row the block covers.
+ZoneVerdict ClassifyZone(const RowPredicate &predicate, const internal::ZoneSummary &zone) noexcept
+{
+    if (const auto *time = std::get_if<TimeRangeRowPredicate>(&predicate); time != nullptr)
+    {
+        const int64_t begin = time->Begin();
+        const int64_t end = time->End();
+        if (begin > end || zone.timeRows == 0)
+        {
+            return ZoneVerdict::None;
+        }
+        if (zone.hasUnsignedTime && end < 0)
+        {
+            // `MatchesRow` clamps negative bounds to 0 for `Uint64`
+            // slots, so a `0` reading can match; leave it to the scan.
+            return ZoneVerdict::Some;
+        }
+        if (zone.maxMicros < begin || zone.minMicros > end)
+        {
+            return ZoneVerdict::None;
+        }
+        const bool inside = zone.minMicros >= begin && zone.maxMicros <= end;
+        return inside && zone.timeRows == zone.rows ? ZoneVerdict::All : ZoneVerdict::Some;
+    }
+    const auto *numeric = std::get_if<NumericRangeRowPredicate>(&predicate);
+    if (numeric == nullptr)
+    {
+        return ZoneVerdict::Some;
+    }
+    const std::optional<double> lo = numeric->MinValue();
+    const std::optional<double> hi = numeric->MaxValue();
+    if (zone.numberRows == 0 || (lo.has_value() && zone.maxNumber < *lo) || (hi.has_value() && zone.minNumber > *hi))
+    {
+        return ZoneVerdict::None;
+    }
+    const bool inside = (!lo.has_value() || zone.minNumber >= *lo) && (!hi.has_value() || zone.maxNumber <= *hi);
+    return inside && zone.numberRows == zone.rows ? ZoneVerdict::All : ZoneVerdict::Some;
+}
+
+/// @p leaf over rows `[firstRow, endRow)` (non-empty), folded across
+/// every block those rows touch.
+ZoneVerdict ClassifyRows(const ZonedLeaf &leaf, size_t firstRow, size_t endRow) noexcept
+{
+    const size_t lastBlock = leaf.zones->BlockOf(endRow - 1);
+    const ZoneVerdict first = ClassifyZone(*leaf.predicate, leaf.zones->Block(leaf.zones->BlockOf(firstRow)));
+    for (size_t block = leaf.zones->BlockOf(firstRow) + 1; block <= lastBlock && first != ZoneVerdict::Some; ++block)
+    {
+        if (ClassifyZone(*leaf.predicate, leaf.zones->Block(block)) != first)
+        {
+            return ZoneVerdict::Some;
+        }
+    }
+    return first;
+}
+
+/// A `CallbackStringRowPredicate` leaf narrowed by the table's
+/// trigram index.
+struct TrigramLeaf
+{
+    const RowPredicate *predicate = nullptr;
+    size_t column = 0;
+    internal::TrigramCandidates candidates;
+};
+
+std::optional<TrigramLeaf> ResolveTrigramLeaf(const RowPredicate &predicate, const LogTable &table)
+{
+    const auto *stringPredicate = std::get_if<CallbackStringRowPredicate>(&predicate);
+    if (stringPredicate == nullptr || stringPredicate->Trigrams().IsAll())
+    {
+        return std::nullopt;
+    }
+    std::optional<internal::TrigramCandidates> candidates = table.TrigramCandidatesFor(stringPredicate->Trigrams());
+    if (!candidates.has_value())
+    {
+        return std::nullopt;
+    }
+    return TrigramLeaf{
+        .predicate = &predicate, .column = stringPredicate->ColumnIndex(), .candidates = std::move(*candidates)
+    };
+}
+
+/// Whether @p row can satisfy @p leaf. Outside the candidate granules
+/// no string cell holds the query's trigrams, so only a cell the
+/// predicate sees as formatted text (number, time, bool) can match;
+/// an empty cell never does, as every non-`All` query needs a trigram.
+bool TrigramMayMatch(const TrigramLeaf &leaf, const LogTable &table, size_t row) noexcept
+{
+    if (leaf.candidates.Contains(row))
+    {
+        return true;
+    }
+    switch (table.GetCompactValue(row, leaf.column).tag)
+    {
+    case internal::CompactTag::Monostate:
+    case internal::CompactTag::MmapSlice:
+    case internal::CompactTag::OwnedString:
+    case internal::CompactTag::DictRef:
+        return false;
+    default:
+        return true;
+    }
+}
+
+/// First rows of the trigram granules `[firstRow, endRow)` touches, so
+/// workers can take whole granules.
+std::vector<size_t> TrigramGranuleStarts(const TrigramLeaf &leaf, size_t firstRow, size_t endRow)
+{
+    std::vector<size_t> starts;
+    starts.reserve(((endRow - firstRow) / internal::TrigramIndex::GRANULE_ROWS) + 2);
+    for (size_t row = firstRow; row < endRow; row = leaf.candidates.GranuleEndRow(row))
+    {
+        starts.push_back(row);
+    }
+    return starts;
+}
+
+/// Materialise @p predicate's accept-set over `[firstRow, firstRow +
+/// rowCount)` into a packed bitset in parallel; bit `i` is row
+/// `firstRow + i`. Each worker owns a private bitset; the main thread
 /// OR-coalesces at the end.
-RowBitset MaterialiseLeafBitset(const RowPredicate &predicate, const LogTable &table, size_t rowCount)
+RowBitset MaterialiseLeafBitset(const RowPredicate &predicate, const LogTable &table, size_t firstRow, size_t rowCount)
 {
+    if (const auto indexed = ResolveIndexedLeaf(predicate, table); indexed.has_value())
+    {
+        // Posting lists already are the accept-set; skip the scan.
+        RowBitset bitset(rowCount);
+        for (const EnumValueId id : indexed->ids)
+        {
+            indexed->index->ForEachRow(id, firstRow, firstRow + rowCount, [&bitset, firstRow](size_t row) {
+                bitset.Set(row - firstRow);
+            });
+        }
+        return bitset;
+    }
+
     tbb::enumerable_thread_specific<RowBitset> workerBitsets{[rowCount] { return RowBitset(rowCount); }};
-    tbb::parallel_for(
-        tbb::blocked_range<size_t>(0, rowCount),
-        [&predicate, &table, &workerBitsets](const tbb::blocked_range<size_t> &range) {
-            auto &local = workerBitsets.local();
-            for (size_t row = range.begin(); row != range.end(); ++row)
-            {
-                if (MatchesRow(predicate, table, row))
+    if (const auto trigram = ResolveTrigramLeaf(predicate, table); trigram.has_value() && rowCount != 0)
+    {
+        // Granule at a time, testing only rows the index leaves open.
+        const size_t endRow = firstRow + rowCount;
+        const std::vector<size_t> starts = TrigramGranuleStarts(*trigram, firstRow, endRow);
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, starts.size()),
+            [&predicate, &table, &workerBitsets, &trigram, &starts, firstRow, endRow](
+                const tbb::blocked_range<size_t> &range
+            ) {
+                auto &local = workerBitsets.local();
+                for (size_t slot = range.begin(); slot != range.end(); ++slot)
                 {
-                    local.Set(row);
+                    const size_t end = slot + 1 < starts.size() ? starts[slot + 1] : endRow;
+                    for (size_t row = starts[slot]; row < end; ++row)
+                    {
+                        if (TrigramMayMatch(*trigram, table, row) && MatchesRow(predicate, table, row))
+                        {
+                            local.Set(row - firstRow);
+                        }
+                    }
                 }
             }
-        }
-    );
+        );
+    }
+    else if (const auto zoned = ResolveZonedLeaf(predicate, table); zoned.has_value() && rowCount != 0)
+    {
+        // Block at a time: skip blocks the zone map rules out, fill
+        // wholly-matching ones without reading a slot.
+        const internal::ZoneMap &zones = *zoned->zones;
+        const size_t endRow = firstRow + rowCount;
+        const size_t firstBlock = zones.BlockOf(firstRow);
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(firstBlock, zones.BlockOf(endRow - 1) + 1, 1),
+            [&predicate, &table, &workerBitsets, &zones, firstRow, endRow](const tbb::blocked_range<size_t> &range) {
+                auto &local = workerBitsets.local();
+                for (size_t block = range.begin(); block != range.end(); ++block)
+                {
+                    const size_t begin = std::max(zones.BlockFirstRow(block), firstRow);
+                    const size_t end = std::min(zones.BlockEndRow(block), endRow);
+                    const ZoneVerdict verdict = ClassifyZone(predicate, zones.Block(block));
+                    if (verdict == ZoneVerdict::All)
+                    {
+                        local.SetRange(begin - firstRow, end - firstRow);
+                        continue;
+                    }
+                    for (size_t row = begin; verdict == ZoneVerdict::Some && row < end; ++row)
+                    {
+                        if (MatchesRow(predicate, table, row))
+                        {
+                            local.Set(row - firstRow);
+                        }
+                    }
+                }
+            }
+        );
+    }
+    else
+    {
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(firstRow, firstRow + rowCount),
+            [&predicate, &table, &workerBitsets, firstRow](const tbb::blocked_range<size_t> &range) {
+                auto &local = workerBitsets.local();
+                for (size_t row = range.begin(); row != range.end(); ++row)
+                {
+                    if (MatchesRow(predicate, table, row))
+                    {
+                        local.Set(row - firstRow);
+                    }
+                }
+            }
+        );
+    }
 
     // Seed from the first worker (move: skip zero-init + full OR),
     // fold the rest. No workers = no rows, return empty.
@@ -813,11 +1124,240 @@ void CollectLeafsInVisitOrder(const CompiledFilterExpression &expr, std::vector<
     );
 }
 
+/// Cheapest `IndexedLeaf` every accepted row must satisfy: @p expr
+/// itself when it is a leaf, else a direct leaf child of a top-level
+/// `And`. Deeper leaves are left to the bitset path.
+std::optional<IndexedLeaf> FindRequiredIndexedLeaf(const CompiledFilterExpression &expr, const LogTable &table)
+{
+    if (const auto *leaf = std::get_if<CompiledFilterExpression::Leaf>(&expr.node); leaf != nullptr)
+    {
+        return ResolveIndexedLeaf(leaf->predicate, table);
+    }
+    const auto *conjunction = std::get_if<CompiledFilterExpression::And>(&expr.node);
+    if (conjunction == nullptr)
+    {
+        return std::nullopt;
+    }
+    std::optional<IndexedLeaf> best;
+    for (const CompiledFilterExpression &child : conjunction->children)
+    {
+        const auto *leaf = std::get_if<CompiledFilterExpression::Leaf>(&child.node);
+        if (leaf == nullptr)
+        {
+            continue;
+        }
+        auto indexed = ResolveIndexedLeaf(leaf->predicate, table);
+        if (indexed.has_value() && (!best.has_value() || indexed->postings < best->postings))
+        {
+            best = std::move(indexed);
+        }
+    }
+    return best;
+}
+
+/// Zoned range leaves every accepted row must satisfy: @p expr itself
+/// when it is a leaf, else the direct leaf children of a top-level
+/// `And`. @p conjuncts receives how many conjuncts they came from, so
+/// the caller knows whether the leaves alone decide a row.
+std::vector<ZonedLeaf> FindRequiredZonedLeaves(
+    const CompiledFilterExpression &expr, const LogTable &table, size_t &conjuncts
+)
+{
+    std::vector<ZonedLeaf> leaves;
+    conjuncts = 1;
+    if (const auto *leaf = std::get_if<CompiledFilterExpression::Leaf>(&expr.node); leaf != nullptr)
+    {
+        if (auto zoned = ResolveZonedLeaf(leaf->predicate, table); zoned.has_value())
+        {
+            leaves.push_back(*zoned);
+        }
+        return leaves;
+    }
+    const auto *conjunction = std::get_if<CompiledFilterExpression::And>(&expr.node);
+    if (conjunction == nullptr)
+    {
+        return leaves;
+    }
+    conjuncts = conjunction->children.size();
+    for (const CompiledFilterExpression &child : conjunction->children)
+    {
+        const auto *leaf = std::get_if<CompiledFilterExpression::Leaf>(&child.node);
+        if (leaf == nullptr)
+        {
+            continue;
+        }
+        if (auto zoned = ResolveZonedLeaf(leaf->predicate, table); zoned.has_value())
+        {
+            leaves.push_back(*zoned);
+        }
+    }
+    return leaves;
+}
+
+/// Cheapest `TrigramLeaf` every accepted row must satisfy, picked like
+/// `FindRequiredIndexedLeaf`: by fewest candidate granules.
+std::optional<TrigramLeaf> FindRequiredTrigramLeaf(const CompiledFilterExpression &expr, const LogTable &table)
+{
+    if (const auto *leaf = std::get_if<CompiledFilterExpression::Leaf>(&expr.node); leaf != nullptr)
+    {
+        return ResolveTrigramLeaf(leaf->predicate, table);
+    }
+    const auto *conjunction = std::get_if<CompiledFilterExpression::And>(&expr.node);
+    if (conjunction == nullptr)
+    {
+        return std::nullopt;
+    }
+    std::optional<TrigramLeaf> best;
+    for (const CompiledFilterExpression &child : conjunction->children)
+    {
+        const auto *leaf = std::get_if<CompiledFilterExpression::Leaf>(&child.node);
+        if (leaf == nullptr)
+        {
+            continue;
+        }
+        auto resolved = ResolveTrigramLeaf(leaf->predicate, table);
+        if (resolved.has_value() &&
+            (!best.has_value() ||
+             resolved->candidates.CandidateGranuleCount() < best->candidates.CandidateGranuleCount()))
+        {
+            best = std::move(resolved);
+        }
+    }
+    return best;
+}
+
+/// Rows in `[firstRow, endRow)` accepted by @p expression, granule by
+/// granule: the tree is only evaluated on rows @p leaf may match.
+std::vector<size_t> CollectTrigramRows(
+    const LogTable &table,
+    const CompiledFilterExpression &expression,
+    const TrigramLeaf &leaf,
+    size_t firstRow,
+    size_t endRow
+)
+{
+    const std::vector<size_t> starts = TrigramGranuleStarts(leaf, firstRow, endRow);
+    std::vector<std::vector<size_t>> granuleRows(starts.size());
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, starts.size()),
+        [&table, &expression, &leaf, &starts, &granuleRows, endRow](const tbb::blocked_range<size_t> &range) {
+            for (size_t slot = range.begin(); slot != range.end(); ++slot)
+            {
+                const size_t end = slot + 1 < starts.size() ? starts[slot + 1] : endRow;
+                std::vector<size_t> &rows = granuleRows[slot];
+                for (size_t row = starts[slot]; row < end; ++row)
+                {
+                    if (TrigramMayMatch(leaf, table, row) && EvaluateExpression(expression, table, row))
+                    {
+                        rows.push_back(row);
+                    }
+                }
+            }
+        }
+    );
+
+    size_t total = 0;
+    for (const auto &rows : granuleRows)
+    {
+        total += rows.size();
+    }
+    std::vector<size_t> accepted;
+    accepted.reserve(total);
+    for (const auto &rows : granuleRows)
+    {
+        accepted.insert(accepted.end(), rows.begin(), rows.end());
+    }
+    return accepted;
+}
+
+/// Rows in `[firstRow, endRow)` accepted by @p expression, walking the
+/// first leaf's zone-map blocks: a block any of @p leaves rules out is
+/// skipped, one they all wholly accept is taken as-is when they are the
+/// whole conjunction, and the rest are evaluated row by row. Other
+/// leaves fold their own blocks over the same rows, since a map rebuilt
+/// after eviction need not share the first one's alignment.
+std::vector<size_t> CollectZonedRows(
+    const LogTable &table,
+    const CompiledFilterExpression &expression,
+    const std::vector<ZonedLeaf> &leaves,
+    bool leavesDecide,
+    size_t firstRow,
+    size_t endRow
+)
+{
+    const internal::ZoneMap &zones = *leaves.front().zones;
+    const size_t firstBlock = zones.BlockOf(firstRow);
+    std::vector<std::vector<size_t>> blockRows(zones.BlockOf(endRow - 1) + 1 - firstBlock);
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, blockRows.size(), 1),
+        [&table, &expression, &leaves, &zones, &blockRows, leavesDecide, firstBlock, firstRow, endRow](
+            const tbb::blocked_range<size_t> &range
+        ) {
+            for (size_t slot = range.begin(); slot != range.end(); ++slot)
+            {
+                const size_t begin = std::max(zones.BlockFirstRow(firstBlock + slot), firstRow);
+                const size_t end = std::min(zones.BlockEndRow(firstBlock + slot), endRow);
+                bool skip = false;
+                bool all = true;
+                for (const ZonedLeaf &leaf : leaves)
+                {
+                    const ZoneVerdict verdict = ClassifyRows(leaf, begin, end);
+                    skip = verdict == ZoneVerdict::None;
+                    all = all && verdict == ZoneVerdict::All;
+                    if (skip)
+                    {
+                        break;
+                    }
+                }
+                if (skip)
+                {
+                    continue;
+                }
+                std::vector<size_t> &rows = blockRows[slot];
+                if (all && leavesDecide)
+                {
+                    rows.resize(end - begin);
+                    std::iota(rows.begin(), rows.end(), begin);
+                    continue;
+                }
+                for (size_t row = begin; row < end; ++row)
+                {
+                    if (EvaluateExpression(expression, table, row))
+                    {
+                        rows.push_back(row);
+                    }
+                }
+            }
+        }
+    );
+
+    size_t total = 0;
+    for (const auto &rows : blockRows)
+    {
+        total += rows.size();
+    }
+    std::vector<size_t> accepted;
+    accepted.reserve(total);
+    for (const auto &rows : blockRows)
+    {
+        accepted.insert(accepted.end(), rows.begin(), rows.end());
+    }
+    return accepted;
+}
+
 } // namespace
 
 std::vector<size_t> FilterAcceptedRows(const LogTable &table, const CompiledFilterExpression &expression)
 {
-    const size_t rowCount = table.RowCount();
+    return FilterAcceptedRows(table, expression, 0, table.RowCount());
+}
+
+std::vector<size_t> FilterAcceptedRows(
+    const LogTable &table, const CompiledFilterExpression &expression, size_t firstRow, size_t endRow
+)
+{
+    endRow = std::min(endRow, table.RowCount());
+    const size_t rowCount = endRow > firstRow ? endRow - firstRow : 0;
     std::vector<size_t> accepted;
 
     if (IsMatchAllCompiled(expression))
@@ -825,7 +1365,7 @@ std::vector<size_t> FilterAcceptedRows(const LogTable &table, const CompiledFilt
         // Identity case: hand back every row so callers share one
         // code path with the filtered case.
         accepted.resize(rowCount);
-        std::iota(accepted.begin(), accepted.end(), size_t{0});
+        std::iota(accepted.begin(), accepted.end(), firstRow);
         return accepted;
     }
 
@@ -834,6 +1374,48 @@ std::vector<size_t> FilterAcceptedRows(const LogTable &table, const CompiledFilt
         return accepted;
     }
 
+    if (auto indexed = FindRequiredIndexedLeaf(expression, table); indexed.has_value())
+    {
+        accepted = CollectIndexedRows(*indexed, firstRow, endRow);
+        if (std::holds_alternative<CompiledFilterExpression::Leaf>(expression.node))
+        {
+            return accepted;
+        }
+        // The postings bound the accept-set; evaluate the full tree on
+        // just those rows. Flags keep the compaction in row order.
+        std::vector<uint8_t> keep(accepted.size(), 0U);
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, accepted.size()),
+            [&table, &expression, &accepted, &keep](const tbb::blocked_range<size_t> &range) {
+                for (size_t i = range.begin(); i != range.end(); ++i)
+                {
+                    keep[i] = EvaluateExpression(expression, table, accepted[i]) ? 1U : 0U;
+                }
+            }
+        );
+        size_t kept = 0;
+        for (size_t i = 0; i < accepted.size(); ++i)
+        {
+            if (keep[i] != 0U)
+            {
+                accepted[kept++] = accepted[i];
+            }
+        }
+        accepted.resize(kept);
+        return accepted;
+    }
+
+    size_t conjuncts = 0;
+    if (const auto zoned = FindRequiredZonedLeaves(expression, table, conjuncts); !zoned.empty())
+    {
+        return CollectZonedRows(table, expression, zoned, zoned.size() == conjuncts, firstRow, endRow);
+    }
+
+    if (const auto trigram = FindRequiredTrigramLeaf(expression, table); trigram.has_value())
+    {
+        return CollectTrigramRows(table, expression, *trigram, firstRow, endRow);
+    }
+
     // Shape drives evaluator choice. Visit is always safe; bitset
     // is the perf win on complex trees.
     TreeShape shape;
@@ -870,20 +1452,20 @@ std::vector<size_t> FilterAcceptedRows(const LogTable &table, const CompiledFilt
         leafBitsets.reserve(uniquePredicates.size());
         for (const RowPredicate *predicate : uniquePredicates)
         {
-            leafBitsets.push_back(MaterialiseLeafBitset(*predicate, table, rowCount));
+            leafBitsets.push_back(MaterialiseLeafBitset(*predicate, table, firstRow, rowCount));
         }
 
         size_t leafCursor = 0;
         const RowBitset resultBitset =
             EvaluateExpressionBitset(expression, leafBitsets, leafSlots, leafCursor, rowCount);
-        resultBitset.CollectInto(accepted);
+        resultBitset.CollectInto(accepted, firstRow);
         return accepted;
     }
 
     // Visit path: parallel-for over rows, each row walks the tree.
     tbb::enumerable_thread_specific<std::vector<size_t>> buckets;
     tbb::parallel_for(
-        tbb::blocked_range<size_t>(0, rowCount),
+        tbb::blocked_range<size_t>(firstRow, endRow),
         [&table, &expression, &buckets](const tbb::blocked_range<size_t> &range) {
             auto &local = buckets.local();
             local.reserve(local.size() + range.size());
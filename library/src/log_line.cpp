@@ -1,6 +1,7 @@
 #include "loglib/log_line.hpp"
 
 #include "loglib/internal/compact_log_value.hpp"
+#include "loglib/internal/row_shape.hpp"
 #include "loglib/line_source.hpp"
 
 #include <algorithm>
@@ -165,15 +166,18 @@ LogLine::LogLine(
     LineSource &source,
     size_t lineId
 )
-    : mValues(static_cast<uint32_t>(sortedValues.size())), mKeys(&keys), mSource(&source), mLineId(lineId)
+    : mKeys(&keys), mSource(&source), mLineId(lineId)
 {
 #ifndef NDEBUG
     assert(std::ranges::is_sorted(sortedValues, [](const auto &a, const auto &b) { return a.first < b.first; }));
 #endif
+    std::vector<std::pair<KeyId, internal::CompactLogValue>> staging;
+    staging.reserve(sortedValues.size());
     for (auto &entry : sortedValues)
     {
-        mValues.EmplaceBack(entry.first, MakeCompactFromVariant(source, lineId, entry.second));
+        staging.emplace_back(entry.first, MakeCompactFromVariant(source, lineId, entry.second));
     }
+    AssignFields(staging);
 }
 
 LogLine::LogLine(
@@ -187,12 +191,11 @@ LogLine::LogLine(
 #ifndef NDEBUG
     assert(std::ranges::is_sorted(sortedValues, [](const auto &a, const auto &b) { return a.first < b.first; }));
 #endif
-    // Exact-fit copy keeps each LogLine at `size * 16` bytes.
-    mValues.AssignSorted(sortedValues.data(), static_cast<uint32_t>(sortedValues.size()));
+    AssignFields(sortedValues);
 }
 
 LogLine::LogLine(const LogMap &values, KeyIndex &keys, LineSource &source, size_t lineId)
-    : mValues(static_cast<uint32_t>(values.size())), mKeys(&keys), mSource(&source), mLineId(lineId)
+    : mKeys(&keys), mSource(&source), mLineId(lineId)
 {
     std::vector<std::pair<KeyId, internal::CompactLogValue>> staging;
     staging.reserve(values.size());
@@ -201,12 +204,17 @@ LogLine::LogLine(const LogMap &values, KeyIndex &keys, LineSource &source, size_
         staging.emplace_back(keys.GetOrInsert(key), MakeCompactFromVariant(source, lineId, value));
     }
     std::ranges::sort(staging, [](const auto &a, const auto &b) { return a.first < b.first; });
-    mValues.AssignSorted(staging.data(), static_cast<uint32_t>(staging.size()));
+    AssignFields(staging);
 }
 
 const internal::CompactLogValue *LogLine::FindCompact(KeyId id) const noexcept
 {
-    // Linear scan; lines are tiny and sorted, with an early bail.
+    if (mShape != nullptr)
+    {
+        const uint16_t slot = mShape->SlotOf(id);
+        return slot != internal::RowShape::NO_SLOT ? &mValues.ShapedData()[slot] : nullptr;
+    }
+    // Unshaped row: linear scan; sorted, with an early bail.
     const auto *data = mValues.Data();
     const uint32_t size = mValues.Size();
     for (uint32_t i = 0; i < size; ++i)
@@ -321,28 +329,33 @@ void LogLine::SetOrReplaceEnumDictRef(KeyId id, EnumValueId vid)
 
 void LogLine::SetCompact(KeyId id, internal::CompactLogValue compact)
 {
-    auto *data = mValues.Data();
-    const uint32_t size = mValues.Size();
-    uint32_t lo = 0;
-    uint32_t hi = size;
-    while (lo < hi)
+    if (internal::CompactLogValue *slot = FindCompactMutable(id))
     {
-        const uint32_t mid = lo + ((hi - lo) / 2U);
-        if (data[mid].first < id)
-        {
-            lo = mid + 1U;
-        }
-        else
-        {
-            hi = mid;
-        }
+        *slot = compact;
+        return;
     }
-    if (lo < size && data[lo].first == id)
+    // New key: the row changes shape, so rebuild its fields from the
+    // KeyId-labelled view (the shaped layout has no room to insert).
+    const internal::CompactFieldsView current = CompactValues();
+    std::vector<std::pair<KeyId, internal::CompactLogValue>> staging(current.begin(), current.end());
+    const auto it = std::ranges::lower_bound(staging, id, {}, &std::pair<KeyId, internal::CompactLogValue>::first);
+    staging.emplace(it, id, compact);
+    AssignFields(staging);
+}
+
+void LogLine::AssignFields(std::span<const std::pair<KeyId, internal::CompactLogValue>> sortedValues)
+{
+    mShape = mKeys != nullptr ? internal::InternRowShape(*mKeys, sortedValues) : nullptr;
+    const auto count = static_cast<uint32_t>(sortedValues.size());
+    if (mShape != nullptr)
     {
-        mValues.Set(lo, compact);
-        return;
+        mValues.AssignShaped(sortedValues.data(), count);
+    }
+    else
+    {
+        // Exact-fit copy keeps each LogLine at `size * 24` bytes.
+        mValues.AssignSorted(sortedValues.data(), count);
     }
-    mValues.Insert(lo, id, compact);
 }
 
 std::vector<std::string> LogLine::GetKeys() const
@@ -353,9 +366,9 @@ std::vector<std::string> LogLine::GetKeys() const
     {
         return keys;
     }
-    for (uint32_t i = 0; i < mValues.Size(); ++i)
+    for (const auto &entry : CompactValues())
     {
-        keys.emplace_back(mKeys->KeyOf(mValues.Data()[i].first));
+        keys.emplace_back(mKeys->KeyOf(entry.first));
     }
     return keys;
 }
@@ -364,16 +377,19 @@ std::vector<std::pair<KeyId, LogValue>> LogLine::IndexedValues() const
 {
     std::vector<std::pair<KeyId, LogValue>> result;
     result.reserve(mValues.Size());
-    for (uint32_t i = 0; i < mValues.Size(); ++i)
+    for (const auto &[id, compact] : CompactValues())
     {
-        const auto &entry = mValues.Data()[i];
-        result.emplace_back(entry.first, entry.second.Materialise(mSource, mLineId, entry.first));
+        result.emplace_back(id, compact.Materialise(mSource, mLineId, id));
     }
     return result;
 }
 
-std::span<const std::pair<KeyId, internal::CompactLogValue>> LogLine::CompactValues() const noexcept
+internal::CompactFieldsView LogLine::CompactValues() const noexcept
 {
+    if (mShape != nullptr)
+    {
+        return {mShape->Keys().data(), mValues.ShapedData(), mValues.Size()};
+    }
     return {mValues.Data(), mValues.Size()};
 }
 
@@ -385,19 +401,37 @@ LogMap LogLine::Values() const
     {
         return snapshot;
     }
-    for (uint32_t i = 0; i < mValues.Size(); ++i)
+    for (const auto &[id, compact] : CompactValues())
     {
-        const auto &entry = mValues.Data()[i];
-        snapshot.emplace(
-            std::string(mKeys->KeyOf(entry.first)), entry.second.Materialise(mSource, mLineId, entry.first)
-        );
+        snapshot.emplace(std::string(mKeys->KeyOf(id)), compact.Materialise(mSource, mLineId, id));
     }
     return snapshot;
 }
 
 void LogLine::RebindKeys(const KeyIndex &keys)
 {
+    // A moved `KeyIndex` keeps its registry (and our shape).
+    if (keys.Shapes().Owns(mShape))
+    {
+        mKeys = &keys;
+        return;
+    }
+    // Otherwise the key set must be interned on the new index's side.
+    // Copy the fields out first: a shaped view reads its KeyIds from the
+    // old shape, and `AssignFields` may free the buffer it reads.
+    if (mShape == nullptr)
+    {
+        mKeys = &keys;
+        const std::span<const std::pair<KeyId, internal::CompactLogValue>> fields(mValues.Data(), mValues.Size());
+        if (internal::InternRowShape(keys, fields) == nullptr)
+        {
+            return;
+        }
+    }
+    const internal::CompactFieldsView current = CompactValues();
+    const std::vector<std::pair<KeyId, internal::CompactLogValue>> staging(current.begin(), current.end());
     mKeys = &keys;
+    AssignFields(staging);
 }
 
 const KeyIndex &LogLine::Keys() const
@@ -441,7 +475,14 @@ void LogLine::RebaseOwnedStringOffsets(uint64_t delta) noexcept
     {
         return;
     }
-    internal::RebaseOwnedStringOffsets(mValues.Data(), mValues.Size(), delta);
+    if (mValues.IsShaped())
+    {
+        internal::RebaseOwnedStringOffsets(mValues.ShapedData(), mValues.Size(), delta);
+    }
+    else
+    {
+        internal::RebaseOwnedStringOffsets(mValues.Data(), mValues.Size(), delta);
+    }
 }
 
 bool LogLine::IsMmapSlice(KeyId id) const noexcept
@@ -0,0 +1,77 @@
+#include "loglib/log_line_store.hpp"
+
+#include <iterator>
+#include <utility>
+
+namespace loglib
+{
+
+LogLineStore::LogLineStore(std::vector<LogLine> lines)
+{
+    reserve(lines.size());
+    for (LogLine &line : lines)
+    {
+        push_back(std::move(line));
+    }
+}
+
+void LogLineStore::push_back(LogLine &&line)
+{
+    if (mChunks.empty() || mChunks.back().size() == CHUNK_ROWS)
+    {
+        // Only the tail chunk grows geometrically; full chunks are
+        // never reallocated, so earlier rows keep their addresses.
+        mChunks.emplace_back();
+        if (mChunks.size() > 1)
+        {
+            mChunks.back().reserve(CHUNK_ROWS);
+        }
+    }
+    mChunks.back().push_back(std::move(line));
+    ++mSize;
+}
+
+void LogLineStore::reserve(size_t rows)
+{
+    mChunks.reserve(((mHead + rows) >> CHUNK_SHIFT) + 1);
+}
+
+void LogLineStore::clear() noexcept
+{
+    mChunks.clear();
+    mHead = 0;
+    mSize = 0;
+}
+
+void LogLineStore::EraseFront(size_t count)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    if (count >= mSize)
+    {
+        clear();
+        return;
+    }
+    const size_t slot = mHead + count;
+    const size_t droppedChunks = slot >> CHUNK_SHIFT;
+    if (droppedChunks > 0)
+    {
+        mChunks.erase(mChunks.begin(), std::next(mChunks.begin(), static_cast<std::ptrdiff_t>(droppedChunks)));
+    }
+    mHead = slot & (CHUNK_ROWS - 1);
+    mSize -= count;
+}
+
+size_t LogLineStore::MemoryBytes() const noexcept
+{
+    size_t bytes = mChunks.capacity() * sizeof(std::vector<LogLine>);
+    for (const std::vector<LogLine> &chunk : mChunks)
+    {
+        bytes += chunk.capacity() * sizeof(LogLine);
+    }
+    return bytes;
+}
+
+} // namespace loglib
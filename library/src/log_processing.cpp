@@ -556,6 +556,27 @@ void BackfillTimestampColumn(
     }
 }
 
+std::vector<std::string> BackfillTimestampColumn(
+    const LogConfiguration::Column &column, LogLineStore &lines, size_t first
+)
+{
+    std::vector<std::string> errors;
+    lines.ForEachSegment(first, lines.size(), [&](std::span<LogLine> segment) {
+        std::vector<std::string> segmentErrors = BackfillTimestampColumn(column, segment);
+        std::ranges::move(segmentErrors, std::back_inserter(errors));
+    });
+    return errors;
+}
+
+void BackfillTimestampColumn(
+    const LogConfiguration::Column &column, LogLineStore &lines, size_t first, BackfillErrors discardErrors
+)
+{
+    lines.ForEachSegment(first, lines.size(), [&](std::span<LogLine> segment) {
+        BackfillTimestampColumn(column, segment, discardErrors);
+    });
+}
+
 std::vector<std::string> ParseTimestamps(LogData &logData, const LogConfiguration &configuration)
 {
     std::vector<std::string> errors;
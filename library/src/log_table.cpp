@@ -7,12 +7,17 @@
 #include <date/date.h>
 #include <date/tz.h>
 #include <fmt/format.h>
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/enumerable_thread_specific.h>
+#include <oneapi/tbb/parallel_for.h>
+#include <oneapi/tbb/parallel_reduce.h>
 
 #include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cstdio>
 #include <iterator>
+#include <limits>
 #include <optional>
 #include <span>
 #include <string>
@@ -109,6 +114,28 @@ bool IsEnumPassEligible(const LogConfiguration::Column &column) noexcept
     return column.type == LogConfiguration::Type::Any && column.autoDetect;
 }
 
+/// Call @p visit with the text of every string field of @p line:
+/// string slots by their bytes, `DictRef` slots resolved through
+/// @p dictionaries.
+template <typename Visit>
+void ForEachStringField(const LogLine &line, const EnumDictionaryRegistry &dictionaries, Visit &&visit)
+{
+    for (const auto &[id, slot] : line.CompactValues())
+    {
+        if (slot.tag == internal::CompactTag::DictRef)
+        {
+            if (const EnumDictionary *dictionary = dictionaries.Find(id); dictionary != nullptr)
+            {
+                visit(dictionary->Resolve(static_cast<EnumValueId>(slot.payload)));
+            }
+        }
+        else if (const std::optional<std::string_view> bytes = line.PeekStringView(slot); bytes.has_value())
+        {
+            visit(*bytes);
+        }
+    }
+}
+
 } // namespace
 
 bool LogTable::EnumColumnHealth::ShouldDemote(double tolerance, size_t minSamples) const noexcept
@@ -201,7 +228,12 @@ LogTable::LogTable(LogTable &&other) noexcept
       mLastBackfillRange(std::move(other.mLastBackfillRange)),
       mLastBatchDemotedKeys(std::move(other.mLastBatchDemotedKeys)),
       mLevelRankCache(std::move(other.mLevelRankCache)),
-      mPendingLevelBubbleKeys(std::move(other.mPendingLevelBubbleKeys))
+      mPendingLevelBubbleKeys(std::move(other.mPendingLevelBubbleKeys)),
+      mColumnStore(std::move(other.mColumnStore)),
+      mEnumIndexes(std::move(other.mEnumIndexes)),
+      mZoneMaps(std::move(other.mZoneMaps)),
+      mTrigramIndex(std::move(other.mTrigramIndex)),
+      mTrigramIndexEnabled(other.mTrigramIndexEnabled)
 {
     other.mIsStreaming = false;
     other.mLastBatchDemotedKeys.clear();
@@ -234,6 +266,11 @@ LogTable &LogTable::operator=(LogTable &&other) noexcept
     mLevelRankCache = std::move(other.mLevelRankCache);
     mPendingLevelBubbleKeys = std::move(other.mPendingLevelBubbleKeys);
     other.mPendingLevelBubbleKeys.clear();
+    mColumnStore = std::move(other.mColumnStore);
+    mEnumIndexes = std::move(other.mEnumIndexes);
+    mZoneMaps = std::move(other.mZoneMaps);
+    mTrigramIndex = std::move(other.mTrigramIndex);
+    mTrigramIndexEnabled = other.mTrigramIndexEnabled;
     // Each `LineSource` cached `&other.mEnumDictionaries`; rebind to ours.
     RewireSourceRegistries();
     return *this;
@@ -263,6 +300,10 @@ void LogTable::Update(LogData &&data)
     // Same rationale as the ctor: static-load path, caller resets
     // the model afterward, so the bubble can land inline.
     ApplyPendingLevelBubbles();
+    SyncColumnarStorage();
+    SyncEnumIndexes();
+    SyncZoneMaps();
+    SyncTrigramIndex();
 }
 
 void LogTable::Reset()
@@ -286,6 +327,10 @@ void LogTable::Reset()
     // instead of `nullptr`. Also rebuilds any cache invalidated by a
     // freshly-loaded `levelMapping`.
     RefreshSnapshotEnumKeys();
+    SyncColumnarStorage();
+    SyncEnumIndexes();
+    SyncZoneMaps();
+    SyncTrigramIndex();
 }
 
 void LogTable::OnConfigurationReloaded()
@@ -299,6 +344,9 @@ void LogTable::OnConfigurationReloaded()
     // keys are invariant under reorder.
     RefreshColumnKeyIds();
     RefreshSnapshotEnumKeys();
+    SyncColumnarStorage();
+    SyncEnumIndexes();
+    SyncZoneMaps();
 }
 
 void LogTable::BeginStreaming(std::unique_ptr<LineSource> source)
@@ -333,6 +381,10 @@ void LogTable::BeginStreaming(std::unique_ptr<LineSource> source)
     RefreshSnapshotTimeKeys();
     RefreshSnapshotEnumKeys();
     RefreshColumnKeyIds();
+    SyncColumnarStorage();
+    SyncEnumIndexes();
+    SyncZoneMaps();
+    SyncTrigramIndex();
 }
 
 void LogTable::AppendStreaming(std::unique_ptr<LineSource> source)
@@ -427,7 +479,8 @@ void LogTable::AppendBatch(StreamedBatch batch)
         // Streaming has no consumer for per-line errors.
         if (firstObservation)
         {
-            BackfillTimestampColumn(column, std::span<LogLine>(mData.Lines()), BackfillErrors::Discard);
+            InvalidateColumnarColumn(columnIndex);
+            BackfillTimestampColumn(column, mData.Lines(), 0, BackfillErrors::Discard);
             for (const KeyId id : columnKeyIds)
             {
                 if (id != INVALID_KEY_ID)
@@ -445,10 +498,7 @@ void LogTable::AppendBatch(StreamedBatch batch)
         {
             if (oldLineCount < mData.Lines().size())
             {
-                const std::span<LogLine> slice(
-                    mData.Lines().data() + oldLineCount, mData.Lines().size() - oldLineCount
-                );
-                BackfillTimestampColumn(column, slice, BackfillErrors::Discard);
+                BackfillTimestampColumn(column, mData.Lines(), oldLineCount, BackfillErrors::Discard);
             }
         }
     }
@@ -459,6 +509,10 @@ void LogTable::AppendBatch(StreamedBatch batch)
     {
         mLastBackfillRange = std::make_pair(*firstBackfilled, *lastBackfilled);
     }
+    SyncColumnarStorage();
+    SyncEnumIndexes();
+    SyncZoneMaps();
+    SyncTrigramIndex();
 }
 
 LogTable::AppendBatchPreview LogTable::PreviewAppend(const StreamedBatch &batch) const
@@ -487,6 +541,9 @@ void LogTable::MoveColumn(size_t srcIndex, size_t destIndex)
         return;
     }
     mConfiguration.MoveColumn(srcIndex, destIndex);
+    mColumnStore.MoveColumn(srcIndex, destIndex);
+    mEnumIndexes.MoveColumn(srcIndex, destIndex);
+    mZoneMaps.MoveColumn(srcIndex, destIndex);
     using Diff = std::vector<std::vector<KeyId>>::difference_type;
     auto begin = mColumnKeyIds.begin();
     if (srcIndex > destIndex)
@@ -535,6 +592,26 @@ LogValue LogTable::GetValue(size_t row, size_t column) const
     {
         return std::monostate{};
     }
+    if (const internal::DenseColumn *dense = ColumnarView(column); dense != nullptr)
+    {
+        // Non-string slots materialise without the row's source; only
+        // strings and `DictRef`s need the `LogLine` walk below.
+        switch (dense->Tag(row))
+        {
+        case internal::CompactTag::Monostate:
+            return std::monostate{};
+        case internal::CompactTag::Int64:
+        case internal::CompactTag::Uint64:
+        case internal::CompactTag::Double:
+        case internal::CompactTag::Bool:
+        case internal::CompactTag::Timestamp:
+            return dense->Slot(row).Materialise(nullptr, 0);
+        case internal::CompactTag::MmapSlice:
+        case internal::CompactTag::OwnedString:
+        case internal::CompactTag::DictRef:
+            break;
+        }
+    }
     const auto &line = mData.Lines()[row];
     for (const KeyId id : mColumnKeyIds[column])
     {
@@ -627,6 +704,233 @@ LogData &LogTable::Data() noexcept
     return mData;
 }
 
+void LogTable::SetColumnarStorage(bool enabled)
+{
+    // Always drop first: re-enabling rebuilds from scratch, so a caller
+    // that rewrote rows through `Data()` gets a faithful mirror back.
+    mColumnStore.SetEnabled(false);
+    if (enabled)
+    {
+        mColumnStore.SetEnabled(true);
+        SyncColumnarStorage();
+    }
+}
+
+bool LogTable::ColumnarStorageEnabled() const noexcept
+{
+    return mColumnStore.Enabled();
+}
+
+const internal::DenseColumn *LogTable::ColumnarView(size_t column) const noexcept
+{
+    if (!mColumnStore.Enabled() || column >= mColumnStore.ColumnCount())
+    {
+        return nullptr;
+    }
+    const internal::DenseColumn &dense = mColumnStore.Column(column);
+    // Every public mutator re-syncs before returning, so a short
+    // column only shows up mid-mutation (appended rows not mirrored
+    // yet, or a column invalidated ahead of a rewrite). Readers fall
+    // back to the row walk there.
+    return dense.Size() == mData.Lines().size() ? &dense : nullptr;
+}
+
+size_t LogTable::ColumnarMemoryBytes() const noexcept
+{
+    return mColumnStore.Enabled() ? mColumnStore.MemoryBytes() : 0;
+}
+
+void LogTable::SetEnumIndexes(bool enabled)
+{
+    // Same drop-then-rebuild contract as `SetColumnarStorage`.
+    mEnumIndexes.SetEnabled(false);
+    if (enabled)
+    {
+        mEnumIndexes.SetEnabled(true);
+        SyncEnumIndexes();
+    }
+}
+
+bool LogTable::EnumIndexesEnabled() const noexcept
+{
+    return mEnumIndexes.Enabled();
+}
+
+const internal::EnumPostingIndex *LogTable::EnumIndex(size_t column) const noexcept
+{
+    if (!mEnumIndexes.Enabled() || column >= mEnumIndexes.ColumnCount() || column >= mColumnKeyIds.size())
+    {
+        return nullptr;
+    }
+    // Ids are only meaningful against the dictionary and alias keys
+    // the index was built from; anything else waits for the next sync.
+    const EnumDictionary *dictionary = ResolveEnumColumn(column).dictionary;
+    if (dictionary == nullptr || mEnumIndexes.ColumnDictionary(column) != dictionary ||
+        mEnumIndexes.ColumnKeys(column) != mColumnKeyIds[column])
+    {
+        return nullptr;
+    }
+    const internal::EnumPostingIndex &index = mEnumIndexes.Index(column);
+    return index.Size() == mData.Lines().size() ? &index : nullptr;
+}
+
+size_t LogTable::EnumIndexMemoryBytes() const noexcept
+{
+    return mEnumIndexes.Enabled() ? mEnumIndexes.MemoryBytes() : 0;
+}
+
+void LogTable::SetZoneMaps(bool enabled)
+{
+    // Same drop-then-rebuild contract as `SetColumnarStorage`.
+    mZoneMaps.SetEnabled(false);
+    if (enabled)
+    {
+        mZoneMaps.SetEnabled(true);
+        SyncZoneMaps();
+    }
+}
+
+bool LogTable::ZoneMapsEnabled() const noexcept
+{
+    return mZoneMaps.Enabled();
+}
+
+const internal::ZoneMap *LogTable::ColumnZoneMap(size_t column) const noexcept
+{
+    if (!mZoneMaps.Enabled() || column >= mZoneMaps.ColumnCount() || column >= mColumnKeyIds.size() ||
+        !mZoneMaps.Tracked(column) || mZoneMaps.ColumnKeys(column) != mColumnKeyIds[column])
+    {
+        return nullptr;
+    }
+    const internal::ZoneMap &map = mZoneMaps.Map(column);
+    return map.Size() == mData.Lines().size() ? &map : nullptr;
+}
+
+std::optional<std::pair<int64_t, int64_t>> LogTable::EpochMicrosecondsRange(size_t column) const noexcept
+{
+    const internal::ZoneMap *map = ColumnZoneMap(column);
+    if (map == nullptr)
+    {
+        return std::nullopt;
+    }
+    const internal::ZoneSummary total = map->Total();
+    if (total.timeRows == 0)
+    {
+        return std::nullopt;
+    }
+    return std::make_pair(total.minMicros, total.maxMicros);
+}
+
+size_t LogTable::ZoneMapMemoryBytes() const noexcept
+{
+    return mZoneMaps.Enabled() ? mZoneMaps.MemoryBytes() : 0;
+}
+
+void LogTable::SetTrigramIndex(bool enabled)
+{
+    // Same drop-then-rebuild contract as `SetColumnarStorage`.
+    mTrigramIndex.Clear();
+    mTrigramIndexEnabled = enabled;
+    SyncTrigramIndex();
+}
+
+bool LogTable::TrigramIndexEnabled() const noexcept
+{
+    return mTrigramIndexEnabled;
+}
+
+std::optional<internal::TrigramCandidates> LogTable::TrigramCandidatesFor(const TrigramQuery &query) const
+{
+    if (!mTrigramIndexEnabled || mTrigramIndex.Size() != mData.Lines().size())
+    {
+        return std::nullopt;
+    }
+    return mTrigramIndex.Candidates(query);
+}
+
+size_t LogTable::TrigramIndexMemoryBytes() const noexcept
+{
+    return mTrigramIndexEnabled ? mTrigramIndex.MemoryBytes() : 0;
+}
+
+internal::TrigramIndexSignature LogTable::TrigramSignature() const
+{
+    const auto &lines = mData.Lines();
+    using Totals = std::pair<uint64_t, uint64_t>;
+    const Totals totals = tbb::parallel_reduce(
+        tbb::blocked_range<size_t>(0, lines.size()),
+        Totals{},
+        [this, &lines](const tbb::blocked_range<size_t> &range, Totals partial) {
+            for (size_t row = range.begin(); row != range.end(); ++row)
+            {
+                ForEachStringField(lines[row], mEnumDictionaries, [&partial](std::string_view bytes) {
+                    ++partial.first;
+                    partial.second += bytes.size();
+                });
+            }
+            return partial;
+        },
+        [](const Totals &lhs, const Totals &rhs) { return Totals{lhs.first + rhs.first, lhs.second + rhs.second}; }
+    );
+    return internal::TrigramIndexSignature{
+        .rows = lines.size(), .stringCells = totals.first, .stringBytes = totals.second
+    };
+}
+
+bool LogTable::SaveTrigramIndex(const std::filesystem::path &indexDir, const std::filesystem::path &source) const
+{
+    if (!mTrigramIndexEnabled || mTrigramIndex.Size() != mData.Lines().size())
+    {
+        return false;
+    }
+    return internal::SaveTrigramIndex(indexDir, source, TrigramSignature(), mTrigramIndex);
+}
+
+bool LogTable::LoadTrigramIndex(const std::filesystem::path &indexDir, const std::filesystem::path &source)
+{
+    std::optional<internal::TrigramIndex> loaded = internal::LoadTrigramIndex(indexDir, source, TrigramSignature());
+    if (!loaded.has_value())
+    {
+        return false;
+    }
+    mTrigramIndex = std::move(*loaded);
+    mTrigramIndexEnabled = true;
+    return true;
+}
+
+internal::CompactLogValue LogTable::GetCompactValue(size_t row, size_t column) const noexcept
+{
+    if (column >= mColumnKeyIds.size() || row >= mData.Lines().size())
+    {
+        return internal::CompactLogValue::MakeMonostate();
+    }
+    if (const internal::DenseColumn *dense = ColumnarView(column); dense != nullptr)
+    {
+        return dense->Slot(row);
+    }
+    return ResolveColumnSlot(mData.Lines()[row], column);
+}
+
+std::optional<int64_t> LogTable::GetEpochMicroseconds(size_t row, size_t column) const noexcept
+{
+    // Acceptance set must stay in lockstep with `AsEpochMicroseconds`.
+    const internal::CompactLogValue slot = GetCompactValue(row, column);
+    switch (slot.tag)
+    {
+    case internal::CompactTag::Timestamp:
+    case internal::CompactTag::Int64:
+        return static_cast<int64_t>(slot.payload);
+    case internal::CompactTag::Uint64:
+        if (slot.payload <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+        {
+            return static_cast<int64_t>(slot.payload);
+        }
+        return std::nullopt;
+    default:
+        return std::nullopt;
+    }
+}
+
 void LogTable::EvictPrefixRows(size_t count)
 {
     if (count == 0)
@@ -634,6 +938,10 @@ void LogTable::EvictPrefixRows(size_t count)
         return;
     }
     auto &lines = mData.Lines();
+    mColumnStore.EraseFrontRows(count);
+    mEnumIndexes.EraseFrontRows(count);
+    mZoneMaps.EraseFrontRows(count);
+    mTrigramIndex.EraseFront(count);
 
     // Release per-line storage for evicted rows. Non-evicting sources no-op.
     auto evictSource = [&](size_t firstSurvivingLineId) {
@@ -659,8 +967,9 @@ void LogTable::EvictPrefixRows(size_t count)
         return;
     }
 
+    // Chunked store: drops whole evicted chunks, survivors stay put.
     const size_t firstSurvivingLineId = lines[count].LineId();
-    lines.erase(lines.begin(), lines.begin() + static_cast<std::ptrdiff_t>(count));
+    lines.EraseFront(count);
     evictSource(firstSurvivingLineId);
 }
 
@@ -699,6 +1008,7 @@ void LogTable::RefreshColumnKeyIds()
         }
         mColumnKeyIds.push_back(std::move(ids));
     }
+    SyncColumnarKeys();
 }
 
 void LogTable::RefreshColumnKeyIdsForKeys(const std::vector<std::string> &newKeys)
@@ -750,6 +1060,7 @@ void LogTable::RefreshColumnKeyIdsForKeys(const std::vector<std::string> &newKey
         }
         mColumnKeyIds[columnIndex] = std::move(ids);
     }
+    SyncColumnarKeys();
 }
 
 void LogTable::RefreshSnapshotTimeKeys()
@@ -824,6 +1135,283 @@ void LogTable::RefreshSnapshotEnumKeys()
     }
 }
 
+internal::CompactLogValue LogTable::ResolveColumnSlot(const LogLine &line, size_t column) const noexcept
+{
+    for (const KeyId id : mColumnKeyIds[column])
+    {
+        if (id == INVALID_KEY_ID)
+        {
+            continue;
+        }
+        const internal::CompactLogValue *slot = line.FindCompact(id);
+        if (slot == nullptr)
+        {
+            continue;
+        }
+        // Same skip rule as `CompactLogValue::Materialise`: a slot that
+        // would materialise to monostate falls through to the next alias.
+        bool materialises = true;
+        switch (slot->tag)
+        {
+        case internal::CompactTag::Monostate:
+            materialises = false;
+            break;
+        case internal::CompactTag::MmapSlice:
+            materialises = line.PeekStringView(*slot).has_value();
+            break;
+        case internal::CompactTag::DictRef:
+        {
+            const LineSource *source = line.Source();
+            const EnumDictionaryRegistry *registry = source != nullptr ? source->EnumDictionaries() : nullptr;
+            materialises = registry != nullptr && registry->Find(id) != nullptr;
+            break;
+        }
+        default:
+            break;
+        }
+        if (materialises)
+        {
+            return *slot;
+        }
+    }
+    return internal::CompactLogValue::MakeMonostate();
+}
+
+void LogTable::SyncColumnarKeys()
+{
+    if (!mColumnStore.Enabled())
+    {
+        return;
+    }
+    mColumnStore.Resize(mColumnKeyIds.size());
+    for (size_t column = 0; column < mColumnKeyIds.size(); ++column)
+    {
+        if (mColumnStore.ColumnKeys(column) != mColumnKeyIds[column])
+        {
+            mColumnStore.Invalidate(column);
+            mColumnStore.SetColumnKeys(column, mColumnKeyIds[column]);
+        }
+    }
+}
+
+void LogTable::SyncColumnarStorage()
+{
+    if (!mColumnStore.Enabled())
+    {
+        return;
+    }
+    SyncColumnarKeys();
+    const auto &lines = mData.Lines();
+    const size_t rowCount = lines.size();
+    for (size_t column = 0; column < mColumnKeyIds.size(); ++column)
+    {
+        internal::DenseColumn &dense = mColumnStore.Column(column);
+        if (dense.Size() > rowCount)
+        {
+            // Rows vanished without `EvictPrefixRows` (e.g. `Reset`).
+            dense.Clear();
+        }
+        if (dense.Empty())
+        {
+            // Exact-fit only on a full rebuild; appends keep the
+            // vectors' geometric growth.
+            dense.Reserve(rowCount);
+        }
+        for (size_t row = dense.Size(); row < rowCount; ++row)
+        {
+            dense.Append(ResolveColumnSlot(lines[row], column));
+        }
+    }
+}
+
+void LogTable::SyncEnumIndexes()
+{
+    if (!mEnumIndexes.Enabled())
+    {
+        return;
+    }
+    mEnumIndexes.Resize(mColumnKeyIds.size());
+    const size_t rowCount = mData.Lines().size();
+    std::vector<EnumValueId> ids;
+    for (size_t column = 0; column < mColumnKeyIds.size(); ++column)
+    {
+        const EnumDictionary *dictionary = ResolveEnumColumn(column).dictionary;
+        mEnumIndexes.Bind(column, mColumnKeyIds[column], dictionary);
+        internal::EnumPostingIndex &index = mEnumIndexes.Index(column);
+        if (dictionary == nullptr || index.Size() > rowCount)
+        {
+            // Not an enum column, or rows vanished without
+            // `EvictPrefixRows` (e.g. `Reset`).
+            index.Clear();
+            if (dictionary == nullptr)
+            {
+                continue;
+            }
+        }
+        const size_t firstRow = index.Size();
+        if (firstRow == rowCount)
+        {
+            continue;
+        }
+        // Resolving ids is the expensive half (a line walk per row
+        // without the columnar mirror), so it runs in parallel;
+        // posting appends must stay ascending and run serially.
+        ids.assign(rowCount - firstRow, INVALID_ENUM_VALUE_ID);
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(firstRow, rowCount),
+            [this, column, firstRow, &ids](const tbb::blocked_range<size_t> &range) {
+                for (size_t row = range.begin(); row != range.end(); ++row)
+                {
+                    if (const auto id = GetEnumValueId(row, column); id.has_value())
+                    {
+                        ids[row - firstRow] = *id;
+                    }
+                }
+            }
+        );
+        for (const EnumValueId id : ids)
+        {
+            index.Append(id);
+        }
+    }
+}
+
+void LogTable::SyncZoneMaps()
+{
+    if (!mZoneMaps.Enabled())
+    {
+        return;
+    }
+    mZoneMaps.Resize(mColumnKeyIds.size());
+    const size_t rowCount = mData.Lines().size();
+    const auto &columns = mConfiguration.Configuration().columns;
+    std::vector<internal::ZoneSummary> blocks;
+    for (size_t column = 0; column < mColumnKeyIds.size(); ++column)
+    {
+        using Type = LogConfiguration::Type;
+        const Type type = column < columns.size() ? columns[column].type : Type::Any;
+        const bool tracked =
+            type == Type::Time || type == Type::Integer || type == Type::Floating || type == Type::Number;
+        mZoneMaps.Bind(column, mColumnKeyIds[column], tracked);
+        internal::ZoneMap &map = mZoneMaps.Map(column);
+        if (!tracked || map.Size() > rowCount)
+        {
+            // Not a range-filterable column, or rows vanished without
+            // `EvictPrefixRows` (e.g. `Reset`).
+            map.Clear();
+            if (!tracked)
+            {
+                continue;
+            }
+        }
+        // Top up the open block serially, then summarise whole blocks
+        // in parallel; each block only reads its own rows.
+        size_t row = map.Size();
+        for (; row < rowCount && !map.AtBlockBoundary(); ++row)
+        {
+            map.Append(GetCompactValue(row, column));
+        }
+        if (row == rowCount)
+        {
+            continue;
+        }
+        constexpr size_t BLOCK_ROWS = internal::ZoneMap::BLOCK_ROWS;
+        const size_t firstRow = row;
+        blocks.assign((rowCount - firstRow + BLOCK_ROWS - 1) / BLOCK_ROWS, internal::ZoneSummary{});
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, blocks.size()),
+            [this, column, firstRow, rowCount, &blocks](const tbb::blocked_range<size_t> &range) {
+                for (size_t block = range.begin(); block != range.end(); ++block)
+                {
+                    const size_t begin = firstRow + (block * BLOCK_ROWS);
+                    const size_t end = std::min(begin + BLOCK_ROWS, rowCount);
+                    for (size_t r = begin; r < end; ++r)
+                    {
+                        blocks[block].Add(GetCompactValue(r, column));
+                    }
+                }
+            }
+        );
+        for (const internal::ZoneSummary &summary : blocks)
+        {
+            map.AppendBlock(summary);
+        }
+    }
+}
+
+void LogTable::SyncTrigramIndex()
+{
+    if (!mTrigramIndexEnabled)
+    {
+        return;
+    }
+    const auto &lines = mData.Lines();
+    const size_t rowCount = lines.size();
+    if (mTrigramIndex.Size() > rowCount)
+    {
+        // Rows vanished without `EvictPrefixRows` (e.g. `Reset`).
+        mTrigramIndex.Clear();
+    }
+    constexpr size_t GRANULE_ROWS = internal::TrigramIndex::GRANULE_ROWS;
+    // Granules per `AppendGranules` call: bounds the key lists held at
+    // once while a large file is indexed.
+    constexpr size_t WINDOW_GRANULES = 1024;
+    tbb::enumerable_thread_specific<internal::TrigramKeySet> keySets;
+    std::vector<std::vector<uint32_t>> granules;
+    while (mTrigramIndex.Size() < rowCount)
+    {
+        // Entry 0 tops up the open granule; each later one covers a
+        // whole granule, so workers never share one.
+        const size_t firstRow = mTrigramIndex.Size();
+        const size_t openEnd = firstRow + std::min(mTrigramIndex.OpenGranuleRoom(), rowCount - firstRow);
+        const size_t windowEnd = std::min(openEnd + ((WINDOW_GRANULES - 1) * GRANULE_ROWS), rowCount);
+        granules.assign(1 + ((windowEnd - openEnd + GRANULE_ROWS - 1) / GRANULE_ROWS), {});
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, granules.size()),
+            [this, &lines, &keySets, &granules, firstRow, openEnd, windowEnd](const tbb::blocked_range<size_t> &range) {
+                internal::TrigramKeySet &keys = keySets.local();
+                for (size_t granule = range.begin(); granule != range.end(); ++granule)
+                {
+                    const size_t begin = granule == 0 ? firstRow : openEnd + ((granule - 1) * GRANULE_ROWS);
+                    const size_t end = granule == 0 ? openEnd : std::min(begin + GRANULE_ROWS, windowEnd);
+                    for (size_t row = begin; row < end; ++row)
+                    {
+                        ForEachStringField(lines[row], mEnumDictionaries, [&keys](std::string_view bytes) {
+                            keys.AddCell(bytes);
+                        });
+                    }
+                    granules[granule] = keys.TakeKeys();
+                }
+            }
+        );
+        mTrigramIndex.AppendGranules(granules, windowEnd - firstRow);
+    }
+}
+
+void LogTable::InvalidateColumnarColumn(size_t columnIndex) noexcept
+{
+    if ((!mColumnStore.Enabled() && !mEnumIndexes.Enabled() && !mZoneMaps.Enabled()) ||
+        columnIndex >= mColumnKeyIds.size())
+    {
+        return;
+    }
+    // Slots are rewritten per `KeyId`, so any column aliasing one of
+    // this column's keys goes stale too.
+    const std::vector<KeyId> &keys = mColumnKeyIds[columnIndex];
+    for (size_t column = 0; column < mColumnKeyIds.size(); ++column)
+    {
+        const bool sharesKey = std::ranges::any_of(mColumnKeyIds[column], [&keys](KeyId id) {
+            return id != INVALID_KEY_ID && std::ranges::find(keys, id) != keys.end();
+        });
+        if (column == columnIndex || sharesKey)
+        {
+            mColumnStore.Invalidate(column);
+            mEnumIndexes.Invalidate(column);
+            mZoneMaps.Invalidate(column);
+        }
+    }
+}
+
 void LogTable::RewireSourceRegistries()
 {
     for (auto &source : mData.Sources())
@@ -866,6 +1454,16 @@ std::optional<EnumValueId> LogTable::GetEnumValueId(size_t row, size_t column) c
     {
         return std::nullopt;
     }
+    if (const internal::DenseColumn *dense = ColumnarView(column); dense != nullptr)
+    {
+        if (dense->Tag(row) == internal::CompactTag::DictRef)
+        {
+            return static_cast<EnumValueId>(static_cast<uint16_t>(dense->Payload(row)));
+        }
+        // The mirror holds the first *materialising* alias; a later
+        // alias can still carry a `DictRef` (or a dictionary-less one
+        // was skipped). The row walk below keeps those rare cases exact.
+    }
     const auto &line = mData.Lines()[row];
     // `LogLine::GetEnumValueId` does one `FindCompact` walk and
     // returns nullopt for absent or non-`DictRef` slots, so a single
@@ -1382,6 +1980,9 @@ LogConfiguration::Type LogTable::RescanColumnForAutoDetection(size_t columnIndex
     }
     // Else: no slots present at all -- leave at `Type::Any + autoDetect`
     // so a later batch (or re-open) can finalise.
+    SyncColumnarStorage();
+    SyncEnumIndexes();
+    SyncZoneMaps();
     return mConfiguration.Configuration().columns[columnIndex].type;
 }
 
@@ -1485,6 +2086,9 @@ bool LogTable::FinalizeAutoDetection()
 
     mEnumTrackers.clear();
     mIsStreaming = false;
+    SyncColumnarStorage();
+    SyncEnumIndexes();
+    SyncZoneMaps();
     return promoted;
 }
 
@@ -1518,6 +2122,7 @@ void LogTable::OnUserChangedColumnType(size_t columnIndex, LogConfiguration::Typ
     // Refresh column key ids first; the encode / back-fill walks
     // below depend on the cached ids.
     RefreshColumnKeyIds();
+    InvalidateColumnarColumn(columnIndex);
 
     const auto column = snapshot();
     switch (column.type)
@@ -1535,9 +2140,7 @@ void LogTable::OnUserChangedColumnType(size_t columnIndex, LogConfiguration::Typ
             mConfiguration.SetColumnParseFormats(columnIndex, DefaultTimeParseFormats());
         }
         BackfillTimestampColumn(
-            mConfiguration.Configuration().columns[columnIndex],
-            std::span<LogLine>(mData.Lines()),
-            BackfillErrors::Discard
+            mConfiguration.Configuration().columns[columnIndex], mData.Lines(), 0, BackfillErrors::Discard
         );
         break;
     }
@@ -1632,6 +2235,9 @@ void LogTable::OnUserChangedColumnType(size_t columnIndex, LogConfiguration::Typ
         break;
     }
     }
+    SyncColumnarStorage();
+    SyncEnumIndexes();
+    SyncZoneMaps();
 }
 
 bool LogTable::EncodeColumnRange(
@@ -1752,6 +2358,7 @@ void LogTable::PromoteColumnToEnum(size_t columnIndex)
     // doesn't depend on the live columns vector across mutations.
     const std::vector<std::string> columnKeys = mConfiguration.Configuration().columns[columnIndex].keys;
     const std::string headerKey = mConfiguration.Configuration().columns[columnIndex].header;
+    InvalidateColumnarColumn(columnIndex);
 
     mConfiguration.SetColumnType(columnIndex, LogConfiguration::Type::Enumeration);
     // Pre-create canonical dictionary and alias-wire so the encode hot
@@ -1824,6 +2431,7 @@ void LogTable::DemoteColumnFromEnum(size_t columnIndex, bool recordForBatch)
     {
         return;
     }
+    InvalidateColumnarColumn(columnIndex);
 
     std::vector<KeyId> keyIds;
     keyIds.reserve(column.keys.size());
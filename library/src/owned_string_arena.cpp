@@ -0,0 +1,133 @@
+#include "loglib/internal/owned_string_arena.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace loglib::internal
+{
+
+void OwnedStringArena::Adopt(uint64_t offset, std::string bytes, size_t span)
+{
+    span = std::max(span, bytes.size());
+    if (span == 0)
+    {
+        return;
+    }
+    // Batches adopt in offset order, so the common case is a push_back.
+    auto position = mChunks.end();
+    if (!mChunks.empty() && mChunks.back().offset > offset)
+    {
+        position = std::ranges::upper_bound(mChunks, offset, {}, &Chunk::offset);
+    }
+    mChunks.insert(position, Chunk{.offset = offset, .span = span, .bytes = std::move(bytes)});
+}
+
+OwnedStringArena::Chunk *OwnedStringArena::FindChunkEndingAt(uint64_t end) noexcept
+{
+    if (mChunks.empty() || end == 0)
+    {
+        return nullptr;
+    }
+    auto it = std::ranges::upper_bound(mChunks, end - 1, {}, &Chunk::offset);
+    if (it == mChunks.begin())
+    {
+        return nullptr;
+    }
+    Chunk &chunk = *std::prev(it);
+    return chunk.offset + chunk.bytes.size() == end ? &chunk : nullptr;
+}
+
+bool OwnedStringArena::TryExtend(uint64_t end, std::string_view bytes)
+{
+    Chunk *chunk = FindChunkEndingAt(end);
+    if (chunk == nullptr)
+    {
+        return false;
+    }
+    const size_t needed = chunk->bytes.size() + bytes.size();
+    if (needed > chunk->span)
+    {
+        // Grow the span only if nothing was reserved after the chunk.
+        uint64_t spanEnd = chunk->offset + chunk->span;
+        if (!mEnd.compare_exchange_strong(spanEnd, chunk->offset + needed, std::memory_order_relaxed))
+        {
+            return false;
+        }
+        chunk->span = needed;
+    }
+    chunk->bytes.append(bytes);
+    return true;
+}
+
+uint64_t OwnedStringArena::Append(std::string_view bytes)
+{
+    if (!mChunks.empty())
+    {
+        const Chunk &last = mChunks.back();
+        const uint64_t end = last.offset + last.bytes.size();
+        if (TryExtend(end, bytes))
+        {
+            return end;
+        }
+    }
+    const uint64_t offset = Reserve(bytes.size());
+    Adopt(offset, std::string(bytes));
+    return offset;
+}
+
+const OwnedStringArena::Chunk *OwnedStringArena::FindChunkCovering(uint64_t offset) const noexcept
+{
+    const auto covers = [offset](const Chunk &chunk) {
+        return chunk.offset <= offset && offset - chunk.offset < chunk.span;
+    };
+    const size_t hint = mLastChunk.load(std::memory_order_relaxed);
+    for (size_t index = hint; index < mChunks.size() && index <= hint + 1; ++index)
+    {
+        if (covers(mChunks[index]))
+        {
+            if (index != hint)
+            {
+                mLastChunk.store(index, std::memory_order_relaxed);
+            }
+            return &mChunks[index];
+        }
+    }
+
+    auto it = std::ranges::upper_bound(mChunks, offset, {}, &Chunk::offset);
+    if (it == mChunks.begin())
+    {
+        return nullptr;
+    }
+    --it;
+    mLastChunk.store(static_cast<size_t>(it - mChunks.begin()), std::memory_order_relaxed);
+    return &*it;
+}
+
+std::string_view OwnedStringArena::Bytes(uint64_t offset, size_t length) const noexcept
+{
+    const Chunk *found = FindChunkCovering(offset);
+    if (found == nullptr)
+    {
+        return {};
+    }
+    const Chunk &chunk = *found;
+    const uint64_t local = offset - chunk.offset;
+    if (local > chunk.bytes.size() || length > chunk.bytes.size() - local)
+    {
+        return {};
+    }
+    return std::string_view(chunk.bytes).substr(local, length);
+}
+
+size_t OwnedStringArena::MemoryBytes() const noexcept
+{
+    size_t bytes = mChunks.capacity() * sizeof(Chunk);
+    for (const Chunk &chunk : mChunks)
+    {
+        bytes += chunk.bytes.capacity();
+    }
+    return bytes;
+}
+
+} // namespace loglib::internal
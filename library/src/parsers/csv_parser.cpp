@@ -6,6 +6,7 @@
 #include "loglib/internal/compact_log_value.hpp"
 #include "loglib/internal/csv_tokenize.hpp"
 #include "loglib/internal/line_decoder.hpp"
+#include "loglib/internal/line_framer.hpp"
 #include "loglib/internal/probe_line_view.hpp"
 #include "loglib/internal/static_parser_pipeline.hpp"
 #include "loglib/internal/streaming_parse_loop.hpp"
@@ -268,20 +269,13 @@ void DecodeCsvBatch(
 
     std::vector<std::pair<KeyId, internal::CompactLogValue>> values;
 
-    while (cursor < end)
+    internal::LineFramer framer(cursor, end, fileEnd, fileBegin);
+    internal::FramedLine framed;
+    while (framer.Next(framed))
     {
-        const char *lineStart = cursor;
-        const char *newline = static_cast<const char *>(memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
-        const char *lineEnd = newline ? newline : end;
-        cursor = (newline != nullptr) ? newline + 1 : end;
-
-        std::string_view line(lineStart, static_cast<size_t>(lineEnd - lineStart));
-        line = StripCr(line);
-
-        // `GetLine` subtracts 1 for the '\n'; pad by 1 on an unterminated
-        // last line so the final byte isn't lost.
-        const uint64_t nextOffset = static_cast<uint64_t>(cursor - fileBegin) + (newline == nullptr ? 1u : 0u);
-        parsed.localLineOffsets.push_back(nextOffset);
+        const char *lineStart = framed.begin;
+        const std::string_view line = framed.Text();
+        parsed.localLineOffsets.push_back(framed.nextOffset);
 
         if (line.empty())
         {
@@ -659,6 +653,9 @@ void CsvParser::ParseStreaming(
     const size_t batchSize = advanced.batchSizeBytes != 0 ? advanced.batchSizeBytes
                                                           : internal::AdvancedParserOptions::DEFAULT_BATCH_SIZE_BYTES;
 
+    // The header scan below reads a snapshot; a progressive decode must
+    // have published the whole header line first.
+    internal::WaitForFirstLine(file, options.stopToken);
     const char *fileBegin = file.Data();
     const size_t fileSize = file.Size();
     const char *fileEnd = (fileBegin != nullptr) ? fileBegin + fileSize : nullptr;
@@ -728,35 +725,8 @@ void CsvParser::ParseStreaming(
         return;
     }
 
-    const char *cursor = fileBegin;
-    uint64_t batchIndex = 0;
-
-    auto stageA = [cursor, fileEnd, batchSize, batchIndex](CsvByteRange &out) mutable -> bool {
-        if (cursor >= fileEnd)
-        {
-            return false;
-        }
-        const char *batchBegin = cursor;
-        const auto remaining = static_cast<size_t>(fileEnd - cursor);
-        const size_t advance = std::min(batchSize, remaining);
-        const char *target = cursor + advance;
-        if (advance < remaining)
-        {
-            const char *newline =
-                static_cast<const char *>(memchr(target, '\n', static_cast<size_t>(fileEnd - target)));
-            cursor = (newline != nullptr) ? newline + 1 : fileEnd;
-        }
-        else
-        {
-            cursor = fileEnd;
-        }
-
-        out.batchIndex = batchIndex++;
-        out.bytesBegin = batchBegin;
-        out.bytesEnd = cursor;
-        out.fileEnd = fileEnd;
-        return true;
-    };
+    internal::StaticBatchCutter cutter(file, batchSize, options.stopToken);
+    auto stageA = [&cutter](CsvByteRange &out, size_t targetBytes) { return cutter.Next(out, targetBytes); };
 
     FileLineSource *sourcePtr = &source;
     auto stageB = [sourcePtr, &columnKeys, headerLineOffset](
@@ -4,6 +4,7 @@
 #include "loglib/internal/advanced_parser_options.hpp"
 #include "loglib/internal/compact_log_value.hpp"
 #include "loglib/internal/line_decoder.hpp"
+#include "loglib/internal/line_framer.hpp"
 #include "loglib/internal/probe_line_view.hpp"
 #include "loglib/internal/static_parser_pipeline.hpp"
 #include "loglib/internal/streaming_parse_loop.hpp"
@@ -21,6 +22,7 @@
 
 #include <simdjson.h>
 
+#include <bit>
 #include <cstdint>
 #include <cstring>
 #include <fstream>
@@ -77,6 +79,12 @@ constexpr size_t INSERT_SORTED_LOWER_BOUND_THRESHOLD = 8;
 constexpr size_t INITIAL_OBJECT_FIELD_CAPACITY = 16;
 constexpr size_t LINE_PADDED_EXTRA_SLACK_BYTES = 64;
 
+/// Largest Stage A batch decoded as one `iterate_many` stream. The
+/// worker's parser holds capacity for the whole batch (about 6 bytes per
+/// input byte), so oversized batches from a tuning override stay on the
+/// line-at-a-time path.
+constexpr size_t DOCUMENT_STREAM_MAX_BATCH_BYTES = size_t{16} << 20;
+
 void InsertSorted(
     std::vector<std::pair<KeyId, internal::CompactLogValue>> &out, KeyId id, internal::CompactLogValue value
 )
@@ -503,6 +511,153 @@ struct JsonByteRange
     const char *fileEnd = nullptr;
 };
 
+/// Decode a batch through one `iterate_many` stream, so simdjson builds
+/// the structural index once per batch instead of once per line. The
+/// batch must have `SIMDJSON_PADDING` readable bytes past its end.
+///
+/// A document is taken only when it is an object that starts and ends
+/// on one line, with nothing but empty lines before it; anything else
+/// (a non-object, an object spanning lines, a whitespace-only line, a
+/// stream error) stops the stream there. Returns the start of the first
+/// line left for the line-at-a-time loop, or the batch end.
+const char *DecodeJsonDocumentStream(
+    const JsonByteRange &batch,
+    internal::WorkerScratch<JsonWorkerState> &worker,
+    KeyIndex &keys,
+    FileLineSource &source,
+    std::span<const internal::TimeColumnSpec> timeColumns,
+    internal::ParsedPipelineBatch &parsed,
+    internal::LineFramer &framer,
+    size_t &relativeLineNumber
+)
+{
+    const char *begin = batch.bytesBegin;
+    const char *end = batch.bytesEnd;
+    const char *fileBegin = source.File().Data();
+    const auto fileSize = static_cast<size_t>(batch.fileEnd - fileBegin);
+    const auto length = static_cast<size_t>(end - begin);
+
+    // A power-of-two window keeps the parser's capacity stable across
+    // batches; `allocate` reallocates on any change.
+    simdjson::ondemand::document_stream stream;
+    if (worker.user.parser.iterate_many(begin, length, std::bit_ceil(length)).get(stream))
+    {
+        return begin;
+    }
+
+    const char *lineStart = begin;
+    for (auto it = stream.begin(); it != stream.end(); ++it)
+    {
+        auto document = *it;
+        if (document.error())
+        {
+            return lineStart;
+        }
+        // The first document of a stream reports index 0 even past
+        // leading whitespace.
+        const char *docStart = begin + it.current_index();
+        while (docStart < end && (*docStart == ' ' || *docStart == '\t' || *docStart == '\r' || *docStart == '\n'))
+        {
+            ++docStart;
+        }
+
+        internal::FramedLine line;
+        for (;;)
+        {
+            // Below `lineStart`: a second document on a line already
+            // taken, which the line loop ignores as trailing content.
+            if (docStart < lineStart)
+            {
+                return lineStart;
+            }
+            line = framer.LineAt(lineStart);
+            if (docStart < line.next)
+            {
+                break;
+            }
+            if (line.contentEnd != lineStart)
+            {
+                return lineStart;
+            }
+            parsed.localLineOffsets.push_back(line.nextOffset);
+            relativeLineNumber++;
+            lineStart = line.next;
+        }
+
+        if (*docStart != '{')
+        {
+            return lineStart;
+        }
+        // The line loop rejects an object with anything but whitespace
+        // after it on the line.
+        const std::string_view docSource = it.source();
+        const char *docEnd = docSource.data() + docSource.size();
+        if (docEnd > line.contentEnd ||
+            std::any_of(docEnd, line.contentEnd, [](char c) { return c != ' ' && c != '\t' && c != '\r'; }))
+        {
+            return lineStart;
+        }
+        auto object = document.get_object();
+        if (object.error())
+        {
+            return lineStart;
+        }
+
+        std::vector<std::pair<KeyId, internal::CompactLogValue>> values;
+        try
+        {
+            auto objectValue = object.value();
+            values = ParseJsonLine(
+                objectValue,
+                keys,
+                worker.user.cache,
+                /* sourceIsStable = */ true,
+                &worker.keyCache,
+                fileBegin,
+                fileSize,
+                parsed.ownedStringsArena
+            );
+        }
+        catch (const std::exception &)
+        {
+            // The line loop reparses this line and records the error.
+            return lineStart;
+        }
+
+        // A field error leaves the iterator short of the closing brace,
+        // and the stream then yields empty objects for the documents
+        // after it. Only a cleanly consumed object keeps the stream.
+        const char *location = nullptr;
+        const simdjson::error_code locationError = document.current_location().get(location);
+        if (locationError == simdjson::SUCCESS ? location < docEnd : locationError != simdjson::OUT_OF_BOUNDS)
+        {
+            return lineStart;
+        }
+
+        parsed.localLineOffsets.push_back(line.nextOffset);
+        LogLine logLine(std::move(values), keys, source, relativeLineNumber - 1);
+        parsed.lines.push_back(std::move(logLine));
+        worker.PromoteTimestamps(parsed.lines.back(), timeColumns, std::string_view(parsed.ownedStringsArena));
+        relativeLineNumber++;
+        lineStart = line.next;
+    }
+
+    // A truncated last document is dropped by the stream, not reported;
+    // only empty lines may follow the last one taken.
+    while (lineStart < end)
+    {
+        const internal::FramedLine line = framer.LineAt(lineStart);
+        if (line.contentEnd != lineStart)
+        {
+            return lineStart;
+        }
+        parsed.localLineOffsets.push_back(line.nextOffset);
+        relativeLineNumber++;
+        lineStart = line.next;
+    }
+    return end;
+}
+
 void DecodeJsonBatch(
     const JsonByteRange &batch,
     internal::WorkerScratch<JsonWorkerState> &worker,
@@ -525,24 +680,24 @@ void DecodeJsonBatch(
     parsed.localLineOffsets.reserve(estimatedLines);
 
     size_t relativeLineNumber = 1;
+    internal::LineFramer framer(cursor, end, fileEnd, fileBegin);
 
-    while (cursor < end)
+    // The mmap fast path needs SIMDJSON_PADDING bytes of slack past the
+    // batch; the tail batch and oversized batches go line by line.
+    if (static_cast<size_t>(fileEnd - end) >= simdjson::SIMDJSON_PADDING &&
+        batchBytes <= DOCUMENT_STREAM_MAX_BATCH_BYTES)
     {
-        const char *lineStart = cursor;
-        const char *newline = static_cast<const char *>(memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
-        const char *lineEnd = newline ? newline : end;
-        cursor = (newline != nullptr) ? newline + 1 : end;
-
-        std::string_view line(lineStart, static_cast<size_t>(lineEnd - lineStart));
-        if (!line.empty() && line.back() == '\r')
-        {
-            line.remove_suffix(1);
-        }
+        framer.Resume(
+            DecodeJsonDocumentStream(batch, worker, keys, source, timeColumns, parsed, framer, relativeLineNumber)
+        );
+    }
 
-        // `GetLine` subtracts 1 (the '\n'); for an unterminated final
-        // line push `fileSize + 1` so we don't lop off the last char.
-        const uint64_t nextOffset = static_cast<uint64_t>(cursor - fileBegin) + (newline == nullptr ? 1u : 0u);
-        parsed.localLineOffsets.push_back(nextOffset);
+    internal::FramedLine framed;
+    while (framer.Next(framed))
+    {
+        const char *lineEnd = framed.end;
+        const std::string_view line = framed.Text();
+        parsed.localLineOffsets.push_back(framed.nextOffset);
 
         if (line.empty())
         {
@@ -808,39 +963,8 @@ void JsonParser::ParseStreaming(
     const size_t batchSize = advanced.batchSizeBytes != 0 ? advanced.batchSizeBytes
                                                           : internal::AdvancedParserOptions::DEFAULT_BATCH_SIZE_BYTES;
 
-    const char *fileBegin = file.Data();
-    const size_t fileSize = file.Size();
-    const char *fileEnd = (fileBegin != nullptr) ? fileBegin + fileSize : nullptr;
-    const char *cursor = fileBegin;
-    uint64_t batchIndex = 0;
-
-    auto stageA = [cursor, fileEnd, batchSize, batchIndex](JsonByteRange &out) mutable -> bool {
-        if (cursor >= fileEnd)
-        {
-            return false;
-        }
-        const char *batchBegin = cursor;
-        // Bounded advance: `cursor + batchSize` past one-past-end is UB.
-        const auto remaining = static_cast<size_t>(fileEnd - cursor);
-        const size_t advance = std::min(batchSize, remaining);
-        const char *target = cursor + advance;
-        if (advance < remaining)
-        {
-            const char *newline =
-                static_cast<const char *>(memchr(target, '\n', static_cast<size_t>(fileEnd - target)));
-            cursor = (newline != nullptr) ? newline + 1 : fileEnd;
-        }
-        else
-        {
-            cursor = fileEnd;
-        }
-
-        out.batchIndex = batchIndex++;
-        out.bytesBegin = batchBegin;
-        out.bytesEnd = cursor;
-        out.fileEnd = fileEnd;
-        return true;
-    };
+    internal::StaticBatchCutter cutter(file, batchSize, options.stopToken);
+    auto stageA = [&cutter](JsonByteRange &out, size_t targetBytes) { return cutter.Next(out, targetBytes); };
 
     FileLineSource *sourcePtr = &source;
     auto stageB = [sourcePtr](
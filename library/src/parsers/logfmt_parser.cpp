@@ -2,9 +2,11 @@
 
 #include "loglib/file_line_source.hpp"
 #include "loglib/internal/advanced_parser_options.hpp"
+#include "loglib/internal/byte_classes.hpp"
 #include "loglib/internal/classify_bare_scalar.hpp"
 #include "loglib/internal/compact_log_value.hpp"
 #include "loglib/internal/line_decoder.hpp"
+#include "loglib/internal/line_framer.hpp"
 #include "loglib/internal/probe_line_view.hpp"
 #include "loglib/internal/static_parser_pipeline.hpp"
 #include "loglib/internal/streaming_parse_loop.hpp"
@@ -89,17 +91,44 @@ struct LogfmtField
     bool valueIsNull = false;
 };
 
+/// Bytes the tokenizer stops on besides controls and space; the
+/// `*_CLASS` constants index `ByteClassMasks::bytes` in this order.
+constexpr internal::ByteClassSet LOGFMT_BYTE_CLASSES{'=', '"', '\\'};
+constexpr size_t EQUALS_CLASS = 0;
+constexpr size_t QUOTE_CLASS = 1;
+constexpr size_t BACKSLASH_CLASS = 2;
+
+constexpr auto NON_SPACE_BYTES = [](const internal::ByteClassMasks &masks) noexcept {
+    return ~masks.controlOrSpace;
+};
+constexpr auto KEY_TERMINATORS = [](const internal::ByteClassMasks &masks) noexcept {
+    return masks.controlOrSpace | masks.bytes[EQUALS_CLASS] | masks.bytes[QUOTE_CLASS];
+};
+constexpr auto BARE_VALUE_TERMINATORS = [](const internal::ByteClassMasks &masks) noexcept {
+    return masks.controlOrSpace | masks.bytes[QUOTE_CLASS];
+};
+constexpr auto QUOTED_VALUE_STOPS = [](const internal::ByteClassMasks &masks) noexcept {
+    return masks.bytes[QUOTE_CLASS] | masks.bytes[BACKSLASH_CLASS];
+};
+
 /// State machine ported from `kr/logfmt`'s `scanner.go`
 /// (https://github.com/kr/logfmt/blob/19f9bcb100e6/scanner.go).
 /// Walks @p line and emits each `key=value` (or bare-key) field via
 /// @p emit. Returns false on an unterminated quoted value; fields
 /// emitted before that point are kept. @p quotedScratch is reused
 /// across calls to hold unescaped quoted bytes.
-template <class Emit> bool TokenizeLogfmtLine(std::string_view line, std::string &quotedScratch, Emit emit)
+///
+/// Runs of key, value, and separator bytes are skipped with
+/// `ByteClassCursor`, which classifies 64 bytes at a time; the states
+/// and transitions are the scalar scanner's. @p readableEnd bounds the
+/// bytes the cursor may load directly (the mmap end, or the line end).
+template <class Emit>
+bool TokenizeLogfmtLine(std::string_view line, const char *readableEnd, std::string &quotedScratch, Emit emit)
 {
     const char *const data = line.data();
     const size_t end = line.size();
     size_t i = 0;
+    internal::ByteClassCursor cursor(line, readableEnd, LOGFMT_BYTE_CLASSES);
 
     auto isSpace = [](unsigned char c) noexcept {
         return c == ' ' || c == '\t' || c == '\v' || c == '\f' || c == '\r';
@@ -108,10 +137,7 @@ template <class Emit> bool TokenizeLogfmtLine(std::string_view line, std::string
     while (i < end)
     {
         // Skip inter-pair whitespace and any trailing junk after a previous pair.
-        while (i < end && static_cast<unsigned char>(data[i]) <= ' ')
-        {
-            ++i;
-        }
+        i = cursor.Find(i, NON_SPACE_BYTES);
         if (i >= end)
         {
             return true;
@@ -119,15 +145,7 @@ template <class Emit> bool TokenizeLogfmtLine(std::string_view line, std::string
 
         // Read a key: printable ASCII excluding '=' / '"' / whitespace.
         const size_t keyStart = i;
-        while (i < end)
-        {
-            const auto c = static_cast<unsigned char>(data[i]);
-            if (c <= ' ' || c == '=' || c == '"')
-            {
-                break;
-            }
-            ++i;
-        }
+        i = cursor.Find(i, KEY_TERMINATORS);
         const std::string_view key(data + keyStart, i - keyStart);
         if (key.empty())
         {
@@ -167,8 +185,12 @@ template <class Emit> bool TokenizeLogfmtLine(std::string_view line, std::string
             bool terminated = false;
             while (i < end)
             {
-                const char c = data[i];
-                if (c == '\\')
+                i = cursor.Find(i, QUOTED_VALUE_STOPS);
+                if (i >= end)
+                {
+                    break;
+                }
+                if (data[i] == '\\')
                 {
                     sawEscape = true;
                     if (i + 1 < end)
@@ -180,12 +202,8 @@ template <class Emit> bool TokenizeLogfmtLine(std::string_view line, std::string
                     i = end;
                     break;
                 }
-                if (c == '"')
-                {
-                    terminated = true;
-                    break;
-                }
-                ++i;
+                terminated = true;
+                break;
             }
             if (!terminated)
             {
@@ -255,15 +273,7 @@ template <class Emit> bool TokenizeLogfmtLine(std::string_view line, std::string
         // Bare value: printable ASCII excluding '"' / whitespace.
         // (kr/logfmt permits '=' inside bare values; we keep that.)
         const size_t valueStart = i;
-        while (i < end)
-        {
-            const auto c = static_cast<unsigned char>(data[i]);
-            if (c <= ' ' || c == '"')
-            {
-                break;
-            }
-            ++i;
-        }
+        i = cursor.Find(i, BARE_VALUE_TERMINATORS);
         LogfmtField field;
         field.key = key;
         field.value = std::string_view(data + valueStart, i - valueStart);
@@ -337,7 +347,11 @@ void ParseLogfmtLine(
         InsertSorted(out, keyId, internal::ClassifyBareScalar(field.value, fileBegin, fileSize, ownedArena));
     };
 
-    outUnterminated = !TokenizeLogfmtLine(line, quotedScratch, emit);
+    // Lines inside the mmap may be classified in place up to the file
+    // end; anything else (streaming carry buffer) only to the line end.
+    const char *lineEnd = line.data() + line.size();
+    const bool inMapping = fileBegin != nullptr && line.data() >= fileBegin && lineEnd <= fileBegin + fileSize;
+    outUnterminated = !TokenizeLogfmtLine(line, inMapping ? fileBegin + fileSize : lineEnd, quotedScratch, emit);
 }
 
 bool LineLooksLikeLogfmt(std::string_view line)
@@ -421,23 +435,12 @@ void DecodeLogfmtBatch(
     // another continuation.
     size_t pendingLeadingBlanks = 0;
 
-    while (cursor < end)
+    internal::LineFramer framer(cursor, end, fileEnd, fileBegin);
+    internal::FramedLine framed;
+    while (framer.Next(framed))
     {
-        const char *lineStart = cursor;
-        const char *newline = static_cast<const char *>(memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
-        const char *lineEnd = newline ? newline : end;
-        cursor = (newline != nullptr) ? newline + 1 : end;
-
-        std::string_view line(lineStart, static_cast<size_t>(lineEnd - lineStart));
-        if (!line.empty() && line.back() == '\r')
-        {
-            line.remove_suffix(1);
-        }
-
-        // `GetLine` subtracts 1 (the '\n'); for an unterminated last
-        // line push `fileSize + 1` so we don't lose the final char.
-        const uint64_t nextOffset = static_cast<uint64_t>(cursor - fileBegin) + (newline == nullptr ? 1u : 0u);
-        parsed.localLineOffsets.push_back(nextOffset);
+        const std::string_view line = framed.Text();
+        parsed.localLineOffsets.push_back(framed.nextOffset);
 
         if (line.empty())
         {
@@ -883,38 +886,8 @@ void LogfmtParser::ParseStreaming(
     const size_t batchSize = advanced.batchSizeBytes != 0 ? advanced.batchSizeBytes
                                                           : internal::AdvancedParserOptions::DEFAULT_BATCH_SIZE_BYTES;
 
-    const char *fileBegin = file.Data();
-    const size_t fileSize = file.Size();
-    const char *fileEnd = (fileBegin != nullptr) ? fileBegin + fileSize : nullptr;
-    const char *cursor = fileBegin;
-    uint64_t batchIndex = 0;
-
-    auto stageA = [cursor, fileEnd, batchSize, batchIndex](LogfmtByteRange &out) mutable -> bool {
-        if (cursor >= fileEnd)
-        {
-            return false;
-        }
-        const char *batchBegin = cursor;
-        const auto remaining = static_cast<size_t>(fileEnd - cursor);
-        const size_t advance = std::min(batchSize, remaining);
-        const char *target = cursor + advance;
-        if (advance < remaining)
-        {
-            const char *newline =
-                static_cast<const char *>(memchr(target, '\n', static_cast<size_t>(fileEnd - target)));
-            cursor = (newline != nullptr) ? newline + 1 : fileEnd;
-        }
-        else
-        {
-            cursor = fileEnd;
-        }
-
-        out.batchIndex = batchIndex++;
-        out.bytesBegin = batchBegin;
-        out.bytesEnd = cursor;
-        out.fileEnd = fileEnd;
-        return true;
-    };
+    internal::StaticBatchCutter cutter(file, batchSize, options.stopToken);
+    auto stageA = [&cutter](LogfmtByteRange &out, size_t targetBytes) { return cutter.Next(out, targetBytes); };
 
     FileLineSource *sourcePtr = &source;
     const bool multiline = options.multilineLogfmt;
@@ -2,9 +2,12 @@
 
 #include "loglib/file_line_source.hpp"
 #include "loglib/internal/advanced_parser_options.hpp"
+#include "loglib/internal/builtin_regex_decoders.hpp"
 #include "loglib/internal/classify_bare_scalar.hpp"
 #include "loglib/internal/compact_log_value.hpp"
+#include "loglib/internal/delimited_captures.hpp"
 #include "loglib/internal/line_decoder.hpp"
+#include "loglib/internal/line_framer.hpp"
 #include "loglib/internal/probe_line_view.hpp"
 #include "loglib/internal/regex_template_probe_list.hpp"
 #include "loglib/internal/static_parser_pipeline.hpp"
@@ -21,7 +24,13 @@
 
 #include <fmt/format.h>
 
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
+
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <cstdint>
 #include <cstring>
 #include <fstream>
@@ -70,6 +79,11 @@ constexpr size_t PCRE2_ERROR_BUFFER_SIZE = 256;
 /// yes/no decision.
 constexpr size_t IS_VALID_PROBE_MAX_LINES = 8;
 
+/// Candidate templates (after the first-byte prefilter) at which the
+/// auto-detect probe spreads PCRE2 work across TBB workers. Below it
+/// the task overhead outweighs a handful of anchored matches.
+constexpr size_t PARALLEL_PROBE_MIN_TEMPLATES = 16;
+
 // ---------------------------------------------------------------------
 // RAII wrappers around the PCRE2 C handles.
 // ---------------------------------------------------------------------
@@ -201,6 +215,8 @@ public:
         pcre2_set_depth_limit(mContext.get(), PCRE2_DEPTH_LIMIT);
 
         ExtractSchema();
+        ExtractFirstBytes(pattern);
+        SelectDecoderWithoutPcre2(pattern);
         return true;
     }
 
@@ -250,6 +266,38 @@ public:
         return mJitCompiled;
     }
 
+    /// False only when no match anchored at offset 0 can begin with
+    /// @p firstByte, so the caller can skip `pcre2_match`. Applies to
+    /// every `PCRE2_ANCHORED` call, and to unanchored calls when
+    /// `IsAnchored()`.
+    [[nodiscard]] bool MayStartWith(char firstByte) const noexcept
+    {
+        const auto byte = static_cast<unsigned char>(firstByte);
+        return ((mFirstBytes[byte / 64] >> (byte % 64)) & 1U) != 0;
+    }
+
+    /// True when the pattern can only match at the subject start (every
+    /// top-level branch begins with `^`).
+    [[nodiscard]] bool IsAnchored() const noexcept
+    {
+        return mAnchored;
+    }
+
+    /// Fill @p captures (one per named group, in `Schema()` order; empty
+    /// for a group that did not participate) without calling PCRE2, when
+    /// the pattern is a built-in template with a hand-written decoder or
+    /// reduces to delimiter-separated captures. False means PCRE2 has to
+    /// decide, either because there is no such decoder or because it
+    /// cannot settle @p line.
+    [[nodiscard]] bool TryDecodeWithoutPcre2(std::string_view line, std::vector<std::string_view> &captures) const
+    {
+        if (mBuiltinDecoder != nullptr)
+        {
+            return mBuiltinDecoder->decode(line, captures);
+        }
+        return mDelimitedCaptures && internal::SplitDelimitedCaptures(*mDelimitedCaptures, line, captures);
+    }
+
     /// Allocate per-worker match data sized to this pattern's
     /// capture count. PCRE2 documents
     /// `pcre2_match_data_create_from_pattern` as the canonical
@@ -327,11 +375,126 @@ private:
         mSchema.groupIndices = std::move(sortedIndices);
     }
 
+    /// Fill `mFirstBytes` from PCRE2's start-of-match analysis.
+    ///
+    /// PCRE2 skips that analysis for anchored patterns, which is every
+    /// `^...` template. A match anchored at offset 0 of `^X` is also a
+    /// match of `X`, so the analysis runs on a throwaway unanchored
+    /// compile of `X`. Anything PCRE2 cannot summarise leaves every byte
+    /// allowed.
+    void ExtractFirstBytes(std::string_view pattern)
+    {
+        mFirstBytes.fill(~uint64_t{0});
+
+        uint32_t allOptions = 0;
+        pcre2_pattern_info(mCode.get(), PCRE2_INFO_ALLOPTIONS, &allOptions);
+        mAnchored = (allOptions & PCRE2_ANCHORED) != 0;
+
+        std::string_view unanchored = pattern;
+        if (unanchored.starts_with('^'))
+        {
+            unanchored.remove_prefix(1);
+            // `^{1}x` would re-read as a literal `{1}x`; a quantified `^`
+            // is not worth a prefilter.
+            if (!unanchored.empty() && std::string_view("*+?{").find(unanchored.front()) != std::string_view::npos)
+            {
+                return;
+            }
+        }
+        int errcode = 0;
+        PCRE2_SIZE erroffset = 0;
+        const Pcre2CodePtr analysis(pcre2_compile(
+            reinterpret_cast<PCRE2_SPTR>(unanchored.data()),
+            unanchored.size(),
+            /*options*/ 0,
+            &errcode,
+            &erroffset,
+            /*ccontext*/ nullptr
+        ));
+        if (analysis == nullptr)
+        {
+            return;
+        }
+
+        uint32_t firstCodeType = 0;
+        pcre2_pattern_info(analysis.get(), PCRE2_INFO_FIRSTCODETYPE, &firstCodeType);
+        if (firstCodeType == 1)
+        {
+            uint32_t firstCodeUnit = 0;
+            pcre2_pattern_info(analysis.get(), PCRE2_INFO_FIRSTCODEUNIT, &firstCodeUnit);
+            // The info call does not say whether the unit is caseless;
+            // allowing both ASCII cases keeps the filter conservative.
+            const auto unit = static_cast<unsigned char>(firstCodeUnit);
+            mFirstBytes.fill(0);
+            AllowFirstByte(unit);
+            if (unit >= 'A' && unit <= 'Z')
+            {
+                AllowFirstByte(static_cast<unsigned char>(unit + ('a' - 'A')));
+            }
+            else if (unit >= 'a' && unit <= 'z')
+            {
+                AllowFirstByte(static_cast<unsigned char>(unit - ('a' - 'A')));
+            }
+            return;
+        }
+        if (firstCodeType != 0)
+        {
+            return;
+        }
+        const uint8_t *bitmap = nullptr;
+        pcre2_pattern_info(analysis.get(), PCRE2_INFO_FIRSTBITMAP, static_cast<void *>(&bitmap));
+        if (bitmap == nullptr)
+        {
+            return;
+        }
+        mFirstBytes.fill(0);
+        for (unsigned byte = 0; byte < 256; ++byte)
+        {
+            if ((bitmap[byte / 8] & (1U << (byte % 8))) != 0)
+            {
+                AllowFirstByte(static_cast<unsigned char>(byte));
+            }
+        }
+    }
+
+    /// Pick a PCRE2-free decoder for @p pattern. Both kinds stop at `\r`
+    /// and `\n` inside `.` runs; the `ANY` and `NUL` newline conventions
+    /// treat further bytes as line ends, so they keep every line on PCRE2.
+    void SelectDecoderWithoutPcre2(std::string_view pattern)
+    {
+        mBuiltinDecoder = nullptr;
+        mDelimitedCaptures.reset();
+
+        uint32_t newline = 0;
+        pcre2_pattern_info(mCode.get(), PCRE2_INFO_NEWLINE, &newline);
+        if (newline == PCRE2_NEWLINE_ANY || newline == PCRE2_NEWLINE_NUL)
+        {
+            return;
+        }
+        const internal::BuiltinRegexDecoder *builtin = internal::FindBuiltinRegexDecoder(pattern);
+        if (builtin != nullptr && builtin->groupCount == mSchema.groupIndices.size())
+        {
+            mBuiltinDecoder = builtin;
+            return;
+        }
+        mDelimitedCaptures = internal::RecognizeDelimitedCapturePattern(pattern);
+    }
+
+    void AllowFirstByte(unsigned char byte) noexcept
+    {
+        mFirstBytes[byte / 64] |= uint64_t{1} << (byte % 64);
+    }
+
     Pcre2CodePtr mCode;
     Pcre2MatchContextPtr mContext;
     PatternSchema mSchema;
     std::string mPatternString;
     bool mJitCompiled = false;
+    bool mAnchored = false;
+    /// 256-bit set of bytes an anchored match may start with.
+    std::array<uint64_t, 4> mFirstBytes{~uint64_t{0}, ~uint64_t{0}, ~uint64_t{0}, ~uint64_t{0}};
+    const internal::BuiltinRegexDecoder *mBuiltinDecoder = nullptr;
+    std::optional<internal::DelimitedCapturePattern> mDelimitedCaptures;
 };
 
 // ---------------------------------------------------------------------
@@ -368,6 +531,12 @@ struct CompiledProbeSnapshot
     /// built against. The probe re-acquires when the counter
     /// advances.
     uint64_t generation = 0;
+    /// Multi-pattern first-byte prefilter: bit `i % 64` of word
+    /// `i / 64` in `firstByteCandidates[b]` is set when `compiled[i]`
+    /// can match a line starting with byte `b` (see
+    /// `CompiledPattern::MayStartWith`). One lookup per probe line
+    /// yields every template worth running PCRE2 for.
+    std::array<std::vector<uint64_t>, 256> firstByteCandidates;
 };
 
 /// Lazy, thread-safe singleton that mirrors the merged template
@@ -428,6 +597,20 @@ std::shared_ptr<const CompiledProbeSnapshot> CurrentProbeSnapshot()
         }
     }
 
+    const size_t words = (fresh->compiled.size() + 63) / 64;
+    for (size_t byte = 0; byte < fresh->firstByteCandidates.size(); ++byte)
+    {
+        std::vector<uint64_t> &candidates = fresh->firstByteCandidates[byte];
+        candidates.assign(words, 0);
+        for (size_t i = 0; i < fresh->compiled.size(); ++i)
+        {
+            if (fresh->compiled[i].compiled.MayStartWith(static_cast<char>(byte)))
+            {
+                candidates[i / 64] |= uint64_t{1} << (i % 64);
+            }
+        }
+    }
+
     const std::unique_lock<std::shared_mutex> write(mutex);
     // Re-check: another thread may have rebuilt against the same
     // generation between the read lock and the write lock. Prefer
@@ -455,10 +638,9 @@ std::shared_ptr<const CompiledProbeSnapshot> CurrentProbeSnapshot()
 /// the probe (or vice-versa). A per-call `pcre2_match_data` is
 /// used because the cache is process-wide; allocating one tiny
 /// block is cheap next to the match itself.
-bool MatchesFullyForProbe(const CompiledPattern &cp, std::string_view line)
+bool MatchesFullyForProbe(const CompiledPattern &cp, pcre2_match_data *md, std::string_view line)
 {
-    const Pcre2MatchDataPtr md = cp.NewMatchData();
-    if (md == nullptr)
+    if (!line.empty() && !cp.MayStartWith(line.front()))
     {
         return false;
     }
@@ -468,12 +650,18 @@ bool MatchesFullyForProbe(const CompiledPattern &cp, std::string_view line)
         line.size(),
         /*startoffset*/ 0,
         PCRE2_ANCHORED | PCRE2_ENDANCHORED,
-        md.get(),
+        md,
         cp.Context()
     );
     return rc > 0;
 }
 
+bool MatchesFullyForProbe(const CompiledPattern &cp, std::string_view line)
+{
+    const Pcre2MatchDataPtr md = cp.NewMatchData();
+    return md != nullptr && MatchesFullyForProbe(cp, md.get(), line);
+}
+
 /// UTF-8 BOM. Some editors (Notepad, older PowerShell) prepend it
 /// to text files; with the BOM intact the `^date` / `^IP` / `^[`
 /// anchors in the built-in templates can't bind to position 0 and
@@ -489,6 +677,9 @@ constexpr std::string_view UTF8_BOM = "\xEF\xBB\xBF";
 /// `IS_VALID_MIN_MATCHES` of the first non-blank lines from
 /// @p sniffBuffer, or nullptr. Built-ins probe before user
 /// templates by construction — see `CompiledProbeSnapshot`.
+/// The first-byte candidate sets narrow the field in one pass over
+/// the lines; large survivor sets are matched on TBB workers, still
+/// returning the lowest-ordered winner.
 const RegexTemplate *ProbeAutoDetectTemplates(std::string_view sniffBuffer)
 {
     std::vector<std::string> probeLines;
@@ -529,22 +720,91 @@ const RegexTemplate *ProbeAutoDetectTemplates(std::string_view sniffBuffer)
     {
         return nullptr;
     }
-    for (const CompiledTemplate &t : snapshot->compiled)
+
+    // One prefilter pass over the probe lines: per template, the set of
+    // lines whose first byte it can match. Only templates with at least
+    // `IS_VALID_MIN_MATCHES` such lines can win, so only they reach PCRE2.
+    static_assert(IS_VALID_PROBE_MAX_LINES <= 8, "probe line masks are 8 bits wide");
+    std::vector<uint8_t> lineMasks(snapshot->compiled.size(), 0);
+    for (size_t line = 0; line < probeLines.size(); ++line)
+    {
+        const auto firstByte = static_cast<unsigned char>(probeLines[line].front());
+        const std::vector<uint64_t> &candidates = snapshot->firstByteCandidates[firstByte];
+        for (size_t word = 0; word < candidates.size(); ++word)
+        {
+            for (uint64_t bits = candidates[word]; bits != 0; bits &= bits - 1)
+            {
+                lineMasks[(word * 64) + static_cast<size_t>(std::countr_zero(bits))] |=
+                    static_cast<uint8_t>(1U << line);
+            }
+        }
+    }
+    std::vector<size_t> candidates;
+    for (size_t i = 0; i < lineMasks.size(); ++i)
     {
+        if (static_cast<size_t>(std::popcount(lineMasks[i])) >= IS_VALID_MIN_MATCHES)
+        {
+            candidates.push_back(i);
+        }
+    }
+
+    const auto claims = [&snapshot, &probeLines, &lineMasks](size_t index) {
+        const CompiledPattern &compiled = snapshot->compiled[index].compiled;
+        const Pcre2MatchDataPtr md = compiled.NewMatchData();
+        if (md == nullptr)
+        {
+            return false;
+        }
         size_t hits = 0;
-        for (const std::string &l : probeLines)
+        for (uint8_t lines = lineMasks[index]; lines != 0; lines &= static_cast<uint8_t>(lines - 1))
         {
-            if (MatchesFullyForProbe(t.compiled, l))
+            if (MatchesFullyForProbe(compiled, md.get(), probeLines[static_cast<size_t>(std::countr_zero(lines))]) &&
+                ++hits >= IS_VALID_MIN_MATCHES)
             {
-                ++hits;
-                if (hits >= IS_VALID_MIN_MATCHES)
+                return true;
+            }
+        }
+        return false;
+    };
+
+    if (candidates.size() < PARALLEL_PROBE_MIN_TEMPLATES)
+    {
+        for (const size_t index : candidates)
+        {
+            if (claims(index))
+            {
+                return snapshot->compiled[index].source;
+            }
+        }
+        return nullptr;
+    }
+
+    // Probe order decides ties, so the winner is the lowest claiming
+    // candidate. Workers skip candidates above the best claim so far;
+    // every candidate below it is still checked in full.
+    std::atomic<size_t> winner{candidates.size()};
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, candidates.size(), 1),
+        [&candidates, &claims, &winner](const tbb::blocked_range<size_t> &range) {
+            for (size_t c = range.begin(); c != range.end(); ++c)
+            {
+                if (c >= winner.load(std::memory_order_relaxed))
                 {
-                    return t.source;
+                    return;
+                }
+                if (claims(candidates[c]))
+                {
+                    size_t best = winner.load(std::memory_order_relaxed);
+                    while (c < best && !winner.compare_exchange_weak(best, c, std::memory_order_relaxed))
+                    {
+                    }
+                    return;
                 }
             }
         }
-    }
-    return nullptr;
+    );
+    const size_t best = winner.load();
+    return best < candidates.size() ? snapshot->compiled[candidates[best]].source : nullptr;
 }
 
 // ---------------------------------------------------------------------
@@ -569,6 +829,25 @@ std::vector<KeyId> InternSchemaKeys(const PatternSchema &schema, KeyIndex &keys)
 // Match-and-emit: shared between the static and streaming pipelines.
 // ---------------------------------------------------------------------
 
+/// Append one captured group to @p out as a compact value. Empty
+/// captures are dropped: same convention as CSV, "field present but
+/// blank" doesn't bloat the per-line array.
+void EmitCapture(
+    KeyId keyId,
+    std::string_view captured,
+    const char *fileBegin,
+    size_t fileSize,
+    std::string &ownedArena,
+    std::vector<std::pair<KeyId, internal::CompactLogValue>> &out
+)
+{
+    if (captured.empty())
+    {
+        return;
+    }
+    out.emplace_back(keyId, internal::ClassifyBareScalar(captured, fileBegin, fileSize, ownedArena));
+}
+
 /// Run one `pcre2_match` against @p line and emit the captured
 /// named groups as compact values. `out` is appended in source
 /// order (caller sorts before constructing the `LogLine`). The
@@ -576,6 +855,12 @@ std::vector<KeyId> InternSchemaKeys(const PatternSchema &schema, KeyIndex &keys)
 /// typed (status codes, byte counts, ...), matching CSV's
 /// bare-cell typing.
 ///
+/// Two shortcuts skip PCRE2 without changing the result: a built-in
+/// template's hand-written decoder or a delimiter split fills
+/// @p splitScratch (any line they cannot settle still goes to PCRE2),
+/// and an anchored pattern rejects a line whose first byte cannot start
+/// a match.
+///
 /// `fileBegin`/`fileSize` enable the zero-copy `MmapSlice` fast
 /// path for static parsing; streaming callers pass `nullptr`/0.
 /// `errorOut` is populated on no-match / match-limit / other
@@ -591,6 +876,7 @@ bool MatchLineAndEmit(
     size_t fileSize,
     std::string &ownedArena,
     std::vector<std::pair<KeyId, internal::CompactLogValue>> &out,
+    std::vector<std::string_view> &splitScratch,
     std::string &errorOut
 )
 {
@@ -602,15 +888,30 @@ bool MatchLineAndEmit(
     out.clear();
     errorOut.clear();
 
-    const int rc = pcre2_match(
-        compiled.Code(),
-        reinterpret_cast<PCRE2_SPTR>(line.data()),
-        line.size(),
-        /*startoffset*/ 0,
-        /*options*/ 0,
-        matchData,
-        compiled.Context()
-    );
+    const auto &schema = compiled.Schema();
+    if (compiled.TryDecodeWithoutPcre2(line, splitScratch))
+    {
+        out.reserve(splitScratch.size());
+        for (size_t i = 0; i < splitScratch.size(); ++i)
+        {
+            EmitCapture(columnKeys[i], splitScratch[i], fileBegin, fileSize, ownedArena, out);
+        }
+        return true;
+    }
+
+    int rc = PCRE2_ERROR_NOMATCH;
+    if (!compiled.IsAnchored() || line.empty() || compiled.MayStartWith(line.front()))
+    {
+        rc = pcre2_match(
+            compiled.Code(),
+            reinterpret_cast<PCRE2_SPTR>(line.data()),
+            line.size(),
+            /*startoffset*/ 0,
+            /*options*/ 0,
+            matchData,
+            compiled.Context()
+        );
+    }
     if (rc == PCRE2_ERROR_NOMATCH)
     {
         errorOut = "Line did not match the regex pattern.";
@@ -630,7 +931,6 @@ bool MatchLineAndEmit(
     const PCRE2_SIZE *ovector = pcre2_get_ovector_pointer(matchData);
     const auto captureCount = static_cast<uint32_t>(rc);
 
-    const auto &schema = compiled.Schema();
     out.reserve(schema.groupIndices.size());
     for (size_t i = 0; i < schema.groupIndices.size(); ++i)
     {
@@ -648,17 +948,14 @@ bool MatchLineAndEmit(
             // return monostate.
             continue;
         }
-        const std::string_view captured(line.data() + startOff, endOff - startOff);
-        if (captured.empty())
-        {
-            // Same convention as CSV: an empty capture is
-            // "field present but blank" — drop it so it doesn't
-            // bloat the per-line array.
-            continue;
-        }
-        const internal::CompactLogValue compact =
-            internal::ClassifyBareScalar(captured, fileBegin, fileSize, ownedArena);
-        out.emplace_back(columnKeys[i], compact);
+        EmitCapture(
+            columnKeys[i],
+            std::string_view(line.data() + startOff, endOff - startOff),
+            fileBegin,
+            fileSize,
+            ownedArena,
+            out
+        );
     }
     return true;
 }
@@ -670,6 +967,7 @@ bool MatchLineAndEmit(
 struct RegexWorkerState
 {
     Pcre2MatchDataPtr matchData;
+    std::vector<std::string_view> captureScratch;
 };
 
 /// Lazily attach @p worker to @p compiled on first use.
@@ -700,15 +998,6 @@ struct RegexByteRange
 
 bool RegexLooksLikeHeader(const CompiledPattern &compiled, pcre2_match_data *matchData, std::string_view line);
 
-std::string_view StripCr(std::string_view s) noexcept
-{
-    if (!s.empty() && s.back() == '\r')
-    {
-        s.remove_suffix(1);
-    }
-    return s;
-}
-
 /// Strip a leading UTF-8 BOM from @p sv if present. Mirrors CSV's
 /// helper; only valid on the very first line of a file.
 std::string_view StripBom(std::string_view sv) noexcept
@@ -772,30 +1061,22 @@ void DecodeRegexBatch(
     // another continuation.
     size_t pendingLeadingBlanks = 0;
 
-    while (cursor < end)
+    internal::LineFramer framer(cursor, end, fileEnd, fileBegin);
+    internal::FramedLine framed;
+    while (framer.Next(framed))
     {
-        const char *lineStart = cursor;
-        const char *newline = static_cast<const char *>(memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
-        const char *lineEnd = (newline != nullptr) ? newline : end;
-        cursor = (newline != nullptr) ? newline + 1 : end;
-
-        std::string_view line(lineStart, static_cast<size_t>(lineEnd - lineStart));
-        line = StripCr(line);
+        std::string_view line = framed.Text();
         // Strip a leading UTF-8 BOM only when this line starts at
         // file byte 0. Keeps `^...` anchors in user / built-in
         // patterns binding after a BOM-prefixed editor save.
         // Stage A emits batches on line boundaries, so only the
         // first line of batch 0 can ever match here.
-        if (lineStart == fileBegin)
+        if (framed.begin == fileBegin)
         {
             line = StripBom(line);
         }
 
-        // Pad by 1 on an unterminated last line so the final
-        // byte isn't lost on `LogFile::GetLine` round-trips
-        // (matches the CSV pipeline).
-        const uint64_t nextOffset = static_cast<uint64_t>(cursor - fileBegin) + (newline == nullptr ? 1U : 0U);
-        parsed.localLineOffsets.push_back(nextOffset);
+        parsed.localLineOffsets.push_back(framed.nextOffset);
 
         if (line.empty())
         {
@@ -879,6 +1160,7 @@ void DecodeRegexBatch(
                 fileSize,
                 parsed.ownedStringsArena,
                 values,
+                worker.user.captureScratch,
                 lineError
             ))
         {
@@ -938,6 +1220,12 @@ bool RegexLooksLikeHeader(const CompiledPattern &compiled, pcre2_match_data *mat
     {
         return false;
     }
+    // Even a partial match must consume the first byte, so a line that
+    // cannot start a match is a continuation without running PCRE2.
+    if (!compiled.MayStartWith(line.front()))
+    {
+        return false;
+    }
     const int rc = pcre2_match(
         compiled.Code(),
         reinterpret_cast<PCRE2_SPTR>(line.data()),
@@ -1029,6 +1317,7 @@ public:
                 /*fileSize=*/0,
                 outOwnedArena,
                 out,
+                mCaptureScratch,
                 errorOut
             ))
         {
@@ -1054,6 +1343,7 @@ private:
     /// Match data is tied to `mHeaderProbe` and cannot be shared with
     /// the main pattern's match state.
     Pcre2MatchDataPtr mHeaderMatchData;
+    std::vector<std::string_view> mCaptureScratch;
     bool mSawFirstLine = false;
 };
 
@@ -1214,9 +1504,6 @@ void RegexParser::ParseStreaming(
                                                             : ResolvePattern(/*explicitPattern=*/std::nullopt, options);
 
     const LogFile &file = source.File();
-    const char *fileBegin = file.Data();
-    const size_t fileSize = file.Size();
-    const char *fileEnd = (fileBegin != nullptr) ? fileBegin + fileSize : nullptr;
 
     const size_t newKeyBaseline = sink.Keys().Size();
 
@@ -1278,33 +1565,8 @@ void RegexParser::ParseStreaming(
     const size_t batchSize = advanced.batchSizeBytes != 0 ? advanced.batchSizeBytes
                                                           : internal::AdvancedParserOptions::DEFAULT_BATCH_SIZE_BYTES;
 
-    const char *cursor = fileBegin;
-    uint64_t batchIndex = 0;
-    auto stageA = [cursor, fileEnd, batchSize, batchIndex](RegexByteRange &out) mutable -> bool {
-        if (cursor == nullptr || cursor >= fileEnd)
-        {
-            return false;
-        }
-        const char *batchBegin = cursor;
-        const auto remaining = static_cast<size_t>(fileEnd - cursor);
-        const size_t advance = std::min(batchSize, remaining);
-        const char *target = cursor + advance;
-        if (advance < remaining)
-        {
-            const char *newline =
-                static_cast<const char *>(memchr(target, '\n', static_cast<size_t>(fileEnd - target)));
-            cursor = (newline != nullptr) ? newline + 1 : fileEnd;
-        }
-        else
-        {
-            cursor = fileEnd;
-        }
-        out.batchIndex = batchIndex++;
-        out.bytesBegin = batchBegin;
-        out.bytesEnd = cursor;
-        out.fileEnd = fileEnd;
-        return true;
-    };
+    internal::StaticBatchCutter cutter(file, batchSize, options.stopToken);
+    auto stageA = [&cutter](RegexByteRange &out, size_t targetBytes) { return cutter.Next(out, targetBytes); };
 
     FileLineSource *sourcePtr = &source;
     auto stageB = [sourcePtr, &compiled, &columnKeys, staticContinuationMode, anchorPtr](
@@ -0,0 +1,163 @@
+#include "loglib/internal/pipeline_autotuner.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace loglib::internal
+{
+
+namespace
+{
+
+/// Weight of a new observation in the running averages.
+constexpr double SMOOTHING = 0.25;
+
+/// Stage B must trail Stage C by this factor before more workers are
+/// worth a pipeline drain.
+constexpr double STAGE_B_BOTTLENECK_RATIO = 1.25;
+
+void Smooth(double &average, double sample, uint64_t samples)
+{
+    average = samples == 1 ? sample : average + ((sample - average) * SMOOTHING);
+}
+
+size_t RoundUpToGranule(size_t bytes)
+{
+    constexpr size_t GRANULE = PipelineAutotuner::BATCH_SIZE_GRANULE;
+    return ((bytes + GRANULE - 1) / GRANULE) * GRANULE;
+}
+
+} // namespace
+
+PipelineAutotuner::PipelineAutotuner(
+    const AdvancedParserOptions &advanced, unsigned int threads, size_t ntokens, unsigned int hardwareThreads
+)
+    : mAdvanced(advanced),
+      mAdaptBatchSize(
+          advanced.autotune && (advanced.batchSizeBytes == 0 ||
+                                advanced.batchSizeBytes == AdvancedParserOptions::DEFAULT_BATCH_SIZE_BYTES)
+      ),
+      mAdaptThreads(advanced.autotune && advanced.threads == 0),
+      mHardwareThreads(std::max(hardwareThreads, threads)),
+      mThreads(threads),
+      mTokens(ntokens),
+      mBatchSize(
+          advanced.batchSizeBytes != 0 ? advanced.batchSizeBytes : AdvancedParserOptions::DEFAULT_BATCH_SIZE_BYTES
+      )
+{
+}
+
+void PipelineAutotuner::Observe(
+    size_t bytes, size_t lines, std::chrono::nanoseconds stageB, std::chrono::nanoseconds stageC
+)
+{
+    if (bytes == 0)
+    {
+        return;
+    }
+    ++mObservedBatches;
+    const auto byteCount = static_cast<double>(bytes);
+    const auto stageBNanos = static_cast<double>(stageB.count());
+    const auto stageCNanos = static_cast<double>(stageC.count());
+    Smooth(mBytesPerLine, byteCount / static_cast<double>(std::max<size_t>(lines, 1)), mObservedBatches);
+    Smooth(mStageBNanosPerByte, stageBNanos / byteCount, mObservedBatches);
+    Smooth(mStageCNanosPerByte, stageCNanos / byteCount, mObservedBatches);
+    Smooth(mStageBNanos, stageBNanos, mObservedBatches);
+    Smooth(mStageCNanos, stageCNanos, mObservedBatches);
+
+    if (mObservedBatches < CALIBRATION_BATCHES)
+    {
+        return;
+    }
+    if (mAdaptBatchSize)
+    {
+        RetuneBatchSize();
+    }
+    if (mAdaptThreads && !mThreadsDecided)
+    {
+        DecideThreads();
+    }
+}
+
+void PipelineAutotuner::RetuneBatchSize()
+{
+    const size_t current = BatchSizeBytes();
+    double desired = static_cast<double>(current);
+    if (mStageBNanosPerByte > 0.0)
+    {
+        const auto targetNanos = static_cast<double>(std::chrono::nanoseconds(TARGET_STAGE_B_LATENCY).count());
+        desired = targetNanos / mStageBNanosPerByte;
+    }
+    desired = std::max(desired, static_cast<double>(MIN_LINES_PER_BATCH) * mBytesPerLine);
+
+    // At most 2x either way, and only towards [MIN_BATCH_BYTES,
+    // MAX_BATCH_BYTES] from a size outside it.
+    const size_t lower = std::max(current / 2, std::min(current, MIN_BATCH_BYTES));
+    const size_t upper = std::min(current * 2, std::max(current, MAX_BATCH_BYTES));
+    const auto stepped =
+        static_cast<size_t>(std::clamp(desired, static_cast<double>(lower), static_cast<double>(upper)));
+    const size_t next = std::min(RoundUpToGranule(stepped), upper);
+    // Leave sizes within an eighth of the current one alone, so
+    // jitter in the averages doesn't re-cut every batch.
+    if (next > current + (current / 8) || next + (current / 8) < current)
+    {
+        mBatchSize.store(next, std::memory_order_relaxed);
+        Report();
+    }
+}
+
+void PipelineAutotuner::DecideThreads()
+{
+    mThreadsDecided = true;
+    if (mStageCNanosPerByte <= 0.0)
+    {
+        return;
+    }
+    const double stageBPerWorker = mStageBNanosPerByte / static_cast<double>(mThreads);
+    if (stageBPerWorker <= mStageCNanosPerByte * STAGE_B_BOTTLENECK_RATIO)
+    {
+        return;
+    }
+    const double workersToMatchStageC = std::ceil(mStageBNanosPerByte / mStageCNanosPerByte);
+    const auto wanted =
+        static_cast<unsigned int>(std::min(workersToMatchStageC, static_cast<double>(mHardwareThreads)));
+    if (wanted > mThreads)
+    {
+        mPendingThreads = wanted;
+        mReplanPending.store(true, std::memory_order_release);
+    }
+}
+
+void PipelineAutotuner::Replan()
+{
+    if (!mReplanPending.exchange(false, std::memory_order_acq_rel))
+    {
+        return;
+    }
+    mThreads = mPendingThreads;
+    mTokens = size_t{2} * static_cast<size_t>(mThreads);
+    Report();
+}
+
+PipelineTuning PipelineAutotuner::Current() const
+{
+    return PipelineTuning{
+        .threads = mThreads,
+        .ntokens = mTokens,
+        .batchSizeBytes = BatchSizeBytes(),
+        .observedBatches = mObservedBatches,
+        .bytesPerLine = mBytesPerLine,
+        .stageBLatency = std::chrono::nanoseconds(static_cast<int64_t>(mStageBNanos)),
+        .stageCLatency = std::chrono::nanoseconds(static_cast<int64_t>(mStageCNanos)),
+    };
+}
+
+void PipelineAutotuner::Report() const
+{
+    if (mAdvanced.onTuning)
+    {
+        mAdvanced.onTuning(Current());
+    }
+}
+
+} // namespace loglib::internal
@@ -0,0 +1,159 @@
+#include "loglib/internal/row_shape.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <utility>
+
+namespace loglib::internal
+{
+
+namespace
+{
+
+std::atomic<uint64_t> sNextRegistrySerial{1};
+
+/// Last shape this thread interned, tagged with its registry's serial.
+/// Parser workers emit long runs of same-shape rows, so this absorbs
+/// nearly every `Intern` call without touching the registry lock.
+struct LastInternedShape
+{
+    uint64_t registrySerial = 0;
+    const RowShape *shape = nullptr;
+};
+
+thread_local LastInternedShape tLastShape;
+
+uint64_t HashKeys(std::span<const std::pair<KeyId, CompactLogValue>> fields) noexcept
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const auto &entry : fields)
+    {
+        hash ^= entry.first;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash ^ fields.size();
+}
+
+} // namespace
+
+RowShape::RowShape(std::vector<KeyId> keys, uint64_t hash, uint64_t ownerSerial)
+    : mKeys(std::move(keys)), mHash(hash), mOwnerSerial(ownerSerial)
+{
+    if (!mKeys.empty())
+    {
+        mSlotOfKey.assign(static_cast<size_t>(mKeys.back()) + 1U, NO_SLOT);
+        for (size_t slot = 0; slot < mKeys.size(); ++slot)
+        {
+            mSlotOfKey[mKeys[slot]] = static_cast<uint16_t>(slot);
+        }
+    }
+}
+
+bool RowShape::Matches(std::span<const std::pair<KeyId, CompactLogValue>> fields) const noexcept
+{
+    if (fields.size() != mKeys.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < fields.size(); ++i)
+    {
+        if (fields[i].first != mKeys[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t RowShape::MemoryBytes() const noexcept
+{
+    return (mKeys.capacity() * sizeof(KeyId)) + (mSlotOfKey.capacity() * sizeof(uint16_t));
+}
+
+RowShapeRegistry::RowShapeRegistry()
+    : mSerial(sNextRegistrySerial.fetch_add(1, std::memory_order_relaxed))
+{
+}
+
+const RowShape *RowShapeRegistry::Intern(std::span<const std::pair<KeyId, CompactLogValue>> fields)
+{
+    if (fields.empty() || fields.size() >= RowShape::NO_SLOT || fields.back().first >= MAX_SHAPED_KEY_ID)
+    {
+        return nullptr;
+    }
+    if (tLastShape.registrySerial == mSerial && tLastShape.shape->Matches(fields))
+    {
+        return tLastShape.shape;
+    }
+
+    const uint64_t hash = HashKeys(fields);
+    const auto findLocked = [&]() -> const RowShape * {
+        const auto it = mByHash.find(hash);
+        if (it == mByHash.end())
+        {
+            return nullptr;
+        }
+        const auto match = std::ranges::find_if(it->second, [&](const RowShape *shape) {
+            return shape->Matches(fields);
+        });
+        return match != it->second.end() ? *match : nullptr;
+    };
+
+    const RowShape *shape = nullptr;
+    {
+        const std::shared_lock<std::shared_mutex> lock(mMutex);
+        shape = findLocked();
+        if (shape == nullptr && mShapes.size() >= MAX_SHAPES)
+        {
+            return nullptr;
+        }
+    }
+    if (shape == nullptr)
+    {
+        const std::unique_lock<std::shared_mutex> lock(mMutex);
+        shape = findLocked();
+        if (shape == nullptr)
+        {
+            if (mShapes.size() >= MAX_SHAPES)
+            {
+                return nullptr;
+            }
+            std::vector<KeyId> keys;
+            keys.reserve(fields.size());
+            for (const auto &entry : fields)
+            {
+                keys.push_back(entry.first);
+            }
+            shape = &mShapes.emplace_back(std::move(keys), hash, mSerial);
+            mByHash[hash].push_back(shape);
+        }
+    }
+    tLastShape = {.registrySerial = mSerial, .shape = shape};
+    return shape;
+}
+
+size_t RowShapeRegistry::Size() const
+{
+    const std::shared_lock<std::shared_mutex> lock(mMutex);
+    return mShapes.size();
+}
+
+size_t RowShapeRegistry::MemoryBytes() const
+{
+    const std::shared_lock<std::shared_mutex> lock(mMutex);
+    size_t bytes = mShapes.size() * sizeof(RowShape);
+    for (const RowShape &shape : mShapes)
+    {
+        bytes += shape.MemoryBytes();
+    }
+    bytes += mByHash.size() * (sizeof(uint64_t) + sizeof(std::vector<const RowShape *>) + sizeof(const RowShape *));
+    return bytes;
+}
+
+const RowShape *InternRowShape(const KeyIndex &keys, std::span<const std::pair<KeyId, CompactLogValue>> fields)
+{
+    return keys.Shapes().Intern(fields);
+}
+
+} // namespace loglib::internal
@@ -0,0 +1,190 @@
+#include "loglib/internal/seek_index.hpp"
+
+#include "loglib/internal/sidecar_io.hpp"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <fstream>
+#include <ios>
+#include <string_view>
+#include <utility>
+
+namespace loglib::internal
+{
+
+namespace
+{
+
+/// Sidecar layout, little-endian:
+///   magic, compressedSize u64, modifiedTime i64, fingerprint u64,
+///   decodedSize u64, pointCount u32, then per point:
+///   compressedOffset u64, decodedOffset u64, bits u8,
+///   windowBytes u32, storedBytes u32, zlib-compressed window.
+constexpr std::string_view SIDECAR_MAGIC = "SLVGZIX1";
+constexpr std::string_view SIDECAR_EXTENSION = ".gzidx";
+
+/// Largest window inflate can use.
+constexpr std::size_t MAX_WINDOW_BYTES = std::size_t{32} << 10;
+
+/// Bytes hashed at each end of the compressed input.
+constexpr std::size_t FINGERPRINT_EDGE_BYTES = std::size_t{4} << 10;
+
+constexpr std::uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+constexpr std::uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+} // namespace
+
+std::uint64_t SeekIndexFingerprint(std::span<const std::uint8_t> compressed) noexcept
+{
+    std::uint64_t hash = FNV_OFFSET_BASIS;
+    const auto mix = [&hash](std::span<const std::uint8_t> bytes) {
+        for (const std::uint8_t byte : bytes)
+        {
+            hash = (hash ^ byte) * FNV_PRIME;
+        }
+    };
+    const std::size_t edge = std::min(compressed.size(), FINGERPRINT_EDGE_BYTES);
+    mix(compressed.first(edge));
+    mix(compressed.last(edge));
+    return hash;
+}
+
+std::filesystem::path SeekIndexPath(const std::filesystem::path &indexDir, const std::filesystem::path &source)
+{
+    return SidecarPath(indexDir, source, SIDECAR_EXTENSION);
+}
+
+std::optional<GzipSeekIndex> LoadGzipSeekIndex(
+    const std::filesystem::path &indexDir, const std::filesystem::path &source, std::uint64_t fingerprint
+) noexcept
+{
+    try
+    {
+        const std::filesystem::path sidecar = SeekIndexPath(indexDir, source);
+        const std::optional<std::int64_t> modified = ModifiedTime(source);
+        if (sidecar.empty() || !modified.has_value())
+        {
+            return std::nullopt;
+        }
+        std::ifstream in(sidecar, std::ios::binary);
+        if (!in.is_open())
+        {
+            return std::nullopt;
+        }
+        SidecarReader reader(in);
+
+        std::array<char, SIDECAR_MAGIC.size()> magic{};
+        GzipSeekIndex index;
+        std::uint32_t pointCount = 0;
+        if (!reader.GetBytes(magic.data(), magic.size()) ||
+            std::string_view(magic.data(), magic.size()) != SIDECAR_MAGIC || !reader.Get(index.compressedSize) ||
+            !reader.Get(index.modifiedTime) || !reader.Get(index.fingerprint) || !reader.Get(index.decodedSize) ||
+            !reader.Get(pointCount))
+        {
+            return std::nullopt;
+        }
+        if (index.compressedSize != std::filesystem::file_size(source) || index.modifiedTime != *modified ||
+            index.fingerprint != fingerprint)
+        {
+            return std::nullopt;
+        }
+
+        std::vector<std::uint8_t> stored;
+        index.points.reserve(std::min<std::size_t>(pointCount, 1 << 16));
+        for (std::uint32_t i = 0; i < pointCount; ++i)
+        {
+            GzipSeekPoint point;
+            std::uint32_t windowBytes = 0;
+            std::uint32_t storedBytes = 0;
+            if (!reader.Get(point.compressedOffset) || !reader.Get(point.decodedOffset) || !reader.Get(point.bits) ||
+                !reader.Get(windowBytes) || !reader.Get(storedBytes))
+            {
+                return std::nullopt;
+            }
+            const bool ordered = index.points.empty() ||
+                                 (point.compressedOffset > index.points.back().compressedOffset &&
+                                  point.decodedOffset > index.points.back().decodedOffset);
+            if (!ordered || point.bits > 7 || point.compressedOffset == 0 ||
+                point.compressedOffset >= index.compressedSize || point.decodedOffset > index.decodedSize ||
+                windowBytes > MAX_WINDOW_BYTES || storedBytes > compressBound(MAX_WINDOW_BYTES))
+            {
+                return std::nullopt;
+            }
+            stored.resize(storedBytes);
+            if (!reader.GetBytes(stored.data(), stored.size()))
+            {
+                return std::nullopt;
+            }
+            point.window.resize(windowBytes);
+            uLongf windowLength = windowBytes;
+            if (::uncompress(point.window.data(), &windowLength, stored.data(), storedBytes) != Z_OK ||
+                windowLength != windowBytes)
+            {
+                return std::nullopt;
+            }
+            index.points.push_back(std::move(point));
+        }
+        return index;
+    }
+    catch (const std::exception &)
+    {
+        return std::nullopt;
+    }
+}
+
+void SaveGzipSeekIndex(
+    const std::filesystem::path &indexDir, const std::filesystem::path &source, const GzipSeekIndex &index
+) noexcept
+{
+    try
+    {
+        const std::filesystem::path sidecar = SeekIndexPath(indexDir, source);
+        const std::optional<std::int64_t> modified = ModifiedTime(source);
+        if (sidecar.empty() || !modified.has_value())
+        {
+            return;
+        }
+        const bool written = WriteSidecarAtomically(sidecar, [&index, &modified](SidecarWriter &writer) {
+            writer.PutBytes(SIDECAR_MAGIC.data(), SIDECAR_MAGIC.size());
+            writer.Put(index.compressedSize);
+            writer.Put(*modified);
+            writer.Put(index.fingerprint);
+            writer.Put(index.decodedSize);
+            writer.Put(static_cast<std::uint32_t>(index.points.size()));
+
+            std::vector<std::uint8_t> stored(compressBound(MAX_WINDOW_BYTES));
+            for (const GzipSeekPoint &point : index.points)
+            {
+                const std::size_t windowBytes = std::min(point.window.size(), MAX_WINDOW_BYTES);
+                uLongf storedBytes = static_cast<uLongf>(stored.size());
+                if (::compress2(
+                        stored.data(), &storedBytes, point.window.data(), static_cast<uLong>(windowBytes), Z_BEST_SPEED
+                    ) != Z_OK)
+                {
+                    return false;
+                }
+                writer.Put(point.compressedOffset);
+                writer.Put(point.decodedOffset);
+                writer.Put(point.bits);
+                writer.Put(static_cast<std::uint32_t>(windowBytes));
+                writer.Put(static_cast<std::uint32_t>(storedBytes));
+                writer.PutBytes(stored.data(), storedBytes);
+            }
+            return true;
+        });
+        if (!written)
+        {
+            return;
+        }
+        PruneSidecars(indexDir, SIDECAR_EXTENSION, MAX_SEEK_INDEX_FILES);
+    }
+    catch (const std::exception &)
+    {
+        // Best-effort cache; see the header.
+    }
+}
+
+} // namespace loglib::internal
@@ -6,6 +6,7 @@
 #include "loglib/line_source.hpp"
 #include "loglib/log_data.hpp"
 #include "loglib/log_line.hpp"
+#include "loglib/log_line_store.hpp"
 #include "loglib/log_table.hpp"
 
 #include <glaze/glaze.hpp>
@@ -448,7 +449,7 @@ AnchorWantedSet BuildAnchorWantedSet(const std::vector<LogConfiguration::AnchorE
 }
 
 void PopulateAnchorMatches(
-    AnchorWantedSet &wanted, const std::vector<LogLine> &lines, const SessionBundleWriteOptions &options
+    AnchorWantedSet &wanted, const LogLineStore &lines, const SessionBundleWriteOptions &options
 )
 {
     if (wanted.empty())
@@ -501,7 +502,7 @@ void PopulateAnchorMatches(
 
 void RemapAnchors(
     LogConfiguration &configuration,
-    const std::vector<LogLine> &lines,
+    const LogLineStore &lines,
     std::string_view flattenedLocator,
     const SessionBundleWriteOptions &options
 )
@@ -0,0 +1,114 @@
+#include "loglib/internal/sidecar_io.hpp"
+
+#include "loglib/internal/file_identity.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <exception>
+#include <random>
+#include <system_error>
+#include <utility>
+
+namespace loglib::internal
+{
+
+std::optional<std::int64_t> ModifiedTime(const std::filesystem::path &path) noexcept
+{
+    std::error_code ec;
+    const auto time = std::filesystem::last_write_time(path, ec);
+    if (ec)
+    {
+        return std::nullopt;
+    }
+    return static_cast<std::int64_t>(time.time_since_epoch().count());
+}
+
+std::filesystem::path SidecarPath(
+    const std::filesystem::path &indexDir, const std::filesystem::path &source, std::string_view extension
+)
+{
+    const FileIdentity identity = FromPath(source);
+    if (!identity.valid || indexDir.empty())
+    {
+        return {};
+    }
+    return indexDir / fmt::format("{:016x}-{:016x}{}", identity.high, identity.low, extension);
+}
+
+bool WriteSidecarAtomically(
+    const std::filesystem::path &sidecar, const std::function<bool(SidecarWriter &)> &write
+) noexcept
+{
+    try
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(sidecar.parent_path(), ec);
+        if (ec)
+        {
+            return false;
+        }
+
+        std::random_device rd;
+        std::filesystem::path staging = sidecar;
+        staging += fmt::format(".{:08x}.tmp", rd());
+        {
+            std::ofstream out(staging, std::ios::binary | std::ios::trunc);
+            if (!out.is_open())
+            {
+                return false;
+            }
+            SidecarWriter writer(out);
+            if (!write(writer) || !out.flush())
+            {
+                out.close();
+                std::filesystem::remove(staging, ec);
+                return false;
+            }
+        }
+        std::filesystem::rename(staging, sidecar, ec);
+        if (ec)
+        {
+            std::filesystem::remove(staging, ec);
+            return false;
+        }
+        return true;
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+}
+
+void PruneSidecars(const std::filesystem::path &indexDir, std::string_view extension, std::size_t maxFiles) noexcept
+{
+    try
+    {
+        std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> sidecars;
+        for (const auto &entry : std::filesystem::directory_iterator(indexDir))
+        {
+            if (entry.is_regular_file() && entry.path().extension() == extension)
+            {
+                sidecars.emplace_back(entry.last_write_time(), entry.path());
+            }
+        }
+        if (sidecars.size() <= maxFiles)
+        {
+            return;
+        }
+        std::sort(sidecars.begin(), sidecars.end());
+        const std::size_t excess = sidecars.size() - maxFiles;
+        for (std::size_t i = 0; i < excess; ++i)
+        {
+            std::error_code ec;
+            std::filesystem::remove(sidecars[i].second, ec);
+        }
+    }
+    catch (const std::exception &)
+    {
+        // Pruning is housekeeping; a racing writer or unreadable entry
+        // only delays it to the next save.
+    }
+}
+
+} // namespace loglib::internal
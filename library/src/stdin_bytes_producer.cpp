@@ -188,7 +188,7 @@ class StdinBytesProducerImpl
 {
 public:
     StdinBytesProducerImpl(NativeHandle handle, StdinBytesProducer::Options options)
-        : mHandle(handle), mOptions(std::move(options))
+        : mHandle(handle), mOptions(std::move(options)), mQueue(mOptions.queueCapBytes)
     {
         if (!IsValidNative(mHandle))
         {
@@ -221,14 +221,22 @@ public:
 
     std::size_t Read(std::span<char> buffer)
     {
-        const std::scoped_lock lock(mLock);
         return mQueue.Read(buffer);
     }
 
+    [[nodiscard]] std::span<const char> BorrowBytes(std::size_t maxBytes)
+    {
+        return mQueue.Borrow(maxBytes);
+    }
+
+    void ReleaseBorrowedBytes() noexcept
+    {
+        mQueue.ReleaseBorrowed();
+    }
+
     void WaitForBytes(std::chrono::milliseconds timeout)
     {
-        std::unique_lock<std::mutex> lock(mLock);
-        mCv.wait_for(lock, timeout, [this] { return !mQueue.Empty() || mClosed.load(std::memory_order_acquire); });
+        mQueue.WaitForBytes(timeout, [this] { return mClosed.load(std::memory_order_acquire); });
     }
 
     void Stop() noexcept
@@ -316,7 +324,7 @@ public:
             break;
         }
 #endif
-        mCv.notify_all();
+        mQueue.WakeConsumer();
 
 #ifdef _WIN32
         // Race guard: `CancelIoEx` above only cancels
@@ -465,9 +473,8 @@ private:
             const long long got = ReadNative(handle, chunk.data(), chunk.size());
             if (got > 0)
             {
-                const std::scoped_lock lock(mLock);
-                mQueue.Append(chunk.data(), static_cast<std::size_t>(got), mOptions.queueCapBytes, mDropped);
-                mCv.notify_all();
+                // Lock-free; wakes a parked parser itself.
+                mQueue.Append(chunk.data(), static_cast<std::size_t>(got), mDropped);
                 continue;
             }
             // got == 0 (EOF) or got == -1 (hard error). Both are
@@ -479,11 +486,11 @@ private:
             const std::scoped_lock lock(mLock);
             mClosed.store(true, std::memory_order_release);
         }
-        mCv.notify_all();
+        mQueue.WakeConsumer();
     }
 
+    /// Guards `mHandle`. The byte path does not take it.
     mutable std::mutex mLock;
-    std::condition_variable mCv;
     NativeHandle mHandle = INVALID_NATIVE;
 #ifndef _WIN32
     // POSIX self-pipe used to wake the worker's `poll` without
@@ -537,6 +544,21 @@ std::size_t StdinBytesProducer::Read(std::span<char> buffer)
     return mImpl->Read(buffer);
 }
 
+bool StdinBytesProducer::SupportsBorrowedBytes() const noexcept
+{
+    return true;
+}
+
+std::span<const char> StdinBytesProducer::BorrowBytes(std::size_t maxBytes)
+{
+    return mImpl->BorrowBytes(maxBytes);
+}
+
+void StdinBytesProducer::ReleaseBorrowedBytes() noexcept
+{
+    mImpl->ReleaseBorrowedBytes();
+}
+
 void StdinBytesProducer::WaitForBytes(std::chrono::milliseconds timeout)
 {
     mImpl->WaitForBytes(timeout);
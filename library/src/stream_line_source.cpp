@@ -3,6 +3,8 @@
 #include "loglib/bytes_producer.hpp"
 
 #include <algorithm>
+#include <cstring>
+#include <limits>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -10,9 +12,34 @@
 namespace loglib
 {
 
+StreamLineSource::ReadGuard::ReadGuard(const StreamLineSource &source) noexcept
+{
+    // Register in the current epoch's slot, then confirm the epoch did
+    // not move underneath us; otherwise the writer may already have
+    // checked that slot for drain and we must retry in the new one.
+    for (;;)
+    {
+        const uint64_t epoch = source.mEpoch.load();
+        std::atomic<uint32_t> &slot = source.mActiveReaders[epoch & 1U];
+        slot.fetch_add(1);
+        if (source.mEpoch.load() == epoch)
+        {
+            mSlot = &slot;
+            return;
+        }
+        slot.fetch_sub(1);
+    }
+}
+
+StreamLineSource::ReadGuard::~ReadGuard()
+{
+    mSlot->fetch_sub(1, std::memory_order_release);
+}
+
 StreamLineSource::StreamLineSource(std::filesystem::path displayName, std::unique_ptr<BytesProducer> producer)
-    : mDisplayName(std::move(displayName)), mProducer(std::move(producer))
+    : mDisplayName(std::move(displayName)), mProducer(std::move(producer)), mTable(std::make_unique<IndexTable>())
 {
+    mPublishedTable.store(mTable.get(), std::memory_order_release);
 }
 
 StreamLineSource::~StreamLineSource() = default;
@@ -24,12 +51,14 @@ const std::filesystem::path &StreamLineSource::Path() const noexcept
 
 std::string StreamLineSource::RawLine(size_t lineId) const
 {
-    const std::scoped_lock guard(mLock);
-    if (!LineIsLiveLocked(lineId))
     {
-        throw std::out_of_range("StreamLineSource::RawLine: lineId " + std::to_string(lineId) + " is not available");
+        const ReadGuard guard(*this);
+        if (const LineEntry *entry = FindEntry(lineId); entry != nullptr)
+        {
+            return std::string(std::string_view(entry->bytes, entry->rawLength));
+        }
     }
-    return mLines[IndexForLocked(lineId)];
+    throw std::out_of_range("StreamLineSource::RawLine: lineId " + std::to_string(lineId) + " is not available");
 }
 
 std::string_view StreamLineSource::ResolveMmapBytes(
@@ -42,20 +71,45 @@ std::string_view StreamLineSource::ResolveMmapBytes(
 
 std::string_view StreamLineSource::ResolveOwnedBytes(uint64_t offset, uint32_t length, size_t lineId) const noexcept
 {
-    const std::scoped_lock guard(mLock);
-    if (!LineIsLiveLocked(lineId))
+    uint32_t ownedLength = 0;
+    {
+        const ReadGuard guard(*this);
+        const LineEntry *entry = FindEntry(lineId);
+        if (entry == nullptr)
+        {
+            return {};
+        }
+        ownedLength = entry->ownedLength;
+        if (offset + length <= ownedLength)
+        {
+            // Chunks are freed only by `EvictBefore`, so the view
+            // outlives the guard. Callers must not retain it past the
+            // next `EvictBefore` for this line id.
+            return {entry->bytes + entry->rawLength + offset, length};
+        }
+    }
+    if (offset < ownedLength)
+    {
+        return {};
+    }
+
+    // Bytes added by `AppendOwnedBytes` after the line was committed.
+    const std::scoped_lock lock(mWriteLock);
+    if (lineId < mFirstAvailableLineId.load(std::memory_order_relaxed))
+    {
+        return {};
+    }
+    const auto it = mLateOwnedBytes.find(lineId);
+    if (it == mLateOwnedBytes.end())
     {
         return {};
     }
-    const std::string &arena = mLineOwnedBytes[IndexForLocked(lineId)];
-    if (offset > arena.size() || offset + length > arena.size())
+    const uint64_t lateOffset = offset - ownedLength;
+    if (lateOffset + length > it->second.size())
     {
         return {};
     }
-    // Deque entries are reference-stable until evicted, so the view
-    // outlives the lock release. Callers must not retain it past the
-    // next `EvictBefore` for this line id.
-    return {arena.data() + offset, length};
+    return {it->second.data() + lateOffset, length};
 }
 
 std::span<const char> StreamLineSource::StableBytes() const noexcept
@@ -67,16 +121,17 @@ std::span<const char> StreamLineSource::StableBytes() const noexcept
 
 uint64_t StreamLineSource::AppendOwnedBytes(size_t lineId, std::string_view bytes)
 {
-    const std::scoped_lock guard(mLock);
-    if (!LineIsLiveLocked(lineId))
+    const std::scoped_lock lock(mWriteLock);
+    const LineEntry *entry = FindEntry(lineId);
+    if (entry == nullptr)
     {
         throw std::out_of_range(
             "StreamLineSource::AppendOwnedBytes: lineId " + std::to_string(lineId) + " is not available"
         );
     }
-    std::string &arena = mLineOwnedBytes[IndexForLocked(lineId)];
-    const uint64_t offset = arena.size();
-    arena.append(bytes.data(), bytes.size());
+    std::string &late = mLateOwnedBytes[lineId];
+    const uint64_t offset = entry->ownedLength + late.size();
+    late.append(bytes.data(), bytes.size());
     return offset;
 }
 
@@ -87,27 +142,55 @@ bool StreamLineSource::SupportsEviction() const noexcept
 
 void StreamLineSource::EvictBefore(size_t firstSurvivingLineId)
 {
-    const std::scoped_lock guard(mLock);
-    if (firstSurvivingLineId <= mFirstAvailableLineId)
+    const std::scoped_lock lock(mWriteLock);
+    const size_t first = mFirstAvailableLineId.load(std::memory_order_relaxed);
+    if (firstSurvivingLineId <= first)
     {
         return;
     }
     // Cap at `mNextLineId`: an over-shot caller drops everything held
     // and `AppendLine` resumes at `mNextLineId`.
-    const size_t target = std::min(firstSurvivingLineId, mNextLineId);
-    const size_t drop = target - mFirstAvailableLineId;
-    for (size_t i = 0; i < drop; ++i)
+    const size_t target = std::min(firstSurvivingLineId, mNextLineId.load(std::memory_order_relaxed));
+    // Unlink before retiring: readers arriving from here on reject the
+    // evicted ids, and earlier readers are covered by the epoch.
+    mFirstAvailableLineId.store(target);
+
+    Retired retired;
+    while (!mChunks.empty() && mChunks.front().lastLineId < target)
+    {
+        retired.bytes += mChunks.front().capacity;
+        retired.chunks.push_back(std::move(mChunks.front().bytes));
+        mChunks.pop_front();
+    }
+
+    size_t droppedBlocks = 0;
+    while (droppedBlocks < mIndexBlocks.size() &&
+           mTable->baseLineId + ((droppedBlocks + 1) * INDEX_BLOCK_LINES) <= target)
+    {
+        retired.blocks.push_back(std::move(mIndexBlocks[droppedBlocks]));
+        retired.bytes += INDEX_BLOCK_BYTES;
+        ++droppedBlocks;
+    }
+    if (droppedBlocks > 0)
+    {
+        mIndexBlocks.erase(mIndexBlocks.begin(), mIndexBlocks.begin() + static_cast<std::ptrdiff_t>(droppedBlocks));
+        auto table = std::make_unique<IndexTable>();
+        table->baseLineId = mTable->baseLineId + (droppedBlocks * INDEX_BLOCK_LINES);
+        table->blocks.assign(mTable->blocks.begin() + static_cast<std::ptrdiff_t>(droppedBlocks), mTable->blocks.end());
+        PublishTableLocked(std::move(table));
+    }
+
+    mLateOwnedBytes.erase(mLateOwnedBytes.begin(), mLateOwnedBytes.lower_bound(target));
+
+    if (!retired.chunks.empty() || !retired.blocks.empty())
     {
-        mLines.pop_front();
-        mLineOwnedBytes.pop_front();
+        RetireLocked(std::move(retired));
     }
-    mFirstAvailableLineId = target;
 }
 
 size_t StreamLineSource::FirstAvailableLineId() const noexcept
 {
-    const std::scoped_lock guard(mLock);
-    return mFirstAvailableLineId;
+    return mFirstAvailableLineId.load(std::memory_order_acquire);
 }
 
 BytesProducer *StreamLineSource::Producer() noexcept
@@ -120,53 +203,167 @@ const BytesProducer *StreamLineSource::Producer() const noexcept
     return mProducer.get();
 }
 
-size_t StreamLineSource::AppendLine(std::string rawLine, std::string ownedBytes)
+size_t StreamLineSource::AppendLine(std::string_view rawLine, std::string_view ownedBytes)
 {
-    const std::scoped_lock guard(mLock);
-    const size_t lineId = mNextLineId++;
-    mLines.push_back(std::move(rawLine));
-    mLineOwnedBytes.push_back(std::move(ownedBytes));
+    if (rawLine.size() > std::numeric_limits<uint32_t>::max() ||
+        ownedBytes.size() > std::numeric_limits<uint32_t>::max())
+    {
+        throw std::length_error("StreamLineSource::AppendLine: line exceeds 4 GiB");
+    }
+
+    const std::scoped_lock lock(mWriteLock);
+    const size_t lineId = mNextLineId.load(std::memory_order_relaxed);
+    char *bytes = ReserveBytesLocked(rawLine.size() + ownedBytes.size(), lineId);
+    if (!rawLine.empty())
+    {
+        std::memcpy(bytes, rawLine.data(), rawLine.size());
+    }
+    if (!ownedBytes.empty())
+    {
+        std::memcpy(bytes + rawLine.size(), ownedBytes.data(), ownedBytes.size());
+    }
+    *EntryForLocked(lineId) = LineEntry{
+        .bytes = bytes,
+        .rawLength = static_cast<uint32_t>(rawLine.size()),
+        .ownedLength = static_cast<uint32_t>(ownedBytes.size()),
+    };
+    // Publishes the entry and its bytes to lock-free readers.
+    mNextLineId.store(lineId + 1, std::memory_order_release);
+
+    if (!mRetired.empty())
+    {
+        ReclaimLocked();
+    }
     return lineId;
 }
 
 size_t StreamLineSource::Size() const noexcept
 {
-    const std::scoped_lock guard(mLock);
-    return mLines.size();
+    const size_t first = mFirstAvailableLineId.load(std::memory_order_acquire);
+    const size_t next = mNextLineId.load(std::memory_order_acquire);
+    return next > first ? next - first : 0;
 }
 
 size_t StreamLineSource::OwnedMemoryBytes() const noexcept
 {
-    const std::scoped_lock guard(mLock);
-    // STRICT LOWER BOUND: this counts the per-string control block
-    // (`sizeof(std::string)` per element) plus each string's heap
-    // `capacity()`. It does NOT count `std::deque`'s per-block
-    // bookkeeping (deque has no public `capacity()`), nor any small-
-    // string-optimisation slack inside the control block, nor the
-    // mutex / member overhead of `*this`. For "is this stream growing
-    // unboundedly?" diagnostics the lower bound is more useful than a
-    // pessimistic estimate that conflates allocator block-rounding
-    // with logical growth, so callers should treat it as such.
-    size_t total = (mLines.size() + mLineOwnedBytes.size()) * sizeof(std::string);
-    for (const auto &line : mLines)
+    const std::scoped_lock lock(mWriteLock);
+    // Chunks count at capacity, so the tail slack of the current chunk
+    // (up to `CHUNK_BYTES`) is included; memory retired but not yet
+    // reclaimed counts too, since it is still resident.
+    size_t total = mRetiredBytes;
+    for (const Chunk &chunk : mChunks)
     {
-        total += line.capacity();
+        total += chunk.capacity;
     }
-    for (const auto &arena : mLineOwnedBytes)
+    total += mIndexBlocks.size() * INDEX_BLOCK_BYTES;
+    total += sizeof(IndexTable) + (mTable->blocks.capacity() * sizeof(const LineEntry *));
+    for (const auto &[lineId, late] : mLateOwnedBytes)
     {
-        total += arena.capacity();
+        total += sizeof(lineId) + sizeof(late) + late.capacity();
     }
     return total;
 }
 
-bool StreamLineSource::LineIsLiveLocked(size_t lineId) const noexcept
+const StreamLineSource::LineEntry *StreamLineSource::FindEntry(size_t lineId) const noexcept
+{
+    if (lineId < mFirstAvailableLineId.load(std::memory_order_acquire) ||
+        lineId >= mNextLineId.load(std::memory_order_acquire))
+    {
+        return nullptr;
+    }
+    // Loaded after `mNextLineId`, so the table covers every line below it.
+    const IndexTable *table = mPublishedTable.load(std::memory_order_acquire);
+    if (lineId < table->baseLineId)
+    {
+        return nullptr;
+    }
+    const size_t relative = lineId - table->baseLineId;
+    const size_t block = relative / INDEX_BLOCK_LINES;
+    if (block >= table->blocks.size())
+    {
+        return nullptr;
+    }
+    return &table->blocks[block][relative % INDEX_BLOCK_LINES];
+}
+
+StreamLineSource::LineEntry *StreamLineSource::EntryForLocked(size_t lineId) noexcept
 {
-    return lineId >= mFirstAvailableLineId && lineId < mNextLineId;
+    const size_t relative = lineId - mTable->baseLineId;
+    const size_t block = relative / INDEX_BLOCK_LINES;
+    if (block == mIndexBlocks.size())
+    {
+        mIndexBlocks.push_back(std::make_unique<LineEntry[]>(INDEX_BLOCK_LINES));
+        auto table = std::make_unique<IndexTable>(*mTable);
+        table->blocks.push_back(mIndexBlocks.back().get());
+        PublishTableLocked(std::move(table));
+    }
+    return &mIndexBlocks[block][relative % INDEX_BLOCK_LINES];
 }
 
-size_t StreamLineSource::IndexForLocked(size_t lineId) const noexcept
+char *StreamLineSource::ReserveBytesLocked(size_t bytes, size_t lineId)
 {
-    return lineId - mFirstAvailableLineId;
+    if (bytes == 0)
+    {
+        return nullptr;
+    }
+    if (mChunks.empty() || mChunks.back().capacity - mChunks.back().used < bytes)
+    {
+        // The abandoned tail of the previous chunk stays as slack until
+        // the chunk is evicted.
+        const size_t capacity = std::max(CHUNK_BYTES, bytes);
+        mChunks.push_back(Chunk{
+            .bytes = std::make_unique_for_overwrite<char[]>(capacity),
+            .capacity = capacity,
+            .used = 0,
+            .lastLineId = lineId,
+        });
+    }
+    Chunk &chunk = mChunks.back();
+    char *result = chunk.bytes.get() + chunk.used;
+    chunk.used += bytes;
+    chunk.lastLineId = lineId;
+    return result;
+}
+
+void StreamLineSource::PublishTableLocked(std::unique_ptr<IndexTable> table)
+{
+    mPublishedTable.store(table.get());
+    Retired retired;
+    retired.bytes = sizeof(IndexTable) + (mTable->blocks.capacity() * sizeof(const LineEntry *));
+    retired.table = std::exchange(mTable, std::move(table));
+    RetireLocked(std::move(retired));
+}
+
+void StreamLineSource::RetireLocked(Retired retired)
+{
+    retired.epoch = mEpoch.load(std::memory_order_relaxed);
+    mRetiredBytes += retired.bytes;
+    mRetired.push_back(std::move(retired));
+    ReclaimLocked();
+}
+
+void StreamLineSource::ReclaimLocked()
+{
+    // Only writers advance the epoch, and they hold `mWriteLock`.
+    uint64_t epoch = mEpoch.load(std::memory_order_relaxed);
+    // Moving to `epoch + 1` reuses the slot of `epoch - 1`; wait until
+    // every reader registered there has left.
+    if (mActiveReaders[(epoch + 1) & 1U].load() == 0)
+    {
+        ++epoch;
+        mEpoch.store(epoch);
+    }
+    // Memory retired at epoch `e` was unlinked before any reader of
+    // `e + 1` registered; once the epoch reaches `e + 2`, the readers
+    // of `e` have drained too.
+    std::erase_if(mRetired, [&](const Retired &retired) {
+        if (retired.epoch + 2 > epoch)
+        {
+            return false;
+        }
+        mRetiredBytes -= retired.bytes;
+        return true;
+    });
 }
 
 } // namespace loglib
@@ -1,6 +1,7 @@
 #include "loglib/tcp_server_producer.hpp"
 
 #include "loglib/internal/line_bytes_queue.hpp"
+#include "loglib/internal/line_framer.hpp"
 
 #include <asio.hpp>
 #ifdef LOGLIB_HAS_TLS
@@ -10,7 +11,6 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
-#include <condition_variable>
 #include <cstring>
 #include <functional>
 #include <memory>
@@ -106,6 +106,8 @@ public:
     TcpServerProducerImpl &operator=(TcpServerProducerImpl &&) = delete;
 
     size_t Read(std::span<char> buffer);
+    [[nodiscard]] std::span<const char> BorrowBytes(size_t maxBytes);
+    void ReleaseBorrowedBytes() noexcept;
     void WaitForBytes(std::chrono::milliseconds timeout);
     void Stop() noexcept;
     [[nodiscard]] bool IsClosed() const noexcept;
@@ -119,7 +121,7 @@ public:
 
     /// Called from a session's read handler. Pushes the bytes in
     /// @p completeLines (always ending on a `\n` boundary) into the
-    /// shared queue under the mutex, applying back-pressure.
+    /// shared queue, applying back-pressure.
     void OnSessionLines(std::string_view completeLines);
 
     /// Called from a session's `Finalize`. Drops the session from
@@ -161,14 +163,13 @@ private:
     std::optional<asio::ssl::context> mSslContext;
 #endif
 
+    /// Guards the session table. The byte path does not take it.
     mutable std::mutex mMutex;
-    std::condition_variable mCv;
 
-    /// Byte queue. Backed by `LineBytesQueue` (deque<char> with
-    /// line-aware back-pressure) so the per-batch front drop is
-    /// O(K-bytes-dropped) instead of O(remaining buffer). The parse
-    /// loop's `Read` / `WaitForBytes` pattern stays uniform across
-    /// all producers.
+    /// Byte queue: lock-free SPSC ring with line-aware back-pressure.
+    /// Every session runs on the single I/O worker, so the worker is
+    /// the only producer and the parser thread the only consumer. The
+    /// queue also parks the parser in `WaitForBytes`.
     LineBytesQueue mReadyBuffer;
 
     /// Active sessions, keyed by id. Lives on the mutex so `Stop` can
@@ -252,14 +253,19 @@ template <class Stream> void Session<Stream>::OnRead(const asio::error_code &ec,
     // lines (terminated by '\n') and forward those to the shared
     // queue. The trailing partial stays in the carry until the next
     // chunk -- this is what guarantees that lines from concurrent
-    // peers don't tear in the shared queue.
+    // peers don't tear in the shared queue. The carry never holds a
+    // '\n' between chunks, so only the appended bytes need a scan and
+    // a long partial line is not rescanned on every read.
+    const std::size_t scannedBytes = mCarry.size();
     mCarry.append(mReadBuffer.data(), bytes);
 
-    if (const auto lastNewline = mCarry.rfind('\n'); lastNewline != std::string::npos)
+    if (const auto lastNewline = FindLastNewline(std::string_view(mCarry).substr(scannedBytes));
+        lastNewline != std::string_view::npos)
     {
-        const std::string_view completeLines(mCarry.data(), lastNewline + 1);
+        const std::size_t completeBytes = scannedBytes + lastNewline + 1;
+        const std::string_view completeLines(mCarry.data(), completeBytes);
         mImpl->OnSessionLines(completeLines);
-        mCarry.erase(0, lastNewline + 1);
+        mCarry.erase(0, completeBytes);
     }
 
     // NOLINTNEXTLINE(misc-no-recursion): async re-arm; not synchronous stack recursion.
@@ -366,7 +372,7 @@ asio::ssl::context BuildSslContext(const TcpServerProducer::TlsOptions &tls)
 #endif // LOGLIB_HAS_TLS
 
 TcpServerProducerImpl::TcpServerProducerImpl(TcpServerProducer::Options options)
-    : mOptions(std::move(options)), mAcceptor(mIoContext)
+    : mOptions(std::move(options)), mAcceptor(mIoContext), mReadyBuffer(mOptions.maxQueueBytes)
 {
     if (mOptions.tls.has_value())
     {
@@ -420,7 +426,7 @@ TcpServerProducerImpl::TcpServerProducerImpl(TcpServerProducer::Options options)
             static_cast<void>(0);
         }
         mWorkerExited.store(true, std::memory_order_release);
-        mCv.notify_all();
+        mReadyBuffer.WakeConsumer();
     });
 }
 
@@ -435,24 +441,27 @@ TcpServerProducerImpl::~TcpServerProducerImpl()
 
 size_t TcpServerProducerImpl::Read(std::span<char> buffer)
 {
-    if (buffer.empty())
-    {
-        return 0;
-    }
-    const std::scoped_lock lock(mMutex);
     return mReadyBuffer.Read(buffer);
 }
 
+std::span<const char> TcpServerProducerImpl::BorrowBytes(size_t maxBytes)
+{
+    return mReadyBuffer.Borrow(maxBytes);
+}
+
+void TcpServerProducerImpl::ReleaseBorrowedBytes() noexcept
+{
+    mReadyBuffer.ReleaseBorrowed();
+}
+
 void TcpServerProducerImpl::WaitForBytes(std::chrono::milliseconds timeout)
 {
     if (timeout.count() <= 0)
     {
         return;
     }
-    std::unique_lock<std::mutex> lock(mMutex);
-    mCv.wait_for(lock, timeout, [&] {
-        return !mReadyBuffer.Empty() || mStopRequested.load(std::memory_order_acquire) ||
-               mWorkerExited.load(std::memory_order_acquire);
+    mReadyBuffer.WaitForBytes(timeout, [&] {
+        return mStopRequested.load(std::memory_order_acquire) || mWorkerExited.load(std::memory_order_acquire);
     });
 }
 
@@ -506,7 +515,7 @@ void TcpServerProducerImpl::Stop() noexcept
         // terminates rather than wedging the worker thread.
         mIoContext.stop();
     }
-    mCv.notify_all();
+    mReadyBuffer.WakeConsumer();
 }
 
 bool TcpServerProducerImpl::IsClosed() const noexcept
@@ -515,7 +524,6 @@ bool TcpServerProducerImpl::IsClosed() const noexcept
     {
         return false;
     }
-    const std::scoped_lock lock(mMutex);
     return mReadyBuffer.Empty();
 }
 
@@ -572,12 +580,9 @@ void TcpServerProducerImpl::OnSessionLines(std::string_view completeLines)
     {
         return;
     }
-    {
-        const std::scoped_lock lock(mMutex);
-        mReadyBuffer.Append(completeLines, mOptions.maxQueueBytes, mDroppedByteCount);
-    }
+    // Lock-free; wakes a parked parser itself.
+    mReadyBuffer.Append(completeLines, mDroppedByteCount);
     MarkRunning();
-    mCv.notify_all();
 }
 
 void TcpServerProducerImpl::OnSessionEnded(size_t sessionId)
@@ -586,7 +591,7 @@ void TcpServerProducerImpl::OnSessionEnded(size_t sessionId)
         const std::scoped_lock lock(mMutex);
         mActiveSessions.erase(sessionId);
     }
-    mCv.notify_all();
+    mReadyBuffer.WakeConsumer();
 }
 
 void TcpServerProducerImpl::MarkRunning()
@@ -726,6 +731,21 @@ size_t TcpServerProducer::Read(std::span<char> buffer)
     return mImpl->Read(buffer);
 }
 
+bool TcpServerProducer::SupportsBorrowedBytes() const noexcept
+{
+    return true;
+}
+
+std::span<const char> TcpServerProducer::BorrowBytes(size_t maxBytes)
+{
+    return mImpl->BorrowBytes(maxBytes);
+}
+
+void TcpServerProducer::ReleaseBorrowedBytes() noexcept
+{
+    mImpl->ReleaseBorrowedBytes();
+}
+
 void TcpServerProducer::WaitForBytes(std::chrono::milliseconds timeout)
 {
     mImpl->WaitForBytes(timeout);
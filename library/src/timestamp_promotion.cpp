@@ -4,7 +4,6 @@
 #include "loglib/line_source.hpp"
 #include "loglib/log_line.hpp"
 
-#include <algorithm>
 #include <cstring>
 #include <optional>
 #include <string_view>
@@ -39,16 +38,12 @@ std::optional<std::string_view> ExtractStringBytes(
     {
         return std::nullopt;
     }
-    const auto compact = line.CompactValues();
-    // Asymmetric comparator: std::ranges::lower_bound rejects it.
-    auto it = std::lower_bound(compact.begin(), compact.end(), keyId, [](const auto &entry, KeyId target) {
-        return entry.first < target;
-    });
-    if (it == compact.end() || it->first != keyId)
+    const CompactLogValue *slot = line.FindCompact(keyId);
+    if (slot == nullptr)
     {
         return std::nullopt;
     }
-    const CompactLogValue &value = it->second;
+    const CompactLogValue &value = *slot;
     const LineSource *source = line.Source();
     if (value.tag == CompactTag::MmapSlice)
     {
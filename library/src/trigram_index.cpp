@@ -0,0 +1,586 @@
+#include "loglib/internal/trigram_index.hpp"
+
+#include "loglib/internal/sidecar_io.hpp"
+
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
+
+#include <algorithm>
+#include <bit>
+#include <exception>
+#include <fstream>
+#include <ios>
+#include <utility>
+
+namespace loglib::internal
+{
+
+namespace
+{
+
+/// Sidecar layout, little-endian:
+///   magic, fileSize u64, modifiedTime i64, rows u64, stringCells u64,
+///   stringBytes u64, then `TrigramIndex::Write`.
+constexpr std::string_view SIDECAR_MAGIC = "SLVTRGX1";
+constexpr std::string_view SIDECAR_EXTENSION = ".trgidx";
+
+constexpr char32_t ASCII_END = 0x80;
+constexpr char32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+/// Dense 0..69 code of a folded symbol; `'A'`..`'Z'` never occur.
+uint32_t SymbolCode(char symbol) noexcept
+{
+    const auto byte = static_cast<uint32_t>(static_cast<unsigned char>(symbol));
+    return byte <= '@' ? byte - ' ' : byte - '[' + ('@' - ' ' + 1);
+}
+
+/// Decode the code point starting at @p bytes[@p pos] and advance past
+/// it; a malformed sequence decodes to U+FFFD and skips one byte.
+char32_t DecodeUtf8(std::string_view bytes, size_t &pos) noexcept
+{
+    const auto lead = static_cast<unsigned char>(bytes[pos]);
+    if (lead < ASCII_END)
+    {
+        ++pos;
+        return lead;
+    }
+    size_t length = 0;
+    char32_t codePoint = 0;
+    char32_t minimum = 0;
+    if ((lead & 0xE0U) == 0xC0U)
+    {
+        length = 2;
+        codePoint = lead & 0x1FU;
+        minimum = 0x80;
+    }
+    else if ((lead & 0xF0U) == 0xE0U)
+    {
+        length = 3;
+        codePoint = lead & 0x0FU;
+        minimum = 0x800;
+    }
+    else if ((lead & 0xF8U) == 0xF0U)
+    {
+        length = 4;
+        codePoint = lead & 0x07U;
+        minimum = 0x10000;
+    }
+    if (length == 0 || pos + length > bytes.size())
+    {
+        ++pos;
+        return REPLACEMENT_CHARACTER;
+    }
+    for (size_t i = 1; i < length; ++i)
+    {
+        const auto next = static_cast<unsigned char>(bytes[pos + i]);
+        if ((next & 0xC0U) != 0x80U)
+        {
+            ++pos;
+            return REPLACEMENT_CHARACTER;
+        }
+        codePoint = (codePoint << 6U) | (next & 0x3FU);
+    }
+    if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+    {
+        ++pos;
+        return REPLACEMENT_CHARACTER;
+    }
+    pos += length;
+    return codePoint;
+}
+
+} // namespace
+
+char FoldTrigramCodePoint(char32_t codePoint) noexcept
+{
+    if (codePoint < ASCII_END)
+    {
+        if (codePoint == ' ' || (codePoint >= '\t' && codePoint <= '\r'))
+        {
+            return ' ';
+        }
+        if (codePoint < ' ' || codePoint == 0x7F)
+        {
+            return TRIGRAM_OTHER_SYMBOL;
+        }
+        if (codePoint >= 'A' && codePoint <= 'Z')
+        {
+            return static_cast<char>(codePoint - 'A' + 'a');
+        }
+        return static_cast<char>(codePoint);
+    }
+    switch (codePoint)
+    {
+    // `QChar::isSpace` beyond ASCII: NEL, NBSP and the Unicode
+    // separators.
+    case 0x0085:
+    case 0x00A0:
+    case 0x1680:
+    case 0x2028:
+    case 0x2029:
+    case 0x202F:
+    case 0x205F:
+    case 0x3000:
+        return ' ';
+    case 0x212A: // KELVIN SIGN ~ k
+        return 'k';
+    case 0x017F: // LATIN SMALL LETTER LONG S ~ s
+        return 's';
+    case 0x0130: // dotted capital I
+    case 0x0131: // dotless small i
+        return 'i';
+    default:
+        break;
+    }
+    if (codePoint >= 0x2000 && codePoint <= 0x200A)
+    {
+        return ' ';
+    }
+    return TRIGRAM_OTHER_SYMBOL;
+}
+
+void FoldTrigramText(std::string_view bytes, bool compact, std::string &out)
+{
+    const size_t start = out.size();
+    bool pendingSpace = false;
+    size_t pos = 0;
+    while (pos < bytes.size())
+    {
+        const char symbol = FoldTrigramCodePoint(DecodeUtf8(bytes, pos));
+        if (compact && symbol == ' ')
+        {
+            pendingSpace = out.size() > start;
+            continue;
+        }
+        if (pendingSpace)
+        {
+            out.push_back(' ');
+            pendingSpace = false;
+        }
+        out.push_back(symbol);
+    }
+}
+
+uint32_t TrigramKey(char first, char second, char third) noexcept
+{
+    return (((SymbolCode(first) * TRIGRAM_SYMBOL_COUNT) + SymbolCode(second)) * TRIGRAM_SYMBOL_COUNT) +
+           SymbolCode(third);
+}
+
+TrigramKeySet::TrigramKeySet()
+    : mSeen((TRIGRAM_KEY_COUNT + 63) / 64, 0U)
+{
+}
+
+void TrigramKeySet::AddCell(std::string_view bytes)
+{
+    mFolded.clear();
+    FoldTrigramText(bytes, /*compact=*/true, mFolded);
+    for (size_t i = 0; i + 2 < mFolded.size(); ++i)
+    {
+        const char a = mFolded[i];
+        const char b = mFolded[i + 1];
+        const char c = mFolded[i + 2];
+        // `TRIGRAM_OTHER_SYMBOL` breaks trigrams: how many symbols a
+        // run of non-ASCII or malformed bytes decodes to is not stable
+        // across decoders, so such windows are never indexed or queried.
+        if (a == TRIGRAM_OTHER_SYMBOL || b == TRIGRAM_OTHER_SYMBOL || c == TRIGRAM_OTHER_SYMBOL)
+        {
+            continue;
+        }
+        const uint32_t key = TrigramKey(a, b, c);
+        uint64_t &word = mSeen[key / 64U];
+        const uint64_t bit = uint64_t{1} << (key % 64U);
+        if ((word & bit) == 0U)
+        {
+            word |= bit;
+            mKeys.push_back(key);
+        }
+    }
+}
+
+std::vector<uint32_t> TrigramKeySet::TakeKeys()
+{
+    for (const uint32_t key : mKeys)
+    {
+        mSeen[key / 64U] &= ~(uint64_t{1} << (key % 64U));
+    }
+    std::ranges::sort(mKeys, [](uint32_t lhs, uint32_t rhs) {
+        const size_t lhsShard = TrigramIndex::ShardOf(lhs);
+        const size_t rhsShard = TrigramIndex::ShardOf(rhs);
+        return lhsShard != rhsShard ? lhsShard < rhsShard : lhs < rhs;
+    });
+    return std::exchange(mKeys, {});
+}
+
+bool TrigramCandidates::Contains(size_t row) const noexcept
+{
+    if (row >= mRows)
+    {
+        return true;
+    }
+    const auto granule = static_cast<size_t>(((mFirstId + row) / TrigramIndex::GRANULE_ROWS) - mFirstGranule);
+    return ((mBits[granule / 64U] >> (granule % 64U)) & 1U) != 0U;
+}
+
+size_t TrigramCandidates::GranuleEndRow(size_t row) const noexcept
+{
+    constexpr uint64_t GRANULE_ROWS = TrigramIndex::GRANULE_ROWS;
+    return static_cast<size_t>((((mFirstId + row) / GRANULE_ROWS) + 1) * GRANULE_ROWS - mFirstId);
+}
+
+size_t TrigramCandidates::CandidateGranuleCount() const noexcept
+{
+    size_t count = 0;
+    for (const uint64_t word : mBits)
+    {
+        count += static_cast<size_t>(std::popcount(word));
+    }
+    return count;
+}
+
+void TrigramIndex::AppendGranules(std::span<const std::vector<uint32_t>> granules, size_t rows)
+{
+    if (rows == 0)
+    {
+        return;
+    }
+    if (mSlots.empty())
+    {
+        mSlots.assign(TRIGRAM_KEY_COUNT, 0U);
+    }
+    const uint64_t firstGranule = (mFirstId + mSize) / GRANULE_ROWS;
+    // Each task owns one shard's postings and the `mSlots` entries of
+    // its keys, so shards never touch shared state.
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, SHARD_COUNT, 1),
+        [this, granules, firstGranule](const tbb::blocked_range<size_t> &range) {
+            for (size_t shard = range.begin(); shard != range.end(); ++shard)
+            {
+                std::vector<Posting> &postings = mShards[shard];
+                for (size_t offset = 0; offset < granules.size(); ++offset)
+                {
+                    const uint64_t granule = firstGranule + offset;
+                    const auto keys = std::ranges::equal_range(granules[offset], shard, {}, [](uint32_t key) {
+                        return ShardOf(key);
+                    });
+                    for (const uint32_t key : keys)
+                    {
+                        uint32_t &slot = mSlots[key];
+                        if (slot == 0U)
+                        {
+                            postings.emplace_back().key = key;
+                            slot = static_cast<uint32_t>(postings.size());
+                        }
+                        Posting &posting = postings[slot - 1U];
+                        if (posting.lastGranule != granule)
+                        {
+                            posting.granules.Append(granule);
+                            posting.lastGranule = granule;
+                        }
+                    }
+                }
+            }
+        }
+    );
+    mSize += rows;
+}
+
+void TrigramIndex::EraseFront(size_t count)
+{
+    if (count >= mSize)
+    {
+        Clear();
+        return;
+    }
+    mFirstId += count;
+    mSize -= count;
+    const uint64_t firstGranule = mFirstId / GRANULE_ROWS;
+    for (std::vector<Posting> &postings : mShards)
+    {
+        for (Posting &posting : postings)
+        {
+            posting.granules.EraseBelow(firstGranule);
+        }
+    }
+}
+
+void TrigramIndex::Clear() noexcept
+{
+    mSlots.clear();
+    for (std::vector<Posting> &postings : mShards)
+    {
+        postings.clear();
+    }
+    mFirstId = 0;
+    mSize = 0;
+}
+
+const TrigramIndex::Posting *TrigramIndex::Find(uint32_t key) const noexcept
+{
+    if (key >= mSlots.size() || mSlots[key] == 0U)
+    {
+        return nullptr;
+    }
+    return &mShards[ShardOf(key)][mSlots[key] - 1U];
+}
+
+std::optional<TrigramCandidates> TrigramIndex::Candidates(const TrigramQuery &query) const
+{
+    if (query.IsAll())
+    {
+        return std::nullopt;
+    }
+    TrigramCandidates candidates;
+    candidates.mFirstId = mFirstId;
+    candidates.mFirstGranule = mFirstId / GRANULE_ROWS;
+    candidates.mRows = mSize;
+    if (mSize != 0)
+    {
+        candidates.mGranules =
+            static_cast<size_t>(((mFirstId + mSize - 1) / GRANULE_ROWS) + 1 - candidates.mFirstGranule);
+    }
+    candidates.mBits.assign((candidates.mGranules + 63) / 64, 0U);
+    Evaluate(query, candidates);
+    return candidates;
+}
+
+void TrigramIndex::OrPostings(uint32_t key, TrigramCandidates &out) const
+{
+    const Posting *posting = Find(key);
+    if (posting == nullptr)
+    {
+        return;
+    }
+    const uint64_t first = out.mFirstGranule;
+    posting->granules.ForEachInRange(first, first + out.mGranules, [&out, first](uint64_t granule) {
+        const auto bit = static_cast<size_t>(granule - first);
+        out.mBits[bit / 64U] |= uint64_t{1} << (bit % 64U);
+    });
+}
+
+void TrigramIndex::Evaluate(const TrigramQuery &query, TrigramCandidates &out) const
+{
+    using Op = TrigramQuery::Op;
+    std::ranges::fill(out.mBits, 0U);
+    switch (query.op)
+    {
+    case Op::None:
+        return;
+    case Op::All:
+        std::ranges::fill(out.mBits, ~uint64_t{0});
+        if (const size_t tail = out.mGranules % 64U; tail != 0 && !out.mBits.empty())
+        {
+            out.mBits.back() = (uint64_t{1} << tail) - 1U;
+        }
+        return;
+    case Op::Or:
+    {
+        for (const uint32_t key : query.trigrams)
+        {
+            OrPostings(key, out);
+        }
+        TrigramCandidates scratch = out;
+        for (const TrigramQuery &sub : query.subs)
+        {
+            Evaluate(sub, scratch);
+            for (size_t i = 0; i < out.mBits.size(); ++i)
+            {
+                out.mBits[i] |= scratch.mBits[i];
+            }
+        }
+        return;
+    }
+    case Op::And:
+    {
+        TrigramCandidates scratch = out;
+        bool first = true;
+        const auto intersect = [&out, &scratch, &first]() {
+            if (first)
+            {
+                out.mBits = scratch.mBits;
+                first = false;
+                return;
+            }
+            for (size_t i = 0; i < out.mBits.size(); ++i)
+            {
+                out.mBits[i] &= scratch.mBits[i];
+            }
+        };
+        for (const uint32_t key : query.trigrams)
+        {
+            std::ranges::fill(scratch.mBits, 0U);
+            OrPostings(key, scratch);
+            intersect();
+        }
+        for (const TrigramQuery &sub : query.subs)
+        {
+            Evaluate(sub, scratch);
+            intersect();
+        }
+        if (first)
+        {
+            // An empty conjunction holds everywhere.
+            TrigramQuery all;
+            Evaluate(all, out);
+        }
+        return;
+    }
+    }
+}
+
+size_t TrigramIndex::TrigramCount() const noexcept
+{
+    size_t count = 0;
+    for (const std::vector<Posting> &postings : mShards)
+    {
+        count += postings.size();
+    }
+    return count;
+}
+
+size_t TrigramIndex::MemoryBytes() const noexcept
+{
+    size_t bytes = mSlots.capacity() * sizeof(uint32_t);
+    for (const std::vector<Posting> &postings : mShards)
+    {
+        bytes += postings.capacity() * sizeof(Posting);
+        for (const Posting &posting : postings)
+        {
+            bytes += posting.granules.MemoryBytes();
+        }
+    }
+    return bytes;
+}
+
+void TrigramIndex::Write(SidecarWriter &writer) const
+{
+    writer.Put(mFirstId);
+    writer.Put(static_cast<uint64_t>(mSize));
+    writer.Put(static_cast<uint32_t>(TrigramCount()));
+    for (const std::vector<Posting> &postings : mShards)
+    {
+        for (const Posting &posting : postings)
+        {
+            writer.Put(posting.key);
+            writer.Put(posting.lastGranule);
+            posting.granules.Write(writer);
+        }
+    }
+}
+
+bool TrigramIndex::Read(SidecarReader &reader)
+{
+    Clear();
+    uint64_t firstId = 0;
+    uint64_t size = 0;
+    uint32_t postingCount = 0;
+    if (!reader.Get(firstId) || !reader.Get(size) || !reader.Get(postingCount) || postingCount > TRIGRAM_KEY_COUNT)
+    {
+        return false;
+    }
+    mSlots.assign(TRIGRAM_KEY_COUNT, 0U);
+    for (uint32_t i = 0; i < postingCount; ++i)
+    {
+        Posting posting;
+        if (!reader.Get(posting.key) || !reader.Get(posting.lastGranule) || posting.key >= TRIGRAM_KEY_COUNT ||
+            mSlots[posting.key] != 0U || !posting.granules.Read(reader))
+        {
+            Clear();
+            return false;
+        }
+        std::vector<Posting> &postings = mShards[ShardOf(posting.key)];
+        postings.push_back(std::move(posting));
+        mSlots[postings.back().key] = static_cast<uint32_t>(postings.size());
+    }
+    mFirstId = firstId;
+    mSize = static_cast<size_t>(size);
+    return true;
+}
+
+std::optional<TrigramIndex> LoadTrigramIndex(
+    const std::filesystem::path &indexDir, const std::filesystem::path &source, const TrigramIndexSignature &signature
+) noexcept
+{
+    try
+    {
+        const std::filesystem::path sidecar = SidecarPath(indexDir, source, SIDECAR_EXTENSION);
+        const std::optional<std::int64_t> modified = ModifiedTime(source);
+        if (sidecar.empty() || !modified.has_value())
+        {
+            return std::nullopt;
+        }
+        std::ifstream in(sidecar, std::ios::binary);
+        if (!in.is_open())
+        {
+            return std::nullopt;
+        }
+        SidecarReader reader(in);
+
+        std::array<char, SIDECAR_MAGIC.size()> magic{};
+        uint64_t fileSize = 0;
+        int64_t modifiedTime = 0;
+        TrigramIndexSignature stored;
+        if (!reader.GetBytes(magic.data(), magic.size()) ||
+            std::string_view(magic.data(), magic.size()) != SIDECAR_MAGIC || !reader.Get(fileSize) ||
+            !reader.Get(modifiedTime) || !reader.Get(stored.rows) || !reader.Get(stored.stringCells) ||
+            !reader.Get(stored.stringBytes))
+        {
+            return std::nullopt;
+        }
+        if (fileSize != std::filesystem::file_size(source) || modifiedTime != *modified || stored != signature)
+        {
+            return std::nullopt;
+        }
+        TrigramIndex index;
+        if (!index.Read(reader) || index.Size() != signature.rows)
+        {
+            return std::nullopt;
+        }
+        return index;
+    }
+    catch (const std::exception &)
+    {
+        return std::nullopt;
+    }
+}
+
+bool SaveTrigramIndex(
+    const std::filesystem::path &indexDir,
+    const std::filesystem::path &source,
+    const TrigramIndexSignature &signature,
+    const TrigramIndex &index
+) noexcept
+{
+    try
+    {
+        const std::filesystem::path sidecar = SidecarPath(indexDir, source, SIDECAR_EXTENSION);
+        const std::optional<std::int64_t> modified = ModifiedTime(source);
+        if (sidecar.empty() || !modified.has_value())
+        {
+            return false;
+        }
+        const uint64_t fileSize = std::filesystem::file_size(source);
+        const bool written = WriteSidecarAtomically(sidecar, [&](SidecarWriter &writer) {
+            writer.PutBytes(SIDECAR_MAGIC.data(), SIDECAR_MAGIC.size());
+            writer.Put(fileSize);
+            writer.Put(*modified);
+            writer.Put(signature.rows);
+            writer.Put(signature.stringCells);
+            writer.Put(signature.stringBytes);
+            index.Write(writer);
+            return true;
+        });
+        if (written)
+        {
+            PruneSidecars(indexDir, SIDECAR_EXTENSION, MAX_TRIGRAM_INDEX_FILES);
+        }
+        return written;
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+}
+
+} // namespace loglib::internal
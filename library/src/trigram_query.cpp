@@ -0,0 +1,1308 @@
+#include "loglib/trigram_query.hpp"
+
+#include "loglib/internal/trigram_index.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace loglib
+{
+
+namespace
+{
+
+using internal::FoldTrigramCodePoint;
+using internal::TRIGRAM_OTHER_SYMBOL;
+
+/// Folded strings, sorted and distinct.
+using StringSet = std::vector<std::string>;
+
+/// Largest exact set kept before it is folded into prefix / suffix
+/// sets (Code Search's `maxExact`).
+constexpr size_t MAX_EXACT = 7;
+/// Largest prefix / suffix set kept before its strings are shortened.
+constexpr size_t MAX_SET = 20;
+/// Character classes wider than this many symbols act as "any char".
+constexpr size_t MAX_CLASS_SYMBOLS = 16;
+/// Copies of `x` a bounded repeat `x{n,...}` is expanded to.
+constexpr size_t MAX_SPELLED_REPEATS = 4;
+/// Terms an `Or` may hold before it is given up as `All`.
+constexpr size_t MAX_OR_TERMS = 64;
+/// Group nesting the parser follows before giving up.
+constexpr int MAX_DEPTH = 64;
+
+constexpr char32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+/// `And` of every trigram in @p symbols; `All` when it has none.
+TrigramQuery TrigramsOf(const std::string &symbols)
+{
+    TrigramQuery query;
+    for (size_t i = 0; i + 2 < symbols.size(); ++i)
+    {
+        const char a = symbols[i];
+        const char b = symbols[i + 1];
+        const char c = symbols[i + 2];
+        if (a != TRIGRAM_OTHER_SYMBOL && b != TRIGRAM_OTHER_SYMBOL && c != TRIGRAM_OTHER_SYMBOL)
+        {
+            query.trigrams.push_back(internal::TrigramKey(a, b, c));
+        }
+    }
+    if (query.trigrams.empty())
+    {
+        return query;
+    }
+    std::ranges::sort(query.trigrams);
+    const auto [first, last] = std::ranges::unique(query.trigrams);
+    query.trigrams.erase(first, last);
+    query.op = TrigramQuery::Op::And;
+    return query;
+}
+
+/// `Or` over @p set of each string's trigrams.
+TrigramQuery TrigramsOf(const StringSet &set)
+{
+    TrigramQuery query;
+    query.op = TrigramQuery::Op::None;
+    for (const std::string &symbols : set)
+    {
+        query = TrigramQuery::Or(std::move(query), TrigramsOf(symbols));
+    }
+    return query;
+}
+
+/// Sort, dedupe and drop strings another member makes redundant: for
+/// prefixes one that extends another (the shorter one is implied), for
+/// suffixes one that ends with another.
+void Clean(StringSet &set, bool isSuffix)
+{
+    std::ranges::sort(set);
+    const auto [first, last] = std::ranges::unique(set);
+    set.erase(first, last);
+    StringSet kept;
+    kept.reserve(set.size());
+    for (const std::string &candidate : set)
+    {
+        const bool redundant = std::ranges::any_of(set, [&candidate, isSuffix](const std::string &other) {
+            return other.size() < candidate.size() &&
+                   (isSuffix ? candidate.ends_with(other) : candidate.starts_with(other));
+        });
+        if (!redundant)
+        {
+            kept.push_back(candidate);
+        }
+    }
+    set = std::move(kept);
+}
+
+StringSet Cross(const StringSet &lhs, const StringSet &rhs)
+{
+    StringSet out;
+    out.reserve(lhs.size() * rhs.size());
+    for (const std::string &left : lhs)
+    {
+        for (const std::string &right : rhs)
+        {
+            out.push_back(left + right);
+        }
+    }
+    std::ranges::sort(out);
+    const auto [first, last] = std::ranges::unique(out);
+    out.erase(first, last);
+    return out;
+}
+
+StringSet Union(StringSet lhs, const StringSet &rhs)
+{
+    lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+    std::ranges::sort(lhs);
+    const auto [first, last] = std::ranges::unique(lhs);
+    lhs.erase(first, last);
+    return lhs;
+}
+
+size_t MinLength(const StringSet &set)
+{
+    size_t shortest = std::string::npos;
+    for (const std::string &symbols : set)
+    {
+        shortest = std::min(shortest, symbols.size());
+    }
+    return set.empty() ? 0 : shortest;
+}
+
+/// What a sub-expression tells about the strings it matches, after
+/// Russ Cox's Code Search `regexpInfo`: either the exact set of them,
+/// or sets of their possible prefixes and suffixes, plus a trigram
+/// query every match satisfies.
+struct Info
+{
+    bool canEmpty = false;
+    std::optional<StringSet> exact;
+    StringSet prefix;
+    StringSet suffix;
+    TrigramQuery match;
+
+    /// And the exact strings' trigrams into `match`.
+    void AddExact()
+    {
+        if (exact.has_value())
+        {
+            match = TrigramQuery::And(std::move(match), TrigramsOf(*exact));
+        }
+    }
+
+    /// And the set's trigrams into `match`, then shorten its strings to
+    /// two symbols (longer ones are covered by `match` now), and further
+    /// while the set is too large.
+    void SimplifySet(StringSet &set, bool isSuffix)
+    {
+        Clean(set, isSuffix);
+        match = TrigramQuery::And(std::move(match), TrigramsOf(set));
+        for (size_t length = 2; length == 2 || set.size() > MAX_SET; --length)
+        {
+            for (std::string &symbols : set)
+            {
+                if (symbols.size() > length)
+                {
+                    symbols = isSuffix ? symbols.substr(symbols.size() - length) : symbols.substr(0, length);
+                }
+            }
+            Clean(set, isSuffix);
+            if (length == 0)
+            {
+                break;
+            }
+        }
+    }
+
+    /// Fold a large (or, with @p force, any long enough) exact set into
+    /// prefix / suffix form, and keep those sets small.
+    void Simplify(bool force)
+    {
+        if (exact.has_value())
+        {
+            std::ranges::sort(*exact);
+            const auto [first, last] = std::ranges::unique(*exact);
+            exact->erase(first, last);
+            const size_t shortest = MinLength(*exact);
+            if (exact->size() > MAX_EXACT || (force && shortest >= 3))
+            {
+                AddExact();
+                for (const std::string &symbols : *exact)
+                {
+                    if (symbols.size() < 3)
+                    {
+                        prefix.push_back(symbols);
+                        suffix.push_back(symbols);
+                    }
+                    else
+                    {
+                        prefix.push_back(symbols.substr(0, 2));
+                        suffix.push_back(symbols.substr(symbols.size() - 2));
+                    }
+                }
+                exact.reset();
+            }
+        }
+        if (!exact.has_value())
+        {
+            SimplifySet(prefix, false);
+            SimplifySet(suffix, true);
+        }
+    }
+};
+
+Info EmptyString()
+{
+    Info info;
+    info.canEmpty = true;
+    info.exact = StringSet{std::string{}};
+    return info;
+}
+
+/// Any single character, whatever it folds to.
+Info AnyChar()
+{
+    Info info;
+    info.prefix = {std::string{}};
+    info.suffix = {std::string{}};
+    return info;
+}
+
+/// Any string, empty included.
+Info AnyMatch()
+{
+    Info info = AnyChar();
+    info.canEmpty = true;
+    return info;
+}
+
+Info Symbols(const std::vector<char> &symbols)
+{
+    Info info;
+    info.exact.emplace();
+    for (const char symbol : symbols)
+    {
+        info.exact->emplace_back(1, symbol);
+    }
+    return info;
+}
+
+Info Concat(Info lhs, Info rhs)
+{
+    // Keep cross products bounded: an exact side that would blow up
+    // switches to prefix / suffix form first.
+    if (lhs.exact.has_value() && rhs.exact.has_value() && lhs.exact->size() * rhs.exact->size() > MAX_SET * MAX_SET)
+    {
+        lhs.Simplify(true);
+        if (lhs.exact.has_value())
+        {
+            lhs.AddExact();
+            lhs.prefix = *lhs.exact;
+            lhs.suffix = *lhs.exact;
+            lhs.exact.reset();
+            lhs.Simplify(false);
+        }
+    }
+    Info out;
+    out.canEmpty = lhs.canEmpty && rhs.canEmpty;
+    out.match = TrigramQuery::And(lhs.match, rhs.match);
+    if (lhs.exact.has_value() && rhs.exact.has_value())
+    {
+        out.exact = Cross(*lhs.exact, *rhs.exact);
+    }
+    else
+    {
+        if (lhs.exact.has_value())
+        {
+            out.prefix = Cross(*lhs.exact, rhs.prefix);
+        }
+        else
+        {
+            out.prefix = lhs.prefix;
+            if (lhs.canEmpty)
+            {
+                out.prefix = Union(out.prefix, rhs.prefix);
+            }
+        }
+        if (rhs.exact.has_value())
+        {
+            out.suffix = Cross(lhs.suffix, *rhs.exact);
+        }
+        else
+        {
+            out.suffix = rhs.suffix;
+            if (rhs.canEmpty)
+            {
+                out.suffix = Union(out.suffix, lhs.suffix);
+            }
+        }
+    }
+    // A trigram straddling the boundary is in neither side's query yet.
+    if (!lhs.exact.has_value() && !rhs.exact.has_value() && lhs.suffix.size() <= MAX_SET &&
+        rhs.prefix.size() <= MAX_SET && MinLength(lhs.suffix) + MinLength(rhs.prefix) >= 3)
+    {
+        out.match = TrigramQuery::And(std::move(out.match), TrigramsOf(Cross(lhs.suffix, rhs.prefix)));
+    }
+    out.Simplify(false);
+    return out;
+}
+
+Info Alternate(Info lhs, Info rhs)
+{
+    Info out;
+    if (lhs.exact.has_value() && rhs.exact.has_value())
+    {
+        out.exact = Union(*lhs.exact, *rhs.exact);
+    }
+    else if (lhs.exact.has_value())
+    {
+        out.prefix = Union(*lhs.exact, rhs.prefix);
+        out.suffix = Union(*lhs.exact, rhs.suffix);
+        lhs.AddExact();
+    }
+    else if (rhs.exact.has_value())
+    {
+        out.prefix = Union(lhs.prefix, *rhs.exact);
+        out.suffix = Union(lhs.suffix, *rhs.exact);
+        rhs.AddExact();
+    }
+    else
+    {
+        out.prefix = Union(lhs.prefix, rhs.prefix);
+        out.suffix = Union(lhs.suffix, rhs.suffix);
+    }
+    out.canEmpty = lhs.canEmpty || rhs.canEmpty;
+    out.match = TrigramQuery::Or(std::move(lhs.match), std::move(rhs.match));
+    out.Simplify(false);
+    return out;
+}
+
+/// `x+`: prefixes and suffixes stay those of `x`, but it is no longer
+/// exact.
+Info Plus(Info info)
+{
+    if (info.exact.has_value())
+    {
+        info.prefix = *info.exact;
+        info.suffix = *info.exact;
+        info.exact.reset();
+    }
+    info.Simplify(false);
+    return info;
+}
+
+/// Recursive-descent walk over a PCRE2 pattern that builds `Info`
+/// directly. Returns nullopt for anything it does not understand, and
+/// the caller then gives up on the index for this pattern.
+class RegexAnalyzer
+{
+public:
+    explicit RegexAnalyzer(std::u32string pattern)
+        : mPattern(std::move(pattern))
+    {
+    }
+
+    std::optional<Info> Run()
+    {
+        auto info = ParseAlternation(0);
+        if (!info.has_value() || mPos != mPattern.size())
+        {
+            // A stray `)` or similar: not a pattern Qt would accept.
+            return std::nullopt;
+        }
+        return info;
+    }
+
+private:
+    [[nodiscard]] bool AtEnd() const noexcept
+    {
+        return mPos >= mPattern.size();
+    }
+
+    [[nodiscard]] char32_t Peek(size_t ahead = 0) const noexcept
+    {
+        return mPos + ahead < mPattern.size() ? mPattern[mPos + ahead] : U'\0';
+    }
+
+    bool Consume(char32_t expected) noexcept
+    {
+        if (!AtEnd() && mPattern[mPos] == expected)
+        {
+            ++mPos;
+            return true;
+        }
+        return false;
+    }
+
+    static bool IsAsciiAlnum(char32_t c) noexcept
+    {
+        return (c >= U'a' && c <= U'z') || (c >= U'A' && c <= U'Z') || (c >= U'0' && c <= U'9');
+    }
+
+    static Info Literal(char32_t codePoint)
+    {
+        return Symbols({FoldTrigramCodePoint(codePoint)});
+    }
+
+    std::optional<Info> ParseAlternation(int depth)
+    {
+        if (depth > MAX_DEPTH)
+        {
+            return std::nullopt;
+        }
+        auto info = ParseConcat(depth);
+        while (info.has_value() && Consume(U'|'))
+        {
+            auto next = ParseConcat(depth);
+            if (!next.has_value())
+            {
+                return std::nullopt;
+            }
+            info = Alternate(std::move(*info), std::move(*next));
+        }
+        return info;
+    }
+
+    std::optional<Info> ParseConcat(int depth)
+    {
+        Info info = EmptyString();
+        while (!AtEnd() && (mInQuote || (Peek() != U'|' && Peek() != U')')))
+        {
+            auto next = ParseRepeat(depth);
+            if (!next.has_value())
+            {
+                return std::nullopt;
+            }
+            info = Concat(std::move(info), std::move(*next));
+        }
+        return info;
+    }
+
+    /// `{n}`, `{n,}`, `{n,m}` or `{,m}` at the cursor; leaves the cursor
+    /// alone and returns nullopt when `{` starts a literal instead.
+    std::optional<std::pair<size_t, std::optional<size_t>>> ParseBraces()
+    {
+        size_t pos = mPos + 1;
+        const auto number = [this, &pos]() -> std::optional<size_t> {
+            size_t value = 0;
+            const size_t start = pos;
+            while (pos < mPattern.size() && mPattern[pos] >= U'0' && mPattern[pos] <= U'9')
+            {
+                value = std::min<size_t>((value * 10) + (mPattern[pos] - U'0'), 1U << 16U);
+                ++pos;
+            }
+            return pos > start ? std::optional<size_t>(value) : std::nullopt;
+        };
+        const auto low = number();
+        std::optional<size_t> high = low;
+        if (pos < mPattern.size() && mPattern[pos] == U',')
+        {
+            ++pos;
+            high = number();
+        }
+        else if (!low.has_value())
+        {
+            return std::nullopt;
+        }
+        if (pos >= mPattern.size() || mPattern[pos] != U'}' || (!low.has_value() && !high.has_value()))
+        {
+            return std::nullopt;
+        }
+        mPos = pos + 1;
+        return std::make_pair(low.value_or(0), high);
+    }
+
+    std::optional<Info> ParseRepeat(int depth)
+    {
+        auto info = ParseAtom(depth);
+        while (info.has_value() && !AtEnd())
+        {
+            // PCRE drops comments and quote delimiters before reading a
+            // quantifier, so in `a(?#note)+` and `\Qab\E+` the `+`
+            // applies to the `a` / `b` before them.
+            if (!SkipIgnorable())
+            {
+                return std::nullopt;
+            }
+            if (mInQuote)
+            {
+                break;
+            }
+            const char32_t c = Peek();
+            size_t low = 0;
+            std::optional<size_t> high;
+            if (c == U'*')
+            {
+                ++mPos;
+            }
+            else if (c == U'+')
+            {
+                ++mPos;
+                low = 1;
+            }
+            else if (c == U'?')
+            {
+                ++mPos;
+                high = 1;
+            }
+            else if (c == U'{')
+            {
+                const auto braces = ParseBraces();
+                if (!braces.has_value())
+                {
+                    break;
+                }
+                low = braces->first;
+                high = braces->second;
+            }
+            else
+            {
+                break;
+            }
+            // Lazy / possessive suffixes do not change what can match.
+            if (!Consume(U'?'))
+            {
+                Consume(U'+');
+            }
+            if (low == 0)
+            {
+                info = high == 1 ? Alternate(std::move(*info), EmptyString()) : AnyMatch();
+            }
+            else if (high != 1)
+            {
+                // `x{n,m}` starts and ends with `x{n}`; spell out a few
+                // copies so their trigrams count, then relax to `+`.
+                Info repeated = *info;
+                for (size_t copy = 1; copy < std::min(low, MAX_SPELLED_REPEATS); ++copy)
+                {
+                    repeated = Concat(std::move(repeated), *info);
+                }
+                info = high == low && low <= MAX_SPELLED_REPEATS ? std::move(repeated) : Plus(std::move(repeated));
+            }
+        }
+        return info;
+    }
+
+    /// Step over comments, `\E` and empty `\Q\E` pairs; false on an
+    /// unterminated comment.
+    bool SkipIgnorable()
+    {
+        while (true)
+        {
+            if (!mInQuote && Peek() == U'(' && Peek(1) == U'?' && Peek(2) == U'#')
+            {
+                mPos += 3;
+                if (!SkipName(U')'))
+                {
+                    return false;
+                }
+            }
+            else if (Peek() == U'\\' && Peek(1) == U'E')
+            {
+                mPos += 2;
+                mInQuote = false;
+            }
+            else if (!mInQuote && Peek() == U'\\' && Peek(1) == U'Q' && Peek(2) == U'\\' && Peek(3) == U'E')
+            {
+                mPos += 4;
+            }
+            else
+            {
+                return true;
+            }
+        }
+    }
+
+    std::optional<Info> ParseAtom(int depth)
+    {
+        const char32_t c = Peek();
+        ++mPos;
+        if (mInQuote)
+        {
+            if (c == U'\\' && Peek() == U'E')
+            {
+                ++mPos;
+                mInQuote = false;
+                return EmptyString();
+            }
+            return Literal(c);
+        }
+        switch (c)
+        {
+        case U'(':
+            return ParseGroup(depth);
+        case U'[':
+            return ParseClass();
+        case U'.':
+            return AnyChar();
+        case U'^':
+        case U'$':
+            return EmptyString();
+        case U'\\':
+            return ParseEscape();
+        case U'*':
+        case U'+':
+        case U'?':
+            // Quantifier with nothing to repeat.
+            return std::nullopt;
+        default:
+            return Literal(c);
+        }
+    }
+
+    /// Zero-width or ignorable group body: parse it for position only.
+    std::optional<Info> SkipGroupBody(int depth)
+    {
+        if (!ParseAlternation(depth + 1).has_value() || !Consume(U')'))
+        {
+            return std::nullopt;
+        }
+        return EmptyString();
+    }
+
+    std::optional<Info> GroupBody(int depth)
+    {
+        auto info = ParseAlternation(depth + 1);
+        if (!info.has_value() || !Consume(U')'))
+        {
+            return std::nullopt;
+        }
+        return info;
+    }
+
+    bool SkipName(char32_t close)
+    {
+        while (!AtEnd() && Peek() != close)
+        {
+            ++mPos;
+        }
+        return Consume(close);
+    }
+
+    std::optional<Info> ParseGroup(int depth)
+    {
+        if (Peek() == U'*')
+        {
+            // `(*VERB)` / `(*UTF)` and friends.
+            return std::nullopt;
+        }
+        if (!Consume(U'?'))
+        {
+            return GroupBody(depth);
+        }
+        const char32_t c = Peek();
+        if (c == U':' || c == U'>' || c == U'|')
+        {
+            ++mPos;
+            return GroupBody(depth);
+        }
+        if (c == U'=' || c == U'!')
+        {
+            ++mPos;
+            return SkipGroupBody(depth);
+        }
+        if (c == U'<' && (Peek(1) == U'=' || Peek(1) == U'!'))
+        {
+            mPos += 2;
+            return SkipGroupBody(depth);
+        }
+        if (c == U'#')
+        {
+            return SkipName(U')') ? std::optional<Info>(EmptyString()) : std::nullopt;
+        }
+        if (c == U'<' || c == U'\'')
+        {
+            ++mPos;
+            return SkipName(c == U'<' ? U'>' : U'\'') ? GroupBody(depth) : std::nullopt;
+        }
+        if (c == U'P' && Peek(1) == U'<')
+        {
+            mPos += 2;
+            return SkipName(U'>') ? GroupBody(depth) : std::nullopt;
+        }
+        if (c == U'P' && Peek(1) == U'=')
+        {
+            // Named backreference.
+            mPos += 2;
+            return SkipName(U')') ? std::optional<Info>(AnyMatch()) : std::nullopt;
+        }
+        // Inline flags: `(?i)`, `(?s-m)`, `(?i:...)`. Only extended mode
+        // changes how the rest of the pattern reads.
+        while (!AtEnd() && ((Peek() >= U'a' && Peek() <= U'z') || Peek() == U'-' || Peek() == U'^'))
+        {
+            if (Peek() == U'x')
+            {
+                return std::nullopt;
+            }
+            ++mPos;
+        }
+        if (Consume(U')'))
+        {
+            return EmptyString();
+        }
+        if (Consume(U':'))
+        {
+            return GroupBody(depth);
+        }
+        // Recursion, conditionals, callouts, ...
+        return std::nullopt;
+    }
+
+    /// Hex digits up to @p maxDigits, or inside `{...}`.
+    std::optional<char32_t> ParseCodePoint(int base, size_t maxDigits)
+    {
+        const bool braced = Consume(U'{');
+        char32_t value = 0;
+        size_t digits = 0;
+        while (!AtEnd() && (braced || digits < maxDigits))
+        {
+            const char32_t c = Peek();
+            int digit = -1;
+            if (c >= U'0' && c <= U'9')
+            {
+                digit = static_cast<int>(c - U'0');
+            }
+            else if (base == 16 && c >= U'a' && c <= U'f')
+            {
+                digit = static_cast<int>(c - U'a') + 10;
+            }
+            else if (base == 16 && c >= U'A' && c <= U'F')
+            {
+                digit = static_cast<int>(c - U'A') + 10;
+            }
+            if (digit < 0 || digit >= base)
+            {
+                break;
+            }
+            value = std::min<char32_t>((value * static_cast<char32_t>(base)) + static_cast<char32_t>(digit), 0x110000);
+            ++digits;
+            ++mPos;
+        }
+        if (braced && !Consume(U'}'))
+        {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+    /// Symbols a `\` escape inside or outside a class stands for. Sets
+    /// @p any for escapes matching too many symbols; nullopt for escapes
+    /// that are not a single character (assertions, backreferences,
+    /// `\Q`) or that the analyzer does not know.
+    std::optional<std::vector<char>> EscapeSymbols(char32_t c, bool &any)
+    {
+        any = false;
+        switch (c)
+        {
+        case U'd':
+        {
+            std::vector<char> digits{TRIGRAM_OTHER_SYMBOL};
+            for (char digit = '0'; digit <= '9'; ++digit)
+            {
+                digits.push_back(digit);
+            }
+            return digits;
+        }
+        case U's':
+        case U'h':
+        case U'v':
+            // Whitespace folds to `' '`; the odd `\h` / `\v` member
+            // `QChar::isSpace` disagrees on folds to the other symbol.
+            return std::vector<char>{' ', TRIGRAM_OTHER_SYMBOL};
+        case U'w':
+        case U'D':
+        case U'S':
+        case U'W':
+        case U'H':
+        case U'V':
+        case U'N':
+        case U'C':
+        case U'X':
+        case U'R':
+            any = true;
+            return std::vector<char>{};
+        case U'p':
+        case U'P':
+            if (Peek() == U'{')
+            {
+                if (!SkipName(U'}'))
+                {
+                    return std::nullopt;
+                }
+            }
+            else if (!AtEnd())
+            {
+                ++mPos;
+            }
+            any = true;
+            return std::vector<char>{};
+        case U'n':
+            return std::vector<char>{FoldTrigramCodePoint(U'\n')};
+        case U't':
+            return std::vector<char>{FoldTrigramCodePoint(U'\t')};
+        case U'r':
+            return std::vector<char>{FoldTrigramCodePoint(U'\r')};
+        case U'f':
+            return std::vector<char>{FoldTrigramCodePoint(U'\f')};
+        case U'e':
+        case U'a':
+        case U'c':
+            if (c == U'c' && !AtEnd())
+            {
+                ++mPos;
+            }
+            return std::vector<char>{TRIGRAM_OTHER_SYMBOL};
+        case U'x':
+        {
+            const auto codePoint = ParseCodePoint(16, 2);
+            return codePoint.has_value() ? std::optional(std::vector<char>{FoldTrigramCodePoint(*codePoint)})
+                                         : std::nullopt;
+        }
+        case U'o':
+        {
+            if (Peek() != U'{')
+            {
+                return std::nullopt;
+            }
+            const auto codePoint = ParseCodePoint(8, 0);
+            return codePoint.has_value() ? std::optional(std::vector<char>{FoldTrigramCodePoint(*codePoint)})
+                                         : std::nullopt;
+        }
+        case U'0':
+        {
+            const auto codePoint = ParseCodePoint(8, 2);
+            return codePoint.has_value() ? std::optional(std::vector<char>{FoldTrigramCodePoint(*codePoint)})
+                                         : std::nullopt;
+        }
+        default:
+            break;
+        }
+        if (IsAsciiAlnum(c))
+        {
+            return std::nullopt;
+        }
+        // Escaped punctuation or non-ASCII: the character itself.
+        return std::vector<char>{FoldTrigramCodePoint(c)};
+    }
+
+    std::optional<Info> ParseEscape()
+    {
+        if (AtEnd())
+        {
+            return std::nullopt;
+        }
+        const char32_t c = Peek();
+        ++mPos;
+        switch (c)
+        {
+        case U'b':
+        case U'B':
+        case U'A':
+        case U'z':
+        case U'Z':
+        case U'G':
+        case U'K':
+        case U'E':
+            return EmptyString();
+        case U'Q':
+            // Quoted characters are read one atom at a time, so a
+            // quantifier after `\E` applies to the last one only.
+            mInQuote = true;
+            return EmptyString();
+        case U'g':
+        case U'k':
+            // Backreference or subroutine call by name / number.
+            if (Peek() == U'{' || Peek() == U'<' || Peek() == U'\'')
+            {
+                const char32_t open = Peek();
+                ++mPos;
+                if (!SkipName(open == U'{' ? U'}' : (open == U'<' ? U'>' : U'\'')))
+                {
+                    return std::nullopt;
+                }
+            }
+            else
+            {
+                Consume(U'-');
+                while (Peek() >= U'0' && Peek() <= U'9')
+                {
+                    ++mPos;
+                }
+            }
+            return AnyMatch();
+        default:
+            break;
+        }
+        if (c >= U'1' && c <= U'9')
+        {
+            // Backreference (or an octal escape PCRE reads the same way).
+            while (Peek() >= U'0' && Peek() <= U'9')
+            {
+                ++mPos;
+            }
+            return AnyMatch();
+        }
+        bool any = false;
+        auto symbols = EscapeSymbols(c, any);
+        if (!symbols.has_value())
+        {
+            return std::nullopt;
+        }
+        return any ? AnyChar() : Symbols(*symbols);
+    }
+
+    /// Add the folds of every code point in `[low, high]` to @p set.
+    static void AddRange(char32_t low, char32_t high, std::array<bool, 128> &set)
+    {
+        for (char32_t c = low; c <= std::min<char32_t>(high, 0x7F); ++c)
+        {
+            set[static_cast<unsigned char>(FoldTrigramCodePoint(c))] = true;
+        }
+        if (high < 0x80)
+        {
+            return;
+        }
+        set[static_cast<unsigned char>(TRIGRAM_OTHER_SYMBOL)] = true;
+        // The non-ASCII code points with an ASCII fold.
+        static constexpr std::array<char32_t, 19> FOLDED = {
+            0x0085, 0x00A0, 0x0130, 0x0131, 0x017F, 0x1680, 0x2000, 0x2001, 0x2002, 0x2003,
+            0x2004, 0x2005, 0x2006, 0x2007, 0x2008, 0x2009, 0x200A, 0x2028, 0x2029,
+        };
+        static constexpr std::array<char32_t, 4> FOLDED_HIGH = {0x202F, 0x205F, 0x212A, 0x3000};
+        for (const char32_t codePoint : FOLDED)
+        {
+            if (codePoint >= low && codePoint <= high)
+            {
+                set[static_cast<unsigned char>(FoldTrigramCodePoint(codePoint))] = true;
+            }
+        }
+        for (const char32_t codePoint : FOLDED_HIGH)
+        {
+            if (codePoint >= low && codePoint <= high)
+            {
+                set[static_cast<unsigned char>(FoldTrigramCodePoint(codePoint))] = true;
+            }
+        }
+    }
+
+    /// One class member's code point, for range endpoints; nullopt when
+    /// the member is a multi-symbol escape.
+    std::optional<char32_t> ClassCodePoint()
+    {
+        if (Peek() != U'\\')
+        {
+            return mPattern[mPos++];
+        }
+        const char32_t c = Peek(1);
+        switch (c)
+        {
+        case U'n':
+            mPos += 2;
+            return U'\n';
+        case U't':
+            mPos += 2;
+            return U'\t';
+        case U'r':
+            mPos += 2;
+            return U'\r';
+        case U'f':
+            mPos += 2;
+            return U'\f';
+        case U'x':
+            mPos += 2;
+            return ParseCodePoint(16, 2);
+        case U'0':
+            mPos += 2;
+            return ParseCodePoint(8, 2);
+        default:
+            break;
+        }
+        if (c == U'\0' || IsAsciiAlnum(c))
+        {
+            return std::nullopt;
+        }
+        mPos += 2;
+        return c;
+    }
+
+    std::optional<Info> ParseClass()
+    {
+        const bool negated = Consume(U'^');
+        std::array<bool, 128> set{};
+        bool any = false;
+        bool first = true;
+        while (true)
+        {
+            if (AtEnd())
+            {
+                return std::nullopt;
+            }
+            if (Peek() == U']' && !first)
+            {
+                ++mPos;
+                break;
+            }
+            first = false;
+            if (Peek() == U'[' && Peek(1) == U':')
+            {
+                // POSIX class: wide enough to treat as anything.
+                mPos += 2;
+                if (!SkipName(U']'))
+                {
+                    return std::nullopt;
+                }
+                any = true;
+                continue;
+            }
+            if (Peek() == U'\\' && Peek(1) == U'Q')
+            {
+                mPos += 2;
+                while (!AtEnd() && !(Peek() == U'\\' && Peek(1) == U'E'))
+                {
+                    AddRange(Peek(), Peek(), set);
+                    ++mPos;
+                }
+                mPos = std::min(mPos + 2, mPattern.size());
+                continue;
+            }
+            const size_t start = mPos;
+            const auto low = ClassCodePoint();
+            if (!low.has_value())
+            {
+                // Multi-symbol escape such as `\d` or `\w`.
+                mPos = start + 1;
+                const char32_t c = Peek();
+                ++mPos;
+                bool wide = false;
+                const auto symbols = c == U'b' ? std::optional(std::vector<char>{TRIGRAM_OTHER_SYMBOL})
+                                               : EscapeSymbols(c, wide);
+                if (!symbols.has_value())
+                {
+                    return std::nullopt;
+                }
+                any = any || wide;
+                for (const char symbol : *symbols)
+                {
+                    set[static_cast<unsigned char>(symbol)] = true;
+                }
+                continue;
+            }
+            if (Peek() == U'-' && Peek(1) != U']' && Peek(1) != U'\0')
+            {
+                const size_t dash = mPos;
+                ++mPos;
+                const auto high = ClassCodePoint();
+                if (high.has_value() && *high >= *low)
+                {
+                    AddRange(*low, *high, set);
+                    continue;
+                }
+                if (high.has_value())
+                {
+                    // Reversed range: PCRE rejects the pattern.
+                    return std::nullopt;
+                }
+                // `a-\d`: the dash is literal.
+                mPos = dash;
+            }
+            AddRange(*low, *low, set);
+        }
+        std::vector<char> symbols;
+        for (size_t symbol = 0; symbol < set.size(); ++symbol)
+        {
+            if (set[symbol])
+            {
+                symbols.push_back(static_cast<char>(symbol));
+            }
+        }
+        if (negated || any || symbols.size() > MAX_CLASS_SYMBOLS)
+        {
+            return AnyChar();
+        }
+        if (symbols.empty())
+        {
+            return std::nullopt;
+        }
+        return Symbols(symbols);
+    }
+
+    std::u32string mPattern;
+    size_t mPos = 0;
+    /// Inside `\Q...\E`: every character is a literal.
+    bool mInQuote = false;
+};
+
+/// Decode UTF-8 for the parser; malformed bytes become U+FFFD.
+std::u32string DecodePattern(std::string_view pattern)
+{
+    std::u32string out;
+    out.reserve(pattern.size());
+    size_t pos = 0;
+    while (pos < pattern.size())
+    {
+        const auto lead = static_cast<unsigned char>(pattern[pos]);
+        size_t length = 1;
+        char32_t codePoint = lead;
+        if (lead >= 0xF0U)
+        {
+            length = 4;
+            codePoint = lead & 0x07U;
+        }
+        else if (lead >= 0xE0U)
+        {
+            length = 3;
+            codePoint = lead & 0x0FU;
+        }
+        else if (lead >= 0xC0U)
+        {
+            length = 2;
+            codePoint = lead & 0x1FU;
+        }
+        else if (lead >= 0x80U)
+        {
+            length = 0;
+        }
+        bool valid = length != 0 && pos + length <= pattern.size();
+        for (size_t i = 1; valid && i < length; ++i)
+        {
+            const auto next = static_cast<unsigned char>(pattern[pos + i]);
+            valid = (next & 0xC0U) == 0x80U;
+            codePoint = (codePoint << 6U) | (next & 0x3FU);
+        }
+        if (!valid)
+        {
+            out.push_back(REPLACEMENT_CHARACTER);
+            ++pos;
+            continue;
+        }
+        out.push_back(codePoint);
+        pos += length;
+    }
+    return out;
+}
+
+/// Sort and dedupe the trigrams; drop repeated sub-queries.
+void Normalise(TrigramQuery &query)
+{
+    std::ranges::sort(query.trigrams);
+    const auto [first, last] = std::ranges::unique(query.trigrams);
+    query.trigrams.erase(first, last);
+    std::vector<TrigramQuery> subs;
+    subs.reserve(query.subs.size());
+    for (TrigramQuery &sub : query.subs)
+    {
+        if (std::ranges::find(subs, sub) == subs.end())
+        {
+            subs.push_back(std::move(sub));
+        }
+    }
+    query.subs = std::move(subs);
+}
+
+} // namespace
+
+TrigramQuery TrigramQuery::ForLiteral(std::string_view needle)
+{
+    // Compacting the needle too keeps it a substring of any compacted
+    // text it is a raw substring of.
+    std::string symbols;
+    internal::FoldTrigramText(needle, /*compact=*/true, symbols);
+    return TrigramsOf(symbols);
+}
+
+TrigramQuery TrigramQuery::ForRegex(std::string_view pattern)
+{
+    RegexAnalyzer analyzer(DecodePattern(pattern));
+    auto info = analyzer.Run();
+    if (!info.has_value())
+    {
+        return TrigramQuery{};
+    }
+    info->Simplify(true);
+    info->AddExact();
+    return std::move(info->match);
+}
+
+TrigramQuery TrigramQuery::And(TrigramQuery lhs, TrigramQuery rhs)
+{
+    if (lhs.op == Op::None || rhs.op == Op::All)
+    {
+        return lhs;
+    }
+    if (rhs.op == Op::None || lhs.op == Op::All)
+    {
+        return rhs;
+    }
+    const auto single = [](const TrigramQuery &query) {
+        return query.op == Op::Or && query.subs.empty() && query.trigrams.size() == 1;
+    };
+    TrigramQuery out;
+    out.op = Op::And;
+    for (TrigramQuery *side : {&lhs, &rhs})
+    {
+        if (side->op == Op::And || single(*side))
+        {
+            out.trigrams.insert(out.trigrams.end(), side->trigrams.begin(), side->trigrams.end());
+            for (TrigramQuery &sub : side->subs)
+            {
+                out.subs.push_back(std::move(sub));
+            }
+        }
+        else
+        {
+            out.subs.push_back(std::move(*side));
+        }
+    }
+    Normalise(out);
+    return out;
+}
+
+TrigramQuery TrigramQuery::Or(TrigramQuery lhs, TrigramQuery rhs)
+{
+    if (lhs.op == Op::All || rhs.op == Op::None)
+    {
+        return lhs;
+    }
+    if (rhs.op == Op::All || lhs.op == Op::None)
+    {
+        return rhs;
+    }
+    const auto single = [](const TrigramQuery &query) {
+        return query.op == Op::And && query.subs.empty() && query.trigrams.size() == 1;
+    };
+    TrigramQuery out;
+    out.op = Op::Or;
+    for (TrigramQuery *side : {&lhs, &rhs})
+    {
+        if (side->op == Op::Or || single(*side))
+        {
+            out.trigrams.insert(out.trigrams.end(), side->trigrams.begin(), side->trigrams.end());
+            for (TrigramQuery &sub : side->subs)
+            {
+                out.subs.push_back(std::move(sub));
+            }
+        }
+        else
+        {
+            out.subs.push_back(std::move(*side));
+        }
+    }
+    Normalise(out);
+    // A branch that already holds one of the `Or`'s lone trigrams adds
+    // nothing: `t | (t & u)` is `t`.
+    std::erase_if(out.subs, [&out](const TrigramQuery &sub) {
+        return sub.op == Op::And && std::ranges::any_of(sub.trigrams, [&out](uint32_t key) {
+                   return std::ranges::binary_search(out.trigrams, key);
+               });
+    });
+    // Likewise `(t & u) | (t & u & v)` is `t & u`: drop a branch that
+    // requires every trigram of a flat sibling branch.
+    std::vector<bool> absorbed(out.subs.size(), false);
+    for (size_t i = 0; i < out.subs.size(); ++i)
+    {
+        const TrigramQuery &weaker = out.subs[i];
+        if (weaker.op != Op::And || !weaker.subs.empty())
+        {
+            continue;
+        }
+        for (size_t j = 0; j < out.subs.size(); ++j)
+        {
+            if (j != i && !absorbed[j] && out.subs[j].op == Op::And &&
+                std::ranges::includes(out.subs[j].trigrams, weaker.trigrams))
+            {
+                absorbed[j] = true;
+            }
+        }
+    }
+    size_t kept = 0;
+    for (size_t i = 0; i < out.subs.size(); ++i)
+    {
+        if (absorbed[i])
+        {
+            continue;
+        }
+        if (kept != i)
+        {
+            out.subs[kept] = std::move(out.subs[i]);
+        }
+        ++kept;
+    }
+    out.subs.resize(kept);
+    if (out.trigrams.empty() && out.subs.size() == 1)
+    {
+        return std::move(out.subs.front());
+    }
+    if (out.trigrams.size() + out.subs.size() > MAX_OR_TERMS)
+    {
+        // Dropping a branch would lose matches; give up instead.
+        return TrigramQuery{};
+    }
+    return out;
+}
+
+} // namespace loglib
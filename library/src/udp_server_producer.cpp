@@ -6,13 +6,13 @@
 
 #include <atomic>
 #include <chrono>
-#include <condition_variable>
 #include <cstring>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <span>
 #include <string>
+#include <string_view>
 #include <system_error>
 #include <thread>
 #include <utility>
@@ -33,6 +33,8 @@ public:
     UdpServerProducerImpl &operator=(UdpServerProducerImpl &&) = delete;
 
     size_t Read(std::span<char> buffer);
+    [[nodiscard]] std::span<const char> BorrowBytes(size_t maxBytes);
+    void ReleaseBorrowedBytes() noexcept;
     void WaitForBytes(std::chrono::milliseconds timeout);
     void Stop() noexcept;
     [[nodiscard]] bool IsClosed() const noexcept;
@@ -49,8 +51,8 @@ private:
 
     /// Append @p bytes to the byte queue, normalising the trailing
     /// newline. Drops front bytes (under-the-hood FIFO) if the queue
-    /// would exceed `mOptions.maxQueueBytes`.
-    void AppendDatagramLocked(const char *data, size_t size);
+    /// would exceed `mOptions.maxQueueBytes`. I/O worker only.
+    void AppendDatagram(const char *data, size_t size);
 
     /// Edge-triggered transition `Waiting -> Running` once a real
     /// datagram has arrived. Mirrors `TcpServerProducer::MarkRunning`
@@ -70,13 +72,9 @@ private:
     std::vector<char> mRecvBuffer;
     asio::ip::udp::endpoint mPeerEndpoint;
 
-    mutable std::mutex mMutex;
-    std::condition_variable mCv;
-
-    /// Byte queue (FIFO). Backed by a `std::deque<char>` ring so
-    /// back-pressure-induced front drops are O(K-bytes-dropped) and
-    /// never trigger a full-buffer shift. The wrapper handles the
-    /// line-aware drop policy so this file stays focused on Asio
+    /// Byte queue: lock-free SPSC ring (I/O worker in, parser out)
+    /// that also owns the line-aware drop policy and the parser's
+    /// `WaitForBytes` parking, so this file stays focused on Asio
     /// plumbing.
     LineBytesQueue mReadyBuffer;
 
@@ -100,7 +98,8 @@ private:
 };
 
 UdpServerProducerImpl::UdpServerProducerImpl(UdpServerProducer::Options options)
-    : mOptions(std::move(options)), mSocket(mIoContext), mRecvBuffer(mOptions.maxDatagramBytes)
+    : mOptions(std::move(options)), mSocket(mIoContext), mRecvBuffer(mOptions.maxDatagramBytes),
+      mReadyBuffer(mOptions.maxQueueBytes)
 {
     asio::error_code ec;
     const asio::ip::address bindAddr = asio::ip::make_address(mOptions.bindAddress, ec);
@@ -148,7 +147,7 @@ UdpServerProducerImpl::UdpServerProducerImpl(UdpServerProducer::Options options)
             static_cast<void>(0);
         }
         mWorkerExited.store(true, std::memory_order_release);
-        mCv.notify_all();
+        mReadyBuffer.WakeConsumer();
     });
 }
 
@@ -163,24 +162,27 @@ UdpServerProducerImpl::~UdpServerProducerImpl()
 
 size_t UdpServerProducerImpl::Read(std::span<char> buffer)
 {
-    if (buffer.empty())
-    {
-        return 0;
-    }
-    const std::scoped_lock lock(mMutex);
     return mReadyBuffer.Read(buffer);
 }
 
+std::span<const char> UdpServerProducerImpl::BorrowBytes(size_t maxBytes)
+{
+    return mReadyBuffer.Borrow(maxBytes);
+}
+
+void UdpServerProducerImpl::ReleaseBorrowedBytes() noexcept
+{
+    mReadyBuffer.ReleaseBorrowed();
+}
+
 void UdpServerProducerImpl::WaitForBytes(std::chrono::milliseconds timeout)
 {
     if (timeout.count() <= 0)
     {
         return; // non-blocking
     }
-    std::unique_lock<std::mutex> lock(mMutex);
-    mCv.wait_for(lock, timeout, [&] {
-        return !mReadyBuffer.Empty() || mStopRequested.load(std::memory_order_acquire) ||
-               mWorkerExited.load(std::memory_order_acquire);
+    mReadyBuffer.WaitForBytes(timeout, [&] {
+        return mStopRequested.load(std::memory_order_acquire) || mWorkerExited.load(std::memory_order_acquire);
     });
 }
 
@@ -215,7 +217,7 @@ void UdpServerProducerImpl::Stop() noexcept
         // hard-stop as the safety net so the producer always terminates.
         mIoContext.stop();
     }
-    mCv.notify_all();
+    mReadyBuffer.WakeConsumer();
 }
 
 bool UdpServerProducerImpl::IsClosed() const noexcept
@@ -224,7 +226,6 @@ bool UdpServerProducerImpl::IsClosed() const noexcept
     {
         return false;
     }
-    const std::scoped_lock lock(mMutex);
     return mReadyBuffer.Empty();
 }
 
@@ -317,45 +318,30 @@ void UdpServerProducerImpl::StartReceive()
             }
             if (bytes > 0)
             {
-                {
-                    const std::scoped_lock lock(mMutex);
-                    AppendDatagramLocked(mRecvBuffer.data(), bytes);
-                }
+                AppendDatagram(mRecvBuffer.data(), bytes);
                 mDatagramCount.fetch_add(1, std::memory_order_acq_rel);
                 MarkRunning();
-                mCv.notify_all();
             }
             StartReceive();
         }
     );
 }
 
-void UdpServerProducerImpl::AppendDatagramLocked(const char *data, size_t size)
+void UdpServerProducerImpl::AppendDatagram(const char *data, size_t size)
 {
     if (size == 0)
     {
         return;
     }
-    // Normalise the trailing newline first so the line-aware
-    // back-pressure path inside `LineBytesQueue::Append` always sees
-    // a complete-line payload (the framing contract the parser
-    // expects). The synthetic newline goes through a stack buffer
-    // when the datagram is large enough to need it; for the common
-    // pre-terminated case we hand the original pointer through.
-    if (data[size - 1] == '\n')
-    {
-        mReadyBuffer.Append(data, size, mOptions.maxQueueBytes, mDroppedByteCount);
-    }
-    else
-    {
-        // One pass: append the datagram and the synthetic newline as
-        // separate ops -- both share the same back-pressure cap, so
-        // the second call will drop additional history if needed
-        // without ever creating a torn line.
-        mReadyBuffer.Append(data, size, mOptions.maxQueueBytes, mDroppedByteCount);
-        const char nl = '\n';
-        mReadyBuffer.Append(&nl, 1, mOptions.maxQueueBytes, mDroppedByteCount);
-    }
+    // Normalise the trailing newline so the line-aware back-pressure
+    // path inside `LineBytesQueue::Append` always sees a complete-line
+    // payload (the framing contract the parser expects). The datagram
+    // and its synthetic newline go in as one unit: appended separately,
+    // the consumer could borrow between them, or a pinned borrow could
+    // drop the lone newline and merge the next datagram into this line.
+    const std::string_view payload(data, size);
+    const std::string_view newline = payload.back() == '\n' ? std::string_view{} : std::string_view{"\n"};
+    mReadyBuffer.Append(payload, newline, mDroppedByteCount);
 }
 
 } // namespace loglib::internal
@@ -376,6 +362,21 @@ size_t UdpServerProducer::Read(std::span<char> buffer)
     return mImpl->Read(buffer);
 }
 
+bool UdpServerProducer::SupportsBorrowedBytes() const noexcept
+{
+    return true;
+}
+
+std::span<const char> UdpServerProducer::BorrowBytes(size_t maxBytes)
+{
+    return mImpl->BorrowBytes(maxBytes);
+}
+
+void UdpServerProducer::ReleaseBorrowedBytes() noexcept
+{
+    mImpl->ReleaseBorrowedBytes();
+}
+
 void UdpServerProducer::WaitForBytes(std::chrono::milliseconds timeout)
 {
     mImpl->WaitForBytes(timeout);
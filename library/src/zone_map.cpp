@@ -0,0 +1,221 @@
+#include "loglib/internal/zone_map.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <optional>
+
+namespace loglib::internal
+{
+
+void ZoneSummary::Add(const CompactLogValue &slot) noexcept
+{
+    ++rows;
+    // Acceptance sets mirror `TimeRangeRowPredicate::MatchesRow` and
+    // `NumericRangeRowPredicate::MatchesRow`.
+    std::optional<int64_t> micros;
+    std::optional<double> number;
+    switch (slot.tag)
+    {
+    case CompactTag::Timestamp:
+        micros = static_cast<int64_t>(slot.payload);
+        break;
+    case CompactTag::Int64:
+        micros = static_cast<int64_t>(slot.payload);
+        number = static_cast<double>(static_cast<int64_t>(slot.payload));
+        break;
+    case CompactTag::Uint64:
+        if (slot.payload <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+        {
+            micros = static_cast<int64_t>(slot.payload);
+            hasUnsignedTime = true;
+        }
+        number = static_cast<double>(slot.payload);
+        break;
+    case CompactTag::Double:
+        if (const auto value = std::bit_cast<double>(slot.payload); !std::isnan(value))
+        {
+            number = value;
+        }
+        break;
+    default:
+        break;
+    }
+    if (micros.has_value())
+    {
+        ++timeRows;
+        minMicros = std::min(minMicros, *micros);
+        maxMicros = std::max(maxMicros, *micros);
+    }
+    if (number.has_value())
+    {
+        ++numberRows;
+        minNumber = std::min(minNumber, *number);
+        maxNumber = std::max(maxNumber, *number);
+    }
+}
+
+void ZoneSummary::Merge(const ZoneSummary &other) noexcept
+{
+    rows += other.rows;
+    timeRows += other.timeRows;
+    numberRows += other.numberRows;
+    hasUnsignedTime = hasUnsignedTime || other.hasUnsignedTime;
+    minMicros = std::min(minMicros, other.minMicros);
+    maxMicros = std::max(maxMicros, other.maxMicros);
+    minNumber = std::min(minNumber, other.minNumber);
+    maxNumber = std::max(maxNumber, other.maxNumber);
+}
+
+void ZoneMap::Append(const CompactLogValue &slot)
+{
+    if (AtBlockBoundary() || mBlocks.empty())
+    {
+        mBlocks.emplace_back();
+    }
+    mBlocks.back().Add(slot);
+    ++mSize;
+}
+
+void ZoneMap::AppendBlock(const ZoneSummary &summary)
+{
+    assert(AtBlockBoundary() && summary.rows <= BLOCK_ROWS);
+    if (summary.rows == 0)
+    {
+        return;
+    }
+    mBlocks.push_back(summary);
+    mSize += summary.rows;
+}
+
+void ZoneMap::EraseFront(size_t count)
+{
+    if (count >= mSize)
+    {
+        Clear();
+        return;
+    }
+    const uint64_t firstKey = mFirstId / BLOCK_ROWS;
+    mFirstId += count;
+    mSize -= count;
+    const auto dropped = static_cast<std::ptrdiff_t>((mFirstId / BLOCK_ROWS) - firstKey);
+    mBlocks.erase(mBlocks.begin(), std::next(mBlocks.begin(), dropped));
+}
+
+void ZoneMap::Clear() noexcept
+{
+    mBlocks.clear();
+    // A rebuild starts from row 0, so realign blocks to it.
+    mFirstId = 0;
+    mSize = 0;
+}
+
+size_t ZoneMap::BlockFirstRow(size_t block) const noexcept
+{
+    const uint64_t start = ((mFirstId / BLOCK_ROWS) + block) * BLOCK_ROWS;
+    return start > mFirstId ? static_cast<size_t>(start - mFirstId) : 0;
+}
+
+size_t ZoneMap::BlockEndRow(size_t block) const noexcept
+{
+    const uint64_t end = ((mFirstId / BLOCK_ROWS) + block + 1) * BLOCK_ROWS;
+    return std::min(static_cast<size_t>(end - mFirstId), mSize);
+}
+
+ZoneSummary ZoneMap::Total() const noexcept
+{
+    ZoneSummary total;
+    for (const ZoneSummary &block : mBlocks)
+    {
+        total.Merge(block);
+    }
+    return total;
+}
+
+void ZoneMapStore::SetEnabled(bool enabled) noexcept
+{
+    mEnabled = enabled;
+    if (!enabled)
+    {
+        Clear();
+    }
+}
+
+void ZoneMapStore::Resize(size_t columnCount)
+{
+    mColumns.resize(columnCount);
+}
+
+void ZoneMapStore::Bind(size_t index, const std::vector<KeyId> &keyIds, bool tracked)
+{
+    Entry &entry = mColumns[index];
+    if (entry.keyIds == keyIds && entry.tracked == tracked)
+    {
+        return;
+    }
+    entry.map.Clear();
+    entry.keyIds = keyIds;
+    entry.tracked = tracked;
+}
+
+void ZoneMapStore::Invalidate(size_t index) noexcept
+{
+    if (index < mColumns.size())
+    {
+        mColumns[index].map.Clear();
+    }
+}
+
+void ZoneMapStore::MoveColumn(size_t srcIndex, size_t destIndex)
+{
+    if (srcIndex == destIndex || srcIndex >= mColumns.size() || destIndex >= mColumns.size())
+    {
+        return;
+    }
+    using Diff = std::vector<Entry>::difference_type;
+    auto begin = mColumns.begin();
+    if (srcIndex > destIndex)
+    {
+        std::rotate(
+            std::next(begin, static_cast<Diff>(destIndex)),
+            std::next(begin, static_cast<Diff>(srcIndex)),
+            std::next(begin, static_cast<Diff>(srcIndex + 1))
+        );
+    }
+    else
+    {
+        std::rotate(
+            std::next(begin, static_cast<Diff>(srcIndex)),
+            std::next(begin, static_cast<Diff>(srcIndex + 1)),
+            std::next(begin, static_cast<Diff>(destIndex + 1))
+        );
+    }
+}
+
+void ZoneMapStore::EraseFrontRows(size_t count)
+{
+    for (Entry &entry : mColumns)
+    {
+        entry.map.EraseFront(count);
+    }
+}
+
+void ZoneMapStore::Clear() noexcept
+{
+    mColumns.clear();
+}
+
+size_t ZoneMapStore::MemoryBytes() const noexcept
+{
+    size_t bytes = mColumns.capacity() * sizeof(Entry);
+    for (const Entry &entry : mColumns)
+    {
+        bytes += entry.map.MemoryBytes() + (entry.keyIds.capacity() * sizeof(KeyId));
+    }
+    return bytes;
+}
+
+} // namespace loglib::internal
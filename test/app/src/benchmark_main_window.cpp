@@ -17,11 +17,13 @@
 #include "highlight_rule_set.hpp"
 #include "log_filter_model.hpp"
 #include "log_model.hpp"
+#include "log_string_matcher.hpp"
 #include "qt_streaming_log_sink.hpp"
 #include "row_order_proxy_model.hpp"
 
 #include <loglib/enum_dictionary.hpp>
 #include <loglib/file_line_source.hpp>
+#include <loglib/filter_expression.hpp>
 #include <loglib/key_index.hpp>
 #include <loglib/log_compare.hpp>
 #include <loglib/log_configuration.hpp>
@@ -45,11 +47,13 @@
 #include <algorithm>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <memory>
 #include <numeric>
 #include <optional>
+#include <random>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -100,6 +104,24 @@ std::size_t WriteJsonlFixture(const std::filesystem::path &path, std::size_t cou
     return std::filesystem::file_size(path);
 }
 
+// `WriteJsonlFixture` plus a uniformly random `duration_ms` per record,
+// so a sort on it scatters every streamed batch across the table.
+std::size_t WriteJsonlFixtureWithDurations(const std::filesystem::path &path, std::size_t count)
+{
+    auto records = test_common::GenerateRandomLogRecords(count);
+    std::mt19937 rng(test_common::MakeRandomSeed());
+    std::uniform_int_distribution<std::int64_t> durationDist(0, 60'000);
+    const test_common::LogFormat format = test_common::JsonLines();
+    std::ofstream stream(path, std::ios::binary);
+    for (auto &record : records)
+    {
+        record["duration_ms"] = durationDist(rng);
+        stream << format.writeLine(record) << '\n';
+    }
+    stream.flush();
+    return std::filesystem::file_size(path);
+}
+
 struct RunResult
 {
     std::chrono::steady_clock::duration elapsed{};
@@ -522,6 +544,182 @@ private slots:
         );
     }
 
+    // Live-tail cost of an active `Or`-of-regex filter: stream the
+    // fixture through the production chain with the filter installed
+    // after the first batch, and time `LogFilterModel`'s
+    // `rowsInserted` handler for every later batch. The handler used
+    // to shift every accepted row and evaluate the batch serially on
+    // the GUI thread; the max per-batch time is the UI stall to watch.
+    void BenchStreamingTailWithOrRegexFilter()
+    {
+        using Ms = std::chrono::duration<double, std::milli>;
+
+        auto model = std::make_unique<LogModel>();
+        auto rowProxy = std::make_unique<RowOrderProxyModel>();
+        rowProxy->setSourceModel(model.get());
+
+        // Slots run in connection order: this one fires just before
+        // the filter proxy's handler, the one below just after it.
+        std::chrono::steady_clock::time_point handlerStart;
+        QObject::connect(rowProxy.get(), &QAbstractItemModel::rowsInserted, rowProxy.get(), [&handlerStart]() {
+            handlerStart = std::chrono::steady_clock::now();
+        });
+        auto filterProxy = std::make_unique<LogFilterModel>();
+        filterProxy->setSourceModel(rowProxy.get());
+        filterProxy->SetLogModel(model.get());
+
+        int messageCol = -1;
+        std::size_t batches = 0;
+        std::chrono::steady_clock::duration handlerTotal{};
+        std::chrono::steady_clock::duration handlerMax{};
+        QObject::connect(rowProxy.get(), &QAbstractItemModel::rowsInserted, rowProxy.get(), [&]() {
+            const auto elapsed = std::chrono::steady_clock::now() - handlerStart;
+            if (messageCol >= 0)
+            {
+                handlerTotal += elapsed;
+                handlerMax = std::max(handlerMax, elapsed);
+                ++batches;
+                return;
+            }
+            // First batch: the columns exist now, so bind the filter.
+            messageCol = FindColumnByKey(model->Configuration().columns, "message");
+            if (messageCol >= 0)
+            {
+                filterProxy->SetFilterExpression(MakeOrRegexFilter(messageCol));
+            }
+        });
+
+        QSignalSpy finishedSpy(model.get(), &LogModel::streamingFinished);
+        auto file = std::make_unique<loglib::LogFile>(mLogPath.string());
+        auto fileSource = std::make_unique<loglib::FileLineSource>(std::move(file));
+        loglib::FileLineSource *fileSourcePtr = fileSource.get();
+        const auto t0 = std::chrono::steady_clock::now();
+        model->BeginStreaming(std::move(fileSource), [fileSourcePtr, sink = model->Sink()](loglib::StopToken token) {
+            loglib::ParserOptions options;
+            options.stopToken = std::move(token);
+            const loglib::JsonParser parser;
+            parser.ParseStreaming(*fileSourcePtr, *sink, options);
+        });
+        QVERIFY2(finishedSpy.wait(180'000), "streamingFinished must fire within the 180 s timeout");
+        const auto elapsed = std::chrono::steady_clock::now() - t0;
+
+        QVERIFY2(messageCol >= 0, "fixture must produce a `message` column");
+        QCOMPARE(static_cast<std::size_t>(model->rowCount()), LINE_COUNT);
+        // The incrementally maintained proxy must match a one-shot
+        // evaluation over the finished table.
+        const auto reference = loglib::FilterAcceptedRows(model->Table(), MakeOrRegexFilter(messageCol));
+        QCOMPARE(static_cast<std::size_t>(filterProxy->rowCount()), reference.size());
+
+        qDebug().noquote() << FormatThroughput(
+            QStringLiteral("Qt path, streaming with Or/regex filter"), elapsed, mBytes, LINE_COUNT
+        );
+        qDebug().noquote() << QStringLiteral(
+                                  "Filter proxy append handler over %1 batches: %2 ms total, %3 ms max (%4 rows "
+                                  "accepted)"
+        )
+                                  .arg(batches)
+                                  .arg(Ms(handlerTotal).count(), 0, 'f', 2)
+                                  .arg(Ms(handlerMax).count(), 0, 'f', 2)
+                                  .arg(filterProxy->rowCount());
+    }
+
+    // Live-tail cost under an active sort on a scattered numeric
+    // column: stream a fixture with a random `duration_ms` per record,
+    // sort by it descending after the first batch, and time
+    // `LogFilterModel`'s `rowsInserted` handler for every later batch.
+    // Each batch used to pay one `vector::insert` and one bracket per
+    // row; the max per-batch time is the UI stall to watch.
+    void BenchStreamingTailSortedByDuration()
+    {
+        using Ms = std::chrono::duration<double, std::milli>;
+
+        const auto fixturePath = std::filesystem::path(mTempDir.path().toStdString()) / "bench_durations.jsonl";
+        const std::size_t bytes = WriteJsonlFixtureWithDurations(fixturePath, LINE_COUNT);
+        QVERIFY(bytes > 0);
+
+        auto model = std::make_unique<LogModel>();
+        auto rowProxy = std::make_unique<RowOrderProxyModel>();
+        rowProxy->setSourceModel(model.get());
+
+        // Slots run in connection order: this one fires just before
+        // the filter proxy's handler, the one below just after it.
+        std::chrono::steady_clock::time_point handlerStart;
+        QObject::connect(rowProxy.get(), &QAbstractItemModel::rowsInserted, rowProxy.get(), [&handlerStart]() {
+            handlerStart = std::chrono::steady_clock::now();
+        });
+        auto filterProxy = std::make_unique<LogFilterModel>();
+        filterProxy->setSourceModel(rowProxy.get());
+        filterProxy->SetLogModel(model.get());
+
+        int durationCol = -1;
+        std::size_t batches = 0;
+        std::size_t insertBrackets = 0;
+        std::chrono::steady_clock::duration handlerTotal{};
+        std::chrono::steady_clock::duration handlerMax{};
+        QObject::connect(filterProxy.get(), &QAbstractItemModel::rowsInserted, filterProxy.get(), [&insertBrackets]() {
+            ++insertBrackets;
+        });
+        QObject::connect(rowProxy.get(), &QAbstractItemModel::rowsInserted, rowProxy.get(), [&]() {
+            const auto elapsed = std::chrono::steady_clock::now() - handlerStart;
+            if (durationCol >= 0)
+            {
+                handlerTotal += elapsed;
+                handlerMax = std::max(handlerMax, elapsed);
+                ++batches;
+                return;
+            }
+            // First batch: the columns exist now, so install the sort.
+            durationCol = FindColumnByKey(model->Configuration().columns, "duration_ms");
+            if (durationCol >= 0)
+            {
+                filterProxy->sort(durationCol, Qt::DescendingOrder);
+                insertBrackets = 0;
+            }
+        });
+
+        QSignalSpy finishedSpy(model.get(), &LogModel::streamingFinished);
+        auto file = std::make_unique<loglib::LogFile>(fixturePath.string());
+        auto fileSource = std::make_unique<loglib::FileLineSource>(std::move(file));
+        loglib::FileLineSource *fileSourcePtr = fileSource.get();
+        const auto t0 = std::chrono::steady_clock::now();
+        model->BeginStreaming(std::move(fileSource), [fileSourcePtr, sink = model->Sink()](loglib::StopToken token) {
+            loglib::ParserOptions options;
+            options.stopToken = std::move(token);
+            const loglib::JsonParser parser;
+            parser.ParseStreaming(*fileSourcePtr, *sink, options);
+        });
+        QVERIFY2(finishedSpy.wait(180'000), "streamingFinished must fire within the 180 s timeout");
+        const auto elapsed = std::chrono::steady_clock::now() - t0;
+
+        QVERIFY2(durationCol >= 0, "fixture must produce a `duration_ms` column");
+        QCOMPARE(static_cast<std::size_t>(filterProxy->rowCount()), LINE_COUNT);
+        // The incrementally merged permutation must read back sorted.
+        // Identity row order, so source rows are log rows.
+        const loglib::LogTable &table = model->Table();
+        int previousRow = filterProxy->mapToSource(filterProxy->index(0, 0)).row();
+        for (int proxyRow = 1; proxyRow < filterProxy->rowCount(); ++proxyRow)
+        {
+            const int row = filterProxy->mapToSource(filterProxy->index(proxyRow, 0)).row();
+            const int cmp = loglib::CompareRows(
+                table, static_cast<size_t>(previousRow), static_cast<size_t>(row), static_cast<size_t>(durationCol)
+            );
+            QVERIFY2(cmp >= 0, "sorted tail must stay in descending `duration_ms` order");
+            previousRow = row;
+        }
+
+        qDebug().noquote() << FormatThroughput(
+            QStringLiteral("Qt path, streaming sorted by duration_ms"), elapsed, bytes, LINE_COUNT
+        );
+        qDebug().noquote() << QStringLiteral(
+                                  "Filter proxy sorted-append handler over %1 batches: %2 ms total, %3 ms max (%4 "
+                                  "insert brackets)"
+        )
+                                  .arg(batches)
+                                  .arg(Ms(handlerTotal).count(), 0, 'f', 2)
+                                  .arg(Ms(handlerMax).count(), 0, 'f', 2)
+                                  .arg(insertBrackets);
+    }
+
 private:
     static constexpr std::size_t LINE_COUNT = 1'000'000;
 
@@ -554,6 +752,27 @@ private:
         return -1;
     }
 
+    /// `message` matches either of two regexes; the shape the tail
+    /// benchmark filters on.
+    static loglib::CompiledFilterExpression MakeOrRegexFilter(int messageCol)
+    {
+        const auto makeRegexLeaf = [messageCol](const QString &pattern) {
+            loglib::CompiledFilterExpression leaf;
+            leaf.node = loglib::CompiledFilterExpression::Leaf(loglib::RowPredicate{
+                std::in_place_type<loglib::CallbackStringRowPredicate>,
+                static_cast<size_t>(messageCol),
+                MakeStringMatcher(pattern, loglib::LeafRule::Match::RegularExpression)
+            });
+            return leaf;
+        };
+        loglib::CompiledFilterExpression::Or orNode;
+        orNode.children.push_back(makeRegexLeaf(QStringLiteral(R"(\btempor\b.*\baliqua$)")));
+        orNode.children.push_back(makeRegexLeaf(QStringLiteral(R"(^lorem ipsum)")));
+        loglib::CompiledFilterExpression expression;
+        expression.node = std::move(orNode);
+        return expression;
+    }
+
     /// Time a single-threaded `CompareRows` sort. When @p useEnumRank
     /// is true the column must be Enumeration and a precomputed
     /// `EnumDictRank` is passed; otherwise the rank pointer is null
@@ -1637,6 +1637,315 @@ private slots:
         model.EndStreaming(false);
     }
 
+    // Streaming appends under an active `Or` filter: the append path
+    // evaluates only the new rows through the range overload of
+    // `loglib::FilterAcceptedRows` and extends the reverse index in
+    // place. After every batch the proxy must match a from-scratch
+    // rebuild, both in identity order and behind a reversed
+    // `RowOrderProxyModel` (where new rows land at the top).
+    static void TestFilterModelStreamingAppendsMatchRebuild()
+    {
+        LogModel model;
+        loglib::StreamLineSource &streamSource = BeginSyntheticStreamSession(model);
+        RowOrderProxyModel rowProxy;
+        rowProxy.setSourceModel(&model);
+        LogFilterModel filterModel;
+        filterModel.setSourceModel(&rowProxy);
+        filterModel.SetLogModel(&model);
+
+        loglib::KeyIndex &keys = model.Sink()->Keys();
+        const loglib::KeyId valueKey = keys.GetOrInsert(std::string("value"));
+        model.AppendBatch(MakeSyntheticBatch(streamSource, keys, valueKey, 1, 20, /*declareNewKey=*/true));
+        const int valueCol = ColumnByHeader(model, QStringLiteral("value"));
+        QVERIFY(valueCol >= 0);
+
+        // value <= 10 OR 40 < value < 61 OR value > 95.
+        const auto makeRange = [valueCol](std::optional<double> minValue, std::optional<double> maxValue) {
+            loglib::CompiledFilterExpression leaf;
+            leaf.node = loglib::CompiledFilterExpression::Leaf(loglib::RowPredicate{
+                std::in_place_type<loglib::NumericRangeRowPredicate>, static_cast<size_t>(valueCol), minValue, maxValue
+            });
+            return leaf;
+        };
+        loglib::CompiledFilterExpression::Or orNode;
+        orNode.children.push_back(makeRange(std::nullopt, 10.5));
+        orNode.children.push_back(makeRange(40.5, 60.5));
+        orNode.children.push_back(makeRange(95.5, std::nullopt));
+        loglib::CompiledFilterExpression expression;
+        expression.node = std::move(orNode);
+        filterModel.SetFilterExpression(std::move(expression));
+
+        const auto isAccepted = [](qint64 value) {
+            return value <= 10 || (value > 40 && value < 61) || value > 95;
+        };
+        const auto verifyAgainstSource = [&]() {
+            // Walk the source in proxy order and check every accepted
+            // row appears exactly where a rebuild would put it.
+            int expectedProxyRow = 0;
+            for (int srcRow = 0; srcRow < rowProxy.rowCount(); ++srcRow)
+            {
+                const qint64 value =
+                    rowProxy.data(rowProxy.index(srcRow, valueCol), LogModelItemDataRole::SortRole).toLongLong();
+                const QModelIndex mapped = filterModel.mapFromSource(rowProxy.index(srcRow, 0));
+                if (isAccepted(value))
+                {
+                    QCOMPARE(mapped.row(), expectedProxyRow);
+                    QCOMPARE(filterModel.mapToSource(filterModel.index(expectedProxyRow, 0)).row(), srcRow);
+                    ++expectedProxyRow;
+                }
+                else
+                {
+                    QVERIFY(!mapped.isValid());
+                }
+            }
+            QCOMPARE(filterModel.rowCount(), expectedProxyRow);
+        };
+        verifyAgainstSource();
+
+        size_t nextLineId = 21;
+        for (const bool reversed : {false, true})
+        {
+            rowProxy.SetReversed(reversed);
+            verifyAgainstSource();
+            for (int batch = 0; batch < 4; ++batch)
+            {
+                const QSignalSpy insertSpy(&filterModel, &QAbstractItemModel::rowsInserted);
+                model.AppendBatch(
+                    MakeSyntheticBatch(streamSource, keys, valueKey, nextLineId, 10, /*declareNewKey=*/false)
+                );
+                nextLineId += 10;
+                // Unsorted inserts stay one bracket per batch.
+                QVERIFY(insertSpy.count() <= 1);
+                verifyAgainstSource();
+            }
+        }
+        QCOMPARE(model.rowCount(), 100);
+
+        model.EndStreaming(false);
+    }
+
+    // Retention eviction under a filter: the oldest-first cap removes a
+    // source prefix, which the unsorted path applies by advancing the
+    // row maps' bases instead of rewriting every survivor (behind a
+    // reversed `RowOrderProxyModel` it is a suffix instead). After every
+    // evicting batch the proxy must map both ways exactly like a model
+    // rebuilt from scratch over the same source.
+    static void TestFilterModelRetentionEvictionMatchesRebuild()
+    {
+        LogModel model;
+        loglib::StreamLineSource &streamSource = BeginSyntheticStreamSession(model);
+        model.SetRetentionCap(60);
+        RowOrderProxyModel rowProxy;
+        rowProxy.setSourceModel(&model);
+        LogFilterModel filterModel;
+        filterModel.setSourceModel(&rowProxy);
+        filterModel.SetLogModel(&model);
+
+        // `value` cycles through 0..22 out of line order, so rejected
+        // rows are mixed into every evicted prefix and the source and
+        // proxy bases advance by different amounts.
+        loglib::KeyIndex &keys = model.Sink()->Keys();
+        const loglib::KeyId valueKey = keys.GetOrInsert(std::string("value"));
+        size_t nextLineId = 1;
+        const auto appendBatch = [&](size_t count) {
+            loglib::StreamedBatch batch;
+            batch.firstLineNumber = nextLineId;
+            if (nextLineId == 1)
+            {
+                batch.newKeys.emplace_back("value");
+            }
+            for (size_t i = 0; i < count; ++i, ++nextLineId)
+            {
+                streamSource.AppendLine("synthetic line " + std::to_string(nextLineId), std::string{});
+                std::vector<std::pair<loglib::KeyId, loglib::internal::CompactLogValue>> compactValues;
+                compactValues.emplace_back(
+                    valueKey, loglib::internal::CompactLogValue::MakeInt64(static_cast<int64_t>((nextLineId * 37) % 23))
+                );
+                batch.lines.emplace_back(std::move(compactValues), keys, streamSource, nextLineId);
+            }
+            model.AppendBatch(std::move(batch));
+        };
+        appendBatch(60);
+        const int valueCol = ColumnByHeader(model, QStringLiteral("value"));
+        QVERIFY(valueCol >= 0);
+
+        const auto makeRules = [valueCol]() {
+            std::vector<loglib::RowPredicate> rules;
+            rules.emplace_back(
+                std::in_place_type<loglib::NumericRangeRowPredicate>, static_cast<size_t>(valueCol), 6.5, std::nullopt
+            );
+            return rules;
+        };
+        filterModel.SetFilterRules(makeRules());
+
+        const auto verifyAgainstRebuild = [&]() {
+            LogFilterModel rebuilt;
+            rebuilt.setSourceModel(&rowProxy);
+            rebuilt.SetLogModel(&model);
+            rebuilt.SetFilterRules(makeRules());
+
+            QCOMPARE(filterModel.rowCount(), rebuilt.rowCount());
+            for (int proxyRow = 0; proxyRow < rebuilt.rowCount(); ++proxyRow)
+            {
+                QCOMPARE(
+                    filterModel.mapToSource(filterModel.index(proxyRow, 0)).row(),
+                    rebuilt.mapToSource(rebuilt.index(proxyRow, 0)).row()
+                );
+            }
+            for (int srcRow = 0; srcRow < rowProxy.rowCount(); ++srcRow)
+            {
+                const QModelIndex source = rowProxy.index(srcRow, 0);
+                QCOMPARE(filterModel.mapFromSource(source).row(), rebuilt.mapFromSource(source).row());
+            }
+            // Rows past the shrunken source never map.
+            QVERIFY(!filterModel.mapFromSource(rowProxy.index(rowProxy.rowCount(), 0)).isValid());
+        };
+        verifyAgainstRebuild();
+
+        for (const bool reversed : {false, true})
+        {
+            rowProxy.SetReversed(reversed);
+            verifyAgainstRebuild();
+            // Enough evictions that the dropped slots are reclaimed
+            // more than once.
+            for (int batch = 0; batch < 12; ++batch)
+            {
+                const QSignalSpy removeSpy(&filterModel, &QAbstractItemModel::rowsRemoved);
+                appendBatch(batch % 2 == 0 ? 7 : 25);
+                QVERIFY(removeSpy.count() <= 1);
+                QCOMPARE(model.rowCount(), 60);
+                verifyAgainstRebuild();
+            }
+        }
+
+        model.EndStreaming(false);
+    }
+
+    // Streaming appends under an active sort: `InsertSortedRows` sorts
+    // each batch once, announces one bracket per run of rows sharing a
+    // slot, and merges the batch into the permutation afterwards. Every
+    // bracket must already read back in sorted order, and after every
+    // batch the proxy must match a full re-sort (ties in ascending
+    // source order), in both sort orders and both row orders.
+    static void TestFilterModelSortedStreamingAppendsMatchResort()
+    {
+        LogModel model;
+        loglib::StreamLineSource &streamSource = BeginSyntheticStreamSession(model);
+        RowOrderProxyModel rowProxy;
+        rowProxy.setSourceModel(&model);
+        LogFilterModel filterModel;
+        filterModel.setSourceModel(&rowProxy);
+        filterModel.SetLogModel(&model);
+
+        // `value` cycles through 0..22 out of line order, so every batch
+        // scatters across the sorted rows and lands on ties.
+        loglib::KeyIndex &keys = model.Sink()->Keys();
+        const loglib::KeyId valueKey = keys.GetOrInsert(std::string("value"));
+        size_t nextLineId = 1;
+        const auto appendBatch = [&](size_t count) {
+            loglib::StreamedBatch batch;
+            batch.firstLineNumber = nextLineId;
+            if (nextLineId == 1)
+            {
+                batch.newKeys.emplace_back("value");
+            }
+            for (size_t i = 0; i < count; ++i, ++nextLineId)
+            {
+                streamSource.AppendLine("synthetic line " + std::to_string(nextLineId), std::string{});
+                std::vector<std::pair<loglib::KeyId, loglib::internal::CompactLogValue>> compactValues;
+                compactValues.emplace_back(
+                    valueKey, loglib::internal::CompactLogValue::MakeInt64(static_cast<int64_t>((nextLineId * 37) % 23))
+                );
+                batch.lines.emplace_back(std::move(compactValues), keys, streamSource, nextLineId);
+            }
+            model.AppendBatch(std::move(batch));
+        };
+        appendBatch(30);
+        const int valueCol = ColumnByHeader(model, QStringLiteral("value"));
+        QVERIFY(valueCol >= 0);
+
+        // value >= 3, so rejected rows are mixed into every batch.
+        std::vector<loglib::RowPredicate> rules;
+        rules.emplace_back(
+            std::in_place_type<loglib::NumericRangeRowPredicate>, static_cast<size_t>(valueCol), 2.5, std::nullopt
+        );
+        filterModel.SetFilterRules(std::move(rules));
+
+        Qt::SortOrder order = Qt::AscendingOrder;
+        const auto valueAt = [&](int proxyRow) {
+            return filterModel.data(filterModel.index(proxyRow, valueCol), LogModelItemDataRole::SortRole).toLongLong();
+        };
+        const auto inOrder = [&](qint64 lhs, qint64 rhs) {
+            return order == Qt::AscendingOrder ? lhs <= rhs : lhs >= rhs;
+        };
+        const auto verifyAgainstResort = [&]() {
+            std::vector<std::pair<qint64, int>> expected;
+            for (int srcRow = 0; srcRow < rowProxy.rowCount(); ++srcRow)
+            {
+                const qint64 value =
+                    rowProxy.data(rowProxy.index(srcRow, valueCol), LogModelItemDataRole::SortRole).toLongLong();
+                if (value >= 3)
+                {
+                    expected.emplace_back(value, srcRow);
+                }
+            }
+            std::ranges::stable_sort(expected, [&](const auto &lhs, const auto &rhs) {
+                return lhs.first != rhs.first && inOrder(lhs.first, rhs.first);
+            });
+            QCOMPARE(filterModel.rowCount(), static_cast<int>(expected.size()));
+            for (int proxyRow = 0; proxyRow < filterModel.rowCount(); ++proxyRow)
+            {
+                const int srcRow = expected[static_cast<size_t>(proxyRow)].second;
+                QCOMPARE(filterModel.mapToSource(filterModel.index(proxyRow, 0)).row(), srcRow);
+                QCOMPARE(filterModel.mapFromSource(rowProxy.index(srcRow, 0)).row(), proxyRow);
+            }
+        };
+
+        // Mid-merge, each bracket grows the model by its own row count
+        // and the rows around it already read back sorted.
+        int rowsBeforeInsert = 0;
+        int insertBrackets = 0;
+        QObject::connect(&filterModel, &QAbstractItemModel::rowsAboutToBeInserted, &filterModel, [&]() {
+            rowsBeforeInsert = filterModel.rowCount();
+        });
+        QObject::connect(
+            &filterModel,
+            &QAbstractItemModel::rowsInserted,
+            &filterModel,
+            [&](const QModelIndex & /*parent*/, int first, int last) {
+                ++insertBrackets;
+                QCOMPARE(filterModel.rowCount(), rowsBeforeInsert + last - first + 1);
+                const int checkEnd = std::min(last + 1, filterModel.rowCount() - 1);
+                for (int proxyRow = std::max(first, 1); proxyRow <= checkEnd; ++proxyRow)
+                {
+                    QVERIFY(inOrder(valueAt(proxyRow - 1), valueAt(proxyRow)));
+                }
+            }
+        );
+
+        for (const bool reversed : {false, true})
+        {
+            rowProxy.SetReversed(reversed);
+            for (const Qt::SortOrder sortOrder : {Qt::AscendingOrder, Qt::DescendingOrder})
+            {
+                order = sortOrder;
+                filterModel.sort(valueCol, order);
+                verifyAgainstResort();
+                for (int batch = 0; batch < 2; ++batch)
+                {
+                    insertBrackets = 0;
+                    appendBatch(25);
+                    // 25 scattered rows cannot all share one slot.
+                    QVERIFY(insertBrackets > 1);
+                    verifyAgainstResort();
+                }
+            }
+        }
+        QCOMPARE(model.rowCount(), 230);
+
+        model.EndStreaming(false);
+    }
+
     // Sink Pause/Resume: while paused, `OnBatch` redirects into the paused
     // buffer instead of posting per-batch QueuedConnection lambdas; on
     // Resume the buffer is coalesced into a single batch and posted to
@@ -15760,6 +16069,49 @@ private slots:
         }
     }
 
+    // Promoted enum columns carry a posting index for the filter
+    // path; the dialog reports its size per column and in the summary.
+    void TestDiagnosticsDialogReportsEnumIndexMemory()
+    {
+        const int enumCol = StreamFixtureForColumnTests();
+        QVERIFY2(enumCol >= 0, "category column must exist after streaming");
+        auto *model = mWindow->Model();
+        const loglib::internal::EnumPostingIndex *index = model->Table().EnumIndex(static_cast<size_t>(enumCol));
+        QVERIFY2(index != nullptr, "Promoted enum column must have a live posting index");
+        // NOLINTNEXTLINE(clang-analyzer-core.CallAndMessage): prior QVERIFY2 aborts on null.
+        QCOMPARE(index->Size(), model->Table().RowCount());
+
+        const ConfigurationDiagnosticsDialog dialog(model);
+        const auto *table = dialog.findChild<QTableWidget *>();
+        QVERIFY2(table != nullptr, "Dialog must own a diagnosticsTable widget");
+        // Last column is "Index memory"; sort key is the byte count.
+        // NOLINTNEXTLINE(clang-analyzer-core.CallAndMessage): prior QVERIFY2 aborts on null.
+        const int indexMemoryColumn = table->columnCount() - 1;
+        int enumRow = -1;
+        for (int row = 0; row < table->rowCount(); ++row)
+        {
+            const QTableWidgetItem *headerItem = table->item(row, 0);
+            if (headerItem != nullptr && headerItem->data(Qt::UserRole).toInt() == enumCol)
+            {
+                enumRow = row;
+                break;
+            }
+        }
+        QVERIFY2(enumRow >= 0, "Dialog must include a row for the enum column");
+        const QTableWidgetItem *memoryItem = table->item(enumRow, indexMemoryColumn);
+        QVERIFY(memoryItem != nullptr);
+        // NOLINTNEXTLINE(clang-analyzer-core.CallAndMessage): prior QVERIFY aborts on null.
+        QCOMPARE(memoryItem->data(Qt::UserRole).toULongLong(), static_cast<qulonglong>(index->MemoryBytes()));
+
+        const auto *summary = dialog.findChild<QLabel *>();
+        QVERIFY(summary != nullptr);
+        // NOLINTNEXTLINE(clang-analyzer-core.CallAndMessage): prior QVERIFY aborts on null.
+        QVERIFY2(
+            summary->text().contains(QStringLiteral("Filter indexes")),
+            qPrintable(QStringLiteral("Summary must report index memory; got: %1").arg(summary->text()))
+        );
+    }
+
     // Regression: the mismatched-row highlight must adapt to the
     // active palette. The original fix pinned a pale-pink bg + dark
     // fg which read as a glaringly bright row in Dark themes.
@@ -408,6 +408,22 @@ private slots:
         QVERIFY(std::holds_alternative<loglib::CallbackStringRowPredicate>(*compiled));
     }
 
+    /// String leaves carry the trigrams the full-text index narrows
+    /// by; a needle too short for a trigram carries `All`.
+    void CompileStringLeafCarriesTrigrams()
+    {
+        const std::vector<Column> columns{MakeColumn("msg", "msg", loglib::LogConfiguration::Type::String)};
+        const auto trigramsOf = [&columns](Leaf::Match match, std::string needle) {
+            const auto compiled = CompileLeaf(MakeStringLeaf("msg", match, std::move(needle)), 0, columns, nullptr);
+            return std::get<loglib::CallbackStringRowPredicate>(compiled.value()).Trigrams();
+        };
+        QCOMPARE(trigramsOf(Leaf::Match::Contains, "timeout"), loglib::TrigramQuery::ForLiteral("timeout"));
+        QCOMPARE(trigramsOf(Leaf::Match::Exactly, "timeout"), loglib::TrigramQuery::ForLiteral("timeout"));
+        QCOMPARE(trigramsOf(Leaf::Match::RegularExpression, "time(out)?"), loglib::TrigramQuery::ForLiteral("time"));
+        QVERIFY(!trigramsOf(Leaf::Match::Wildcard, "conn*refused").IsAll());
+        QVERIFY(trigramsOf(Leaf::Match::Contains, "ok").IsAll());
+    }
+
     // ---- CompileExpression: combinator propagation ------------------------
 
     /// An input `And{}` with no children stays match-all -- the
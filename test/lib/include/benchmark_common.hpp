@@ -29,6 +29,7 @@
 #include <functional>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -193,13 +194,16 @@ void RunTimedSamples(const char *label, std::size_t samples, ThroughputInputs th
 struct StructuralBytes
 {
     std::size_t lines = 0;
+    /// Reserved-but-uncarved tails of the `LogFile`'s field slabs; the
+    /// carved part is already in `lines`.
+    std::size_t fieldSlabSlack = 0;
     std::size_t lineOffsets = 0;
     std::size_t ownedStrings = 0;
     std::size_t keyIndex = 0;
 
     std::size_t Total() const noexcept
     {
-        return lines + lineOffsets + ownedStrings + keyIndex;
+        return lines + fieldSlabSlack + lineOffsets + ownedStrings + keyIndex;
     }
 };
 
@@ -222,6 +226,7 @@ inline StructuralBytes ComputeStructuralBytes(const loglib::LogTable &table)
         const loglib::LogFile &file = fileSource->File();
         result.lineOffsets += file.LineOffsetsMemoryBytes();
         result.ownedStrings += file.OwnedStringsMemoryBytes();
+        result.fieldSlabSlack += file.FieldSlabSlackBytes();
     }
     result.keyIndex = data.Keys().EstimatedMemoryBytes();
     return result;
@@ -332,6 +337,8 @@ using ParserStreamFn = std::function<void(
 struct StreamingRunResult
 {
     std::chrono::steady_clock::duration elapsed{};
+    /// `~LogTable` alone: what closing the tab costs the GUI thread.
+    std::chrono::steady_clock::duration teardown{};
     std::chrono::steady_clock::duration appendTotal{};
     std::size_t appendBatches = 0;
     std::size_t appendLines = 0;
@@ -361,7 +368,8 @@ inline StreamingRunResult RunStreamingFlow(
     {
         loglib::LogConfigurationManager configManager;
         configManager.Load(configPath.string());
-        loglib::LogTable table(loglib::LogData{}, std::move(configManager));
+        std::optional<loglib::LogTable> tableHolder(std::in_place, loglib::LogData{}, std::move(configManager));
+        loglib::LogTable &table = *tableHolder;
 
         // Mirror `MainWindow::OpenJsonStreaming`: the parser borrows the
         // same `FileLineSource` the table owns, so Stage C's offsets and
@@ -395,6 +403,10 @@ inline StreamingRunResult RunStreamingFlow(
             result.peakWorkingSetDeltaBytes = peakAfter > peakBefore ? peakAfter - peakBefore : 0;
             result.memoryCaptured = true;
         }
+
+        const auto teardownStart = std::chrono::steady_clock::now();
+        tableHolder.reset();
+        result.teardown = std::chrono::steady_clock::now() - teardownStart;
     }
     result.elapsed = std::chrono::steady_clock::now() - start;
     return result;
@@ -430,6 +442,10 @@ inline void RunStreamingBenchmark(
             "LogTable::AppendBatch wall-time: " << appendMs << " ms over " << warmup.appendBatches << " batches / "
                                                 << warmup.appendLines << " lines (" << per100k << " ms / 100k lines)"
         );
+        WARN(
+            "Close-tab latency (~LogTable): " << std::chrono::duration<double, std::milli>(warmup.teardown).count()
+                                              << " ms for " << expectedRows << " rows"
+        );
 
         if (warmup.memoryCaptured)
         {
@@ -441,9 +457,10 @@ inline void RunStreamingBenchmark(
             const double structuralBytesMiB = static_cast<double>(warmup.structuralBytes.Total()) / MIB;
             const double structuralRatio = bytes == 0 ? 0.0 : structuralBytesMiB / fileBytesMiB;
             WARN(
-                "Structural bytes (lines+offsets+ownedStrings+keys): "
+                "Structural bytes (lines+slabSlack+offsets+ownedStrings+keys): "
                 << structuralBytesMiB << " MiB (" << bytesPerLine << " B/line, "
                 << static_cast<double>(warmup.structuralBytes.lines) / MIB << " MiB lines + "
+                << static_cast<double>(warmup.structuralBytes.fieldSlabSlack) / MIB << " MiB field-slab slack + "
                 << static_cast<double>(warmup.structuralBytes.lineOffsets) / MIB << " MiB offsets + "
                 << static_cast<double>(warmup.structuralBytes.ownedStrings) / MIB << " MiB ownedStrings + "
                 << static_cast<double>(warmup.structuralBytes.keyIndex) / MIB
@@ -8,6 +8,7 @@
 
 #include <loglib/file_line_source.hpp>
 #include <loglib/internal/advanced_parser_options.hpp>
+#include <loglib/internal/byte_classes.hpp>
 #include <loglib/log_parse_sink.hpp>
 #include <loglib/parser_options.hpp>
 #include <loglib/parsers/csv_parser.hpp>
@@ -109,6 +110,10 @@ TEST_CASE("Stream CSV log to LogTable (wide, 200'000 lines)", "[.][benchmark][cs
     const TestLogConfiguration configFile;
     configFile.Write(*configuration);
 
+    // Cell slicing runs on the same runtime-selected block classifier
+    // as logfmt; report which one.
+    WARN("Byte-class kernel: " << internal::ByteClassKernelName());
+
     RunStreamingBenchmark(
         "Stream 200'000 wide CSV log entries to LogTable",
         configFile.GetFilePath(),
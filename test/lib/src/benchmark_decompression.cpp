@@ -1,14 +1,20 @@
 // Decompression benchmark for `DecompressingByteSource`. Measures
 // end-to-end `DecompressingByteSource` + `ParseFile` on a ~500 MiB
-// JSONL fixture per codec vs. the uncompressed baseline.
+// JSONL fixture per codec vs. the uncompressed baseline, and
+// time-to-first-row of the temp-file decode vs. progressive mode, and
+// frame-parallel decode of BGZF / multi-frame zstd vs. one thread.
 // Release-only (see `BENCHMARK_REQUIRES_RELEASE_BUILD`); opt-in via
 // the `[benchmark]` tag (`ctest -L benchmark`).
 
 #include "benchmark_common.hpp"
 #include "common.hpp"
 
+#include <loglib/file_line_source.hpp>
+#include <loglib/internal/buffering_sink.hpp>
 #include <loglib/internal/decompressing_byte_source.hpp>
+#include <loglib/log_file.hpp>
 #include <loglib/parse_file.hpp>
+#include <loglib/parser_options.hpp>
 #include <loglib/parsers/json_parser.hpp>
 
 #include <test_common/log_format.hpp>
@@ -29,8 +35,11 @@
 #include <fstream>
 #include <ios>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
 using bench::ReportThroughput;
 using loglib::JsonParser;
@@ -294,6 +303,82 @@ void CompressToZstd(const std::filesystem::path &input, const std::filesystem::p
     ::ZSTD_freeCCtx(cctx);
 }
 
+// BGZF (`bgzip`): independent gzip members of <= 64 KiB input, each
+// recording its own size in a `BC` extra subfield, then an EOF block.
+void CompressToBgzf(const std::filesystem::path &input, const std::filesystem::path &output)
+{
+    std::ifstream in(input, std::ios::binary);
+    std::ofstream out(output, std::ios::binary);
+    REQUIRE((in.is_open() && out.is_open()));
+
+    constexpr std::size_t BLOCK_INPUT_BYTES = 65280;
+    std::vector<char> inBuf(BLOCK_INPUT_BYTES);
+    std::vector<Bytef> deflated(2 * BLOCK_INPUT_BYTES);
+    auto writeLe = [&out](std::uint32_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i)
+        {
+            out.put(static_cast<char>((value >> (8 * i)) & 0xff));
+        }
+    };
+    auto writeBlock = [&](std::size_t size) {
+        z_stream strm{};
+        REQUIRE(::deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) == Z_OK);
+        strm.next_in = reinterpret_cast<Bytef *>(inBuf.data());
+        strm.avail_in = static_cast<uInt>(size);
+        strm.next_out = deflated.data();
+        strm.avail_out = static_cast<uInt>(deflated.size());
+        REQUIRE(::deflate(&strm, Z_FINISH) == Z_STREAM_END);
+        const std::size_t payload = strm.total_out;
+        ::deflateEnd(&strm);
+
+        const std::array<char, 16> header = {'\x1f', '\x8b', 8, 4, 0, 0, 0, 0, 0, '\xff', 6, 0, 'B', 'C', 2, 0};
+        out.write(header.data(), static_cast<std::streamsize>(header.size()));
+        writeLe(static_cast<std::uint32_t>(18 + payload + 8 - 1), 2);
+        out.write(reinterpret_cast<const char *>(deflated.data()), static_cast<std::streamsize>(payload));
+        const uLong crc = ::crc32(0, reinterpret_cast<const Bytef *>(inBuf.data()), static_cast<uInt>(size));
+        writeLe(static_cast<std::uint32_t>(crc), 4);
+        writeLe(static_cast<std::uint32_t>(size), 4);
+    };
+    while (true)
+    {
+        in.read(inBuf.data(), static_cast<std::streamsize>(inBuf.size()));
+        const auto got = static_cast<std::size_t>(in.gcount());
+        if (got == 0)
+        {
+            break;
+        }
+        writeBlock(got);
+    }
+    writeBlock(0);
+}
+
+// Multi-frame zstd (`pzstd` equivalent): one frame per 4 MiB of input.
+void CompressToZstdFrames(const std::filesystem::path &input, const std::filesystem::path &output)
+{
+    std::ifstream in(input, std::ios::binary);
+    std::ofstream out(output, std::ios::binary);
+    REQUIRE((in.is_open() && out.is_open()));
+
+    constexpr std::size_t FRAME_INPUT_BYTES = std::size_t{4} << 20;
+    ZSTD_CCtx *cctx = ::ZSTD_createCCtx();
+    REQUIRE(cctx != nullptr);
+    std::vector<char> inBuf(FRAME_INPUT_BYTES);
+    std::vector<char> outBuf(::ZSTD_compressBound(FRAME_INPUT_BYTES));
+    while (true)
+    {
+        in.read(inBuf.data(), static_cast<std::streamsize>(inBuf.size()));
+        const auto got = static_cast<std::size_t>(in.gcount());
+        if (got == 0)
+        {
+            break;
+        }
+        const std::size_t written = ::ZSTD_compress2(cctx, outBuf.data(), outBuf.size(), inBuf.data(), got);
+        REQUIRE(!::ZSTD_isError(written));
+        out.write(outBuf.data(), static_cast<std::streamsize>(written));
+    }
+    ::ZSTD_freeCCtx(cctx);
+}
+
 // -------- benchmark helper --------
 
 struct FixtureLocations
@@ -307,6 +392,9 @@ struct FixtureLocations
     // benchmark history.
     std::filesystem::path xzMt;
     std::filesystem::path zstd;
+    // Independently decodable frames for the frame-parallel decoder.
+    std::filesystem::path bgzf;
+    std::filesystem::path zstdFrames;
 };
 
 FixtureLocations BuildFixtures()
@@ -318,6 +406,8 @@ FixtureLocations BuildFixtures()
     paths.xz = BenchScratchPath(".jsonl.xz");
     paths.xzMt = BenchScratchPath(".jsonl.mt.xz");
     paths.zstd = BenchScratchPath(".jsonl.zst");
+    paths.bgzf = BenchScratchPath(".jsonl.bgzf.gz");
+    paths.zstdFrames = BenchScratchPath(".jsonl.frames.zst");
 
     // Regenerate the uncompressed fixture on first entry so on-disk
     // size is deterministic across CI hosts. Held in a function-local
@@ -354,9 +444,31 @@ FixtureLocations BuildFixtures()
     ensureCompressed(paths.uncompressed, paths.xz, &CompressToXz);
     ensureCompressed(paths.uncompressed, paths.xzMt, &CompressToXzMt);
     ensureCompressed(paths.uncompressed, paths.zstd, &CompressToZstd);
+    ensureCompressed(paths.uncompressed, paths.bgzf, &CompressToBgzf);
+    ensureCompressed(paths.uncompressed, paths.zstdFrames, &CompressToZstdFrames);
     return paths;
 }
 
+/// Decode only (temp-file path) with @p decodeThreads, recording or
+/// using gzip seek indexes in @p seekIndexDir when set; reports MB/s
+/// of decoded output.
+void TimeDecodeAndReport(
+    const char *label,
+    const std::filesystem::path &path,
+    unsigned decodeThreads,
+    const std::filesystem::path &seekIndexDir = {}
+)
+{
+    DecompressingByteSource::Options options;
+    options.decodeThreads = decodeThreads;
+    options.seekIndexDir = seekIndexDir;
+    const auto start = std::chrono::steady_clock::now();
+    const DecompressingByteSource dbs(path, {}, {}, options);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    REQUIRE(dbs.WasDecompressed());
+    ReportThroughput(label, elapsed, dbs.DecompressedSize(), BENCH_LINE_COUNT);
+}
+
 std::size_t TimeAndReport(const char *label, const std::filesystem::path &path, bool decompressFirst)
 {
     const std::size_t bytes = std::filesystem::file_size(path);
@@ -379,6 +491,52 @@ std::size_t TimeAndReport(const char *label, const std::filesystem::path &path,
     return bytes;
 }
 
+/// `BufferingSink` that records when the first rows arrive.
+class FirstRowTimingSink : public loglib::internal::BufferingSink
+{
+public:
+    using BufferingSink::BufferingSink;
+
+    void OnBatch(loglib::StreamedBatch batch) override
+    {
+        if (!firstRow && !batch.lines.empty())
+        {
+            firstRow = std::chrono::steady_clock::now();
+        }
+        BufferingSink::OnBatch(std::move(batch));
+    }
+
+    std::optional<std::chrono::steady_clock::time_point> firstRow;
+};
+
+/// Decode @p path (temp file or progressive) and parse it, reporting
+/// time-to-first-row and total wall time from the start of the decode.
+void TimeFirstRowAndReport(const char *label, const std::filesystem::path &path, bool progressive)
+{
+    const JsonParser parser;
+    const auto start = std::chrono::steady_clock::now();
+    DecompressingByteSource::Options options;
+    options.progressive = progressive;
+    DecompressingByteSource dbs(path, {}, {}, options);
+    REQUIRE(dbs.IsProgressive() == progressive);
+
+    auto logFile = progressive ? std::make_unique<loglib::LogFile>(dbs.ProgressiveBuffer(), dbs.DisplayPath())
+                               : std::make_unique<loglib::LogFile>(dbs.EffectivePath());
+    auto fileSource = std::make_unique<loglib::FileLineSource>(std::move(logFile));
+    loglib::FileLineSource *sourceRaw = fileSource.get();
+    FirstRowTimingSink sink(std::move(fileSource));
+    parser.ParseStreaming(*sourceRaw, sink, loglib::ParserOptions{});
+    const auto end = std::chrono::steady_clock::now();
+
+    REQUIRE(sink.TakeData().Lines().size() == BENCH_LINE_COUNT);
+    REQUIRE(sink.firstRow.has_value());
+    WARN(
+        label << ": first row after "
+              << std::chrono::duration<double, std::milli>(*sink.firstRow - start).count() << " ms, total "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms"
+    );
+}
+
 } // namespace
 
 TEST_CASE("Decompress + parse a 500 MiB JSONL fixture (all codecs)", "[.][benchmark][decompression]")
@@ -407,3 +565,45 @@ TEST_CASE("Decompress + parse a 500 MiB JSONL fixture (all codecs)", "[.][benchm
     TimeAndReport("Decompress + parse (xz, multi-block/MT)", paths.xzMt, true);
     TimeAndReport("Decompress + parse (zstd)", paths.zstd, true);
 }
+
+TEST_CASE("Time to first row: temp-file vs progressive decode", "[.][benchmark][decompression]")
+{
+    BENCHMARK_REQUIRES_RELEASE_BUILD();
+
+    const FixtureLocations paths = BuildFixtures();
+
+    TimeFirstRowAndReport("Temp-file decode + parse (gzip)", paths.gzip, false);
+    TimeFirstRowAndReport("Progressive decode + parse (gzip)", paths.gzip, true);
+    TimeFirstRowAndReport("Temp-file decode + parse (zstd)", paths.zstd, false);
+    TimeFirstRowAndReport("Progressive decode + parse (zstd)", paths.zstd, true);
+}
+
+TEST_CASE("Frame-parallel decode: one thread vs all cores", "[.][benchmark][decompression]")
+{
+    BENCHMARK_REQUIRES_RELEASE_BUILD();
+
+    const FixtureLocations paths = BuildFixtures();
+
+    TimeDecodeAndReport("Decode BGZF gzip, 1 thread", paths.bgzf, 1);
+    TimeDecodeAndReport("Decode BGZF gzip, all cores", paths.bgzf, 0);
+    TimeDecodeAndReport("Decode multi-frame zstd, 1 thread", paths.zstdFrames, 1);
+    TimeDecodeAndReport("Decode multi-frame zstd, all cores", paths.zstdFrames, 0);
+    // Single-member gzip has no frame boundaries; stays serial.
+    TimeDecodeAndReport("Decode single-member gzip, all cores", paths.gzip, 0);
+}
+
+TEST_CASE("Gzip reopen: first open vs seek-indexed reopen", "[.][benchmark][decompression]")
+{
+    BENCHMARK_REQUIRES_RELEASE_BUILD();
+
+    const FixtureLocations paths = BuildFixtures();
+    const std::filesystem::path seekIndexDir = BenchScratchPath("_seek_index");
+    std::error_code ec;
+    std::filesystem::remove_all(seekIndexDir, ec);
+
+    // The first open decodes serially and records the index; the
+    // reopen decodes the spans between its points on all cores.
+    TimeDecodeAndReport("Decode single-member gzip, first open", paths.gzip, 0, seekIndexDir);
+    TimeDecodeAndReport("Decode single-member gzip, indexed reopen", paths.gzip, 0, seekIndexDir);
+    std::filesystem::remove_all(seekIndexDir, ec);
+}
@@ -9,9 +9,11 @@
 #include <loglib/enum_dictionary.hpp>
 #include <loglib/file_line_source.hpp>
 #include <loglib/internal/advanced_parser_options.hpp>
+#include <loglib/internal/row_shape.hpp>
 #include <loglib/key_index.hpp>
 #include <loglib/log_file.hpp>
 #include <loglib/log_line.hpp>
+#include <loglib/log_line_store.hpp>
 #include <loglib/log_parser.hpp>
 #include <loglib/log_table.hpp>
 #include <loglib/log_value.hpp>
@@ -173,7 +175,7 @@ TEST_CASE("LogLine::GetValue micro-benchmark", "[.][benchmark][log_line][get_val
     ParseResult result = ParseFile(parser, testFile.GetFilePath());
     REQUIRE(result.errors.empty());
     const LogData &data = result.data;
-    const std::vector<LogLine> &lines = data.Lines();
+    const LogLineStore &lines = data.Lines();
     REQUIRE(!lines.empty());
 
     const std::array<std::string, 5> kKeys = {"timestamp", "level", "message", "thread_id", "component"};
@@ -247,7 +249,7 @@ TEST_CASE("LogLine::GetValue micro-benchmark", "[.][benchmark][log_line][get_val
         {
             source->SetEnumDictionaries(&registry);
         }
-        std::vector<LogLine> &mutLines = mutableData.Lines();
+        LogLineStore &mutLines = mutableData.Lines();
         for (auto &[rowIdx, vid] : rowDictRefs)
         {
             mutLines[rowIdx].SetOrReplaceEnumDictRef(levelKey, vid);
@@ -269,6 +271,68 @@ TEST_CASE("LogLine::GetValue micro-benchmark", "[.][benchmark][log_line][get_val
     (void)hitsSink;
 }
 
+// Wide-row variant: 60 keys per row puts the interned `RowShape` slot
+// lookup against the linear `CompactLineFields` scan it replaced, where
+// the scan cost grows with row width. Every row shares one shape.
+TEST_CASE("LogLine::GetValue micro-benchmark (wide rows)", "[.][benchmark][log_line][get_value_micro][wide]")
+{
+    BENCHMARK_REQUIRES_RELEASE_BUILD();
+
+    const TestStructuredLogFile testFile(GenerateWideLogRecords(10'000, /*columnCount=*/60), test_common::JsonLines());
+    const JsonParser parser;
+
+    ParseResult result = ParseFile(parser, testFile.GetFilePath());
+    REQUIRE(result.errors.empty());
+    const LogData &data = result.data;
+    const LogLineStore &lines = data.Lines();
+    REQUIRE(!lines.empty());
+
+    std::vector<KeyId> keyIds;
+    for (const auto &entry : lines.front().CompactValues())
+    {
+        keyIds.push_back(entry.first);
+    }
+    REQUIRE(keyIds.size() >= 60);
+
+    volatile size_t hitsSink = 0;
+
+    RunTimedSamples("CompactValues linear scan (reference)", 11, [&]() {
+        size_t hits = 0;
+        for (const LogLine &line : lines)
+        {
+            const auto fields = line.CompactValues();
+            for (const KeyId id : keyIds)
+            {
+                const auto it = std::ranges::find_if(fields, [id](const auto &entry) { return entry.first == id; });
+                if (it != fields.end())
+                {
+                    ++hits;
+                }
+            }
+        }
+        hitsSink = hits;
+    });
+
+    RunTimedSamples("LogLine::GetValue(KeyId) — shaped rows", 11, [&]() {
+        size_t hits = 0;
+        for (const LogLine &line : lines)
+        {
+            for (const KeyId id : keyIds)
+            {
+                if (!std::holds_alternative<std::monostate>(line.GetValue(id)))
+                {
+                    ++hits;
+                }
+            }
+        }
+        hitsSink = hits;
+    });
+
+    WARN("Row shapes interned: " << data.Keys().Shapes().Size() << " across " << lines.size() << " rows");
+
+    (void)hitsSink;
+}
+
 // Allocation footprint and `string_view` fast-path fraction. We don't
 // override global `operator new` (interacts badly with Catch2 reporting
 // and TBB workers); instead we count the observable structural cost of
@@ -346,6 +410,25 @@ TEST_CASE("Allocation footprint and string_view fast-path fraction", "[.][benchm
                                      << "/line)"
     );
 
+    // Per-row resident bytes: the `LogLine` itself plus its field block.
+    // Rows with an interned `RowShape` store bare 16 B values; the
+    // per-row-KeyId layout they replace costs a 24 B pair per field.
+    size_t rowBytes = result.data.Keys().Shapes().MemoryBytes();
+    size_t keyedRowBytes = 0;
+    for (const LogLine &line : result.data.Lines())
+    {
+        rowBytes += sizeof(LogLine) + line.OwnedMemoryBytes();
+        keyedRowBytes += sizeof(LogLine) + (line.ValueCount() * sizeof(std::pair<KeyId, internal::CompactLogValue>));
+    }
+    WARN(
+        "Row footprint: " << (static_cast<double>(rowBytes) / static_cast<double>(lineCount)) << " B/row across "
+                          << result.data.Keys().Shapes().Size() << " row shape(s) vs "
+                          << (static_cast<double>(keyedRowBytes) / static_cast<double>(lineCount))
+                          << " B/row with per-row KeyIds ("
+                          << (100.0 - (100.0 * static_cast<double>(rowBytes) / static_cast<double>(keyedRowBytes)))
+                          << "% smaller)"
+    );
+
     REQUIRE(mmapSliceValues > 0);
 }
 
@@ -30,10 +30,12 @@
 #include <loglib/log_parse_sink.hpp>
 #include <loglib/log_table.hpp>
 #include <loglib/log_value.hpp>
+#include <loglib/trigram_query.hpp>
 
 #include <catch2/catch_all.hpp>
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -197,7 +199,13 @@ LargeTable BuildLargeLevelTable(const TestLogFile &fixture, size_t rowCount)
 /// Build a `Type::String` `LogTable` with @p rowCount rows over a
 /// pool of short message templates. Used by the
 /// `CallbackStringRowPredicate` benchmark below.
-LargeTable BuildLargeStringTable(const TestLogFile &fixture, size_t rowCount)
+/// Unique per-row token for `BuildLargeStringTable(..., true)`.
+std::string TraceId(size_t row)
+{
+    return "trace=" + std::to_string((static_cast<uint64_t>(row) * 0x9E3779B97F4A7C15ULL) >> 24U);
+}
+
+LargeTable BuildLargeStringTable(const TestLogFile &fixture, size_t rowCount, bool withTraceIds = false)
 {
     auto source = std::make_unique<FileLineSource>(std::make_unique<LogFile>(fixture.GetFilePath()));
     FileLineSource *sourcePtr = source.get();
@@ -246,7 +254,14 @@ LargeTable BuildLargeStringTable(const TestLogFile &fixture, size_t rowCount)
         batch.lines.reserve(batchSize);
         for (size_t i = 0; i < batchSize; ++i)
         {
-            batch.lines.push_back(MakeLine(keys, *sourcePtr, {{"msg", std::string(templates[pick(rng)])}}));
+            std::string msg = templates[pick(rng)];
+            if (withTraceIds)
+            {
+                // A token no other row shares, for needles selective
+                // enough to prune.
+                msg += " " + TraceId(base + i);
+            }
+            batch.lines.push_back(MakeLine(keys, *sourcePtr, {{"msg", std::move(msg)}}));
         }
         if (base == 0)
         {
@@ -257,6 +272,92 @@ LargeTable BuildLargeStringTable(const TestLogFile &fixture, size_t rowCount)
     return {.table = std::move(table), .sourceOwner = nullptr};
 }
 
+/// Build a wide mixed-type `LogTable` with @p rowCount rows: a pinned
+/// `Type::Time` column (`ts`), a pinned `Type::Floating` column
+/// (`latency`), a pinned `Type::Boolean` column (`ok`), plus four
+/// string fields ahead of them in `KeyId` order so the row walk has
+/// to step over realistic row widths before reaching a typed slot.
+/// Used by the columnar-storage benchmark below.
+LargeTable BuildLargeScalarTable(const TestLogFile &fixture, size_t rowCount)
+{
+    auto source = std::make_unique<FileLineSource>(std::make_unique<LogFile>(fixture.GetFilePath()));
+    FileLineSource *sourcePtr = source.get();
+
+    LogConfiguration cfg;
+    cfg.columns.push_back(
+        {.header = "ts", .keys = {"ts"}, .printFormat = "{}", .type = LogConfiguration::Type::Time, .parseFormats = {}}
+    );
+    cfg.columns.push_back(
+        {.header = "latency",
+         .keys = {"latency"},
+         .printFormat = "{}",
+         .type = LogConfiguration::Type::Floating,
+         .parseFormats = {}}
+    );
+    cfg.columns.push_back(
+        {.header = "ok",
+         .keys = {"ok"},
+         .printFormat = "{}",
+         .type = LogConfiguration::Type::Boolean,
+         .parseFormats = {}}
+    );
+    const TestLogConfiguration cfgFile;
+    cfgFile.Write(cfg);
+    LogConfigurationManager mgr;
+    mgr.Load(cfgFile.GetFilePath());
+
+    LogTable table({}, std::move(mgr));
+    table.BeginStreaming(std::move(source));
+
+    KeyIndex &keys = table.Keys();
+    // Intern the string fields first so they precede the typed keys
+    // in every row's sorted slot array.
+    const std::vector<std::string> paddingKeys = {"host", "service", "thread", "msg"};
+    for (const auto &key : paddingKeys)
+    {
+        keys.GetOrInsert(key);
+    }
+
+    // NOLINTNEXTLINE(cert-msc32-c, cert-msc51-cpp, bugprone-random-generator-seed)
+    std::mt19937 rng{0x5CA1A3U};
+    std::uniform_real_distribution<double> latency{0.0, 1000.0};
+    std::uniform_int_distribution<int64_t> jitter{0, 999};
+
+    constexpr int64_t BASE_MICROS = 1'700'000'000'000'000;
+    constexpr size_t BATCH = 50'000;
+    for (size_t base = 0; base < rowCount; base += BATCH)
+    {
+        const size_t batchSize = std::min(BATCH, rowCount - base);
+        StreamedBatch batch;
+        batch.firstLineNumber = base + 1;
+        batch.lines.reserve(batchSize);
+        for (size_t i = 0; i < batchSize; ++i)
+        {
+            const auto row = static_cast<int64_t>(base + i);
+            batch.lines.push_back(MakeLine(
+                keys,
+                *sourcePtr,
+                {{"host", std::string("node-7")},
+                 {"service", std::string("ingest")},
+                 {"thread", std::string("worker-3")},
+                 {"msg", std::string("request handled")},
+                 {"ts", TimeStamp{std::chrono::microseconds{BASE_MICROS + (row * 1000) + jitter(rng)}}},
+                 {"latency", latency(rng)},
+                 {"ok", row % 10 != 0}}
+            ));
+        }
+        if (base == 0)
+        {
+            for (const auto &key : paddingKeys)
+            {
+                batch.newKeys.emplace_back(key);
+            }
+        }
+        table.AppendBatch(std::move(batch));
+    }
+    return {.table = std::move(table), .sourceOwner = nullptr};
+}
+
 template <typename Fn> std::chrono::nanoseconds TimeOnce(Fn fn)
 {
     const auto start = std::chrono::steady_clock::now();
@@ -945,3 +1046,333 @@ TEST_CASE(
     // back to visit or the leaf-materialisation lost concurrency.
     CHECK(Ms(low).count() < 200.0);
 }
+
+TEST_CASE(
+    "LogTable columnar storage vs row walk: typed filter and sort over 1'000'000 rows",
+    "[.][benchmark][log_filter][log_compare][columnar][large]"
+)
+{
+    RequireReleaseBuildForBenchmarks();
+
+    constexpr size_t ROW_COUNT = 1'000'000;
+    const TestLogFile fixture("benchmark_log_filter_columnar.json");
+    fixture.Write("");
+    LargeTable owned = BuildLargeScalarTable(fixture, ROW_COUNT);
+    LogTable &table = owned.table;
+    REQUIRE(table.RowCount() == ROW_COUNT);
+    REQUIRE(table.ColumnCount() >= 3);
+
+    // ts in the middle half AND latency under 250 AND ok: three typed
+    // leaves on the visit path, each a per-row slot read.
+    constexpr int64_t BASE_MICROS = 1'700'000'000'000'000;
+    const auto quarter = static_cast<int64_t>(ROW_COUNT / 4) * 1000;
+    std::vector<CompiledFilterExpression> children(3);
+    children[0].node =
+        CompiledFilterExpression::Leaf{TimeRangeRowPredicate(0, BASE_MICROS + quarter, BASE_MICROS + (3 * quarter))};
+    children[1].node = CompiledFilterExpression::Leaf{NumericRangeRowPredicate(1, std::nullopt, 250.0)};
+    children[2].node = CompiledFilterExpression::Leaf{BoolRowPredicate(2, true, false)};
+    CompiledFilterExpression expr;
+    CompiledFilterExpression::And andNode;
+    andNode.children = std::move(children);
+    expr.node = std::move(andNode);
+    expr.referencedColumns = {0, 1, 2};
+
+    std::vector<size_t> logRows(ROW_COUNT);
+    std::iota(logRows.begin(), logRows.end(), size_t{0});
+
+    using Ms = std::chrono::duration<double, std::milli>;
+    constexpr int SAMPLES = 5;
+    struct Timings
+    {
+        std::chrono::nanoseconds filter = std::chrono::nanoseconds::max();
+        std::chrono::nanoseconds sortTime = std::chrono::nanoseconds::max();
+        std::chrono::nanoseconds sortFloating = std::chrono::nanoseconds::max();
+        std::vector<size_t> accepted;
+        std::vector<size_t> permutation;
+    };
+    const auto measure = [&]() {
+        Timings t;
+        for (int s = 0; s < SAMPLES; ++s)
+        {
+            t.filter = std::min(t.filter, TimeOnce([&]() { t.accepted = FilterAcceptedRows(table, expr); }));
+            t.sortTime = std::min(t.sortTime, TimeOnce([&]() {
+                                      t.permutation = SortPermutationByColumn(
+                                          table, std::span<const size_t>{logRows}, size_t{0}, /*ascending=*/false
+                                      );
+                                  }));
+            t.sortFloating = std::min(t.sortFloating, TimeOnce([&]() {
+                                          (void)SortPermutationByColumn(
+                                              table, std::span<const size_t>{logRows}, size_t{1}, /*ascending=*/true
+                                          );
+                                      }));
+        }
+        return t;
+    };
+
+    table.SetColumnarStorage(false);
+    const Timings rowWalk = measure();
+
+    const auto buildElapsed = TimeOnce([&]() { table.SetColumnarStorage(true); });
+    const Timings columnar = measure();
+
+    REQUIRE_FALSE(rowWalk.accepted.empty());
+    CHECK(columnar.accepted == rowWalk.accepted);
+    CHECK(columnar.permutation == rowWalk.permutation);
+
+    WARN(
+        "Columnar mirror over " << ROW_COUNT << " rows x " << table.ColumnCount()
+                                << " columns: build=" << Ms(buildElapsed).count()
+                                << " ms, memory=" << (table.ColumnarMemoryBytes() / (1024 * 1024)) << " MiB"
+    );
+    WARN(
+        "FilterAcceptedRows AND(time, numeric, bool): row walk low="
+            << Ms(rowWalk.filter).count() << " ms, columnar low=" << Ms(columnar.filter).count()
+            << " ms, accepted=" << columnar.accepted.size()
+    );
+    WARN(
+        "SortPermutationByColumn Time desc: row walk low=" << Ms(rowWalk.sortTime).count()
+                                                           << " ms, columnar low=" << Ms(columnar.sortTime).count()
+                                                           << " ms; Floating asc: row walk low="
+                                                           << Ms(rowWalk.sortFloating).count() << " ms, columnar low="
+                                                           << Ms(columnar.sortFloating).count() << " ms"
+    );
+
+    // Both paths share the typed-key sort, so only the key extraction
+    // differs; the filter is where the dense read should win outright.
+    // Generous ceiling so CI noise doesn't flap: the columnar filter
+    // must at least not regress against the row walk.
+    CHECK(Ms(columnar.filter).count() <= Ms(rowWalk.filter).count() * 1.25);
+}
+
+TEST_CASE(
+    "LogTable enum index vs scan: enum filters over 1'000'000 rows",
+    "[.][benchmark][log_filter][enum_index][large]"
+)
+{
+    RequireReleaseBuildForBenchmarks();
+
+    constexpr size_t ROW_COUNT = 1'000'000;
+    const TestLogFile fixture("benchmark_log_filter_enum_index.json");
+    fixture.Write("");
+    LargeTable owned = BuildLargeEnumTable(fixture, ROW_COUNT, "region");
+    LogTable &table = owned.table;
+    REQUIRE(table.RowCount() == ROW_COUNT);
+
+    // One value (~25% of rows) and two values (~50%, two posting lists
+    // merged) as bare leaves; the `And` narrows by the smaller leaf.
+    std::vector<CompiledFilterExpression> expressions;
+    expressions.push_back(MakeEnumLeaf(table, 0, {"warn"}));
+    expressions.push_back(MakeEnumLeaf(table, 0, {"warn", "error"}));
+    {
+        CompiledFilterExpression::And andNode;
+        andNode.children.push_back(MakeEnumLeaf(table, 0, {"warn", "error", "debug"}));
+        andNode.children.push_back(MakeEnumLeaf(table, 0, {"warn"}));
+        expressions.emplace_back().node = std::move(andNode);
+    }
+    const std::array<const char *, 3> labels = {"leaf(1 value)", "leaf(2 values)", "AND(3 values, 1 value)"};
+
+    using Ms = std::chrono::duration<double, std::milli>;
+    constexpr int SAMPLES = 5;
+    const auto measure = [&](const CompiledFilterExpression &expr, std::vector<size_t> &accepted) {
+        auto low = std::chrono::nanoseconds::max();
+        for (int s = 0; s < SAMPLES; ++s)
+        {
+            low = std::min(low, TimeOnce([&]() { accepted = FilterAcceptedRows(table, expr); }));
+        }
+        return low;
+    };
+
+    std::vector<std::vector<size_t>> scanned(expressions.size());
+    std::vector<std::chrono::nanoseconds> scanTimes;
+    table.SetEnumIndexes(false);
+    for (size_t i = 0; i < expressions.size(); ++i)
+    {
+        scanTimes.push_back(measure(expressions[i], scanned[i]));
+    }
+
+    const auto buildElapsed = TimeOnce([&]() { table.SetEnumIndexes(true); });
+    REQUIRE(table.EnumIndex(0) != nullptr);
+    WARN(
+        "Enum index over " << ROW_COUNT << " rows: build=" << Ms(buildElapsed).count()
+                           << " ms, memory=" << (table.EnumIndexMemoryBytes() / 1024) << " KiB"
+    );
+
+    for (size_t i = 0; i < expressions.size(); ++i)
+    {
+        std::vector<size_t> indexed;
+        const auto indexTime = measure(expressions[i], indexed);
+        REQUIRE_FALSE(scanned[i].empty());
+        CHECK(indexed == scanned[i]);
+        WARN(
+            "FilterAcceptedRows " << labels[i] << ": scan low=" << Ms(scanTimes[i]).count()
+                                  << " ms, index low=" << Ms(indexTime).count()
+                                  << " ms, accepted=" << indexed.size()
+        );
+        // Posting lists skip the per-row predicate entirely; even the
+        // 50% two-list merge must not lose to the scan.
+        CHECK(Ms(indexTime).count() <= Ms(scanTimes[i]).count() * 1.25);
+    }
+}
+
+TEST_CASE(
+    "LogTable zone maps vs row scan: time and numeric range filters over 1'000'000 rows",
+    "[.][benchmark][log_filter][zone_map][large]"
+)
+{
+    RequireReleaseBuildForBenchmarks();
+
+    constexpr size_t ROW_COUNT = 1'000'000;
+    const TestLogFile fixture("benchmark_log_filter_zone_map.json");
+    fixture.Write("");
+    LargeTable owned = BuildLargeScalarTable(fixture, ROW_COUNT);
+    LogTable &table = owned.table;
+    REQUIRE(table.RowCount() == ROW_COUNT);
+
+    // `ts` ascends ~1 ms per row, so a time window maps onto a run of
+    // blocks; `latency` is uniform noise, so its ranges prune nothing
+    // and show the block walk's overhead instead.
+    constexpr int64_t BASE_MICROS = 1'700'000'000'000'000;
+    const auto percent = static_cast<int64_t>(ROW_COUNT / 100) * 1000;
+    const auto timeLeaf = [](int64_t begin, int64_t end) {
+        CompiledFilterExpression expr;
+        expr.node = CompiledFilterExpression::Leaf{TimeRangeRowPredicate(0, BASE_MICROS + begin, BASE_MICROS + end)};
+        return expr;
+    };
+    std::vector<CompiledFilterExpression> expressions;
+    expressions.push_back(timeLeaf(50 * percent, 51 * percent));
+    expressions.push_back(timeLeaf(10 * percent, 90 * percent));
+    expressions.emplace_back().node = CompiledFilterExpression::Leaf{NumericRangeRowPredicate(1, 990.0, std::nullopt)};
+    {
+        CompiledFilterExpression::And andNode;
+        andNode.children.push_back(timeLeaf(40 * percent, 50 * percent));
+        andNode.children.emplace_back().node =
+            CompiledFilterExpression::Leaf{NumericRangeRowPredicate(1, std::nullopt, 100.0)};
+        expressions.emplace_back().node = std::move(andNode);
+    }
+    const std::array<const char *, 4> labels = {
+        "time(1% window)", "time(80% window)", "latency(>= 990)", "AND(time 10%, latency <= 100)"
+    };
+
+    using Ms = std::chrono::duration<double, std::milli>;
+    constexpr int SAMPLES = 5;
+    const auto measure = [&](const CompiledFilterExpression &expr, std::vector<size_t> &accepted) {
+        auto low = std::chrono::nanoseconds::max();
+        for (int s = 0; s < SAMPLES; ++s)
+        {
+            low = std::min(low, TimeOnce([&]() { accepted = FilterAcceptedRows(table, expr); }));
+        }
+        return low;
+    };
+
+    std::vector<std::vector<size_t>> scanned(expressions.size());
+    std::vector<std::chrono::nanoseconds> scanTimes;
+    table.SetZoneMaps(false);
+    for (size_t i = 0; i < expressions.size(); ++i)
+    {
+        scanTimes.push_back(measure(expressions[i], scanned[i]));
+    }
+
+    const auto buildElapsed = TimeOnce([&]() { table.SetZoneMaps(true); });
+    REQUIRE(table.ColumnZoneMap(0) != nullptr);
+    REQUIRE(table.ColumnZoneMap(1) != nullptr);
+    WARN(
+        "Zone maps over " << ROW_COUNT << " rows: build=" << Ms(buildElapsed).count()
+                          << " ms, memory=" << (table.ZoneMapMemoryBytes() / 1024) << " KiB"
+    );
+
+    for (size_t i = 0; i < expressions.size(); ++i)
+    {
+        std::vector<size_t> zoned;
+        const auto zoneTime = measure(expressions[i], zoned);
+        REQUIRE_FALSE(scanned[i].empty());
+        CHECK(zoned == scanned[i]);
+        WARN(
+            "FilterAcceptedRows " << labels[i] << ": scan low=" << Ms(scanTimes[i]).count()
+                                  << " ms, zone map low=" << Ms(zoneTime).count()
+                                  << " ms, accepted=" << zoned.size()
+        );
+        // Unprunable ranges fall back to the per-row check block by
+        // block; that must stay within noise of the plain scan.
+        CHECK(Ms(zoneTime).count() <= Ms(scanTimes[i]).count() * 1.25);
+    }
+}
+
+TEST_CASE(
+    "LogTable trigram index vs row scan: substring and regex find over 1'000'000 rows",
+    "[.][benchmark][log_filter][trigram_index][large]"
+)
+{
+    RequireReleaseBuildForBenchmarks();
+
+    constexpr size_t ROW_COUNT = 1'000'000;
+    const TestLogFile fixture("benchmark_log_filter_trigram_index.json");
+    fixture.Write("");
+    LargeTable owned = BuildLargeStringTable(fixture, ROW_COUNT, true);
+    LogTable &table = owned.table;
+    REQUIRE(table.RowCount() == ROW_COUNT);
+
+    // A unique trace id and a rare regex prune to a few granules;
+    // "user-id" sits in three of the seven templates, so it prunes
+    // nothing and shows the candidate walk's overhead instead.
+    const auto leaf = [](TrigramQuery query, CallbackStringRowPredicate::MatchFn match) {
+        CallbackStringRowPredicate predicate(0, std::move(match));
+        predicate.SetTrigrams(std::move(query));
+        CompiledFilterExpression expr;
+        expr.node = CompiledFilterExpression::Leaf{std::move(predicate)};
+        return expr;
+    };
+    const auto containsLeaf = [&leaf](const std::string &needle) {
+        // NOLINTNEXTLINE(bugprone-exception-escape)
+        return leaf(TrigramQuery::ForLiteral(needle), [needle](std::string_view slot) {
+            return slot.contains(needle);
+        });
+    };
+    std::vector<CompiledFilterExpression> expressions;
+    expressions.push_back(containsLeaf(TraceId(ROW_COUNT / 2)));
+    expressions.push_back(containsLeaf("user-id"));
+    // `user-id=17 .*trace=12`, hand-matched.
+    expressions.push_back(leaf(TrigramQuery::ForRegex("user-id=17 .*trace=12"), [](std::string_view slot) {
+        const size_t at = slot.find("user-id=17 ");
+        return at != std::string_view::npos && slot.find("trace=12", at) != std::string_view::npos;
+    }));
+    const std::array<const char *, 3> labels = {
+        "contains(trace id)", "contains(user-id)", "regex(user-id=17 .*trace=12)"
+    };
+
+    using Ms = std::chrono::duration<double, std::milli>;
+    constexpr int SAMPLES = 5;
+    const auto measure = [&](const CompiledFilterExpression &expr, std::vector<size_t> &accepted) {
+        auto low = std::chrono::nanoseconds::max();
+        for (int s = 0; s < SAMPLES; ++s)
+        {
+            low = std::min(low, TimeOnce([&]() { accepted = FilterAcceptedRows(table, expr); }));
+        }
+        return low;
+    };
+
+    std::vector<std::vector<size_t>> scanned(expressions.size());
+    std::vector<std::chrono::nanoseconds> scanTimes;
+    for (size_t i = 0; i < expressions.size(); ++i)
+    {
+        scanTimes.push_back(measure(expressions[i], scanned[i]));
+    }
+
+    const auto buildElapsed = TimeOnce([&]() { table.SetTrigramIndex(true); });
+    WARN(
+        "Trigram index over " << ROW_COUNT << " rows: build=" << Ms(buildElapsed).count()
+                              << " ms, memory=" << (table.TrigramIndexMemoryBytes() / 1024) << " KiB"
+    );
+
+    for (size_t i = 0; i < expressions.size(); ++i)
+    {
+        std::vector<size_t> indexed;
+        const auto indexTime = measure(expressions[i], indexed);
+        REQUIRE_FALSE(scanned[i].empty());
+        CHECK(indexed == scanned[i]);
+        WARN(
+            "FilterAcceptedRows " << labels[i] << ": scan low=" << Ms(scanTimes[i]).count()
+                                  << " ms, trigram index low=" << Ms(indexTime).count()
+                                  << " ms, accepted=" << indexed.size()
+        );
+    }
+}
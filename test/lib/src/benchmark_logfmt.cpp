@@ -9,6 +9,7 @@
 
 #include <loglib/file_line_source.hpp>
 #include <loglib/internal/advanced_parser_options.hpp>
+#include <loglib/internal/byte_classes.hpp>
 #include <loglib/log_parse_sink.hpp>
 #include <loglib/parser_options.hpp>
 #include <loglib/parsers/logfmt_parser.hpp>
@@ -61,6 +62,10 @@ TEST_CASE("Stream logfmt log to LogTable (1'000'000 lines)", "[.][benchmark][log
     const TestLogConfiguration configFile;
     configFile.Write(*configuration);
 
+    // The tokenizer's block classifier is picked at runtime; name it so
+    // numbers from different machines are comparable.
+    WARN("Byte-class kernel: " << internal::ByteClassKernelName());
+
     RunStreamingBenchmark(
         "Stream 1'000'000 logfmt log entries to LogTable",
         configFile.GetFilePath(),
@@ -0,0 +1,124 @@
+// TCP ingest throughput benchmark for `TcpServerProducer`. A client
+// thread pushes ~512 MiB of JSON lines over loopback as fast as the
+// socket allows while the parser-side consumer drains the producer,
+// once through the zero-copy `BorrowBytes` path and once through the
+// copying `Read` path. Reports MB/s, lines/s and dropped bytes.
+// Release-only (see `BENCHMARK_REQUIRES_RELEASE_BUILD`); opt-in via
+// the `[benchmark]` tag (`ctest -L benchmark`).
+
+#include "benchmark_common.hpp"
+
+#include <loglib/tcp_server_producer.hpp>
+
+#include <test_common/network_log_client.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <thread>
+
+using bench::ReportThroughput;
+using loglib::TcpServerProducer;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+constexpr std::size_t TOTAL_BYTES = std::size_t{512} * 1024 * 1024;
+
+/// ~1 MiB of newline-terminated JSON lines, sent repeatedly.
+std::string MakeSendBlock(std::size_t &linesPerBlock)
+{
+    std::string block;
+    linesPerBlock = 0;
+    while (block.size() < std::size_t{1024} * 1024)
+    {
+        block += R"({"ts":"2026-01-01T00:00:00.000Z","level":"info","service":"ingest","msg":"request served","seq":)";
+        block += std::to_string(linesPerBlock);
+        block += "}\n";
+        ++linesPerBlock;
+    }
+    return block;
+}
+
+struct IngestResult
+{
+    std::chrono::nanoseconds elapsed{};
+    std::size_t bytes = 0;
+    std::size_t lines = 0;
+    std::size_t dropped = 0;
+};
+
+/// Send `TOTAL_BYTES` to a fresh producer and drain it with @p drain,
+/// which returns the bytes it consumed in one step (0 when empty).
+template <class Drain> IngestResult RunIngest(Drain drain)
+{
+    TcpServerProducer::Options options;
+    options.bindAddress = "127.0.0.1";
+    TcpServerProducer producer(options);
+
+    std::size_t linesPerBlock = 0;
+    const std::string block = MakeSendBlock(linesPerBlock);
+    const std::size_t blocks = TOTAL_BYTES / block.size();
+    const std::size_t sentBytes = blocks * block.size();
+
+    IngestResult result;
+    const auto start = std::chrono::steady_clock::now();
+    std::thread client([&]() {
+        test_common::TcpLogClient sender("127.0.0.1", producer.BoundPort());
+        for (std::size_t i = 0; i < blocks; ++i)
+        {
+            sender.SendRaw(block);
+        }
+        sender.Close();
+    });
+
+    const auto deadline = start + 120s;
+    while (result.bytes + producer.DroppedByteCount() < sentBytes && std::chrono::steady_clock::now() < deadline)
+    {
+        const std::size_t consumed = drain(producer, result.lines);
+        if (consumed == 0)
+        {
+            producer.WaitForBytes(10ms);
+        }
+        result.bytes += consumed;
+    }
+    result.elapsed = std::chrono::steady_clock::now() - start;
+    client.join();
+    result.dropped = producer.DroppedByteCount();
+    CHECK(result.bytes + result.dropped == sentBytes);
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("TCP ingest throughput (borrowed vs copied reads)", "[.][benchmark][tcp_ingest]")
+{
+    BENCHMARK_REQUIRES_RELEASE_BUILD();
+
+    const IngestResult borrowed = RunIngest([](TcpServerProducer &producer, std::size_t &lines) -> std::size_t {
+        const std::span<const char> bytes = producer.BorrowBytes(std::size_t{64} * 1024);
+        lines += static_cast<std::size_t>(std::count(bytes.begin(), bytes.end(), '\n'));
+        producer.ReleaseBorrowedBytes();
+        return bytes.size();
+    });
+    ReportThroughput("TCP ingest (BorrowBytes)", borrowed.elapsed, borrowed.bytes, borrowed.lines);
+
+    std::array<char, 64 * 1024> buffer{};
+    const IngestResult copied = RunIngest([&buffer](TcpServerProducer &producer, std::size_t &lines) -> std::size_t {
+        const std::size_t read = producer.Read(std::span<char>(buffer));
+        lines += static_cast<std::size_t>(std::count(buffer.begin(), buffer.begin() + read, '\n'));
+        return read;
+    });
+    ReportThroughput("TCP ingest (Read)", copied.elapsed, copied.bytes, copied.lines);
+
+    WARN(
+        "[tcp_ingest] dropped bytes under back-pressure: BorrowBytes = " << borrowed.dropped
+                                                                         << ", Read = " << copied.dropped
+    );
+}
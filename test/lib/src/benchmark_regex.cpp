@@ -27,12 +27,14 @@
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 #include <cstddef>
 #include <filesystem>
 #include <memory>
 #include <span>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 using namespace loglib;
@@ -50,13 +52,18 @@ namespace
 /// captures a reference that outlives every `RunStreamingFlow`
 /// sample. Registry storage is process-lifetime, but a defensive
 /// owned copy keeps the closure state-free.
+///
+/// @p patternSuffix is appended to the template's pattern; `(?:)`
+/// keeps the match semantics but takes the pattern off the built-in
+/// decoder table, which measures the plain PCRE2 path for comparison.
 void RunRegexTemplateBenchmark(
     std::string_view templateName,
     test_common::LogFormat (*factory)(),
     const char *label,
     const std::filesystem::path &logPath,
     std::size_t lines,
-    std::size_t samples
+    std::size_t samples,
+    std::string_view patternSuffix = {}
 )
 {
     BENCHMARK_REQUIRES_RELEASE_BUILD();
@@ -65,7 +72,7 @@ void RunRegexTemplateBenchmark(
     REQUIRE(tmpl != nullptr);
     // Owned copy: the closure captures by reference; this string
     // outlives every `RegexParser::ParseStreaming` invocation.
-    const std::string pattern{tmpl->pattern};
+    const std::string pattern = std::string(tmpl->pattern).append(patternSuffix);
 
     const test_common::TimestampPolicy timestamps = DeterministicBenchmarkTimestamps();
 
@@ -107,7 +114,9 @@ constexpr std::size_t REGEX_BENCH_SAMPLES = 4;
 
 } // namespace
 
-TEST_CASE("Stream Syslog (RFC3164) log to LogTable (1'000'000 lines)", "[.][benchmark][regex_parser][large]")
+TEST_CASE(
+    "Stream Syslog (RFC3164) log to LogTable (1'000'000 lines)", "[.][benchmark][regex_parser][large][builtin_decoder]"
+)
 {
     RunRegexTemplateBenchmark(
         "Syslog (RFC3164)",
@@ -119,6 +128,24 @@ TEST_CASE("Stream Syslog (RFC3164) log to LogTable (1'000'000 lines)", "[.][benc
     );
 }
 
+TEST_CASE(
+    "Stream Syslog (RFC3164) log through PCRE2 only to LogTable (1'000'000 lines)",
+    "[.][benchmark][regex_parser][large][builtin_decoder]"
+)
+{
+    // Baseline for the case above: same fixture, pattern kept off the
+    // built-in decoder table.
+    RunRegexTemplateBenchmark(
+        "Syslog (RFC3164)",
+        &test_common::SyslogRfc3164Format,
+        "Stream 1'000'000 Syslog (RFC3164) entries to LogTable (PCRE2 only)",
+        "bench_regex_syslog_pcre2.log",
+        REGEX_BENCH_LINES,
+        REGEX_BENCH_SAMPLES,
+        "(?:)"
+    );
+}
+
 TEST_CASE(
     "Stream Apache/nginx Combined Log Format log to LogTable (1'000'000 lines)", "[.][benchmark][regex_parser][large]"
 )
@@ -529,3 +556,69 @@ TEST_CASE(
     // at 1.040-1.121x across six back-to-back local runs).
     CHECK(bestRatio >= 1.03);
 }
+
+TEST_CASE("Auto-detect probe across 100 user templates", "[.][benchmark][regex_parser][auto_detect]")
+{
+    BENCHMARK_REQUIRES_RELEASE_BUILD();
+
+    // A large user registry: a third of the templates share the `ID `
+    // prefix (they all survive the first-byte prefilter and exercise
+    // the parallel match), the rest start with distinct literals the
+    // prefilter drops. The matching template is the last one probed.
+    constexpr int TEMPLATE_COUNT = 100;
+    constexpr int CALLS = 2'000;
+    std::vector<RegexTemplate> extras;
+    extras.reserve(TEMPLATE_COUNT);
+    for (int i = 0; i < TEMPLATE_COUNT; ++i)
+    {
+        const bool winner = i == TEMPLATE_COUNT - 1;
+        std::string pattern = i % 3 == 0 || winner ? std::string("^ID ")
+                                                   : std::string("^K").append(std::to_string(i)).append(" ");
+        pattern.append(winner ? std::string(R"((?<tag>T\d+))")
+                              : std::string("(?<tag>X").append(std::to_string(i)).append(")"));
+        pattern.append(R"( (?<level>[A-Z]+) (?<message>.*)$)");
+        extras.push_back(RegexTemplate{
+            .name = std::string("bench-auto-detect-").append(std::to_string(i)),
+            .pattern = std::move(pattern),
+            .sampleLines = {},
+            .autoDetect = true,
+            .priority = loglib::USER_TEMPLATE_DEFAULT_PRIORITY + i,
+            .description = "",
+        });
+    }
+    loglib::SetExtraRegexTemplates(std::span<const RegexTemplate>(extras));
+
+    std::string matching;
+    std::string unmatched;
+    for (int i = 0; i < 8; ++i)
+    {
+        matching.append("ID T").append(std::to_string(i)).append(" INFO request served in 12 ms\n");
+        unmatched.append("ID Y").append(std::to_string(i)).append(" INFO request served in 12 ms\n");
+    }
+    REQUIRE(DetectRegexTemplateFromBytes(matching)->name == extras.back().name);
+    REQUIRE_FALSE(DetectRegexTemplateFromBytes(unmatched).has_value());
+
+    const auto timeCalls = [](const std::string &buffer) {
+        std::size_t detected = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int call = 0; call < CALLS; ++call)
+        {
+            if (DetectRegexTemplateFromBytes(buffer).has_value())
+            {
+                ++detected;
+            }
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::make_pair(std::chrono::duration<double, std::micro>(elapsed).count() / CALLS, detected);
+    };
+    const auto [matchingUs, matchingHits] = timeCalls(matching);
+    const auto [unmatchedUs, unmatchedHits] = timeCalls(unmatched);
+    loglib::SetExtraRegexTemplates({});
+
+    CHECK(matchingHits == static_cast<std::size_t>(CALLS));
+    CHECK(unmatchedHits == 0);
+    WARN(
+        "Auto-detect over " << TEMPLATE_COUNT << " user templates: " << matchingUs << " us/call (last template wins), "
+                            << unmatchedUs << " us/call (no template wins)"
+    );
+}
@@ -0,0 +1,200 @@
+// Static-pipeline scaling and page-cache benchmarks for `loglib`. See CONTRIBUTING.md
+// `## Benchmarking` for the PR-process docs. Debug builds skip these
+// cases automatically — see `BENCHMARK_REQUIRES_RELEASE_BUILD`.
+
+#include "benchmark_common.hpp"
+#include "common.hpp"
+
+#include <loglib/file_line_source.hpp>
+#include <loglib/internal/advanced_parser_options.hpp>
+#include <loglib/internal/buffering_sink.hpp>
+#include <loglib/log_data.hpp>
+#include <loglib/log_file.hpp>
+#include <loglib/parser_options.hpp>
+#include <loglib/parsers/json_parser.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace loglib;
+using namespace bench;
+
+namespace
+{
+
+/// JSON lines whose string values all carry escapes, so every one is
+/// decoded into the owned-string arena and the per-line work after
+/// Stage B (line-id shift, arena rebase) is as large as it gets.
+std::string MakeEscapedJsonLines(std::size_t count)
+{
+    std::string content;
+    content.reserve(count * 200);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const std::string id = std::to_string(i);
+        content.append(R"({"timestamp":"2026-01-01T00:00:00.000","level":"info","msg":"request \"GET /items/)")
+            .append(id)
+            .append(R"(\" served\tin 12 ms","path":"C:\\srv\\app\\)")
+            .append(id)
+            .append(R"(.log","user":"caf\u00e9 \"guest\"","id":)")
+            .append(id)
+            .append("}\n");
+    }
+    return content;
+}
+
+/// Map @p path with @p mapOptions and parse it into a `BufferingSink`;
+/// returns the row count.
+std::size_t ParseStatic(
+    const std::string &path, const internal::AdvancedParserOptions &advanced, LogFile::MapOptions mapOptions = {}
+)
+{
+    auto source = std::make_unique<FileLineSource>(std::make_unique<LogFile>(path, path, mapOptions));
+    FileLineSource *sourcePtr = source.get();
+    internal::BufferingSink sink(std::move(source));
+
+    JsonParser::ParseStreaming(*sourcePtr, sink, ParserOptions{}, advanced);
+    return sink.TakeData().Lines().size();
+}
+
+/// Parse with a pinned worker count and batch size.
+std::size_t ParseWithThreads(const std::string &path, unsigned int threads)
+{
+    internal::AdvancedParserOptions advanced;
+    advanced.threads = threads;
+    advanced.autotune = false;
+    return ParseStatic(path, advanced);
+}
+
+/// Drop @p path's pages from the page cache so the next mapping faults
+/// them in from disk. Linux only; clean pages need no privileges.
+bool EvictFromPageCache(const std::string &path)
+{
+#ifdef __linux__
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    // Write back first: dirty pages would survive `DONTNEED`.
+    const bool evicted = ::fdatasync(fd) == 0 && ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+    ::close(fd);
+    return evicted;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+} // namespace
+
+// Scaling curve of `RunStaticParserPipeline` over 1..32 workers. Only
+// Stage A, the reserve stage and Stage C are serial; the curve flattens
+// where they (or the core count) become the ceiling. Counts above
+// `hardware_concurrency` are still run and show oversubscription.
+TEST_CASE("Static pipeline thread scaling (JSON, escaped strings)", "[.][benchmark][static_pipeline][thread_scaling]")
+{
+    BENCHMARK_REQUIRES_RELEASE_BUILD();
+
+    constexpr std::size_t LINE_COUNT = 1'000'000;
+    const TestLogFile file("benchmark_static_pipeline_scaling.json");
+    file.Write(MakeEscapedJsonLines(LINE_COUNT));
+    const std::size_t bytes = std::filesystem::file_size(file.GetFilePath());
+
+    WARN("Thread scaling on hardware_concurrency=" << std::thread::hardware_concurrency());
+
+    using Ms = std::chrono::duration<double, std::milli>;
+    constexpr std::array<unsigned int, 6> THREAD_COUNTS = {1, 2, 4, 8, 16, 32};
+    double singleThreadLinesPerSec = 0.0;
+    for (const unsigned int threads : THREAD_COUNTS)
+    {
+        REQUIRE(ParseWithThreads(file.GetFilePath(), threads) == LINE_COUNT); // warm-up
+        const SampleStats stats = CollectSamples(3, [&]() {
+            REQUIRE(ParseWithThreads(file.GetFilePath(), threads) == LINE_COUNT);
+        });
+
+        const double seconds = std::chrono::duration<double>(stats.mean).count();
+        const double linesPerSec = seconds == 0.0 ? 0.0 : static_cast<double>(LINE_COUNT) / seconds;
+        const double mbps = seconds == 0.0 ? 0.0 : (static_cast<double>(bytes) / (1024.0 * 1024.0)) / seconds;
+        if (threads == 1)
+        {
+            singleThreadLinesPerSec = linesPerSec;
+        }
+        const double speedup = singleThreadLinesPerSec == 0.0 ? 0.0 : linesPerSec / singleThreadLinesPerSec;
+        WARN(
+            "threads=" << threads << ": " << linesPerSec << " lines/s, " << mbps << " MB/s mean over 3 samples ("
+                       << speedup << "x vs 1 thread, " << Ms(stats.mean).count() << " ms)"
+        );
+    }
+}
+
+// Cold-page-cache parse of a ~190 MB file under each `LogFile::MapOptions`
+// mode. Every sample evicts the file first, so the timed window (map +
+// populate + parse) pays the disk reads; compare modes on the same
+// machine and disk only.
+TEST_CASE("Static pipeline cold page cache (JSON, map options)", "[.][benchmark][static_pipeline][cold_cache]")
+{
+    BENCHMARK_REQUIRES_RELEASE_BUILD();
+
+    constexpr std::size_t LINE_COUNT = 1'000'000;
+    constexpr std::size_t SAMPLES = 3;
+    const TestLogFile file("benchmark_static_pipeline_cold.json");
+    file.Write(MakeEscapedJsonLines(LINE_COUNT));
+    const std::size_t bytes = std::filesystem::file_size(file.GetFilePath());
+    if (!EvictFromPageCache(file.GetFilePath()))
+    {
+        SKIP("Cannot evict the fixture from the page cache on this platform.");
+    }
+
+    struct Mode
+    {
+        const char *label;
+        LogFile::MapOptions options;
+    };
+    const std::array<Mode, 4> modes = {
+        Mode{.label = "no access hints", .options = {.accessHints = false}},
+        Mode{.label = "access hints (default)", .options = {}},
+        Mode{.label = "populate", .options = {.populate = true}},
+        Mode{.label = "populate + huge pages", .options = {.populate = true, .hugePages = true}},
+    };
+
+    using Ms = std::chrono::duration<double, std::milli>;
+    const internal::AdvancedParserOptions advanced;
+    for (const Mode &mode : modes)
+    {
+        std::vector<double> elapsedMs;
+        for (std::size_t sample = 0; sample < SAMPLES; ++sample)
+        {
+            REQUIRE(EvictFromPageCache(file.GetFilePath()));
+            const auto start = std::chrono::steady_clock::now();
+            REQUIRE(ParseStatic(file.GetFilePath(), advanced, mode.options) == LINE_COUNT);
+            elapsedMs.push_back(Ms(std::chrono::steady_clock::now() - start).count());
+        }
+
+        double meanMs = 0.0;
+        for (const double ms : elapsedMs)
+        {
+            meanMs += ms / static_cast<double>(SAMPLES);
+        }
+        const double mbps = meanMs == 0.0 ? 0.0 : (static_cast<double>(bytes) / (1024.0 * 1024.0)) / (meanMs / 1000.0);
+        WARN(
+            "Cold cache, " << mode.label << ": " << meanMs << " ms mean over " << SAMPLES << " samples (low="
+                           << *std::ranges::min_element(elapsedMs) << " ms), " << mbps << " MB/s"
+        );
+    }
+}
@@ -5,14 +5,18 @@
 // 250 ms / p95 <= 500 ms on the parser-side path (no Qt event loop).
 //
 // Tagged `[stream_latency][benchmark]` to land under the `benchmark`
-// CTest label.
+// CTest label. The `[retention]` case below times the steady-state
+// append + prefix-eviction loop at a retention cap, and `[stream_source]`
+// times `StreamLineSource` ingest against per-line strings.
 
 #include "benchmark_common.hpp"
 #include "common.hpp"
 
+#include <loglib/internal/compact_log_value.hpp>
 #include <loglib/key_index.hpp>
 #include <loglib/log_line.hpp>
 #include <loglib/log_parse_sink.hpp>
+#include <loglib/log_table.hpp>
 #include <loglib/parser_options.hpp>
 #include <loglib/parsers/json_parser.hpp>
 #include <loglib/stop_token.hpp>
@@ -31,8 +35,10 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
+#include <deque>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
 #include <mutex>
 #include <random>
 #include <string>
@@ -41,8 +47,11 @@
 #include <vector>
 
 using loglib::JsonParser;
+using loglib::KeyId;
 using loglib::KeyIndex;
+using loglib::LogLine;
 using loglib::LogParseSink;
+using loglib::LogTable;
 using loglib::ParserOptions;
 using loglib::StopSource;
 using loglib::StreamedBatch;
@@ -170,6 +179,32 @@ void RunProducer(
     producerDone.store(true, std::memory_order_release);
 }
 
+/// Synthetic retention-tail batch: @p count rows numbered from
+/// @p firstLineId, each published into @p streamSource and carrying one
+/// `value` field equal to its line id.
+StreamedBatch MakeRetentionBatch(
+    StreamLineSource &streamSource, KeyIndex &keys, KeyId valueKey, size_t firstLineId, size_t count
+)
+{
+    StreamedBatch batch;
+    batch.firstLineNumber = firstLineId;
+    if (firstLineId == 1)
+    {
+        batch.newKeys.emplace_back("value");
+    }
+    batch.lines.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const size_t lineId = streamSource.AppendLine("raw", std::string{});
+        std::vector<std::pair<KeyId, loglib::internal::CompactLogValue>> compactValues;
+        compactValues.emplace_back(
+            valueKey, loglib::internal::CompactLogValue::MakeInt64(static_cast<int64_t>(lineId))
+        );
+        batch.lines.emplace_back(std::move(compactValues), keys, streamSource, lineId);
+    }
+    return batch;
+}
+
 double Percentile(std::vector<double> sorted, double pct)
 {
     if (sorted.empty())
@@ -324,3 +359,201 @@ TEST_CASE("Stream Mode write-to-row latency", "[.][benchmark][stream_latency]")
     CHECK(median <= 250.0);
     CHECK(p95 <= 500.0);
 }
+
+// Steady-state live tail at the retention cap. Every batch pushes the
+// table past `CAP`, so each iteration pays `AppendBatch` plus an
+// `EvictPrefixRows` of one batch worth of rows — the shape
+// `LogModel::SetRetentionCap` produces at a sustained ingest rate. The
+// chunked row store drops whole chunks instead of shifting the surviving
+// `CAP` rows; the same eviction over a flat `std::vector<LogLine>` is
+// timed alongside as the reference.
+TEST_CASE("Retention-capped tail: steady-state append + prefix eviction", "[.][benchmark][retention]")
+{
+    BENCHMARK_REQUIRES_RELEASE_BUILD();
+
+    constexpr size_t CAP = 1'000'000;
+    constexpr size_t BATCH_ROWS = 10'000;
+    constexpr size_t STEADY_BATCHES = 200;
+
+    auto streamSource = std::make_unique<StreamLineSource>(std::filesystem::path("<retention>"), nullptr);
+    StreamLineSource &streamRef = *streamSource;
+    LogTable table;
+    table.BeginStreaming(std::move(streamSource));
+    KeyIndex &keys = table.Keys();
+    const KeyId valueKey = keys.GetOrInsert(std::string("value"));
+
+    // Fill to the cap before measuring.
+    size_t nextLineId = 1;
+    while (table.RowCount() < CAP)
+    {
+        table.AppendBatch(MakeRetentionBatch(streamRef, keys, valueKey, nextLineId, BATCH_ROWS));
+        nextLineId += BATCH_ROWS;
+    }
+    REQUIRE(table.RowCount() == CAP);
+
+    std::vector<double> appendMs;
+    std::vector<double> evictMs;
+    appendMs.reserve(STEADY_BATCHES);
+    evictMs.reserve(STEADY_BATCHES);
+    for (size_t i = 0; i < STEADY_BATCHES; ++i)
+    {
+        StreamedBatch batch = MakeRetentionBatch(streamRef, keys, valueKey, nextLineId, BATCH_ROWS);
+        nextLineId += BATCH_ROWS;
+
+        const auto appendStart = std::chrono::steady_clock::now();
+        table.AppendBatch(std::move(batch));
+        const auto evictStart = std::chrono::steady_clock::now();
+        table.EvictPrefixRows(table.RowCount() - CAP);
+        const auto evictEnd = std::chrono::steady_clock::now();
+
+        appendMs.push_back(std::chrono::duration<double, std::milli>(evictStart - appendStart).count());
+        evictMs.push_back(std::chrono::duration<double, std::milli>(evictEnd - evictStart).count());
+    }
+    REQUIRE(table.RowCount() == CAP);
+    CHECK(std::get<int64_t>(table.GetValue(0, 0)) == static_cast<int64_t>(nextLineId - CAP));
+    CHECK(std::get<int64_t>(table.GetValue(CAP - 1, 0)) == static_cast<int64_t>(nextLineId - 1));
+
+    // Reference: the same steady state over a flat vector (front erase
+    // shifts every survivor).
+    std::vector<double> vectorEvictMs;
+    vectorEvictMs.reserve(STEADY_BATCHES);
+    {
+        auto refSource = std::make_unique<StreamLineSource>(std::filesystem::path("<retention-ref>"), nullptr);
+        KeyIndex refKeys;
+        const KeyId refValueKey = refKeys.GetOrInsert(std::string("value"));
+        std::vector<LogLine> flat;
+        size_t refLineId = 1;
+        while (flat.size() < CAP)
+        {
+            StreamedBatch batch = MakeRetentionBatch(*refSource, refKeys, refValueKey, refLineId, BATCH_ROWS);
+            refLineId += BATCH_ROWS;
+            std::ranges::move(batch.lines, std::back_inserter(flat));
+        }
+        for (size_t i = 0; i < STEADY_BATCHES; ++i)
+        {
+            StreamedBatch batch = MakeRetentionBatch(*refSource, refKeys, refValueKey, refLineId, BATCH_ROWS);
+            refLineId += BATCH_ROWS;
+            std::ranges::move(batch.lines, std::back_inserter(flat));
+            const auto evictStart = std::chrono::steady_clock::now();
+            flat.erase(flat.begin(), flat.begin() + static_cast<std::ptrdiff_t>(flat.size() - CAP));
+            const auto evictEnd = std::chrono::steady_clock::now();
+            refSource->EvictBefore(flat.front().LineId());
+            vectorEvictMs.push_back(std::chrono::duration<double, std::milli>(evictEnd - evictStart).count());
+        }
+    }
+
+    const double evictMedian = Percentile(evictMs, 50.0);
+    const double evictP95 = Percentile(evictMs, 95.0);
+    const double vectorMedian = Percentile(vectorEvictMs, 50.0);
+    WARN(
+        "[retention] cap = " << CAP << ", batch = " << BATCH_ROWS << " rows x " << STEADY_BATCHES
+                             << " batches; AppendBatch median = " << Percentile(appendMs, 50.0)
+                             << " ms; EvictPrefixRows median = " << evictMedian << " ms, p95 = " << evictP95
+                             << " ms; flat-vector erase median = " << vectorMedian << " ms"
+    );
+
+    CHECK(evictMedian <= vectorMedian);
+}
+
+// `StreamLineSource` ingest at a capped live tail: every line is appended
+// with its owned arena, a reader thread resolves recent lines the way the
+// GUI does, and the head is evicted once per 10'000 lines. The reference
+// is the previous layout (two `std::deque<std::string>`s behind one
+// mutex shared with the reader).
+TEST_CASE("StreamLineSource append + read + evict throughput", "[.][benchmark][stream_source]")
+{
+    BENCHMARK_REQUIRES_RELEASE_BUILD();
+
+    constexpr size_t LINE_COUNT = 2'000'000;
+    constexpr size_t CAP = 100'000;
+    constexpr size_t EVICT_EVERY = 10'000;
+    const std::string raw =
+        R"({"ts":"2026-01-01T00:00:00Z","level":"info","msg":"request served","path":"/api/v1/items","ms":12})";
+    const std::string owned(32, 'o');
+
+    const auto runReader = [](std::atomic<bool> &done, auto &&readRecent) {
+        return std::thread([&done, readRecent]() mutable {
+            while (!done.load(std::memory_order_acquire))
+            {
+                readRecent();
+            }
+        });
+    };
+
+    double arenaNsPerLine = 0.0;
+    size_t arenaReads = 0;
+    size_t arenaBytes = 0;
+    {
+        StreamLineSource source(std::filesystem::path("<stream-source>"), nullptr);
+        std::atomic<bool> done{false};
+        std::atomic<size_t> reads{0};
+        std::thread reader = runReader(done, [&]() {
+            const size_t next = source.FirstAvailableLineId() + source.Size();
+            if (next > 1 && !source.ResolveOwnedBytes(0, 8, next - 1).empty())
+            {
+                reads.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 1; i <= LINE_COUNT; ++i)
+        {
+            source.AppendLine(raw, owned);
+            if (i % EVICT_EVERY == 0 && i > CAP)
+            {
+                source.EvictBefore(i - CAP);
+            }
+        }
+        const auto end = std::chrono::steady_clock::now();
+        done.store(true, std::memory_order_release);
+        reader.join();
+        arenaNsPerLine = std::chrono::duration<double, std::nano>(end - start).count() / LINE_COUNT;
+        arenaReads = reads.load();
+        arenaBytes = source.OwnedMemoryBytes();
+    }
+
+    double dequeNsPerLine = 0.0;
+    size_t dequeReads = 0;
+    {
+        std::mutex lock;
+        std::deque<std::string> lines;
+        std::deque<std::string> ownedBytes;
+        std::atomic<bool> done{false};
+        std::atomic<size_t> reads{0};
+        std::thread reader = runReader(done, [&]() {
+            const std::scoped_lock guard(lock);
+            if (!ownedBytes.empty() && ownedBytes.back().size() >= 8)
+            {
+                reads.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 1; i <= LINE_COUNT; ++i)
+        {
+            std::string rawCopy = raw;
+            std::string ownedCopy = owned;
+            const std::scoped_lock guard(lock);
+            lines.push_back(std::move(rawCopy));
+            ownedBytes.push_back(std::move(ownedCopy));
+            if (i % EVICT_EVERY == 0 && i > CAP)
+            {
+                while (lines.size() > CAP)
+                {
+                    lines.pop_front();
+                    ownedBytes.pop_front();
+                }
+            }
+        }
+        const auto end = std::chrono::steady_clock::now();
+        done.store(true, std::memory_order_release);
+        reader.join();
+        dequeNsPerLine = std::chrono::duration<double, std::nano>(end - start).count() / LINE_COUNT;
+        dequeReads = reads.load();
+    }
+
+    WARN(
+        "[stream_source] " << LINE_COUNT << " lines, cap " << CAP << ": chunk arena " << arenaNsPerLine
+                           << " ns/line (" << arenaReads << " concurrent reads, " << arenaBytes
+                           << " bytes held); deque<string> + mutex " << dequeNsPerLine << " ns/line ("
+                           << dequeReads << " concurrent reads)"
+    );
+}
@@ -0,0 +1,120 @@
+#include "common.hpp"
+
+#include <loglib/internal/builtin_regex_decoders.hpp>
+#include <loglib/log_data.hpp>
+#include <loglib/parse_file.hpp>
+#include <loglib/parsers/regex_parser.hpp>
+#include <loglib/regex_templates.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace loglib;
+using loglib::internal::BuiltinRegexDecoder;
+using loglib::internal::BuiltinRegexDecoders;
+using loglib::internal::FindBuiltinRegexDecoder;
+
+TEST_CASE("Every built-in regex decoder matches a shipped template byte for byte", "[builtin_regex_decoders]")
+{
+    REQUIRE_FALSE(BuiltinRegexDecoders().empty());
+    for (const BuiltinRegexDecoder &decoder : BuiltinRegexDecoders())
+    {
+        INFO("decoder: " << decoder.name);
+        const auto found = FindBuiltinByPattern(decoder.pattern);
+        REQUIRE(found.has_value());
+        CHECK(found->name == decoder.name);
+        CHECK(FindBuiltinRegexDecoder(found->pattern) == &decoder);
+
+        // Every sample line takes the fast path.
+        std::vector<std::string_view> captures;
+        for (const std::string &line : found->sampleLines)
+        {
+            INFO("line: " << line);
+            CHECK(decoder.decode(line, captures));
+            CHECK(captures.size() == decoder.groupCount);
+        }
+    }
+    CHECK(FindBuiltinRegexDecoder("^(?<message>.*)$") == nullptr);
+}
+
+TEST_CASE("Built-in regex decoders leave absent optional groups empty", "[builtin_regex_decoders]")
+{
+    std::vector<std::string_view> captures;
+
+    const BuiltinRegexDecoder *syslog = FindBuiltinRegexDecoder(FindTemplateByName("Syslog (RFC3164)")->pattern);
+    REQUIRE(syslog != nullptr);
+    REQUIRE(syslog->decode("Jan  4 10:23:26 host-c CRON: (root) CMD", captures));
+    CHECK(captures == std::vector<std::string_view>{"Jan  4 10:23:26", "host-c", "CRON", "", "(root) CMD"});
+
+    const BuiltinRegexDecoder *common =
+        FindBuiltinRegexDecoder(FindTemplateByName("Apache/nginx Common Log Format")->pattern);
+    REQUIRE(common != nullptr);
+    REQUIRE(common->decode(R"(10.0.0.1 - - [10/Oct/2000:13:55:36 -0700] "GET /a.gif" 200 -)", captures));
+    CHECK(captures[5] == "/a.gif");
+    CHECK(captures[6].empty());
+    CHECK(captures[8] == "-");
+    // `"-"` is the second alternative; PCRE2 decides it.
+    CHECK_FALSE(common->decode(R"(10.0.0.1 - - [10/Oct/2000:13:55:36 -0700] "-" 408 -)", captures));
+}
+
+TEST_CASE("Built-in regex decoders parse like PCRE2 on mutated sample lines", "[builtin_regex_decoders][regex_parser]")
+{
+    // A trailing `(?:)` keeps the pattern off the decoder table, so the
+    // second parser runs every line through PCRE2. Random edits around
+    // the separators the decoders key on produce near-miss lines that
+    // must fail (or fall back) identically.
+    constexpr std::string_view EDIT_BYTES = " \t\"[]:-+.Z09aH/\r";
+    std::mt19937 rng(0x5EED);
+
+    for (const BuiltinRegexDecoder &decoder : BuiltinRegexDecoders())
+    {
+        INFO("decoder: " << decoder.name);
+        const auto tmpl = FindBuiltinByPattern(decoder.pattern);
+        REQUIRE(tmpl.has_value());
+
+        std::string content;
+        for (size_t i = 0; i < 2000; ++i)
+        {
+            std::string line = tmpl->sampleLines[i % tmpl->sampleLines.size()];
+            if (i >= tmpl->sampleLines.size())
+            {
+                const size_t pos = rng() % (line.size() + 1);
+                const char edit = EDIT_BYTES[rng() % EDIT_BYTES.size()];
+                switch (rng() % 3)
+                {
+                case 0:
+                    line.insert(line.begin() + static_cast<std::ptrdiff_t>(pos), edit);
+                    break;
+                case 1:
+                    line.erase(std::min(pos, line.size() - 1), 1);
+                    break;
+                default:
+                    line[std::min(pos, line.size() - 1)] = edit;
+                    break;
+                }
+            }
+            content.append(line);
+            content.push_back('\n');
+        }
+        const TestLogFile file("builtin_regex_decoder_parity.log");
+        file.Write(content);
+
+        const RegexParser fast{std::string(decoder.pattern)};
+        const RegexParser reference{std::string(decoder.pattern).append("(?:)")};
+        const ParseResult fastResult = ParseFile(fast, file.GetFilePath());
+        const ParseResult referenceResult = ParseFile(reference, file.GetFilePath());
+
+        CHECK(fastResult.errors == referenceResult.errors);
+        REQUIRE(fastResult.data.Lines().size() == referenceResult.data.Lines().size());
+        for (size_t i = 0; i < fastResult.data.Lines().size(); ++i)
+        {
+            CHECK(fast.ToString(fastResult.data.Lines()[i]) == reference.ToString(referenceResult.data.Lines()[i]));
+        }
+    }
+}
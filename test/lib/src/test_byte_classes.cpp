@@ -0,0 +1,119 @@
+#include <loglib/internal/byte_classes.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+
+using loglib::internal::BYTE_CLASS_BLOCK_BYTES;
+using loglib::internal::ByteClassCursor;
+using loglib::internal::ByteClassMasks;
+using loglib::internal::ByteClassSet;
+using loglib::internal::ClassifyBlock;
+using loglib::internal::ClassifyBlockScalar;
+
+namespace
+{
+
+constexpr ByteClassSet TEST_CLASSES{'=', '"', '\\', ','};
+
+} // namespace
+
+TEST_CASE("ByteClasses: the dispatched kernel matches the scalar kernel", "[byte_classes]")
+{
+    INFO("kernel=" << loglib::internal::ByteClassKernelName());
+
+    // Bias toward the classified bytes and the `' '` / 0x7f / 0x80
+    // edges where a signed compare would go wrong.
+    constexpr std::array<char, 10> INTERESTING = {'=', '"', '\\', ',', ' ', '\t', '\x7f', '\x80', '\xff', '\x21'};
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> anyByte(0, 255);
+    std::uniform_int_distribution<size_t> pick(0, INTERESTING.size() * 2 - 1);
+
+    std::array<char, BYTE_CLASS_BLOCK_BYTES> block{};
+    for (int round = 0; round < 2000; ++round)
+    {
+        for (char &c : block)
+        {
+            const size_t choice = pick(rng);
+            c = choice < INTERESTING.size() ? INTERESTING[choice] : static_cast<char>(anyByte(rng));
+        }
+        const ByteClassMasks expected = ClassifyBlockScalar(block.data(), TEST_CLASSES);
+        const ByteClassMasks actual = ClassifyBlock(block.data(), TEST_CLASSES);
+        INFO("round=" << round);
+        CHECK(actual.controlOrSpace == expected.controlOrSpace);
+        for (size_t i = 0; i < TEST_CLASSES.count; ++i)
+        {
+            CHECK(actual.bytes[i] == expected.bytes[i]);
+        }
+    }
+}
+
+TEST_CASE("ByteClasses: scalar kernel bit layout", "[byte_classes]")
+{
+    std::array<char, BYTE_CLASS_BLOCK_BYTES> block{};
+    block.fill('a');
+    block[0] = '=';
+    block[31] = '"';
+    block[32] = ' ';
+    block[63] = '\\';
+    block[40] = '\x80';
+
+    const ByteClassMasks masks = ClassifyBlockScalar(block.data(), TEST_CLASSES);
+    CHECK(masks.bytes[0] == (uint64_t{1} << 0));
+    CHECK(masks.bytes[1] == (uint64_t{1} << 31));
+    CHECK(masks.bytes[2] == (uint64_t{1} << 63));
+    CHECK(masks.bytes[3] == 0);
+    CHECK(masks.controlOrSpace == (uint64_t{1} << 32));
+}
+
+TEST_CASE("ByteClasses: cursor finds matches across blocks and in a short tail", "[byte_classes]")
+{
+    const auto quotes = [](const ByteClassMasks &masks) { return masks.bytes[1]; };
+    const auto nonSpace = [](const ByteClassMasks &masks) { return ~masks.controlOrSpace; };
+
+    std::string text(200, 'x');
+    text[10] = '"';
+    text[64] = '"';
+    text[149] = '"';
+
+    SECTION("readable only to the range end")
+    {
+        ByteClassCursor cursor(text, text.data() + text.size(), TEST_CLASSES);
+        CHECK(cursor.Find(0, quotes) == 10);
+        CHECK(cursor.Find(11, quotes) == 64);
+        CHECK(cursor.Find(65, quotes) == 149);
+        CHECK(cursor.Find(150, quotes) == text.size());
+    }
+    SECTION("a match past the range end is not reported")
+    {
+        // Block 128..191 is loaded in place, so byte 149 is classified
+        // but lies outside the range.
+        const std::string_view range(text.data(), 149);
+        ByteClassCursor cursor(range, text.data() + text.size(), TEST_CLASSES);
+        CHECK(cursor.Find(65, quotes) == range.size());
+    }
+    SECTION("zero padding never reads as a match")
+    {
+        const std::string spaces(70, ' ');
+        ByteClassCursor cursor(spaces, spaces.data() + spaces.size(), TEST_CLASSES);
+        CHECK(cursor.Find(0, nonSpace) == spaces.size());
+    }
+}
+
+TEST_CASE("ByteClasses: prefix XOR marks the bytes between quote pairs", "[byte_classes]")
+{
+    using loglib::internal::PrefixXor;
+
+    // Quotes at 1 and 4: bytes 1..3 are inside; the closing quote is not.
+    CHECK(PrefixXor(0b10010) == 0b01110);
+    CHECK(PrefixXor(0) == 0);
+    // An unmatched quote at bit 63 leaves only that bit set, which is
+    // what carries the in-quote state into the next block.
+    CHECK(PrefixXor(uint64_t{1} << 63) == (uint64_t{1} << 63));
+    CHECK(PrefixXor(1) == ~uint64_t{0});
+}
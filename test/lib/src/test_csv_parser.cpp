@@ -204,6 +204,41 @@ TEST_CASE("Quoted cell with embedded comma / quote / newline [csv]", "[csv_parse
     CHECK(loglib::AsStringView(result.data.Lines()[1].GetValue("text")) == std::string_view{"a\"b"});
 }
 
+TEST_CASE("Quoted cells crossing 64-byte classification blocks [csv]", "[csv_parser]")
+{
+    // The tokenizer carries the in-quote state from one 64-byte block to
+    // the next, so quoted commas and `""` escapes straddling a block edge
+    // must not split cells. The last row has a stray `"` mid-cell, which
+    // hands the rest of the line to the scalar state machine.
+    const std::string padding(60, 'p');
+    std::string text("a,b,c\n");
+    text.append(padding).append(",\"x,y,").append(padding).append(",z\",tail\n");
+    text.append(padding).append(",\"q\"\"").append(padding).append("\"\"\",tail\n");
+    text.append(padding).append(",mid\"dle,\"tail,end\"\n");
+
+    const loglib::CsvParser parser;
+    const TestLogFile file;
+    file.Write(text);
+
+    auto result = loglib::ParseFile(parser, file.GetFilePath());
+    REQUIRE(result.errors.empty());
+    REQUIRE(result.data.Lines().size() == 3);
+
+    std::string expectedB("x,y,");
+    expectedB.append(padding).append(",z");
+    CHECK(loglib::AsStringView(result.data.Lines()[0].GetValue("a")) == padding);
+    CHECK(loglib::AsStringView(result.data.Lines()[0].GetValue("b")) == expectedB);
+    CHECK(loglib::AsStringView(result.data.Lines()[0].GetValue("c")) == std::string_view{"tail"});
+
+    std::string expectedEscaped("q\"");
+    expectedEscaped.append(padding).append("\"");
+    CHECK(loglib::AsStringView(result.data.Lines()[1].GetValue("b")) == expectedEscaped);
+    CHECK(loglib::AsStringView(result.data.Lines()[1].GetValue("c")) == std::string_view{"tail"});
+
+    CHECK(loglib::AsStringView(result.data.Lines()[2].GetValue("b")) == std::string_view{"mid\"dle"});
+    CHECK(loglib::AsStringView(result.data.Lines()[2].GetValue("c")) == std::string_view{"tail,end"});
+}
+
 TEST_CASE("Unterminated quoted cell surfaces as error [csv]", "[csv_parser]")
 {
     const loglib::CsvParser parser;
@@ -1,8 +1,13 @@
 #include "common.hpp"
 
+#include <loglib/file_line_source.hpp>
+#include <loglib/internal/buffering_sink.hpp>
 #include <loglib/internal/decompressing_byte_source.hpp>
+#include <loglib/internal/growing_byte_buffer.hpp>
+#include <loglib/internal/seek_index.hpp>
 #include <loglib/log_file.hpp>
 #include <loglib/parse_file.hpp>
+#include <loglib/parser_options.hpp>
 #include <loglib/parsers/json_parser.hpp>
 #include <loglib/stop_token.hpp>
 
@@ -13,6 +18,7 @@
 #include <zlib.h>
 #include <zstd.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <chrono>
@@ -28,6 +34,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <system_error>
 #include <thread>
 #include <type_traits>
@@ -36,6 +43,7 @@
 using loglib::StopSource;
 using loglib::internal::DecompressingByteSource;
 using loglib::internal::DecompressionCancelled;
+using loglib::internal::GrowingByteBuffer;
 
 namespace
 {
@@ -171,6 +179,77 @@ std::vector<std::uint8_t> CompressZstd(const std::string &input)
     return out;
 }
 
+/// BGZF (`bgzip`) framing: one gzip member per <= 64 KiB of input,
+/// each recording its own size in a `BC` extra subfield, followed by
+/// the empty end-of-file block.
+std::vector<std::uint8_t> CompressBgzf(const std::string &input)
+{
+    constexpr std::size_t BLOCK_INPUT_BYTES = 65280;
+    std::vector<std::uint8_t> out;
+    auto appendLe32 = [&out](std::uint32_t value) {
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            out.push_back(static_cast<std::uint8_t>(value >> shift));
+        }
+    };
+    auto appendBlock = [&](const char *data, std::size_t size) {
+        z_stream strm{};
+        // windowBits = -15: raw deflate; the gzip framing is written by hand.
+        REQUIRE(::deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) == Z_OK);
+        std::vector<std::uint8_t> deflated(::deflateBound(&strm, static_cast<uLong>(size)));
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        strm.next_in = const_cast<Bytef *>(reinterpret_cast<const Bytef *>(data));
+        strm.avail_in = static_cast<uInt>(size);
+        strm.next_out = deflated.data();
+        strm.avail_out = static_cast<uInt>(deflated.size());
+        REQUIRE(::deflate(&strm, Z_FINISH) == Z_STREAM_END);
+        deflated.resize(strm.total_out);
+        ::deflateEnd(&strm);
+
+        // 18-byte header + payload + CRC32 + ISIZE; BSIZE stores size - 1.
+        const std::size_t blockSize = 18 + deflated.size() + 8;
+        const std::array<std::uint8_t, 16> header = {0x1f, 0x8b, 8, 4, 0, 0, 0, 0, 0, 0xff, 6, 0, 'B', 'C', 2, 0};
+        out.insert(out.end(), header.begin(), header.end());
+        out.push_back(static_cast<std::uint8_t>((blockSize - 1) & 0xff));
+        out.push_back(static_cast<std::uint8_t>((blockSize - 1) >> 8));
+        out.insert(out.end(), deflated.begin(), deflated.end());
+        appendLe32(
+            static_cast<std::uint32_t>(::crc32(0, reinterpret_cast<const Bytef *>(data), static_cast<uInt>(size)))
+        );
+        appendLe32(static_cast<std::uint32_t>(size));
+    };
+    for (std::size_t offset = 0; offset < input.size(); offset += BLOCK_INPUT_BYTES)
+    {
+        appendBlock(input.data() + offset, std::min(BLOCK_INPUT_BYTES, input.size() - offset));
+    }
+    appendBlock("", 0);
+    return out;
+}
+
+/// One zstd frame per @p frameInputBytes of input, like `pzstd` or the
+/// seekable format. @p recordContentSize toggles the frame-header size.
+std::vector<std::uint8_t> CompressZstdFrames(
+    const std::string &input, std::size_t frameInputBytes, bool recordContentSize = true
+)
+{
+    ZSTD_CCtx *cctx = ::ZSTD_createCCtx();
+    REQUIRE(cctx != nullptr);
+    REQUIRE(!::ZSTD_isError(::ZSTD_CCtx_setParameter(cctx, ZSTD_c_contentSizeFlag, recordContentSize ? 1 : 0)));
+    std::vector<std::uint8_t> out;
+    for (std::size_t offset = 0; offset < input.size(); offset += frameInputBytes)
+    {
+        const std::size_t size = std::min(frameInputBytes, input.size() - offset);
+        const std::size_t was = out.size();
+        out.resize(was + ::ZSTD_compressBound(size));
+        const std::size_t written =
+            ::ZSTD_compress2(cctx, out.data() + was, out.size() - was, input.data() + offset, size);
+        REQUIRE(!::ZSTD_isError(written));
+        out.resize(was + written);
+    }
+    ::ZSTD_freeCCtx(cctx);
+    return out;
+}
+
 std::string SampleContent(std::size_t targetBytes)
 {
     std::string out;
@@ -795,6 +874,200 @@ TEST_CASE(
     CHECK(DecompressingByteSource::SniffCodec(tiny.Path()) == Codec::None);
 }
 
+TEST_CASE("DecompressingByteSource: frame-parallel decode matches the stream decoder", "[DecompressingByteSource]")
+{
+    const std::string content = SampleContent(4 * 1024 * 1024);
+    auto verifyParallel = [&content](const std::vector<std::uint8_t> &compressed, const std::string &suffix) {
+        const TempBinaryFile fixture(suffix);
+        fixture.WriteBytes(compressed);
+
+        for (const bool progressive : {false, true})
+        {
+            DecompressingByteSource::Options options;
+            options.decodeThreads = 4;
+            options.progressive = progressive;
+            DecompressingByteSource dbs(fixture.Path(), {}, {}, options);
+            std::string decoded;
+            if (dbs.IsProgressive())
+            {
+                const auto buffer = dbs.ProgressiveBuffer();
+                std::size_t size = buffer->Size();
+                while (!buffer->IsComplete())
+                {
+                    size = buffer->WaitForGrowth(size, loglib::StopToken{});
+                }
+                CHECK(buffer->Error().empty());
+                decoded.assign(buffer->Data(), buffer->Size());
+            }
+            else
+            {
+                decoded = ReadFileContents(dbs.EffectivePath());
+            }
+            CHECK(dbs.DecompressedSize() == content.size());
+            CHECK(decoded == content);
+        }
+    };
+
+    SECTION("BGZF gzip")
+    {
+        verifyParallel(CompressBgzf(content), ".log.gz");
+    }
+    SECTION("multi-frame zstd")
+    {
+        verifyParallel(CompressZstdFrames(content, 256 * 1024), ".log.zst");
+    }
+    SECTION("multi-frame zstd without content sizes")
+    {
+        verifyParallel(CompressZstdFrames(content, 256 * 1024, false), ".log.zst");
+    }
+    SECTION("zstd frames too large to buffer are streamed in order")
+    {
+        // Incompressible frames past the per-frame buffering limit.
+        std::string noisy = content;
+        // NOLINTNEXTLINE(cert-msc32-c,cert-msc51-cpp,bugprone-random-generator-seed)
+        std::mt19937 gen(7);
+        noisy.resize(noisy.size() + (9 * 1024 * 1024));
+        for (std::size_t i = content.size(); i < noisy.size(); ++i)
+        {
+            noisy[i] = static_cast<char>(gen());
+        }
+        const auto compressed = CompressZstdFrames(noisy, 10 * 1024 * 1024);
+        const TempBinaryFile fixture(".log.zst");
+        fixture.WriteBytes(compressed);
+        DecompressingByteSource::Options options;
+        options.decodeThreads = 4;
+        DecompressingByteSource dbs(fixture.Path(), {}, {}, options);
+        CHECK(ReadFileContents(dbs.EffectivePath()) == noisy);
+    }
+}
+
+TEST_CASE("DecompressingByteSource: frame-parallel decode enforces the size cap", "[DecompressingByteSource]")
+{
+    const std::string content = SampleContent(4 * 1024 * 1024);
+    auto verifyCap = [&content](const std::vector<std::uint8_t> &compressed, const std::string &suffix) {
+        const TempBinaryFile fixture(suffix);
+        fixture.WriteBytes(compressed);
+        DecompressingByteSource::Options options;
+        options.decodeThreads = 4;
+
+        // Workers trip the cap while buffering, well before the output.
+        options.maxDecompressedBytes = 64 * 1024;
+        CHECK_THROWS_AS(
+            DecompressingByteSource(fixture.Path(), {}, {}, options), loglib::internal::DecompressionSizeCapExceeded
+        );
+
+        // One byte short of the content still trips; the exact size does not.
+        options.maxDecompressedBytes = content.size() - 1;
+        CHECK_THROWS_AS(
+            DecompressingByteSource(fixture.Path(), {}, {}, options), loglib::internal::DecompressionSizeCapExceeded
+        );
+        options.maxDecompressedBytes = content.size();
+        DecompressingByteSource dbs(fixture.Path(), {}, {}, options);
+        CHECK(dbs.DecompressedSize() == content.size());
+    };
+
+    SECTION("BGZF gzip")
+    {
+        verifyCap(CompressBgzf(content), ".log.gz");
+    }
+    SECTION("multi-frame zstd")
+    {
+        verifyCap(CompressZstdFrames(content, 256 * 1024), ".log.zst");
+    }
+    SECTION("multi-frame zstd without content sizes")
+    {
+        verifyCap(CompressZstdFrames(content, 256 * 1024, false), ".log.zst");
+    }
+}
+
+TEST_CASE("DecompressingByteSource: frame-parallel decode reports truncation", "[DecompressingByteSource]")
+{
+    const std::string content = SampleContent(2 * 1024 * 1024);
+    auto verifyTruncation = [](std::vector<std::uint8_t> compressed, const std::string &suffix) {
+        compressed.resize(compressed.size() / 2);
+        const TempBinaryFile fixture(suffix);
+        fixture.WriteBytes(compressed);
+        DecompressingByteSource::Options options;
+        options.decodeThreads = 4;
+        CHECK_THROWS_AS(DecompressingByteSource(fixture.Path(), {}, {}, options), std::runtime_error);
+    };
+
+    SECTION("BGZF gzip")
+    {
+        verifyTruncation(CompressBgzf(content), ".log.gz");
+    }
+    SECTION("multi-frame zstd")
+    {
+        verifyTruncation(CompressZstdFrames(content, 128 * 1024), ".log.zst");
+    }
+}
+
+TEST_CASE("DecompressingByteSource: gzip seek index is recorded and reused", "[DecompressingByteSource]")
+{
+    const std::string content = SampleContent(4 * 1024 * 1024);
+    const TempBinaryFile cache("-seek-index");
+    auto verifyIndexed = [&content, &cache](const std::vector<std::uint8_t> &compressed) {
+        const TempBinaryFile fixture(".log.gz");
+        fixture.WriteBytes(compressed);
+
+        DecompressingByteSource::Options options;
+        options.seekIndexDir = cache.Path();
+        options.seekPointSpacingBytes = 256 * 1024;
+        options.decodeThreads = 1;
+        {
+            const DecompressingByteSource first(fixture.Path(), {}, {}, options);
+            CHECK(ReadFileContents(first.EffectivePath()) == content);
+        }
+        const auto index = loglib::internal::LoadGzipSeekIndex(
+            cache.Path(), fixture.Path(), loglib::internal::SeekIndexFingerprint(fixture.ReadBytes())
+        );
+        REQUIRE(index.has_value());
+        CHECK(index->points.size() >= 8);
+        CHECK(index->decodedSize == content.size());
+
+        options.decodeThreads = 4;
+        for (const bool progressive : {false, true})
+        {
+            options.progressive = progressive;
+            DecompressingByteSource reopened(fixture.Path(), {}, {}, options);
+            std::string decoded;
+            if (reopened.IsProgressive())
+            {
+                const auto buffer = reopened.ProgressiveBuffer();
+                std::size_t size = buffer->Size();
+                while (!buffer->IsComplete())
+                {
+                    size = buffer->WaitForGrowth(size, loglib::StopToken{});
+                }
+                CHECK(buffer->Error().empty());
+                decoded.assign(buffer->Data(), buffer->Size());
+            }
+            else
+            {
+                decoded = ReadFileContents(reopened.EffectivePath());
+            }
+            CHECK(reopened.DecompressedSize() == content.size());
+            CHECK(decoded == content);
+        }
+    };
+
+    SECTION("single member")
+    {
+        verifyIndexed(CompressGzip(content));
+    }
+    SECTION("seek points span member boundaries")
+    {
+        const std::size_t half = content.size() / 2;
+        std::vector<std::uint8_t> compressed = CompressGzip(content.substr(0, half));
+        const std::vector<std::uint8_t> second = CompressGzip(content.substr(half));
+        compressed.insert(compressed.end(), second.begin(), second.end());
+        verifyIndexed(compressed);
+    }
+
+    std::error_code ec;
+    std::filesystem::remove_all(cache.Path(), ec);
+}
+
 TEST_CASE("DecompressingByteSource: CodecName maps every enum value", "[DecompressingByteSource]")
 {
     using Codec = DecompressingByteSource::Codec;
@@ -859,3 +1132,166 @@ TEST_CASE("DecompressingByteSource: row-count parity with ParseFile", "[Decompre
         verifyParity(CompressZstd(jsonl), ".jsonl.zst");
     }
 }
+
+#ifndef _WIN32
+
+namespace
+{
+
+DecompressingByteSource::Options ProgressiveOptions()
+{
+    DecompressingByteSource::Options options;
+    options.progressive = true;
+    return options;
+}
+
+std::string ParityJsonl(std::size_t lineCount)
+{
+    std::string jsonl;
+    jsonl.reserve(lineCount * 96);
+    for (std::size_t i = 0; i < lineCount; ++i)
+    {
+        jsonl += "{\"index\":";
+        jsonl += std::to_string(i);
+        jsonl += ",\"level\":\"info\",\"msg\":\"progressive decompression fixture line\"}\n";
+    }
+    return jsonl;
+}
+
+/// Parses the progressive buffer of @p dbs the way `MainWindow` does:
+/// a `LogFile` over the growing bytes, streamed through the parser
+/// while the decoder is still writing.
+loglib::ParseResult ParseProgressive(const DecompressingByteSource &dbs)
+{
+    auto fileSource = std::make_unique<loglib::FileLineSource>(
+        std::make_unique<loglib::LogFile>(dbs.ProgressiveBuffer(), dbs.DisplayPath())
+    );
+    loglib::FileLineSource *sourceRaw = fileSource.get();
+    loglib::internal::BufferingSink sink(std::move(fileSource));
+    const loglib::JsonParser parser;
+    parser.ParseStreaming(*sourceRaw, sink, loglib::ParserOptions{});
+    return loglib::ParseResult{.data = sink.TakeData(), .errors = sink.TakeErrors()};
+}
+
+} // namespace
+
+TEST_CASE("DecompressingByteSource: progressive round-trip each codec", "[DecompressingByteSource][progressive]")
+{
+    REQUIRE(GrowingByteBuffer::IsSupported());
+    const std::string content = SampleContent(1024 * 1024);
+    auto verifyRoundTrip = [&content](const std::vector<std::uint8_t> &compressed, const std::string &suffix) {
+        const TempBinaryFile fixture(suffix);
+        fixture.WriteBytes(compressed);
+
+        DecompressingByteSource dbs(fixture.Path(), {}, {}, ProgressiveOptions());
+        REQUIRE(dbs.IsProgressive());
+        const auto buffer = dbs.ProgressiveBuffer();
+        REQUIRE(buffer != nullptr);
+        // No temp file: the effective path is the source itself.
+        CHECK(dbs.EffectivePath() == fixture.Path());
+
+        std::size_t size = buffer->Size();
+        while (!buffer->IsComplete())
+        {
+            size = buffer->WaitForGrowth(size, loglib::StopToken{});
+        }
+        CHECK(buffer->Error().empty());
+        CHECK(dbs.DecompressedSize() == content.size());
+        CHECK(std::string_view(buffer->Data(), buffer->Size()) == content);
+    };
+
+    SECTION("gzip")
+    {
+        verifyRoundTrip(CompressGzip(content), ".log.gz");
+    }
+    SECTION("bzip2")
+    {
+        verifyRoundTrip(CompressBzip2(content), ".log.bz2");
+    }
+    SECTION("xz")
+    {
+        verifyRoundTrip(CompressXz(content), ".log.xz");
+    }
+    SECTION("zstd")
+    {
+        verifyRoundTrip(CompressZstd(content), ".log.zst");
+    }
+}
+
+TEST_CASE(
+    "DecompressingByteSource: progressive parse matches the temp-file parse", "[DecompressingByteSource][progressive]"
+)
+{
+    constexpr std::size_t LINE_COUNT = 40000;
+    const std::string jsonl = ParityJsonl(LINE_COUNT);
+    const TempBinaryFile fixture(".jsonl.gz");
+    fixture.WriteBytes(CompressGzip(jsonl));
+
+    DecompressingByteSource reference(fixture.Path());
+    const loglib::JsonParser parser;
+    const auto expected = loglib::ParseFile(parser, reference.EffectivePath());
+    REQUIRE(expected.data.Lines().size() == LINE_COUNT);
+
+    DecompressingByteSource dbs(fixture.Path(), {}, {}, ProgressiveOptions());
+    REQUIRE(dbs.IsProgressive());
+    const auto result = ParseProgressive(dbs);
+    CHECK(result.data.Lines().size() == expected.data.Lines().size());
+    CHECK(result.errors.empty());
+}
+
+TEST_CASE(
+    "DecompressingByteSource: progressive truncation keeps the decoded rows", "[DecompressingByteSource][progressive]"
+)
+{
+    const std::string jsonl = ParityJsonl(80000);
+    std::vector<std::uint8_t> compressed = CompressGzip(jsonl);
+    compressed.resize(compressed.size() / 2);
+    const TempBinaryFile fixture(".jsonl.gz");
+    fixture.WriteBytes(compressed);
+
+    // The temp-file decode rejects the whole file; progressive mode has
+    // already handed rows to the parser when the codec error lands.
+    DecompressingByteSource dbs(fixture.Path(), {}, {}, ProgressiveOptions());
+    REQUIRE(dbs.IsProgressive());
+    const auto result = ParseProgressive(dbs);
+    CHECK(result.data.Lines().size() > 0);
+    CHECK(result.data.Lines().size() < 80000);
+    bool sawTruncation = false;
+    for (const auto &error : result.errors)
+    {
+        sawTruncation = sawTruncation || error.find("Decompression stopped early") != std::string::npos;
+    }
+    CHECK(sawTruncation);
+}
+
+TEST_CASE(
+    "DecompressingByteSource: progressive falls back for discardFirstLine", "[DecompressingByteSource][progressive]"
+)
+{
+    const std::string content = SampleContent(64 * 1024);
+    const TempBinaryFile fixture(".log.zst");
+    fixture.WriteBytes(CompressZstd(content));
+
+    DecompressingByteSource::Options options = ProgressiveOptions();
+    options.discardFirstLine = true;
+    DecompressingByteSource dbs(fixture.Path(), {}, {}, options);
+    CHECK_FALSE(dbs.IsProgressive());
+    CHECK(dbs.ProgressiveBuffer() == nullptr);
+    CHECK(dbs.EffectivePath() != fixture.Path());
+}
+
+TEST_CASE("DecompressingByteSource: progressive honours a pre-stopped token", "[DecompressingByteSource][progressive]")
+{
+    const std::string content = SampleContent(1024 * 1024);
+    const TempBinaryFile fixture(".log.gz");
+    fixture.WriteBytes(CompressGzip(content));
+
+    StopSource stopSource;
+    stopSource.request_stop();
+    CHECK_THROWS_AS(
+        DecompressingByteSource(fixture.Path(), {}, stopSource.get_token(), ProgressiveOptions()),
+        DecompressionCancelled
+    );
+}
+
+#endif // _WIN32
@@ -0,0 +1,86 @@
+#include <loglib/internal/delimited_captures.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+using loglib::internal::DelimitedCapturePattern;
+using loglib::internal::DelimitedField;
+using loglib::internal::RecognizeDelimitedCapturePattern;
+using loglib::internal::SplitDelimitedCaptures;
+
+TEST_CASE("RecognizeDelimitedCapturePattern accepts delimiter-only templates", "[delimited_captures]")
+{
+    const auto pipes = RecognizeDelimitedCapturePattern(R"(^(?<ts>[^|]+)\|(?<level>[^|]*)\|(?<message>.*)$)");
+    REQUIRE(pipes.has_value());
+    CHECK(pipes->delimiter == '|');
+    CHECK(
+        pipes->fields == std::vector<DelimitedField>{
+                             DelimitedField::UntilDelimiterNonEmpty,
+                             DelimitedField::UntilDelimiter,
+                             DelimitedField::Rest,
+                         }
+    );
+
+    const auto tabs = RecognizeDelimitedCapturePattern(R"(^(?<a>[^\t]*)\t(?<b>[^\t]+)$)");
+    REQUIRE(tabs.has_value());
+    CHECK(tabs->delimiter == '\t');
+    CHECK(
+        tabs->fields ==
+        std::vector<DelimitedField>{DelimitedField::UntilDelimiter, DelimitedField::UntilDelimiterNonEmpty}
+    );
+
+    const auto semicolons = RecognizeDelimitedCapturePattern(R"(^(?<a>[^;]*);(?<b>.+)$)");
+    REQUIRE(semicolons.has_value());
+    CHECK(semicolons->delimiter == ';');
+    CHECK(semicolons->fields.back() == DelimitedField::RestNonEmpty);
+}
+
+TEST_CASE("RecognizeDelimitedCapturePattern rejects anything PCRE2 must decide", "[delimited_captures]")
+{
+    // Unanchored, or `$` escaped into a literal.
+    CHECK_FALSE(RecognizeDelimitedCapturePattern(R"((?<a>[^|]*)\|(?<b>[^|]*)$)"));
+    CHECK_FALSE(RecognizeDelimitedCapturePattern(R"(^(?<a>[^|]*)\|(?<b>[^|]*))"));
+    // Separator differs from the excluded byte.
+    CHECK_FALSE(RecognizeDelimitedCapturePattern(R"(^(?<a>[^|]*),(?<b>[^|]*)$)"));
+    CHECK_FALSE(RecognizeDelimitedCapturePattern(R"(^(?<a>[^|]*)\|(?<b>[^,]*)$)"));
+    // `.*` anywhere but last backtracks.
+    CHECK_FALSE(RecognizeDelimitedCapturePattern(R"(^(?<a>.*)\|(?<b>[^|]*)$)"));
+    // Lazy / possessive quantifiers, unnamed groups, classes and escapes.
+    CHECK_FALSE(RecognizeDelimitedCapturePattern(R"(^(?<a>[^|]*?)\|(?<b>.*)$)"));
+    CHECK_FALSE(RecognizeDelimitedCapturePattern(R"(^(?<a>[^|]*+)\|(?<b>.*)$)"));
+    CHECK_FALSE(RecognizeDelimitedCapturePattern(R"(^(?<a>[^|]*)\|(?:x)(?<b>.*)$)"));
+    CHECK_FALSE(RecognizeDelimitedCapturePattern(R"(^(?<a>[^|a]*)\|(?<b>.*)$)"));
+    CHECK_FALSE(RecognizeDelimitedCapturePattern(R"(^(?<a>[^\d]*)\d(?<b>.*)$)"));
+    CHECK_FALSE(RecognizeDelimitedCapturePattern(R"(^(?<a>\w+)\|(?<b>.*)$)"));
+}
+
+TEST_CASE("SplitDelimitedCaptures yields the anchored regex captures", "[delimited_captures]")
+{
+    const DelimitedCapturePattern pattern{
+        '|',
+        {DelimitedField::UntilDelimiterNonEmpty, DelimitedField::UntilDelimiter, DelimitedField::Rest},
+    };
+    std::vector<std::string_view> captures;
+
+    REQUIRE(SplitDelimitedCaptures(pattern, "2024|INFO|a|b", captures));
+    CHECK(captures == std::vector<std::string_view>{"2024", "INFO", "a|b"});
+
+    REQUIRE(SplitDelimitedCaptures(pattern, "2024||", captures));
+    CHECK(captures == std::vector<std::string_view>{"2024", "", ""});
+
+    // Too few delimiters, or an empty `[^|]+` field.
+    CHECK_FALSE(SplitDelimitedCaptures(pattern, "2024|INFO", captures));
+    CHECK_FALSE(SplitDelimitedCaptures(pattern, "|INFO|x", captures));
+    // `.` vs line terminators depends on the PCRE2 newline convention.
+    CHECK_FALSE(SplitDelimitedCaptures(pattern, "2024|INFO|a\rb", captures));
+
+    const DelimitedCapturePattern closed{'|', {DelimitedField::UntilDelimiter, DelimitedField::UntilDelimiterNonEmpty}};
+    REQUIRE(SplitDelimitedCaptures(closed, "|x", captures));
+    CHECK(captures == std::vector<std::string_view>{"", "x"});
+    // The last `[^|]` field runs to `$` and so cannot hold a delimiter.
+    CHECK_FALSE(SplitDelimitedCaptures(closed, "a|b|c", captures));
+    CHECK_FALSE(SplitDelimitedCaptures(closed, "a|", captures));
+}
@@ -0,0 +1,97 @@
+#include <loglib/enum_dictionary.hpp>
+#include <loglib/internal/enum_posting_index.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using loglib::EnumValueId;
+using loglib::INVALID_ENUM_VALUE_ID;
+using loglib::internal::EnumPostingIndex;
+using loglib::internal::RowIdSet;
+
+namespace
+{
+
+std::vector<uint64_t> Collect(const RowIdSet &set, uint64_t first, uint64_t end)
+{
+    std::vector<uint64_t> ids;
+    set.ForEachInRange(first, end, [&ids](uint64_t id) { ids.push_back(id); });
+    return ids;
+}
+
+std::vector<size_t> CollectRows(const EnumPostingIndex &index, EnumValueId id, size_t firstRow, size_t endRow)
+{
+    std::vector<size_t> rows;
+    index.ForEachRow(id, firstRow, endRow, [&rows](size_t row) { rows.push_back(row); });
+    return rows;
+}
+
+} // namespace
+
+TEST_CASE("RowIdSet keeps ids ascending across array and bitmap chunks", "[enum_posting_index]")
+{
+    RowIdSet set;
+    std::vector<uint64_t> expected;
+    // Dense run past `ARRAY_MAX_ENTRIES` flips chunk 0 to a bitmap;
+    // the sparse tail in chunks 1 and 3 stays in arrays.
+    for (uint64_t id = 0; id < 2 * RowIdSet::ARRAY_MAX_ENTRIES; id += 2)
+    {
+        set.Append(id);
+        expected.push_back(id);
+    }
+    for (const uint64_t id : {uint64_t{65'536}, uint64_t{65'600}, uint64_t{200'000}})
+    {
+        set.Append(id);
+        expected.push_back(id);
+    }
+    CHECK(set.Count() == expected.size());
+    CHECK(Collect(set, 0, 1'000'000) == expected);
+    CHECK(Collect(set, 7, 12) == std::vector<uint64_t>{8, 10});
+    CHECK(Collect(set, 65'537, 200'000) == std::vector<uint64_t>{65'600});
+    CHECK(Collect(set, 300'000, 400'000).empty());
+    CHECK(Collect(set, 5, 5).empty());
+
+    // Cut inside the bitmap chunk, then inside an array chunk.
+    set.EraseBelow(8'000);
+    CHECK(Collect(set, 0, 1'000'000).front() == 8'000);
+    CHECK(set.Count() == 96 + 3);
+    set.EraseBelow(65'537);
+    CHECK(Collect(set, 0, 1'000'000) == std::vector<uint64_t>{65'600, 200'000});
+    CHECK(set.Count() == 2);
+    set.EraseBelow(1'000'000);
+    CHECK(set.Empty());
+}
+
+TEST_CASE("EnumPostingIndex maps rows to ids and survives prefix eviction", "[enum_posting_index]")
+{
+    const auto a = static_cast<EnumValueId>(0);
+    const auto b = static_cast<EnumValueId>(3);
+    EnumPostingIndex index;
+    for (size_t row = 0; row < 10; ++row)
+    {
+        // Rows cycle a, b, <no value>.
+        index.Append(row % 3 == 0 ? a : (row % 3 == 1 ? b : INVALID_ENUM_VALUE_ID));
+    }
+    CHECK(index.Size() == 10);
+    CHECK(index.RowCount(a) == 4);
+    CHECK(index.RowCount(b) == 3);
+    CHECK(index.RowCount(static_cast<EnumValueId>(7)) == 0);
+    CHECK(CollectRows(index, a, 0, 10) == std::vector<size_t>{0, 3, 6, 9});
+    CHECK(CollectRows(index, b, 2, 8) == std::vector<size_t>{4, 7});
+
+    index.EraseFront(4);
+    CHECK(index.Size() == 6);
+    CHECK(index.RowCount(a) == 2);
+    CHECK(CollectRows(index, a, 0, 6) == std::vector<size_t>{2, 5});
+    CHECK(CollectRows(index, b, 0, 6) == std::vector<size_t>{0, 3});
+
+    index.Append(b);
+    CHECK(CollectRows(index, b, 0, 100) == std::vector<size_t>{0, 3, 6});
+
+    index.EraseFront(100);
+    CHECK(index.Empty());
+    CHECK(CollectRows(index, b, 0, 100).empty());
+}
@@ -0,0 +1,118 @@
+#include <loglib/internal/growing_byte_buffer.hpp>
+#include <loglib/stop_token.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+
+using loglib::StopSource;
+using loglib::StopToken;
+using loglib::internal::GrowingByteBuffer;
+
+// POSIX only; Windows keeps the temp-file decode (see `IsSupported`).
+#ifndef _WIN32
+
+TEST_CASE("GrowingByteBuffer: appended bytes stay at a fixed address", "[growing_byte_buffer]")
+{
+    REQUIRE(GrowingByteBuffer::IsSupported());
+    GrowingByteBuffer buffer(std::size_t{1} << 30, std::size_t{1} << 30);
+    const char *base = buffer.Data();
+    REQUIRE(base != nullptr);
+    CHECK(buffer.Size() == 0);
+
+    buffer.Append("first\n", 6);
+    buffer.Append("second\n", 7);
+    CHECK(buffer.Data() == base);
+    CHECK(std::string_view(buffer.Data(), buffer.Size()) == "first\nsecond\n");
+    CHECK_FALSE(buffer.IsComplete());
+    CHECK(buffer.SpilledBytes() == 0);
+
+    buffer.Finish();
+    CHECK(buffer.IsComplete());
+    CHECK(buffer.Error().empty());
+}
+
+TEST_CASE("GrowingByteBuffer: bytes past the in-memory budget spill to disk", "[growing_byte_buffer]")
+{
+    // A zero budget sends every window to the unlinked spill file.
+    GrowingByteBuffer buffer(std::size_t{1} << 30, 0);
+    std::string expected;
+    for (int i = 0; i < 20000; ++i)
+    {
+        const std::string line = "spilled line " + std::to_string(i) + "\n";
+        buffer.Append(line.data(), line.size());
+        expected += line;
+    }
+    buffer.Finish();
+    CHECK(buffer.SpilledBytes() == expected.size());
+    CHECK(std::string_view(buffer.Data(), buffer.Size()) == expected);
+}
+
+TEST_CASE("GrowingByteBuffer: appends past the reservation throw", "[growing_byte_buffer]")
+{
+    GrowingByteBuffer buffer(1, 1);
+    const std::string window(GrowingByteBuffer::WINDOW_BYTES, 'x');
+    buffer.Append(window.data(), window.size());
+    CHECK_THROWS_AS(buffer.Append("y", 1), std::length_error);
+    CHECK(buffer.Size() == window.size());
+}
+
+TEST_CASE("GrowingByteBuffer: a reader follows a concurrent writer", "[growing_byte_buffer]")
+{
+    GrowingByteBuffer buffer(std::size_t{1} << 30, std::size_t{1} << 30);
+    std::string expected;
+    for (int i = 0; i < 50000; ++i)
+    {
+        expected += "row-" + std::to_string(i) + "\n";
+    }
+
+    std::thread writer([&]() {
+        std::size_t written = 0;
+        while (written < expected.size())
+        {
+            const std::size_t chunk = std::min<std::size_t>(expected.size() - written, 1 + (written % 4093));
+            buffer.Append(expected.data() + written, chunk);
+            written += chunk;
+        }
+        buffer.Finish("writer done early");
+    });
+
+    const StopToken noStop;
+    std::size_t known = 0;
+    while (!buffer.IsComplete() || known < buffer.Size())
+    {
+        const std::size_t size = buffer.WaitForGrowth(known, noStop);
+        // Every published prefix is final.
+        const std::string_view published(buffer.Data() + known, size - known);
+        REQUIRE(published == std::string_view(expected).substr(known, size - known));
+        known = size;
+    }
+    writer.join();
+
+    CHECK(known == expected.size());
+    CHECK(buffer.Error() == "writer done early");
+}
+
+TEST_CASE("GrowingByteBuffer: WaitForGrowth returns on stop", "[growing_byte_buffer]")
+{
+    GrowingByteBuffer buffer(std::size_t{1} << 30, std::size_t{1} << 30);
+    StopSource stop;
+    std::thread stopper([&stop]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        stop.request_stop();
+    });
+    CHECK(buffer.WaitForGrowth(0, stop.get_token()) == 0);
+    stopper.join();
+
+    CHECK_FALSE(buffer.StopRequested());
+    buffer.RequestStop();
+    CHECK(buffer.StopRequested());
+}
+
+#endif // _WIN32
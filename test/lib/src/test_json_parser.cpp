@@ -4,6 +4,7 @@
 #include <loglib/file_line_source.hpp>
 #include <loglib/internal/advanced_parser_options.hpp>
 #include <loglib/internal/buffering_sink.hpp>
+#include <loglib/internal/pipeline_autotuner.hpp>
 #include <loglib/key_index.hpp>
 #include <loglib/line_source.hpp>
 #include <loglib/log_configuration.hpp>
@@ -187,6 +188,29 @@ TEST_CASE("Parse file with invalid and valid line", "[json_parser]")
     CHECK(result.data.Lines().size() == 1);
 }
 
+// Static parses carve every row's field array out of per-batch slabs that
+// the `LogFile` owns, so closing the session frees O(batches) blocks.
+TEST_CASE("Static parse carves row fields from LogFile-owned slabs", "[json_parser][field_slab]")
+{
+    const loglib::JsonParser parser;
+    const TestLogFile testFile;
+    std::string content;
+    for (int i = 0; i < 2000; ++i)
+    {
+        content += R"({"level": "info", "n": )" + std::to_string(i) + "}\n";
+    }
+    testFile.Write(content);
+
+    auto result = ParseFile(parser, testFile.GetFilePath());
+    REQUIRE(result.errors.empty());
+    REQUIRE(result.data.Lines().size() == 2000);
+
+    const loglib::FileLineSource *source = result.data.FrontFileSource();
+    REQUIRE(source != nullptr);
+    CHECK(source->File().FieldSlabMemoryBytes() > 0);
+    CHECK(std::get<int64_t>(result.data.Lines()[1999].GetValue("n")) == 1999);
+}
+
 TEST_CASE("Parse file with multiple invalid lines", "[json_parser]")
 {
     const loglib::JsonParser parser;
@@ -1235,6 +1259,124 @@ TEST_CASE("Padded-tail slow path parses lines within SIMDJSON_PADDING bytes of E
     }
 }
 
+TEST_CASE("Batch document stream hands irregular lines back to the line loop", "[json_parser][document_stream]")
+{
+    // Each batch is first decoded as one `iterate_many` stream; the first
+    // line that is not exactly one object drops the rest of the batch to the
+    // line-at-a-time loop. Rows, errors, and line ids must not depend on
+    // where that happens, so every batch size sees the same result. The
+    // irregular lines cover a field error (partial row; the stream must not
+    // be reused after it), trailing content, an object split across lines,
+    // CRLF, a non-object, and a second document on one line.
+    using namespace loglib;
+
+    const size_t batchSizeBytes = GENERATE(size_t{64}, size_t{256}, size_t{1} << 20);
+
+    std::vector<std::string> raw = {
+        R"({"i":1})",
+        "",
+        R"({"i":3,})",
+        R"({"i":4})",
+        R"({"i":5} x)",
+        R"({"i":6,)",
+        R"("n":2})",
+        "{\"i\":8}\r",
+        "[1,2]",
+        R"({"i":10}{"i":11})",
+    };
+    for (size_t i = raw.size() + 1; i <= 40; ++i)
+    {
+        std::string line = R"({"i":)";
+        line.append(std::to_string(i));
+        line.append("}");
+        raw.push_back(std::move(line));
+    }
+
+    std::string body;
+    for (const auto &s : raw)
+    {
+        body.append(s);
+        body.push_back('\n');
+    }
+    const TestLogFile testFile;
+    testFile.Write(body);
+
+    internal::AdvancedParserOptions advanced;
+    advanced.batchSizeBytes = batchSizeBytes;
+    advanced.threads = 1;
+    const ParseResult result = ParseWithSink(testFile.GetFilePath(), {}, advanced);
+
+    INFO("batchSizeBytes=" << batchSizeBytes);
+    REQUIRE(result.errors.size() == 4);
+    CHECK(result.errors[0].contains("Error on line 5"));
+    CHECK(result.errors[1].contains("Error on line 6"));
+    CHECK(result.errors[2].contains("Error on line 7"));
+    CHECK(result.errors[3].contains("Error on line 9"));
+
+    std::vector<size_t> expectedIds = {0, 2, 3, 7, 9};
+    for (size_t id = 10; id < 40; ++id)
+    {
+        expectedIds.push_back(id);
+    }
+    REQUIRE(result.data.Lines().size() == expectedIds.size());
+    for (size_t i = 0; i < expectedIds.size(); ++i)
+    {
+        INFO("i=" << i);
+        const LogLine &line = result.data.Lines()[i];
+        CHECK(line.LineId() == expectedIds[i]);
+        CHECK(std::get<int64_t>(line.GetValue("i")) == static_cast<int64_t>(expectedIds[i] + 1));
+    }
+    CHECK(result.data.Lines()[3].Source()->RawLine(7) == R"({"i":8})");
+    CHECK(result.data.FrontFileSource()->File().GetLineCount() == 40);
+}
+
+TEST_CASE("Autotuned batch sizes parse the same rows as a pinned batch size", "[json_parser][pipeline_autotuner]")
+{
+    // Start at 256-byte batches: after calibration the tuner jumps to
+    // `MIN_BATCH_BYTES`, so the cut positions move mid-file. Rows and
+    // line ids must match a parse that keeps 256-byte batches.
+    using namespace loglib;
+
+    std::string body;
+    for (size_t i = 0; i < 4000; ++i)
+    {
+        body.append(R"({"i":)").append(std::to_string(i)).append(R"(,"s":"row"})").push_back('\n');
+    }
+    const TestLogFile testFile;
+    testFile.Write(body);
+
+    std::vector<internal::PipelineTuning> reports;
+    internal::AdvancedParserOptions tuned;
+    tuned.threads = 1;
+    tuned.batchSizeBytes = 256;
+    tuned.onTuning = [&reports](const internal::PipelineTuning &tuning) { reports.push_back(tuning); };
+    internal::AdvancedParserOptions pinned = tuned;
+    pinned.autotune = false;
+    pinned.onTuning = nullptr;
+
+    const ParseResult tunedResult = ParseWithSink(testFile.GetFilePath(), {}, tuned);
+    const ParseResult pinnedResult = ParseWithSink(testFile.GetFilePath(), {}, pinned);
+
+    REQUIRE(reports.size() >= 2);
+    CHECK(reports.front().threads == 1);
+    CHECK(reports.front().batchSizeBytes == 256);
+    CHECK(reports.front().observedBatches == 0);
+    CHECK(reports.back().batchSizeBytes >= internal::PipelineAutotuner::MIN_BATCH_BYTES);
+    CHECK(reports.back().observedBatches >= internal::PipelineAutotuner::CALIBRATION_BATCHES);
+
+    CHECK(tunedResult.errors.empty());
+    CHECK(pinnedResult.errors.empty());
+    REQUIRE(tunedResult.data.Lines().size() == 4000);
+    REQUIRE(pinnedResult.data.Lines().size() == 4000);
+    for (size_t i = 0; i < 4000; ++i)
+    {
+        INFO("i=" << i);
+        const LogLine &line = tunedResult.data.Lines()[i];
+        CHECK(line.LineId() == pinnedResult.data.Lines()[i].LineId());
+        CHECK(std::get<int64_t>(line.GetValue("i")) == static_cast<int64_t>(i));
+    }
+}
+
 TEST_CASE(
     "InsertSorted preserves last-write-wins on duplicate keys above the lower_bound threshold",
     "[json_parser][duplicate_keys]"
@@ -0,0 +1,312 @@
+#include <loglib/internal/line_bytes_queue.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+
+using loglib::internal::LineBytesQueue;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+std::string DrainAll(LineBytesQueue &queue)
+{
+    std::string out;
+    std::array<char, 256> chunk{};
+    for (;;)
+    {
+        const std::size_t n = queue.Read(std::span<char>(chunk));
+        if (n == 0)
+        {
+            return out;
+        }
+        out.append(chunk.data(), n);
+    }
+}
+
+} // namespace
+
+TEST_CASE("LineBytesQueue: back-pressure drops the oldest whole lines", "[line_bytes_queue]")
+{
+    LineBytesQueue queue(32);
+    std::atomic<std::size_t> dropped{0};
+
+    queue.Append("aaaa\nbbbb\n", dropped);
+    queue.Append("cccccccccc\ndddddddddd\n", dropped);
+    CHECK(queue.Size() == 32);
+    CHECK(dropped.load() == 0);
+
+    // Three bytes over the cap: the drop rounds up through "aaaa\n".
+    queue.Append("ee\n", dropped);
+    CHECK(dropped.load() == 5);
+    CHECK(DrainAll(queue) == "bbbb\ncccccccccc\ndddddddddd\nee\n");
+    CHECK(queue.Empty());
+}
+
+TEST_CASE("LineBytesQueue: a payload larger than the cap keeps its newest lines", "[line_bytes_queue]")
+{
+    LineBytesQueue queue(16);
+    std::atomic<std::size_t> dropped{0};
+
+    queue.Append("old\n", dropped);
+    queue.Append(std::string(40, 'x') + "\ntail\n", dropped);
+    CHECK(DrainAll(queue) == "tail\n");
+    CHECK(dropped.load() == 4 + 41);
+}
+
+TEST_CASE("LineBytesQueue: Borrow hands out contiguous spans across the wrap", "[line_bytes_queue]")
+{
+    LineBytesQueue queue(64);
+    std::atomic<std::size_t> dropped{0};
+
+    // Enough traffic to wrap the ring many times.
+    for (int i = 0; i < 1000; ++i)
+    {
+        const std::string line = "line " + std::to_string(i) + "\n";
+        queue.Append(line, dropped);
+        std::string got;
+        while (got.size() < line.size())
+        {
+            const std::span<const char> bytes = queue.Borrow(1024);
+            REQUIRE_FALSE(bytes.empty());
+            got.append(bytes.data(), bytes.size());
+            queue.ReleaseBorrowed();
+        }
+        REQUIRE(got == line);
+    }
+    CHECK(dropped.load() == 0);
+    CHECK(queue.Borrow(1024).empty());
+}
+
+TEST_CASE("LineBytesQueue: borrowed bytes survive producer back-pressure", "[line_bytes_queue]")
+{
+    LineBytesQueue queue(32);
+    std::atomic<std::size_t> dropped{0};
+
+    queue.Append("first-line-0123\n", dropped);
+    const std::span<const char> borrowed = queue.Borrow(1024);
+    REQUIRE(std::string_view(borrowed.data(), borrowed.size()) == "first-line-0123\n");
+
+    // Borrowed bytes already count as read, so the soft cap no longer
+    // covers them. Push more than a whole ring while the borrow is held:
+    // the tail wraps onto the borrowed span and must drop, not overwrite.
+    std::size_t sent = 0;
+    while (sent < 2 * LineBytesQueue::MAX_BORROW_BYTES)
+    {
+        queue.Append("later-line-4567\n", dropped);
+        sent += 16;
+    }
+    CHECK(std::string_view(borrowed.data(), borrowed.size()) == "first-line-0123\n");
+    CHECK(dropped.load() > 0);
+    queue.ReleaseBorrowed();
+
+    const std::string rest = DrainAll(queue);
+    CHECK(rest.size() % 16 == 0);
+    CHECK(rest.size() + dropped.load() == sent);
+
+    // Space is reclaimed once the borrow ends.
+    queue.Append("after-release-8\n", dropped);
+    CHECK(DrainAll(queue) == "after-release-8\n");
+}
+
+TEST_CASE("LineBytesQueue: a payload and its suffix are kept or dropped together", "[line_bytes_queue]")
+{
+    LineBytesQueue queue(32);
+    std::atomic<std::size_t> dropped{0};
+
+    queue.Append("first-line-0123\n", dropped);
+    const std::span<const char> borrowed = queue.Borrow(1024);
+    REQUIRE(borrowed.size() == 16);
+
+    // Fill the ring up to 16 bytes short of the pinned borrow, so a
+    // 16-byte payload would still fit but not its newline.
+    const std::size_t capacity = 32 + LineBytesQueue::MAX_BORROW_BYTES;
+    std::size_t sent = 0;
+    for (std::size_t tail = 16; tail + 16 < capacity; tail += 16)
+    {
+        queue.Append("later-line-4567\n", dropped);
+        sent += 16;
+    }
+    queue.Append("datagram-no-eol!", "\n", dropped);
+    sent += 17;
+    queue.ReleaseBorrowed();
+
+    const std::string rest = DrainAll(queue);
+    CHECK(rest.find("datagram") == std::string::npos);
+    CHECK(rest.size() % 16 == 0);
+    CHECK(rest.size() + dropped.load() == sent);
+
+    // The next line starts clean instead of merging into a torn one.
+    queue.Append("next-datagram", "\n", dropped);
+    CHECK(DrainAll(queue) == "next-datagram\n");
+}
+
+TEST_CASE("LineBytesQueue: concurrent producer and consumer never tear lines", "[line_bytes_queue]")
+{
+    LineBytesQueue queue(4096);
+    std::atomic<std::size_t> dropped{0};
+    std::atomic<bool> done{false};
+    std::size_t sentBytes = 0;
+
+    std::thread producer([&]() {
+        for (int i = 0; i < 50000; ++i)
+        {
+            const std::string line =
+                "row-" + std::to_string(i) + "-" + std::string(static_cast<std::size_t>(i % 61), 'z') + "\n";
+            sentBytes += line.size();
+            queue.Append(line, dropped);
+        }
+        done.store(true);
+        queue.WakeConsumer();
+    });
+
+    std::string carry;
+    std::size_t receivedBytes = 0;
+    std::size_t tornLines = 0;
+    for (;;)
+    {
+        const std::span<const char> bytes = queue.Borrow(1024);
+        if (bytes.empty())
+        {
+            if (done.load() && queue.Empty())
+            {
+                break;
+            }
+            queue.WaitForBytes(5ms, [&] { return done.load(); });
+            continue;
+        }
+        receivedBytes += bytes.size();
+        carry.append(bytes.data(), bytes.size());
+        queue.ReleaseBorrowed();
+
+        std::size_t start = 0;
+        for (std::size_t newline = carry.find('\n'); newline != std::string::npos; newline = carry.find('\n', start))
+        {
+            const std::string_view line(carry.data() + start, newline - start);
+            const std::size_t dash = line.find('-', 4);
+            const int index = std::stoi(std::string(line.substr(4, dash - 4)));
+            if (!line.starts_with("row-") || line.size() != dash + 1 + static_cast<std::size_t>(index % 61))
+            {
+                ++tornLines;
+            }
+            start = newline + 1;
+        }
+        carry.erase(0, start);
+    }
+    producer.join();
+
+    CHECK(tornLines == 0);
+    CHECK(carry.empty());
+    CHECK(receivedBytes + dropped.load() == sentBytes);
+}
+
+TEST_CASE("LineBytesQueue: the ring grows with the backlog and shrinks once it drains", "[line_bytes_queue]")
+{
+    LineBytesQueue queue(std::size_t{64} << 20);
+    std::atomic<std::size_t> dropped{0};
+    CHECK(queue.RingBytes() == LineBytesQueue::INITIAL_RING_BYTES);
+
+    // A borrow taken before the ring grows stays readable afterwards.
+    queue.Append("pinned-line-0123\n", dropped);
+    const std::span<const char> borrowed = queue.Borrow(1024);
+    REQUIRE(std::string_view(borrowed.data(), borrowed.size()) == "pinned-line-0123\n");
+
+    std::string expected;
+    for (int i = 0; expected.size() < (std::size_t{4} << 20); ++i)
+    {
+        const std::string line = "backlog-" + std::to_string(i) + "\n";
+        expected += line;
+        queue.Append(line, dropped);
+    }
+    CHECK(queue.RingBytes() >= expected.size());
+    CHECK(queue.RingBytes() <= (std::size_t{8} << 20));
+    CHECK(std::string_view(borrowed.data(), borrowed.size()) == "pinned-line-0123\n");
+    queue.ReleaseBorrowed();
+
+    CHECK(DrainAll(queue) == expected);
+    CHECK(dropped.load() == 0);
+
+    // Short lines read as they arrive hand the burst's memory back.
+    for (int i = 0; i < 16; ++i)
+    {
+        queue.Append("steady\n", dropped);
+        CHECK(DrainAll(queue) == "steady\n");
+    }
+    CHECK(queue.RingBytes() == LineBytesQueue::INITIAL_RING_BYTES);
+}
+
+TEST_CASE("LineBytesQueue: bursts that resize the ring keep lines whole and in order", "[line_bytes_queue]")
+{
+    LineBytesQueue queue(std::size_t{16} << 20);
+    std::atomic<std::size_t> dropped{0};
+    std::atomic<bool> done{false};
+    std::size_t sentBytes = 0;
+
+    std::thread producer([&]() {
+        int index = 0;
+        for (int burst = 0; burst < 20; ++burst)
+        {
+            // Alternate large bursts (the ring grows) with trickles
+            // (the ring shrinks back while the consumer catches up).
+            const int lines = burst % 2 == 0 ? 200000 : 50;
+            for (int i = 0; i < lines; ++i, ++index)
+            {
+                const std::string line = "row-" + std::to_string(index) + "\n";
+                sentBytes += line.size();
+                queue.Append(line, dropped);
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+        done.store(true);
+        queue.WakeConsumer();
+    });
+
+    std::string carry;
+    std::size_t receivedBytes = 0;
+    std::size_t badLines = 0;
+    long long lastIndex = -1;
+    for (;;)
+    {
+        const std::span<const char> bytes = queue.Borrow(4096);
+        if (bytes.empty())
+        {
+            if (done.load() && queue.Empty())
+            {
+                break;
+            }
+            queue.WaitForBytes(5ms, [&] { return done.load(); });
+            continue;
+        }
+        receivedBytes += bytes.size();
+        carry.append(bytes.data(), bytes.size());
+        queue.ReleaseBorrowed();
+
+        std::size_t start = 0;
+        for (std::size_t newline = carry.find('\n'); newline != std::string::npos; newline = carry.find('\n', start))
+        {
+            const std::string_view line(carry.data() + start, newline - start);
+            const long long index = line.starts_with("row-") ? std::stoll(std::string(line.substr(4))) : -1;
+            if (index <= lastIndex)
+            {
+                ++badLines;
+            }
+            lastIndex = std::max(lastIndex, index);
+            start = newline + 1;
+        }
+        carry.erase(0, start);
+    }
+    producer.join();
+
+    CHECK(badLines == 0);
+    CHECK(carry.empty());
+    CHECK(receivedBytes + dropped.load() == sentBytes);
+}
@@ -0,0 +1,108 @@
+#include <loglib/internal/line_framer.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using loglib::internal::FindLastNewline;
+using loglib::internal::FramedLine;
+using loglib::internal::LineFramer;
+using loglib::internal::NewlineScanner;
+
+TEST_CASE("LineFramer: lines, offsets, and CR stripping match a memchr reference", "[line_framer]")
+{
+    // Random short lines, blank lines, CRLF endings, and an optional
+    // unterminated tail, so line ends land on and around block edges.
+    constexpr std::string_view ALPHABET = "ab \r\n\n";
+    std::mt19937 rng(99);
+    std::uniform_int_distribution<size_t> pick(0, ALPHABET.size() - 1);
+    std::uniform_int_distribution<size_t> length(0, 300);
+
+    for (int round = 0; round < 500; ++round)
+    {
+        std::string text(length(rng), 'x');
+        for (char &c : text)
+        {
+            c = ALPHABET[pick(rng)];
+        }
+        // Frame a batch in the middle of a larger buffer, as Stage B does.
+        std::string file("head\n");
+        file.append(text);
+        const char *begin = file.data() + 5;
+        const char *end = file.data() + file.size();
+
+        std::vector<uint64_t> expectedOffsets;
+        std::vector<std::string_view> expectedTexts;
+        for (const char *cursor = begin; cursor < end;)
+        {
+            const auto *newline =
+                static_cast<const char *>(std::memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+            const char *lineEnd = newline != nullptr ? newline : end;
+            std::string_view line(cursor, static_cast<size_t>(lineEnd - cursor));
+            if (!line.empty() && line.back() == '\r')
+            {
+                line.remove_suffix(1);
+            }
+            cursor = newline != nullptr ? newline + 1 : end;
+            expectedTexts.push_back(line);
+            expectedOffsets.push_back(static_cast<uint64_t>(cursor - file.data()) + (newline == nullptr ? 1U : 0U));
+        }
+
+        LineFramer framer(begin, end, end, file.data());
+        std::vector<uint64_t> offsets;
+        std::vector<std::string_view> texts;
+        FramedLine framed;
+        while (framer.Next(framed))
+        {
+            texts.push_back(framed.Text());
+            offsets.push_back(framed.nextOffset);
+        }
+        INFO("round=" << round);
+        CHECK(texts == expectedTexts);
+        CHECK(offsets == expectedOffsets);
+    }
+}
+
+TEST_CASE("LineFramer: Resume continues after a consumed prefix", "[line_framer]")
+{
+    const std::string file = "one\ntwo\nthree";
+    LineFramer framer(file.data(), file.data() + file.size(), file.data() + file.size(), file.data());
+
+    const FramedLine first = framer.LineAt(file.data());
+    CHECK(first.Text() == "one");
+    framer.Resume(first.next);
+
+    FramedLine framed;
+    REQUIRE(framer.Next(framed));
+    CHECK(framed.Text() == "two");
+    REQUIRE(framer.Next(framed));
+    CHECK(framed.Text() == "three");
+    // Unterminated: one past the end so `GetLine` keeps the last byte.
+    CHECK(framed.nextOffset == file.size() + 1);
+    CHECK_FALSE(framer.Next(framed));
+}
+
+TEST_CASE("NewlineScanner and FindLastNewline across blocks", "[line_framer]")
+{
+    std::string text(200, 'x');
+    text[3] = '\n';
+    text[64] = '\n';
+    text[130] = '\n';
+
+    NewlineScanner scanner(text, text.data() + text.size());
+    CHECK(scanner.Find(0) == 3);
+    CHECK(scanner.Find(4) == 64);
+    CHECK(scanner.Find(65) == 130);
+    CHECK(scanner.Find(131) == std::string_view::npos);
+
+    CHECK(FindLastNewline(text) == 130);
+    CHECK(FindLastNewline(std::string_view(text).substr(0, 130)) == 64);
+    CHECK(FindLastNewline(std::string_view(text).substr(0, 3)) == std::string_view::npos);
+    CHECK(FindLastNewline({}) == std::string_view::npos);
+}
@@ -19,6 +19,7 @@
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -723,3 +724,67 @@ TEST_CASE(
         CHECK(perm[4] == 0); // info
     }
 }
+
+TEST_CASE(
+    "SortPermutationByColumn scalar fast path agrees with CompareRows in both directions",
+    "[log_compare][sort_permutation][columnar]"
+)
+{
+    // The `Time` / `Integer` / `Floating` / `Boolean` fast path sorts
+    // on pre-materialised typed keys; it must reproduce the generic
+    // `CompareRows` order exactly, tail bucket and NaN placement
+    // included, with and without columnar storage.
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const auto ts = [](int64_t micros) { return LogValue{TimeStamp{std::chrono::microseconds{micros}}}; };
+    struct Case
+    {
+        LogConfiguration::Type type;
+        std::vector<LogValue> values;
+    };
+    const std::vector<Case> cases = {
+        {LogConfiguration::Type::Integer,
+         {int64_t{5}, std::monostate{}, int64_t{-3}, uint64_t{7}, nan, 2.9, std::string("x"), int64_t{5},
+          std::numeric_limits<uint64_t>::max(), -1e300}},
+        {LogConfiguration::Type::Floating,
+         {1.5, nan, std::monostate{}, int64_t{-2}, uint64_t{3}, nan, std::string("y"), 1.5, -0.25}},
+        {LogConfiguration::Type::Time,
+         {ts(300), ts(100), std::monostate{}, int64_t{200}, uint64_t{50}, std::string("z"), ts(100),
+          std::numeric_limits<uint64_t>::max()}},
+        {LogConfiguration::Type::Boolean, {true, false, std::monostate{}, int64_t{1}, true, false}},
+    };
+
+    for (const Case &testCase : cases)
+    {
+        const TestLogFile fixture("log_compare_scalar_sort.json");
+        fixture.Write("");
+        LogTable table = BuildSingleColumnTable(fixture, "v", testCase.type, testCase.values);
+        REQUIRE(table.Configuration().Configuration().columns[0].type == testCase.type);
+
+        std::vector<size_t> logRows(table.RowCount());
+        std::iota(logRows.begin(), logRows.end(), size_t{0});
+        // Reverse so input index and row index disagree.
+        std::ranges::reverse(logRows);
+
+        for (const bool ascending : {true, false})
+        {
+            std::vector<size_t> expected(logRows.size());
+            std::iota(expected.begin(), expected.end(), size_t{0});
+            std::ranges::stable_sort(expected, [&](size_t a, size_t b) {
+                const int cmp = CompareRows(table, logRows[a], logRows[b], 0);
+                return ascending ? cmp < 0 : cmp > 0;
+            });
+
+            for (const bool columnar : {false, true})
+            {
+                table.SetColumnarStorage(columnar);
+                const std::vector<size_t> perm =
+                    SortPermutationByColumn(table, std::span<const size_t>{logRows}, size_t{0}, ascending);
+                INFO(
+                    "type=" << static_cast<int>(testCase.type) << " ascending=" << ascending
+                            << " columnar=" << columnar
+                );
+                CHECK(perm == expected);
+            }
+        }
+    }
+}
@@ -1,15 +1,19 @@
 #include "common.hpp"
 
 #include <loglib/file_line_source.hpp>
+#include <loglib/internal/compact_log_value.hpp>
 #include <loglib/key_index.hpp>
 #include <loglib/log_data.hpp>
 #include <loglib/log_file.hpp>
 #include <loglib/log_line.hpp>
+#include <loglib/log_line_store.hpp>
 
 #include <catch2/catch_all.hpp>
 
 #include <memory>
+#include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace loglib;
@@ -85,3 +89,64 @@ TEST_CASE("Merge() should correctly combine sources, lines and keys from two Log
     CHECK(sortedKeys[0] == "key1");
     CHECK(sortedKeys[1] == "key2");
 }
+
+TEST_CASE("LogLineStore evicts whole chunks without moving surviving rows", "[LogData][log_line_store]")
+{
+    const TestLogFile testLogFile;
+    auto source = testLogFile.CreateFileLineSource();
+    const KeyIndex keys;
+
+    constexpr size_t CHUNK = LogLineStore::CHUNK_ROWS;
+    constexpr size_t TOTAL = (3 * CHUNK) + 10;
+    LogLineStore store;
+    for (size_t i = 0; i < TOTAL; ++i)
+    {
+        store.push_back(LogLine(std::vector<std::pair<KeyId, internal::CompactLogValue>>{}, keys, *source, i));
+    }
+    REQUIRE(store.size() == TOTAL);
+    CHECK(store.back().LineId() == TOTAL - 1);
+
+    // Rows in full chunks never move: pin one in the second chunk.
+    const LogLine *pinned = &store[CHUNK + 100];
+
+    store.EraseFront(CHUNK + 5);
+    REQUIRE(store.size() == TOTAL - CHUNK - 5);
+    CHECK(store.front().LineId() == CHUNK + 5);
+    CHECK(&store[95] == pinned);
+    CHECK(store.back().LineId() == TOTAL - 1);
+
+    // Segments tile the live range in row order.
+    size_t expected = 60;
+    size_t segments = 0;
+    store.ForEachSegment(55, store.size(), [&](std::span<LogLine> segment) {
+        ++segments;
+        for (const LogLine &line : segment)
+        {
+            CHECK(line.LineId() == CHUNK + expected);
+            ++expected;
+        }
+    });
+    CHECK(segments == 3);
+    CHECK(expected == TOTAL - CHUNK);
+
+    // Iteration agrees with indexing.
+    size_t row = 0;
+    for (const LogLine &line : store)
+    {
+        CHECK(&line == &store[row]);
+        ++row;
+    }
+    CHECK(row == store.size());
+
+    // Evicting up to a chunk boundary leaves a zero head offset.
+    store.EraseFront(CHUNK - 5);
+    CHECK(store.front().LineId() == 2 * CHUNK);
+
+    // Appends after eviction land at the tail.
+    store.push_back(LogLine(std::vector<std::pair<KeyId, internal::CompactLogValue>>{}, keys, *source, TOTAL));
+    CHECK(store.back().LineId() == TOTAL);
+    CHECK(store.size() == CHUNK + 11);
+
+    store.EraseFront(store.size() + 1);
+    CHECK(store.empty());
+}
@@ -4,6 +4,8 @@
 
 #include <catch2/catch_all.hpp>
 
+#include <string>
+
 using namespace loglib;
 
 TEST_CASE("Successfully open a valid log file", "[LogFile]")
@@ -198,3 +200,46 @@ TEST_CASE("LogFile: RegisterMultiLineRecord single-line span is a no-op", "[LogF
     CHECK(logFile->GetLine(1) == "Line 2");
     CHECK(logFile->GetLine(2) == "Line 3");
 }
+
+// Map options and access hints only change paging; every combination
+// must expose the same bytes, and out-of-range hints must be ignored.
+TEST_CASE("LogFile: map options and access hints leave content unchanged", "[LogFile][mmap-hints]")
+{
+    const TestLogFile testLogFile;
+    std::string content;
+    for (int i = 0; i < 2000; ++i)
+    {
+        content.append("Line ").append(std::to_string(i)).append("\n");
+    }
+    testLogFile.Write(content);
+
+    for (const bool populate : {false, true})
+    {
+        for (const bool hugePages : {false, true})
+        {
+            INFO("populate=" << populate << " hugePages=" << hugePages);
+            const LogFile logFile(
+                testLogFile.GetFilePath(),
+                testLogFile.GetFilePath(),
+                LogFile::MapOptions{.accessHints = true, .populate = populate, .hugePages = hugePages}
+            );
+            REQUIRE(logFile.Size() == content.size());
+
+            logFile.AdviseSequentialAccess();
+            logFile.AdviseWillNeed(5, 100);
+            logFile.AdviseWillNeed(content.size() - 1, 1'000'000);
+            logFile.AdviseWillNeed(content.size() + 4096, 1);
+            logFile.AdviseWillNeed(0, 0);
+            logFile.AdviseRandomAccess();
+
+            CHECK(std::string(logFile.Data(), logFile.Size()) == content);
+        }
+    }
+
+    const LogFile unhinted(
+        testLogFile.GetFilePath(), testLogFile.GetFilePath(), LogFile::MapOptions{.accessHints = false}
+    );
+    unhinted.AdviseWillNeed(0, content.size());
+    unhinted.AdviseRandomAccess();
+    CHECK(std::string(unhinted.Data(), unhinted.Size()) == content);
+}
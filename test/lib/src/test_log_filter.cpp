@@ -10,6 +10,7 @@
 #include <loglib/log_parse_sink.hpp>
 #include <loglib/log_table.hpp>
 #include <loglib/log_value.hpp>
+#include <loglib/trigram_query.hpp>
 
 #include <catch2/catch_all.hpp>
 
@@ -18,6 +19,7 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <optional>
@@ -929,6 +931,27 @@ CompiledFilterExpression MakeCompiledNot(CompiledFilterExpression child)
     return expr;
 }
 
+/// Leaf over column @p predicate targets; for the range predicates,
+/// which need no dictionary plumbing.
+CompiledFilterExpression MakeLeaf(RowPredicate predicate)
+{
+    CompiledFilterExpression expr;
+    const size_t column = RowPredicateColumn(predicate);
+    expr.node = CompiledFilterExpression::Leaf{std::move(predicate)};
+    expr.referencedColumns.push_back(column);
+    return expr;
+}
+
+CompiledFilterExpression MakeTimeLeaf(int64_t begin, int64_t end)
+{
+    return MakeLeaf(RowPredicate{std::in_place_type<TimeRangeRowPredicate>, size_t{0}, begin, end});
+}
+
+CompiledFilterExpression MakeNumericLeaf(std::optional<double> minValue, std::optional<double> maxValue)
+{
+    return MakeLeaf(RowPredicate{std::in_place_type<NumericRangeRowPredicate>, size_t{0}, minValue, maxValue});
+}
+
 } // namespace
 
 TEST_CASE("EvaluateExpression: default expression matches every row", "[log_filter][expression]")
@@ -1392,3 +1415,371 @@ TEST_CASE(
     const std::vector<size_t> accepted = FilterAcceptedRows(table, expr);
     CHECK(accepted.empty());
 }
+
+TEST_CASE(
+    "FilterAcceptedRows: row-range overload matches the full-table result on both paths", "[log_filter][expression]"
+)
+{
+    const TestLogFile fixture("log_filter_accepted_range.json");
+    fixture.Write("");
+    const LogTable table = BuildEnumTable(fixture, "category", {"a", "b", "c", "d", "e"}, 1'000);
+
+    // A flat `And` stays on the visit path; `Or` + `Not` takes the
+    // bitset path. Cover both.
+    std::vector<CompiledFilterExpression> visitChildren;
+    visitChildren.push_back(MakeEnumLeaf(table, 0, {"a", "b", "c"}));
+    visitChildren.push_back(MakeEnumLeaf(table, 0, {"c", "d"}));
+    const CompiledFilterExpression visitExpr = MakeCompiledAnd(std::move(visitChildren));
+
+    std::vector<CompiledFilterExpression> orChildren;
+    orChildren.push_back(MakeEnumLeaf(table, 0, {"a"}));
+    orChildren.push_back(MakeEnumLeaf(table, 0, {"b"}));
+    orChildren.push_back(MakeEnumLeaf(table, 0, {"c"}));
+    std::vector<CompiledFilterExpression> andChildren;
+    andChildren.push_back(MakeCompiledOr(std::move(orChildren)));
+    andChildren.push_back(MakeCompiledNot(MakeEnumLeaf(table, 0, {"b"})));
+    const CompiledFilterExpression bitsetExpr = MakeCompiledAnd(std::move(andChildren));
+
+    for (const CompiledFilterExpression *expr : {&visitExpr, &bitsetExpr})
+    {
+        const std::vector<size_t> full = FilterAcceptedRows(table, *expr);
+        // Unaligned bounds exercise the bitset's offset and tail mask.
+        const std::vector<std::pair<size_t, size_t>> ranges = {{0, 1'000}, {3, 67}, {130, 131}, {999, 1'000}};
+        for (const auto &[first, end] : ranges)
+        {
+            std::vector<size_t> expected;
+            std::ranges::copy_if(full, std::back_inserter(expected), [first, end](size_t row) {
+                return row >= first && row < end;
+            });
+            CHECK(FilterAcceptedRows(table, *expr, first, end) == expected);
+        }
+        // Empty and past-the-end ranges clamp to nothing.
+        CHECK(FilterAcceptedRows(table, *expr, 500, 500).empty());
+        CHECK(FilterAcceptedRows(table, *expr, 1'000, 2'000).empty());
+    }
+
+    // Match-all hands back the range itself.
+    const std::vector<size_t> all = FilterAcceptedRows(table, CompiledFilterExpression{}, 998, 5'000);
+    CHECK(all == std::vector<size_t>{998, 999});
+}
+
+TEST_CASE("EnumRowPredicate exposes indexable ids only when every value resolved", "[log_filter][enum][enum_index]")
+{
+    const TestLogFile fixture("log_filter_indexable_ids.json");
+    fixture.Write("");
+    const LogTable table = BuildEnumTable(fixture, "category", {"a", "b", "c"}, 30);
+    const EnumDictionary *dict = FindDictionary(table, "category");
+    REQUIRE(dict != nullptr);
+
+    const std::vector<std::string> resolved = {"c", "a", "c"};
+    const auto resolvedViews = ToViews(resolved);
+    const auto ids = EnumRowPredicate(0, resolvedViews, dict).IndexableIds();
+    REQUIRE(ids.has_value());
+    CHECK(*ids == std::vector<EnumValueId>{dict->Find("a"), dict->Find("c")});
+
+    // An unresolved value keeps the string set in play.
+    const std::vector<std::string> partial = {"a", "zzz"};
+    const auto partialViews = ToViews(partial);
+    CHECK_FALSE(EnumRowPredicate(0, partialViews, dict).IndexableIds().has_value());
+    CHECK_FALSE(EnumRowPredicate(0, resolvedViews, nullptr).IndexableIds().has_value());
+
+    // Empty selection matches nothing, index or not.
+    const std::vector<std::string_view> empty;
+    const auto none = EnumRowPredicate(0, empty, dict).IndexableIds();
+    REQUIRE(none.has_value());
+    CHECK(none->empty());
+}
+
+TEST_CASE("FilterAcceptedRows: enum index path matches the scan", "[log_filter][expression][enum_index]")
+{
+    const TestLogFile fixture("log_filter_enum_index.json");
+    fixture.Write("");
+    // 70'000 rows span two 65536-id chunks. `hot` fills 8 of every 20
+    // rows (bitmap containers), each `cN` one (array containers).
+    std::vector<std::string> vocabulary(8, "hot");
+    for (int i = 0; i < 12; ++i)
+    {
+        vocabulary.push_back("c" + std::to_string(i));
+    }
+    LogTable table = BuildEnumTable(fixture, "category", vocabulary, 70'000);
+    table.SetEnumIndexes(true);
+    REQUIRE(table.EnumIndex(0) != nullptr);
+    CHECK(table.EnumIndex(0)->RowCount(FindDictionary(table, "category")->Find("hot")) == 28'000);
+    CHECK(table.EnumIndexMemoryBytes() > 0);
+
+    std::vector<CompiledFilterExpression> expressions;
+    expressions.push_back(MakeEnumLeaf(table, 0, {"hot"}));
+    expressions.push_back(MakeEnumLeaf(table, 0, {"c7", "c1", "c3"}));
+    {
+        // Narrowed by the cheaper of two indexed `And` leaves.
+        std::vector<CompiledFilterExpression> children;
+        children.push_back(MakeEnumLeaf(table, 0, {"hot", "c2", "c5"}));
+        children.push_back(MakeEnumLeaf(table, 0, {"c5", "c9"}));
+        expressions.push_back(MakeCompiledAnd(std::move(children)));
+    }
+    {
+        // `Or` + `Not`: bitset path fed from the posting lists.
+        std::vector<CompiledFilterExpression> orChildren;
+        orChildren.push_back(MakeEnumLeaf(table, 0, {"c0"}));
+        orChildren.push_back(MakeEnumLeaf(table, 0, {"hot"}));
+        std::vector<CompiledFilterExpression> children;
+        children.push_back(MakeCompiledOr(std::move(orChildren)));
+        children.push_back(MakeCompiledNot(MakeEnumLeaf(table, 0, {"c0"})));
+        expressions.push_back(MakeCompiledAnd(std::move(children)));
+    }
+
+    const auto checkParity = [&table, &expressions]() {
+        const std::vector<std::pair<size_t, size_t>> ranges = {
+            {0, table.RowCount()}, {3, 70}, {65'530, 65'545}, {table.RowCount() - 1, table.RowCount()}
+        };
+        for (const CompiledFilterExpression &expr : expressions)
+        {
+            for (const auto &[first, end] : ranges)
+            {
+                std::vector<size_t> expected;
+                for (size_t row = first; row < end; ++row)
+                {
+                    if (EvaluateExpression(expr, table, row))
+                    {
+                        expected.push_back(row);
+                    }
+                }
+                CHECK(FilterAcceptedRows(table, expr, first, end) == expected);
+            }
+        }
+    };
+
+    checkParity();
+
+    // Eviction trims the posting heads; survivors renumber from 0.
+    table.EvictPrefixRows(40'001);
+    REQUIRE(table.RowCount() == 29'999);
+    REQUIRE(table.EnumIndex(0) != nullptr);
+    checkParity();
+
+    table.SetEnumIndexes(false);
+    CHECK(table.EnumIndex(0) == nullptr);
+    CHECK(table.EnumIndexMemoryBytes() == 0);
+}
+
+TEST_CASE("FilterAcceptedRows: zone map path matches the scan", "[log_filter][expression][zone_map]")
+{
+    const TestLogFile fixture("log_filter_zone_map.json");
+    fixture.Write("");
+    // Ascending integers over four 4096-row blocks, with gaps in block
+    // 1, a NaN in block 2 and a `uint64_t` 0 every 1000 rows (which a
+    // negative time bound still matches, see `TimeRangeRowPredicate`).
+    std::vector<LogValue> values;
+    for (int64_t row = 0; row < (3 * 4096) + 500; ++row)
+    {
+        if (row >= 4096 && row < 8192 && row % 9 == 0)
+        {
+            values.emplace_back(std::monostate{});
+        }
+        else if (row == 10'000)
+        {
+            values.emplace_back(std::numeric_limits<double>::quiet_NaN());
+        }
+        else if (row % 1000 == 999)
+        {
+            values.emplace_back(uint64_t{0});
+        }
+        else
+        {
+            values.emplace_back(row);
+        }
+    }
+    LogTable table = BuildSingleColumnTable(fixture, "n", LogConfiguration::Type::Number, values);
+    table.SetZoneMaps(true);
+    REQUIRE(table.ColumnZoneMap(0) != nullptr);
+    CHECK(table.ColumnZoneMap(0)->BlockCount() == 4);
+    CHECK(table.ZoneMapMemoryBytes() > 0);
+
+    std::vector<CompiledFilterExpression> expressions;
+    expressions.push_back(MakeNumericLeaf(0.0, 4095.0));
+    expressions.push_back(MakeNumericLeaf(5000.0, 6000.0));
+    expressions.push_back(MakeNumericLeaf(1e9, std::nullopt));
+    expressions.push_back(MakeNumericLeaf(std::nullopt, std::nullopt));
+    expressions.push_back(MakeTimeLeaf(-5, -1));
+    expressions.push_back(MakeTimeLeaf(100, 8000));
+    {
+        std::vector<CompiledFilterExpression> children;
+        children.push_back(MakeNumericLeaf(0.0, 9000.0));
+        children.push_back(MakeTimeLeaf(4000, 20'000));
+        expressions.push_back(MakeCompiledAnd(std::move(children)));
+    }
+    {
+        // `Or` + `Not`: bitset path with zoned leaves.
+        std::vector<CompiledFilterExpression> children;
+        children.push_back(MakeNumericLeaf(std::nullopt, 100.0));
+        children.push_back(MakeCompiledNot(MakeNumericLeaf(200.0, std::nullopt)));
+        children.push_back(MakeTimeLeaf(12'000, 12'100));
+        expressions.push_back(MakeCompiledOr(std::move(children)));
+    }
+
+    const auto checkParity = [&table, &expressions]() {
+        const std::vector<std::pair<size_t, size_t>> ranges = {
+            {0, table.RowCount()}, {3, 70}, {4090, 4200}, {table.RowCount() - 1, table.RowCount()}
+        };
+        for (const CompiledFilterExpression &expr : expressions)
+        {
+            for (const auto &[first, end] : ranges)
+            {
+                std::vector<size_t> expected;
+                for (size_t row = first; row < end; ++row)
+                {
+                    if (EvaluateExpression(expr, table, row))
+                    {
+                        expected.push_back(row);
+                    }
+                }
+                CHECK(FilterAcceptedRows(table, expr, first, end) == expected);
+            }
+        }
+    };
+
+    checkParity();
+
+    // Eviction keeps the straddling block's (wider) summary.
+    table.EvictPrefixRows(5'000);
+    REQUIRE(table.ColumnZoneMap(0) != nullptr);
+    CHECK(table.ColumnZoneMap(0)->BlockCount() == 3);
+    checkParity();
+
+    table.SetZoneMaps(false);
+    CHECK(table.ColumnZoneMap(0) == nullptr);
+    CHECK(table.ZoneMapMemoryBytes() == 0);
+}
+
+namespace
+{
+
+CompiledFilterExpression MakeTrigramLeaf(TrigramQuery query, CallbackStringRowPredicate::MatchFn match)
+{
+    CallbackStringRowPredicate predicate(0, std::move(match));
+    predicate.SetTrigrams(std::move(query));
+    return MakeLeaf(RowPredicate{std::move(predicate)});
+}
+
+CompiledFilterExpression MakeContainsLeaf(const std::string &needle)
+{
+    return MakeTrigramLeaf(TrigramQuery::ForLiteral(needle), [needle](std::string_view bytes) {
+        return bytes.find(needle) != std::string_view::npos;
+    });
+}
+
+} // namespace
+
+TEST_CASE("FilterAcceptedRows: trigram index path matches the scan", "[log_filter][expression][trigram_index]")
+{
+    const TestLogFile fixture("log_filter_trigram_index.json");
+    fixture.Write("");
+    // `blk<granule>-<row>` strings, an integer every 7th row (matched
+    // through the printFormat fallback, never through the index) and
+    // an empty cell every 11th row.
+    std::vector<LogValue> values;
+    for (int64_t row = 0; row < (12 * 256) + 100; ++row)
+    {
+        if (row % 11 == 0)
+        {
+            values.emplace_back(std::monostate{});
+        }
+        else if (row % 7 == 0)
+        {
+            values.emplace_back(row);
+        }
+        else
+        {
+            values.emplace_back("blk" + std::to_string(row / 256) + "-" + std::to_string(row));
+        }
+    }
+    LogTable table = BuildSingleColumnTable(fixture, "s", LogConfiguration::Type::Any, values);
+    CHECK_FALSE(table.TrigramCandidatesFor(TrigramQuery::ForLiteral("blk3-")).has_value());
+
+    table.SetTrigramIndex(true);
+    CHECK(table.TrigramIndexMemoryBytes() > 0);
+    const auto candidates = table.TrigramCandidatesFor(TrigramQuery::ForLiteral("blk3-"));
+    REQUIRE(candidates.has_value());
+    CHECK(candidates->GranuleCount() == 13);
+    CHECK(candidates->CandidateGranuleCount() == 1);
+
+    std::vector<CompiledFilterExpression> expressions;
+    expressions.push_back(MakeContainsLeaf("blk3-"));
+    expressions.push_back(MakeContainsLeaf("-2801"));
+    expressions.push_back(MakeContainsLeaf("zzz"));
+    // Row 2807 holds an integer, so only the fallback can find it.
+    expressions.push_back(MakeContainsLeaf("2807"));
+    // `blk1[0-9]-`, hand-matched.
+    expressions.push_back(
+        MakeTrigramLeaf(TrigramQuery::ForRegex("blk1[0-9]-"), [](std::string_view bytes) {
+            for (size_t at = bytes.find("blk1"); at != std::string_view::npos; at = bytes.find("blk1", at + 1))
+            {
+                if (at + 5 < bytes.size() && bytes[at + 4] >= '0' && bytes[at + 4] <= '9' && bytes[at + 5] == '-')
+                {
+                    return true;
+                }
+            }
+            return false;
+        })
+    );
+    {
+        std::vector<CompiledFilterExpression> children;
+        children.push_back(MakeContainsLeaf("blk2-"));
+        children.push_back(MakeContainsLeaf("-6"));
+        expressions.push_back(MakeCompiledAnd(std::move(children)));
+    }
+    {
+        // `Or` + `Not`: bitset path with trigram leaves.
+        std::vector<CompiledFilterExpression> children;
+        children.push_back(MakeContainsLeaf("blk5-"));
+        children.push_back(MakeCompiledNot(MakeContainsLeaf("blk")));
+        children.push_back(MakeContainsLeaf("-99"));
+        expressions.push_back(MakeCompiledOr(std::move(children)));
+    }
+
+    const auto checkParity = [&table, &expressions]() {
+        const std::vector<std::pair<size_t, size_t>> ranges = {
+            {0, table.RowCount()}, {3, 70}, {250, 1100}, {table.RowCount() - 1, table.RowCount()}
+        };
+        for (const CompiledFilterExpression &expr : expressions)
+        {
+            for (const auto &[first, end] : ranges)
+            {
+                std::vector<size_t> expected;
+                for (size_t row = first; row < end; ++row)
+                {
+                    if (EvaluateExpression(expr, table, row))
+                    {
+                        expected.push_back(row);
+                    }
+                }
+                CHECK(FilterAcceptedRows(table, expr, first, end) == expected);
+            }
+        }
+    };
+
+    checkParity();
+
+    // Eviction shifts the granules; the straddling one keeps its keys.
+    table.EvictPrefixRows(1'000);
+    REQUIRE(table.TrigramCandidatesFor(TrigramQuery::ForLiteral("blk3-")).has_value());
+    checkParity();
+
+    table.SetTrigramIndex(false);
+    CHECK_FALSE(table.TrigramCandidatesFor(TrigramQuery::ForLiteral("blk3-")).has_value());
+    CHECK(table.TrigramIndexMemoryBytes() == 0);
+}
+
+TEST_CASE("LogTable::EpochMicrosecondsRange reads the zone map", "[log_filter][time][zone_map]")
+{
+    const TestLogFile fixture("log_filter_zone_map_range.json");
+    fixture.Write("");
+    LogTable table = BuildTimeTable(fixture, "ts", {5'000, -20, 7'000'000, 300});
+    CHECK_FALSE(table.EpochMicrosecondsRange(0).has_value());
+
+    table.SetZoneMaps(true);
+    const auto range = table.EpochMicrosecondsRange(0);
+    REQUIRE(range.has_value());
+    CHECK(range->first == -20);
+    CHECK(range->second == 7'000'000);
+}
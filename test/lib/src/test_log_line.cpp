@@ -2,6 +2,8 @@
 
 #include <loglib/enum_dictionary.hpp>
 #include <loglib/internal/compact_log_value.hpp>
+#include <loglib/internal/line_field_slab.hpp>
+#include <loglib/internal/row_shape.hpp>
 #include <loglib/key_index.hpp>
 #include <loglib/log_line.hpp>
 
@@ -382,3 +384,128 @@ TEST_CASE("LogLine::IsDictRef discriminates DictRef slots from MmapSlice / Owned
     CHECK_FALSE(line.IsOwnedString(enumKey));
     CHECK(line.IsOwnedString(stringKey));
 }
+
+// Rows carrying the same key set share one interned `RowShape`; lookups through
+// its slot table must agree with the linear scan, including after a row grows a
+// key and after the `KeyIndex` moves (the registry travels with it).
+TEST_CASE("LogLine row shapes resolve keys like a linear scan", "[log_line][row_shape]")
+{
+    const TestLogFile testFile;
+    auto source = testFile.CreateFileLineSource();
+
+    KeyIndex keys;
+    const LogMap map{{"a", std::string("x")}, {"b", int64_t{2}}, {"c", true}};
+    LogLine first(map, keys, *source, 0);
+    LogLine second(map, keys, *source, 1);
+    const KeyId missing = keys.GetOrInsert("missing");
+
+    CHECK(keys.Shapes().Size() == 1);
+    // Shaped rows keep only their values; the KeyIds live in the shape.
+    CHECK(first.OwnedMemoryBytes() == 3 * sizeof(internal::CompactLogValue));
+    for (const LogLine *line : {&first, &second})
+    {
+        for (const auto &[id, value] : line->CompactValues())
+        {
+            CHECK(line->FindCompact(id) == &value);
+        }
+        CHECK(line->FindCompact(missing) == nullptr);
+        CHECK(line->FindCompact(KeyId{100000}) == nullptr);
+        CHECK(std::holds_alternative<std::monostate>(line->GetValue("missing")));
+    }
+
+    second.SetValue(missing, LogValue{std::string("now present")});
+    CHECK(keys.Shapes().Size() == 2);
+    CHECK(std::get<std::string>(second.GetValue("missing")) == "now present");
+    CHECK(std::get<int64_t>(second.GetValue("b")) == 2);
+    CHECK(first.FindCompact(missing) == nullptr);
+
+    KeyIndex moved = std::move(keys);
+    first.RebindKeys(moved);
+    second.RebindKeys(moved);
+    CHECK(moved.Shapes().Size() == 2);
+    CHECK(std::get<std::string>(first.GetValue("a")) == "x");
+    CHECK(std::get<std::string>(second.GetValue("missing")) == "now present");
+
+    // A different index with the same `KeyId` space interns the shape on its side.
+    KeyIndex other;
+    for (KeyId id = 0; id < moved.Size(); ++id)
+    {
+        static_cast<void>(other.GetOrInsert(moved.KeyOf(id)));
+    }
+    LogLine rebound(map, moved, *source, 2);
+    rebound.RebindKeys(other);
+    CHECK(other.Shapes().Size() == 1);
+    CHECK(std::get<bool>(rebound.GetValue("c")));
+}
+
+TEST_CASE("LogLine keeps per-field KeyIds for rows the shape registry declines", "[log_line][row_shape]")
+{
+    const TestLogFile testFile;
+    auto source = testFile.CreateFileLineSource();
+
+    KeyIndex keys;
+    const KeyId low = keys.GetOrInsert("low");
+    KeyId high = low;
+    while (high < internal::RowShapeRegistry::MAX_SHAPED_KEY_ID)
+    {
+        high = keys.GetOrInsert("pad" + std::to_string(high));
+    }
+
+    std::vector<std::pair<KeyId, internal::CompactLogValue>> values{
+        {low, internal::CompactLogValue::MakeInt64(1)},
+        {high, internal::CompactLogValue::MakeBool(true)},
+    };
+    LogLine line(std::move(values), keys, *source, 0);
+
+    CHECK(keys.Shapes().Size() == 0);
+    CHECK(line.OwnedMemoryBytes() == 2 * sizeof(std::pair<KeyId, internal::CompactLogValue>));
+    CHECK(std::get<int64_t>(line.GetValue(low)) == 1);
+    CHECK(std::get<bool>(line.GetValue(high)));
+
+    // Inserting a key keeps the keyed layout in KeyId order.
+    const KeyId mid = 1;
+    line.SetValue(mid, LogValue{std::string("mid")});
+    const auto fields = line.CompactValues();
+    REQUIRE(fields.size() == 3);
+    CHECK(fields[0].first == low);
+    CHECK(fields[1].first == mid);
+    CHECK(fields[2].first == high);
+}
+
+TEST_CASE("LogLine fields are carved from the installed LineFieldSlab", "[log_line][field_slab]")
+{
+    const TestLogFile testFile;
+    auto source = testFile.CreateFileLineSource();
+
+    KeyIndex keys;
+    const KeyId a = keys.GetOrInsert("a");
+    const KeyId b = keys.GetOrInsert("b");
+
+    // The slab outlives the rows carved from it, as the `LogFile` does.
+    internal::LineFieldSlab slab(256);
+    std::vector<LogLine> lines;
+    {
+        const internal::ScopedLineFieldSlab scope(slab);
+        for (int64_t i = 0; i < 64; ++i)
+        {
+            std::vector<std::pair<KeyId, internal::CompactLogValue>> values{
+                {a, internal::CompactLogValue::MakeInt64(i)},
+                {b, internal::CompactLogValue::MakeBool(true)},
+            };
+            lines.emplace_back(std::move(values), keys, *source, static_cast<size_t>(i));
+        }
+    }
+    CHECK(internal::CurrentLineFieldSlab() == nullptr);
+    CHECK(slab.UsedBytes() == 64 * 2 * sizeof(internal::CompactLogValue));
+    CHECK(slab.MemoryBytes() >= slab.UsedBytes());
+
+    // Growing a slab-backed row moves it to the heap without freeing the slab block.
+    const KeyId c = keys.GetOrInsert("c");
+    lines[10].SetValue(c, LogValue{std::string("grown")});
+    CHECK(slab.UsedBytes() == 64 * 2 * sizeof(internal::CompactLogValue));
+    CHECK(std::get<int64_t>(lines[10].GetValue(a)) == 10);
+    CHECK(std::get<std::string>(lines[10].GetValue(c)) == "grown");
+    CHECK(std::get<int64_t>(lines[63].GetValue(a)) == 63);
+
+    lines.clear();
+}
@@ -8,6 +8,7 @@
 #include <loglib/key_index.hpp>
 #include <loglib/log_configuration.hpp>
 #include <loglib/log_data.hpp>
+#include <loglib/log_filter.hpp>
 #include <loglib/log_level.hpp>
 #include <loglib/log_line.hpp>
 #include <loglib/log_parse_sink.hpp>
@@ -3661,3 +3662,174 @@ TEST_CASE(
     // `ColumnCount` is the closest observable proxy.
     CHECK(table.ColumnCount() == 1);
 }
+
+namespace
+{
+
+/// Every (row, column) read the columnar mirror serves, captured so the
+/// same table can be compared with the mirror on and off.
+struct ColumnarReadSnapshot
+{
+    std::vector<LogValue> values;
+    std::vector<std::optional<EnumValueId>> enumIds;
+    std::vector<std::optional<int64_t>> epochMicros;
+};
+
+ColumnarReadSnapshot SnapshotColumnarReads(const LogTable &table)
+{
+    ColumnarReadSnapshot snapshot;
+    for (size_t row = 0; row < table.RowCount(); ++row)
+    {
+        for (size_t column = 0; column < table.ColumnCount(); ++column)
+        {
+            snapshot.values.push_back(table.GetValue(row, column));
+            snapshot.enumIds.push_back(table.GetEnumValueId(row, column));
+            snapshot.epochMicros.push_back(table.GetEpochMicroseconds(row, column));
+        }
+    }
+    return snapshot;
+}
+
+/// Read the table through the (incrementally maintained) mirror, then
+/// through the row walk, and require both to agree. Leaves the mirror
+/// enabled (rebuilt from scratch).
+void RequireColumnarMatchesRowWalk(LogTable &table)
+{
+    REQUIRE(table.ColumnarStorageEnabled());
+    for (size_t column = 0; column < table.ColumnCount(); ++column)
+    {
+        const internal::DenseColumn *dense = table.ColumnarView(column);
+        REQUIRE(dense != nullptr);
+        REQUIRE(dense->Size() == table.RowCount());
+    }
+    const ColumnarReadSnapshot columnar = SnapshotColumnarReads(table);
+    table.SetColumnarStorage(false);
+    CHECK(table.ColumnarView(0) == nullptr);
+    CHECK(table.ColumnarMemoryBytes() == 0);
+    const ColumnarReadSnapshot rowWalk = SnapshotColumnarReads(table);
+    table.SetColumnarStorage(true);
+
+    REQUIRE(columnar.values.size() == rowWalk.values.size());
+    for (size_t i = 0; i < columnar.values.size(); ++i)
+    {
+        INFO("slot " << i);
+        CHECK(LogValueEquivalent(columnar.values[i], rowWalk.values[i]));
+        CHECK(columnar.enumIds[i] == rowWalk.enumIds[i]);
+        CHECK(columnar.epochMicros[i] == rowWalk.epochMicros[i]);
+    }
+}
+
+} // namespace
+
+TEST_CASE(
+    "LogTable columnar storage mirrors the row walk across appends, promotion, moves and eviction",
+    "[log_table][columnar]"
+)
+{
+    const TestLogFile testFile("columnar.json");
+    testFile.Write("");
+    auto source = testFile.CreateFileLineSource();
+    FileLineSource *sourcePtr = source.get();
+
+    LogTable table;
+    table.BeginStreaming(std::move(source));
+    table.SetColumnarStorage(true);
+    CHECK(table.ColumnarStorageEnabled());
+
+    KeyIndex &keys = table.Keys();
+    constexpr size_t BATCH_ROWS = 40;
+    constexpr size_t BATCHES = 3;
+    const std::array<std::string_view, 3> levels = {"info", "warn", "error"};
+    size_t prevKeyCount = 0;
+    for (size_t batchIndex = 0; batchIndex < BATCHES; ++batchIndex)
+    {
+        std::vector<std::vector<std::pair<std::string, LogValue>>> rows;
+        for (size_t i = 0; i < BATCH_ROWS; ++i)
+        {
+            const size_t n = (batchIndex * BATCH_ROWS) + i;
+            std::vector<std::pair<std::string, LogValue>> fields;
+            fields.emplace_back("count", static_cast<int64_t>(n));
+            // Sparse column: every third row leaves it absent.
+            if (n % 3 != 0)
+            {
+                fields.emplace_back("ratio", static_cast<double>(n) / 4.0);
+            }
+            fields.emplace_back("flag", n % 2 == 0);
+            fields.emplace_back("level", std::string(levels[n % levels.size()]));
+            fields.emplace_back("msg", "message " + std::to_string(n));
+            // Second batch onward grows a new column mid-stream.
+            if (batchIndex > 0)
+            {
+                fields.emplace_back("late", TimeStamp{std::chrono::microseconds{static_cast<int64_t>(n) * 1000}});
+            }
+            rows.push_back(std::move(fields));
+        }
+        table.AppendBatch(BuildStreamedBatch(keys, *sourcePtr, rows, prevKeyCount, (batchIndex * BATCH_ROWS) + 1));
+        prevKeyCount = keys.Size();
+        table.ApplyPendingLevelBubbles();
+        RequireColumnarMatchesRowWalk(table);
+    }
+    CHECK(table.ColumnarMemoryBytes() > 0);
+
+    // Streaming promotes the low-cardinality column eagerly; the mirror
+    // must carry `DictRef` slots for it after the rebuild.
+    const int levelColumn = table.FindColumnIndexByKey(keys.Find(std::string("level")));
+    REQUIRE(levelColumn >= 0);
+    REQUIRE(table.GetEnumValueId(0, static_cast<size_t>(levelColumn)).has_value());
+
+    table.MoveColumn(0, table.ColumnCount() - 1);
+    RequireColumnarMatchesRowWalk(table);
+
+    table.EvictPrefixRows(BATCH_ROWS + 5);
+    REQUIRE(table.RowCount() == (BATCHES * BATCH_ROWS) - BATCH_ROWS - 5);
+    RequireColumnarMatchesRowWalk(table);
+
+    table.FinalizeAutoDetection();
+    RequireColumnarMatchesRowWalk(table);
+}
+
+TEST_CASE("LogTable columnar storage leaves filter results unchanged", "[log_table][columnar][log_filter]")
+{
+    const TestLogFile testFile("columnar_filter.json");
+    testFile.Write("");
+    auto source = testFile.CreateFileLineSource();
+    FileLineSource *sourcePtr = source.get();
+
+    LogTable table;
+    table.BeginStreaming(std::move(source));
+    KeyIndex &keys = table.Keys();
+
+    std::vector<std::vector<std::pair<std::string, LogValue>>> rows;
+    for (int64_t n = 0; n < 200; ++n)
+    {
+        std::vector<std::pair<std::string, LogValue>> fields;
+        fields.emplace_back("count", n);
+        fields.emplace_back("flag", n % 5 == 0);
+        if (n % 7 != 0)
+        {
+            fields.emplace_back("ts", TimeStamp{std::chrono::microseconds{n * 10}});
+        }
+        rows.push_back(std::move(fields));
+    }
+    table.AppendBatch(BuildStreamedBatch(keys, *sourcePtr, rows, 0, 1));
+
+    const auto columnOf = [&](const char *key) {
+        const int column = table.FindColumnIndexByKey(keys.Find(std::string(key)));
+        REQUIRE(column >= 0);
+        return static_cast<size_t>(column);
+    };
+    std::vector<CompiledFilterExpression> expressions(3);
+    expressions[0].node = CompiledFilterExpression::Leaf{NumericRangeRowPredicate(columnOf("count"), 20.0, 120.0)};
+    expressions[1].node = CompiledFilterExpression::Leaf{BoolRowPredicate(columnOf("flag"), true, false)};
+    expressions[2].node = CompiledFilterExpression::Leaf{TimeRangeRowPredicate(columnOf("ts"), 500, 1500)};
+
+    for (const CompiledFilterExpression &expression : expressions)
+    {
+        table.SetColumnarStorage(false);
+        const std::vector<size_t> rowWalk = FilterAcceptedRows(table, expression);
+        table.SetColumnarStorage(true);
+        const std::vector<size_t> columnar = FilterAcceptedRows(table, expression);
+        CHECK_FALSE(rowWalk.empty());
+        CHECK(columnar == rowWalk);
+    }
+}
@@ -140,6 +140,45 @@ TEST_CASE("Quoted value with C-style escapes [logfmt]", "[logfmt_parser]")
     CHECK(loglib::AsStringView(values.at("msg")) == std::string_view{expected});
 }
 
+TEST_CASE("Fields crossing 64-byte classification blocks [logfmt]", "[logfmt_parser]")
+{
+    // The tokenizer classifies 64 bytes at a time; keys, escapes, and
+    // terminators straddling a block edge must land exactly as in the
+    // byte-at-a-time scanner, and non-ASCII bytes must not read as controls.
+    const std::string longKey(70, 'k');
+    std::string quoted(61, 'q');
+    quoted.append("\\\"");
+    quoted.append(80, 'r');
+    const std::string bareValue = std::string(60, 'b') + "=\xe9\xe9" + std::string(10, 'c');
+
+    std::string line = longKey;
+    line.append("=1 msg=\"");
+    line.append(quoted);
+    line.append("\" \t  tail=");
+    line.append(bareValue);
+    line.append(" flag");
+
+    const loglib::LogfmtParser parser;
+    const TestLogFile file;
+    file.Write(line + "\n" + line + "\n");
+
+    auto result = loglib::ParseFile(parser, file.GetFilePath());
+    REQUIRE(result.errors.empty());
+    REQUIRE(result.data.Lines().size() == 2);
+
+    std::string expectedMsg(61, 'q');
+    expectedMsg.push_back('"');
+    expectedMsg.append(80, 'r');
+    for (const auto &logLine : result.data.Lines())
+    {
+        const auto values = logLine.Values();
+        CHECK(std::get<uint64_t>(values.at(longKey)) == 1);
+        CHECK(loglib::AsStringView(values.at("msg")) == std::string_view{expectedMsg});
+        CHECK(loglib::AsStringView(values.at("tail")) == std::string_view{bareValue});
+        CHECK(std::holds_alternative<std::monostate>(values.at("flag")));
+    }
+}
+
 TEST_CASE("Unterminated quoted value reports a parse error [logfmt]", "[logfmt_parser]")
 {
     const loglib::LogfmtParser parser;
@@ -0,0 +1,118 @@
+#include <loglib/internal/owned_string_arena.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using loglib::internal::OwnedStringArena;
+
+TEST_CASE("OwnedStringArena resolves chunks adopted out of reservation order", "[owned_string_arena]")
+{
+    OwnedStringArena arena;
+    const uint64_t first = arena.Reserve(5);
+    const uint64_t second = arena.Reserve(6);
+    const uint64_t third = arena.Reserve(5);
+    CHECK(first == 0);
+    CHECK(second == 5);
+    CHECK(third == 11);
+    CHECK(arena.End() == 16);
+
+    arena.Adopt(third, "third");
+    arena.Adopt(first, "first");
+    arena.Adopt(second, "second");
+
+    CHECK(arena.Bytes(first, 5) == "first");
+    CHECK(arena.Bytes(second, 6) == "second");
+    CHECK(arena.Bytes(third + 1, 3) == "hir");
+    CHECK(arena.Bytes(second, 0).empty());
+
+    // Ranges crossing a chunk boundary or past the end resolve empty.
+    CHECK(arena.Bytes(first + 3, 4).empty());
+    CHECK(arena.Bytes(arena.End(), 1).empty());
+    CHECK(arena.Bytes(1000, 2).empty());
+}
+
+TEST_CASE("OwnedStringArena extends in place only when the range is free", "[owned_string_arena]")
+{
+    OwnedStringArena arena;
+
+    SECTION("Append packs writes while nothing is reserved past the tail")
+    {
+        CHECK(arena.Append("first") == 0);
+        CHECK(arena.Append("second") == 5);
+        CHECK(arena.Bytes(0, 11) == "firstsecond");
+        CHECK(arena.End() == 11);
+    }
+
+    SECTION("A reservation past the tail forces a fresh range")
+    {
+        const uint64_t head = arena.Append("head");
+        const uint64_t pending = arena.Reserve(3);
+        CHECK_FALSE(arena.TryExtend(head + 4, "more"));
+        const uint64_t moved = arena.Append("tail");
+        CHECK(moved == pending + 3);
+        arena.Adopt(pending, "mid");
+        CHECK(arena.Bytes(head, 4) == "head");
+        CHECK(arena.Bytes(pending, 3) == "mid");
+        CHECK(arena.Bytes(moved, 4) == "tail");
+    }
+
+    SECTION("Spare span absorbs extensions behind later reservations")
+    {
+        const uint64_t held = arena.Reserve(8);
+        arena.Adopt(held, "abc", 8);
+        const uint64_t later = arena.Reserve(4);
+        arena.Adopt(later, "next");
+
+        CHECK(arena.TryExtend(held + 3, "defgh"));
+        CHECK(arena.Bytes(held, 8) == "abcdefgh");
+        CHECK_FALSE(arena.TryExtend(held + 8, "i"));
+        CHECK(arena.Bytes(later, 4) == "next");
+        // Offsets only extend from the end of a string.
+        CHECK_FALSE(arena.TryExtend(held + 2, "x"));
+    }
+}
+
+TEST_CASE("OwnedStringArena reads stay correct when an adopt shifts the cached chunk", "[owned_string_arena]")
+{
+    OwnedStringArena arena;
+    const uint64_t first = arena.Reserve(5);
+    const uint64_t second = arena.Reserve(6);
+    const uint64_t third = arena.Reserve(5);
+    arena.Adopt(first, "first");
+    arena.Adopt(third, "third");
+
+    // Warm the cached chunk on `third`, then insert a chunk before it.
+    CHECK(arena.Bytes(third, 5) == "third");
+    CHECK(arena.Bytes(second, 6).empty());
+    arena.Adopt(second, "second");
+    CHECK(arena.Bytes(third, 5) == "third");
+    CHECK(arena.Bytes(second, 6) == "second");
+    CHECK(arena.Bytes(first, 5) == "first");
+
+    // Forward, backward and repeated walks all resolve the same bytes.
+    const std::vector<std::pair<uint64_t, std::string_view>> walk = {
+        {first, "first"},
+        {second, "second"},
+        {third, "third"},
+        {third, "third"},
+        {second, "second"},
+        {first, "first"},
+        {third, "third"},
+    };
+    for (const auto &[offset, expected] : walk)
+    {
+        CHECK(arena.Bytes(offset, expected.size()) == expected);
+    }
+
+    // Spare span past a chunk's bytes still resolves empty.
+    const uint64_t spare = arena.Reserve(8);
+    arena.Adopt(spare, "ab", 8);
+    CHECK(arena.Bytes(spare, 2) == "ab");
+    CHECK(arena.Bytes(spare + 4, 1).empty());
+    CHECK(arena.Bytes(spare + 1, 1) == "b");
+}
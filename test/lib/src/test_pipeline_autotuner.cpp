@@ -0,0 +1,149 @@
+#include <loglib/internal/advanced_parser_options.hpp>
+#include <loglib/internal/pipeline_autotuner.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+using loglib::internal::AdvancedParserOptions;
+using loglib::internal::PipelineAutotuner;
+using loglib::internal::PipelineTuning;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+/// Feed @p batches identical observations at the tuner's current size,
+/// with Stage B / Stage C costs proportional to the bytes cut.
+void ObserveBatches(
+    PipelineAutotuner &tuner,
+    size_t batches,
+    size_t bytesPerLine,
+    std::chrono::nanoseconds stageBPerKiB,
+    std::chrono::nanoseconds stageCPerKiB
+)
+{
+    for (size_t i = 0; i < batches; ++i)
+    {
+        const size_t bytes = tuner.BatchSizeBytes();
+        const auto kib = static_cast<std::chrono::nanoseconds::rep>(bytes / 1024);
+        tuner.Observe(bytes, bytes / bytesPerLine, stageBPerKiB * kib, stageCPerKiB * kib);
+    }
+}
+
+} // namespace
+
+TEST_CASE("PipelineAutotuner sizes batches from Stage B latency and line width", "[pipeline_autotuner]")
+{
+    AdvancedParserOptions advanced;
+    advanced.threads = 4;
+    std::vector<PipelineTuning> reports;
+    advanced.onTuning = [&reports](const PipelineTuning &tuning) { reports.push_back(tuning); };
+
+    SECTION("cheap narrow lines grow the batch, at most 2x per batch")
+    {
+        PipelineAutotuner tuner(advanced, 4, 8, 4);
+        // 1 us/KiB: the 10 ms latency target allows ~10 MiB.
+        ObserveBatches(tuner, PipelineAutotuner::CALIBRATION_BATCHES - 1, 100, 1us, 100ns);
+        CHECK(tuner.BatchSizeBytes() == AdvancedParserOptions::DEFAULT_BATCH_SIZE_BYTES);
+        CHECK(reports.empty());
+        ObserveBatches(tuner, 1, 100, 1us, 100ns);
+        CHECK(tuner.BatchSizeBytes() == 2 * AdvancedParserOptions::DEFAULT_BATCH_SIZE_BYTES);
+        ObserveBatches(tuner, 16, 100, 1us, 100ns);
+        CHECK(tuner.BatchSizeBytes() == PipelineAutotuner::MAX_BATCH_BYTES);
+        REQUIRE_FALSE(reports.empty());
+        CHECK(reports.back().batchSizeBytes == PipelineAutotuner::MAX_BATCH_BYTES);
+        CHECK(reports.back().bytesPerLine == Catch::Approx(100.0).epsilon(0.01));
+    }
+
+    SECTION("expensive wide lines shrink the batch towards the latency target")
+    {
+        PipelineAutotuner tuner(advanced, 4, 8, 4);
+        // 50 us/KiB: 10 ms is ~200 KiB, above the 4096-line floor for 16-byte lines.
+        ObserveBatches(tuner, 32, 16, 50us, 1us);
+        CHECK(tuner.BatchSizeBytes() >= PipelineAutotuner::MIN_BATCH_BYTES);
+        CHECK(tuner.BatchSizeBytes() <= 256 * 1024);
+        CHECK(tuner.BatchSizeBytes() % PipelineAutotuner::BATCH_SIZE_GRANULE == 0);
+    }
+
+    SECTION("the line floor keeps slow narrow lines from tiny batches")
+    {
+        PipelineAutotuner tuner(advanced, 4, 8, 4);
+        // The latency target alone would cut ~20 KiB; 4096 lines of 200 bytes need ~800 KiB.
+        ObserveBatches(tuner, 32, 200, 500us, 1us);
+        CHECK(tuner.BatchSizeBytes() >= PipelineAutotuner::MIN_LINES_PER_BATCH * 200);
+    }
+
+    SECTION("autotune=false pins the configured size")
+    {
+        advanced.autotune = false;
+        advanced.batchSizeBytes = 24;
+        PipelineAutotuner tuner(advanced, 4, 8, 4);
+        ObserveBatches(tuner, 32, 8, 1us, 100ns);
+        CHECK(tuner.BatchSizeBytes() == 24);
+        CHECK(reports.empty());
+    }
+
+    SECTION("an explicit batch size is kept even with autotune on")
+    {
+        for (const size_t explicitBytes : {size_t{16}, size_t{64}, size_t{4 * 1024}, size_t{2 * 1024 * 1024}})
+        {
+            advanced.batchSizeBytes = explicitBytes;
+            PipelineAutotuner tuner(advanced, 4, 8, 4);
+            ObserveBatches(tuner, 32, 8, 1us, 100ns);
+            CHECK(tuner.BatchSizeBytes() == explicitBytes);
+        }
+        CHECK(reports.empty());
+    }
+}
+
+TEST_CASE("PipelineAutotuner widens the pipeline only when Stage B is the bottleneck", "[pipeline_autotuner]")
+{
+    AdvancedParserOptions advanced;
+    advanced.batchSizeBytes = PipelineAutotuner::MIN_BATCH_BYTES;
+    std::vector<PipelineTuning> reports;
+    advanced.onTuning = [&reports](const PipelineTuning &tuning) { reports.push_back(tuning); };
+
+    SECTION("Stage B at 20x Stage C on 8 workers asks for 20 of 32 cores")
+    {
+        PipelineAutotuner tuner(advanced, 8, 16, 32);
+        ObserveBatches(tuner, PipelineAutotuner::CALIBRATION_BATCHES, 100, 20us, 1us);
+        REQUIRE(tuner.ReplanPending());
+        tuner.Replan();
+        CHECK_FALSE(tuner.ReplanPending());
+        CHECK(tuner.Current().threads == 20);
+        CHECK(tuner.Current().ntokens == 40);
+        CHECK(reports.back().threads == 20);
+
+        // The decision is made once per parse.
+        ObserveBatches(tuner, 32, 100, 200us, 1us);
+        CHECK_FALSE(tuner.ReplanPending());
+    }
+
+    SECTION("the core count caps the widening")
+    {
+        PipelineAutotuner tuner(advanced, 8, 16, 12);
+        ObserveBatches(tuner, PipelineAutotuner::CALIBRATION_BATCHES, 100, 20us, 1us);
+        REQUIRE(tuner.ReplanPending());
+        tuner.Replan();
+        CHECK(tuner.Current().threads == 12);
+    }
+
+    SECTION("a Stage C bottleneck keeps the starting workers")
+    {
+        PipelineAutotuner tuner(advanced, 8, 16, 32);
+        ObserveBatches(tuner, 32, 100, 4us, 1us);
+        CHECK_FALSE(tuner.ReplanPending());
+        CHECK(tuner.Current().threads == 8);
+    }
+
+    SECTION("an explicit thread count is never changed")
+    {
+        advanced.threads = 8;
+        PipelineAutotuner tuner(advanced, 8, 16, 32);
+        ObserveBatches(tuner, 32, 100, 20us, 1us);
+        CHECK_FALSE(tuner.ReplanPending());
+    }
+}
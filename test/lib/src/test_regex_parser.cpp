@@ -176,6 +176,73 @@ TEST_CASE("RegexParser non-matching lines surface as errors [regex]", "[regex_pa
     CHECK(result.errors[0].contains("did not match"));
 }
 
+TEST_CASE("RegexParser delimiter-only patterns split like PCRE2 [regex]", "[regex_parser]")
+{
+    // The first pattern takes the positional splitter; the trailing
+    // `(?:)` keeps the second one on PCRE2. Both must produce the same
+    // rows and the same per-line errors.
+    const RegexParser split(R"(^(?<ts>[^|]+)\|(?<level>[^|]*)\|(?<message>.*)$)");
+    const RegexParser pcre(R"(^(?<ts>[^|]+)\|(?<level>[^|]*)\|(?<message>.*)(?:)$)");
+    const TestLogFile file("regex_delimited.log");
+    file.Write(
+        "2024-01-01|INFO|started\n"
+        "2024-01-02||empty level\n"
+        "2024-01-03|WARN|pipes | in | message\r\n"
+        "|INFO|missing timestamp\n"
+        "2024-01-04|no second delimiter\n"
+        "2024-01-05|ERROR|\n"
+        "17|42|7\n"
+    );
+
+    auto splitResult = ParseFile(split, file.GetFilePath());
+    auto pcreResult = ParseFile(pcre, file.GetFilePath());
+    CHECK(splitResult.errors == pcreResult.errors);
+    REQUIRE(splitResult.errors.size() == 2);
+    REQUIRE(splitResult.data.Lines().size() == pcreResult.data.Lines().size());
+    for (size_t i = 0; i < splitResult.data.Lines().size(); ++i)
+    {
+        CHECK(split.ToString(splitResult.data.Lines()[i]) == pcre.ToString(pcreResult.data.Lines()[i]));
+    }
+
+    REQUIRE(splitResult.data.Lines().size() == 5);
+    CHECK(AsStringView(splitResult.data.Lines()[2].GetValue("message")) == std::string_view{"pipes | in | message"});
+    CHECK_FALSE(splitResult.data.Lines()[3].Values().contains("message"));
+    CHECK(std::get<std::uint64_t>(splitResult.data.Lines()[4].GetValue("level")) == 42U);
+}
+
+TEST_CASE("RegexParser first-byte prefilter keeps matches and rejects the rest [regex]", "[regex_parser]")
+{
+    // Every match of these anchored patterns starts with `[` (or a
+    // letter of either case under `(?i)`); lines starting elsewhere are
+    // rejected before PCRE2 runs, with the usual no-match error.
+    const RegexParser bracketed(R"(^\[(?<level>\w+)\] (?<message>.*)$)");
+    const TestLogFile file("regex_first_byte.log");
+    file.Write(
+        "[INFO] started\n"
+        "INFO] no bracket\n"
+        "[WARN] disk\n"
+    );
+    auto result = ParseFile(bracketed, file.GetFilePath());
+    REQUIRE(result.data.Lines().size() == 2);
+    REQUIRE(result.errors.size() == 1);
+    CHECK(result.errors[0].contains("line 2"));
+    CHECK(result.errors[0].contains("did not match"));
+
+    const RegexParser caseless(R"((?i)^user\s+(?<id>\d+)$)");
+    const TestLogFile mixed("regex_first_byte_caseless.log");
+    mixed.Write(
+        "user 1\n"
+        "USER 2\n"
+        "xuser 3\n"
+    );
+    auto caselessResult = ParseFile(caseless, mixed.GetFilePath());
+    REQUIRE(caselessResult.data.Lines().size() == 2);
+    CHECK(caselessResult.errors.size() == 1);
+
+    CHECK(PatternMatchesLine(R"(^\[(?<level>\w+)\] (?<message>.*)$)", "[INFO] started"));
+    CHECK_FALSE(PatternMatchesLine(R"(^\[(?<level>\w+)\] (?<message>.*)$)", "INFO] started"));
+}
+
 TEST_CASE("RegexParser optional unmatched groups -> monostate [regex]", "[regex_parser]")
 {
     // `pid` is optional: absent on line 1, present on line 2.
@@ -447,6 +447,40 @@ TEST_CASE("Unanchored user templates cannot substring-match the probe [regex_tem
     SetExtraRegexTemplates({});
 }
 
+TEST_CASE("Probe order decides among many first-byte candidates [regex_templates]", "[regex_templates]")
+{
+    // Forty extras share the leading `ID ` literal, so every one
+    // survives the first-byte prefilter and the probe takes its
+    // parallel path. Two of them match the fixture; registration
+    // order is the reverse of priority order, and the lower priority
+    // (earlier-probed) of the two must win regardless of which
+    // worker finishes first.
+    constexpr int EXTRA_COUNT = 40;
+    std::vector<RegexTemplate> extras;
+    for (int i = 0; i < EXTRA_COUNT; ++i)
+    {
+        const bool matches = i == 5 || i == 30;
+        extras.push_back(RegexTemplate{
+            .name = std::string("Shared prefix ").append(std::to_string(i)),
+            .pattern = matches ? std::string(R"(^ID (?<tag>T\d+) (?<msg>.*)$)")
+                               : std::string("^ID (?<tag>X").append(std::to_string(i)).append(") (?<msg>.*)$"),
+            .sampleLines = {},
+            .autoDetect = true,
+            .priority = USER_TEMPLATE_DEFAULT_PRIORITY + EXTRA_COUNT - i,
+            .description = "",
+        });
+    }
+    SetExtraRegexTemplates(extras);
+
+    const auto detected = DetectRegexTemplateFromBytes("ID T1 first\nID T2 second\nID T3 third\n");
+    REQUIRE(detected.has_value());
+    CHECK(detected->name == "Shared prefix 30");
+
+    CHECK_FALSE(DetectRegexTemplateFromBytes("ID Y1 first\nID Y2 second\n").has_value());
+
+    SetExtraRegexTemplates({});
+}
+
 TEST_CASE(
     "Java template captures logger separately from message for colon-fused lines [regex_templates]", "[regex_templates]"
 )
@@ -0,0 +1,168 @@
+#include <loglib/internal/seek_index.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+using loglib::internal::GzipSeekIndex;
+using loglib::internal::GzipSeekPoint;
+using loglib::internal::LoadGzipSeekIndex;
+using loglib::internal::SaveGzipSeekIndex;
+using loglib::internal::SeekIndexFingerprint;
+using loglib::internal::SeekIndexPath;
+
+namespace
+{
+
+/// Unique scratch directory holding a fake compressed source and the
+/// sidecar cache; removed on destruction.
+class SeekIndexFixture
+{
+public:
+    SeekIndexFixture()
+    {
+        std::random_device rd;
+        std::ostringstream name;
+        name << "slv-seek-index-" << std::hex << ((static_cast<std::uint64_t>(rd()) << 32) | rd());
+        mRoot = std::filesystem::temp_directory_path() / name.str();
+        std::filesystem::create_directories(mRoot);
+        WriteSource(std::string(64 * 1024, 'z'));
+    }
+
+    ~SeekIndexFixture()
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(mRoot, ec);
+    }
+
+    SeekIndexFixture(const SeekIndexFixture &) = delete;
+    SeekIndexFixture &operator=(const SeekIndexFixture &) = delete;
+
+    std::filesystem::path Source() const
+    {
+        return mRoot / "source.log.gz";
+    }
+
+    std::filesystem::path IndexDir() const
+    {
+        return mRoot / "index";
+    }
+
+    void WriteSource(const std::string &bytes) const
+    {
+        std::ofstream out(Source(), std::ios::binary | std::ios::trunc);
+        REQUIRE(out.is_open());
+        out << bytes;
+    }
+
+    std::uint64_t Fingerprint() const
+    {
+        std::ifstream in(Source(), std::ios::binary);
+        const std::vector<std::uint8_t> bytes{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+        return SeekIndexFingerprint(bytes);
+    }
+
+    GzipSeekIndex SampleIndex() const
+    {
+        GzipSeekIndex index;
+        index.compressedSize = std::filesystem::file_size(Source());
+        index.fingerprint = Fingerprint();
+        index.decodedSize = 1 << 20;
+        for (std::uint64_t i = 1; i <= 3; ++i)
+        {
+            GzipSeekPoint point;
+            point.compressedOffset = i * 1000;
+            point.decodedOffset = i * 200000;
+            point.bits = static_cast<std::uint8_t>(i);
+            point.window.assign(32 * 1024, static_cast<std::uint8_t>('a' + i));
+            index.points.push_back(std::move(point));
+        }
+        return index;
+    }
+
+private:
+    std::filesystem::path mRoot;
+};
+
+} // namespace
+
+TEST_CASE("SeekIndex: a saved index loads back unchanged", "[seek_index]")
+{
+    const SeekIndexFixture fixture;
+    const GzipSeekIndex saved = fixture.SampleIndex();
+    SaveGzipSeekIndex(fixture.IndexDir(), fixture.Source(), saved);
+    REQUIRE(std::filesystem::exists(SeekIndexPath(fixture.IndexDir(), fixture.Source())));
+
+    const auto loaded = LoadGzipSeekIndex(fixture.IndexDir(), fixture.Source(), fixture.Fingerprint());
+    REQUIRE(loaded.has_value());
+    CHECK(loaded->compressedSize == saved.compressedSize);
+    CHECK(loaded->fingerprint == saved.fingerprint);
+    CHECK(loaded->decodedSize == saved.decodedSize);
+    REQUIRE(loaded->points.size() == saved.points.size());
+    for (std::size_t i = 0; i < saved.points.size(); ++i)
+    {
+        CHECK(loaded->points[i].compressedOffset == saved.points[i].compressedOffset);
+        CHECK(loaded->points[i].decodedOffset == saved.points[i].decodedOffset);
+        CHECK(loaded->points[i].bits == saved.points[i].bits);
+        CHECK(loaded->points[i].window == saved.points[i].window);
+    }
+}
+
+TEST_CASE("SeekIndex: an index for different bytes is rejected", "[seek_index]")
+{
+    const SeekIndexFixture fixture;
+    SaveGzipSeekIndex(fixture.IndexDir(), fixture.Source(), fixture.SampleIndex());
+
+    SECTION("fingerprint differs")
+    {
+        CHECK_FALSE(LoadGzipSeekIndex(fixture.IndexDir(), fixture.Source(), fixture.Fingerprint() + 1).has_value());
+    }
+    SECTION("source grew")
+    {
+        fixture.WriteSource(std::string(64 * 1024 + 1, 'z'));
+        CHECK_FALSE(LoadGzipSeekIndex(fixture.IndexDir(), fixture.Source(), fixture.Fingerprint()).has_value());
+    }
+    SECTION("no cache directory")
+    {
+        CHECK_FALSE(LoadGzipSeekIndex({}, fixture.Source(), fixture.Fingerprint()).has_value());
+    }
+}
+
+TEST_CASE("SeekIndex: a damaged sidecar is rejected", "[seek_index]")
+{
+    const SeekIndexFixture fixture;
+    SaveGzipSeekIndex(fixture.IndexDir(), fixture.Source(), fixture.SampleIndex());
+    const std::filesystem::path sidecar = SeekIndexPath(fixture.IndexDir(), fixture.Source());
+    const std::uintmax_t size = std::filesystem::file_size(sidecar);
+
+    SECTION("truncated")
+    {
+        std::filesystem::resize_file(sidecar, size - 1);
+    }
+    SECTION("bad magic")
+    {
+        std::fstream io(sidecar, std::ios::binary | std::ios::in | std::ios::out);
+        io.put('X');
+    }
+    CHECK_FALSE(LoadGzipSeekIndex(fixture.IndexDir(), fixture.Source(), fixture.Fingerprint()).has_value());
+}
+
+TEST_CASE("SeekIndex: points out of order are rejected", "[seek_index]")
+{
+    const SeekIndexFixture fixture;
+    GzipSeekIndex index = fixture.SampleIndex();
+    std::swap(index.points[0], index.points[1]);
+    SaveGzipSeekIndex(fixture.IndexDir(), fixture.Source(), index);
+    CHECK_FALSE(LoadGzipSeekIndex(fixture.IndexDir(), fixture.Source(), fixture.Fingerprint()).has_value());
+}
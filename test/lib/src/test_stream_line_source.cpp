@@ -12,6 +12,7 @@
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <utility>
 
 using loglib::BytesProducer;
@@ -165,6 +166,116 @@ TEST_CASE("StreamLineSource: EvictBefore drops prefix lines", "[StreamLineSource
     CHECK(source.Size() == 3);
 }
 
+TEST_CASE("StreamLineSource: AppendOwnedBytes continues the line's owned offsets", "[StreamLineSource]")
+{
+    StreamLineSource source(std::filesystem::path("s.log"), nullptr);
+    const size_t id1 = source.AppendLine("raw 1", "alpha");
+    const size_t id2 = source.AppendLine("raw 2", "");
+
+    // The committed bytes sit in the chunk arena; later appends land
+    // after them in offset space.
+    const uint64_t betaOffset = source.AppendOwnedBytes(id1, "beta");
+    CHECK(betaOffset == 5);
+    const uint64_t gammaOffset = source.AppendOwnedBytes(id1, "gamma");
+    CHECK(gammaOffset == 9);
+    CHECK(source.AppendOwnedBytes(id2, "delta") == 0);
+
+    CHECK(source.ResolveOwnedBytes(0, 5, id1) == "alpha");
+    CHECK(source.ResolveOwnedBytes(betaOffset, 4, id1) == "beta");
+    CHECK(source.ResolveOwnedBytes(gammaOffset, 5, id1) == "gamma");
+    CHECK(source.ResolveOwnedBytes(0, 5, id2) == "delta");
+    CHECK(source.RawLine(id1) == "raw 1");
+
+    // A range straddling committed and late bytes is not contiguous.
+    CHECK(source.ResolveOwnedBytes(3, 4, id1).empty());
+
+    source.EvictBefore(id2);
+    CHECK(source.ResolveOwnedBytes(betaOffset, 4, id1).empty());
+    CHECK_THROWS_AS(source.AppendOwnedBytes(id1, "x"), std::out_of_range);
+}
+
+TEST_CASE("StreamLineSource: EvictBefore releases whole arena chunks", "[StreamLineSource]")
+{
+    StreamLineSource source(std::filesystem::path("s.log"), nullptr);
+
+    // ~5 chunks of 1 KiB lines, spanning more than one index block.
+    const std::string payload(1024, 'p');
+    const size_t lineCount = (5 * StreamLineSource::CHUNK_BYTES) / payload.size();
+    REQUIRE(lineCount > StreamLineSource::INDEX_BLOCK_LINES);
+    for (size_t i = 1; i <= lineCount; ++i)
+    {
+        source.AppendLine("line " + std::to_string(i), payload);
+    }
+    const size_t bytesFull = source.OwnedMemoryBytes();
+    CHECK(bytesFull >= lineCount * payload.size());
+
+    // Evicting a partial chunk's worth frees nothing yet.
+    source.EvictBefore(10);
+    CHECK(source.RawLine(10) == "line 10");
+
+    // Evict all but the last 100 lines: every chunk but the tail ones is
+    // released (retired memory is reclaimed by later writer calls).
+    const size_t keepFrom = lineCount - 99;
+    source.EvictBefore(keepFrom);
+    source.AppendLine("tail", "");
+    source.AppendLine("tail", "");
+    CHECK(source.OwnedMemoryBytes() <= 2 * StreamLineSource::CHUNK_BYTES + (128 * 1024));
+    CHECK(source.Size() == 102);
+    CHECK(source.RawLine(keepFrom) == "line " + std::to_string(keepFrom));
+    CHECK(source.ResolveOwnedBytes(0, 1024, lineCount) == payload);
+    CHECK_THROWS_AS(source.RawLine(keepFrom - 1), std::out_of_range);
+}
+
+TEST_CASE("StreamLineSource: lock-free readers race appends and eviction", "[StreamLineSource]")
+{
+    StreamLineSource source(std::filesystem::path("s.log"), nullptr);
+    constexpr size_t LINE_COUNT = 20000;
+    const std::string payload(200, 'x');
+
+    std::atomic<bool> done{false};
+    std::atomic<size_t> mismatches{0};
+    std::thread reader([&]() {
+        while (!done.load(std::memory_order_acquire))
+        {
+            // Probe both ends: the head races chunk release, the tail
+            // races index growth.
+            const size_t first = source.FirstAvailableLineId();
+            const size_t last = first + source.Size();
+            for (size_t probe = 0; probe < 64; ++probe)
+            {
+                const size_t id = probe < 32 ? first + probe : last - (64 - probe);
+                // A concurrently evicted id throws; a live one must be
+                // intact (`RawLine` copies under the read epoch).
+                try
+                {
+                    if (source.RawLine(id) != payload)
+                    {
+                        mismatches.fetch_add(1);
+                    }
+                }
+                catch (const std::out_of_range &)
+                {
+                }
+            }
+        }
+    });
+
+    for (size_t i = 1; i <= LINE_COUNT; ++i)
+    {
+        source.AppendLine(payload, "");
+        if (i % 1000 == 0)
+        {
+            source.EvictBefore(i - 500);
+        }
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    CHECK(mismatches.load() == 0);
+    CHECK(source.FirstAvailableLineId() == LINE_COUNT - 500);
+    CHECK(source.RawLine(LINE_COUNT) == payload);
+}
+
 TEST_CASE("StreamLineSource: EvictBefore with id <= FirstAvailableLineId is a no-op", "[StreamLineSource]")
 {
     StreamLineSource source(std::filesystem::path("s.log"), nullptr);
@@ -0,0 +1,318 @@
+#include <loglib/internal/trigram_index.hpp>
+#include <loglib/trigram_query.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+using loglib::TrigramQuery;
+using loglib::internal::FoldTrigramText;
+using loglib::internal::LoadTrigramIndex;
+using loglib::internal::SaveTrigramIndex;
+using loglib::internal::TRIGRAM_OTHER_SYMBOL;
+using loglib::internal::TrigramIndex;
+using loglib::internal::TrigramIndexSignature;
+using loglib::internal::TrigramKey;
+using loglib::internal::TrigramKeySet;
+
+namespace
+{
+
+constexpr size_t GRANULE_ROWS = TrigramIndex::GRANULE_ROWS;
+
+std::string Fold(std::string_view bytes, bool compact)
+{
+    std::string out;
+    FoldTrigramText(bytes, compact, out);
+    return out;
+}
+
+/// Index with one granule per entry of @p texts.
+TrigramIndex IndexOf(const std::vector<std::string> &texts)
+{
+    TrigramKeySet keys;
+    std::vector<std::vector<uint32_t>> granules;
+    for (const std::string &text : texts)
+    {
+        keys.AddCell(text);
+        granules.push_back(keys.TakeKeys());
+    }
+    TrigramIndex index;
+    index.AppendGranules(granules, texts.size() * GRANULE_ROWS);
+    return index;
+}
+
+/// Which of @p texts @p query keeps as candidates.
+std::vector<bool> CandidateTexts(const TrigramQuery &query, const std::vector<std::string> &texts)
+{
+    const TrigramIndex index = IndexOf(texts);
+    const auto candidates = index.Candidates(query);
+    std::vector<bool> out;
+    for (size_t i = 0; i < texts.size(); ++i)
+    {
+        out.push_back(!candidates.has_value() || candidates->Contains(i * GRANULE_ROWS));
+    }
+    return out;
+}
+
+/// Scratch directory with a source file and an index cache; removed on
+/// destruction.
+class TrigramIndexFixture
+{
+public:
+    TrigramIndexFixture()
+    {
+        std::random_device rd;
+        std::ostringstream name;
+        name << "slv-trigram-index-" << std::hex << ((static_cast<std::uint64_t>(rd()) << 32) | rd());
+        mRoot = std::filesystem::temp_directory_path() / name.str();
+        std::filesystem::create_directories(mRoot);
+        WriteSource("first line\nsecond line\n");
+    }
+
+    ~TrigramIndexFixture()
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(mRoot, ec);
+    }
+
+    TrigramIndexFixture(const TrigramIndexFixture &) = delete;
+    TrigramIndexFixture &operator=(const TrigramIndexFixture &) = delete;
+
+    std::filesystem::path Source() const
+    {
+        return mRoot / "source.log";
+    }
+
+    std::filesystem::path IndexDir() const
+    {
+        return mRoot / "index";
+    }
+
+    void WriteSource(const std::string &bytes) const
+    {
+        std::ofstream out(Source(), std::ios::binary | std::ios::trunc);
+        out << bytes;
+    }
+
+    /// The single sidecar in `IndexDir()`, or an empty path.
+    std::filesystem::path Sidecar() const
+    {
+        for (const auto &entry : std::filesystem::directory_iterator(IndexDir()))
+        {
+            return entry.path();
+        }
+        return {};
+    }
+
+private:
+    std::filesystem::path mRoot;
+};
+
+} // namespace
+
+TEST_CASE("FoldTrigramText lower-cases ASCII and isolates other code points", "[trigram_index]")
+{
+    const std::string other(1, TRIGRAM_OTHER_SYMBOL);
+    CHECK(Fold("GET /Api", false) == "get /api");
+    CHECK(Fold("caf\xC3\xA9!", false) == "caf" + other + "!");
+    // KELVIN SIGN and LONG S match `k` / `s` case-insensitively.
+    CHECK(Fold("\xE2\x84\xAA\xC5\xBF", false) == "ks");
+    // A stray continuation byte and a control byte.
+    CHECK(Fold("a\x80" "b\x01", false) == "a" + other + "b" + other);
+    // NO-BREAK SPACE is whitespace to `QString::simplified`.
+    CHECK(Fold("a\xC2\xA0" "b", false) == "a b");
+
+    CHECK(Fold("  a \t\n b  ", false) == "  a    b  ");
+    CHECK(Fold("  a \t\n b  ", true) == "a b");
+}
+
+TEST_CASE("TrigramQuery::ForLiteral requires every trigram of the needle", "[trigram_index]")
+{
+    CHECK(TrigramQuery::ForLiteral("ab").IsAll());
+    CHECK(TrigramQuery::ForLiteral("").IsAll());
+
+    const TrigramQuery query = TrigramQuery::ForLiteral("Time Out");
+    CHECK(query.op == TrigramQuery::Op::And);
+    CHECK(query.trigrams.size() == 6);
+    CHECK(query == TrigramQuery::ForLiteral("time  out"));
+
+    // Windows touching a non-ASCII code point are not indexed.
+    const TrigramQuery accented = TrigramQuery::ForLiteral("x\xC3\xA9yz ab");
+    CHECK(
+        accented.trigrams ==
+        std::vector<uint32_t>{TrigramKey(' ', 'a', 'b'), TrigramKey('y', 'z', ' '), TrigramKey('z', ' ', 'a')}
+    );
+
+    const std::vector<std::string> texts = {"request timed out", "Connection Time  out", "timeout", "time out"};
+    CHECK(CandidateTexts(query, texts) == std::vector<bool>{false, true, false, true});
+}
+
+TEST_CASE("TrigramQuery::ForRegex keeps every text the pattern can match", "[trigram_index]")
+{
+    const std::vector<std::string> texts = {
+        "error 42 while reading", "warn: disk at 91%", "WARNING flag", "all good", "errno=13", "GET /api/v2/users"
+    };
+
+    CHECK(CandidateTexts(TrigramQuery::ForRegex("error|warn"), texts) ==
+          std::vector<bool>{true, true, true, false, false, false});
+    CHECK(CandidateTexts(TrigramQuery::ForRegex("err(or|no)"), texts) ==
+          std::vector<bool>{true, false, false, false, true, false});
+    CHECK(CandidateTexts(TrigramQuery::ForRegex("(?i)WARN\\w*\\s+flag"), texts) ==
+          std::vector<bool>{false, false, true, false, false, false});
+    CHECK(CandidateTexts(TrigramQuery::ForRegex("/api/v[0-9]+/users$"), texts) ==
+          std::vector<bool>{false, false, false, false, false, true});
+    CHECK(CandidateTexts(TrigramQuery::ForRegex("\\Qdisk at\\E \\d+%"), texts) ==
+          std::vector<bool>{false, true, false, false, false, false});
+
+    // Nothing to go on, or a construct the analysis does not model.
+    CHECK(TrigramQuery::ForRegex("a.b").IsAll());
+    CHECK(TrigramQuery::ForRegex("(?:ab)*c").IsAll());
+    CHECK(TrigramQuery::ForRegex("(?x) e r r o r").IsAll());
+    CHECK(TrigramQuery::ForRegex("(a+)+(*ACCEPT)").IsAll());
+    CHECK(TrigramQuery::ForRegex("unbalanced)").IsAll());
+    // A backreference matches anything, so only the group's trigrams
+    // are required.
+    CHECK(TrigramQuery::ForRegex("(abc)\\1") == TrigramQuery::ForLiteral("abc"));
+    // `time | timeout` needs no more than "time".
+    CHECK(TrigramQuery::ForRegex("time(out)?") == TrigramQuery::ForLiteral("time"));
+}
+
+TEST_CASE("TrigramIndex grows row by row like a bulk build", "[trigram_index]")
+{
+    // Rows whose text varies, so granules differ in their keys.
+    const auto rowText = [](size_t row) { return "row " + std::to_string(row % 997) + (row % 3 == 0 ? " odd" : ""); };
+    const size_t rows = (5 * GRANULE_ROWS) + 17;
+
+    TrigramIndex bulk;
+    {
+        TrigramKeySet keys;
+        std::vector<std::vector<uint32_t>> granules;
+        for (size_t row = 0; row < rows; row += GRANULE_ROWS)
+        {
+            for (size_t r = row; r < std::min(row + GRANULE_ROWS, rows); ++r)
+            {
+                keys.AddCell(rowText(r));
+            }
+            granules.push_back(keys.TakeKeys());
+        }
+        bulk.AppendGranules(granules, rows);
+    }
+
+    TrigramIndex incremental;
+    TrigramKeySet keys;
+    size_t row = 0;
+    for (const size_t step : {1U, 100U, 300U, 513U, 400U})
+    {
+        // Top up the open granule, then whole granules.
+        std::vector<std::vector<uint32_t>> granules;
+        const size_t end = std::min(row + step, rows);
+        size_t granuleEnd = row + std::min(incremental.OpenGranuleRoom(), end - row);
+        const size_t first = row;
+        while (row < end)
+        {
+            for (; row < granuleEnd; ++row)
+            {
+                keys.AddCell(rowText(row));
+            }
+            granules.push_back(keys.TakeKeys());
+            granuleEnd = std::min(row + GRANULE_ROWS, end);
+        }
+        incremental.AppendGranules(granules, end - first);
+    }
+    REQUIRE(incremental.Size() == rows);
+    REQUIRE(bulk.Size() == rows);
+    CHECK(incremental.TrigramCount() == bulk.TrigramCount());
+
+    for (const char *needle : {"odd", "row 12", "row 996", "missing"})
+    {
+        const auto lhs = bulk.Candidates(TrigramQuery::ForLiteral(needle));
+        const auto rhs = incremental.Candidates(TrigramQuery::ForLiteral(needle));
+        REQUIRE(lhs.has_value());
+        REQUIRE(rhs.has_value());
+        CHECK(lhs->CandidateGranuleCount() == rhs->CandidateGranuleCount());
+        for (size_t r = 0; r < rows; r += 37)
+        {
+            CHECK(lhs->Contains(r) == rhs->Contains(r));
+        }
+    }
+    CHECK(bulk.Candidates(TrigramQuery::ForLiteral("missing"))->CandidateGranuleCount() == 0);
+    CHECK(bulk.Candidates(TrigramQuery::ForLiteral("x")) == std::nullopt);
+}
+
+TEST_CASE("TrigramIndex eviction keeps row numbering and granule alignment", "[trigram_index]")
+{
+    TrigramIndex index = IndexOf({"alpha", "beta", "gamma", "delta"});
+    REQUIRE(index.Size() == 4 * GRANULE_ROWS);
+
+    index.EraseFront(GRANULE_ROWS + 10);
+    CHECK(index.Size() == (3 * GRANULE_ROWS) - 10);
+    const auto gamma = index.Candidates(TrigramQuery::ForLiteral("gamma"));
+    REQUIRE(gamma.has_value());
+    CHECK(gamma->GranuleCount() == 3);
+    // The straddling `beta` granule now ends early.
+    CHECK(gamma->GranuleEndRow(0) == GRANULE_ROWS - 10);
+    CHECK_FALSE(gamma->Contains(GRANULE_ROWS - 11));
+    CHECK(gamma->Contains(GRANULE_ROWS - 10));
+    CHECK_FALSE(gamma->Contains((2 * GRANULE_ROWS) - 10));
+    // Rows appended after the query count as candidates.
+    CHECK(gamma->Contains(index.Size()));
+    CHECK(index.Candidates(TrigramQuery::ForLiteral("alpha"))->CandidateGranuleCount() == 0);
+
+    index.EraseFront(index.Size());
+    CHECK(index.Empty());
+    CHECK(index.OpenGranuleRoom() == GRANULE_ROWS);
+}
+
+TEST_CASE("TrigramIndex persists keyed by a file's identity", "[trigram_index]")
+{
+    const TrigramIndexFixture fixture;
+    TrigramIndex index = IndexOf({"first line", "second line"});
+    index.EraseFront(3);
+    const TrigramIndexSignature signature{.rows = index.Size(), .stringCells = 2, .stringBytes = 21};
+
+    REQUIRE(SaveTrigramIndex(fixture.IndexDir(), fixture.Source(), signature, index));
+    auto loaded = LoadTrigramIndex(fixture.IndexDir(), fixture.Source(), signature);
+    REQUIRE(loaded.has_value());
+    CHECK(loaded->Size() == index.Size());
+    CHECK(loaded->TrigramCount() == index.TrigramCount());
+    const auto second = loaded->Candidates(TrigramQuery::ForLiteral("second"));
+    REQUIRE(second.has_value());
+    CHECK_FALSE(second->Contains(0));
+    CHECK(second->Contains(GRANULE_ROWS - 3));
+
+    // Other rows, or a file that changed since.
+    TrigramIndexSignature other = signature;
+    other.stringBytes += 1;
+    CHECK_FALSE(LoadTrigramIndex(fixture.IndexDir(), fixture.Source(), other).has_value());
+    fixture.WriteSource("first line\nsecond line\nthird line\n");
+    CHECK_FALSE(LoadTrigramIndex(fixture.IndexDir(), fixture.Source(), signature).has_value());
+}
+
+TEST_CASE("LoadTrigramIndex rejects a truncated sidecar", "[trigram_index]")
+{
+    const TrigramIndexFixture fixture;
+    const TrigramIndex index = IndexOf({"first line", "second line"});
+    const TrigramIndexSignature signature{.rows = index.Size(), .stringCells = 2, .stringBytes = 21};
+    REQUIRE(SaveTrigramIndex(fixture.IndexDir(), fixture.Source(), signature, index));
+
+    const std::filesystem::path sidecar = fixture.Sidecar();
+    REQUIRE_FALSE(sidecar.empty());
+    const auto size = std::filesystem::file_size(sidecar);
+    for (const auto keep : {size - 1, size / 2, std::uintmax_t{12}})
+    {
+        std::filesystem::resize_file(sidecar, keep);
+        CHECK_FALSE(LoadTrigramIndex(fixture.IndexDir(), fixture.Source(), signature).has_value());
+    }
+}
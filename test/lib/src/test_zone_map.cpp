@@ -0,0 +1,117 @@
+#include <loglib/internal/compact_log_value.hpp>
+#include <loglib/internal/zone_map.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+using loglib::internal::CompactLogValue;
+using loglib::internal::ZoneMap;
+using loglib::internal::ZoneSummary;
+
+TEST_CASE("ZoneSummary tracks time and numeric readings separately", "[zone_map]")
+{
+    ZoneSummary zone;
+    zone.Add(CompactLogValue::MakeTimestamp(loglib::TimeStamp{std::chrono::microseconds{500}}));
+    zone.Add(CompactLogValue::MakeInt64(-7));
+    zone.Add(CompactLogValue::MakeUint64(std::numeric_limits<uint64_t>::max()));
+    zone.Add(CompactLogValue::MakeDouble(std::numeric_limits<double>::quiet_NaN()));
+    zone.Add(CompactLogValue::MakeDouble(2.5));
+    zone.Add(CompactLogValue::MakeMonostate());
+
+    CHECK(zone.rows == 6);
+    // Timestamp + Int64; the oversized Uint64 has no epoch reading.
+    CHECK(zone.timeRows == 2);
+    CHECK(zone.minMicros == -7);
+    CHECK(zone.maxMicros == 500);
+    CHECK_FALSE(zone.hasUnsignedTime);
+    // Int64 + Uint64 + the non-NaN double.
+    CHECK(zone.numberRows == 3);
+    CHECK(zone.minNumber == -7.0);
+    CHECK(zone.maxNumber == static_cast<double>(std::numeric_limits<uint64_t>::max()));
+
+    zone.Add(CompactLogValue::MakeUint64(3));
+    CHECK(zone.hasUnsignedTime);
+    CHECK(zone.timeRows == 3);
+}
+
+TEST_CASE("ZoneMap splits rows into aligned blocks", "[zone_map]")
+{
+    ZoneMap map;
+    const size_t rows = (2 * ZoneMap::BLOCK_ROWS) + 10;
+    for (size_t row = 0; row < rows; ++row)
+    {
+        map.Append(CompactLogValue::MakeInt64(static_cast<int64_t>(row)));
+    }
+    REQUIRE(map.Size() == rows);
+    REQUIRE(map.BlockCount() == 3);
+    CHECK(map.BlockOf(ZoneMap::BLOCK_ROWS - 1) == 0);
+    CHECK(map.BlockOf(ZoneMap::BLOCK_ROWS) == 1);
+    CHECK(map.BlockFirstRow(2) == 2 * ZoneMap::BLOCK_ROWS);
+    CHECK(map.BlockEndRow(2) == rows);
+    CHECK(map.Block(1).minMicros == static_cast<int64_t>(ZoneMap::BLOCK_ROWS));
+    CHECK(map.Block(1).maxMicros == static_cast<int64_t>((2 * ZoneMap::BLOCK_ROWS) - 1));
+    CHECK_FALSE(map.AtBlockBoundary());
+
+    const ZoneSummary total = map.Total();
+    CHECK(total.rows == rows);
+    CHECK(total.minMicros == 0);
+    CHECK(total.maxMicros == static_cast<int64_t>(rows - 1));
+}
+
+TEST_CASE("ZoneMap appends whole blocks summarised elsewhere", "[zone_map]")
+{
+    ZoneMap map;
+    ZoneSummary block;
+    for (size_t row = 0; row < ZoneMap::BLOCK_ROWS; ++row)
+    {
+        block.Add(CompactLogValue::MakeDouble(1.5));
+    }
+    map.AppendBlock(block);
+    REQUIRE(map.AtBlockBoundary());
+
+    ZoneSummary tail;
+    tail.Add(CompactLogValue::MakeDouble(-1.0));
+    map.AppendBlock(tail);
+    // Row-wise appends keep filling the partial block.
+    map.Append(CompactLogValue::MakeDouble(9.0));
+    CHECK(map.Size() == ZoneMap::BLOCK_ROWS + 2);
+    REQUIRE(map.BlockCount() == 2);
+    CHECK(map.Block(1).rows == 2);
+    CHECK(map.Block(1).minNumber == -1.0);
+    CHECK(map.Block(1).maxNumber == 9.0);
+}
+
+TEST_CASE("ZoneMap eviction drops whole blocks and keeps row numbering", "[zone_map]")
+{
+    ZoneMap map;
+    const size_t rows = 3 * ZoneMap::BLOCK_ROWS;
+    for (size_t row = 0; row < rows; ++row)
+    {
+        map.Append(CompactLogValue::MakeInt64(static_cast<int64_t>(row)));
+    }
+
+    map.EraseFront(ZoneMap::BLOCK_ROWS + 100);
+    CHECK(map.Size() == rows - ZoneMap::BLOCK_ROWS - 100);
+    REQUIRE(map.BlockCount() == 2);
+    // The straddling block keeps its pre-eviction summary.
+    CHECK(map.Block(0).rows == ZoneMap::BLOCK_ROWS);
+    CHECK(map.Block(0).minMicros == static_cast<int64_t>(ZoneMap::BLOCK_ROWS));
+    CHECK(map.BlockFirstRow(0) == 0);
+    CHECK(map.BlockEndRow(0) == ZoneMap::BLOCK_ROWS - 100);
+    CHECK(map.BlockOf(ZoneMap::BLOCK_ROWS - 100) == 1);
+    CHECK(map.BlockFirstRow(1) == ZoneMap::BLOCK_ROWS - 100);
+
+    // New rows land in the open block's successor as before.
+    map.Append(CompactLogValue::MakeInt64(-1));
+    CHECK(map.BlockCount() == 3);
+    CHECK(map.Block(2).minMicros == -1);
+
+    map.EraseFront(map.Size());
+    CHECK(map.Empty());
+    CHECK(map.BlockCount() == 0);
+    CHECK(map.AtBlockBoundary());
+}